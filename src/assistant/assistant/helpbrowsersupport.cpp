@@ -71,13 +71,16 @@ public:
     void abort() override;
 
     qint64 bytesAvailable() const override
-        { return data.size() + QNetworkReply::bytesAvailable(); }
+        { return data.size() - readPos + QNetworkReply::bytesAvailable(); }
 
 protected:
     qint64 readData(char *data, qint64 maxlen) override;
 
 private:
     QByteArray data;
+    // Reading moves this instead of removing the read bytes from the front
+    // of data, which would copy the rest of a large file on every read.
+    qint64 readPos = 0;
     const qint64 origLen;
 };
 
@@ -105,13 +108,16 @@ void HelpNetworkReply::abort()
 qint64 HelpNetworkReply::readData(char *buffer, qint64 maxlen)
 {
     TRACE_OBJ
-    qint64 len = qMin(qint64(data.size()), maxlen);
+    qint64 len = qMin(qint64(data.size()) - readPos, maxlen);
     if (len) {
-        memcpy(buffer, data.constData(), len);
-        data.remove(0, len);
+        memcpy(buffer, data.constData() + readPos, len);
+        readPos += len;
     }
-    if (!data.size())
+    if (readPos == data.size()) {
+        data.clear();
+        readPos = 0;
         QTimer::singleShot(0, this, &QNetworkReply::finished);
+    }
     return len;
 }
 
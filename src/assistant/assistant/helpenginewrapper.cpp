@@ -32,6 +32,7 @@ namespace {
     const QString HomePageKey("homepage"_L1);
     const QString MainWindowKey("MainWindow"_L1);
     const QString MainWindowGeometryKey("MainWindowGeometry"_L1);
+    const QString MaxLoadedPagesKey("MaxLoadedPages"_L1);
     const QString SearchWasAttachedKey("SearchWasAttached"_L1);
     const QString StartOptionKey("StartOption"_L1);
     const QString UseAppFontKey("useAppFont"_L1);
@@ -216,6 +217,24 @@ bool HelpEngineWrapper::registerDocumentation(const QString &docFile)
     return true;
 }
 
+QStringList HelpEngineWrapper::registerDocumentations(const QStringList &docFiles,
+                                                      QStringList *warnings)
+{
+    TRACE_OBJ
+    d->checkDocFilesWatched();
+    QMetaObject::Connection connection;
+    if (warnings) {
+        connection = connect(d->m_helpEngine, &QHelpEngineCore::warning, this,
+                             [warnings](const QString &msg) { warnings->append(msg); });
+    }
+    const QStringList registered = d->m_helpEngine->registerDocumentations(docFiles);
+    disconnect(connection);
+    if (!registered.isEmpty())
+        d->m_qchWatcher->addPaths(registered);
+    d->checkDocFilesWatched();
+    return registered;
+}
+
 bool HelpEngineWrapper::unregisterDocumentation(const QString &namespaceName)
 {
     TRACE_OBJ
@@ -290,6 +309,18 @@ void HelpEngineWrapper::setLastShownPages(const QStringList &lastShownPages)
     CollectionConfiguration::setLastShownPages(*d->m_helpEngine, lastShownPages);
 }
 
+const QStringList HelpEngineWrapper::lastShownPageTitles() const
+{
+    TRACE_OBJ
+    return CollectionConfiguration::lastShownPageTitles(*d->m_helpEngine);
+}
+
+void HelpEngineWrapper::setLastShownPageTitles(const QStringList &lastShownPageTitles)
+{
+    TRACE_OBJ
+    CollectionConfiguration::setLastShownPageTitles(*d->m_helpEngine, lastShownPageTitles);
+}
+
 const QStringList HelpEngineWrapper::lastZoomFactors() const
 {
     TRACE_OBJ
@@ -302,6 +333,12 @@ void HelpEngineWrapper::setLastZoomFactors(const QStringList &lastZoomFactors)
     CollectionConfiguration::setLastZoomFactors(*d->m_helpEngine, lastZoomFactors);
 }
 
+int HelpEngineWrapper::maxLoadedPages() const
+{
+    TRACE_OBJ
+    return d->m_helpEngine->customValue(MaxLoadedPagesKey, 0).toInt();
+}
+
 const QString HelpEngineWrapper::cacheDir() const
 {
     TRACE_OBJ
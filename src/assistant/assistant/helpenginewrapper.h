@@ -55,6 +55,8 @@ public:
     QString documentationFileName(const QString &namespaceName) const;
     const QString collectionFile() const;
     bool registerDocumentation(const QString &docFile);
+    QStringList registerDocumentations(const QStringList &docFiles,
+                                       QStringList *warnings = nullptr);
     bool unregisterDocumentation(const QString &namespaceName);
     QUrl findFile(const QUrl &url) const;
     QByteArray fileData(const QUrl &url) const;
@@ -84,9 +86,13 @@ public:
     //       Perhaps also fill up missing elements automatically or assert.
     const QStringList lastShownPages() const;
     void setLastShownPages(const QStringList &lastShownPages);
+    const QStringList lastShownPageTitles() const;
+    void setLastShownPageTitles(const QStringList &lastShownPageTitles);
     const QStringList lastZoomFactors() const;
     void setLastZoomFactors(const QStringList &lastZoomFactors);
 
+    int maxLoadedPages() const;
+
     const QString cacheDir() const;
     bool cacheDirIsRelativeToCollection() const;
     void setCacheDir(const QString &cacheDir, bool relativeToCollection);
@@ -11,6 +11,8 @@
 #include <QtCore/QStringBuilder>
 #include <QtCore/QTemporaryFile>
 
+#include <optional>
+
 #include <QtGui/QDesktopServices>
 #if QT_CONFIG(clipboard)
 #include <QtGui/QClipboard>
@@ -151,6 +153,7 @@ public:
     };
     HistoryItem currentHistoryItem() const;
     void setSourceInternal(const QUrl &url, int *vscroll = nullptr, bool reload = false);
+    void loadPendingItem();
     void incrementZoom(int steps);
     void applyZoom(int percentage);
 
@@ -158,16 +161,22 @@ public:
     QLiteHtmlWidget *m_viewer = nullptr;
     std::vector<HistoryItem> m_backItems;
     std::vector<HistoryItem> m_forwardItems;
+    // The page that is shown once the viewer becomes visible. A negative
+    // vscroll scrolls to the fragment of the url instead.
+    std::optional<HistoryItem> m_pendingItem;
     int m_fontZoom = 100; // zoom percentage
 };
 
 HelpViewerPrivate::HistoryItem HelpViewerPrivate::currentHistoryItem() const
 {
+    if (m_pendingItem)
+        return *m_pendingItem;
     return { m_viewer->url(), m_viewer->title(), m_viewer->verticalScrollBar()->value() };
 }
 
 void HelpViewerPrivate::setSourceInternal(const QUrl &url, int *vscroll, bool reload)
 {
+    m_pendingItem.reset();
     QGuiApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
 
     const bool isHelp = (url.toString() == "help"_L1);
@@ -199,6 +208,14 @@ void HelpViewerPrivate::setSourceInternal(const QUrl &url, int *vscroll, bool re
     emit q->titleChanged();
 }
 
+void HelpViewerPrivate::loadPendingItem()
+{
+    if (!m_pendingItem)
+        return;
+    HistoryItem item = *m_pendingItem;
+    setSourceInternal(item.url, item.vscroll < 0 ? nullptr : &item.vscroll);
+}
+
 void HelpViewerPrivate::incrementZoom(int steps)
 {
     const int incrementPercentage = 10 * steps; // 10 percent increase by single step
@@ -239,6 +256,8 @@ HelpViewer::HelpViewer(qreal zoom, QWidget *parent)
     connect(
             QGuiApplication::styleHints(), &QStyleHints::colorSchemeChanged, this,
             [this] {
+                if (d->m_pendingItem)
+                    return;
                 int vscroll = d->m_viewer->verticalScrollBar()->value();
                 d->setSourceInternal(source(), &vscroll, /*reload*/ true);
             },
@@ -283,12 +302,12 @@ qreal HelpViewer::scale() const
 
 QString HelpViewer::title() const
 {
-    return d->m_viewer->title();
+    return d->m_pendingItem ? d->m_pendingItem->title : d->m_viewer->title();
 }
 
 QUrl HelpViewer::source() const
 {
-    return d->m_viewer->url();
+    return d->m_pendingItem ? d->m_pendingItem->url : d->m_viewer->url();
 }
 
 void HelpViewer::reload()
@@ -301,6 +320,46 @@ void HelpViewer::setSource(const QUrl &url)
     doSetSource(url, false);
 }
 
+/*
+    Shows \a url with \a title in the tab, but only loads the page once
+    the viewer is shown for the first time, so that restoring many pages
+    from the last session does not load all of them at startup.
+*/
+void HelpViewer::setSourceDeferred(const QUrl &url, const QString &title)
+{
+    if (isVisible()) {
+        setSource(url);
+        return;
+    }
+    d->m_pendingItem = HelpViewerPrivate::HistoryItem{ url, title, -1 };
+    emit titleChanged();
+}
+
+bool HelpViewer::isLoaded() const
+{
+    return !d->m_pendingItem && d->m_viewer->url().isValid();
+}
+
+/*
+    Frees the document of a page that is not visible. The url, title and
+    scroll position are kept, and the page is loaded again once the viewer
+    is shown.
+*/
+void HelpViewer::unload()
+{
+    if (!isLoaded() || isVisible())
+        return;
+    d->m_pendingItem = d->currentHistoryItem();
+    d->m_viewer->setUrl(QUrl());
+    d->m_viewer->setHtml(QString());
+}
+
+void HelpViewer::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    d->loadPendingItem();
+}
+
 void HelpViewer::doSetSource(const QUrl &url, bool reload)
 {
     if (launchWithExternalApp(url))
@@ -308,7 +367,7 @@ void HelpViewer::doSetSource(const QUrl &url, bool reload)
 
     d->m_forwardItems.clear();
     emit forwardAvailable(false);
-    if (d->m_viewer->url().isValid()) {
+    if (source().isValid()) {
         d->m_backItems.push_back(d->currentHistoryItem());
         while (d->m_backItems.size() > kMaxHistoryItems) // this should trigger only once anyhow
             d->m_backItems.erase(d->m_backItems.begin());
@@ -45,6 +45,10 @@ public:
     QUrl source() const;
     void reload();
     void setSource(const QUrl &url);
+    void setSourceDeferred(const QUrl &url, const QString &title);
+
+    bool isLoaded() const;
+    void unload();
 
 #if QT_CONFIG(printer)
     void print(QPrinter *printer);
@@ -82,6 +86,10 @@ signals:
     void highlighted(const QUrl &link);
     void printRequested();
     void loadFinished();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
 private:
     void doSetSource(const QUrl &url, bool reload);
 
@@ -59,6 +59,8 @@ public:
         return true;
     }
 
+    void schedulePrefetch(const QUrl &pageUrl, const QByteArray &html);
+
 public slots:
     void openLink()
     {
@@ -75,7 +77,11 @@ public:
     int zoomCount;
     bool forceFont = false;
 
+private slots:
+    void prefetchNext();
+
 private:
+    QList<QUrl> prefetchQueue;
 
     void doOpenLink(bool newPage)
     {
@@ -9,7 +9,9 @@
 #include "openpagesmanager.h"
 #include "tracer.h"
 
+#include <QtCore/QRegularExpression>
 #include <QtCore/QStringBuilder>
+#include <QtCore/QTimer>
 
 #include <QtGui/QContextMenuEvent>
 #include <QtWidgets/QMenu>
@@ -348,6 +350,8 @@ QVariant HelpViewerImpl::loadResource(int type, const QUrl &name)
     if (type < 4) {
         const QUrl url = HelpEngineWrapper::instance().findFile(name);
         ba = HelpEngineWrapper::instance().fileData(url);
+        if (type == QTextDocument::HtmlResource)
+            d->schedulePrefetch(url, ba);
         if (url.toString().endsWith(".svg"_L1, Qt::CaseInsensitive)) {
             QImage image;
             image.loadFromData(ba, "svg");
@@ -370,4 +374,48 @@ void HelpViewerImpl::scrollToTextPosition(int position)
     }
 }
 
+// -- HelpViewerImplPrivate
+
+/*
+    Queues the previous and next pages that QDoc links from the head of
+    \a html, so that they are in the help engine's caches by the time the
+    user navigates to them. The help engine is bound to the GUI thread,
+    so the pages are read one at a time while the event loop is idle.
+*/
+void HelpViewerImpl::HelpViewerImplPrivate::schedulePrefetch(const QUrl &pageUrl,
+                                                             const QByteArray &html)
+{
+    static const QRegularExpression linkExpression(
+            uR"(<link\s+rel="(?:prev|next)"\s+href="([^"]+)")"_s,
+            QRegularExpression::CaseInsensitiveOption);
+
+    const qsizetype headEnd = html.indexOf("</head>");
+    const QString head = QString::fromUtf8(headEnd < 0 ? html : html.left(headEnd));
+
+    const bool idle = prefetchQueue.isEmpty();
+    prefetchQueue.clear();
+    for (const QRegularExpressionMatch &match : linkExpression.globalMatch(head)) {
+        QUrl url = pageUrl.resolved(QUrl(match.captured(1)));
+        url.setFragment({});
+        if (url != pageUrl && !prefetchQueue.contains(url))
+            prefetchQueue.append(url);
+    }
+    if (idle && !prefetchQueue.isEmpty())
+        QTimer::singleShot(0, this, &HelpViewerImplPrivate::prefetchNext);
+}
+
+void HelpViewerImpl::HelpViewerImplPrivate::prefetchNext()
+{
+    if (prefetchQueue.isEmpty())
+        return;
+
+    HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
+    const QUrl url = helpEngine.findFile(prefetchQueue.takeFirst());
+    if (url.isValid())
+        helpEngine.fileData(url);
+
+    if (!prefetchQueue.isEmpty())
+        QTimer::singleShot(0, this, &HelpViewerImplPrivate::prefetchNext);
+}
+
 QT_END_NAMESPACE
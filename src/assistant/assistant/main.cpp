@@ -47,10 +47,14 @@ updateLastPagesOnUnregister(QHelpEngineCore& helpEngine, const QString& nsName)
         QStringList zoomList = CollectionConfiguration::lastZoomFactors(helpEngine);
         while (zoomList.size() < currentPages.size())
             zoomList.append(CollectionConfiguration::DefaultZoomFactor);
+        QStringList titles = CollectionConfiguration::lastShownPageTitles(helpEngine);
+        if (titles.size() != currentPages.size())
+            titles = QStringList(currentPages.size(), QString());
 
         for (int i = currentPages.size(); --i >= 0;) {
             if (QUrl(currentPages.at(i)).host() == nsName) {
                 zoomList.removeAt(i);
+                titles.removeAt(i);
                 currentPages.removeAt(i);
                 lastPage = (lastPage == (i + 1)) ? 1 : lastPage;
             }
@@ -59,6 +63,7 @@ updateLastPagesOnUnregister(QHelpEngineCore& helpEngine, const QString& nsName)
         CollectionConfiguration::setLastShownPages(helpEngine, currentPages);
         CollectionConfiguration::setLastTabPage(helpEngine, lastPage);
         CollectionConfiguration::setLastZoomFactors(helpEngine, zoomList);
+        CollectionConfiguration::setLastShownPageTitles(helpEngine, titles);
     }
 }
 
@@ -398,8 +398,8 @@ void MainWindow::lookForNewQtDocumentation()
             this, &MainWindow::qtDocumentationInstalled);
     connect(m_qtDocInstaller, &QtDocInstaller::qchFileNotFound,
             this, &MainWindow::resetQtDocInfo);
-    connect(m_qtDocInstaller, &QtDocInstaller::registerDocumentation,
-            this, &MainWindow::registerDocumentation);
+    connect(m_qtDocInstaller, &QtDocInstaller::registerDocumentations,
+            this, &MainWindow::registerDocumentations);
     if (helpEngine.qtDocInfo("qt"_L1).size() != 2)
         statusBar()->showMessage(tr("Looking for Qt Documentation..."));
     m_qtDocInstaller->installDocs();
@@ -1123,27 +1123,40 @@ void MainWindow::resetQtDocInfo(const QString &component)
         QStringList(QDateTime().toString(Qt::ISODate)));
 }
 
-void MainWindow::registerDocumentation(const QString &component,
-                                       const QString &absFileName)
+void MainWindow::registerDocumentations(const QList<QtDocInstaller::QchFile> &qchFiles)
 {
     TRACE_OBJ
-    QString ns = QHelpEngineCore::namespaceName(absFileName);
-    if (ns.isEmpty())
-        return;
-
     HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
-    if (helpEngine.registeredDocumentations().contains(ns))
-        helpEngine.unregisterDocumentation(ns);
-    if (!helpEngine.registerDocumentation(absFileName)) {
-        QMessageBox::warning(this, tr("Qt Assistant"),
-            tr("Could not register file '%1': %2").
-            arg(absFileName).arg(helpEngine.error()));
-    } else {
-        QStringList docInfo;
-        docInfo << QFileInfo(absFileName).lastModified().toString(Qt::ISODate)
-                << absFileName;
-        helpEngine.setQtDocInfo(component, docInfo);
+    const QStringList registeredNamespaces = helpEngine.registeredDocumentations();
+    QStringList fileNames;
+    fileNames.reserve(qchFiles.size());
+    for (const QtDocInstaller::QchFile &qchFile : qchFiles) {
+        if (registeredNamespaces.contains(qchFile.namespaceName))
+            helpEngine.unregisterDocumentation(qchFile.namespaceName);
+        fileNames.append(qchFile.fileName);
+    }
+
+    QStringList warnings;
+    const QStringList registered = helpEngine.registerDocumentations(fileNames, &warnings);
+    QStringList failed;
+    for (const QtDocInstaller::QchFile &qchFile : qchFiles) {
+        if (!registered.contains(qchFile.fileName)) {
+            failed.append(qchFile.fileName);
+        } else {
+            QStringList docInfo;
+            docInfo << QFileInfo(qchFile.fileName).lastModified().toString(Qt::ISODate)
+                    << qchFile.fileName;
+            helpEngine.setQtDocInfo(qchFile.component, docInfo);
+        }
     }
+
+    if (failed.isEmpty())
+        return;
+    if (warnings.isEmpty())
+        warnings.append(helpEngine.error());
+    QMessageBox::warning(this, tr("Qt Assistant"),
+        tr("Could not register %n file(s): %1\n\n%2", nullptr, failed.size()).
+        arg(failed.join(", "_L1), warnings.join(u'\n')));
 }
 
 void MainWindow::handlePageCountChanged()
@@ -8,6 +8,8 @@
 #include <QtCore/QUrl>
 #include <QtWidgets/QMainWindow>
 
+#include "qtdocinstaller.h"
+
 QT_BEGIN_NAMESPACE
 
 class QAction;
@@ -19,7 +21,6 @@ class CentralWidget;
 class CmdLineParser;
 class ContentWindow;
 class IndexWindow;
-class QtDocInstaller;
 class SearchWidget;
 struct QHelpLink;
 
@@ -73,8 +74,7 @@ private slots:
     void indexingStarted();
     void indexingFinished();
     void qtDocumentationInstalled();
-    void registerDocumentation(const QString &component,
-        const QString &absFileName);
+    void registerDocumentations(const QList<QtDocInstaller::QchFile> &qchFiles);
     void resetQtDocInfo(const QString &component);
     void checkInitState();
     void documentationRemoved(const QString &namespaceName);
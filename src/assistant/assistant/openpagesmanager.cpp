@@ -41,6 +41,7 @@ OpenPagesManager::OpenPagesManager(QObject *parent, bool defaultCollection,
                                    const QUrl &cmdLineUrl)
     : QObject(parent)
     , m_model(new OpenPagesModel(this))
+    , m_maxLoadedPages(HelpEngineWrapper::instance().maxLoadedPages())
 {
     TRACE_OBJ
     m_openPagesWidget = new OpenPagesWidget(m_model);
@@ -104,6 +105,9 @@ void OpenPagesManager::setupInitialPages(bool defaultCollection,
             QStringList zoomFactors = helpEngine.lastZoomFactors();
             while (zoomFactors.size() < pageCount)
                 zoomFactors.append(CollectionConfiguration::DefaultZoomFactor);
+            QStringList titles = helpEngine.lastShownPageTitles();
+            if (titles.size() != pageCount)
+                titles = QStringList(pageCount, QString());
             initialPage = helpEngine.lastTabPage();
             if (initialPage >= pageCount) {
                 qWarning("Initial page set to %d, maximum possible value is %d",
@@ -114,7 +118,10 @@ void OpenPagesManager::setupInitialPages(bool defaultCollection,
                 const QString &curFile = lastShownPageList.at(curPage);
                 if (helpEngine.findFile(curFile).isValid()
                     || curFile == "about:blank"_L1) {
-                    m_model->addPage(curFile, zoomFactors.at(curPage).toFloat());
+                    // Only the current page is loaded, the others once
+                    // they are shown.
+                    m_model->addDeferredPage(curFile, titles.at(curPage),
+                                             zoomFactors.at(curPage).toFloat());
                 } else if (curPage <= initialPage && initialPage > 0)
                     --initialPage;
             }
@@ -256,6 +263,22 @@ void OpenPagesManager::setCurrentPage(HelpViewer *page)
     TRACE_OBJ
     CentralWidget::instance()->setCurrentPage(page);
     m_openPagesWidget->selectCurrentPage();
+    unloadInactivePages(page);
+}
+
+void OpenPagesManager::unloadInactivePages(HelpViewer *currentPage)
+{
+    TRACE_OBJ
+    m_recentPages.removeOne(currentPage);
+    m_recentPages.prepend(currentPage);
+    if (m_maxLoadedPages <= 0)
+        return;
+
+    int loadedPages = 0;
+    for (HelpViewer *page : std::as_const(m_recentPages)) {
+        if (page->isLoaded() && ++loadedPages > m_maxLoadedPages)
+            page->unload();
+    }
 }
 
 void OpenPagesManager::removePage(int index)
@@ -263,6 +286,7 @@ void OpenPagesManager::removePage(int index)
     TRACE_OBJ
     emit aboutToClosePage(index);
 
+    m_recentPages.removeOne(m_model->pageAt(index));
     CentralWidget::instance()->removePage(index);
     m_model->removePage(index);
     m_openPagesWidget->selectCurrentPage();
@@ -4,6 +4,7 @@
 #ifndef OPENPAGESMANAGER_H
 #define OPENPAGESMANAGER_H
 
+#include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
 
@@ -74,6 +75,7 @@ private:
 
     void nextOrPreviousPage(int offset);
     void showSwitcherOrSelectPage() const;
+    void unloadInactivePages(HelpViewer *currentPage);
 
     OpenPagesModel *m_model;
     OpenPagesWidget *m_openPagesWidget = nullptr;
@@ -81,6 +83,11 @@ private:
 
     QPointer<HelpViewer> m_helpPageViewer;
 
+    // The pages, most recently shown first, and how many of them keep
+    // their documents loaded; 0 means all of them.
+    QList<HelpViewer *> m_recentPages;
+    int m_maxLoadedPages = 0;
+
     static OpenPagesManager *m_instance;
 };
 
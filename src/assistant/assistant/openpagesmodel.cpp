@@ -42,6 +42,22 @@ QVariant OpenPagesModel::data(const QModelIndex &index, int role) const
 }
 
 HelpViewer *OpenPagesModel::addPage(const QUrl &url, qreal zoom)
+{
+    TRACE_OBJ
+    HelpViewer *page = createPage(zoom);
+    page->setSource(url);
+    return page;
+}
+
+HelpViewer *OpenPagesModel::addDeferredPage(const QUrl &url, const QString &title, qreal zoom)
+{
+    TRACE_OBJ
+    HelpViewer *page = createPage(zoom);
+    page->setSourceDeferred(url, title);
+    return page;
+}
+
+HelpViewer *OpenPagesModel::createPage(qreal zoom)
 {
     TRACE_OBJ
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
@@ -49,7 +65,6 @@ HelpViewer *OpenPagesModel::addPage(const QUrl &url, qreal zoom)
     connect(page, &HelpViewer::titleChanged, this, &OpenPagesModel::handleTitleChanged);
     m_pages << page;
     endInsertRows();
-    page->setSource(url);
     return page;
 }
 
@@ -10,6 +10,11 @@
 #include "helpenginewrapper.h"
 #include "qtdocinstaller.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -43,20 +48,59 @@ void QtDocInstaller::run()
     m_qchDir.setPath(QLibraryInfo::path(QLibraryInfo::DocumentationPath));
     m_qchFiles = m_qchDir.entryList(QStringList() << "*.qch"_L1);
 
-    bool changes = false;
+    QList<QchFile> qchFiles;
     for (const DocInfo &docInfo : std::as_const(m_docInfos)) {
-        changes |= installDoc(docInfo);
-        m_mutex.lock();
-        if (m_abort) {
-            m_mutex.unlock();
+        const QString fileName = qchFileToRegister(docInfo);
+        if (!fileName.isEmpty())
+            qchFiles.append({ docInfo.first, fileName, QString() });
+        if (isAborted())
             return;
-        }
-        m_mutex.unlock();
     }
+    const bool changes = !qchFiles.isEmpty();
+
+    // Opening a .qch file for its namespace takes most of the time, and
+    // the files do not depend on each other.
+    std::vector<QString> namespaces(qchFiles.size());
+    std::atomic<qsizetype> next = 0;
+    const auto worker = [&] {
+        for (qsizetype i = next++; i < qchFiles.size() && !isAborted(); i = next++)
+            namespaces[i] = QHelpEngineCore::namespaceName(qchFiles.at(i).fileName);
+    };
+    const qsizetype threadCount = std::min<qsizetype>(
+            std::max(1u, std::thread::hardware_concurrency()), qchFiles.size());
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (qsizetype t = 0; t < threadCount; ++t)
+        threads.emplace_back(worker);
+    for (std::thread &thread : threads)
+        thread.join();
+    if (isAborted())
+        return;
+
+    QList<QchFile> validQchFiles;
+    validQchFiles.reserve(qchFiles.size());
+    for (qsizetype i = 0; i < qchFiles.size(); ++i) {
+        if (namespaces[i].isEmpty())
+            continue;
+        qchFiles[i].namespaceName = std::move(namespaces[i]);
+        validQchFiles.append(std::move(qchFiles[i]));
+    }
+    if (!validQchFiles.isEmpty())
+        emit registerDocumentations(validQchFiles);
     emit docsInstalled(changes);
 }
 
-bool QtDocInstaller::installDoc(const DocInfo &docInfo)
+bool QtDocInstaller::isAborted()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_abort;
+}
+
+/*
+    Returns the absolute path of the .qch file of the component of
+    \a docInfo if it needs to be registered, or an empty string.
+*/
+QString QtDocInstaller::qchFileToRegister(const DocInfo &docInfo)
 {
     TRACE_OBJ
     const QString &component = docInfo.first;
@@ -71,21 +115,20 @@ bool QtDocInstaller::installDoc(const DocInfo &docInfo)
 
     if (m_qchFiles.isEmpty()) {
         emit qchFileNotFound(component);
-        return false;
+        return {};
     }
     for (const QString &f : std::as_const(m_qchFiles)) {
         if (f.startsWith(component)) {
             QFileInfo fi(m_qchDir.absolutePath() + QDir::separator() + f);
             if (dt.isValid() && fi.lastModified().toSecsSinceEpoch() == dt.toSecsSinceEpoch()
                 && qchFile == fi.absoluteFilePath())
-                return false;
-            emit registerDocumentation(component, fi.absoluteFilePath());
-            return true;
+                return {};
+            return fi.absoluteFilePath();
         }
     }
 
     emit qchFileNotFound(component);
-    return false;
+    return {};
 }
 
 QT_END_NAMESPACE
@@ -20,19 +20,25 @@ class QtDocInstaller : public QThread
 
 public:
     typedef QPair<QString, QStringList> DocInfo;
+    struct QchFile
+    {
+        QString component;
+        QString fileName;
+        QString namespaceName;
+    };
     QtDocInstaller(const QList<DocInfo> &docInfos);
     ~QtDocInstaller() override;
     void installDocs();
 
 signals:
     void qchFileNotFound(const QString &component);
-    void registerDocumentation(const QString &component,
-                               const QString &absFileName);
+    void registerDocumentations(const QList<QtDocInstaller::QchFile> &qchFiles);
     void docsInstalled(bool newDocsInstalled);
 
 private:
     void run() override;
-    bool installDoc(const DocInfo &docInfo);
+    QString qchFileToRegister(const DocInfo &docInfo);
+    bool isAborted();
 
     bool m_abort;
     QMutex m_mutex;
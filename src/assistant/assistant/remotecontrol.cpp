@@ -11,6 +11,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QFileSystemWatcher>
+#include <QtCore/QLoggingCategory>
 #include <QtCore/QTextStream>
 
 #include <QtWidgets/QMessageBox>
@@ -32,6 +33,9 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+// Reports how long the commands take, for tuning IDE integrations.
+Q_LOGGING_CATEGORY(lcRemoteControl, "qt.assistant.remotecontrol")
+
 RemoteControl::RemoteControl(MainWindow *mainWindow)
     : QObject(mainWindow)
     , m_mainWindow(mainWindow)
@@ -41,6 +45,10 @@ RemoteControl::RemoteControl(MainWindow *mainWindow)
     connect(m_mainWindow, &MainWindow::initDone,
             this, &RemoteControl::applyCache);
 
+    m_batchTimer.setSingleShot(true);
+    m_batchTimer.setInterval(BatchInterval);
+    connect(&m_batchTimer, &QTimer::timeout, this, &RemoteControl::applyCache);
+
     StdInListener *l = new StdInListener(this);
     connect(l, &StdInListener::receivedCommand,
             this, &RemoteControl::handleCommandString);
@@ -59,8 +67,15 @@ void RemoteControl::handleCommandString(const QString &cmdString)
             QMessageBox::information(nullptr, tr("Debugging Remote Control"),
                 tr("Received Command: %1 %2").arg(cmd).arg(arg));
 
+        QElapsedTimer timer;
+        timer.start();
+        if (m_caching && m_batchedCommands++ == 0)
+            m_batchLatency.start();
+
         if (cmd == "debug"_L1)
             handleDebugCommand(arg);
+         else if (cmd == "batch"_L1)
+            handleBatchCommand(arg);
          else if (cmd == "show"_L1)
             handleShowOrHideCommand(arg, true);
          else if (cmd == "hide"_L1)
@@ -83,7 +98,12 @@ void RemoteControl::handleCommandString(const QString &cmdString)
             handleUnregisterCommand(arg);
          else
             break;
+
+        qCDebug(lcRemoteControl, "%s: %lld ms%s", qPrintable(cmd), timer.elapsed(),
+                m_caching ? " (cached)" : "");
     }
+    if (m_batching && m_initialized)
+        m_batchTimer.start();
     m_mainWindow->raise();
     m_mainWindow->activateWindow();
 }
@@ -105,6 +125,18 @@ void RemoteControl::handleDebugCommand(const QString &arg)
     m_debug = arg == "on"_L1;
 }
 
+void RemoteControl::handleBatchCommand(const QString &arg)
+{
+    TRACE_OBJ
+    m_batching = arg == "on"_L1;
+    if (m_initialized && m_batching != m_caching) {
+        if (m_batching)
+            m_caching = true;
+        else
+            applyCache();
+    }
+}
+
 void RemoteControl::handleShowOrHideCommand(const QString &arg, bool show)
 {
     TRACE_OBJ
@@ -238,6 +270,10 @@ void RemoteControl::handleUnregisterCommand(const QString &arg)
 void RemoteControl::applyCache()
 {
     TRACE_OBJ
+    QElapsedTimer timer;
+    timer.start();
+    m_batchTimer.stop();
+
     if (m_setSource.isValid()) {
         CentralWidget::instance()->setSource(m_setSource);
     } else if (!m_activateKeyword.isEmpty()) {
@@ -259,7 +295,17 @@ void RemoteControl::applyCache()
     if (m_expandTOC != -2)
         m_mainWindow->expandTOC(m_expandTOC);
 
-    m_caching = false;
+    if (m_batchedCommands > 0) {
+        qCDebug(lcRemoteControl, "Applied %d cached commands: %lld ms after the first one, "
+                "applying took %lld ms", m_batchedCommands, m_batchLatency.elapsed(),
+                timer.elapsed());
+    }
+
+    clearCache();
+    m_expandTOC = -2;
+    m_batchedCommands = 0;
+    m_initialized = true;
+    m_caching = m_batching;
 }
 
 void RemoteControl::clearCache()
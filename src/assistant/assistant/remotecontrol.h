@@ -4,8 +4,10 @@
 #ifndef REMOTECONTROL_H
 #define REMOTECONTROL_H
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 
 QT_BEGIN_NAMESPACE
@@ -28,6 +30,7 @@ private:
     void clearCache();
     void splitInputString(const QString &input, QString &cmd, QString &arg);
     void handleDebugCommand(const QString &arg);
+    void handleBatchCommand(const QString &arg);
     void handleShowOrHideCommand(const QString &arg, bool show);
     void handleSetSourceCommand(const QString &arg);
     void handleSyncContentsCommand();
@@ -50,6 +53,16 @@ private:
 
     bool m_caching = true;
     bool m_syncContents = false;
+
+    // In batch mode, the commands received within BatchInterval of each
+    // other are cached like the ones received during startup, and applied
+    // together, so that only the last navigation is carried out.
+    static constexpr int BatchInterval = 50;
+    QTimer m_batchTimer;
+    QElapsedTimer m_batchLatency;
+    int m_batchedCommands = 0;
+    bool m_initialized = false;
+    bool m_batching = false;
 };
 
 QT_END_NAMESPACE
@@ -58,6 +58,10 @@ private:
 QHelpCollectionHandler::QHelpCollectionHandler(const QString &collectionFile, QObject *parent)
     : QObject(parent)
     , m_collectionFile(collectionFile)
+    , m_namespaceCache(NamespaceCacheSize)
+    , m_fileDataCache(FileDataCacheSize)
+    , m_readerCache(ReaderCacheSize)
+    , m_documentsCache(DocumentsCacheSize)
 {
     const QFileInfo fi(m_collectionFile);
     if (!fi.isAbsolute())
@@ -69,6 +73,17 @@ QHelpCollectionHandler::~QHelpCollectionHandler()
     closeDB();
 }
 
+void QHelpCollectionHandler::clearCaches()
+{
+    m_namespaceCache.clear();
+    m_fileDataCache.clear();
+    m_readerCache.clear();
+    m_filterNamespaces.reset();
+    m_indicesCache.clear();
+    m_contentsCache.clear();
+    m_documentsCache.clear();
+}
+
 bool QHelpCollectionHandler::isDBOpened() const
 {
     if (m_query)
@@ -80,9 +95,13 @@ bool QHelpCollectionHandler::isDBOpened() const
 
 void QHelpCollectionHandler::closeDB()
 {
+    clearCaches();
     if (!m_query)
         return;
 
+    // Leave no -wal and -shm files behind, readers may lack write access.
+    if (!m_readOnly)
+        m_query->exec("PRAGMA journal_mode=DELETE"_L1);
     m_query.reset();
     QSqlDatabase::removeDatabase(m_connectionName);
     m_connectionName.clear();
@@ -90,6 +109,7 @@ void QHelpCollectionHandler::closeDB()
 
 bool QHelpCollectionHandler::openCollectionFile()
 {
+    clearCaches();
     if (m_query)
         return true;
 
@@ -116,6 +136,9 @@ bool QHelpCollectionHandler::openCollectionFile()
     if (m_readOnly)
         return true;
 
+    // In WAL mode the read-only engines of other processes keep reading
+    // the collection while this one writes to it.
+    m_query->exec("PRAGMA journal_mode=WAL"_L1);
     m_query->exec("PRAGMA synchronous=OFF"_L1);
     m_query->exec("PRAGMA cache_size=3000"_L1);
 
@@ -295,6 +318,7 @@ void QHelpCollectionHandler::execVacuum()
 
 bool QHelpCollectionHandler::copyCollectionFile(const QString &fileName)
 {
+    clearCaches();
     if (!m_query)
         return false;
 
@@ -328,57 +352,60 @@ bool QHelpCollectionHandler::copyCollectionFile(const QString &fileName)
         return false;
     }
 
-    const QString &oldBaseDir = QFileInfo(collectionFile()).absolutePath();
-    const QFileInfo newColFi(colFile);
-    m_query->exec("SELECT Name, FilePath FROM NamespaceTable"_L1);
-    while (m_query->next()) {
-        copyQuery.prepare("INSERT INTO NamespaceTable VALUES(NULL, ?, ?)"_L1);
-        copyQuery.bindValue(0, m_query->value(0).toString());
-        QString oldFilePath = m_query->value(1).toString();
-        if (!QDir::isAbsolutePath(oldFilePath))
-            oldFilePath = oldBaseDir + u'/' + oldFilePath;
-        copyQuery.bindValue(1, newColFi.absoluteDir().relativeFilePath(oldFilePath));
-        copyQuery.exec();
-    }
-
-    m_query->exec("SELECT NamespaceId, Name FROM FolderTable"_L1);
-    while (m_query->next()) {
-        copyQuery.prepare("INSERT INTO FolderTable VALUES(NULL, ?, ?)"_L1);
-        copyQuery.bindValue(0, m_query->value(0).toString());
-        copyQuery.bindValue(1, m_query->value(1).toString());
-        copyQuery.exec();
-    }
-
-    m_query->exec("SELECT Name FROM FilterAttributeTable"_L1);
-    while (m_query->next()) {
-        copyQuery.prepare("INSERT INTO FilterAttributeTable VALUES(NULL, ?)"_L1);
-        copyQuery.bindValue(0, m_query->value(0).toString());
-        copyQuery.exec();
+    /*
+      The tables are copied by SQL statements on the attached collection,
+      in one transaction, instead of reading the rows here and inserting
+      them one by one. Only the namespaces are copied row by row, since the
+      paths of their files are relative to the collection file.
+    */
+    const QFileInfo oldColFi(collectionFile());
+    copyQuery.prepare("ATTACH DATABASE ? AS source"_L1);
+    copyQuery.bindValue(0, oldColFi.absoluteFilePath());
+    if (!copyQuery.exec()) {
+        emit error(tr("Cannot copy collection file: %1").arg(colFile));
+        return false;
     }
 
-    m_query->exec("SELECT Name FROM FilterNameTable"_L1);
-    while (m_query->next()) {
-        copyQuery.prepare("INSERT INTO FilterNameTable VALUES(NULL, ?)"_L1);
-        copyQuery.bindValue(0, m_query->value(0).toString());
-        copyQuery.exec();
-    }
+    bool ok = true;
+    {
+        Transaction transaction(connectionName);
+        const QString &oldBaseDir = oldColFi.absolutePath();
+        const QDir newColDir = QFileInfo(colFile).absoluteDir();
+        m_query->exec("SELECT Name, FilePath FROM NamespaceTable"_L1);
+        copyQuery.prepare("INSERT INTO NamespaceTable VALUES(NULL, ?, ?)"_L1);
+        while (ok && m_query->next()) {
+            copyQuery.bindValue(0, m_query->value(0).toString());
+            QString oldFilePath = m_query->value(1).toString();
+            if (!QDir::isAbsolutePath(oldFilePath))
+                oldFilePath = oldBaseDir + u'/' + oldFilePath;
+            copyQuery.bindValue(1, newColDir.relativeFilePath(oldFilePath));
+            ok = copyQuery.exec();
+        }
 
-    m_query->exec("SELECT NameId, FilterAttributeId FROM FilterTable"_L1);
-    while (m_query->next()) {
-        copyQuery.prepare("INSERT INTO FilterTable VALUES(?, ?)"_L1);
-        copyQuery.bindValue(0, m_query->value(0).toInt());
-        copyQuery.bindValue(1, m_query->value(1).toInt());
-        copyQuery.exec();
+        const QLatin1StringView copies[] = {
+            "INSERT INTO FolderTable "
+                "SELECT NULL, NamespaceId, Name FROM source.FolderTable ORDER BY Id"_L1,
+            "INSERT INTO FilterAttributeTable "
+                "SELECT NULL, Name FROM source.FilterAttributeTable ORDER BY Id"_L1,
+            "INSERT INTO FilterNameTable "
+                "SELECT NULL, Name FROM source.FilterNameTable ORDER BY Id"_L1,
+            "INSERT INTO FilterTable "
+                "SELECT NameId, FilterAttributeId FROM source.FilterTable"_L1,
+            "INSERT INTO SettingsTable "
+                "SELECT Key, Value FROM source.SettingsTable "
+                "WHERE Key <> 'FTS5IndexedNamespaces'"_L1
+        };
+        for (const QLatin1StringView copy : copies) {
+            if (ok)
+                ok = copyQuery.exec(copy);
+        }
+        if (ok)
+            transaction.commit();
     }
-
-    m_query->exec("SELECT Key, Value FROM SettingsTable"_L1);
-    while (m_query->next()) {
-        if (m_query->value(0).toString() == "FTS5IndexedNamespaces"_L1)
-            continue;
-        copyQuery.prepare("INSERT INTO SettingsTable VALUES(?, ?)"_L1);
-        copyQuery.bindValue(0, m_query->value(0).toString());
-        copyQuery.bindValue(1, m_query->value(1));
-        copyQuery.exec();
+    copyQuery.exec("DETACH DATABASE source"_L1);
+    if (!ok) {
+        emit error(tr("Cannot copy collection file: %1").arg(colFile));
+        return false;
     }
 
     copyQuery.clear();
@@ -662,6 +689,7 @@ bool QHelpCollectionHandler::setFilterData(const QString &filterName,
 
 bool QHelpCollectionHandler::removeFilter(const QString &filterName)
 {
+    clearCaches();
     m_query->prepare("SELECT FilterId FROM Filter WHERE Name = ?"_L1);
     m_query->bindValue(0, filterName);
     if (!m_query->exec())
@@ -692,6 +720,7 @@ bool QHelpCollectionHandler::removeFilter(const QString &filterName)
 
 bool QHelpCollectionHandler::removeCustomFilter(const QString &filterName)
 {
+    clearCaches();
     if (!isDBOpened() || filterName.isEmpty())
         return false;
 
@@ -721,6 +750,7 @@ bool QHelpCollectionHandler::removeCustomFilter(const QString &filterName)
 bool QHelpCollectionHandler::addCustomFilter(const QString &filterName,
                                              const QStringList &attributes)
 {
+    clearCaches();
     if (!isDBOpened() || filterName.isEmpty())
         return false;
 
@@ -834,6 +864,7 @@ QHelpCollectionHandler::FileInfoList QHelpCollectionHandler::registeredDocumenta
 
 bool QHelpCollectionHandler::registerDocumentation(const QString &fileName)
 {
+    clearCaches();
     if (!isDBOpened())
         return false;
 
@@ -869,8 +900,36 @@ bool QHelpCollectionHandler::registerDocumentation(const QString &fileName)
     return true;
 }
 
+/*
+    Registers the \a fileNames in one transaction, so that the collection
+    is only written to disk once. Each file is registered in a savepoint of
+    its own, so that a file that cannot be registered leaves nothing behind.
+    Returns the files that were registered.
+*/
+QStringList QHelpCollectionHandler::registerDocumentations(const QStringList &fileNames)
+{
+    QStringList registered;
+    if (!isDBOpened())
+        return registered;
+
+    Transaction transaction(m_connectionName);
+    QSqlQuery savepoint(QSqlDatabase::database(m_connectionName));
+    for (const QString &fileName : fileNames) {
+        savepoint.exec("SAVEPOINT registerDocumentation"_L1);
+        if (registerDocumentation(fileName))
+            registered.append(fileName);
+        else
+            savepoint.exec("ROLLBACK TO SAVEPOINT registerDocumentation"_L1);
+        savepoint.exec("RELEASE SAVEPOINT registerDocumentation"_L1);
+    }
+    transaction.commit();
+    clearCaches();
+    return registered;
+}
+
 bool QHelpCollectionHandler::unregisterDocumentation(const QString &namespaceName)
 {
+    clearCaches();
     if (!isDBOpened())
         return false;
 
@@ -968,67 +1027,118 @@ bool QHelpCollectionHandler::fileExists(const QUrl &url) const
     return count;
 }
 
-static QString prepareFilterQuery(const QString &filterName)
+/*
+  Returns which registered namespaces match each filter. The matching
+  is done once over the component and version tables, by combining one
+  bit array per component and per version, so that the filter queries
+  only need to compare namespace ids. Like in the previous SQL joins, a
+  NULL component or version of a filter matches a NULL one of a namespace,
+  but not an empty one.
+*/
+const QHelpCollectionHandler::FilterNamespaces &QHelpCollectionHandler::filterNamespaces() const
 {
-    if (filterName.isEmpty())
-        return {};
+    if (m_filterNamespaces)
+        return *m_filterNamespaces;
 
-    return " AND EXISTS(SELECT * FROM Filter WHERE Filter.Name = ?) "
-        "AND ("
-        "(NOT EXISTS(" // 1. filter by component
-        "SELECT * FROM "
-            "ComponentFilter, "
-            "Filter "
-        "WHERE ComponentFilter.FilterId = Filter.FilterId "
-            "AND Filter.Name = ?) "
-        "OR NamespaceTable.Id IN ("
-        "SELECT "
-            "NamespaceTable.Id "
-        "FROM "
-            "NamespaceTable, "
-            "ComponentTable, "
-            "ComponentMapping, "
-            "ComponentFilter, "
-            "Filter "
-        "WHERE ComponentMapping.NamespaceId = NamespaceTable.Id "
-            "AND ComponentTable.ComponentId = ComponentMapping.ComponentId "
-            "AND ((ComponentTable.Name = ComponentFilter.ComponentName) "
-                "OR (ComponentTable.Name IS NULL AND ComponentFilter.ComponentName IS NULL)) "
-            "AND ComponentFilter.FilterId = Filter.FilterId "
-            "AND Filter.Name = ?))"
-        " AND "
-        "(NOT EXISTS(" // 2. filter by version
-        "SELECT * FROM "
-            "VersionFilter, "
-            "Filter "
-        "WHERE VersionFilter.FilterId = Filter.FilterId "
-            "AND Filter.Name = ?) "
-        "OR NamespaceTable.Id IN ("
-        "SELECT "
-            "NamespaceTable.Id "
-        "FROM "
-            "NamespaceTable, "
-            "VersionFilter, "
-            "VersionTable, "
-            "Filter "
-        "WHERE VersionFilter.FilterId = Filter.FilterId "
-            "AND ((VersionFilter.Version = VersionTable.Version) "
-                "OR (VersionFilter.Version IS NULL AND VersionTable.Version IS NULL)) "
-            "AND VersionTable.NamespaceId = NamespaceTable.Id "
-            "AND Filter.Name = ?))"
-        ")"_L1;
+    FilterNamespaces &result = m_filterNamespaces.emplace();
+
+    QHash<int, qsizetype> namespaceIndex;
+    m_query->exec("SELECT Id, Name FROM NamespaceTable ORDER BY Id"_L1);
+    while (m_query->next()) {
+        const int namespaceId = m_query->value(0).toInt();
+        namespaceIndex.insert(namespaceId, result.namespaceIds.size());
+        result.namespaceIds.append(namespaceId);
+        result.namespaceNames.append(m_query->value(1).toString());
+    }
+    const qsizetype namespaceCount = result.namespaceIds.size();
+
+    // NULL and empty values get different keys, as SQL compares them.
+    const auto key = [](const QVariant &value) {
+        return value.isNull() ? QString() : u'=' + value.toString();
+    };
+    const auto namespacesByKey = [&](const QString &query) {
+        QHash<QString, QBitArray> masks;
+        m_query->exec(query);
+        while (m_query->next()) {
+            const qsizetype index = namespaceIndex.value(m_query->value(0).toInt(), -1);
+            if (index < 0)
+                continue;
+            const QString valueKey = key(m_query->value(1));
+            auto it = masks.find(valueKey);
+            if (it == masks.end())
+                it = masks.insert(valueKey, QBitArray(namespaceCount));
+            it->setBit(index);
+        }
+        return masks;
+    };
+    const QHash<QString, QBitArray> componentNamespaces = namespacesByKey(
+            "SELECT ComponentMapping.NamespaceId, ComponentTable.Name "
+            "FROM ComponentMapping, ComponentTable "
+            "WHERE ComponentMapping.ComponentId = ComponentTable.ComponentId"_L1);
+    const QHash<QString, QBitArray> versionNamespaces = namespacesByKey(
+            "SELECT NamespaceId, Version FROM VersionTable"_L1);
+
+    const auto namespacesByFilterId = [&](const QString &query,
+                                          const QHash<QString, QBitArray> &keyNamespaces) {
+        QHash<int, QBitArray> masks;
+        m_query->exec(query);
+        while (m_query->next()) {
+            const int filterId = m_query->value(0).toInt();
+            auto it = masks.find(filterId);
+            if (it == masks.end())
+                it = masks.insert(filterId, QBitArray(namespaceCount));
+            *it |= keyNamespaces.value(key(m_query->value(1)), QBitArray(namespaceCount));
+        }
+        return masks;
+    };
+    const QHash<int, QBitArray> componentFilters = namespacesByFilterId(
+            "SELECT FilterId, ComponentName FROM ComponentFilter"_L1, componentNamespaces);
+    const QHash<int, QBitArray> versionFilters = namespacesByFilterId(
+            "SELECT FilterId, Version FROM VersionFilter"_L1, versionNamespaces);
+
+    // A filter without components or without versions does not restrict them.
+    m_query->exec("SELECT FilterId, Name FROM Filter"_L1);
+    while (m_query->next()) {
+        const int filterId = m_query->value(0).toInt();
+        QBitArray mask(namespaceCount, true);
+        if (const auto it = componentFilters.constFind(filterId); it != componentFilters.cend())
+            mask &= *it;
+        if (const auto it = versionFilters.constFind(filterId); it != versionFilters.cend())
+            mask &= *it;
+        result.filterMasks.insert(m_query->value(1).toString(), mask);
+    }
+    m_query->clear();
+
+    return result;
 }
 
-static void bindFilterQuery(QSqlQuery *query, int bindStart, const QString &filterName)
+/*
+  Returns the bits of the namespaces, in the order of
+  FilterNamespaces::namespaceIds, that match \a filterName. No filter
+  matches all namespaces, an unknown one matches none.
+*/
+QBitArray QHelpCollectionHandler::namespaceMaskForFilter(const QString &filterName) const
 {
+    const FilterNamespaces &namespaces = filterNamespaces();
     if (filterName.isEmpty())
-        return;
+        return QBitArray(namespaces.namespaceIds.size(), true);
+    return namespaces.filterMasks.value(filterName,
+                                        QBitArray(namespaces.namespaceIds.size()));
+}
 
-    query->bindValue(bindStart, filterName);
-    query->bindValue(bindStart + 1, filterName);
-    query->bindValue(bindStart + 2, filterName);
-    query->bindValue(bindStart + 3, filterName);
-    query->bindValue(bindStart + 4, filterName);
+QString QHelpCollectionHandler::namespaceFilterQuery(const QString &filterName) const
+{
+    if (filterName.isEmpty())
+        return {};
+
+    const QList<int> &namespaceIds = filterNamespaces().namespaceIds;
+    const QBitArray mask = namespaceMaskForFilter(filterName);
+    QStringList ids;
+    for (qsizetype i = 0; i < namespaceIds.size(); ++i) {
+        if (mask.testBit(i))
+            ids.append(QString::number(namespaceIds.at(i)));
+    }
+    return " AND NamespaceTable.Id IN (%1)"_L1.arg(ids.join(u','));
 }
 
 static QString prepareFilterQuery(int attributesCount,
@@ -1145,6 +1255,21 @@ QString QHelpCollectionHandler::namespaceForFile(const QUrl &url,
     if (!isDBOpened())
         return {};
 
+    const QString cacheKey = url.toString() + u'\n' + filterName;
+    if (const QString *namespaceName = m_namespaceCache.object(cacheKey)) {
+        ++m_cacheStatistics.hits;
+        return *namespaceName;
+    }
+    ++m_cacheStatistics.misses;
+
+    const QString namespaceName = resolveNamespaceForFile(url, filterName);
+    m_namespaceCache.insert(cacheKey, new QString(namespaceName));
+    return namespaceName;
+}
+
+QString QHelpCollectionHandler::resolveNamespaceForFile(const QUrl &url,
+                                                        const QString &filterName) const
+{
     const FileInfo fileInfo = extractFileInfo(url);
     if (fileInfo.namespaceName.isEmpty())
         return {};
@@ -1162,12 +1287,11 @@ QString QHelpCollectionHandler::namespaceForFile(const QUrl &url,
         "AND FolderTable.NamespaceId = NamespaceTable.Id"_L1;
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + namespaceFilterQuery(filterName);
 
     m_query->prepare(filterQuery);
     m_query->bindValue(0, fileInfo.folderName);
     m_query->bindValue(1, fileInfo.fileName);
-    bindFilterQuery(m_query.get(), 2, filterName);
 
     if (!m_query->exec())
         return {};
@@ -1259,17 +1383,12 @@ QStringList QHelpCollectionHandler::files(const QString &namespaceName,
         "AND NamespaceTable.Name = ?"_L1 + extensionQuery;
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + namespaceFilterQuery(filterName);
 
     m_query->prepare(filterQuery);
     m_query->bindValue(0, namespaceName);
-    int bindCount = 1;
-    if (!extensionFilter.isEmpty()) {
-        m_query->bindValue(bindCount, "%.%1"_L1.arg(extensionFilter));
-        ++bindCount;
-    }
-
-    bindFilterQuery(m_query.get(), bindCount, filterName);
+    if (!extensionFilter.isEmpty())
+        m_query->bindValue(1, "%.%1"_L1.arg(extensionFilter));
 
     if (!m_query->exec())
         return{};
@@ -1313,6 +1432,20 @@ QByteArray QHelpCollectionHandler::fileData(const QUrl &url) const
     if (!isDBOpened())
         return {};
 
+    if (const QByteArray *data = m_fileDataCache.object(url)) {
+        ++m_cacheStatistics.hits;
+        return *data;
+    }
+    ++m_cacheStatistics.misses;
+
+    const QByteArray data = readFileData(url);
+    if (!data.isEmpty())
+        m_fileDataCache.insert(url, new QByteArray(data), data.size());
+    return data;
+}
+
+QByteArray QHelpCollectionHandler::readFileData(const QUrl &url) const
+{
     const QString namespaceName = namespaceForFile(url, QString());
     if (namespaceName.isEmpty())
         return {};
@@ -1322,12 +1455,18 @@ QByteArray QHelpCollectionHandler::fileData(const QUrl &url) const
     const FileInfo docInfo = registeredDocumentation(namespaceName);
     const QString absFileName = absoluteDocPath(docInfo.fileName);
 
-    QHelpDBReader reader(absFileName, QHelpGlobal::uniquifyConnectionName(
-                         docInfo.fileName, const_cast<QHelpCollectionHandler *>(this)), nullptr);
-    if (!reader.init())
-        return {};
+    QHelpDBReader *reader = m_readerCache.object(absFileName);
+    if (!reader) {
+        auto newReader = std::make_unique<QHelpDBReader>(
+                absFileName, QHelpGlobal::uniquifyConnectionName(
+                        docInfo.fileName, const_cast<QHelpCollectionHandler *>(this)), nullptr);
+        if (!newReader->init())
+            return {};
+        reader = newReader.get();
+        m_readerCache.insert(absFileName, newReader.release());
+    }
 
-    return reader.fileData(fileInfo.folderName, fileInfo.fileName);
+    return reader->fileData(fileInfo.folderName, fileInfo.fileName);
 }
 
 QStringList QHelpCollectionHandler::indicesForFilter(const QStringList &filterAttributes) const
@@ -1373,6 +1512,9 @@ QStringList QHelpCollectionHandler::indicesForFilter(const QString &filterName)
     if (!isDBOpened())
         return indices;
 
+    if (const auto it = m_indicesCache.constFind(filterName); it != m_indicesCache.cend())
+        return *it;
+
     const QString filterlessQuery =
         "SELECT DISTINCT "
             "IndexTable.Name "
@@ -1386,17 +1528,17 @@ QStringList QHelpCollectionHandler::indicesForFilter(const QString &filterName)
         "AND IndexTable.NamespaceId = NamespaceTable.Id"_L1;
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName)
+            + namespaceFilterQuery(filterName)
             + " ORDER BY LOWER(IndexTable.Name), IndexTable.Name"_L1;
 
     m_query->prepare(filterQuery);
-    bindFilterQuery(m_query.get(), 0, filterName);
 
     m_query->exec();
 
     while (m_query->next())
         indices.append(m_query->value(0).toString());
 
+    m_indicesCache.insert(filterName, indices);
     return indices;
 }
 
@@ -1482,6 +1624,9 @@ QList<QHelpCollectionHandler::ContentsData> QHelpCollectionHandler::contentsForF
     if (!isDBOpened())
         return {};
 
+    if (const auto it = m_contentsCache.constFind(filterName); it != m_contentsCache.cend())
+        return *it;
+
     const QString filterlessQuery =
         "SELECT DISTINCT "
             "NamespaceTable.Name, "
@@ -1498,10 +1643,9 @@ QList<QHelpCollectionHandler::ContentsData> QHelpCollectionHandler::contentsForF
         "AND ContentsTable.NamespaceId = NamespaceTable.Id "
         "AND VersionTable.NamespaceId = NamespaceTable.Id"_L1;
 
-    const QString filterQuery = filterlessQuery + prepareFilterQuery(filterName);
+    const QString filterQuery = filterlessQuery + namespaceFilterQuery(filterName);
 
     m_query->prepare(filterQuery);
-    bindFilterQuery(m_query.get(), 0, filterName);
 
     m_query->exec();
 
@@ -1531,6 +1675,7 @@ QList<QHelpCollectionHandler::ContentsData> QHelpCollectionHandler::contentsForF
             result.append(it.value());
         }
     }
+    m_contentsCache.insert(filterName, result);
     return result;
 }
 
@@ -1804,6 +1949,7 @@ int QHelpCollectionHandler::registerVirtualFolder(const QString &folderName, int
 
 int QHelpCollectionHandler::registerComponent(const QString &componentName, int namespaceId)
 {
+    clearCaches();
     m_query->prepare("SELECT ComponentId FROM ComponentTable WHERE Name = ?"_L1);
     m_query->bindValue(0, componentName);
     if (!m_query->exec())
@@ -1837,6 +1983,8 @@ bool QHelpCollectionHandler::registerVersion(const QString &version, int namespa
     if (!m_query)
         return false;
 
+    clearCaches();
+
     m_query->prepare("INSERT INTO VersionTable (NamespaceId, Version) VALUES(?, ?)"_L1);
     m_query->addBindValue(namespaceId);
     m_query->addBindValue(version);
@@ -2232,49 +2380,99 @@ QList<QHelpLink> QHelpCollectionHandler::documentsForKeyword(
 QList<QHelpLink> QHelpCollectionHandler::documentsForField(const QString &fieldName,
         const QString &fieldValue, const QStringList &filterAttributes) const
 {
-    if (!isDBOpened())
-        return {};
-
-    const QString filterlessQuery =
-        "SELECT "
-            "FileNameTable.Title, "
-            "NamespaceTable.Name, "
-            "FolderTable.Name, "
-            "FileNameTable.Name, "
-            "IndexTable.Anchor "
-        "FROM "
-            "IndexTable, "
-            "FileNameTable, "
-            "FolderTable, "
-            "NamespaceTable "
-        "WHERE IndexTable.FileId = FileNameTable.FileId "
-        "AND FileNameTable.FolderId = FolderTable.Id "
-        "AND IndexTable.NamespaceId = NamespaceTable.Id "
-        "AND IndexTable.%1 = ?"_L1.arg(fieldName);
+    return documentsForFields(fieldName, { fieldValue }, filterAttributes).value(fieldValue);
+}
 
-    const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterAttributes.size(), "IndexTable"_L1, "Id"_L1,
-                                 "IndexFilterTable"_L1, "IndexId"_L1);
+QHash<QString, QList<QHelpLink>> QHelpCollectionHandler::documentsForIdentifiers(
+        const QStringList &ids, const QStringList &filterAttributes) const
+{
+    return documentsForFields("Identifier"_L1, ids, filterAttributes);
+}
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fieldValue);
-    bindFilterQuery(m_query.get(), 1, filterAttributes);
+QHash<QString, QList<QHelpLink>> QHelpCollectionHandler::documentsForKeywords(
+        const QStringList &keywords, const QStringList &filterAttributes) const
+{
+    return documentsForFields("Name"_L1, keywords, filterAttributes);
+}
 
-    m_query->exec();
+// The values are looked up in chunks, to stay below the limit of SQLite
+// for the number of bound values in a statement.
+static constexpr qsizetype FieldValuesPerQuery = 256;
 
-    QList<QHelpLink> docList;
-    while (m_query->next()) {
-        QString title = m_query->value(0).toString();
+static QString fieldValuesQuery(const QString &fieldName, qsizetype count)
+{
+    QString placeholders;
+    placeholders.reserve(count * 2);
+    for (qsizetype i = 0; i < count; ++i) {
+        if (i > 0)
+            placeholders.append(u',');
+        placeholders.append(u'?');
+    }
+
+    return "SELECT "
+               "FileNameTable.Title, "
+               "NamespaceTable.Name, "
+               "FolderTable.Name, "
+               "FileNameTable.Name, "
+               "IndexTable.Anchor, "
+               "IndexTable.%1 "
+           "FROM "
+               "IndexTable, "
+               "FileNameTable, "
+               "FolderTable, "
+               "NamespaceTable "
+           "WHERE IndexTable.FileId = FileNameTable.FileId "
+           "AND FileNameTable.FolderId = FolderTable.Id "
+           "AND IndexTable.NamespaceId = NamespaceTable.Id "
+           "AND IndexTable.%1 IN (%2)"_L1.arg(fieldName, placeholders);
+}
+
+static void readDocuments(QSqlQuery *query, QHash<QString, QList<QHelpLink>> *documents)
+{
+    while (query->next()) {
+        const QString fieldValue = query->value(5).toString();
+        QString title = query->value(0).toString();
         if (title.isEmpty()) // generate a title + corresponding path
-            title = fieldValue + " : "_L1 + m_query->value(3).toString();
+            title = fieldValue + " : "_L1 + query->value(3).toString();
+
+        const QUrl url = QHelpCollectionHandler::buildQUrl(query->value(1).toString(),
+                                                           query->value(2).toString(),
+                                                           query->value(3).toString(),
+                                                           query->value(4).toString());
+        (*documents)[fieldValue].append(QHelpLink {url, title});
+    }
+}
+
+/*
+  Returns the documents for each of \a fieldValues that has any, running
+  one query for many values instead of one per value.
+*/
+QHash<QString, QList<QHelpLink>> QHelpCollectionHandler::documentsForFields(
+        const QString &fieldName, const QStringList &fieldValues,
+        const QStringList &filterAttributes) const
+{
+    if (!isDBOpened())
+        return {};
+
+    QStringList values = fieldValues;
+    values.removeDuplicates();
 
-        const QUrl url = buildQUrl(m_query->value(1).toString(),
-                                   m_query->value(2).toString(),
-                                   m_query->value(3).toString(),
-                                   m_query->value(4).toString());
-        docList.append(QHelpLink {url, title});
+    QHash<QString, QList<QHelpLink>> documents;
+    for (qsizetype first = 0; first < values.size(); first += FieldValuesPerQuery) {
+        const QStringList chunk = values.mid(first, FieldValuesPerQuery);
+        const QString filterQuery = fieldValuesQuery(fieldName, chunk.size())
+                + prepareFilterQuery(filterAttributes.size(), "IndexTable"_L1, "Id"_L1,
+                                     "IndexFilterTable"_L1, "IndexId"_L1);
+
+        m_query->prepare(filterQuery);
+        for (qsizetype i = 0; i < chunk.size(); ++i)
+            m_query->bindValue(int(i), chunk.at(i));
+        bindFilterQuery(m_query.get(), int(chunk.size()), filterAttributes);
+
+        m_query->exec();
+        readDocuments(m_query.get(), &documents);
     }
-    return docList;
+    return documents;
 }
 
 QList<QHelpLink> QHelpCollectionHandler::documentsForIdentifier(
@@ -2301,50 +2499,74 @@ QMultiMap<QString, QUrl> QHelpCollectionHandler::linksForField(const QString &fi
 
 QList<QHelpLink> QHelpCollectionHandler::documentsForField(const QString &fieldName,
         const QString &fieldValue, const QString &filterName) const
+{
+    return documentsForFields(fieldName, { fieldValue }, filterName).value(fieldValue);
+}
+
+QHash<QString, QList<QHelpLink>> QHelpCollectionHandler::documentsForIdentifiers(
+        const QStringList &ids, const QString &filterName) const
+{
+    return documentsForFields("Identifier"_L1, ids, filterName);
+}
+
+QHash<QString, QList<QHelpLink>> QHelpCollectionHandler::documentsForKeywords(
+        const QStringList &keywords, const QString &filterName) const
+{
+    return documentsForFields("Name"_L1, keywords, filterName);
+}
+
+/*
+  Returns the documents for each of \a fieldValues that has any. Values
+  whose documents are cached for \a filterName are not looked up again,
+  the others are looked up with one query for many values.
+*/
+QHash<QString, QList<QHelpLink>> QHelpCollectionHandler::documentsForFields(
+        const QString &fieldName, const QStringList &fieldValues,
+        const QString &filterName) const
 {
     if (!isDBOpened())
         return {};
 
-    const QString filterlessQuery =
-        "SELECT "
-            "FileNameTable.Title, "
-            "NamespaceTable.Name, "
-            "FolderTable.Name, "
-            "FileNameTable.Name, "
-            "IndexTable.Anchor "
-        "FROM "
-            "IndexTable, "
-            "FileNameTable, "
-            "FolderTable, "
-            "NamespaceTable "
-        "WHERE IndexTable.FileId = FileNameTable.FileId "
-        "AND FileNameTable.FolderId = FolderTable.Id "
-        "AND IndexTable.NamespaceId = NamespaceTable.Id "
-        "AND IndexTable.%1 = ?"_L1.arg(fieldName);
-
-    const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName)
-            + " ORDER BY LOWER(FileNameTable.Title), FileNameTable.Title"_L1;
+    const auto cacheKey = [&](const QString &fieldValue) {
+        return fieldName + u'\n' + filterName + u'\n' + fieldValue;
+    };
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fieldValue);
-    bindFilterQuery(m_query.get(), 1, filterName);
+    QHash<QString, QList<QHelpLink>> documents;
+    QStringList values;
+    for (const QString &fieldValue : fieldValues) {
+        if (const QList<QHelpLink> *cached = m_documentsCache.object(cacheKey(fieldValue))) {
+            if (!cached->isEmpty())
+                documents.insert(fieldValue, *cached);
+        } else {
+            values.append(fieldValue);
+        }
+    }
+    values.removeDuplicates();
+    if (values.isEmpty())
+        return documents;
 
-    m_query->exec();
+    const QString namespaceQuery = namespaceFilterQuery(filterName)
+            + " ORDER BY LOWER(FileNameTable.Title), FileNameTable.Title"_L1;
+    QHash<QString, QList<QHelpLink>> found;
+    for (qsizetype first = 0; first < values.size(); first += FieldValuesPerQuery) {
+        const QStringList chunk = values.mid(first, FieldValuesPerQuery);
+        m_query->prepare(fieldValuesQuery(fieldName, chunk.size()) + namespaceQuery);
+        for (qsizetype i = 0; i < chunk.size(); ++i)
+            m_query->bindValue(int(i), chunk.at(i));
 
-    QList<QHelpLink> docList;
-    while (m_query->next()) {
-        QString title = m_query->value(0).toString();
-        if (title.isEmpty()) // generate a title + corresponding path
-            title = fieldValue + " : "_L1 + m_query->value(3).toString();
+        m_query->exec();
+        readDocuments(m_query.get(), &found);
+    }
 
-        const QUrl url = buildQUrl(m_query->value(1).toString(),
-                                   m_query->value(2).toString(),
-                                   m_query->value(3).toString(),
-                                   m_query->value(4).toString());
-        docList.append(QHelpLink {url, title});
+    // Values without documents are cached as well, since most of the
+    // symbols an IDE asks for are not documented.
+    for (const QString &fieldValue : std::as_const(values)) {
+        const QList<QHelpLink> links = found.value(fieldValue);
+        m_documentsCache.insert(cacheKey(fieldValue), new QList<QHelpLink>(links));
+        if (!links.isEmpty())
+            documents.insert(fieldValue, links);
     }
-    return docList;
+    return documents;
 }
 
 QStringList QHelpCollectionHandler::namespacesForFilter(const QString &filterName) const
@@ -2354,23 +2576,12 @@ QStringList QHelpCollectionHandler::namespacesForFilter(const QString &filterNam
     if (!isDBOpened())
         return namespaceList;
 
-    const QString filterlessQuery =
-        "SELECT "
-            "NamespaceTable.Name "
-        "FROM "
-            "NamespaceTable "
-        "WHERE TRUE"_L1;
-
-    const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
-
-    m_query->prepare(filterQuery);
-    bindFilterQuery(m_query.get(), 0, filterName);
-
-    m_query->exec();
-
-    while (m_query->next())
-        namespaceList.append(m_query->value(0).toString());
+    const QStringList &namespaceNames = filterNamespaces().namespaceNames;
+    const QBitArray mask = namespaceMaskForFilter(filterName);
+    for (qsizetype i = 0; i < namespaceNames.size(); ++i) {
+        if (mask.testBit(i))
+            namespaceList.append(namespaceNames.at(i));
+    }
     return namespaceList;
 }
 
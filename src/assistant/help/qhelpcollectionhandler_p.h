@@ -18,9 +18,15 @@
 #include "qhelpdbreader_p.h"
 #include "qhelplink.h"
 
+#include <QtCore/qbitarray.h>
+#include <QtCore/qcache.h>
 #include <QtCore/qdatetime.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qstringlist.h>
+#include <QtCore/qurl.h>
+
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -58,6 +64,12 @@ public:
         QList<QByteArray> contentsList;
     };
 
+    struct CacheStatistics
+    {
+        qint64 hits = 0;
+        qint64 misses = 0;
+    };
+
     explicit QHelpCollectionHandler(const QString &collectionFile, QObject *parent = nullptr);
     ~QHelpCollectionHandler();
 
@@ -119,6 +131,7 @@ public:
     FileInfo registeredDocumentation(const QString &namespaceName) const;
     FileInfoList registeredDocumentations() const;
     bool registerDocumentation(const QString &fileName);
+    QStringList registerDocumentations(const QStringList &fileNames);
     bool unregisterDocumentation(const QString &namespaceName);
 
     bool fileExists(const QUrl &url) const;
@@ -147,11 +160,21 @@ public:
                                             const QStringList &filterAttributes) const;
     QList<QHelpLink> documentsForKeyword(const QString &keyword,
                                          const QStringList &filterAttributes) const;
+    QHash<QString, QList<QHelpLink>> documentsForIdentifiers(const QStringList &ids,
+                                                             const QString &filterName) const;
+    QHash<QString, QList<QHelpLink>> documentsForKeywords(const QStringList &keywords,
+                                                          const QString &filterName) const;
+    QHash<QString, QList<QHelpLink>> documentsForIdentifiers(
+            const QStringList &ids, const QStringList &filterAttributes) const;
+    QHash<QString, QList<QHelpLink>> documentsForKeywords(
+            const QStringList &keywords, const QStringList &filterAttributes) const;
 
     QStringList namespacesForFilter(const QString &filterName) const;
 
     void setReadOnly(bool readOnly) { m_readOnly = readOnly; }
 
+    CacheStatistics cacheStatistics() const { return m_cacheStatistics; }
+
     static QUrl buildQUrl(const QString &ns, const QString &folder,
                           const QString &relFileName, const QString &anchor);
 
@@ -159,10 +182,20 @@ signals:
     void error(const QString &msg);
 
 private:
+    struct FilterNamespaces
+    {
+        QList<int> namespaceIds;
+        QStringList namespaceNames;
+        QHash<QString, QBitArray> filterMasks; // bits follow namespaceIds
+    };
+
     // legacy stuff
     QList<QHelpLink> documentsForField(const QString &fieldName,
                                        const QString &fieldValue,
                                        const QStringList &filterAttributes) const;
+    QHash<QString, QList<QHelpLink>> documentsForFields(
+            const QString &fieldName, const QStringList &fieldValues,
+            const QStringList &filterAttributes) const;
 
     QString namespaceVersion(const QString &namespaceName) const;
     QMultiMap<QString, QUrl> linksForField(const QString &fieldName, const QString &fieldValue,
@@ -170,6 +203,16 @@ private:
     QList<QHelpLink> documentsForField(const QString &fieldName,
                                        const QString &fieldValue,
                                        const QString &filterName) const;
+    QHash<QString, QList<QHelpLink>> documentsForFields(const QString &fieldName,
+                                                        const QStringList &fieldValues,
+                                                        const QString &filterName) const;
+
+    QString resolveNamespaceForFile(const QUrl &url, const QString &filterName) const;
+    QByteArray readFileData(const QUrl &url) const;
+    void clearCaches();
+    const FilterNamespaces &filterNamespaces() const;
+    QBitArray namespaceMaskForFilter(const QString &filterName) const;
+    QString namespaceFilterQuery(const QString &filterName) const;
 
     bool isDBOpened() const;
     bool createTables(QSqlQuery *query);
@@ -194,6 +237,32 @@ private:
     std::unique_ptr<QSqlQuery> m_query;
     bool m_vacuumScheduled = false;
     bool m_readOnly = true;
+
+    // The help viewer asks for every resource of a page separately, so the
+    // namespaces files resolve to and the file contents are cached. The
+    // caches are cleared whenever documentation or filters change. The
+    // most recently read .qch files are kept open as well.
+    static constexpr qsizetype NamespaceCacheSize = 1024;
+    static constexpr qsizetype FileDataCacheSize = 16 * 1024 * 1024;
+    static constexpr qsizetype ReaderCacheSize = 8;
+    mutable QCache<QString, QString> m_namespaceCache;
+    mutable QCache<QUrl, QByteArray> m_fileDataCache;
+    mutable QCache<QString, QHelpDBReader> m_readerCache;
+    mutable CacheStatistics m_cacheStatistics;
+
+    // The namespaces matching each filter are computed once, so that the
+    // filtered queries do not need to join the component and version
+    // tables. The index and contents of the filters are kept as well,
+    // since switching the filter back and forth asks for them again.
+    mutable std::optional<FilterNamespaces> m_filterNamespaces;
+    mutable QHash<QString, QStringList> m_indicesCache;
+    mutable QHash<QString, QList<ContentsData>> m_contentsCache;
+
+    // IDEs look up the documents of many identifiers at once, and again
+    // for the same ones, so the recent results are kept, keyed by the
+    // field, the filter and the value.
+    static constexpr qsizetype DocumentsCacheSize = 4096;
+    mutable QCache<QString, QList<QHelpLink>> m_documentsCache;
 };
 
 QT_END_NAMESPACE
@@ -1,21 +1,149 @@
 // Copyright (C) 2024 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
-#include "qhelpcontentitem.h"
+#include "qhelpcontentitem_p.h"
+#include "qhelpcollectionhandler_p.h"
 
-#include <QtCore/qstring.h>
-#include <QtCore/qurl.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qiodevice.h>
 
 QT_BEGIN_NAMESPACE
 
-class QHelpContentItemPrivate
+static QUrl constructUrl(const QString &namespaceName, const QString &folderName,
+                         const QString &relativePath)
 {
-public:
-    QString title;
-    QUrl link;
-    QHelpContentItem *parent;
-    QList<QHelpContentItem *> childItems = {};
-};
+    const int idx = relativePath.indexOf(u'#');
+    const QString &rp = idx < 0 ? relativePath : relativePath.left(idx);
+    const QString anchor = idx < 0 ? QString() : relativePath.mid(idx + 1);
+    return QHelpCollectionHandler::buildQUrl(namespaceName, folderName, rp, anchor);
+}
+
+// Skips a QString in the stream, returning whether it was non-empty.
+static bool skipString(QDataStream &s)
+{
+    quint32 size = 0;
+    s >> size;
+    if (s.status() != QDataStream::Ok || size == 0 || size == 0xffffffff)
+        return false;
+    s.skipRawData(size);
+    return s.status() == QDataStream::Ok;
+}
+
+/*
+    Appends the top-level items of the table of contents in \a data to
+    \a root. Only the structure of the tree is read here; the titles and
+    links of the items, and the items themselves, are created when they
+    are asked for.
+*/
+void QHelpContentItemPrivate::appendContents(QHelpContentItem *root, const QByteArray &data,
+                                             const QString &namespaceName,
+                                             const QString &folderName)
+{
+    auto contents = std::make_shared<Contents>();
+    contents->data = data;
+    contents->namespaceName = namespaceName;
+    contents->folderName = folderName;
+
+    QList<Contents::Entry> &entries = contents->entries;
+    QList<int> lastChildren;
+    QList<int> topLevelEntries;
+    QList<int> stack;
+    QDataStream s(data);
+    while (true) {
+        const qint64 offset = s.device()->pos();
+        int depth = 0;
+        s >> depth;
+        skipString(s); // link
+        if (!skipString(s)) // title
+            break;
+
+// The example input (depth, link, title):
+//
+// 0 "graphicaleffects5.html" "Qt 5 Compatibility APIs: Qt Graphical Effects"
+// 1 "qtgraphicaleffects5-index.html" "QML Types"
+// 2 "qml-qt5compat-graphicaleffects-blend.html" "Blend Type Reference"
+// 3 "qml-qt5compat-graphicaleffects-blend-members.html" "List of all members"
+// 2 "qml-qt5compat-graphicaleffects-brightnesscontrast.html" "BrightnessContrast Type Reference"
+//
+// Thus, the valid order of depths is:
+// 1. Whenever the item's depth is < 0, we insert the item as its depth is 0.
+// 2. The first item's depth must be 0, otherwise we insert the item as its depth is 0.
+// 3. When the previous depth was N, the next depth must be in range [0, N+1] inclusively.
+//    If next item's depth is M > N+1, we insert the item as its depth is N+1.
+
+        if (depth <= 0) {
+            stack.clear();
+        } else if (depth < stack.size()) {
+            stack.resize(depth);
+        } else if (depth > stack.size()) {
+            // Fill the gaps with the last item from the stack (or with the root).
+            // This branch handles the case when depths are broken, e.g. 0, 2, 2, 1.
+            // In this case, the 1st item is a root, and 2nd - 4th are all direct
+            // children of the 1st.
+            const int substituteEntry = stack.isEmpty() ? -1 : stack.constLast();
+            while (depth > stack.size())
+                stack.append(substituteEntry);
+        }
+
+        const int parent = stack.isEmpty() ? -1 : stack.constLast();
+        const int index = entries.size();
+        entries.append({ offset });
+        lastChildren.append(-1);
+        if (parent < 0) {
+            topLevelEntries.append(index);
+        } else {
+            if (lastChildren.at(parent) < 0)
+                entries[parent].firstChild = index;
+            else
+                entries[lastChildren.at(parent)].nextSibling = index;
+            lastChildren[parent] = index;
+        }
+        stack.append(index);
+    }
+
+    for (int entry : std::as_const(topLevelEntries))
+        createItem(root, contents, entry);
+}
+
+QHelpContentItem *QHelpContentItemPrivate::createItem(
+        QHelpContentItem *parent, const std::shared_ptr<const Contents> &contents, int entry)
+{
+    QHelpContentItem *item = new QHelpContentItem({}, {}, parent);
+    item->d->contents = contents;
+    item->d->entry = entry;
+    item->d->decoded = false;
+    item->d->childrenCreated = false;
+    return item;
+}
+
+void QHelpContentItemPrivate::decode() const
+{
+    if (decoded)
+        return;
+    decoded = true;
+
+    QDataStream s(contents->data);
+    s.device()->seek(contents->entries.at(entry).offset);
+    int depth = 0;
+    QString relativePath;
+    s >> depth;
+    s >> relativePath;
+    s >> title;
+    link = constructUrl(contents->namespaceName, contents->folderName, relativePath);
+}
+
+void QHelpContentItemPrivate::createChildren(const QHelpContentItem *item) const
+{
+    if (childrenCreated)
+        return;
+    childrenCreated = true;
+
+    auto *parentItem = const_cast<QHelpContentItem *>(item);
+    for (int child = contents->entries.at(entry).firstChild; child >= 0;
+         child = contents->entries.at(child).nextSibling) {
+        createItem(parentItem, contents, child);
+    }
+}
 
 /*!
     \class QHelpContentItem
@@ -47,6 +175,7 @@ QHelpContentItem::~QHelpContentItem()
 */
 QHelpContentItem *QHelpContentItem::child(int row) const
 {
+    d->createChildren(this);
     return d->childItems.value(row);
 }
 
@@ -55,6 +184,7 @@ QHelpContentItem *QHelpContentItem::child(int row) const
 */
 int QHelpContentItem::childCount() const
 {
+    d->createChildren(this);
     return d->childItems.size();
 }
 
@@ -72,6 +202,7 @@ int QHelpContentItem::row() const
 */
 QString QHelpContentItem::title() const
 {
+    d->decode();
     return d->title;
 }
 
@@ -80,6 +211,7 @@ QString QHelpContentItem::title() const
 */
 QUrl QHelpContentItem::url() const
 {
+    d->decode();
     return d->link;
 }
 
@@ -96,6 +228,7 @@ QHelpContentItem *QHelpContentItem::parent() const
 */
 int QHelpContentItem::childPosition(QHelpContentItem *child) const
 {
+    d->createChildren(this);
     return d->childItems.indexOf(child);
 }
 
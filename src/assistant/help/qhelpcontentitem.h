@@ -30,6 +30,7 @@ private:
     QHelpContentItem(const QString &name, const QUrl &link, QHelpContentItem *parent = nullptr);
 
     QHelpContentItemPrivate *d;
+    friend class QHelpContentItemPrivate;
     friend QHelpContentItem *createContentItem(const QString &, const QUrl &, QHelpContentItem *);
 };
 
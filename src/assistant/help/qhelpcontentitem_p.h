@@ -0,0 +1,74 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QHELPCONTENTITEM_P_H
+#define QHELPCONTENTITEM_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists for the convenience
+// of the help generator tools. This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qhelpcontentitem.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qurl.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QHelpContentItemPrivate
+{
+public:
+    // The table of contents of a documentation set, serialized depth first
+    // by qhelpgenerator, along with the position and the place in the tree
+    // of each of its entries. Items are decoded from it on demand.
+    struct Contents
+    {
+        struct Entry
+        {
+            qint64 offset = 0;
+            int firstChild = -1;
+            int nextSibling = -1;
+        };
+
+        QByteArray data;
+        QString namespaceName;
+        QString folderName;
+        QList<Entry> entries;
+    };
+
+    static void appendContents(QHelpContentItem *root, const QByteArray &data,
+                               const QString &namespaceName, const QString &folderName);
+
+    void decode() const;
+    void createChildren(const QHelpContentItem *item) const;
+
+    mutable QString title;
+    mutable QUrl link;
+    QHelpContentItem *parent;
+    mutable QList<QHelpContentItem *> childItems = {};
+
+    std::shared_ptr<const Contents> contents = {};
+    int entry = -1;
+    mutable bool decoded = true;
+    mutable bool childrenCreated = true;
+
+private:
+    static QHelpContentItem *createItem(QHelpContentItem *parent,
+                                        const std::shared_ptr<const Contents> &contents,
+                                        int entry);
+};
+
+QT_END_NAMESPACE
+
+#endif // QHELPCONTENTITEM_P_H
@@ -9,6 +9,7 @@
 #endif
 
 #include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
 #include <QtWidgets/qheaderview.h>
 
 QT_BEGIN_NAMESPACE
@@ -35,10 +36,15 @@ public:
 #if QT_CONFIG(future)
     void createContents(const ItemFutureProvider &futureProvider);
 #endif
+    QHelpContentItem *itemForUrl(const QUrl &url);
+    void indexItems(const QString &host, QHelpContentItem *item);
 
     QHelpContentModel *q = nullptr;
     QHelpEngineCore *helpEngine = nullptr;
     std::shared_ptr<QHelpContentItem> rootItem = {};
+    // The items by the host of their top-level item and their clean path,
+    // built on the first lookup after the contents changed.
+    QHash<std::pair<QString, QString>, QHelpContentItem *> itemsByUrl = {};
 #if QT_CONFIG(future)
     std::unique_ptr<QFutureWatcher<std::shared_ptr<QHelpContentItem>>, WatcherDeleter> watcher = {};
 #endif
@@ -55,6 +61,7 @@ void QHelpContentModelPrivate::createContents(const ItemFutureProvider &futurePr
             if (result && result.get()) {
                 q->beginResetModel();
                 rootItem = result;
+                itemsByUrl.clear();
                 q->endResetModel();
             }
         }
@@ -69,12 +76,38 @@ void QHelpContentModelPrivate::createContents(const ItemFutureProvider &futurePr
     if (rootItem) {
         q->beginResetModel();
         rootItem.reset();
+        itemsByUrl.clear();
         q->endResetModel();
     }
     emit q->contentsCreationStarted();
 }
 #endif
 
+/*
+    Returns the first item with the path of \a url, in a depth-first walk
+    of the top-level items with the host of \a url.
+*/
+QHelpContentItem *QHelpContentModelPrivate::itemForUrl(const QUrl &url)
+{
+    if (!rootItem)
+        return nullptr;
+
+    if (itemsByUrl.isEmpty()) {
+        for (int i = 0; i < rootItem->childCount(); ++i) {
+            QHelpContentItem *item = rootItem->child(i);
+            indexItems(item->url().host(), item);
+        }
+    }
+    return itemsByUrl.value({url.host(), QDir::cleanPath(url.path())});
+}
+
+void QHelpContentModelPrivate::indexItems(const QString &host, QHelpContentItem *item)
+{
+    itemsByUrl.try_emplace({host, QDir::cleanPath(item->url().path())}, item);
+    for (int i = 0; i < item->childCount(); ++i)
+        indexItems(host, item->child(i));
+}
+
 /*!
     \class QHelpContentModel
     \inmodule QtHelp
@@ -265,33 +298,17 @@ QModelIndex QHelpContentWidget::indexOf(const QUrl &link)
         return {};
 
     m_syncIndex = {};
-    for (int i = 0; i < contentModel->rowCount(); ++i) {
-        QHelpContentItem *itm = contentModel->contentItemAt(contentModel->index(i, 0));
-        if (itm && itm->url().host() == link.host()) {
-            if (searchContentItem(contentModel, contentModel->index(i, 0), QDir::cleanPath(link.path())))
-                return m_syncIndex;
-        }
-    }
-    return {};
-}
-
-bool QHelpContentWidget::searchContentItem(QHelpContentModel *model, const QModelIndex &parent,
-                                           const QString &cleanPath)
-{
-    QHelpContentItem *parentItem = model->contentItemAt(parent);
-    if (!parentItem)
-        return false;
-
-    if (QDir::cleanPath(parentItem->url().path()) == cleanPath) {
-        m_syncIndex = parent;
-        return true;
-    }
+    QHelpContentItem *item = contentModel->d->itemForUrl(link);
+    if (!item)
+        return {};
 
-    for (int i = 0; i < parentItem->childCount(); ++i) {
-        if (searchContentItem(model, model->index(i, 0, parent), cleanPath))
-            return true;
-    }
-    return false;
+    // Find the rows from the item up to the root.
+    QList<int> rows;
+    for (QHelpContentItem *child = item; child->parent(); child = child->parent())
+        rows.prepend(child->parent()->childPosition(child));
+    for (int row : std::as_const(rows))
+        m_syncIndex = contentModel->index(row, 0, m_syncIndex);
+    return m_syncIndex;
 }
 
 void QHelpContentWidget::showLink(const QModelIndex &index)
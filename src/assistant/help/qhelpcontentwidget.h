@@ -45,6 +45,7 @@ private:
     QHelpContentModelPrivate *d;
     friend class QHelpEnginePrivate;
     friend class QHelpContentModelPrivate;
+    friend class QHelpContentWidget;
 };
 
 class QHELP_EXPORT QHelpContentWidget : public QTreeView
@@ -61,8 +62,6 @@ private Q_SLOTS:
     void showLink(const QModelIndex &index);
 
 private:
-    bool searchContentItem(QHelpContentModel *model, const QModelIndex &parent,
-                           const QString &path);
     QModelIndex m_syncIndex;
 
 private:
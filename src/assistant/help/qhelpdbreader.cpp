@@ -6,6 +6,7 @@
 
 #include <QtCore/qfile.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qurl.h>
 #include <QtCore/qvariant.h>
 #include <QtSql/qsqldatabase.h>
 #include <QtSql/qsqlerror.h>
@@ -28,6 +29,8 @@ QHelpDBReader::QHelpDBReader(const QString &dbName, const QString &uniqueId, QOb
 
 QHelpDBReader::~QHelpDBReader()
 {
+    m_fileDataQuery.reset();
+    m_query.reset();
     if (m_initDone)
         QSqlDatabase::removeDatabase(m_uniqueId);
 }
@@ -53,8 +56,12 @@ bool QHelpDBReader::init()
 bool QHelpDBReader::initDB()
 {
     QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE"_L1, m_uniqueId);
-    db.setConnectOptions("QSQLITE_OPEN_READONLY"_L1);
-    db.setDatabaseName(m_dbName);
+    // A .qch file is never written once it is generated. Opening it as
+    // immutable lets SQLite skip the file locks and the check for a journal.
+    QUrl url = QUrl::fromLocalFile(m_dbName);
+    url.setQuery("immutable=1"_L1);
+    db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI"_L1);
+    db.setDatabaseName(url.toString(QUrl::FullyEncoded));
     if (!db.open()) {
         /*: The placeholders are: %1 - The name of the database which cannot be opened
                                   %2 - The unique id for the connection
@@ -62,6 +69,8 @@ bool QHelpDBReader::initDB()
         m_error = tr("Cannot open database \"%1\" \"%2\": %3").arg(m_dbName, m_uniqueId, db.lastError().text());
         return false;
     }
+    // Let SQLite read the pages of the file through memory mapping.
+    QSqlQuery(db).exec("PRAGMA mmap_size = 268435456"_L1);
     return true;
 }
 
@@ -369,27 +378,34 @@ QByteArray QHelpDBReader::fileData(const QString &virtualFolder,
         return ba;
 
     namespaceName();
-    m_query->prepare(
-        "SELECT "
-            "FileDataTable.Data "
-        "FROM "
-            "FileDataTable, "
-            "FileNameTable, "
-            "FolderTable, "
-            "NamespaceTable "
-        "WHERE FileDataTable.Id = FileNameTable.FileId "
-        "AND (FileNameTable.Name = ? OR FileNameTable.Name = ?) "
-        "AND FileNameTable.FolderId = FolderTable.Id "
-        "AND FolderTable.Name = ? "
-        "AND FolderTable.NamespaceId = NamespaceTable.Id "
-        "AND NamespaceTable.Name = ?"_L1);
-    m_query->bindValue(0, filePath);
-    m_query->bindValue(1, QString("./"_L1 + filePath));
-    m_query->bindValue(2, virtualFolder);
-    m_query->bindValue(3, m_namespace);
-    m_query->exec();
-    if (m_query->next() && m_query->isValid())
-        ba = qUncompress(m_query->value(0).toByteArray());
+    // Readers are kept open by QHelpCollectionHandler, so prepare the
+    // statement once instead of on every call.
+    if (!m_fileDataQuery) {
+        m_fileDataQuery.reset(new QSqlQuery(QSqlDatabase::database(m_uniqueId)));
+        m_fileDataQuery->setForwardOnly(true);
+        m_fileDataQuery->prepare(
+            "SELECT "
+                "FileDataTable.Data "
+            "FROM "
+                "FileDataTable, "
+                "FileNameTable, "
+                "FolderTable, "
+                "NamespaceTable "
+            "WHERE FileDataTable.Id = FileNameTable.FileId "
+            "AND (FileNameTable.Name = ? OR FileNameTable.Name = ?) "
+            "AND FileNameTable.FolderId = FolderTable.Id "
+            "AND FolderTable.Name = ? "
+            "AND FolderTable.NamespaceId = NamespaceTable.Id "
+            "AND NamespaceTable.Name = ?"_L1);
+    }
+    m_fileDataQuery->bindValue(0, filePath);
+    m_fileDataQuery->bindValue(1, QString("./"_L1 + filePath));
+    m_fileDataQuery->bindValue(2, virtualFolder);
+    m_fileDataQuery->bindValue(3, m_namespace);
+    m_fileDataQuery->exec();
+    if (m_fileDataQuery->next() && m_fileDataQuery->isValid())
+        ba = qUncompress(m_fileDataQuery->value(0).toByteArray());
+    m_fileDataQuery->finish();
     return ba;
 }
 
@@ -430,57 +446,162 @@ QStringList QHelpDBReader::filterAttributes(const QString &filterName) const
     return lst;
 }
 
-QMultiMap<QString, QByteArray> QHelpDBReader::filesData(const QStringList &filterAttributes,
-                                                        const QString &extensionFilter) const
+QHelpDBReader::FileDataCursor::FileDataCursor(std::unique_ptr<QSqlQuery> query)
+    : m_query(std::move(query))
+{}
+
+QHelpDBReader::FileDataCursor::FileDataCursor(FileDataCursor &&other) noexcept = default;
+QHelpDBReader::FileDataCursor &
+QHelpDBReader::FileDataCursor::operator=(FileDataCursor &&other) noexcept = default;
+QHelpDBReader::FileDataCursor::~FileDataCursor() = default;
+
+bool QHelpDBReader::FileDataCursor::next()
 {
-    if (!m_query)
-        return {};
+    return m_query && m_query->next();
+}
+
+QString QHelpDBReader::FileDataCursor::name() const
+{
+    return m_query->value(0).toString();
+}
+
+QByteArray QHelpDBReader::FileDataCursor::data() const
+{
+    return qUncompress(m_query->value(1).toByteArray());
+}
+
+QString QHelpDBReader::FileDataCursor::title() const
+{
+    return m_query->value(1).toString();
+}
+
+QString QHelpDBReader::FileDataCursor::text() const
+{
+    return m_query->value(2).toString();
+}
+
+QString QHelpDBReader::filesDataQuery(const QStringList &filterAttributes,
+                                      const QStringList &extensionFilters, bool searchText) const
+{
+    const QLatin1StringView dataColumns = searchText
+            ? "SearchTextTable.Title, SearchTextTable.Text"_L1 : "FileDataTable.Data"_L1;
+    const QLatin1StringView dataTable = searchText ? "SearchTextTable"_L1 : "FileDataTable"_L1;
+    const QLatin1StringView dataFileId =
+            searchText ? "SearchTextTable.FileId"_L1 : "FileDataTable.Id"_L1;
 
-    QString query;
     QString extension;
-    if (!extensionFilter.isEmpty())
-        extension = "AND FileNameTable.Name LIKE \'%.%1\'"_L1.arg(extensionFilter);
+    if (!extensionFilters.isEmpty()) {
+        QStringList conditions;
+        for (const QString &extensionFilter : extensionFilters)
+            conditions.append("FileNameTable.Name LIKE \'%.%1\'"_L1.arg(quote(extensionFilter)));
+        extension = "AND (%1)"_L1.arg(conditions.join(" OR "_L1));
+    }
 
     if (filterAttributes.isEmpty()) {
-        query =
+        return
             "SELECT "
                 "FileNameTable.Name, "
-                "FileDataTable.Data "
+                "%1 "
             "FROM "
                 "FolderTable, "
                 "FileNameTable, "
-                "FileDataTable "
-            "WHERE FileDataTable.Id = FileNameTable.FileId "
-            "AND FileNameTable.FolderId = FolderTable.Id %1"_L1.arg(extension);
-    } else {
-        for (int i = 0; i < filterAttributes.size(); ++i) {
-            if (i > 0)
-                query.append(" INTERSECT "_L1);
-            query.append(
-                "SELECT "
-                    "FileNameTable.Name, "
-                    "FileDataTable.Data "
-                "FROM "
-                    "FolderTable, "
-                    "FileNameTable, "
-                    "FileDataTable, "
-                    "FileFilterTable, "
-                    "FilterAttributeTable "
-                "WHERE FileDataTable.Id = FileNameTable.FileId "
-                "AND FileNameTable.FolderId = FolderTable.Id "
-                "AND FileNameTable.FileId = FileFilterTable.FileId "
-                "AND FileFilterTable.FilterAttributeId = FilterAttributeTable.Id "
-                "AND FilterAttributeTable.Name = \'%1\' %2"_L1
-                            .arg(quote(filterAttributes.at(i)), extension));
-        }
+                "%2 "
+            "WHERE %3 = FileNameTable.FileId "
+            "AND FileNameTable.FolderId = FolderTable.Id %4"_L1
+                    .arg(dataColumns, dataTable, dataFileId, extension);
+    }
+
+    // Intersect the names and file ids only, and join the data afterwards,
+    // so that SQLite does not have to copy file contents into temporary tables.
+    QString files;
+    for (int i = 0; i < filterAttributes.size(); ++i) {
+        if (i > 0)
+            files.append(" INTERSECT "_L1);
+        files.append(
+            "SELECT "
+                "FileNameTable.Name, "
+                "FileNameTable.FileId "
+            "FROM "
+                "FolderTable, "
+                "FileNameTable, "
+                "FileFilterTable, "
+                "FilterAttributeTable "
+            "WHERE FileNameTable.FolderId = FolderTable.Id "
+            "AND FileNameTable.FileId = FileFilterTable.FileId "
+            "AND FileFilterTable.FilterAttributeId = FilterAttributeTable.Id "
+            "AND FilterAttributeTable.Name = \'%1\' %2"_L1
+                        .arg(quote(filterAttributes.at(i)), extension));
     }
-    m_query->exec(query);
+    return
+        "SELECT "
+            "Files.Name, "
+            "%1 "
+        "FROM "
+            "(%2) AS Files, "
+            "%3 "
+        "WHERE %4 = Files.FileId"_L1.arg(dataColumns, files, dataTable, dataFileId);
+}
+
+QMultiMap<QString, QByteArray> QHelpDBReader::filesData(const QStringList &filterAttributes,
+                                                        const QString &extensionFilter) const
+{
     QMultiMap<QString, QByteArray> result;
-    while (m_query->next())
-        result.insert(m_query->value(0).toString(), qUncompress(m_query->value(1).toByteArray()));
+    FileDataCursor cursor = filesDataCursor(
+            filterAttributes, extensionFilter.isEmpty() ? QStringList() : QStringList(extensionFilter));
+    while (cursor.next())
+        result.insert(cursor.name(), cursor.data());
     return result;
 }
 
+/*
+    Returns a cursor over the files that have all \a filterAttributes and
+    one of the \a extensionFilters. Unlike filesData(), the result set is
+    not held in memory: the rows are fetched from the database one by one.
+*/
+QHelpDBReader::FileDataCursor QHelpDBReader::filesDataCursor(
+        const QStringList &filterAttributes, const QStringList &extensionFilters) const
+{
+    return fileDataCursor(filesDataQuery(filterAttributes, extensionFilters, false));
+}
+
+/*
+    Returns whether the documentation contains the text of its files
+    as stored in the full text search index, which qhelpgenerator writes
+    when asked to.
+*/
+bool QHelpDBReader::hasSearchText() const
+{
+    if (!m_query)
+        return false;
+
+    m_query->exec("SELECT name FROM sqlite_master "
+                  "WHERE type = \'table\' AND name = \'SearchTextTable\'"_L1);
+    return m_query->next();
+}
+
+/*
+    Like filesDataCursor(), but returns a cursor over the titles and texts
+    of the files instead of their contents.
+*/
+QHelpDBReader::FileDataCursor QHelpDBReader::searchTextCursor(
+        const QStringList &filterAttributes, const QStringList &extensionFilters) const
+{
+    return fileDataCursor(filesDataQuery(filterAttributes, extensionFilters, true));
+}
+
+QHelpDBReader::FileDataCursor QHelpDBReader::fileDataCursor(const QString &queryString) const
+{
+    if (!m_query)
+        return FileDataCursor(nullptr);
+
+    auto query = std::make_unique<QSqlQuery>(QSqlDatabase::database(m_uniqueId));
+    // A forward only query does not cache the rows it has already returned.
+    query->setForwardOnly(true);
+    if (!query->exec(queryString))
+        return FileDataCursor(nullptr);
+    return FileDataCursor(std::move(query));
+}
+
 QVariant QHelpDBReader::metaData(const QString &name) const
 {
     if (!m_query)
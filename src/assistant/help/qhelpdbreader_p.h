@@ -19,6 +19,8 @@
 #include <QtCore/qobject.h>
 #include <QtCore/qstringlist.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QSqlQuery;
@@ -53,6 +55,30 @@ public:
         QStringList filterAttributes;
     };
 
+    // Iterates over the files of a filesDataCursor() or searchTextCursor()
+    // query one at a time. The file contents are only read and uncompressed
+    // by data(), which is only valid for filesDataCursor(). title() and
+    // text() are only valid for searchTextCursor().
+    class FileDataCursor
+    {
+    public:
+        FileDataCursor(FileDataCursor &&other) noexcept;
+        FileDataCursor &operator=(FileDataCursor &&other) noexcept;
+        ~FileDataCursor();
+
+        bool next();
+        QString name() const;
+        QByteArray data() const;
+        QString title() const;
+        QString text() const;
+
+    private:
+        friend class QHelpDBReader;
+        explicit FileDataCursor(std::unique_ptr<QSqlQuery> query);
+
+        std::unique_ptr<QSqlQuery> m_query;
+    };
+
     class IndexTable
     {
     public:
@@ -75,6 +101,11 @@ public:
     QList<QStringList> filterAttributeSets() const;
     QMultiMap<QString, QByteArray> filesData(const QStringList &filterAttributes,
                                              const QString &extensionFilter = {}) const;
+    FileDataCursor filesDataCursor(const QStringList &filterAttributes,
+                                   const QStringList &extensionFilters = {}) const;
+    bool hasSearchText() const;
+    FileDataCursor searchTextCursor(const QStringList &filterAttributes,
+                                    const QStringList &extensionFilters = {}) const;
     QByteArray fileData(const QString &virtualFolder, const QString &filePath) const;
 
     QStringList customFilters() const;
@@ -84,6 +115,9 @@ public:
 
 private:
     QString quote(const QString &string) const;
+    QString filesDataQuery(const QStringList &filterAttributes,
+                           const QStringList &extensionFilters, bool searchText) const;
+    FileDataCursor fileDataCursor(const QString &query) const;
     bool initDB();
     QString qtVersionHeuristic() const;
 
@@ -92,6 +126,7 @@ private:
     QString m_uniqueId;
     QString m_error;
     std::unique_ptr<QSqlQuery> m_query;
+    mutable std::unique_ptr<QSqlQuery> m_fileDataQuery;
     mutable QString m_namespace;
 };
 
@@ -3,6 +3,7 @@
 
 #include "qhelpenginecore.h"
 #include "qhelpcollectionhandler_p.h"
+#include "qhelpcontentitem_p.h"
 #include "qhelpdbreader_p.h"
 #include "qhelpfilterengine.h"
 #include "qhelplink.h"
@@ -267,6 +268,41 @@ bool QHelpEngineCore::setupData()
     return d->setup();
 }
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.10
+
+    Sets up the help engine like setupData(), but without blocking the
+    calling thread while the collection file is verified.
+
+    In writable mode, the verification checks the time stamps of the
+    registered documentation files, reregisters the files that changed,
+    and recreates missing index and filter tables. This is done on a
+    separate connection in a worker thread. Afterwards, the help engine
+    is set up in the thread it lives in, which is quick as the collection
+    is up to date then. The setupStarted() and setupFinished() signals
+    are emitted then, too.
+
+    The returned future reports whether the setup was successful.
+
+    \sa setupData(), setReadOnly()
+*/
+QFuture<bool> QHelpEngineCore::requestSetupData()
+{
+    const QString collection = collectionFile();
+    const bool readOnly = isReadOnly();
+    return QtConcurrent::run([collection, readOnly] {
+        if (readOnly)
+            return;
+        QHelpCollectionHandler collectionHandler(collection);
+        collectionHandler.setReadOnly(false);
+        collectionHandler.openCollectionFile();
+    }).then(this, [this] {
+        return setupData();
+    });
+}
+#endif
+
 /*!
     Creates the file \a fileName and copies all contents from
     the current collection file into the newly created file,
@@ -315,6 +351,33 @@ bool QHelpEngineCore::registerDocumentation(const QString &documentationFileName
     return d->collectionHandler->registerDocumentation(documentationFileName);
 }
 
+/*!
+    \since 6.10
+
+    Registers the Qt compressed help files (.qch) in
+    \a documentationFileNames and returns the ones that were registered.
+
+    This is faster than calling registerDocumentation() for each file,
+    since all of them are written to the collection file at once.
+
+    For every file that cannot be registered, warning() is emitted with
+    the reason, while error() only holds the last one.
+
+    \sa registerDocumentation(), error(), warning()
+*/
+QStringList QHelpEngineCore::registerDocumentations(const QStringList &documentationFileNames)
+{
+    d->error.clear();
+    d->needsSetup = true;
+    const QMetaObject::Connection connection =
+            connect(d->collectionHandler.get(), &QHelpCollectionHandler::error,
+                    this, &QHelpEngineCore::warning);
+    const QStringList registered =
+            d->collectionHandler->registerDocumentations(documentationFileNames);
+    disconnect(connection);
+    return registered;
+}
+
 /*!
     Unregisters the Qt compressed help file (.qch) identified by its
     \a namespaceName from the help collection. Returns true
@@ -666,6 +729,82 @@ QList<QHelpLink> QHelpEngineCore::documentsForKeyword(const QString &keyword, co
     return d->collectionHandler->documentsForKeyword(keyword, filterAttributes(filterName));
 }
 
+/*!
+    \since 6.10
+
+    Returns the document links found for each of the \a ids that has any,
+    keyed by the identifier. The returned links depend on the current
+    filter, like the ones returned by documentsForIdentifier().
+
+    This is faster than calling documentsForIdentifier() for each of
+    the \a ids, since they are looked up together, and the results for
+    recently looked up identifiers are reused.
+*/
+QHash<QString, QList<QHelpLink>> QHelpEngineCore::documentsForIdentifiers(
+        const QStringList &ids) const
+{
+    return documentsForIdentifiers(
+            ids, d->usesFilterEngine ? d->filterEngine->activeFilter() : d->currentFilter);
+}
+
+/*!
+    \since 6.10
+
+    Returns the document links found for each of the \a ids that has any,
+    keyed by the identifier and filtered by \a filterName. If you want to
+    get all results unfiltered, pass empty string as \a filterName.
+
+    \sa documentsForIdentifier()
+*/
+QHash<QString, QList<QHelpLink>> QHelpEngineCore::documentsForIdentifiers(
+        const QStringList &ids, const QString &filterName) const
+{
+    if (!d->setup())
+        return {};
+
+    if (d->usesFilterEngine)
+        return d->collectionHandler->documentsForIdentifiers(ids, filterName);
+    return d->collectionHandler->documentsForIdentifiers(ids, filterAttributes(filterName));
+}
+
+/*!
+    \since 6.10
+
+    Returns the document links found for each of the \a keywords that has
+    any, keyed by the keyword. The returned links depend on the current
+    filter, like the ones returned by documentsForKeyword().
+
+    This is faster than calling documentsForKeyword() for each of the
+    \a keywords, since they are looked up together, and the results for
+    recently looked up keywords are reused.
+*/
+QHash<QString, QList<QHelpLink>> QHelpEngineCore::documentsForKeywords(
+        const QStringList &keywords) const
+{
+    return documentsForKeywords(
+            keywords, d->usesFilterEngine ? d->filterEngine->activeFilter() : d->currentFilter);
+}
+
+/*!
+    \since 6.10
+
+    Returns the document links found for each of the \a keywords that has
+    any, keyed by the keyword and filtered by \a filterName. If you want
+    to get all results unfiltered, pass empty string as \a filterName.
+
+    \sa documentsForKeyword()
+*/
+QHash<QString, QList<QHelpLink>> QHelpEngineCore::documentsForKeywords(
+        const QStringList &keywords, const QString &filterName) const
+{
+    if (!d->setup())
+        return {};
+
+    if (d->usesFilterEngine)
+        return d->collectionHandler->documentsForKeywords(keywords, filterName);
+    return d->collectionHandler->documentsForKeywords(keywords, filterAttributes(filterName));
+}
+
 /*!
     Removes the \a key from the settings section in the
     collection file. Returns true if the value was removed
@@ -779,15 +918,6 @@ bool QHelpEngineCore::usesFilterEngine() const
 }
 
 #if QT_CONFIG(future)
-static QUrl constructUrl(const QString &namespaceName, const QString &folderName,
-                         const QString &relativePath)
-{
-    const int idx = relativePath.indexOf(u'#');
-    const QString &rp = idx < 0 ? relativePath : relativePath.left(idx);
-    const QString anchor = idx < 0 ? QString() : relativePath.mid(idx + 1);
-    return QHelpCollectionHandler::buildQUrl(namespaceName, folderName, rp, anchor);
-}
-
 using ContentProviderResult = QList<QHelpCollectionHandler::ContentsData>;
 using ContentProvider = std::function<ContentProviderResult(const QString &)>;
 using ContentResult = std::shared_ptr<QHelpContentItem>;
@@ -814,50 +944,8 @@ static void requestContentHelper(QPromise<ContentResult> &promise, const Content
             if (contents.isEmpty())
                 continue;
 
-            QList<QHelpContentItem *> stack;
-            QDataStream s(contents);
-            while (true) {
-                int depth = 0;
-                QString link, title;
-                s >> depth;
-                s >> link;
-                s >> title;
-                if (title.isEmpty())
-                    break;
-
-// The example input (depth, link, title):
-//
-// 0 "graphicaleffects5.html" "Qt 5 Compatibility APIs: Qt Graphical Effects"
-// 1 "qtgraphicaleffects5-index.html" "QML Types"
-// 2 "qml-qt5compat-graphicaleffects-blend.html" "Blend Type Reference"
-// 3 "qml-qt5compat-graphicaleffects-blend-members.html" "List of all members"
-// 2 "qml-qt5compat-graphicaleffects-brightnesscontrast.html" "BrightnessContrast Type Reference"
-//
-// Thus, the valid order of depths is:
-// 1. Whenever the item's depth is < 0, we insert the item as its depth is 0.
-// 2. The first item's depth must be 0, otherwise we insert the item as its depth is 0.
-// 3. When the previous depth was N, the next depth must be in range [0, N+1] inclusively.
-//    If next item's depth is M > N+1, we insert the item as its depth is N+1.
-
-                if (depth <= 0) {
-                    stack.clear();
-                } else if (depth < stack.size()) {
-                    stack = stack.sliced(0, depth);
-                } else if (depth > stack.size()) {
-                    // Fill the gaps with the last item from the stack (or with the root).
-                    // This branch handles the case when depths are broken, e.g. 0, 2, 2, 1.
-                    // In this case, the 1st item is a root, and 2nd - 4th are all direct
-                    // children of the 1st.
-                    QHelpContentItem *substituteItem =
-                            stack.isEmpty() ? rootItem.get() : stack.constLast();
-                    while (depth > stack.size())
-                        stack.append(substituteItem);
-                }
-
-                const QUrl url = constructUrl(namespaceName, folderName, link);
-                QHelpContentItem *parent = stack.isEmpty() ? rootItem.get() : stack.constLast();
-                stack.push_back(createContentItem(title, url, parent));
-            }
+            QHelpContentItemPrivate::appendContents(rootItem.get(), contents,
+                                                    namespaceName, folderName);
         }
     }
     promise.addResult(rootItem);
@@ -11,6 +11,7 @@
 #include <QtCore/qfuture.h>
 #endif
 
+#include <QtCore/qhash.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qvariant.h>
@@ -49,6 +50,7 @@ public:
 
     static QString namespaceName(const QString &documentationFileName);
     bool registerDocumentation(const QString &documentationFileName);
+    QStringList registerDocumentations(const QStringList &documentationFileNames);
     bool unregisterDocumentation(const QString &namespaceName);
     QString documentationFileName(const QString &namespaceName);
     QStringList registeredDocumentations() const;
@@ -79,6 +81,12 @@ public:
     QList<QHelpLink> documentsForIdentifier(const QString &id, const QString &filterName) const;
     QList<QHelpLink> documentsForKeyword(const QString &keyword) const;
     QList<QHelpLink> documentsForKeyword(const QString &keyword, const QString &filterName) const;
+    QHash<QString, QList<QHelpLink>> documentsForIdentifiers(const QStringList &ids) const;
+    QHash<QString, QList<QHelpLink>> documentsForIdentifiers(const QStringList &ids,
+                                                             const QString &filterName) const;
+    QHash<QString, QList<QHelpLink>> documentsForKeywords(const QStringList &keywords) const;
+    QHash<QString, QList<QHelpLink>> documentsForKeywords(const QStringList &keywords,
+                                                          const QString &filterName) const;
 
     bool removeCustomValue(const QString &key);
     QVariant customValue(const QString &key, const QVariant &defaultValue = {}) const;
@@ -95,6 +103,8 @@ public:
     bool usesFilterEngine() const;
 
 #if QT_CONFIG(future)
+    QFuture<bool> requestSetupData();
+
     QFuture<std::shared_ptr<QHelpContentItem>> requestContentForCurrentFilter() const;
     QFuture<std::shared_ptr<QHelpContentItem>> requestContent(const QString &filter) const;
 
@@ -35,6 +35,12 @@ public:
     QHelpIndexModel *q = nullptr;
     QHelpEngineCore *helpEngine = nullptr;
     QStringList indices = {};
+    // The keyword filter and the positions in indices of the keywords it
+    // matched. Typing usually extends the filter, and the keywords that
+    // contain the extended filter are among those that contained the
+    // previous one.
+    QString lastFilter = {};
+    QList<qsizetype> lastMatches = {};
 #if QT_CONFIG(future)
     std::unique_ptr<QFutureWatcher<QStringList>, WatcherDeleter> watcher = {};
 #endif
@@ -161,18 +167,24 @@ QHelpEngineCore *QHelpIndexModel::helpEngine() const
 QModelIndex QHelpIndexModel::filter(const QString &filter, const QString &wildcard)
 {
     if (filter.isEmpty()) {
+        d->lastFilter.clear();
+        d->lastMatches.clear();
         setStringList(d->indices);
         return index(-1, 0, {});
     }
 
     using Checker = std::function<bool(const QString &)>;
-    const auto checkIndices = [this, filter](const Checker &checker) {
+    const auto checkIndices = [this, filter](const Checker &checker,
+                                             const QList<qsizetype> *candidates) {
         QStringList filteredList;
+        QList<qsizetype> matches;
         int goodMatch = -1;
         int perfectMatch = -1;
-        for (const QString &index : std::as_const(d->indices)) {
+        const auto checkIndex = [&](qsizetype i) {
+            const QString &index = d->indices.at(i);
             if (checker(index)) {
                 filteredList.append(index);
+                matches.append(i);
                 if (perfectMatch == -1 && index.startsWith(filter, Qt::CaseInsensitive)) {
                     if (goodMatch == -1)
                         goodMatch = filteredList.size() - 1;
@@ -182,8 +194,16 @@ QModelIndex QHelpIndexModel::filter(const QString &filter, const QString &wildca
                     perfectMatch = filteredList.size() - 1;
                 }
             }
+        };
+        if (candidates) {
+            for (qsizetype i : *candidates)
+                checkIndex(i);
+        } else {
+            for (qsizetype i = 0; i < d->indices.size(); ++i)
+                checkIndex(i);
         }
         setStringList(filteredList);
+        d->lastMatches = std::move(matches);
         return perfectMatch >= 0 ? perfectMatch : qMax(0, goodMatch);
     };
 
@@ -194,11 +214,16 @@ QModelIndex QHelpIndexModel::filter(const QString &filter, const QString &wildca
         const QRegularExpression regExp(re, QRegularExpression::CaseInsensitiveOption);
         perfectMatch = checkIndices([regExp](const QString &index) {
             return index.contains(regExp);
-        });
+        }, nullptr);
+        d->lastFilter.clear();
     } else {
+        const bool narrowed = !d->lastFilter.isEmpty()
+                && filter.contains(d->lastFilter, Qt::CaseInsensitive);
+        const QList<qsizetype> candidates = narrowed ? d->lastMatches : QList<qsizetype>();
         perfectMatch = checkIndices([filter](const QString &index) {
             return index.contains(filter, Qt::CaseInsensitive);
-        });
+        }, narrowed ? &candidates : nullptr);
+        d->lastFilter = filter;
     }
     return index(perfectMatch, 0, {});
 }
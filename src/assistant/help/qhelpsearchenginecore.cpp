@@ -51,12 +51,23 @@ public:
                              q, &QHelpSearchEngineCore::indexingStarted);
             QObject::connect(m_indexWriter.get(), &QHelpSearchIndexWriter::indexingFinished,
                              q, &QHelpSearchEngineCore::indexingFinished);
+            // The cached search results are stale once the index changes.
+            QObject::connect(m_indexWriter.get(), &QHelpSearchIndexWriter::indexingStarted,
+                             q, [this] { clearSearchCache(); });
+            QObject::connect(m_indexWriter.get(), &QHelpSearchIndexWriter::indexingFinished,
+                             q, [this] { clearSearchCache(); });
         }
 
         m_indexWriter->cancelIndexing();
         m_indexWriter->updateIndex(m_helpEngine->collectionFile(), indexFilesFolder(), reindex);
     }
 
+    void clearSearchCache()
+    {
+        if (m_indexReader)
+            m_indexReader->clearCache();
+    }
+
     void search(const QString &searchInput)
     {
         Q_Q(QHelpSearchEngineCore);
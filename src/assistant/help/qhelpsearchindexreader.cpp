@@ -5,11 +5,14 @@
 #include "qhelpenginecore.h"
 #include "qhelpfilterengine.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qset.h>
 #include <QtSql/qsqldatabase.h>
 #include <QtSql/qsqlquery.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -36,16 +39,23 @@ public:
         m_filterEngineNamespaceList = namespaceList;
     }
 
-    void searchInDB(const QString &term);
-    QList<QHelpSearchResult> searchResults() const { return m_searchResults; }
+    QString cacheKey(const QString &searchInput) const;
+    bool searchInDB(const QString &term, const std::function<bool()> &isCanceled);
+    QList<SearchResultId> searchResultIds() const { return m_searchResultIds; }
+
+    QList<QHelpSearchResult> fetchResults(const QString &searchInput,
+                                          const QList<SearchResultId> &ids);
 
 private:
-    QList<QHelpSearchResult> queryTable(const QSqlDatabase &db, const QString &tableName,
-                                        const QString &searchInput) const;
+    bool queryTable(const QSqlDatabase &db, const QString &tableName, const QString &searchInput,
+                    const std::function<bool()> &isCanceled, QSet<QString> *urls);
+    void fetchFromTable(const QSqlDatabase &db, const QString &tableName,
+                        const QString &searchInput, const QList<qint64> &rowIds,
+                        QHash<qint64, QHelpSearchResult> *results) const;
 
     QMultiMap<QString, QStringList> m_namespaceAttributes;
     QStringList m_filterEngineNamespaceList;
-    QList<QHelpSearchResult> m_searchResults;
+    QList<SearchResultId> m_searchResultIds;
     QString m_indexPath;
     bool m_useFilterEngine = false;
 };
@@ -117,15 +127,22 @@ static void bindNamespacesAndAttributes(QSqlQuery *query, const QStringList &nam
         query->addBindValue(ns);
 }
 
-QList<QHelpSearchResult> Reader::queryTable(const QSqlDatabase &db, const QString &tableName,
-                                            const QString &searchInput) const
+/*
+    Appends the ids of the documents in \a tableName that match
+    \a searchInput to the results, best match first. Documents whose
+    url is in \a urls already are skipped. Only the ids are collected;
+    titles and snippets are fetched for the requested page only.
+*/
+bool Reader::queryTable(const QSqlDatabase &db, const QString &tableName,
+                        const QString &searchInput, const std::function<bool()> &isCanceled,
+                        QSet<QString> *urls)
 {
     const QString nsPlaceholders = m_useFilterEngine
             ? namespacePlaceholders(m_filterEngineNamespaceList)
             : namespacePlaceholders(m_namespaceAttributes);
     QSqlQuery query(db);
-    query.prepare("SELECT url, title, snippet("_L1 + tableName +
-                  ", -1, '<b>', '</b>', '...', '10') FROM "_L1 + tableName +
+    query.setForwardOnly(true);
+    query.prepare("SELECT rowid, url FROM "_L1 + tableName +
                   " WHERE ("_L1 + nsPlaceholders +
                   ") AND "_L1 + tableName +
                   " MATCH ? ORDER BY rank"_L1);
@@ -135,19 +152,38 @@ QList<QHelpSearchResult> Reader::queryTable(const QSqlDatabase &db, const QStrin
     query.addBindValue(searchInput);
     query.exec();
 
-    QList<QHelpSearchResult> results;
+    const bool fromTitles = tableName == "titles"_L1;
+    for (int i = 0; query.next(); ++i) {
+        if (i % 256 == 0 && isCanceled())
+            return false;
+        const auto size = urls->size();
+        urls->insert(query.value(1).toString());
+        if (size != urls->size()) // insertion took place
+            m_searchResultIds.append({ query.value(0).toLongLong(), fromTitles });
+    }
+    return true;
+}
 
-    while (query.next()) {
-        const QString &url = query.value("url"_L1).toString();
-        const QString &title = query.value("title"_L1).toString();
-        const QString &snippet = query.value(2).toString();
-        results.append(QHelpSearchResult(url, title, snippet));
+/*
+    Returns the key of the result cache for \a searchInput. It covers the
+    index and the documentation that the current filter selects.
+*/
+QString Reader::cacheKey(const QString &searchInput) const
+{
+    QString key = m_indexPath + u'\n';
+    if (m_useFilterEngine) {
+        key += m_filterEngineNamespaceList.join(u'\t');
+    } else {
+        for (auto it = m_namespaceAttributes.cbegin(); it != m_namespaceAttributes.cend(); ++it)
+            key += it.key() + u'|' + it.value().join(u'|') + u'\t';
     }
-    return results;
+    return key + u'\n' + searchInput;
 }
 
-void Reader::searchInDB(const QString &searchInput)
+bool Reader::searchInDB(const QString &searchInput, const std::function<bool()> &isCanceled)
 {
+    bool finished = false;
+    m_searchResultIds.clear();
     const QString &uniqueId = QHelpGlobal::uniquifyConnectionName("QHelpReader"_L1, this);
     {
         QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE"_L1, uniqueId);
@@ -155,28 +191,84 @@ void Reader::searchInDB(const QString &searchInput)
         db.setDatabaseName(m_indexPath + "/fts"_L1);
 
         if (db.open()) {
-            const QList<QHelpSearchResult> titleResults = queryTable(db, "titles"_L1, searchInput);
-            const QList<QHelpSearchResult> contentResults =
-                    queryTable(db, "contents"_L1, searchInput);
-
             // merge results form title and contents searches
-            m_searchResults.clear();
-            QSet<QUrl> urls;
-            for (const QHelpSearchResult &result : titleResults) {
-                const auto size = urls.size();
-                urls.insert(result.url());
-                if (size != urls.size()) // insertion took place
-                    m_searchResults.append(result);
-            }
-            for (const QHelpSearchResult &result : contentResults) {
-                const auto size = urls.size();
-                urls.insert(result.url());
-                if (size != urls.size()) // insertion took place
-                    m_searchResults.append(result);
-            }
+            QSet<QString> urls;
+            finished = queryTable(db, "titles"_L1, searchInput, isCanceled, &urls)
+                    && !isCanceled()
+                    && queryTable(db, "contents"_L1, searchInput, isCanceled, &urls);
+        }
+    }
+    QSqlDatabase::removeDatabase(uniqueId);
+    if (!finished)
+        m_searchResultIds.clear();
+    return finished;
+}
+
+void Reader::fetchFromTable(const QSqlDatabase &db, const QString &tableName,
+                            const QString &searchInput, const QList<qint64> &rowIds,
+                            QHash<qint64, QHelpSearchResult> *results) const
+{
+    if (rowIds.isEmpty())
+        return;
+
+    QStringList rowIdList;
+    rowIdList.reserve(rowIds.size());
+    for (qint64 rowId : rowIds)
+        rowIdList.append(QString::number(rowId));
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT rowid, url, title, snippet("_L1 + tableName +
+                  ", -1, '<b>', '</b>', '...', '10') FROM "_L1 + tableName +
+                  " WHERE "_L1 + tableName + " MATCH ? AND rowid IN ("_L1 +
+                  rowIdList.join(u',') + u')');
+    query.addBindValue(searchInput);
+    query.exec();
+
+    while (query.next()) {
+        results->insert(query.value(0).toLongLong(),
+                        QHelpSearchResult(query.value(1).toString(), query.value(2).toString(),
+                                          query.value(3).toString()));
+    }
+}
+
+/*
+    Returns the search results for \a ids, in the same order. The snippets
+    are generated for these documents only, which is what makes paging
+    through large result sets cheap.
+*/
+QList<QHelpSearchResult> Reader::fetchResults(const QString &searchInput,
+                                              const QList<SearchResultId> &ids)
+{
+    QList<qint64> titleRowIds;
+    QList<qint64> contentRowIds;
+    for (const SearchResultId &id : ids)
+        (id.fromTitles ? titleRowIds : contentRowIds).append(id.rowId);
+
+    QHash<qint64, QHelpSearchResult> titleResults;
+    QHash<qint64, QHelpSearchResult> contentResults;
+    const QString &uniqueId = QHelpGlobal::uniquifyConnectionName("QHelpReader"_L1, this);
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE"_L1, uniqueId);
+        db.setConnectOptions("QSQLITE_OPEN_READONLY"_L1);
+        db.setDatabaseName(m_indexPath + "/fts"_L1);
+
+        if (db.open()) {
+            fetchFromTable(db, "titles"_L1, searchInput, titleRowIds, &titleResults);
+            fetchFromTable(db, "contents"_L1, searchInput, contentRowIds, &contentResults);
         }
     }
     QSqlDatabase::removeDatabase(uniqueId);
+
+    QList<QHelpSearchResult> results;
+    results.reserve(ids.size());
+    for (const SearchResultId &id : ids) {
+        const auto &fetched = id.fromTitles ? titleResults : contentResults;
+        const auto it = fetched.constFind(id.rowId);
+        if (it != fetched.cend())
+            results.append(*it);
+    }
+    return results;
 }
 
 static bool attributesMatchFilter(const QStringList &attributes, const QStringList &filter)
@@ -200,12 +292,18 @@ void QHelpSearchIndexReader::cancelSearching()
     m_cancel = true;
 }
 
+void QHelpSearchIndexReader::clearCache()
+{
+    QMutexLocker lock(&m_mutex);
+    m_resultCache.clear();
+}
+
 void QHelpSearchIndexReader::search(const QString &collectionFile, const QString &indexFilesFolder,
                                     const QString &searchInput, bool usesFilterEngine)
 {
     wait();
 
-    m_searchResults.clear();
+    m_searchResultIds.clear();
     m_cancel = false;
     m_searchInput = searchInput;
     m_collectionFile = collectionFile;
@@ -218,13 +316,23 @@ void QHelpSearchIndexReader::search(const QString &collectionFile, const QString
 int QHelpSearchIndexReader::searchResultCount() const
 {
     QMutexLocker lock(&m_mutex);
-    return m_searchResults.size();
+    return m_searchResultIds.size();
 }
 
 QList<QHelpSearchResult> QHelpSearchIndexReader::searchResults(int start, int end) const
 {
     QMutexLocker lock(&m_mutex);
-    return m_searchResults.mid(start, end - start);
+    const QList<SearchResultId> ids = m_searchResultIds.mid(start, end - start);
+    const QString searchInput = m_resultSearchInput;
+    const QString indexPath = m_resultIndexFilesFolder;
+    lock.unlock();
+
+    if (ids.isEmpty())
+        return {};
+
+    Reader reader;
+    reader.setIndexPath(indexPath);
+    return reader.fetchResults(searchInput, ids);
 }
 
 void QHelpSearchIndexReader::run()
@@ -275,13 +383,32 @@ void QHelpSearchIndexReader::run()
         emit searchingFinished();
         return;
     }
-    m_searchResults.clear();
+    m_searchResultIds.clear();
+    const QString key = reader.cacheKey(searchInput);
+    if (const QList<SearchResultId> *cached = m_resultCache.object(key)) {
+        m_searchResultIds = *cached;
+        m_resultSearchInput = searchInput;
+        m_resultIndexFilesFolder = indexPath;
+        lock.unlock();
+        emit searchingFinished();
+        return;
+    }
     lock.unlock();
 
-    reader.searchInDB(searchInput);    // TODO: should this be interruptible as well ???
+    const auto isCanceled = [this] {
+        QMutexLocker locker(&m_mutex);
+        return m_cancel;
+    };
+    if (!reader.searchInDB(searchInput, isCanceled)) {
+        emit searchingFinished();
+        return;
+    }
 
     lock.relock();
-    m_searchResults = reader.searchResults();
+    m_searchResultIds = reader.searchResultIds();
+    m_resultCache.insert(key, new QList<SearchResultId>(m_searchResultIds));
+    m_resultSearchInput = searchInput;
+    m_resultIndexFilesFolder = indexPath;
     lock.unlock();
 
     emit searchingFinished();
@@ -17,6 +17,7 @@
 
 #include "qhelpsearchresult.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
@@ -25,6 +26,13 @@ QT_BEGIN_NAMESPACE
 
 namespace fulltextsearch {
 
+// Identifies a search result by its row in the titles or contents table.
+struct SearchResultId
+{
+    qint64 rowId;
+    bool fromTitles;
+};
+
 // TODO: Employ QFuture / QtConcurrent::run() ?
 class QHelpSearchIndexReader : public QThread
 {
@@ -34,6 +42,7 @@ public:
     ~QHelpSearchIndexReader() override;
 
     void cancelSearching();
+    void clearCache();
     void search(const QString &collectionFile, const QString &indexFilesFolder,
                 const QString &searchInput, bool usesFilterEngine = false);
     int searchResultCount() const;
@@ -47,7 +56,12 @@ private:
     void run() override;
 
     mutable QMutex m_mutex;
-    QList<QHelpSearchResult> m_searchResults;
+    QList<SearchResultId> m_searchResultIds;
+    QString m_resultSearchInput;
+    QString m_resultIndexFilesFolder;
+    // The result ids of the latest searches, keyed by index, filter and
+    // search input, so retyping or going back to a query skips the index.
+    QCache<QString, QList<SearchResultId>> m_resultCache { 32 };
     bool m_cancel = false;
     QString m_collectionFile;
     QString m_searchInput;
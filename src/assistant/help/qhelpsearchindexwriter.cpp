@@ -6,19 +6,27 @@
 #include "qhelpdbreader_p.h"
 #include "qhelpenginecore.h"
 
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdatastream.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstringconverter.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qvariant.h>
+#include <QtCore/qwaitcondition.h>
 #include <QtGui/qtextdocument.h>
 #include <QtSql/qsqldatabase.h>
 #include <QtSql/qsqldriver.h>
 #include <QtSql/qsqlerror.h>
 #include <QtSql/qsqlquery.h>
 
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -27,9 +35,29 @@ namespace fulltextsearch {
 
 const char FTS_DB_NAME[] = "fts";
 
+// The number of documents collected before they are inserted into the database.
+static const qsizetype WriterBatchSize = 256;
+
+static QByteArray contentHash(QByteArrayView data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+static QString documentKey(const QString &attributes, const QString &url)
+{
+    return attributes + u'\n' + url;
+}
+
 class Writer
 {
 public:
+    // A document already in the index, keyed by documentKey().
+    struct IndexedDocument
+    {
+        qint64 id = -1;
+        QByteArray hash;
+    };
+
     Writer(const QString &path);
     ~Writer();
 
@@ -38,12 +66,14 @@ public:
 
     void removeNamespace(const QString &namespaceName);
     bool hasNamespace(const QString &namespaceName);
+    QHash<QString, IndexedDocument> indexedDocuments(const QString &namespaceName);
+    void removeDocuments(const QList<qint64> &ids);
     void insertDoc(const QString &namespaceName,
                    const QString &attributes,
                    const QString &url,
                    const QString &title,
-                   const QString &contents);
-    void startTransaction();
+                   const QString &contents,
+                   const QByteArray &hash);
     void endTransaction();
 
 private:
@@ -61,6 +91,7 @@ private:
     QVariantList m_urls;
     QVariantList m_titles;
     QVariantList m_contents;
+    QVariantList m_hashes;
 };
 
 Writer::Writer(const QString &path)
@@ -71,6 +102,9 @@ Writer::Writer(const QString &path)
     m_uniqueId = QHelpGlobal::uniquifyConnectionName("QHelpWriter"_L1, this);
     m_db = QSqlDatabase::addDatabase("QSQLITE"_L1, m_uniqueId);
     const QString dbPath = m_dbDir + u'/' + QLatin1StringView(FTS_DB_NAME);
+    // Wait for another process writing the same index inside SQLite
+    // instead of failing right away with SQLITE_BUSY.
+    m_db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=30000"_L1);
     m_db.setDatabaseName(dbPath);
     if (!m_db.open()) {
         const QString &error = QHelpSearchIndexWriter::tr(
@@ -81,7 +115,8 @@ Writer::Writer(const QString &path)
         QSqlDatabase::removeDatabase(m_uniqueId);
         m_uniqueId.clear();
     } else {
-        startTransaction();
+        // Lets the search readers query the index while it is written.
+        QSqlQuery(m_db).exec("PRAGMA journal_mode=WAL"_L1);
     }
 }
 
@@ -90,15 +125,12 @@ bool Writer::tryInit(bool reindex)
     if (!m_db.isValid())
         return true;
 
+    // Take the write lock up front. SQLite waits for it for the busy timeout
+    // of the connection, and only reports SQLITE_BUSY (5) once that passed.
     QSqlQuery query(m_db);
-    // HACK: we try to perform any modifying command just to check if
-    // we don't get SQLITE_BUSY code (SQLITE_BUSY is defined to 5 in sqlite driver)
-    if (!query.exec("CREATE TABLE foo ();"_L1) && query.lastError().nativeErrorCode() == "5"_L1) // db is locked
+    if (!query.exec("BEGIN IMMEDIATE;"_L1) && query.lastError().nativeErrorCode() == "5"_L1)
         return false;
 
-    // HACK: clear what we have created
-    query.exec("DROP TABLE foo;"_L1);
-
     init(reindex);
     return true;
 }
@@ -145,7 +177,19 @@ void Writer::init(bool reindex)
         query.exec("DROP TABLE info;"_L1);
     }
 
-    query.exec("CREATE TABLE info (id INTEGER PRIMARY KEY, namespace, attributes, url, title, data);"_L1);
+    query.exec("CREATE TABLE info (id INTEGER PRIMARY KEY, namespace, attributes, url, title, data, "
+               "hash);"_L1);
+
+    // Indexes written before the content hashes were stored get the column
+    // added. Their documents have no hash, and are reindexed when they change.
+    bool hasHashColumn = false;
+    query.exec("PRAGMA table_info(info);"_L1);
+    while (query.next()) {
+        if (query.value(1).toString() == "hash"_L1)
+            hasHashColumn = true;
+    }
+    if (!hasHashColumn)
+        query.exec("ALTER TABLE info ADD COLUMN hash;"_L1);
 
     query.exec("CREATE VIRTUAL TABLE titles USING fts5("
                "namespace UNINDEXED, attributes UNINDEXED, "
@@ -188,8 +232,11 @@ void Writer::init(bool reindex)
 
 Writer::~Writer()
 {
-    if (m_db.isValid())
+    if (m_db.isValid()) {
+        // Restore the rollback journal once the index is written.
+        QSqlQuery(m_db).exec("PRAGMA journal_mode=DELETE"_L1);
         m_db.close();
+    }
     m_db = {};
     if (!m_uniqueId.isEmpty())
         QSqlDatabase::removeDatabase(m_uniqueId);
@@ -201,12 +248,14 @@ void Writer::flush()
         return;
 
     QSqlQuery query(m_db);
-    query.prepare("INSERT INTO info (namespace, attributes, url, title, data) VALUES (?, ?, ?, ?, ?)"_L1);
+    query.prepare("INSERT INTO info (namespace, attributes, url, title, data, hash) "
+                  "VALUES (?, ?, ?, ?, ?, ?)"_L1);
     query.addBindValue(m_namespaces);
     query.addBindValue(m_attributes);
     query.addBindValue(m_urls);
     query.addBindValue(m_titles);
     query.addBindValue(m_contents);
+    query.addBindValue(m_hashes);
     query.execBatch();
 
     m_namespaces.clear();
@@ -214,6 +263,7 @@ void Writer::flush()
     m_urls.clear();
     m_titles.clear();
     m_contents.clear();
+    m_hashes.clear();
 }
 
 void Writer::removeNamespace(const QString &namespaceName)
@@ -240,27 +290,55 @@ bool Writer::hasNamespace(const QString &namespaceName)
     return query.next();
 }
 
+QHash<QString, Writer::IndexedDocument> Writer::indexedDocuments(const QString &namespaceName)
+{
+    QHash<QString, IndexedDocument> documents;
+    if (!m_db.isValid())
+        return documents;
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, attributes, url, hash FROM info WHERE namespace = ?"_L1);
+    query.addBindValue(namespaceName);
+    query.exec();
+    while (query.next()) {
+        documents.insert(documentKey(query.value(1).toString(), query.value(2).toString()),
+                         { query.value(0).toLongLong(), query.value(3).toByteArray() });
+    }
+    return documents;
+}
+
+void Writer::removeDocuments(const QList<qint64> &ids)
+{
+    if (!m_db.isValid() || ids.isEmpty())
+        return;
+
+    // The triggers remove the documents from the full text tables as well,
+    // so, unlike after removeNamespace(), these do not need to be rebuilt.
+    QVariantList idList;
+    idList.reserve(ids.size());
+    for (qint64 id : ids)
+        idList.append(id);
+
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM info WHERE id = ?"_L1);
+    query.addBindValue(idList);
+    query.execBatch();
+}
+
 void Writer::insertDoc(const QString &namespaceName,
                        const QString &attributes,
                        const QString &url,
                        const QString &title,
-                       const QString &contents)
+                       const QString &contents,
+                       const QByteArray &hash)
 {
     m_namespaces.append(namespaceName);
     m_attributes.append(attributes);
     m_urls.append(url);
     m_titles.append(title);
     m_contents.append(contents);
-}
-
-void Writer::startTransaction()
-{
-    if (!m_db.isValid())
-        return;
-
-    m_needOptimize = false;
-    if (m_db.driver()->hasFeature(QSqlDriver::Transactions))
-        m_db.transaction();
+    m_hashes.append(hash);
 }
 
 void Writer::endTransaction()
@@ -282,6 +360,158 @@ void Writer::endTransaction()
         query.exec("VACUUM"_L1);
 }
 
+// Converts documentation files to the text that goes into the index on a
+// pool of worker threads. The SQLite connections stay on the indexing
+// thread, which queues the files and inserts the extracted documents.
+class TextExtractor
+{
+public:
+    struct Document
+    {
+        QString namespaceName;
+        QString attributes;
+        QString url;
+        QString title;
+        QString contents;
+        QByteArray hash;
+    };
+
+    TextExtractor();
+    ~TextExtractor();
+
+    // Blocks while too many files are waiting to be extracted.
+    void enqueue(Document &&document, QByteArray &&data);
+    QList<Document> takeDocuments();
+    void waitForDone();
+    void clear();
+
+private:
+    struct Job
+    {
+        Document document;
+        QByteArray data;
+    };
+
+    void work();
+    static bool extract(Job *job);
+
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    QQueue<Job> m_jobs;
+    QList<Document> m_documents;
+    qsizetype m_maxJobs;
+    int m_busy = 0;
+    bool m_stopped = false;
+    QThreadPool m_pool;
+};
+
+TextExtractor::TextExtractor()
+{
+    const int threadCount = qMax(1, QThread::idealThreadCount());
+    m_maxJobs = 4 * threadCount;
+    m_pool.setMaxThreadCount(threadCount);
+    m_pool.setThreadPriority(QThread::LowestPriority);
+    for (int i = 0; i < threadCount; ++i)
+        m_pool.start([this] { work(); });
+}
+
+TextExtractor::~TextExtractor()
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        m_jobs.clear();
+        m_stopped = true;
+        m_condition.wakeAll();
+    }
+    m_pool.waitForDone();
+}
+
+void TextExtractor::enqueue(Document &&document, QByteArray &&data)
+{
+    QMutexLocker lock(&m_mutex);
+    while (m_jobs.size() >= m_maxJobs)
+        m_condition.wait(&m_mutex);
+    m_jobs.enqueue({ std::move(document), std::move(data) });
+    m_condition.wakeAll();
+}
+
+QList<TextExtractor::Document> TextExtractor::takeDocuments()
+{
+    QMutexLocker lock(&m_mutex);
+    return std::exchange(m_documents, {});
+}
+
+void TextExtractor::waitForDone()
+{
+    QMutexLocker lock(&m_mutex);
+    while (!m_jobs.isEmpty() || m_busy > 0)
+        m_condition.wait(&m_mutex);
+}
+
+void TextExtractor::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_jobs.clear();
+    while (m_busy > 0)
+        m_condition.wait(&m_mutex);
+    m_documents.clear();
+}
+
+void TextExtractor::work()
+{
+    QMutexLocker lock(&m_mutex);
+    while (true) {
+        while (m_jobs.isEmpty() && !m_stopped)
+            m_condition.wait(&m_mutex);
+        if (m_stopped)
+            return;
+
+        Job job = m_jobs.dequeue();
+        ++m_busy;
+        m_condition.wakeAll();
+        lock.unlock();
+
+        const bool extracted = extract(&job);
+
+        lock.relock();
+        --m_busy;
+        if (extracted)
+            m_documents.append(std::move(job.document));
+        m_condition.wakeAll();
+    }
+}
+
+bool TextExtractor::extract(Job *job)
+{
+    Document &document = job->document;
+    return extractSearchText(document.url, job->data, &document.title, &document.contents);
+}
+
+bool extractSearchText(const QString &fileName, const QByteArray &data,
+                       QString *title, QString *contents)
+{
+    QTextStream s(data);
+    auto encoding = QStringDecoder::encodingForHtml(data);
+    if (encoding)
+        s.setEncoding(*encoding);
+
+    const QString &text = s.readAll();
+    if (text.isEmpty())
+        return false;
+
+    if (fileName.endsWith(".txt"_L1)) {
+        *title = fileName.mid(fileName.lastIndexOf(u'/') + 1);
+        *contents = text.toHtmlEscaped();
+    } else {
+        QTextDocument doc;
+        doc.setHtml(text);
+
+        *title = doc.metaInformation(QTextDocument::DocumentTitle).toHtmlEscaped();
+        *contents = doc.toPlainText().toHtmlEscaped();
+    }
+    return true;
+}
+
 QHelpSearchIndexWriter::~QHelpSearchIndexWriter()
 {
     m_mutex.lock();
@@ -360,11 +590,35 @@ void QHelpSearchIndexWriter::run()
 
     Writer writer(indexPath);
 
-    while (!writer.tryInit(reindex))
-        sleep(1);
+    // Each attempt blocks for the busy timeout of the writer's connection.
+    while (!writer.tryInit(reindex)) {
+        lock.relock();
+        if (m_cancel) {
+            emit indexingFinished();
+            return;
+        }
+        lock.unlock();
+    }
 
     const QStringList &registeredDocs = engine.registeredDocumentations();
     QMap<QString, QDateTime> indexMap = readIndexMap(engine);
+    // Namespaces whose documentation file changed since they were indexed.
+    // Only their documents with a different content hash are reindexed.
+    QSet<QString> outdatedNamespaces;
+
+    TextExtractor extractor;
+    qsizetype pendingCount = 0;
+    const auto insertDocuments = [&](const QList<TextExtractor::Document> &documents) {
+        for (const TextExtractor::Document &document : documents) {
+            writer.insertDoc(document.namespaceName, document.attributes, document.url,
+                             document.title, document.contents, document.hash);
+        }
+        pendingCount += documents.size();
+        if (pendingCount >= WriterBatchSize) {
+            writer.flush();
+            pendingCount = 0;
+        }
+    };
 
     if (!reindex) {
         for (const QString &namespaceName : registeredDocs) {
@@ -372,9 +626,8 @@ void QHelpSearchIndexWriter::run()
             if (it != indexMap.constEnd()) {
                 const QString path = engine.documentationFileName(namespaceName);
                 if (*it < QFileInfo(path).lastModified()) {
-                    // Remove some outdated indexed stuff
                     indexMap.erase(it);
-                    writer.removeNamespace(namespaceName);
+                    outdatedNamespaces.insert(namespaceName);
                 } else if (!writer.hasNamespace(namespaceName)) {
                     // No data in fts db for namespace.
                     // The namespace could have been removed from fts db
@@ -428,6 +681,19 @@ void QHelpSearchIndexWriter::run()
             continue;
 
         const QString virtualFolder = reader.virtualFolder();
+        const bool prebuilt = reader.hasSearchText();
+
+        QHash<QString, Writer::IndexedDocument> indexedDocuments;
+        if (outdatedNamespaces.contains(namespaceName))
+            indexedDocuments = writer.indexedDocuments(namespaceName);
+        // Whatever is left in indexedDocuments afterwards was removed or changed.
+        const auto isIndexed = [&indexedDocuments](const QString &key, const QByteArray &hash) {
+            const auto it = indexedDocuments.constFind(key);
+            if (it == indexedDocuments.cend() || it->hash != hash)
+                return false;
+            indexedDocuments.erase(it);
+            return true;
+        };
 
         const QList<QStringList> &attributeSets =
             engine.filterAttributeSets(namespaceName);
@@ -435,17 +701,13 @@ void QHelpSearchIndexWriter::run()
         for (const QStringList &attributes : attributeSets) {
             const QString &attributesString = attributes.join(u'|');
 
-            const auto htmlFiles = reader.filesData(attributes, "html"_L1);
-            const auto htmFiles = reader.filesData(attributes, "htm"_L1);
-            const auto txtFiles = reader.filesData(attributes, "txt"_L1);
-
-            auto files = htmlFiles;
-            files.unite(htmFiles);
-            files.unite(txtFiles);
-
-            for (auto it = files.cbegin(), end = files.cend(); it != end ; ++it) {
+            auto files = prebuilt
+                    ? reader.searchTextCursor(attributes, {"html"_L1, "htm"_L1, "txt"_L1})
+                    : reader.filesDataCursor(attributes, {"html"_L1, "htm"_L1, "txt"_L1});
+            while (files.next()) {
                 lock.relock();
                 if (m_cancel) {
+                    extractor.clear();
                     // store what we have done so far
                     writeIndexMap(&engine, indexMap);
                     writer.endTransaction();
@@ -454,16 +716,10 @@ void QHelpSearchIndexWriter::run()
                 }
                 lock.unlock();
 
-                const QString &file = it.key();
-                const QByteArray &data = it.value();
-
-                if (data.isEmpty())
-                    continue;
-
                 QUrl url;
                 url.setScheme("qthelp"_L1);
                 url.setAuthority(namespaceName);
-                url.setPath(u'/' + virtualFolder + u'/' + file);
+                url.setPath(u'/' + virtualFolder + u'/' + files.name());
 
                 if (url.hasFragment())
                     url.setFragment({});
@@ -474,32 +730,43 @@ void QHelpSearchIndexWriter::run()
                     continue;
                 }
 
-                QTextStream s(data);
-                auto encoding = QStringDecoder::encodingForHtml(data);
-                if (encoding)
-                    s.setEncoding(*encoding);
+                const QString key = documentKey(attributesString, fullFileName);
+                if (prebuilt) {
+                    // The text was extracted by qhelpgenerator already.
+                    const QString title = files.title();
+                    const QString text = files.text();
+                    const QByteArray hash = contentHash((title + u'\n' + text).toUtf8());
+                    if (!isIndexed(key, hash)) {
+                        insertDocuments({ { namespaceName, attributesString, fullFileName,
+                                            title, text, hash } });
+                    }
+                    continue;
+                }
 
-                const QString &text = s.readAll();
-                if (text.isEmpty())
+                QByteArray data = files.data();
+                if (data.isEmpty())
                     continue;
 
-                QString title;
-                QString contents;
-                if (fullFileName.endsWith(".txt"_L1)) {
-                    title = fullFileName.mid(fullFileName.lastIndexOf(u'/') + 1);
-                    contents = text.toHtmlEscaped();
-                } else {
-                    QTextDocument doc;
-                    doc.setHtml(text);
-
-                    title = doc.metaInformation(QTextDocument::DocumentTitle).toHtmlEscaped();
-                    contents = doc.toPlainText().toHtmlEscaped();
-                }
+                const QByteArray hash = contentHash(data);
+                if (isIndexed(key, hash))
+                    continue;
 
-                writer.insertDoc(namespaceName, attributesString, fullFileName, title, contents);
+                extractor.enqueue({ namespaceName, attributesString, fullFileName, {}, {}, hash },
+                                  std::move(data));
+                insertDocuments(extractor.takeDocuments());
             }
         }
+        extractor.waitForDone();
+        insertDocuments(extractor.takeDocuments());
         writer.flush();
+        pendingCount = 0;
+
+        QList<qint64> outdatedIds;
+        outdatedIds.reserve(indexedDocuments.size());
+        for (const Writer::IndexedDocument &document : std::as_const(indexedDocuments))
+            outdatedIds.append(document.id);
+        writer.removeDocuments(outdatedIds);
+
         const QString &path = engine.documentationFileName(namespaceName);
         indexMap.insert(namespaceName, QFileInfo(path).lastModified());
     }
@@ -15,6 +15,8 @@
 // We mean it.
 //
 
+#include "qhelp_global.h"
+
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
 
@@ -24,6 +26,12 @@ class QSqlDatabase;
 
 namespace fulltextsearch {
 
+// Converts the documentation file \a fileName with the given \a data to
+// the HTML escaped \a title and \a contents stored in the search index.
+// Returns false if the file has no text to index.
+QHELP_EXPORT bool extractSearchText(const QString &fileName, const QByteArray &data,
+                                    QString *title, QString *contents);
+
 // TODO: Employ QFuture / QtConcurrent::run() ?
 class QHelpSearchIndexWriter : public QThread
 {
@@ -3,12 +3,16 @@
 
 #include "qhelpengineplugin.h"
 
+#include <QtCore/qthread.h>
+
 #include <algorithm>
 #include <iterator>
 #include <memory>
 
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 static std::vector<QQmlLSHelpProvider::DocumentLink>
 transformQHelpLink(QList<QHelpLink> &&qhelplinklist)
 {
@@ -24,62 +28,164 @@ transformQHelpLink(QList<QHelpLink> &&qhelplinklist)
 }
 
 QQmlLSHelpProvider::QQmlLSHelpProvider(const QString &qhcFilePath, QObject *parent)
+    : m_collectionFile(qhcFilePath), m_ownerThread(QThread::currentThread())
 {
     m_helpEngine.emplace(qhcFilePath, parent);
     m_helpEngine->setReadOnly(false);
     m_helpEngine->setupData();
 }
 
+QQmlLSHelpProvider::~QQmlLSHelpProvider() = default;
+
+namespace {
+// QSqlDatabase connections cannot be shared between threads, so every other
+// thread querying a provider gets a read-only engine of its own. They are
+// kept in thread-local storage so that each one is closed on the thread that
+// opened it when that thread exits, also for threads not started by QThread.
+struct ThreadEngine
+{
+    const QQmlLSHelpProvider *provider = nullptr;
+    std::weak_ptr<int> lifetime;
+    int generation = 0;
+    std::unique_ptr<QHelpEngineCore> engine;
+};
+} // namespace
+
+QHelpEngineCore &QQmlLSHelpProvider::engine() const
+{
+    Q_ASSERT(m_helpEngine.has_value());
+    // Asking for the current thread first also sets up Qt's data for this
+    // thread before the engines below, so that it outlives them.
+    if (QThread::currentThread() == m_ownerThread)
+        return const_cast<QHelpEngineCore &>(*m_helpEngine);
+
+    static thread_local std::vector<ThreadEngine> threadEngines;
+    // Close the engines of providers destroyed in the meantime, before a new
+    // provider can show up at the same address.
+    threadEngines.erase(std::remove_if(threadEngines.begin(), threadEngines.end(),
+                                       [](const ThreadEngine &threadEngine) {
+                                           return threadEngine.lifetime.expired();
+                                       }),
+                        threadEngines.end());
+
+    auto it = std::find_if(threadEngines.begin(), threadEngines.end(),
+                           [this](const ThreadEngine &threadEngine) {
+                               return threadEngine.provider == this;
+                           });
+    if (it == threadEngines.end()) {
+        it = threadEngines.insert(threadEngines.end(), ThreadEngine());
+        it->provider = this;
+        it->lifetime = m_lifetime;
+    }
+
+    // Set up the engine again when documentation has been registered since.
+    const int generation = m_generation.loadAcquire();
+    if (!it->engine || it->generation != generation) {
+        it->engine.reset();
+        it->engine = std::make_unique<QHelpEngineCore>(m_collectionFile);
+        it->engine->setupData();
+        it->generation = generation;
+    }
+    return *it->engine;
+}
+
+// Registration writes to the collection file and must happen on the thread
+// that created the provider.
 bool QQmlLSHelpProvider::registerDocumentation(const QString &documentationFileName)
 {
     Q_ASSERT(m_helpEngine.has_value());
-    return m_helpEngine->registerDocumentation(documentationFileName);
+    Q_ASSERT(QThread::currentThread() == m_ownerThread);
+    const bool registered = m_helpEngine->registerDocumentation(documentationFileName);
+    if (registered) {
+        m_generation.fetchAndAddRelease(1);
+        clearCaches();
+    }
+    return registered;
 }
 
 QByteArray QQmlLSHelpProvider::fileData(const QUrl &url) const
 {
-    Q_ASSERT(m_helpEngine.has_value());
-    return m_helpEngine->fileData(url);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const QByteArray *data = m_fileDataCache.object(url))
+            return *data;
+    }
+    QByteArray data = engine().fileData(url);
+    if (!data.isEmpty()) {
+        const qsizetype cost = qMax<qsizetype>(1, data.size() / 1024);
+        QMutexLocker locker(&m_mutex);
+        m_fileDataCache.insert(url, new QByteArray(data), cost);
+    }
+    return data;
+}
+
+template <typename Lookup>
+std::vector<QQmlLSHelpProvider::DocumentLink>
+QQmlLSHelpProvider::cachedLinks(const QString &key, Lookup lookup) const
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const auto *links = m_linkCache.object(key))
+            return *links;
+    }
+    auto links = transformQHelpLink(lookup(engine()));
+    QMutexLocker locker(&m_mutex);
+    m_linkCache.insert(key, new std::vector<DocumentLink>(links));
+    return links;
 }
 
+// The filter-less overloads use the engine's current filter, which may differ
+// from an explicitly empty filter name, hence the distinct key prefixes.
 std::vector<QQmlLSHelpProvider::DocumentLink>
 QQmlLSHelpProvider::documentsForIdentifier(const QString &id) const
 {
-    Q_ASSERT(m_helpEngine.has_value());
-    return transformQHelpLink(m_helpEngine->documentsForIdentifier(id));
+    return cachedLinks(u"i:"_s + id, [&](QHelpEngineCore &engine) {
+        return engine.documentsForIdentifier(id);
+    });
 }
 
 std::vector<QQmlLSHelpProvider::DocumentLink>
 QQmlLSHelpProvider::documentsForIdentifier(const QString &id, const QString &filterName) const
 {
-    Q_ASSERT(m_helpEngine.has_value());
-    return transformQHelpLink(m_helpEngine->documentsForIdentifier(id, filterName));
+    return cachedLinks(u"I:"_s + filterName + u'\n' + id,
+                       [&](QHelpEngineCore &engine) {
+                           return engine.documentsForIdentifier(id, filterName);
+                       });
 }
 
 std::vector<QQmlLSHelpProvider::DocumentLink>
 QQmlLSHelpProvider::documentsForKeyword(const QString &keyword) const
 {
-    Q_ASSERT(m_helpEngine.has_value());
-    return transformQHelpLink(m_helpEngine->documentsForKeyword(keyword));
+    return cachedLinks(u"k:"_s + keyword,
+                       [&](QHelpEngineCore &engine) {
+                           return engine.documentsForKeyword(keyword);
+                       });
 }
 
 std::vector<QQmlLSHelpProvider::DocumentLink>
 QQmlLSHelpProvider::documentsForKeyword(const QString &keyword, const QString &filter) const
 {
-    Q_ASSERT(m_helpEngine.has_value());
-    return transformQHelpLink(m_helpEngine->documentsForKeyword(keyword, filter));
+    return cachedLinks(u"K:"_s + filter + u'\n' + keyword,
+                       [&](QHelpEngineCore &engine) {
+                           return engine.documentsForKeyword(keyword, filter);
+                       });
+}
+
+void QQmlLSHelpProvider::clearCaches()
+{
+    QMutexLocker locker(&m_mutex);
+    m_linkCache.clear();
+    m_fileDataCache.clear();
 }
 
 QStringList QQmlLSHelpProvider::registeredNamespaces() const
 {
-    Q_ASSERT(m_helpEngine.has_value());
-    return m_helpEngine->registeredDocumentations();
+    return engine().registeredDocumentations();
 }
 
 QString QQmlLSHelpProvider::error() const
 {
-    Q_ASSERT(m_helpEngine.has_value());
-    return m_helpEngine->error();
+    return engine().error();
 }
 
 QHelpEnginePlugin::QHelpEnginePlugin(QObject *parent) : QObject(parent) { }
@@ -15,13 +15,17 @@
 // We mean it.
 //
 
+#include <QtCore/qcache.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qplugin.h>
+#include <QtCore/qurl.h>
 #include <QtHelp/qhelpenginecore.h>
 #include <QtHelp/qhelplink.h>
 
 #include <QtQmlLS/private/qqmllshelpplugininterface_p.h>
 
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -34,6 +38,9 @@ class QQmlLSHelpProvider : public QQmlLSHelpProviderBase
 {
 public:
     QQmlLSHelpProvider(const QString &qhcFile, QObject *parent = nullptr);
+    ~QQmlLSHelpProvider() override;
+    Q_DISABLE_COPY_MOVE(QQmlLSHelpProvider)
+
     bool registerDocumentation(const QString &documentationFileName) override;
     [[nodiscard]] QByteArray fileData(const QUrl &url) const override;
     [[nodiscard]] std::vector<DocumentLink> documentsForIdentifier(const QString &id) const override;
@@ -44,7 +51,23 @@ public:
     [[nodiscard]] QString error() const override;
 
 private:
+    template <typename Lookup>
+    [[nodiscard]] std::vector<DocumentLink> cachedLinks(const QString &key, Lookup lookup) const;
+    [[nodiscard]] QHelpEngineCore &engine() const;
+    void clearCaches();
+
+    const QString m_collectionFile;
+    QThread *const m_ownerThread;
     std::optional<QHelpEngineCore> m_helpEngine;
+    // Lets the engines other threads open for this provider notice that it
+    // is gone.
+    const std::shared_ptr<int> m_lifetime = std::make_shared<int>();
+    QAtomicInt m_generation;
+    mutable QMutex m_mutex;
+    // Hovering keeps asking for the same few identifiers and pages, so keep
+    // the most recent link lookups and uncompressed pages around.
+    mutable QCache<QString, std::vector<DocumentLink>> m_linkCache { 256 };
+    mutable QCache<QUrl, QByteArray> m_fileDataCache { 8 * 1024 }; // cost in KiB
 };
 
 class QHelpEnginePlugin : public QObject, public QQmlLSHelpPluginInterface
@@ -3,7 +3,9 @@
 
 #include "helpgenerator.h"
 #include "qhelpprojectdata_p.h"
+#include <chrometrace_p.h>
 #include <qhelp_global.h>
+#include <QtHelp/private/qhelpsearchindexwriter_p.h>
 
 #include <QtCore/QtMath>
 #include <QtCore/QMap>
@@ -11,19 +13,25 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
-#include <QtCore/QRegularExpression>
 #include <QtCore/QSet>
 #include <QtCore/QMap>
 #include <QtCore/QVariant>
 #include <QtCore/QDateTime>
 #include <QtCore/QStringConverter>
 #include <QtCore/QDataStream>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QThreadPool>
 #include <QtSql/QSqlQuery>
+#include <QtSql/QSqlRecord>
 
 #include <stdio.h>
 
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 class HelpGeneratorPrivate : public QObject
 {
     Q_OBJECT
@@ -36,19 +44,50 @@ public:
     bool checkLinks(const QHelpProjectData &helpData);
     QString error() const;
 
+    bool m_storeSearchText = false;
+    bool m_incremental = false;
+
 Q_SIGNALS:
     void statusChanged(const QString &msg);
     void progressChanged(double progress);
     void warning(const QString &msg);
 
 private:
-    struct FileNameTableData
+    struct FileTableData
     {
         QString name;
         int fileId;
+        QByteArray data;
         QString title;
+        bool hasSearchText = false;
+        QString searchTitle;
+        QString searchText;
+
+        // The file as stored in the previous output file, if any
+        bool hasPrevious = false;
+        bool previousHasSearchText = false;
+        bool reused = false;
+        QByteArray previousData;
+        QString previousTitle;
+        QString previousSearchTitle;
+        QString previousSearchText;
+    };
+
+    bool openPreviousFile(const QString &fileName);
+    void removePreviousFile();
+    void fetchPreviousFileData(FileTableData *file);
+    void prepareFileData(FileTableData *file) const;
+    void insertFileData(const QList<FileTableData> &fileDataList);
+
+    struct LinkCheckData
+    {
+        QString fileName;
+        bool opened = false;
+        QStringList invalidLinks;
     };
 
+    static void checkFileLinks(LinkCheckData *file, const QSet<QString> &files);
+
     void writeTree(QDataStream &s, QHelpDataContentItem *item, int depth);
     bool createTables();
     bool insertFileNotFoundFile();
@@ -70,6 +109,11 @@ private:
     QString m_error;
     QSqlQuery *m_query = nullptr;
 
+    // The output file of the previous run in incremental mode
+    QString m_previousFileName;
+    QSqlQuery *m_previousQuery = nullptr;
+    int m_reusedFileCount = 0;
+
     int m_namespaceId = -1;
     int m_virtualFolderId = -1;
 
@@ -91,6 +135,7 @@ private:
 bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
                               const QString &outputFileName)
 {
+    const ChromeTrace::Span span("generate"_L1, outputFileName);
     emit progressChanged(0);
     m_error.clear();
     if (!helpData || helpData->namespaceName().isEmpty()) {
@@ -104,15 +149,29 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
         return false;
     }
 
+    // The previous file is only needed while generating, however that ends.
+    const auto previousFileGuard = qScopeGuard([this] { removePreviousFile(); });
+
     QFileInfo fi(outFileName);
     if (fi.exists()) {
-        if (!fi.dir().remove(fi.fileName())) {
+        // In incremental mode, the old file is kept aside until the new
+        // one is written, so that the data of unchanged files is copied
+        // from it instead of being compressed again.
+        QString previousFileName;
+        if (m_incremental) {
+            previousFileName = outFileName + QLatin1String(".previous");
+            QFile::remove(previousFileName);
+        }
+        if (previousFileName.isEmpty() ? !fi.dir().remove(fi.fileName())
+                                       : !QFile::rename(outFileName, previousFileName)) {
             m_error = tr("The file %1 cannot be overwritten.").arg(outFileName);
             return false;
         }
+        m_previousFileName = previousFileName;
     }
 
     setupProgress(helpData);
+    m_reusedFileCount = 0;
 
     emit statusChanged(tr("Building up file structure..."));
     bool openingOk = true;
@@ -133,6 +192,11 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
     m_query->exec(QLatin1String("PRAGMA synchronous=OFF"));
     m_query->exec(QLatin1String("PRAGMA cache_size=3000"));
 
+    if (!m_previousFileName.isEmpty() && !openPreviousFile(m_previousFileName)) {
+        emit warning(tr("Cannot read the previous file %1, compressing all files.")
+                     .arg(outFileName));
+    }
+
     addProgress(1.0);
     createTables();
     insertFileNotFoundFile();
@@ -159,10 +223,12 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
         emit statusChanged(tr("Insert help data for filter section (%1 of %2)...")
             .arg(i++).arg(helpData->filterSections().size()));
         insertFilterAttributes(fs.filterAttributes());
-        QByteArray ba;
-        QDataStream s(&ba, QIODevice::WriteOnly);
-        for (QHelpDataContentItem *itm : fs.contents())
-            writeTree(s, itm, 0);
+        QByteArray ba = fs.serializedContents();
+        if (!fs.contents().isEmpty()) {
+            QDataStream s(&ba, QIODevice::WriteOnly | QIODevice::Append);
+            for (QHelpDataContentItem *itm : fs.contents())
+                writeTree(s, itm, 0);
+        }
         if (!insertFiles(fs.files(), helpData->rootPath(), fs.filterAttributes())
             || !insertContents(ba, fs.filterAttributes())
             || !insertKeywords(fs.indices(), fs.filterAttributes())) {
@@ -247,7 +313,7 @@ bool HelpGeneratorPrivate::createTables()
         return false;
     }
 
-    const QStringList tables = QStringList()
+    QStringList tables = QStringList()
             << QLatin1String("CREATE TABLE NamespaceTable ("
                              "Id INTEGER PRIMARY KEY,"
                              "Name TEXT )")
@@ -298,6 +364,12 @@ bool HelpGeneratorPrivate::createTables()
             << QLatin1String("CREATE TABLE MetaDataTable("
                              "Name Text, "
                              "Value BLOB )");
+    if (m_storeSearchText) {
+        tables << QLatin1String("CREATE TABLE SearchTextTable ("
+                                "FileId INTEGER PRIMARY KEY, "
+                                "Title TEXT, "
+                                "Text TEXT )");
+    }
 
     for (const QString &q : tables) {
         if (!m_query->exec(q)) {
@@ -387,6 +459,83 @@ bool HelpGeneratorPrivate::registerVirtualFolder(const QString &folderName, cons
     return false;
 }
 
+bool HelpGeneratorPrivate::openPreviousFile(const QString &fileName)
+{
+    bool hasSearchText = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), QLatin1String("previous"));
+        db.setDatabaseName(fileName);
+        if (db.open()) {
+            QSqlQuery query(db);
+            query.exec(QLatin1String("SELECT Name FROM sqlite_master WHERE TYPE='table' "
+                "AND Name IN ('FileNameTable', 'FileDataTable', 'SearchTextTable')"));
+            int fileTableCount = 0;
+            while (query.next()) {
+                if (query.value(0).toString() == QLatin1String("SearchTextTable"))
+                    hasSearchText = true;
+                else
+                    ++fileTableCount;
+            }
+            if (fileTableCount == 2)
+                m_previousQuery = new QSqlQuery(db);
+        }
+    }
+    if (!m_previousQuery) {
+        QSqlDatabase::removeDatabase(QLatin1String("previous"));
+        return false;
+    }
+
+    if (m_storeSearchText && hasSearchText) {
+        m_previousQuery->prepare(QLatin1String("SELECT a.Title, b.Data, c.Title, c.Text "
+            "FROM FileNameTable a JOIN FileDataTable b ON a.FileId=b.Id "
+            "LEFT JOIN SearchTextTable c ON c.FileId=a.FileId WHERE a.Name=?"));
+    } else {
+        m_previousQuery->prepare(QLatin1String("SELECT a.Title, b.Data "
+            "FROM FileNameTable a JOIN FileDataTable b ON a.FileId=b.Id WHERE a.Name=?"));
+    }
+    return true;
+}
+
+void HelpGeneratorPrivate::removePreviousFile()
+{
+    if (m_previousQuery) {
+        delete m_previousQuery;
+        m_previousQuery = nullptr;
+        QSqlDatabase::removeDatabase(QLatin1String("previous"));
+    }
+    if (!m_previousFileName.isEmpty()) {
+        QFile::remove(m_previousFileName);
+        m_previousFileName.clear();
+    }
+}
+
+void HelpGeneratorPrivate::fetchPreviousFileData(FileTableData *file)
+{
+    if (!m_previousQuery)
+        return;
+
+    m_previousQuery->bindValue(0, file->name);
+    if (!m_previousQuery->exec() || !m_previousQuery->next())
+        return;
+
+    file->hasPrevious = true;
+    file->previousTitle = m_previousQuery->value(0).toString();
+    file->previousData = m_previousQuery->value(1).toByteArray();
+    if (m_previousQuery->record().count() > 2 && !m_previousQuery->value(2).isNull()) {
+        file->previousHasSearchText = true;
+        file->previousSearchTitle = m_previousQuery->value(2).toString();
+        file->previousSearchText = m_previousQuery->value(3).toString();
+    }
+    m_previousQuery->finish();
+}
+
+static bool hasSearchableText(const QString &fileName)
+{
+    return fileName.endsWith(QLatin1String(".html"))
+        || fileName.endsWith(QLatin1String(".htm"))
+        || fileName.endsWith(QLatin1String(".txt"));
+}
+
 bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &rootPath,
                                  const QStringList &filterAttributes)
 {
@@ -426,13 +575,27 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
     if (m_query->next())
         tableFileId = m_query->value(0).toInt() + 1;
 
-    QString title;
-    QString charSet;
-    QList<QByteArray> fileDataList;
     QMap<int, QSet<int> > tmpFileFilterMap;
-    QList<FileNameTableData> fileNameDataList;
+    QList<FileTableData> fileDataList;
+
+    // The files are compressed on a thread pool. To bound the memory
+    // use, only a limited number of them is held at any time.
+    QThreadPool pool;
+    const qsizetype batchSize = 16 * qMax(1, pool.maxThreadCount());
+    const auto processFileData = [&] {
+        for (FileTableData &fileData : fileDataList)
+            pool.start([this, &fileData] { prepareFileData(&fileData); });
+        pool.waitForDone();
+        for (const FileTableData &fileData : std::as_const(fileDataList)) {
+            if (fileData.reused)
+                ++m_reusedFileCount;
+        }
+        insertFileData(fileDataList);
+        addProgress(m_fileStep * fileDataList.size());
+        fileDataList.clear();
+    };
 
-    int i = 0;
+    m_query->exec(QLatin1String("BEGIN"));
     for (const QString &file : files) {
         const QString fileName = QDir::cleanPath(file);
 
@@ -449,35 +612,24 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
             continue;
         }
 
-        QByteArray data = fi.readAll();
-        if (fileName.endsWith(QLatin1String(".html"))
-            || fileName.endsWith(QLatin1String(".htm"))) {
-            auto encoding = QStringDecoder::encodingForHtml(data);
-            if (!encoding)
-                encoding = QStringDecoder::Utf8;
-            title = QHelpGlobal::documentTitle(QStringDecoder(*encoding)(data));
-        } else {
-            title = fileName.mid(fileName.lastIndexOf(QLatin1Char('/')) + 1);
-        }
-
-        int fileId = -1;
         const auto &it = m_fileMap.constFind(fileName);
         if (it == m_fileMap.cend()) {
-            fileDataList.append(qCompress(data));
-
-            FileNameTableData fileNameData;
-            fileNameData.name = fileName;
-            fileNameData.fileId = tableFileId;
-            fileNameData.title = title;
-            fileNameDataList.append(fileNameData);
+            FileTableData fileData;
+            fileData.name = fileName;
+            fileData.fileId = tableFileId;
+            fileData.data = fi.readAll();
+            fetchPreviousFileData(&fileData);
+            fileDataList.append(fileData);
 
             m_fileMap.insert(fileName, tableFileId);
             m_fileFilterMap.insert(tableFileId, filterAtts);
             tmpFileFilterMap.insert(tableFileId, filterAtts);
 
             ++tableFileId;
+            if (fileDataList.size() >= batchSize)
+                processFileData();
         } else {
-            fileId = it.value();
+            const int fileId = it.value();
             QSet<int> &fileFilterSet = m_fileFilterMap[fileId];
             QSet<int> &tmpFileFilterSet = tmpFileFilterMap[fileId];
             for (int filter : std::as_const(filterAtts)) {
@@ -489,49 +641,127 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
             }
         }
     }
+    processFileData();
+    if (m_previousQuery) {
+        emit statusChanged(tr("Reused the data of %n unchanged file(s).", nullptr,
+                              m_reusedFileCount));
+    }
 
-    if (!tmpFileFilterMap.isEmpty()) {
-        m_query->exec(QLatin1String("BEGIN"));
-        for (auto it = tmpFileFilterMap.cbegin(), end = tmpFileFilterMap.cend(); it != end; ++it) {
-            QList<int> filterValues = it.value().values();
-            std::sort(filterValues.begin(), filterValues.end());
-            for (int fv : std::as_const(filterValues)) {
-                m_query->prepare(QLatin1String("INSERT INTO FileFilterTable "
-                    "VALUES(?, ?)"));
-                m_query->bindValue(0, fv);
-                m_query->bindValue(1, it.key());
-                m_query->exec();
-            }
+    QVariantList filterAttributeIds;
+    QVariantList fileIds;
+    for (auto it = tmpFileFilterMap.cbegin(), end = tmpFileFilterMap.cend(); it != end; ++it) {
+        QList<int> filterValues = it.value().values();
+        std::sort(filterValues.begin(), filterValues.end());
+        for (int fv : std::as_const(filterValues)) {
+            filterAttributeIds.append(fv);
+            fileIds.append(it.key());
         }
+    }
+    if (!fileIds.isEmpty()) {
+        m_query->prepare(QLatin1String("INSERT INTO FileFilterTable VALUES(?, ?)"));
+        m_query->addBindValue(filterAttributeIds);
+        m_query->addBindValue(fileIds);
+        m_query->execBatch();
+    }
+    m_query->exec(QLatin1String("COMMIT"));
 
-        for (const QByteArray &fileData : std::as_const(fileDataList)) {
-            m_query->prepare(QLatin1String("INSERT INTO FileDataTable VALUES "
-                "(Null, ?)"));
-            m_query->bindValue(0, fileData);
-            m_query->exec();
-            if (++i % 20 == 0)
-                addProgress(m_fileStep * 20.0);
+    m_query->exec(QLatin1String("SELECT MAX(Id) FROM FileDataTable"));
+    return m_query->next() && m_query->value(0).toInt() == tableFileId - 1;
+}
+
+/*
+    Determines the title and, if requested, the search text of \a file,
+    and compresses its data. Called on the threads of the thread pool.
+
+    If the previous output file has the same contents for the file, its
+    compressed data, title and search text are taken from there instead.
+*/
+void HelpGeneratorPrivate::prepareFileData(FileTableData *file) const
+{
+    const QString &fileName = file->name;
+    const ChromeTrace::Span span("prepare file"_L1, fileName);
+    const bool needsSearchText = m_storeSearchText && hasSearchableText(fileName);
+    if (file->hasPrevious && (!needsSearchText || file->previousHasSearchText)
+        && qUncompress(file->previousData) == file->data) {
+        file->data = std::exchange(file->previousData, QByteArray());
+        file->title = file->previousTitle;
+        if (needsSearchText) {
+            file->hasSearchText = true;
+            file->searchTitle = file->previousSearchTitle;
+            file->searchText = file->previousSearchText;
         }
+        file->reused = true;
+        return;
+    }
+    file->previousData.clear();
 
-        for (const FileNameTableData &fnd : std::as_const(fileNameDataList)) {
-            m_query->prepare(QLatin1String("INSERT INTO FileNameTable "
-                "(FolderId, Name, FileId, Title) VALUES (?, ?, ?, ?)"));
-            m_query->bindValue(0, 1);
-            m_query->bindValue(1, fnd.name);
-            m_query->bindValue(2, fnd.fileId);
-            m_query->bindValue(3, fnd.title);
-            m_query->exec();
+    if (fileName.endsWith(QLatin1String(".html"))
+        || fileName.endsWith(QLatin1String(".htm"))) {
+        auto encoding = QStringDecoder::encodingForHtml(file->data);
+        if (!encoding)
+            encoding = QStringDecoder::Utf8;
+        file->title = QHelpGlobal::documentTitle(QStringDecoder(*encoding)(file->data));
+    } else {
+        file->title = fileName.mid(fileName.lastIndexOf(QLatin1Char('/')) + 1);
+    }
+
+    if (needsSearchText) {
+        const ChromeTrace::Span searchTextSpan("extract search text"_L1, fileName);
+        file->hasSearchText = fulltextsearch::extractSearchText(
+                fileName, file->data, &file->searchTitle, &file->searchText);
+    }
+
+    file->data = qCompress(file->data);
+}
+
+void HelpGeneratorPrivate::insertFileData(const QList<FileTableData> &fileDataList)
+{
+    if (fileDataList.isEmpty())
+        return;
+    const ChromeTrace::Span span("insert file data"_L1);
+
+    QVariantList fileIds;
+    QVariantList data;
+    QVariantList folderIds;
+    QVariantList names;
+    QVariantList titles;
+    QVariantList searchTextFileIds;
+    QVariantList searchTitles;
+    QVariantList searchTexts;
+    for (const FileTableData &fileData : fileDataList) {
+        fileIds.append(fileData.fileId);
+        data.append(fileData.data);
+        folderIds.append(1);
+        names.append(fileData.name);
+        titles.append(fileData.title);
+        if (fileData.hasSearchText) {
+            searchTextFileIds.append(fileData.fileId);
+            searchTitles.append(fileData.searchTitle);
+            searchTexts.append(fileData.searchText);
         }
-        m_query->exec(QLatin1String("COMMIT"));
     }
 
-    m_query->exec(QLatin1String("SELECT MAX(Id) FROM FileDataTable"));
-    if (m_query->next()
-            && m_query->value(0).toInt() == tableFileId - 1) {
-        addProgress(m_fileStep*(i % 20));
-        return true;
+    m_query->prepare(QLatin1String("INSERT INTO FileDataTable VALUES (?, ?)"));
+    m_query->addBindValue(fileIds);
+    m_query->addBindValue(data);
+    m_query->execBatch();
+
+    m_query->prepare(QLatin1String("INSERT INTO FileNameTable "
+        "(FolderId, Name, FileId, Title) VALUES (?, ?, ?, ?)"));
+    m_query->addBindValue(folderIds);
+    m_query->addBindValue(names);
+    m_query->addBindValue(fileIds);
+    m_query->addBindValue(titles);
+    m_query->execBatch();
+
+    if (!searchTextFileIds.isEmpty()) {
+        m_query->prepare(QLatin1String("INSERT INTO SearchTextTable "
+            "(FileId, Title, Text) VALUES (?, ?, ?)"));
+        m_query->addBindValue(searchTextFileIds);
+        m_query->addBindValue(searchTitles);
+        m_query->addBindValue(searchTexts);
+        m_query->execBatch();
     }
-    return false;
 }
 
 bool HelpGeneratorPrivate::registerCustomFilter(const QString &filterName,
@@ -597,6 +827,7 @@ bool HelpGeneratorPrivate::registerCustomFilter(const QString &filterName,
 bool HelpGeneratorPrivate::insertKeywords(const QList<QHelpDataIndexItem> &keywords,
                                     const QStringList &filterAttributes)
 {
+    const ChromeTrace::Span span("insert keywords"_L1);
     if (!m_query)
         return false;
 
@@ -676,6 +907,7 @@ bool HelpGeneratorPrivate::insertKeywords(const QList<QHelpDataIndexItem> &keywo
 bool HelpGeneratorPrivate::insertContents(const QByteArray &ba,
                                     const QStringList &filterAttributes)
 {
+    const ChromeTrace::Span span("insert contents"_L1);
     if (!m_query)
         return false;
 
@@ -741,8 +973,94 @@ bool HelpGeneratorPrivate::insertMetaData(const QMap<QString, QVariant> &metaDat
     return true;
 }
 
+/*
+    Returns the targets of the \c{<a href=...>} and \c{<img src=...>}
+    elements in \a data without the fragment, in the order they appear.
+    This matches the bytes directly, so \a data must be in an ASCII
+    compatible encoding.
+*/
+static QList<QByteArrayView> extractLinks(QByteArrayView data)
+{
+    QList<QByteArrayView> links;
+    const qsizetype size = data.size();
+    qsizetype pos = data.indexOf('<');
+    while (pos >= 0) {
+        const QByteArrayView tag = data.sliced(pos + 1);
+        qsizetype start;
+        if (tag.startsWith("a href="))
+            start = pos + 8;
+        else if (tag.startsWith("img src="))
+            start = pos + 9;
+        else
+            start = pos + 1;
+
+        if (start > pos + 1) {
+            if (start < size && data.at(start) == '"')
+                ++start;
+            qsizetype end = start;
+            while (end < size && data.at(end) != '#' && data.at(end) != '"'
+                   && data.at(end) != '>') {
+                ++end;
+            }
+            if (end > start && end < size)
+                links.append(data.sliced(start, end - start));
+            start = end;
+        }
+        if (start >= size)
+            break;
+        pos = data.indexOf('<', start);
+    }
+    return links;
+}
+
+/*
+    Checks that the links in the HTML \a file point to files in \a files.
+    Called on the threads of the thread pool.
+*/
+void HelpGeneratorPrivate::checkFileLinks(LinkCheckData *file, const QSet<QString> &files)
+{
+    QFile htmlFile(file->fileName);
+    if (!htmlFile.open(QIODevice::ReadOnly))
+        return;
+    file->opened = true;
+
+    QByteArray data = htmlFile.readAll();
+    auto encoding = QStringDecoder::encodingForHtml(data);
+    if (!encoding)
+        encoding = QStringDecoder::Utf8;
+    switch (*encoding) {
+    case QStringConverter::Utf16:
+    case QStringConverter::Utf16LE:
+    case QStringConverter::Utf16BE:
+    case QStringConverter::Utf32:
+    case QStringConverter::Utf32LE:
+    case QStringConverter::Utf32BE:
+        data = QStringDecoder(*encoding)(data).toUtf8();
+        encoding = QStringConverter::Utf8;
+        break;
+    default:
+        break;
+    }
+
+    const QString curDir = QFileInfo(file->fileName).dir().path() + QDir::separator();
+    QStringList invalidCanonicalLinks;
+    for (QByteArrayView link : extractLinks(data)) {
+        if (link.contains("://"))
+            continue;
+        const QString linkedFileName = QStringDecoder(*encoding)(link);
+        const QString canonicalLinkedFileName =
+            QFileInfo(curDir + linkedFileName).canonicalFilePath();
+        if (!files.contains(canonicalLinkedFileName)
+            && !invalidCanonicalLinks.contains(canonicalLinkedFileName)) {
+            file->invalidLinks.append(linkedFileName);
+            invalidCanonicalLinks.append(canonicalLinkedFileName);
+        }
+    }
+}
+
 bool HelpGeneratorPrivate::checkLinks(const QHelpProjectData &helpData)
 {
+    const ChromeTrace::Span span("check links"_L1);
     /*
      * Step 1: Gather the canoncal file paths of all files in the project.
      *         We use a set, because there will be a lot of look-ups.
@@ -764,41 +1082,32 @@ bool HelpGeneratorPrivate::checkLinks(const QHelpProjectData &helpData)
      *         Note that we don't parse the files, but simply grep for the
      *         respective HTML elements. Therefore. contents that are e.g.
      *         commented out can cause false warning.
+     *         The files are checked on a thread pool, and the warnings
+     *         are emitted afterwards, in the order of the files.
      */
-    bool allLinksOk = true;
+    QList<LinkCheckData> htmlFiles;
     for (const QString &fileName : std::as_const(files)) {
-        if (!fileName.endsWith(QLatin1String("html"))
-            && !fileName.endsWith(QLatin1String("htm")))
-            continue;
-        QFile htmlFile(fileName);
-        if (!htmlFile.open(QIODevice::ReadOnly)) {
-            emit warning(tr("File \"%1\" cannot be opened.").arg(fileName));
+        if (fileName.endsWith(QLatin1String("html"))
+            || fileName.endsWith(QLatin1String("htm"))) {
+            htmlFiles.append({ fileName, false, {} });
+        }
+    }
+
+    QThreadPool pool;
+    for (LinkCheckData &file : htmlFiles)
+        pool.start([&file, &files] { checkFileLinks(&file, files); });
+    pool.waitForDone();
+
+    bool allLinksOk = true;
+    for (const LinkCheckData &file : std::as_const(htmlFiles)) {
+        if (!file.opened) {
+            emit warning(tr("File \"%1\" cannot be opened.").arg(file.fileName));
             continue;
         }
-        const QRegularExpression linkPattern(QLatin1String("<(?:a href|img src)=\"?([^#\">]+)[#\">]"));
-        QByteArray data = htmlFile.readAll();
-        auto encoding = QStringDecoder::encodingForHtml(data);
-        if (!encoding)
-            encoding = QStringDecoder::Utf8;
-        const QString &content = QStringDecoder(*encoding)(data);
-        QStringList invalidLinks;
-        QRegularExpressionMatch match;
-        int pos = 0;
-        while ((match = linkPattern.match(content, pos)).hasMatch()) {
-            pos = match.capturedEnd();
-            const QString &linkedFileName = match.captured(1);
-            if (linkedFileName.contains(QLatin1String("://")))
-                continue;
-            const QString &curDir = QFileInfo(fileName).dir().path();
-            const QString &canonicalLinkedFileName =
-                QFileInfo(curDir + QDir::separator() + linkedFileName).canonicalFilePath();
-            if (!files.contains(canonicalLinkedFileName)
-                && !invalidLinks.contains(canonicalLinkedFileName)) {
-                emit warning(tr("File \"%1\" contains an invalid link to file \"%2\"").
-                         arg(fileName).arg(linkedFileName));
-                allLinksOk = false;
-                invalidLinks.append(canonicalLinkedFileName);
-            }
+        for (const QString &linkedFileName : file.invalidLinks) {
+            emit warning(tr("File \"%1\" contains an invalid link to file \"%2\"").
+                     arg(file.fileName).arg(linkedFileName));
+            allLinksOk = false;
         }
     }
 
@@ -826,6 +1135,25 @@ bool HelpGenerator::generate(QHelpProjectData *helpData,
     return m_private->generate(helpData, outputFileName);
 }
 
+/*!
+    Sets whether the text of the HTML and text files is stored in the
+    generated file as well, as specified by \a store. The full text
+    search index then uses it instead of extracting the text itself.
+*/
+void HelpGenerator::setStoreSearchText(bool store)
+{
+    m_private->m_storeSearchText = store;
+}
+
+/*!
+    Sets whether an existing output file is read to reuse the compressed
+    data of the files that did not change, as specified by \a incremental.
+*/
+void HelpGenerator::setIncremental(bool incremental)
+{
+    m_private->m_incremental = incremental;
+}
+
 bool HelpGenerator::checkLinks(const QHelpProjectData &helpData)
 {
     return m_private->checkLinks(helpData);
@@ -17,6 +17,8 @@ class HelpGenerator : public QObject
 
 public:
     HelpGenerator(bool silent = false);
+    void setStoreSearchText(bool store);
+    void setIncremental(bool incremental);
     bool generate(QHelpProjectData *helpData,
         const QString &outputFileName);
     bool checkLinks(const QHelpProjectData &helpData);
@@ -5,6 +5,7 @@
 #include "helpgenerator.h"
 #include "collectionconfigreader.h"
 #include "qhelpprojectdata_p.h"
+#include <chrometrace_p.h>
 
 #include <QtCore/QBuffer>
 #include <QtCore/QDataStream>
@@ -21,6 +22,8 @@
 
 QT_USE_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 class QHG {
     Q_DECLARE_TR_FUNCTIONS(QHelpGenerator)
 };
@@ -53,7 +56,8 @@ int generateCollectionFile(const QByteArray &data, const QString &basePath, cons
     for (auto it = filesToGenerate.cbegin(), end = filesToGenerate.cend(); it != end; ++it) {
         fputs(qPrintable(QHG::tr("Generating help for %1...\n").arg(it.key())), stdout);
         QHelpProjectData helpData;
-        if (!helpData.readData(absoluteFilePath(basePath, it.key()))) {
+        if (!helpData.readData(absoluteFilePath(basePath, it.key()),
+                               QHelpProjectData::SerializedContents)) {
             fprintf(stderr, "%s\n", qPrintable(helpData.errorMessage()));
             return 1;
         }
@@ -232,11 +236,14 @@ int main(int argc, char *argv[])
     bool showVersion = false;
     bool checkLinks = false;
     bool silent = false;
+    bool storeSearchText = false;
+    bool incremental = false;
 
     // don't require a window manager even though we're a QGuiApplication
     qputenv("QT_QPA_PLATFORM", QByteArrayLiteral("minimal"));
 
     QGuiApplication app(argc, argv);
+    ChromeTrace::initialize("qhelpgenerator"_L1);
 #ifndef Q_OS_WIN32
     QTranslator translator;
     QTranslator qtTranslator;
@@ -269,6 +276,10 @@ int main(int argc, char *argv[])
             checkLinks = true;
         } else if (arg == QLatin1String("-s")) {
             silent = true;
+        } else if (arg == QLatin1String("-search-text")) {
+            storeSearchText = true;
+        } else if (arg == QLatin1String("-incremental")) {
+            incremental = true;
         } else {
             const QFileInfo fi(arg);
             inputFile = fi.absoluteFilePath();
@@ -319,6 +330,14 @@ int main(int argc, char *argv[])
         "  -c                     Checks whether all links in HTML files\n"
         "                         point to files in this help project.\n"
         "  -s                     Suppresses status messages.\n"
+        "  -search-text           Stores the text of the HTML files\n"
+        "                         for the full text search in the\n"
+        "                         generated *.qch file, so that it\n"
+        "                         does not need to be extracted when\n"
+        "                         the search index is built.\n"
+        "  -incremental           Reuses the compressed data of\n"
+        "                         unchanged files from an existing\n"
+        "                         *.qch output file.\n"
         "  -v                     Displays the version of \n"
         "                         qhelpgenerator.\n\n");
 
@@ -360,12 +379,14 @@ int main(int argc, char *argv[])
 
     if (inputType == InputQhp) {
         QHelpProjectData *helpData = new QHelpProjectData();
-        if (!helpData->readData(inputFile)) {
+        if (!helpData->readData(inputFile, QHelpProjectData::SerializedContents)) {
             fprintf(stderr, "%s\n", qPrintable(helpData->errorMessage()));
             return 1;
         }
 
         HelpGenerator generator(silent);
+        generator.setStoreSearchText(storeSearchText);
+        generator.setIncremental(incremental);
         bool success = true;
         if (checkLinks)
             success = generator.checkLinks(*helpData);
@@ -149,6 +149,26 @@ QList<QHelpDataContentItem*> QHelpDataFilterSection::contents() const
     return d->contents;
 }
 
+/*!
+    Appends \a data to the serialized contents of the filter section.
+    For each item, in depth-first order, the data holds its depth, its
+    reference and its title, as written by QDataStream.
+*/
+void QHelpDataFilterSection::addSerializedContents(const QByteArray &data)
+{
+    d->serializedContents.append(data);
+}
+
+/*!
+    Returns the serialized contents of the filter section.
+
+    \sa QHelpProjectData::SerializedContents
+*/
+QByteArray QHelpDataFilterSection::serializedContents() const
+{
+    return d->serializedContents;
+}
+
 /*!
     Adds the file \a file to the filter section.
 */
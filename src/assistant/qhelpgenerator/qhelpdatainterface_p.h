@@ -61,6 +61,7 @@ public:
     QStringList filterAttributes;
     QList<QHelpDataIndexItem> indices;
     QList<QHelpDataContentItem*> contents;
+    QByteArray serializedContents;
     QStringList files;
 };
 
@@ -80,6 +81,9 @@ public:
     void setContents(const QList<QHelpDataContentItem*> &contents);
     QList<QHelpDataContentItem*> contents() const;
 
+    void addSerializedContents(const QByteArray &data);
+    QByteArray serializedContents() const;
+
     void addFile(const QString &file);
     void setFiles(const QStringList &files);
     QStringList files() const;
@@ -4,6 +4,7 @@
 #include "qhelpprojectdata_p.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
 #include <QtCore/QStack>
@@ -19,8 +20,9 @@ QT_BEGIN_NAMESPACE
 class QHelpProjectDataPrivate : public QXmlStreamReader
 {
 public:
-    void readData(const QByteArray &contents);
+    void readData(QIODevice *device);
 
+    QHelpProjectData::ContentsMode contentsMode = QHelpProjectData::ContentsTree;
     QString virtualFolder;
     QString namespaceName;
     QString fileName;
@@ -37,6 +39,7 @@ private:
     void readCustomFilter();
     void readFilterSection();
     void readTOC();
+    void readSerializedTOC();
     void readKeywords();
     void readFiles();
     void skipUnknownToken();
@@ -56,9 +59,9 @@ void QHelpProjectDataPrivate::skipUnknownToken()
     skipCurrentElement();
 }
 
-void QHelpProjectDataPrivate::readData(const QByteArray &contents)
+void QHelpProjectDataPrivate::readData(QIODevice *device)
 {
-    addData(contents);
+    setDevice(device);
     while (!atEnd()) {
         readNext();
         if (isStartElement()) {
@@ -148,6 +151,9 @@ void QHelpProjectDataPrivate::readFilterSection()
         if (isStartElement()) {
             if (name() == QLatin1String("filterAttribute"))
                 filterSectionList.last().addFilterAttribute(readElementText());
+            else if (name() == QLatin1String("toc")
+                     && contentsMode == QHelpProjectData::SerializedContents)
+                readSerializedTOC();
             else if (name() == QLatin1String("toc"))
                 readTOC();
             else if (name() == QLatin1String("keywords"))
@@ -195,6 +201,38 @@ void QHelpProjectDataPrivate::readTOC()
     }
 }
 
+// Writes the items in the format of HelpGeneratorPrivate::writeTree()
+// while reading them, instead of building the tree of items first.
+void QHelpProjectDataPrivate::readSerializedTOC()
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    int depth = 0;
+    while (!atEnd()) {
+        readNext();
+        if (isStartElement()) {
+            if (name() == QLatin1String("section")) {
+                const QXmlStreamAttributes attrs = attributes();
+                stream << depth << attrs.value(QLatin1String("ref")).toString()
+                       << attrs.value(QLatin1String("title")).toString();
+                ++depth;
+            } else {
+                skipUnknownToken();
+            }
+        } else if (isEndElement()) {
+            if (name() == QLatin1String("section")) {
+                --depth;
+                continue;
+            } else if (name() == QLatin1String("toc") && depth == 0) {
+                break;
+            } else {
+                skipUnknownToken();
+            }
+        }
+    }
+    filterSectionList.last().addSerializedContents(data);
+}
+
 static inline QString msgMissingAttribute(const QString &fileName, qint64 lineNumber, const QString &name)
 {
     QString result;
@@ -213,9 +251,10 @@ void QHelpProjectDataPrivate::readKeywords()
         readNext();
         if (isStartElement()) {
             if (name() == QLatin1String("keyword")) {
-                const QString &refAttribute = attributes().value(QStringLiteral("ref")).toString();
-                const QString &nameAttribute = attributes().value(QStringLiteral("name")).toString();
-                const QString &idAttribute = attributes().value(QStringLiteral("id")).toString();
+                const QXmlStreamAttributes attrs = attributes();
+                const QString &refAttribute = attrs.value(QStringLiteral("ref")).toString();
+                const QString &nameAttribute = attrs.value(QStringLiteral("name")).toString();
+                const QString &idAttribute = attrs.value(QStringLiteral("id")).toString();
                 if (refAttribute.isEmpty() || (nameAttribute.isEmpty() && idAttribute.isEmpty())) {
                     qWarning("%s", qPrintable(msgMissingAttribute(fileName, lineNumber(), nameAttribute)));
                     continue;
@@ -347,14 +386,26 @@ QHelpProjectData::~QHelpProjectData()
 }
 
 /*!
-    Reads the file \a fileName and stores the help data. The file has to
-    have the Qt help project file format. Returns true if the file
-    was successfully read, otherwise false.
+    \enum QHelpProjectData::ContentsMode
+
+    \value ContentsTree The contents of the filter sections are stored as
+           trees of QHelpDataContentItem, see QHelpDataFilterSection::contents().
+    \value SerializedContents The contents are written to a byte array
+           while they are read, see QHelpDataFilterSection::serializedContents().
+           This needs much less memory for large projects.
+*/
+
+/*!
+    Reads the file \a fileName and stores the help data, with the contents
+    stored as specified by \a contentsMode. The file has to have the Qt
+    help project file format and is read incrementally. Returns true if
+    the file was successfully read, otherwise false.
 
     \sa errorMessage()
 */
-bool QHelpProjectData::readData(const QString &fileName)
+bool QHelpProjectData::readData(const QString &fileName, ContentsMode contentsMode)
 {
+    d->contentsMode = contentsMode;
     d->fileName = fileName;
     d->rootPath = QFileInfo(fileName).absolutePath();
     QFile file(fileName);
@@ -364,7 +415,7 @@ bool QHelpProjectData::readData(const QString &fileName)
         return false;
     }
 
-    d->readData(file.readAll());
+    d->readData(&file);
     return !d->hasError();
 }
 
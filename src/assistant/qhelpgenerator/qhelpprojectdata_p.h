@@ -24,10 +24,15 @@ class QHelpProjectDataPrivate;
 class QHelpProjectData
 {
 public:
+    enum ContentsMode {
+        ContentsTree,
+        SerializedContents
+    };
+
     QHelpProjectData();
     ~QHelpProjectData();
 
-    bool readData(const QString &fileName);
+    bool readData(const QString &fileName, ContentsMode contentsMode = ContentsTree);
     QString errorMessage() const;
 
     QString namespaceName() const;
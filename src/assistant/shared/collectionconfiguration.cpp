@@ -27,6 +27,7 @@ namespace {
     const QString LastPageKey("LastTabPage"_L1);
     const QString LastRegisterTime("LastRegisterTime"_L1);
     const QString LastShownPagesKey("LastShownPages"_L1);
+    const QString LastShownPageTitlesKey("LastShownPageTitles"_L1);
     const QString LastZoomFactorsKey(
 #if defined(BROWSER_QTWEBKIT)
             "LastPagesZoomWebView"_L1
@@ -214,6 +215,18 @@ void CollectionConfiguration::setLastShownPages(QHelpEngineCore &helpEngine,
                               lastShownPages.join(ListSeparator));
 }
 
+const QStringList CollectionConfiguration::lastShownPageTitles(const QHelpEngineCore &helpEngine)
+{
+    // Stored as a list, since titles may contain the list separator.
+    return helpEngine.customValue(LastShownPageTitlesKey).toStringList();
+}
+
+void CollectionConfiguration::setLastShownPageTitles(QHelpEngineCore &helpEngine,
+                                                     const QStringList &lastShownPageTitles)
+{
+    helpEngine.setCustomValue(LastShownPageTitlesKey, lastShownPageTitles);
+}
+
 const QStringList CollectionConfiguration::lastZoomFactors(const QHelpEngineCore &helpEngine)
 {
     return helpEngine.customValue(LastZoomFactorsKey).toString().
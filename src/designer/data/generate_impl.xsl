@@ -819,6 +819,7 @@
 </xsl:text>
         <xsl:text>#include "@HEADER@"&endl;</xsl:text>
         <xsl:text>&endl;</xsl:text>
+        <xsl:text>#include &lt;array&gt;&endl;</xsl:text>
         <xsl:text>&endl;</xsl:text>
         <xsl:text>QT_BEGIN_NAMESPACE&endl;</xsl:text>
         <xsl:text>&endl;using namespace Qt::StringLiterals;&endl;&endl;</xsl:text>
@@ -828,6 +829,20 @@
         <xsl:text>#endif&endl;</xsl:text>
         <xsl:text>&endl;</xsl:text>
 
+<xsl:text>// Attribute values like class, object and property names repeat throughout
+// forms. Let the elements share the strings of recently seen values instead
+// of allocating one for each of them.
+static QString internedString(QStringView value)
+{
+    static thread_local std::array&lt;QString, 512&gt; strings;
+    QString &amp;interned = strings[qHash(value) % strings.size()];
+    if (interned != value)
+        interned = value.toString();
+    return interned;
+}
+
+</xsl:text>
+
         <xsl:text>/*******************************************************************************&endl;</xsl:text>
         <xsl:text>** Implementations&endl;</xsl:text>
         <xsl:text>*/&endl;&endl;</xsl:text>
@@ -167,8 +167,9 @@
         <xsl:param name="val"/>
         <xsl:choose>
             <xsl:when test="$xs-type='xs:string'">
+                <xsl:text>internedString(</xsl:text>
                 <xsl:value-of select="$val"/>
-                <xsl:text>.toString()</xsl:text>
+                <xsl:text>)</xsl:text>
             </xsl:when>
             <xsl:otherwise>
                 <xsl:call-template name="xs-type-from-qstring-func">
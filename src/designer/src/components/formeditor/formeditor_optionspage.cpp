@@ -14,14 +14,17 @@
 
 // SDK
 #include <QtDesigner/abstractformeditor.h>
+#include <QtDesigner/abstractformwindow.h>
 #include <QtDesigner/abstractformwindowmanager.h>
 
 #include <QtCore/qstring.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtGui/qundostack.h>
 #include <QtWidgets/qgroupbox.h>
 #include <QtWidgets/qboxlayout.h>
 #include <QtWidgets/qformlayout.h>
 #include <QtWidgets/qcombobox.h>
+#include <QtWidgets/qspinbox.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -117,11 +120,26 @@ QWidget *FormEditorOptionsPage::createPage(QWidget *parent)
     m_namingComboBox->setCurrentIndex(settings.objectNamingMode());
     namingHLayout->addWidget(m_namingComboBox.data());
 
+    QGroupBox *undoGroupBox =
+        new QGroupBox(QCoreApplication::translate("FormEditorOptionsPage", "Undo History"));
+    QFormLayout *undoLayout = new QFormLayout(undoGroupBox);
+    m_undoLimitSpinBox = new QSpinBox;
+    m_undoLimitSpinBox->setRange(0, 100000);
+    m_undoLimitSpinBox->setSingleStep(100);
+    m_undoLimitSpinBox->setSpecialValueText(QCoreApplication::translate("FormEditorOptionsPage", "Unlimited"));
+    m_undoLimitSpinBox->setToolTip(QCoreApplication::translate("FormEditorOptionsPage",
+                                                               "The oldest commands are discarded when a form has more commands in its undo history. "
+                                                               "Changes take effect for forms whose undo history is empty."));
+    m_undoLimitSpinBox->setValue(settings.undoLimit());
+    undoLayout->addRow(QCoreApplication::translate("FormEditorOptionsPage", "Maximum number of commands"),
+                       m_undoLimitSpinBox.data());
+
     QVBoxLayout *optionsVLayout = new QVBoxLayout();
     optionsVLayout->addWidget(m_defaultGridConf);
     optionsVLayout->addWidget(m_previewConf);
     optionsVLayout->addWidget(m_zoomSettingsWidget);
     optionsVLayout->addWidget(namingGroupBox);
+    optionsVLayout->addWidget(undoGroupBox);
     optionsVLayout->addStretch(1);
 
     // Outer layout to give it horizontal stretch
@@ -164,6 +182,18 @@ void FormEditorOptionsPage::apply()
         settings.setObjectNamingMode(namingMode);
         ActionEditor::setObjectNamingMode(namingMode);
     }
+
+    if (m_undoLimitSpinBox) {
+        const int undoLimit = m_undoLimitSpinBox->value();
+        settings.setUndoLimit(undoLimit);
+        // QUndoStack only accepts a new limit while it is empty
+        QDesignerFormWindowManagerInterface *fwm = m_core->formWindowManager();
+        for (int i = 0, count = fwm->formWindowCount(); i < count; ++i) {
+            QUndoStack *undoStack = fwm->formWindow(i)->commandHistory();
+            if (undoStack->count() == 0)
+                undoStack->setUndoLimit(undoLimit);
+        }
+    }
 }
 
 void FormEditorOptionsPage::finish()
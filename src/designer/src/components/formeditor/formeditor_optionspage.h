@@ -10,6 +10,7 @@
 QT_BEGIN_NAMESPACE
 
 class QComboBox;
+class QSpinBox;
 class QDesignerFormEditorInterface;
 
 namespace qdesigner_internal {
@@ -34,6 +35,7 @@ private:
     QPointer<GridPanel> m_defaultGridConf;
     QPointer<ZoomSettingsWidget> m_zoomSettingsWidget;
     QPointer<QComboBox> m_namingComboBox;
+    QPointer<QSpinBox> m_undoLimitSpinBox;
 };
 
 } // namespace qdesigner_internal
@@ -123,7 +123,6 @@ public:
     void  clearSelectionPool();
 
     void repaintSelection(QWidget *w);
-    void repaintSelection();
 
     bool isWidgetSelected(QWidget *w) const;
     QWidgetList selectedWidgets() const;
@@ -218,12 +217,6 @@ void FormWindow::Selection::repaintSelection(QWidget *w)
         s->update();
 }
 
-void FormWindow::Selection::repaintSelection()
-{
-    for (auto it = m_usedSelections.begin(), mend = m_usedSelections.end(); it != mend; ++it)
-        it.value()->update();
-}
-
 bool FormWindow::Selection::isWidgetSelected(QWidget *w) const{
     return  m_usedSelections.contains(w);
 }
@@ -369,6 +362,7 @@ void FormWindow::init()
     if (FormWindowManager *manager = qobject_cast<FormWindowManager*> (core()->formWindowManager())) {
         manager->undoGroup()->addStack(&m_undoStack);
     }
+    m_undoStack.setUndoLimit(QDesignerSharedSettings(core()).undoLimit());
 
     m_blockSelectionChanged = false;
 
@@ -933,7 +927,10 @@ void FormWindow::updateChildSelections(QWidget *w)
 
 void FormWindow::repaintSelection()
 {
-    m_selection->repaintSelection();
+    // Only the handles of the current widget depend on the state of the
+    // form window, see WidgetHandle::paintEvent().
+    if (m_currentWidget && m_currentWidget != mainContainer())
+        m_selection->repaintSelection(m_currentWidget);
 }
 
 void FormWindow::raiseSelection(QWidget *w)
@@ -2099,7 +2096,17 @@ bool FormWindow::setContents(QIODevice *dev, QString *errorMessageIn /* = 0 */)
             *errorMessageIn = r.errorString();
         return false;
     }
+    return loadUi(r, ui.data(), errorMessageIn);
+}
 
+bool FormWindow::setContentsFromUi(DomUI *ui, QString *errorMessageIn /* = 0 */)
+{
+    QDesignerResource r(this);
+    return loadUi(r, ui, errorMessageIn);
+}
+
+bool FormWindow::loadUi(QDesignerResource &r, DomUI *ui, QString *errorMessageIn)
+{
     UpdateBlocker ub(this);
     clearSelection();
     m_selection->clearSelectionPool();
@@ -2111,7 +2118,7 @@ bool FormWindow::setContents(QIODevice *dev, QString *errorMessageIn /* = 0 */)
     m_undoStack.clear();
     emit changed();
 
-    QWidget *w = r.loadUi(ui.data(), formContainer());
+    QWidget *w = r.loadUi(ui, formContainer());
     if (w) {
         setMainContainer(w);
         emit changed();
@@ -38,6 +38,7 @@ class FormWindowCursor;
 class WidgetEditorTool;
 class FormWindowWidgetStack;
 class FormWindowManager;
+class QDesignerResource;
 class FormWindowDnDItem;
 class SetPropertyCommand;
 
@@ -96,6 +97,7 @@ public:
     QString contents() const override;
     bool setContents(QIODevice *dev, QString *errorMessage = nullptr) override;
     bool setContents(const QString &) override;
+    bool setContentsFromUi(DomUI *ui, QString *errorMessage = nullptr) override;
 
     QDir absoluteDir() const override;
 
@@ -289,6 +291,7 @@ private:
     void layoutContainer(QWidget *w, int type);
 
 private:
+    bool loadUi(QDesignerResource &r, DomUI *ui, QString *errorMessage);
     QWidget *innerContainer(QWidget *outerContainer) const;
     QWidget *containerForPaste() const;
     QAction *createSelectAncestorSubMenu(QWidget *w);
@@ -117,6 +117,8 @@ QDesignerFormEditorInterface *WidgetHandle::core() const
 
 void WidgetHandle::setActive(bool a)
 {
+    if (a == m_active)
+        return;
     m_active = a;
     setBackgroundRole(m_active ? QPalette::Text : QPalette::Dark);
     updateCursor();
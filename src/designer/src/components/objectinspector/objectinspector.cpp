@@ -168,6 +168,7 @@ public:
 
     void clear();
     void setFormWindow(QDesignerFormWindowInterface *fwi);
+    void updateObjects(QDesignerFormWindowInterface *fwi, const QObjectList &objects);
 
     QWidget *managedWidgetAt(const QPoint &global_mouse_pos);
 
@@ -497,6 +498,14 @@ void ObjectInspector::ObjectInspectorPrivate::setFormWindowBlocked(QDesignerForm
             m_treeView->verticalScrollBar()->setValue(yoffset);
         }
         break;
+    case ObjectInspectorModel::RowsChanged: // Widgets added or removed: Expand the new rows
+        for (const QModelIndex &index : m_model->insertedIndexes()) {
+            const QModelIndex filterIndex = m_filterModel->mapFromSource(index);
+            if (filterIndex.isValid())
+                m_treeView->expandRecursively(filterIndex);
+        }
+        applyCursorSelection();
+        break;
     case ObjectInspectorModel::Updated: {
         // Same structure (property changed or click on the form)
         // We maintain a selection of unmanaged objects
@@ -519,6 +528,15 @@ void ObjectInspector::ObjectInspectorPrivate::setFormWindowBlocked(QDesignerForm
     }
 }
 
+// Properties shown in the object inspector changed (object name, icon):
+// Update their rows only, the structure is unchanged.
+void ObjectInspector::ObjectInspectorPrivate::updateObjects(QDesignerFormWindowInterface *fwi,
+                                                            const QObjectList &objects)
+{
+    if (fwi != m_formWindow || !m_model->updateObjects(objects))
+        setFormWindow(fwi);
+}
+
 // Apply selection of form window cursor to object inspector, set current
 void ObjectInspector::ObjectInspectorPrivate::applyCursorSelection()
 {
@@ -768,6 +786,11 @@ void ObjectInspector::setFormWindow(QDesignerFormWindowInterface *fwi)
     m_impl->setFormWindow(fwi);
 }
 
+void ObjectInspector::updateObjects(QDesignerFormWindowInterface *fwi, const QObjectList &objects)
+{
+    m_impl->updateObjects(fwi, objects);
+}
+
 void ObjectInspector::slotSelectionChanged(const QItemSelection & selected, const QItemSelection &deselected)
 {
     m_impl->slotSelectionChanged(selected, deselected);
@@ -30,6 +30,7 @@ public:
     void clearSelection() override;
 
     void setFormWindow(QDesignerFormWindowInterface *formWindow) override;
+    void updateObjects(QDesignerFormWindowInterface *formWindow, const QObjectList &objects) override;
 
 public slots:
     void mainContainerChanged() override;
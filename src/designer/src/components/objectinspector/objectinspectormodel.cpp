@@ -22,6 +22,7 @@
 
 #include <QtGui/qaction.h>
 
+#include <QtCore/qhash.h>
 #include <QtCore/qset.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qcoreapplication.h>
@@ -298,6 +299,12 @@ namespace qdesigner_internal {
         }
     }
 
+    static QString separatorName()
+    {
+        static const QString separator = QCoreApplication::translate("ObjectInspectorModel", "separator");
+        return separator;
+    }
+
     // ------------ ObjectInspectorModel
     ObjectInspectorModel::ObjectInspectorModel(QObject *parent) :
        QStandardItemModel(0, NumColumns, parent)
@@ -323,6 +330,7 @@ namespace qdesigner_internal {
         beginResetModel();
         m_objectIndexMultiMap.clear();
         m_model.clear();
+        m_insertedIndexes.clear();
         endResetModel(); // force editors to be closed in views
         removeRow(0);
     }
@@ -335,13 +343,15 @@ namespace qdesigner_internal {
             m_formWindow = nullptr;
             return NoForm;
         }
+        const bool formWindowChanged = m_formWindow != fw;
         m_formWindow = fw;
+        m_insertedIndexes.clear();
         // Build new model and compare to previous one. If the structure is
-        // identical, just update, else rebuild
+        // identical, just update. If some subtrees were added or removed,
+        // change only their rows, else rebuild
         ObjectModel newModel;
 
-        static const QString separator = QCoreApplication::translate("ObjectInspectorModel", "separator");
-        const ModelRecursionContext ctx(fw->core(),  separator);
+        const ModelRecursionContext ctx(fw->core(), separatorName());
         createModelRecursion(fw, nullptr, mainContainer, newModel, ctx);
 
         if (newModel == m_model) {
@@ -349,11 +359,47 @@ namespace qdesigner_internal {
             return Updated;
         }
 
+        if (!formWindowChanged && changeRows(newModel))
+            return RowsChanged;
+
         rebuild(newModel);
         m_model = newModel;
         return Rebuilt;
     }
 
+    bool ObjectInspectorModel::updateObjects(const QObjectList &objects)
+    {
+        if (!m_formWindow || m_model.isEmpty())
+            return false;
+
+        const ModelRecursionContext ctx(m_formWindow->core(), separatorName());
+        QSet<QObject *> changedObjects;
+        for (QObject *o : objects) {
+            if (changedObjects.contains(o))
+                continue;
+            changedObjects.insert(o);
+            bool found = false;
+            for (ObjectData &entry : m_model) {
+                if (entry.object() != o)
+                    continue;
+                found = true;
+                const ObjectData newEntry(entry.parent(), o, ctx);
+                if (const unsigned changedMask = entry.compare(newEntry)) {
+                    // The type decides about the children, which would need an update().
+                    if (changedMask & ObjectData::TypeChanged)
+                        return false;
+                    entry = newEntry;
+                    const QModelIndexList indexes = m_objectIndexMultiMap.values(o);
+                    for (const QModelIndex &index : indexes)
+                        entry.setItemsDisplayData(rowAt(index), m_icons, changedMask);
+                }
+            }
+            if (!found)
+                return false;
+        }
+        return true;
+    }
+
     QObject *ObjectInspectorModel::objectAt(const QModelIndex &index) const
     {
         if (index.isValid())
@@ -402,6 +448,126 @@ namespace qdesigner_internal {
         }
     }
 
+    // Change the rows in place in case subtrees were removed from or inserted
+    // into one place of the model, for example, when widgets were added to
+    // or deleted from the form. As the model is a depth first list, these
+    // are a range of entries between the unchanged ones at the start and at
+    // the end. Returns false if the change is not of that kind.
+    bool ObjectInspectorModel::changeRows(const ObjectModel &newModel)
+    {
+        const qsizetype oldSize = m_model.size();
+        const qsizetype newSize = newModel.size();
+        const qsizetype commonSize = std::min(oldSize, newSize);
+        qsizetype prefix = 0;
+        while (prefix < commonSize && m_model.at(prefix) == newModel.at(prefix))
+            ++prefix;
+        if (prefix == 0) // another main container
+            return false;
+        qsizetype suffix = 0;
+        while (suffix < commonSize - prefix
+               && m_model.at(oldSize - 1 - suffix) == newModel.at(newSize - 1 - suffix)) {
+            ++suffix;
+        }
+        const qsizetype removedEnd = oldSize - suffix;
+        const qsizetype insertedEnd = newSize - suffix;
+
+        // The ranges must consist of complete subtrees.
+        QSet<QObject *> removedObjects;
+        for (qsizetype i = prefix; i < removedEnd; ++i)
+            removedObjects.insert(m_model.at(i).object());
+        QSet<QObject *> insertedObjects;
+        for (qsizetype i = prefix; i < insertedEnd; ++i) {
+            QObject *o = newModel.at(i).object();
+            if (insertedObjects.contains(o)) // appears several times (actions)
+                return false;
+            insertedObjects.insert(o);
+        }
+        if (suffix > 0
+            && (removedObjects.contains(m_model.at(removedEnd).parent())
+                || insertedObjects.contains(newModel.at(insertedEnd).parent()))) {
+            return false;
+        }
+
+        // Find the items to remove and the parent items and rows of the
+        // subtrees to insert before changing anything.
+        StandardItemList removedItems;
+        for (qsizetype i = prefix; i < removedEnd; ++i) {
+            const ObjectData &entry = m_model.at(i);
+            if (!removedObjects.contains(entry.parent())) {
+                const QModelIndexList indexes = m_objectIndexMultiMap.values(entry.object());
+                if (indexes.size() != 1)
+                    return false;
+                removedItems.append(itemFromIndex(indexes.constFirst()));
+            }
+        }
+
+        struct Insertion {
+            qsizetype entry;
+            QStandardItem *parentItem;
+            int row;
+        };
+        QList<Insertion> insertions;
+        QHash<QObject *, int> childCounts;
+        for (qsizetype i = 0; i < insertedEnd; ++i) {
+            QObject *parent = newModel.at(i).parent();
+            const int row = childCounts[parent]++;
+            if (i < prefix || insertedObjects.contains(parent))
+                continue;
+            const QModelIndexList indexes = m_objectIndexMultiMap.values(parent);
+            if (indexes.size() != 1 || removedObjects.contains(parent))
+                return false;
+            insertions.append({i, itemFromIndex(indexes.constFirst()), row});
+        }
+
+        // Remove the last rows first to keep the row numbers valid.
+        for (auto it = removedItems.crbegin(), end = removedItems.crend(); it != end; ++it) {
+            QStandardItem *item = *it;
+            QStandardItem *parentItem = item->parent() ? item->parent() : invisibleRootItem();
+            parentItem->removeRow(item->row());
+        }
+
+        StandardItemList insertedItems;
+        QHash<QObject *, QStandardItem *> createdItems;
+        auto insertion = insertions.cbegin();
+        for (qsizetype i = prefix; i < insertedEnd; ++i) {
+            const ObjectData &entry = newModel.at(i);
+            StandardItemList row = createModelRow(entry.object());
+            entry.setItems(row, m_icons);
+            if (insertion != insertions.cend() && insertion->entry == i) {
+                insertion->parentItem->insertRow(insertion->row, row);
+                insertedItems.append(row.constFirst());
+                ++insertion;
+            } else {
+                createdItems.value(entry.parent())->appendRow(row);
+            }
+            createdItems.insert(entry.object(), row.constFirst());
+        }
+
+        // The row numbers of the following items changed.
+        m_objectIndexMultiMap.clear();
+        reindexItems(invisibleRootItem());
+        m_insertedIndexes.clear();
+        for (const QStandardItem *item : std::as_const(insertedItems))
+            m_insertedIndexes.append(indexFromItem(item));
+
+        ObjectModel changedModel = m_model.mid(0, prefix);
+        changedModel += newModel.mid(prefix, insertedEnd - prefix);
+        changedModel += m_model.mid(removedEnd);
+        updateItemContents(changedModel, newModel);
+        m_model = changedModel;
+        return true;
+    }
+
+    void ObjectInspectorModel::reindexItems(QStandardItem *parentItem)
+    {
+        const int rows = parentItem->rowCount();
+        for (int r = 0; r < rows; ++r) {
+            QStandardItem *item = parentItem->child(r);
+            m_objectIndexMultiMap.insert(objectOfItem(item), indexFromItem(item));
+            reindexItems(item);
+        }
+    }
+
     // Update item data in case the model has the same structure
     void ObjectInspectorModel::updateItemContents(ObjectModel &oldModel, const ObjectModel &newModel)
     {
@@ -104,8 +104,15 @@ namespace qdesigner_internal {
 
         explicit ObjectInspectorModel(QObject *parent);
 
-        enum UpdateResult { NoForm, Rebuilt, Updated };
+        // RowsChanged: Rows were inserted or removed in place, see insertedIndexes().
+        enum UpdateResult { NoForm, Rebuilt, Updated, RowsChanged };
         UpdateResult update(QDesignerFormWindowInterface *fw);
+        // Update the rows of objects whose properties changed. Returns false
+        // if an object is not in the model, in which case update() is required.
+        bool updateObjects(const QObjectList &objects);
+
+        // The first rows of the subtrees inserted by the last update().
+        const QModelIndexList &insertedIndexes() const { return m_insertedIndexes; }
 
         const QModelIndexList indexesOf(QObject *o) const { return m_objectIndexMultiMap.values(o); }
         QObject *objectAt(const QModelIndex &index) const;
@@ -115,13 +122,16 @@ namespace qdesigner_internal {
 
     private:
         void rebuild(const ObjectModel &newModel);
+        bool changeRows(const ObjectModel &newModel);
         void updateItemContents(ObjectModel &oldModel, const ObjectModel &newModel);
         void clearItems();
+        void reindexItems(QStandardItem *parentItem);
         StandardItemList rowAt(QModelIndex index) const;
 
         ObjectInspectorIcons m_icons;
         QMultiMap<QObject *, QModelIndex> m_objectIndexMultiMap;
         ObjectModel m_model;
+        QModelIndexList m_insertedIndexes;
         QPointer<QDesignerFormWindowInterface> m_formWindow;
     };
 }  // namespace qdesigner_internal
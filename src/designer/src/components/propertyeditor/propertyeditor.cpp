@@ -703,6 +703,22 @@ void PropertyEditor::setPropertyValue(const QString &name, const QVariant &value
     property->setModified(changed);
 }
 
+// Updates the items of changed properties once when going out of scope
+class BrowserUpdateBatch
+{
+public:
+    Q_DISABLE_COPY_MOVE(BrowserUpdateBatch)
+
+    explicit BrowserUpdateBatch(QtAbstractPropertyBrowser *browser) : m_browser(browser)
+    {
+        m_browser->beginUpdate();
+    }
+    ~BrowserUpdateBatch() { m_browser->endUpdate(); }
+
+private:
+    QtAbstractPropertyBrowser *m_browser;
+};
+
 /* Quick update that assumes the actual count of properties has not changed
  * N/A when for example executing a layout command and margin properties appear. */
 void PropertyEditor::updatePropertySheet()
@@ -712,6 +728,7 @@ void PropertyEditor::updatePropertySheet()
 
     updateToolBarLabel();
 
+    BrowserUpdateBatch batch(m_currentBrowser);
     const int propertyCount = m_propertySheet->count();
     const auto npcend = m_nameToProperty.cend();
     for (int i = 0; i < propertyCount; ++i) {
@@ -768,7 +785,8 @@ void PropertyEditor::updateBrowserValue(QtVariantProperty *property, const QVari
         const PropertySheetFlagValue f = qvariant_cast<PropertySheetFlagValue>(v);
         v = QVariant(f.value);
     }
-    QDesignerPropertySheet *sheet = qobject_cast<QDesignerPropertySheet*>(m_core->extensionManager()->extension(m_object, Q_TYPEID(QDesignerPropertySheetExtension)));
+    // The sheet is owned by the object, which might have been deleted
+    QDesignerPropertySheet *sheet = m_object ? m_designerPropertySheet : nullptr;
     int index = -1;
     if (sheet)
         index = sheet->indexOf(property->propertyName());
@@ -888,6 +906,7 @@ void PropertyEditor::setObject(QObject *object)
     storeExpansionState();
 
     UpdateBlocker ub(this);
+    BrowserUpdateBatch batch(m_currentBrowser);
 
     updateToolBarLabel();
 
@@ -895,16 +914,32 @@ void PropertyEditor::setObject(QObject *object)
 
     const QDesignerDynamicPropertySheetExtension *dynamicSheet =
             qt_extension<QDesignerDynamicPropertySheetExtension*>(m_core->extensionManager(), m_object);
-    const QDesignerPropertySheet *sheet = qobject_cast<QDesignerPropertySheet*>(m_core->extensionManager()->extension(m_object, Q_TYPEID(QDesignerPropertySheetExtension)));
 
     // Optimizization: Instead of rebuilding the complete list every time, compile a list of properties to remove,
     // remove them, traverse the sheet, in case property exists just set a value, otherwise - create it.
     QExtensionManager *m = m_core->extensionManager();
 
-    m_propertySheet = qobject_cast<QDesignerPropertySheetExtension*>(m->extension(object, Q_TYPEID(QDesignerPropertySheetExtension)));
+    QObject *sheetObject = m->extension(object, Q_TYPEID(QDesignerPropertySheetExtension));
+    m_propertySheet = qobject_cast<QDesignerPropertySheetExtension*>(sheetObject);
+    m_designerPropertySheet = qobject_cast<QDesignerPropertySheet*>(sheetObject);
+    const QDesignerPropertySheet *sheet = m_designerPropertySheet;
+
+    // The visible properties of the sheet along with their values, which
+    // are queried only once for both passes.
+    struct SheetProperty
+    {
+        int index;
+        QString name;
+        QString group;
+        QVariant value;
+        int type;
+    };
+    QList<SheetProperty> sheetProperties;
+
     if (m_propertySheet) {
         const int stringTypeId = qMetaTypeId<PropertySheetStringValue>();
         const int propertyCount = m_propertySheet->count();
+        sheetProperties.reserve(propertyCount);
         for (int i = 0; i < propertyCount; ++i) {
             if (!m_propertySheet->isVisible(i))
                 continue;
@@ -913,6 +948,9 @@ void PropertyEditor::setObject(QObject *object)
             if (m_propertySheet->indexOf(propertyName) != i)
                 continue;
             const QString groupName = m_propertySheet->propertyGroup(i);
+            const QVariant value = m_propertySheet->property(i);
+            const int type = toBrowserType(value, propertyName);
+            sheetProperties.append({i, propertyName, groupName, value, type});
             const auto rit = toRemove.constFind(propertyName);
             if (rit != toRemove.constEnd()) {
                 QtVariantProperty *property = rit.value();
@@ -921,7 +959,7 @@ void PropertyEditor::setObject(QObject *object)
                 // occurred since different sub-properties are used (disambiguation/id).
                 if (m_propertyToGroup.value(property) == groupName
                     && (idIdBasedTranslationUnchanged || propertyType != stringTypeId)
-                    && toBrowserType(m_propertySheet->property(i), propertyName) == propertyType) {
+                    && type == propertyType) {
                     toRemove.remove(propertyName);
                 }
             }
@@ -952,17 +990,11 @@ void PropertyEditor::setObject(QObject *object)
 
         QtProperty *lastProperty = nullptr;
         QtProperty *lastGroup = nullptr;
-        const int propertyCount = m_propertySheet->count();
-        for (int i = 0; i < propertyCount; ++i) {
-            if (!m_propertySheet->isVisible(i))
-                continue;
-
-            const QString propertyName = m_propertySheet->propertyName(i);
-            if (m_propertySheet->indexOf(propertyName) != i)
-                continue;
-            const QVariant value = m_propertySheet->property(i);
-
-            const int type = toBrowserType(value, propertyName);
+        for (const SheetProperty &sheetProperty : std::as_const(sheetProperties)) {
+            const int i = sheetProperty.index;
+            const QString &propertyName = sheetProperty.name;
+            const QVariant &value = sheetProperty.value;
+            const int type = sheetProperty.type;
 
             QtVariantProperty *property = m_nameToProperty.value(propertyName, 0);
             bool newProperty = property == nullptr;
@@ -1019,7 +1051,7 @@ void PropertyEditor::setObject(QObject *object)
                     setupStringProperty(property, isMainContainer);
                 property->setAttribute(m_strings.m_resettableAttribute, m_propertySheet->hasReset(i));
 
-                const QString groupName = m_propertySheet->propertyGroup(i);
+                const QString &groupName = sheetProperty.group;
                 QtVariantProperty *groupProperty = nullptr;
 
                 if (newProperty) {
@@ -16,6 +16,7 @@ QT_BEGIN_NAMESPACE
 
 class DomProperty;
 class QDesignerMetaDataBaseItemInterface;
+class QDesignerPropertySheet;
 class QDesignerPropertySheetExtension;
 class QLineEdit;
 
@@ -122,6 +123,7 @@ private:
     const Strings m_strings;
     QDesignerFormEditorInterface *m_core;
     QDesignerPropertySheetExtension *m_propertySheet = nullptr;
+    QDesignerPropertySheet *m_designerPropertySheet = nullptr; // m_propertySheet, if it is one
     QtAbstractPropertyBrowser *m_currentBrowser = nullptr;
     QtButtonPropertyBrowser *m_buttonBrowser;
     QtTreePropertyBrowser *m_treeBrowser = nullptr;
@@ -268,6 +268,7 @@ bool WidgetBoxTreeWidget::load(QDesignerWidgetBox::LoadMode loadMode)
         clear();
         break;
     case QDesignerWidgetBox::LoadCustomWidgetsOnly:
+        m_customCategoriesPending = false;
         addCustomCategories(true);
         updateGeometries();
         return true;
@@ -305,12 +306,28 @@ bool WidgetBoxTreeWidget::loadContents(const QString &contents)
     for (const Category &cat : std::as_const(cat_list))
         addCategory(cat);
 
-    addCustomCategories(false);
+    // Querying the custom widgets initializes the plugins; defer that to
+    // show the standard widgets right away. This also merges the custom
+    // categories once for the several files loaded at startup.
+    if (!m_customCategoriesPending) {
+        m_customCategoriesPending = true;
+        QTimer::singleShot(0, this, &WidgetBoxTreeWidget::addPendingCustomCategories);
+    }
     // Restore which items are expanded
     restoreExpandedState();
     return true;
 }
 
+void WidgetBoxTreeWidget::addPendingCustomCategories()
+{
+    if (!m_customCategoriesPending)
+        return;
+    m_customCategoriesPending = false;
+    addCustomCategories(false);
+    restoreExpandedState();
+    updateGeometries();
+}
+
 void WidgetBoxTreeWidget::addCustomCategories(bool replace)
 {
     if (replace) {
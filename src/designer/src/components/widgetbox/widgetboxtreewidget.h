@@ -76,6 +76,7 @@ private slots:
     void deleteScratchpad();
     void slotListMode();
     void slotIconMode();
+    void addPendingCustomCategories();
 
 private:
     WidgetBoxCategoryListView *addCategoryView(QTreeWidgetItem *parent, bool iconMode);
@@ -102,6 +103,7 @@ private:
     mutable QHash<QString, QIcon> m_pluginIcons;
     bool m_iconMode;
     QTimer *m_scratchPadDeleteTimer;
+    bool m_customCategoriesPending = false;
 };
 
 }  // namespace qdesigner_internal
@@ -253,13 +253,15 @@ QDesigner::ParseArgumentsResult QDesigner::parseCommandLineArguments()
 
     bool suppressNewFormShow = m_workbench->readInBackup();
 
+    QStringList fileNames;
     for (auto fileName : std::as_const(options.files)) {
         // Ensure absolute paths for recent file list to be unique
         const QFileInfo fi(fileName);
         if (fi.exists() && fi.isRelative())
             fileName = fi.absoluteFilePath();
-        m_workbench->readInForm(fileName);
+        fileNames.append(fileName);
     }
+    m_workbench->readInForms(fileNames);
 
     if (m_workbench->formWindowCount() > 0)
         suppressNewFormShow = true;
@@ -61,6 +61,7 @@
 #endif
 #include <QtGui/qpainter.h>
 #include <QtGui/qtransform.h>
+#include <QtGui/qundostack.h>
 #include <QtGui/qcursor.h>
 
 #include <QtCore/qdir.h>
@@ -120,20 +121,31 @@ static QString fileDialogFilters(const QString &extension)
 }
 
 static QString fixResourceFileBackupPath(const QDesignerFormWindowInterface *fwi,
-                                         const QDir& backupDir);
+                                         const QString &content, const QDir& backupDir);
+
+static bool usesCrLfLineTerminators(const QDesignerFormWindowInterface *fw)
+{
+    auto *fwb = qobject_cast<const qdesigner_internal::FormWindowBase *>(fw);
+    return fwb != nullptr
+        && fwb->lineTerminatorMode() == qdesigner_internal::FormWindowBase::CRLFLineTerminator;
+}
 
 static QByteArray formWindowContents(const QDesignerFormWindowInterface *fw,
+                                     const QString &content,
                                      std::optional<QDir> alternativeDir = {})
 {
     QString contents = alternativeDir.has_value()
-        ? fixResourceFileBackupPath(fw, alternativeDir.value()) : fw->contents();
-    if (auto *fwb = qobject_cast<const qdesigner_internal::FormWindowBase *>(fw)) {
-        if (fwb->lineTerminatorMode() == qdesigner_internal::FormWindowBase::CRLFLineTerminator)
-            contents.replace(u'\n', "\r\n"_L1);
-    }
+        ? fixResourceFileBackupPath(fw, content, alternativeDir.value()) : content;
+    if (usesCrLfLineTerminators(fw))
+        contents.replace(u'\n', "\r\n"_L1);
     return contents.toUtf8();
 }
 
+static QByteArray formWindowContents(const QDesignerFormWindowInterface *fw)
+{
+    return formWindowContents(fw, fw->contents());
+}
+
 QFileDialog *createSaveAsDialog(QWidget *parent, const QString &dir, const QString &extension)
 {
     auto result = new QFileDialog(parent, QDesignerActions::tr("Save Form As"),
@@ -429,6 +441,11 @@ QDesignerActions::QDesignerActions(QDesignerWorkbench *workbench)
     connect(formWindowManager, &QDesignerFormWindowManagerInterface::formWindowRemoved,
             this, &QDesignerActions::formWindowCountChanged);
     formWindowCountChanged();
+
+    connect(formWindowManager, &QDesignerFormWindowManagerInterface::formWindowAdded,
+            this, &QDesignerActions::formWindowAdded);
+    connect(formWindowManager, &QDesignerFormWindowManagerInterface::formWindowRemoved,
+            this, [this](QDesignerFormWindowInterface *fw) { m_backedUpForms.remove(fw); });
 }
 
 QActionGroup *QDesignerActions::createHelpActions()
@@ -594,13 +611,7 @@ bool QDesignerActions::openForm(QWidget *parent)
     if (fileNames.isEmpty())
         return false;
 
-    bool atLeastOne = false;
-    for (const QString &fileName : fileNames) {
-        if (readInForm(fileName) && !atLeastOne)
-            atLeastOne = true;
-    }
-
-    return atLeastOne;
+    return workbench()->readInForms(fileNames);
 }
 
 bool QDesignerActions::saveFormAs(QDesignerFormWindowInterface *fw)
@@ -1049,13 +1060,26 @@ void QDesignerActions::backupForms()
 
         backupMap.insert(fwn, formBackupName);
 
+        // Skip forms that did not change since they were last backed up
+        const BackedUpForm backup{formBackupName, usesCrLfLineTerminators(fwi)};
+        const auto previous = m_backedUpForms.constFind(fwi);
+        if (previous != m_backedUpForms.cend()
+            && previous->backupFileName == backup.backupFileName
+            && previous->crlfLineTerminators == backup.crlfLineTerminators
+            && QFileInfo::exists(formBackupName)) {
+            continue;
+        }
+
         bool ok = false;
         QSaveFile file(formBackupName);
         if (file.open(QFile::WriteOnly)) {
-            file.write(formWindowContents(fw->editor(), backupDir));
+            file.write(formWindowContents(fwi, fwi->contents(), backupDir));
             ok = file.commit();
         }
-        if (!ok) {
+        if (ok) {
+            m_backedUpForms.insert(fwi, backup);
+        } else {
+            m_backedUpForms.remove(fwi);
             backupMap.remove(fwn);
             qdesigner_internal::designerWarning(tr("The backup file %1 could not be written: %2").
                                                 arg(QDir::toNativeSeparators(file.fileName()),
@@ -1068,9 +1092,8 @@ void QDesignerActions::backupForms()
 }
 
 static QString fixResourceFileBackupPath(const QDesignerFormWindowInterface *fwi,
-                                         const QDir& backupDir)
+                                         const QString &content, const QDir& backupDir)
 {
-    const QString content = fwi->contents();
     QDomDocument domDoc(u"backup"_s);
     if(!domDoc.setContent(content))
         return content;
@@ -1259,6 +1282,14 @@ void QDesignerActions::formWindowCountChanged()
     m_appFontAction->setStatusTip(enabled ? QString() : disabledTip);
 }
 
+// Forgets that a form was backed up once it changes
+void QDesignerActions::formWindowAdded(QDesignerFormWindowInterface *fw)
+{
+    const auto forget = [this, fw] { m_backedUpForms.remove(fw); };
+    connect(fw, &QDesignerFormWindowInterface::changed, this, forget);
+    connect(fw->commandHistory(), &QUndoStack::indexChanged, this, forget);
+}
+
 void QDesignerActions::printPreviewImage()
 {
 #ifdef HAS_PRINTER
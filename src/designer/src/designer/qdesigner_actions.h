@@ -7,6 +7,7 @@
 #include "assistantclient.h"
 #include "qdesigner_settings.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qpointer.h>
 
@@ -110,6 +111,7 @@ private slots:
     void printPreviewImage();
     void updateCloseAction();
     void formWindowCountChanged();
+    void formWindowAdded(QDesignerFormWindowInterface *fw);
     void formWindowSettingsChanged(QDesignerFormWindowInterface *fw);
 
 private:
@@ -138,6 +140,14 @@ private:
 
     QString m_backupPath;
     QString m_backupTmpPath;
+    // The forms that did not change since they were last backed up, with
+    // the backup file they were written to. A form is removed on its next
+    // change, so that unchanged forms are skipped without serializing them.
+    struct BackedUpForm {
+        QString backupFileName;
+        bool crlfLineTerminators = false;
+    };
+    QHash<const QDesignerFormWindowInterface *, BackedUpForm> m_backedUpForms;
 
     QTimer* m_backupTimer;
 
@@ -19,9 +19,13 @@
 
 #include <QtDesigner/QDesignerComponents>
 #include <QtDesigner/abstractintegration.h>
+#include <QtDesigner/abstractlanguage.h>
+#include <QtDesigner/qextensionmanager.h>
 #include <QtDesigner/private/pluginmanager_p.h>
 #include <QtDesigner/private/formwindowbase_p.h>
+#include <QtDesigner/private/formbuilderextra_p.h>
 #include <QtDesigner/private/actioneditor_p.h>
+#include <QtDesigner/private/ui4_p.h>
 
 #include <QtWidgets/qdockwidget.h>
 #include <QtWidgets/qmenu.h>
@@ -41,6 +45,8 @@
 
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/qpluginloader.h>
@@ -657,6 +663,49 @@ bool QDesignerWorkbench::readInForm(const QString &fileName) const
     return m_actionManager->readInForm(fileName);
 }
 
+// Opens several forms. Their XML is read on worker threads while the forms
+// are created one after the other, each shown before the next is created.
+bool QDesignerWorkbench::readInForms(const QStringList &fileNames)
+{
+    readAheadForms(fileNames);
+    bool atLeastOne = false;
+    for (const QString &fileName : fileNames) {
+        if (m_actionManager->readInForm(fileName))
+            atLeastOne = true;
+        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+    m_formsReadAhead.clear();
+    return atLeastOne;
+}
+
+void QDesignerWorkbench::readAheadForms(const QStringList &fileNames)
+{
+    if (fileNames.size() < 2)
+        return;
+
+    QString language = u"c++"_s;
+    if (const auto *le = qt_extension<QDesignerLanguageExtension *>(m_core->extensionManager(), m_core))
+        language = le->name();
+
+    for (const QString &fileName : fileNames) {
+        if (m_formsReadAhead.contains(fileName))
+            continue;
+        auto promise = std::make_shared<QPromise<std::shared_ptr<DomUI>>>();
+        m_formsReadAhead.insert(fileName, promise->future());
+        QThreadPool::globalInstance()->start([promise, fileName, language] {
+            promise->start();
+            std::shared_ptr<DomUI> ui;
+            QFile file(fileName);
+            if (file.open(QFile::ReadOnly | QFile::Text)) {
+                QString errorString;
+                ui.reset(QFormBuilderExtra::readUi(&file, language, &errorString));
+            }
+            promise->addResult(ui);
+            promise->finish();
+        });
+    }
+}
+
 bool QDesignerWorkbench::writeOutForm(QDesignerFormWindowInterface *formWindow, const QString &fileName) const
 {
     return m_actionManager->writeOutForm(formWindow, fileName);
@@ -799,6 +848,7 @@ bool QDesignerWorkbench::readInBackup()
         return false;
 
     const auto modifiedPlaceHolder = "[*]"_L1;
+    readAheadForms(backupFileMap.values());
     for (auto it = backupFileMap.cbegin(), end = backupFileMap.cend(); it != end; ++it) {
         QString fileName = it.key();
         fileName.remove(modifiedPlaceHolder);
@@ -807,6 +857,7 @@ bool QDesignerWorkbench::readInBackup()
             formWindowManager()->activeFormWindow()->setFileName(fileName);
 
     }
+    m_formsReadAhead.clear();
     return true;
 }
 
@@ -930,7 +981,16 @@ QDesignerFormWindow * QDesignerWorkbench::loadForm(const QString &fileName,
     // In this case, the file name will we be cleared on return to force a save box.
     editor->setFileName(fileName);
 
-    if (!editor->setContents(&file, errorMessage)) {
+    std::shared_ptr<DomUI> ui;
+    if (const auto it = m_formsReadAhead.constFind(fileName); it != m_formsReadAhead.cend()) {
+        ui = it.value().result();
+        m_formsReadAhead.erase(it);
+    }
+    auto *editorBase = qobject_cast<qdesigner_internal::FormWindowBase *>(editor);
+    const bool loaded = ui && editorBase
+        ? editorBase->setContentsFromUi(ui.get(), errorMessage)
+        : editor->setContents(&file, errorMessage);
+    if (!loaded) {
         removeFormWindow(formWindow);
         formWindowManager->removeFormWindow(editor);
         m_core->metaDataBase()->remove(editor);
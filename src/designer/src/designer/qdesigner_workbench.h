@@ -6,6 +6,7 @@
 
 #include "designer_enums.h"
 
+#include <QtCore/qfuture.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qobject.h>
@@ -13,6 +14,8 @@
 #include <QtCore/qrect.h>
 #include <QtCore/qset.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QDesignerActions;
@@ -36,6 +39,7 @@ class QDesignerFormEditorInterface;
 class QDesignerFormWindowInterface;
 class QDesignerFormWindowManagerInterface;
 class QDesignerIntegration;
+class DomUI;
 
 class QDesignerWorkbench: public QObject
 {
@@ -66,6 +70,7 @@ public:
     QActionGroup *modeActionGroup() const;
 
     bool readInForm(const QString &fileName) const;
+    bool readInForms(const QStringList &fileNames);
     bool writeOutForm(QDesignerFormWindowInterface *formWindow, const QString &fileName) const;
     bool saveForm(QDesignerFormWindowInterface *fw);
     bool handleClose();
@@ -113,6 +118,7 @@ private:
     void closeAllToolWindows();
     QDesignerToolWindow *widgetBoxToolWindow() const;
     QDesignerFormWindow *loadForm(const QString &fileName, bool detectLineTermiantorMode, QString *errorMessage);
+    void readAheadForms(const QStringList &fileNames);
     void resizeForm(QDesignerFormWindow *fw,  const QWidget *mainContainer) const;
     void saveGeometriesForModeChange();
     void saveGeometries(QDesignerSettings &settings) const;
@@ -142,6 +148,9 @@ private:
 
     QList<QDesignerToolWindow *> m_toolWindows;
     QList<QDesignerFormWindow *> m_formWindows;
+    // Forms being read on worker threads by readAheadForms(), by file name.
+    // A null result makes loadForm() read the file again to report the error.
+    QHash<QString, QFuture<std::shared_ptr<DomUI>>> m_formsReadAhead;
 
     QMenu *m_toolbarMenu;
 
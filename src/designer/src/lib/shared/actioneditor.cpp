@@ -296,13 +296,15 @@ void ActionEditor::setFormWindow(QDesignerFormWindowInterface *formWindow)
     m_filterWidget->setEnabled(true);
 
     const ActionList actionList = formWindow->mainContainer()->findChildren<QAction*>();
+    ActionList shownActions;
     for (QAction *action : actionList)
         if (!action->isSeparator() && core()->metaDataBase()->item(action) != nullptr) {
             // Show unless it has a menu. However, listen for change on menu actions also as it might be removed
             if (!action->menu())
-                m_actionView->model()->addAction(action);
+                shownActions.append(action);
             connect(action, &QAction::changed, this, &ActionEditor::slotActionChanged);
         }
+    m_actionView->model()->addActions(shownActions);
 
     setFilter(m_filter);
 }
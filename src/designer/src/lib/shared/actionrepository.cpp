@@ -93,7 +93,7 @@ void ActionModel::remove(int row)
     qDeleteAll(takeRow(row));
 }
 
-QModelIndex ActionModel::addAction(QAction *action)
+ActionModel::QStandardItemList ActionModel::createItems(QAction *action) const
 {
     Q_ASSERT(m_core);
     QStandardItemList items;
@@ -109,10 +109,31 @@ QModelIndex ActionModel::addAction(QAction *action)
         items.push_back(item);
     }
     setItems(m_core, action, m_emptyIcon, items);
+    return items;
+}
+
+QModelIndex ActionModel::addAction(QAction *action)
+{
+    const QStandardItemList items = createItems(action);
     appendRow(items);
     return indexFromItem(items.constFirst());
 }
 
+// Inserts all rows at once, so that the views lay out their items once
+// instead of once per action.
+void ActionModel::addActions(const QList<QAction *> &actions)
+{
+    if (actions.isEmpty())
+        return;
+    const int firstRow = rowCount();
+    insertRows(firstRow, int(actions.size()));
+    for (qsizetype a = 0, size = actions.size(); a < size; ++a) {
+        const QStandardItemList items = createItems(actions.at(a));
+        for (int column = 0; column < NumColumns; ++column)
+            setItem(firstRow + int(a), column, items.at(column));
+    }
+}
+
 // Find the associated menus and toolbars, ignore toolbuttons
 QWidgetList ActionModel::associatedWidgets(const QAction *action)
 {
@@ -327,6 +348,8 @@ ActionTreeView::ActionTreeView(ActionModel *model, QWidget *parent) :
 
     setModel(model);
     connect(this, &QTreeView::activated, this, &ActionTreeView::slotActivated);
+    // A renamed action might match a filter it did not match before
+    connect(model, &QAbstractItemModel::dataChanged, this, [this] { m_appliedFilter.clear(); });
     connect(header(), &QHeaderView::sectionDoubleClicked,
             this, &QTreeView::resizeColumnToContents);
 
@@ -339,13 +362,25 @@ QAction *ActionTreeView::currentAction() const
     return m_model->actionAt(currentIndex());
 }
 
+// A filter that extends the previously applied one can only hide further
+// rows, so only the visible rows need to be checked then.
+static bool isNarrowingFilter(const QString &appliedFilter, const QString &text)
+{
+    return !appliedFilter.isEmpty() && text.contains(appliedFilter, Qt::CaseInsensitive);
+}
+
 void ActionTreeView::filter(const QString &text)
 {
+    const bool narrowing = isNarrowingFilter(m_appliedFilter, text);
+    m_appliedFilter = text;
     const int rowCount = m_model->rowCount();
     const bool empty = text.isEmpty();
     const QModelIndex parent = rootIndex();
-    for (int i = 0; i < rowCount; i++)
+    for (int i = 0; i < rowCount; i++) {
+        if (narrowing && isRowHidden(i, parent))
+            continue;
         setRowHidden(i, parent, !empty && !m_model->actionName(i).contains(text, Qt::CaseInsensitive));
+    }
 }
 
 void ActionTreeView::dragEnterEvent(QDragEnterEvent *event)
@@ -404,6 +439,7 @@ ActionListView::ActionListView(ActionModel *model, QWidget *parent) :
     setModel(model);
     setTextElideMode(Qt::ElideMiddle);
     connect(this, &QListView::activated, this, &ActionListView::slotActivated);
+    connect(model, &QAbstractItemModel::dataChanged, this, [this] { m_appliedFilter.clear(); });
 
     // We actually want 'Static' as the user should be able to
     // drag away actions only (not to rearrange icons).
@@ -424,10 +460,15 @@ QAction *ActionListView::currentAction() const
 
 void ActionListView::filter(const QString &text)
 {
+    const bool narrowing = isNarrowingFilter(m_appliedFilter, text);
+    m_appliedFilter = text;
     const int rowCount = m_model->rowCount();
     const bool empty = text.isEmpty();
-    for (int i = 0; i < rowCount; i++)
+    for (int i = 0; i < rowCount; i++) {
+        if (narrowing && isRowHidden(i))
+            continue;
         setRowHidden(i, !empty && !m_model->actionName(i).contains(text, Qt::CaseInsensitive));
+    }
 }
 
 void ActionListView::dragEnterEvent(QDragEnterEvent *event)
@@ -523,9 +564,11 @@ void ActionView::setViewMode(int lm)
     switch (lm) {
     case IconView:
         setCurrentWidget(m_actionListView);
+        m_actionListView->filter(m_filter);
         break;
     case DetailedView:
         setCurrentWidget(m_actionTreeView);
+        m_actionTreeView->filter(m_filter);
         break;
     default:
         break;
@@ -539,10 +582,15 @@ void ActionView::slotCurrentChanged(QAction *action)
         emit currentChanged(action);
 }
 
+// Only the visible view is filtered; the other one is filtered when the
+// view mode changes.
 void ActionView::filter(const QString &text)
 {
-    m_actionTreeView->filter(text);
-    m_actionListView->filter(text);
+    m_filter = text;
+    if (currentWidget() == m_actionListView)
+        m_actionListView->filter(text);
+    else
+        m_actionTreeView->filter(text);
 }
 
 void ActionView::selectAll()
@@ -47,6 +47,7 @@ public:
 
     void clearActions();
     QModelIndex addAction(QAction *a);
+    void addActions(const QList<QAction *> &actions);
     // remove row
     void remove(int row);
     // update the row from the underlying action
@@ -77,6 +78,7 @@ private:
     using QStandardItemList = QList<QStandardItem *>;
 
     void initializeHeaders();
+    QStandardItemList createItems(QAction *action) const;
     static void setItems(QDesignerFormEditorInterface *core, QAction *a,
                          const QIcon &defaultIcon,
                          QStandardItemList &sl);
@@ -118,6 +120,7 @@ private slots:
 
 private:
     ActionModel *m_model;
+    QString m_appliedFilter;
 };
 
 // Internal class that provides the icon view of actions.
@@ -152,6 +155,7 @@ private slots:
 
 private:
     ActionModel *m_model;
+    QString m_appliedFilter;
 };
 
 // Action View that can be switched between detailed and icon view
@@ -203,6 +207,7 @@ private:
     ActionModel *m_model;
     ActionTreeView *m_actionTreeView;
     ActionListView *m_actionListView;
+    QString m_filter;
 };
 
 class QDESIGNER_SHARED_EXPORT ActionRepositoryMimeData: public QMimeData
@@ -25,6 +25,8 @@
 #include <QtGui/qfontmetrics.h>
 #include <QtGui/qicon.h>
 
+#include <QtCore/qcache.h>
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qmimedatabase.h>
@@ -35,6 +37,23 @@ QT_BEGIN_NAMESPACE
 using namespace Qt::StringLiterals;
 
 namespace qdesigner_internal {
+
+// Generated code of recently previewed form revisions, keyed by the
+// language, form file name and a hash of the form contents. This avoids
+// launching uic again when the preview is reopened for an unchanged form.
+using GeneratedCodeCache = QCache<QByteArray, QString>;
+Q_GLOBAL_STATIC(GeneratedCodeCache, generatedCodeCache, 16)
+
+static QByteArray generatedCodeKey(const QString &fileName, UicLanguage language,
+                                   const QByteArray &contents)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayView(language == UicLanguage::Python ? "py" : "cpp"));
+    hash.addData(fileName.toUtf8());
+    hash.addData(contents);
+    return hash.result();
+}
+
 // ----------------- CodeDialogPrivate
 struct CodeDialog::CodeDialogPrivate {
     CodeDialogPrivate();
@@ -138,12 +157,19 @@ bool CodeDialog::generateCode(const QDesignerFormWindowInterface *fw,
                               QString *code,
                               QString *errorMessage)
 {
+    const QString fileName = fw->fileName();
+    const QByteArray contents = fw->contents().toUtf8();
+    const QByteArray cacheKey = generatedCodeKey(fileName, language, contents);
+    if (const QString *cached = generatedCodeCache()->object(cacheKey)) {
+        *code = *cached;
+        return true;
+    }
+
     // Generate temporary file name similar to form file name
     // (for header guards)
     QString tempPattern = QDir::tempPath();
     if (!tempPattern.endsWith(QDir::separator())) // platform-dependant
         tempPattern += QDir::separator();
-    const QString fileName = fw->fileName();
     if (fileName.isEmpty()) {
         tempPattern += "designer"_L1;
     } else {
@@ -159,7 +185,7 @@ bool CodeDialog::generateCode(const QDesignerFormWindowInterface *fw,
         return false;
     }
     const QString tempFormFileName = tempFormFile.fileName();
-    tempFormFile.write(fw->contents().toUtf8());
+    tempFormFile.write(contents);
     if (!tempFormFile.flush())  {
         *errorMessage = tr("The temporary form file %1 could not be written.").arg(tempFormFileName);
         return false;
@@ -170,6 +196,7 @@ bool CodeDialog::generateCode(const QDesignerFormWindowInterface *fw,
     if (!runUIC(tempFormFileName, language, rc, *errorMessage))
         return false;
     *code = QString::fromUtf8(rc);
+    generatedCodeCache()->insert(cacheKey, new QString(*code));
     return true;
 }
 
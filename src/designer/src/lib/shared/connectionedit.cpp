@@ -16,10 +16,14 @@
 #include <QtGui/qpixmap.h>
 #include <QtGui/qtransform.h>
 
+#include <QtCore/qdebug.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qmap.h>
 
 QT_BEGIN_NAMESPACE
 
+enum { debugPaintTime = 0 };
+
 static const int BG_ALPHA =              32;
 static const int LINE_PROXIMITY_RADIUS =  3;
 static const int LOOP_MARGIN  =          20;
@@ -714,6 +718,31 @@ QRegion Connection::region() const
     return result;
 }
 
+// The bounding rectangle of region(), without building the region.
+QRect Connection::boundingRect() const
+{
+    QRect result;
+    if (!m_knee_list.isEmpty()) {
+        QPoint topLeft = m_knee_list.constFirst();
+        QPoint bottomRight = topLeft;
+        for (const QPoint &knee : m_knee_list) {
+            topLeft = QPoint(qMin(topLeft.x(), knee.x()), qMin(topLeft.y(), knee.y()));
+            bottomRight = QPoint(qMax(bottomRight.x(), knee.x()), qMax(bottomRight.y(), knee.y()));
+        }
+        if (m_knee_list.size() > 1)
+            result = expand(QRect(topLeft, bottomRight), LINE_PROXIMITY_RADIUS);
+    }
+
+    if (!m_arrow_head.isEmpty())
+        result = result.united(expand(m_arrow_head.boundingRect().toRect(), 1));
+    else if (ground())
+        result = result.united(groundRect());
+
+    result = result.united(labelRect(EndPoint::Source));
+    result = result.united(labelRect(EndPoint::Target));
+    return result;
+}
+
 void Connection::update(bool update_widgets) const
 {
     m_edit->update(region());
@@ -1014,15 +1043,18 @@ void ConnectionEdit::paintLabel(QPainter *p, EndPoint::Type type, Connection *co
 
 void ConnectionEdit::paintConnection(QPainter *p, Connection *con,
                                         WidgetSet *heavy_highlight_set,
-                                        WidgetSet *light_highlight_set) const
+                                        WidgetSet *light_highlight_set,
+                                        bool paintLine) const
 {
     QWidget *source = con->widget(EndPoint::Source);
     QWidget *target = con->widget(EndPoint::Target);
 
     const bool heavy = selected(con) || con == m_tmp_con;
     WidgetSet *set = heavy ? heavy_highlight_set : light_highlight_set;
-    p->setPen(heavy ? m_active_color : m_inactive_color);
-    con->paint(p);
+    if (paintLine) {
+        p->setPen(heavy ? m_active_color : m_inactive_color);
+        con->paint(p);
+    }
 
     if (source != nullptr && source != m_bg_widget)
         set->insert(source, source);
@@ -1033,8 +1065,15 @@ void ConnectionEdit::paintConnection(QPainter *p, Connection *con,
 
 void ConnectionEdit::paintEvent(QPaintEvent *e)
 {
+    QElapsedTimer timer;
+    if (debugPaintTime)
+        timer.start();
+
     QPainter p(this);
     p.setClipRegion(e->region());
+    // Skip what is outside of the exposed area, which is usually small while
+    // dragging, but still collect the widgets to highlight.
+    const QRect exposed = e->rect();
 
     WidgetSet heavy_highlight_set, light_highlight_set;
 
@@ -1042,7 +1081,8 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
         if (!con->isVisible())
             continue;
 
-        paintConnection(&p, con, &heavy_highlight_set, &light_highlight_set);
+        paintConnection(&p, con, &heavy_highlight_set, &light_highlight_set,
+                        con->boundingRect().intersects(exposed));
     }
 
     if (m_tmp_con != nullptr)
@@ -1057,7 +1097,9 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
     p.setBrush(c);
 
     for (QWidget *w : std::as_const(heavy_highlight_set)) {
-        p.drawRect(fixRect(widgetRect(w)));
+        const QRect r = widgetRect(w);
+        if (r.intersects(exposed))
+            p.drawRect(fixRect(r));
         light_highlight_set.remove(w);
     }
 
@@ -1066,15 +1108,20 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
     c.setAlpha(BG_ALPHA);
     p.setBrush(c);
 
-    for (QWidget *w : std::as_const(light_highlight_set))
-        p.drawRect(fixRect(widgetRect(w)));
+    for (QWidget *w : std::as_const(light_highlight_set)) {
+        const QRect r = widgetRect(w);
+        if (r.intersects(exposed))
+            p.drawRect(fixRect(r));
+    }
 
     p.setBrush(palette().color(QPalette::Base));
     p.setPen(palette().color(QPalette::Text));
     for (Connection *con : std::as_const(m_con_list)) {
         if (con->isVisible()) {
-            paintLabel(&p, EndPoint::Source, con);
-            paintLabel(&p, EndPoint::Target, con);
+            for (const EndPoint::Type type : {EndPoint::Source, EndPoint::Target}) {
+                if (con->labelRect(type).intersects(exposed))
+                    paintLabel(&p, type, con);
+            }
         }
     }
 
@@ -1085,10 +1132,18 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
         if (!selected(con) || !con->isVisible())
             continue;
 
-        paintEndPoint(&p, con->endPointPos(EndPoint::Source));
+        if (con->endPointRect(EndPoint::Source).intersects(exposed))
+            paintEndPoint(&p, con->endPointPos(EndPoint::Source));
 
-        if (con->widget(EndPoint::Target) != nullptr)
+        if (con->widget(EndPoint::Target) != nullptr
+            && con->endPointRect(EndPoint::Target).intersects(exposed)) {
             paintEndPoint(&p, con->endPointPos(EndPoint::Target));
+        }
+    }
+
+    if (debugPaintTime) {
+        qDebug() << "ConnectionEdit::paintEvent" << exposed << m_con_list.size() << "connections"
+                 << double(timer.nsecsElapsed()) / 1000000 << "ms";
     }
 }
 
@@ -85,6 +85,7 @@ public:
     void setVisible(bool b);
 
     virtual QRegion region() const;
+    QRect boundingRect() const;
     bool contains(const QPoint &pos) const;
     virtual void paint(QPainter *p) const;
 
@@ -217,7 +218,8 @@ private:
     EndPoint endPointAt(const QPoint &pos) const;
     void paintConnection(QPainter *p, Connection *con,
                          WidgetSet *heavy_highlight_set,
-                         WidgetSet *light_highlight_set) const;
+                         WidgetSet *light_highlight_set,
+                         bool paintLine = true) const;
     void paintLabel(QPainter *p, EndPoint::Type type, Connection *con);
 
 
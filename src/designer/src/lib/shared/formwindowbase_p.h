@@ -24,6 +24,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class DomUI;
 class QDesignerDnDItemInterface;
 class QMenu;
 class QtResourceSet;
@@ -105,6 +106,9 @@ public:
     // Factory method to create a form builder
     virtual QEditorFormBuilder *createFormBuilder() = 0;
 
+    // Like setContents(), for a form already read by QFormBuilderExtra::readUi()
+    virtual bool setContentsFromUi(DomUI *ui, QString *errorMessage = nullptr) = 0;
+
     virtual bool blockSelectionChanged(bool blocked) = 0;
 
     DesignerPixmapCache *pixmapCache() const;
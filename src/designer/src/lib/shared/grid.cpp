@@ -11,11 +11,14 @@
 
 #include <QtGui/qevent.h>
 #include <QtGui/qpainter.h>
+#include <QtGui/qpixmapcache.h>
 
 #include <QtWidgets/qwidget.h>
 
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 static const bool defaultSnap = true;
 static const bool defaultVisible = true;
 static const int DEFAULT_GRID = 10;
@@ -94,30 +97,62 @@ void Grid::paint(QWidget *widget, QPaintEvent *e) const
     paint(p, widget, e);
 }
 
-void Grid::paint(QPainter &p, const QWidget *widget, QPaintEvent *e) const
+// The number of grid cells a tile spans, so that it has a whole number of
+// device pixels also for fractional device pixel ratios like 1.25.
+static int tileCells(int delta, qreal devicePixelRatio)
 {
-    const auto &palette = widget->palette();
-    p.setPen(isDarkMode() ? palette.light().color() : palette.dark().color());
-
-    if (m_visible) {
-        const int xstart = (e->rect().x() / m_deltaX) * m_deltaX;
-        const int ystart = (e->rect().y() / m_deltaY) * m_deltaY;
-
-        const int xend = e->rect().right();
-        const int yend = e->rect().bottom();
-
-        using Points = QList<QPointF>;
-        static Points points;
-        points.clear();
+    for (int cells = 1; cells <= 8; ++cells) {
+        const qreal size = delta * cells * devicePixelRatio;
+        if (qAbs(size - qRound(size)) < 0.01)
+            return cells;
+    }
+    return 1;
+}
 
-        for (int x = xstart; x <= xend; x += m_deltaX) {
-            points.reserve((yend - ystart) / m_deltaY + 1);
-            for (int y = ystart; y <= yend; y += m_deltaY)
-                points.push_back(QPointF(x, y));
-            p.drawPoints( &(*points.begin()), points.size());
-            points.clear();
+// A tile of the grid with a point at the top left of each cell, which is
+// used as a brush, so that painting large areas is a single fill. The
+// points are placed in device pixels, the ratio is only set afterwards, so
+// that they do not drift or blur at fractional device pixel ratios.
+static QPixmap gridTile(int deltaX, int deltaY, const QColor &color, qreal devicePixelRatio)
+{
+    const QString key = "qt_designer_grid_%1_%2_%3_%4"_L1.arg(deltaX).arg(deltaY)
+                        .arg(color.rgba()).arg(devicePixelRatio);
+    QPixmap tile;
+    if (QPixmapCache::find(key, &tile))
+        return tile;
+
+    const int cellsX = tileCells(deltaX, devicePixelRatio);
+    const int cellsY = tileCells(deltaY, devicePixelRatio);
+    tile = QPixmap(qRound(deltaX * cellsX * devicePixelRatio),
+                   qRound(deltaY * cellsY * devicePixelRatio));
+    tile.fill(Qt::transparent);
+    const int pointSize = qMax(1, qRound(devicePixelRatio));
+    QPainter p(&tile);
+    for (int x = 0; x < cellsX; ++x) {
+        for (int y = 0; y < cellsY; ++y) {
+            p.fillRect(qRound(x * deltaX * devicePixelRatio), qRound(y * deltaY * devicePixelRatio),
+                       pointSize, pointSize, color);
         }
     }
+    p.end();
+    tile.setDevicePixelRatio(devicePixelRatio);
+    QPixmapCache::insert(key, tile);
+    return tile;
+}
+
+void Grid::paint(QPainter &p, const QWidget *widget, QPaintEvent *e) const
+{
+    const auto &palette = widget->palette();
+    const QColor color = isDarkMode() ? palette.light().color() : palette.dark().color();
+    p.setPen(color);
+
+    if (m_visible && m_deltaX > 0 && m_deltaY > 0) {
+        const QPixmap tile = gridTile(m_deltaX, m_deltaY, color, widget->devicePixelRatio());
+        p.save();
+        p.setBrushOrigin(0, 0);
+        p.fillRect(e->rect(), QBrush(tile));
+        p.restore();
+    }
 }
 
 int Grid::snapValue(int value, int grid) const
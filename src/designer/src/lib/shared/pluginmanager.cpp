@@ -8,6 +8,7 @@
 #include <QtDesigner/abstractformeditor.h>
 #include <QtDesigner/qextensionmanager.h>
 #include <QtDesigner/abstractlanguage.h>
+#include <QtDesigner/private/formbuilderextra_p.h>
 
 #include <QtUiPlugin/customwidget.h>
 
@@ -19,6 +20,7 @@
 #include <QtCore/qlibrary.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qcoreapplication.h>
@@ -56,6 +58,9 @@ enum { debugPluginManager = 0 };
  * is used to indicate the state.
  * Later, someone might call registerNewPlugins(), which agains clears the flag via
  * registerPlugin() and triggers the process again.
+ * Plugins describing their custom widgets in the "customWidgets" array of
+ * their metadata are not loaded at all when registering them; stand-ins
+ * created from the metadata load them when the first widget is created.
  * Also note that Jambi fakes a custom widget collection that changes its contents
  * every time the project is switched. So, custom widget plugins can actually
  * disappear, and the custom widget list must be cleared and refilled in
@@ -435,6 +440,9 @@ class QDesignerPluginManagerPrivate {
 
     QMap<QString, QString> m_failedPlugins;
 
+    // Custom widgets of the plugins that describe them in their metadata
+    QHash<QString, QDesignerPluginManager::CustomWidgetList> m_lazyCustomWidgets;
+
     // Synced lists of custom widgets and their data. Note that the list
     // must be ordered for collections to appear in order.
     QList<QDesignerCustomWidgetInterface *> m_customWidgets;
@@ -668,7 +676,14 @@ void QDesignerPluginManager::registerPlugin(const QString &plugin)
         return;
 
     QPluginLoader loader(plugin);
-    if (loader.isLoaded() || loader.load()) {
+    const CustomWidgetList lazyCustomWidgets =
+        QFormBuilderExtra::lazyCustomWidgets(plugin, loader.metaData());
+    if (!lazyCustomWidgets.isEmpty())
+        m_d->m_lazyCustomWidgets.insert(plugin, lazyCustomWidgets);
+    else
+        m_d->m_lazyCustomWidgets.remove(plugin);
+
+    if (!lazyCustomWidgets.isEmpty() || loader.isLoaded() || loader.load()) {
         m_d->m_registeredPlugins += plugin;
         const auto fit = m_d->m_failedPlugins.find(plugin);
         if (fit != m_d->m_failedPlugins.end())
@@ -710,8 +725,13 @@ void QDesignerPluginManager::ensureInitialized()
             m_d->addCustomWidgets(o, staticPluginPath, designerLanguage);
     }
     for (const QString &plugin : std::as_const(m_d->m_registeredPlugins)) {
-        if (QObject *o = instance(plugin))
+        const auto lit = m_d->m_lazyCustomWidgets.constFind(plugin);
+        if (lit != m_d->m_lazyCustomWidgets.cend()) {
+            for (QDesignerCustomWidgetInterface *c : lit.value())
+                m_d->addCustomWidget(c, plugin, designerLanguage);
+        } else if (QObject *o = instance(plugin)) {
             m_d->addCustomWidgets(o, plugin, designerLanguage);
+        }
     }
 
     m_d->m_initialized = true;
@@ -745,6 +765,9 @@ QObjectList QDesignerPluginManager::instances() const
 
     QObjectList lst;
     for (const QString &plugin : plugins) {
+        // Custom widget plugins are only loaded when their widgets are used
+        if (m_d->m_lazyCustomWidgets.contains(plugin))
+            continue;
         if (QObject *o = instance(plugin))
             lst.append(o);
     }
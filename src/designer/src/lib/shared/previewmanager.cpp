@@ -31,7 +31,10 @@
 #include <QtGui/qtransform.h>
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qloggingcategory.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qpointer.h>
 #include <QtCore/qshareddata.h>
@@ -40,6 +43,8 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+Q_STATIC_LOGGING_CATEGORY(lcPreview, "qt.designer.preview")
+
 static inline int compare(const qdesigner_internal::PreviewConfiguration &pc1, const qdesigner_internal::PreviewConfiguration &pc2)
 {
     int rc = pc1.style().compare(pc2.style());
@@ -535,6 +540,14 @@ public:
 
     QMap<QString, DeviceSkinParameters> m_deviceSkinConfigCache;
 
+    // Serialized contents of the previewed forms, shared by previews with
+    // different configurations until the form changes.
+    struct FormContents {
+        QByteArray contents;
+        QList<QMetaObject::Connection> connections;
+    };
+    QHash<const QDesignerFormWindowInterface *, FormContents> m_formContentsCache;
+
     QDesignerFormEditorInterface *m_core;
     bool m_updateBlocked;
 };
@@ -624,6 +637,38 @@ QWidget *PreviewManager::showPreview(const QDesignerFormWindowInterface *fw, con
     return showPreview(fw, style, -1, errorMessage);
 }
 
+QByteArray PreviewManager::formContents(const QDesignerFormWindowInterface *fw)
+{
+    auto it = d->m_formContentsCache.find(fw);
+    if (it != d->m_formContentsCache.end())
+        return it->contents;
+
+    QElapsedTimer timer;
+    timer.start();
+    PreviewManagerPrivate::FormContents formContents;
+    formContents.contents = fw->contents().toUtf8();
+    qCDebug(lcPreview) << "Serialized" << fw->fileName() << "in" << timer.elapsed() << "ms";
+
+    auto invalidate = [this, fw] { invalidateFormContents(fw); };
+    formContents.connections = {
+        connect(fw, &QDesignerFormWindowInterface::changed, this, invalidate),
+        connect(fw, &QDesignerFormWindowInterface::geometryChanged, this, invalidate),
+        connect(fw, &QDesignerFormWindowInterface::resourceFilesChanged, this, invalidate),
+        connect(fw, &QObject::destroyed, this, invalidate)
+    };
+    return d->m_formContentsCache.insert(fw, formContents)->contents;
+}
+
+void PreviewManager::invalidateFormContents(const QDesignerFormWindowInterface *fw)
+{
+    const auto it = d->m_formContentsCache.find(fw);
+    if (it == d->m_formContentsCache.end())
+        return;
+    for (const auto &connection : std::as_const(it->connections))
+        disconnect(connection);
+    d->m_formContentsCache.erase(it);
+}
+
 QWidget *PreviewManager::createPreview(const QDesignerFormWindowInterface *fw,
                                        const PreviewConfiguration &pc,
                                        int deviceProfileIndex,
@@ -643,9 +688,16 @@ QWidget *PreviewManager::createPreview(const QDesignerFormWindowInterface *fw,
             deviceProfile = fwb->deviceProfile();
     }
     // Create
-    QWidget *formWidget = QDesignerFormBuilder::createPreview(fw, pc.style(), pc.applicationStyleSheet(), deviceProfile, errorMessage);
+    const QByteArray contents = formContents(fw);
+    QElapsedTimer timer;
+    timer.start();
+    QWidget *formWidget = QDesignerFormBuilder::createPreview(fw, contents, pc.style(),
+                                                              pc.applicationStyleSheet(),
+                                                              deviceProfile, errorMessage);
     if (!formWidget)
         return nullptr;
+    qCDebug(lcPreview) << "Built preview of" << fw->fileName() << "with style" << pc.style()
+                       << "in" << timer.elapsed() << "ms";
 
     const QString title = tr("%1 - [Preview]").arg(formWidget->windowTitle());
     formWidget = fakeContainer(formWidget);
@@ -133,6 +133,8 @@ private:
                            int initialZoom = -1);
 
     void updatePreviewClosed(QWidget *w);
+    QByteArray formContents(const QDesignerFormWindowInterface *fw);
+    void invalidateFormContents(const QDesignerFormWindowInterface *fw);
 
     PreviewManagerPrivate *d;
 
@@ -298,12 +298,23 @@ QWidget *QDesignerFormBuilder::createPreview(const QDesignerFormWindowInterface
                                              const QString &appStyleSheet,
                                              const DeviceProfile &deviceProfile,
                                              QString *errorMessage)
+{
+    return createPreview(fw, fw->contents().toUtf8(), styleName, appStyleSheet,
+                         deviceProfile, errorMessage);
+}
+
+QWidget *QDesignerFormBuilder::createPreview(const QDesignerFormWindowInterface *fw,
+                                             const QByteArray &contents,
+                                             const QString &styleName,
+                                             const QString &appStyleSheet,
+                                             const DeviceProfile &deviceProfile,
+                                             QString *errorMessage)
 {
     // load
     QDesignerFormBuilder builder(fw->core(), deviceProfile);
     builder.setWorkingDirectory(fw->absoluteDir());
 
-    QByteArray bytes = fw->contents().toUtf8();
+    QByteArray bytes = contents;
 
     QBuffer buffer(&bytes);
     buffer.open(QIODevice::ReadOnly);
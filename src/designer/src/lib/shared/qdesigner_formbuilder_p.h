@@ -59,6 +59,10 @@ public:
                                   const QString &appStyleSheet  /* ="" */,
                                   const DeviceProfile &deviceProfile,
                                   QString *errorMessage);
+    // Create a preview widget from contents previously obtained by QDesignerFormWindowInterface::contents()
+    static QWidget *createPreview(const QDesignerFormWindowInterface *fw, const QByteArray &contents,
+                                  const QString &styleName, const QString &appStyleSheet,
+                                  const DeviceProfile &deviceProfile, QString *errorMessage);
     // Convenience that pops up message boxes in case of failures.
     static QWidget *createPreview(const QDesignerFormWindowInterface *fw, const QString &styleName = QString());
     //  Create a preview widget (for integrations) or return 0. The widget has to be embedded into a main window.
@@ -9,6 +9,8 @@
 
 #include <QtWidgets/qwidget.h>
 
+#include <QtCore/qhash.h>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -21,6 +23,41 @@ static QByteArrayList stringListToByteArray(const QStringList &l)
     return rc;
 }
 
+// Class declaring each method of a class, indexed by method index. Computing
+// it walks the superclasses for every method, which is slow for classes with
+// many methods and used to be repeated each time the signal/slot editor
+// listed the members of an object, so the tables are shared by class name.
+using DeclaringClassHash = QHash<QString, QStringList>;
+Q_GLOBAL_STATIC(DeclaringClassHash, declaringClassHash)
+
+static QStringList declaringClasses(const QDesignerMetaObjectInterface *meta)
+{
+    const QString className = meta->className();
+    const auto it = declaringClassHash()->constFind(className);
+    if (it != declaringClassHash()->constEnd())
+        return it.value();
+
+    const int count = meta->methodCount();
+    QStringList result;
+    result.reserve(count);
+    for (int index = 0; index < count; ++index) {
+        const QString member = meta->method(index)->signature();
+        // Find class whose superclass does not contain the method.
+        const QDesignerMetaObjectInterface *meta_obj = meta;
+        for (;;) {
+            const QDesignerMetaObjectInterface *tmp = meta_obj->superClass();
+            if (tmp == nullptr)
+                break;
+            if (tmp->indexOfMethod(member) == -1)
+                break;
+            meta_obj = tmp;
+        }
+        result.append(meta_obj->className());
+    }
+    declaringClassHash()->insert(className, result);
+    return result;
+}
+
 // ------------ QDesignerMemberSheetPrivate
 class QDesignerMemberSheetPrivate {
 public:
@@ -36,8 +73,10 @@ public:
     };
 
     Info &ensureInfo(int index);
+    const QStringList &declaringClasses();
 
     QHash<int, Info> m_info;
+    QStringList m_declaringClasses;
 };
 
 QDesignerMemberSheetPrivate::QDesignerMemberSheetPrivate(QObject *object, QObject *sheetParent) :
@@ -54,6 +93,13 @@ QDesignerMemberSheetPrivate::Info &QDesignerMemberSheetPrivate::ensureInfo(int i
     return it.value();
 }
 
+const QStringList &QDesignerMemberSheetPrivate::declaringClasses()
+{
+    if (m_declaringClasses.isEmpty())
+        m_declaringClasses = ::declaringClasses(m_meta);
+    return m_declaringClasses;
+}
+
 // --------- QDesignerMemberSheet
 
 QDesignerMemberSheet::QDesignerMemberSheet(QObject *object, QObject *parent) :
@@ -84,20 +130,7 @@ QString QDesignerMemberSheet::memberName(int index) const
 
 QString QDesignerMemberSheet::declaredInClass(int index) const
 {
-    const QString member = d->m_meta->method(index)->signature();
-
-    // Find class whose superclass does not contain the method.
-    const QDesignerMetaObjectInterface *meta_obj = d->m_meta;
-
-    for (;;) {
-        const QDesignerMetaObjectInterface *tmp = meta_obj->superClass();
-        if (tmp == nullptr)
-            break;
-        if (tmp->indexOfMethod(member) == -1)
-            break;
-        meta_obj = tmp;
-    }
-    return meta_obj->className();
+    return d->declaringClasses().value(index);
 }
 
 QString QDesignerMemberSheet::memberGroup(int index) const
@@ -142,7 +175,8 @@ bool QDesignerMemberSheet::isSlot(int index) const
 
 bool QDesignerMemberSheet::inheritedFromWidget(int index) const
 {
-    return declaredInClass(index) == "QWidget"_L1 || declaredInClass(index) == "QObject"_L1;
+    const QString declaringClass = declaredInClass(index);
+    return declaringClass == "QWidget"_L1 || declaringClass == "QObject"_L1;
 }
 
 
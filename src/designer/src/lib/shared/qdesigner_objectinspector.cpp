@@ -12,6 +12,12 @@ QDesignerObjectInspector::QDesignerObjectInspector(QWidget *parent, Qt::WindowFl
 {
 }
 
+void QDesignerObjectInspector::updateObjects(QDesignerFormWindowInterface *formWindow,
+                                             const QObjectList &)
+{
+    setFormWindow(formWindow);
+}
+
 void QDesignerObjectInspector::mainContainerChanged()
 {
 }
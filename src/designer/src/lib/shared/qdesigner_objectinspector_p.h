@@ -53,6 +53,9 @@ public:
     virtual bool selectObject(QObject *o) = 0;
     virtual void getSelection(Selection &s) const = 0;
     virtual void clearSelection() = 0;
+    // Update the entries of objects whose properties shown in the inspector
+    // changed. The default implementation calls setFormWindow().
+    virtual void updateObjects(QDesignerFormWindowInterface *formWindow, const QObjectList &objects);
 
 public slots:
     virtual void mainContainerChanged();
@@ -310,6 +310,8 @@ namespace qdesigner_internal {
 
         // Change the name in the data base and change all referencing objects in the meta database
         dbItem->setName(newClassName);
+        if (auto *wdb = qobject_cast<WidgetDataBase *>(widgetDataBase))
+            wdb->invalidateClassNameIndex();
         bool foundReferences = false;
         const QObjectList &dbObjects = metaDataBase->objects();
         for (QObject* object : dbObjects) {
@@ -5,6 +5,7 @@
 #include "qdesigner_utils_p.h"
 #include "dynamicpropertysheet.h"
 #include "qdesigner_propertyeditor_p.h"
+#include "qdesigner_objectinspector_p.h"
 #include "spacer_widget_p.h"
 #include "qdesigner_propertysheet_p.h"
 
@@ -18,6 +19,7 @@
 #include <QtDesigner/abstractobjectinspector.h>
 #include <QtDesigner/abstractintegration.h>
 #include <QtDesigner/abstractwidgetdatabase.h>
+#include <QtDesigner/container.h>
 #include <QtDesigner/qextensionmanager.h>
 
 #include <QtWidgets/qwidget.h>
@@ -1137,6 +1139,32 @@ unsigned PropertyListCommand::restoreDefaultValue()
                               RestoreDefaultFunction(formWindow()));
 }
 
+// The object whose row in the object inspector shows the name changed by
+// a property of \a object: the current page for the page name properties
+// of containers, the widget of a layout for the layout name.
+static QObject *renamedObject(QDesignerFormEditorInterface *core, QObject *object,
+                              SpecialProperty specialProperty)
+{
+    switch (specialProperty) {
+    case SP_CurrentTabName:
+    case SP_CurrentItemName:
+    case SP_CurrentPageName:
+        if (auto *container = qt_extension<QDesignerContainerExtension *>(core->extensionManager(), object)) {
+            const int index = container->currentIndex();
+            if (index >= 0 && index < container->count())
+                return container->widget(index);
+        }
+        break;
+    case SP_LayoutName:
+        if (auto *layout = qobject_cast<QLayout *>(object))
+            return layout->parentWidget();
+        break;
+    default:
+        break;
+    }
+    return nullptr;
+}
+
 // update
 void PropertyListCommand::update(unsigned updateMask)
 {
@@ -1144,8 +1172,19 @@ void PropertyListCommand::update(unsigned updateMask)
         qDebug() << "PropertyListCommand::update(" << updateMask << ')';
 
     if (updateMask & PropertyHelper::UpdateObjectInspector) {
-        if (QDesignerObjectInspectorInterface *oi = formWindow()->core()->objectInspector())
+        QDesignerObjectInspectorInterface *oi = formWindow()->core()->objectInspector();
+        if (auto *designerObjectInspector = qobject_cast<QDesignerObjectInspector *>(oi)) {
+            QDesignerFormEditorInterface *core = formWindow()->core();
+            QObjectList objects;
+            for (const auto &ph : m_propertyHelperList) {
+                objects.append(ph->object());
+                if (QObject *renamed = renamedObject(core, ph->object(), ph->specialProperty()))
+                    objects.append(renamed);
+            }
+            designerObjectInspector->updateObjects(formWindow(), objects);
+        } else if (oi) {
             oi->setFormWindow(formWindow());
+        }
     }
 
     if (updateMask & PropertyHelper::UpdatePropertyEditor) {
@@ -33,6 +33,8 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qhash.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -135,6 +137,55 @@ static const qdesigner_internal::DesignerMetaFlags &designerMetaFlagsFor(const Q
     return it.value();
 }
 
+// The data of the properties of a class, which is the same for all
+// property sheets of its objects and determined once per class.
+struct PropertySheetClassInfo
+{
+    struct Property
+    {
+        QString group;
+        QDesignerPropertySheet::PropertyType propertyType;
+        int type;
+    };
+
+    QString className;
+    QList<Property> properties;
+};
+
+static std::shared_ptr<const PropertySheetClassInfo>
+    propertySheetClassInfoFor(const QDesignerMetaObjectInterface *meta)
+{
+    static QHash<const QDesignerMetaObjectInterface *,
+                 std::shared_ptr<const PropertySheetClassInfo>> cache;
+
+    // The meta objects live as long as the introspection, check against reuse
+    // of the address by a later one.
+    const QString className = meta->className();
+    auto it = cache.find(meta);
+    if (it != cache.end() && it.value()->className == className)
+        return it.value();
+
+    const QDesignerMetaObjectInterface *baseMeta = meta;
+    while (baseMeta && baseMeta->className().startsWith("QDesigner"_L1))
+        baseMeta = baseMeta->superClass();
+    Q_ASSERT(baseMeta != nullptr);
+
+    auto info = std::make_shared<PropertySheetClassInfo>();
+    info->className = className;
+    const int count = meta->propertyCount();
+    info->properties.reserve(count);
+    for (int index = 0; index < count; ++index) {
+        const QDesignerMetaPropertyInterface *p = meta->property(index);
+        QString group = baseMeta->className();
+        if (const QDesignerMetaObjectInterface *pmeta = propertyIntroducedBy(baseMeta, index))
+            group = pmeta->className();
+        info->properties.append({group, QDesignerPropertySheet::propertyTypeFromName(p->name()),
+                                 p->type()});
+    }
+    cache.insert(meta, info);
+    return info;
+}
+
 // ------------ QDesignerMemberSheetPrivate
 class QDesignerPropertySheetPrivate {
 public:
@@ -190,6 +241,7 @@ public:
     };
 
     Info &ensureInfo(int index);
+    const Info &info(int index) const;
 
     QDesignerPropertySheet *q;
     QDesignerFormEditorInterface *m_core;
@@ -197,7 +249,7 @@ public:
     const ObjectType m_objectType;
     const ObjectFlags m_objectFlags;
 
-    QHash<int, Info> m_info;
+    QList<Info> m_info; // by property index
     QHash<int, QVariant> m_fakeProperties;
     QHash<int, QVariant> m_addProperties;
     QHash<QString, int> m_addIndex;
@@ -267,7 +319,7 @@ QVariant QDesignerPropertySheetPrivate::emptyResourceProperty(int index) const
 
 QVariant QDesignerPropertySheetPrivate::defaultResourceProperty(int index) const
 {
-    return m_info.value(index).defaultValue;
+    return info(index).defaultValue;
 }
 
 QVariant QDesignerPropertySheetPrivate::resourceProperty(int index) const
@@ -421,18 +473,21 @@ QLayout* QDesignerPropertySheetPrivate::layout(QDesignerPropertySheetExtension *
 
 QDesignerPropertySheetPrivate::Info &QDesignerPropertySheetPrivate::ensureInfo(int index)
 {
-    auto it = m_info.find(index);
-    if (it == m_info.end())
-        it = m_info.insert(index, Info());
-    return it.value();
+    Q_ASSERT(index >= 0);
+    if (index >= m_info.size())
+        m_info.resize(index + 1);
+    return m_info[index];
+}
+
+const QDesignerPropertySheetPrivate::Info &QDesignerPropertySheetPrivate::info(int index) const
+{
+    static const Info defaultInfo;
+    return index >= 0 && index < m_info.size() ? m_info.at(index) : defaultInfo;
 }
 
 QDesignerPropertySheet::PropertyType QDesignerPropertySheetPrivate::propertyType(int index) const
 {
-    const auto it = m_info.constFind(index);
-    if (it == m_info.constEnd())
-        return QDesignerPropertySheet::PropertyNone;
-    return it.value().propertyType;
+    return info(index).propertyType;
 }
 
 QString QDesignerPropertySheetPrivate::transformLayoutPropertyName(int index) const
@@ -540,12 +595,7 @@ QDesignerPropertySheet::QDesignerPropertySheet(QObject *object, QObject *parent)
     d(new QDesignerPropertySheetPrivate(this, object, parent))
 {
     using Info = QDesignerPropertySheetPrivate::Info;
-    const QDesignerMetaObjectInterface *baseMeta = d->m_meta;
-
-    while (baseMeta &&baseMeta->className().startsWith("QDesigner"_L1)) {
-        baseMeta = baseMeta->superClass();
-    }
-    Q_ASSERT(baseMeta != nullptr);
+    const std::shared_ptr<const PropertySheetClassInfo> classInfo = propertySheetClassInfoFor(d->m_meta);
 
     QDesignerFormWindowInterface *formWindow = QDesignerFormWindowInterface::findFormWindow(d->m_object);
     d->m_fwb = qobject_cast<qdesigner_internal::FormWindowBase *>(formWindow);
@@ -555,31 +605,25 @@ QDesignerPropertySheet::QDesignerPropertySheet(QObject *object, QObject *parent)
         d->m_fwb->addReloadablePropertySheet(this, object);
     }
 
+    d->m_info.resize(count());
     for (int index=0; index<count(); ++index) {
-        const QDesignerMetaPropertyInterface *p = d->m_meta->property(index);
-        const QString name = p->name();
-        if (p->type() == QMetaType::QKeySequence) {
-            createFakeProperty(name);
+        const PropertySheetClassInfo::Property &classProperty = classInfo->properties.at(index);
+        const int type = classProperty.type;
+        if (type == QMetaType::QKeySequence) {
+            createFakeProperty(d->m_meta->property(index)->name());
         } else {
             setVisible(index, false); // use the default for `real' properties
         }
 
-        QString pgroup = baseMeta->className();
-
-        if (const QDesignerMetaObjectInterface *pmeta = propertyIntroducedBy(baseMeta, index)) {
-            pgroup = pmeta->className();
-        }
-
         Info &info = d->ensureInfo(index);
-        info.group = pgroup;
-        info.propertyType = propertyTypeFromName(name);
+        info.group = classProperty.group;
+        info.propertyType = classProperty.propertyType;
 
-        const int type = p->type();
         switch (type) {
         case QMetaType::QCursor:
         case QMetaType::QIcon:
         case QMetaType::QPixmap:
-            info.defaultValue = p->read(d->m_object);
+            info.defaultValue = d->m_meta->property(index)->read(d->m_object);
             if (type == QMetaType::QIcon || type == QMetaType::QPixmap)
                 d->addResourceProperty(index, type);
             break;
@@ -728,8 +772,7 @@ int QDesignerPropertySheet::addDynamicProperty(const QString &propName, const QV
         setVisible(idx, true);
         d->m_addProperties.insert(idx, v);
         setChanged(idx, false);
-        const int index = d->m_meta->indexOfProperty(propName);
-        Info &info = d->ensureInfo(index);
+        Info &info = d->ensureInfo(idx);
         info.defaultValue = value;
         info.kind = QDesignerPropertySheetPrivate::DynamicProperty;
         switch (value.metaType().id()) {
@@ -828,14 +871,14 @@ bool QDesignerPropertySheet::isDynamicProperty(int index) const
     // if someone implements a property sheet only, omitting the dynamic sheet.
     if (index < 0 || index >= count())
         return false;
-    return d->m_info.value(index).kind == QDesignerPropertySheetPrivate::DynamicProperty;
+    return d->info(index).kind == QDesignerPropertySheetPrivate::DynamicProperty;
 }
 
 bool QDesignerPropertySheet::isDefaultDynamicProperty(int index) const
 {
     if (d->invalidIndex(Q_FUNC_INFO, index))
         return false;
-    return d->m_info.value(index).kind == QDesignerPropertySheetPrivate::DefaultDynamicProperty;
+    return d->info(index).kind == QDesignerPropertySheetPrivate::DefaultDynamicProperty;
 }
 
 bool QDesignerPropertySheet::isResourceProperty(int index) const
@@ -962,7 +1005,7 @@ QString QDesignerPropertySheet::propertyGroup(int index) const
 {
     if (d->invalidIndex(Q_FUNC_INFO, index))
         return QString();
-    const QString g = d->m_info.value(index).group;
+    const QString g = d->info(index).group;
 
     if (!g.isEmpty())
         return g;
@@ -1234,7 +1277,7 @@ bool QDesignerPropertySheet::hasReset(int index) const
     if (d->invalidIndex(Q_FUNC_INFO, index))
         return false;
     if (isAdditionalProperty(index))
-        return d->m_info.value(index).reset;
+        return d->info(index).reset;
     return true;
 }
 
@@ -1270,7 +1313,7 @@ bool QDesignerPropertySheet::reset(int index)
     if (isDynamic(index)) {
         const QString propName = propertyName(index);
         const QVariant oldValue = d->m_addProperties.value(index);
-        const QVariant defaultValue = d->m_info.value(index).defaultValue;
+        const QVariant defaultValue = d->info(index).defaultValue;
         QVariant newValue = defaultValue;
         if (d->isStringProperty(index)) {
             newValue = QVariant::fromValue(qdesigner_internal::PropertySheetStringValue(newValue.toString()));
@@ -1285,8 +1328,8 @@ bool QDesignerPropertySheet::reset(int index)
         d->m_object->setProperty(propName.toUtf8(), defaultValue);
         d->m_addProperties[index] = newValue;
         return true;
-    } else if (!d->m_info.value(index).defaultValue.isNull()) {
-        setProperty(index, d->m_info.value(index).defaultValue);
+    } else if (!d->info(index).defaultValue.isNull()) {
+        setProperty(index, d->info(index).defaultValue);
         return true;
     }
     if (isAdditionalProperty(index)) {
@@ -1384,7 +1427,7 @@ bool QDesignerPropertySheet::isChanged(int index) const
             }
         }
     }
-    return d->m_info.value(index).changed;
+    return d->info(index).changed;
 }
 
 void QDesignerPropertySheet::setChanged(int index, bool changed)
@@ -1496,21 +1539,21 @@ bool QDesignerPropertySheet::isVisible(int index) const
             }
             return true;
         }
-        return d->m_info.value(index).visible;
+        return d->info(index).visible;
     }
 
     if (isFakeProperty(index)) {
         switch (type) {
         case PropertyWindowModality: // Hidden for child widgets
         case PropertyWindowOpacity:
-            return d->m_info.value(index).visible;
+            return d->info(index).visible;
         default:
             break;
         }
         return true;
     }
 
-    const bool visible = d->m_info.value(index).visible;
+    const bool visible = d->info(index).visible;
     switch (type) {
     case PropertyWindowTitle:
     case PropertyWindowIcon:
@@ -1556,7 +1599,7 @@ bool QDesignerPropertySheet::isEnabled(int index) const
         return !isManaged || lt == qdesigner_internal::LayoutInfo::NoLayout;
     }
 
-    if (d->m_info.value(index).visible)
+    if (d->info(index).visible)
         return true;
 
     // Enable setting of properties for statically non-designable properties
@@ -1580,12 +1623,12 @@ bool QDesignerPropertySheet::isAttribute(int index) const
     if (d->invalidIndex(Q_FUNC_INFO, index))
         return false;
     if (isAdditionalProperty(index))
-        return d->m_info.value(index).attribute;
+        return d->info(index).attribute;
 
     if (isFakeProperty(index))
         return false;
 
-    return d->m_info.value(index).attribute;
+    return d->info(index).attribute;
 }
 
 void QDesignerPropertySheet::setAttribute(int index, bool attribute)
@@ -13,10 +13,20 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qbuffer.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
 #include <QtCore/qfilesystemwatcher.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qthreadpool.h>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 enum { debugResourceModel = 0 };
 
 // ------------------- QtResourceSetPrivate
@@ -36,6 +46,177 @@ QtResourceSetPrivate::QtResourceSetPrivate(QtResourceModel *model) :
 {
 }
 
+// -------------------- QtCompiledResource
+// A compiled .qrc file. It is registered from its file in the cache
+// directory, which the resource system maps into memory, or from the data
+// if it could not be written there.
+struct QtCompiledResource
+{
+    QString fileName;
+    QByteArray data;
+
+    bool registerResource() const
+    {
+        return fileName.isEmpty()
+            ? QResource::registerResource(reinterpret_cast<const uchar *>(data.constData()))
+            : QResource::registerResource(fileName);
+    }
+
+    bool unregisterResource() const
+    {
+        return fileName.isEmpty()
+            ? QResource::unregisterResource(reinterpret_cast<const uchar *>(data.constData()))
+            : QResource::unregisterResource(fileName);
+    }
+};
+
+// The result of compiling one .qrc file on the thread pool.
+struct QtResourceCompilation
+{
+    QString path;
+    const QtCompiledResource *resource = nullptr;
+    QStringList contents;
+    int errorCount = -1;
+    QByteArray errors;
+};
+
+// -------------------- The cache of compiled resources
+// The compiled .qrc files are kept in the cache directory, together with
+// the modification times of the .qrc file and of the files it lists, so
+// that they are only compiled again when one of them changed.
+static const quint32 resourceCacheMagic = 0x51524343; // "QRCC"
+static const quint32 resourceCacheVersion = 1;
+
+using QtResourceDependencies = QList<std::pair<QString, qint64>>;
+
+static QString resourceCacheDirectory()
+{
+    static const QString directory = [] {
+        const QString location = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (location.isEmpty())
+            return QString();
+        const QString path = location + "/rcc"_L1;
+        return QDir().mkpath(path) ? path : QString();
+    }();
+    return directory;
+}
+
+static QString resourceCacheKey(const QString &path)
+{
+    const QByteArray absolutePath = QFileInfo(path).absoluteFilePath().toUtf8();
+    return QString::fromLatin1(QCryptographicHash::hash(absolutePath, QCryptographicHash::Sha1).toHex());
+}
+
+static qint64 lastModified(const QString &path)
+{
+    const QFileInfo fileInfo(path);
+    return fileInfo.exists() ? fileInfo.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+static QtResourceDependencies resourceDependencies(const QString &path, const QStringList &dataFiles)
+{
+    QtResourceDependencies dependencies;
+    dependencies.append({path, lastModified(path)});
+    // The directories as well, for files added to directories listed in the .qrc file.
+    QStringList directories;
+    for (const QString &dataFile : dataFiles) {
+        dependencies.append({dataFile, lastModified(dataFile)});
+        const QString directory = QFileInfo(dataFile).path();
+        if (!directories.contains(directory))
+            directories.append(directory);
+    }
+    for (const QString &directory : std::as_const(directories))
+        dependencies.append({directory, lastModified(directory)});
+    return dependencies;
+}
+
+static QtCompiledResource *cachedResource(const QString &path, QStringList *contents)
+{
+    const QString directory = resourceCacheDirectory();
+    if (directory.isEmpty())
+        return nullptr;
+    QFile file(directory + u'/' + resourceCacheKey(path) + ".deps"_L1);
+    if (!file.open(QIODevice::ReadOnly))
+        return nullptr;
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString storedPath;
+    QString fileName;
+    QStringList storedContents;
+    QtResourceDependencies dependencies;
+    stream >> magic >> version;
+    if (magic != resourceCacheMagic || version != resourceCacheVersion)
+        return nullptr;
+    stream >> storedPath >> fileName >> storedContents >> dependencies;
+    if (stream.status() != QDataStream::Ok || storedPath != path || !QFile::exists(fileName))
+        return nullptr;
+    for (const auto &dependency : std::as_const(dependencies)) {
+        if (lastModified(dependency.first) != dependency.second)
+            return nullptr;
+    }
+
+    *contents = storedContents;
+    return new QtCompiledResource{fileName, {}};
+}
+
+// Moves the data of resource to a file in the cache directory.
+static void storeResource(const QString &path, QtCompiledResource *resource,
+                          const QStringList &contents, const QStringList &dataFiles)
+{
+    const QString directory = resourceCacheDirectory();
+    if (directory.isEmpty())
+        return;
+    const QString key = resourceCacheKey(path);
+    // A new name each time, since the previous file may still be registered.
+    const QString fileName = directory + u'/' + key + u'-'
+            + QString::number(QDateTime::currentMSecsSinceEpoch(), 16) + ".rcc"_L1;
+
+    QSaveFile dataFile(fileName);
+    if (!dataFile.open(QIODevice::WriteOnly) || dataFile.write(resource->data) != resource->data.size()
+        || !dataFile.commit()) {
+        return;
+    }
+
+    QSaveFile depsFile(directory + u'/' + key + ".deps"_L1);
+    QString previousFileName;
+    {
+        QFile previous(depsFile.fileName());
+        if (previous.open(QIODevice::ReadOnly)) {
+            QDataStream stream(&previous);
+            stream.setVersion(QDataStream::Qt_6_0);
+            quint32 magic = 0;
+            quint32 version = 0;
+            QString storedPath;
+            stream >> magic >> version >> storedPath >> previousFileName;
+            if (magic != resourceCacheMagic || version != resourceCacheVersion)
+                previousFileName.clear();
+        }
+    }
+    if (!depsFile.open(QIODevice::WriteOnly)) {
+        QFile::remove(fileName);
+        return;
+    }
+    QDataStream stream(&depsFile);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << resourceCacheMagic << resourceCacheVersion << path << fileName << contents
+           << resourceDependencies(path, dataFiles);
+    if (stream.status() != QDataStream::Ok || !depsFile.commit()) {
+        QFile::remove(fileName);
+        return;
+    }
+
+    // This fails if the previous file is still mapped on some platforms,
+    // which only leaves it behind.
+    if (!previousFileName.isEmpty() && previousFileName != fileName)
+        QFile::remove(previousFileName);
+
+    resource->fileName = fileName;
+    resource->data.clear();
+}
+
 // -------------------- QtResourceModelPrivate
 class QtResourceModelPrivate
 {
@@ -58,7 +239,7 @@ public:
     QMap<QString, QList<QtResourceSet *>> m_pathToResourceSet;
     QtResourceSet                         *m_currentResourceSet = nullptr;
 
-    QMap<QString, const QByteArray *> m_pathToData;
+    QMap<QString, const QtCompiledResource *> m_pathToData;
 
     QMap<QString, QStringList> m_pathToContents; // qrc path to its contents.
     QMap<QString, QString>     m_fileToQrc; // this map contains the content of active resource set only.
@@ -76,8 +257,8 @@ private:
 
     void slotFileChanged(const QString &);
 
-    const QByteArray *createResource(const QString &path, QStringList *contents, int *errorCount, QIODevice &errorDevice) const;
-    void deleteResource(const QByteArray *data) const;
+    static void createResource(QtResourceCompilation *compilation);
+    void deleteResource(const QtCompiledResource *data) const;
 };
 
 QtResourceModelPrivate::QtResourceModelPrivate() = default;
@@ -119,10 +300,24 @@ void QtResourceSet::setModified(const QString &path)
 }
 
 // ------------------- QtResourceModelPrivate
-const QByteArray *QtResourceModelPrivate::createResource(const QString &path, QStringList *contents, int *errorCount, QIODevice &errorDevice) const
+// Called on the threads of the thread pool.
+void QtResourceModelPrivate::createResource(QtResourceCompilation *compilation)
 {
     using ResourceDataFileMap = RCCResourceLibrary::ResourceDataFileMap;
-    const QByteArray *rc = nullptr;
+    const QString &path = compilation->path;
+    QtCompiledResource *rc = cachedResource(path, &compilation->contents);
+    if (rc) {
+        compilation->errorCount = 0;
+        compilation->resource = rc;
+        if (debugResourceModel)
+            qDebug() << "createResource" << path << "from cache" << rc->fileName;
+        return;
+    }
+
+    QBuffer errorDevice(&compilation->errors);
+    errorDevice.open(QIODevice::WriteOnly);
+    int *errorCount = &compilation->errorCount;
+    QStringList *contents = &compilation->contents;
     *errorCount = -1;
     contents->clear();
     do {
@@ -148,15 +343,19 @@ const QByteArray *QtResourceModelPrivate::createResource(const QString &path, QS
             break;
 
         buffer.close();
-        rc = new QByteArray(buffer.data());
+        rc = new QtCompiledResource{{}, buffer.data()};
+        // Only complete results are cached, so that the errors are
+        // reported again.
+        if (*errorCount == 0)
+            storeResource(path, rc, *contents, library.dataFiles());
     } while (false);
 
     if (debugResourceModel)
         qDebug() << "createResource" << path << "returns data=" << rc << " hasWarnings=" << *errorCount;
-    return rc;
+    compilation->resource = rc;
 }
 
-void QtResourceModelPrivate::deleteResource(const QByteArray *data) const
+void QtResourceModelPrivate::deleteResource(const QtCompiledResource *data) const
 {
     if (data) {
         if (debugResourceModel)
@@ -177,9 +376,9 @@ void QtResourceModelPrivate::registerResourceSet(QtResourceSet *resourceSet)
             qDebug() << "registerResourceSet " << path;
         const auto itRcc = m_pathToData.constFind(path);
         if (itRcc != m_pathToData.constEnd()) { // otherwise data was not created yet
-            const QByteArray *data = itRcc.value();
+            const QtCompiledResource *data = itRcc.value();
             if (data) {
-                if (!QResource::registerResource(reinterpret_cast<const uchar *>(data->constData()))) {
+                if (!data->registerResource()) {
                     qWarning() << "** WARNING: Failed to register " << path << " (QResource failure).";
                 } else {
                     const QStringList contents = m_pathToContents.value(path);
@@ -205,9 +404,9 @@ void QtResourceModelPrivate::unregisterResourceSet(QtResourceSet *resourceSet)
             qDebug() << "unregisterResourceSet " << path;
         const auto itRcc = m_pathToData.constFind(path);
         if (itRcc != m_pathToData.constEnd()) { // otherwise data was not created yet
-            const QByteArray *data = itRcc.value();
+            const QtCompiledResource *data = itRcc.value();
             if (data) {
-                if (!QResource::unregisterResource(reinterpret_cast<const uchar *>(itRcc.value()->constData())))
+                if (!data->unregisterResource())
                     qWarning() << "** WARNING: Failed to unregister " << path << " (QResource failure).";
             }
         }
@@ -236,15 +435,39 @@ void QtResourceModelPrivate::activate(QtResourceSet *resourceSet, const QStringL
 
     auto newPathToData = m_pathToData;
 
+    // Compile the new and modified paths in parallel (or take them from
+    // the cache), large resources take long.
+    QList<QtResourceCompilation> compilations;
+    for (const QString &path : newPaths) {
+        const auto itMod = m_pathToModified.constFind(path);
+        const bool needsCompilation = itMod == m_pathToModified.cend() || itMod.value();
+        const bool listed = std::any_of(compilations.cbegin(), compilations.cend(),
+                                        [&path](const QtResourceCompilation &c) { return c.path == path; });
+        if (needsCompilation && !listed)
+            compilations.append({path, nullptr, {}, -1, {}});
+    }
+    if (compilations.size() == 1) {
+        createResource(&compilations.first());
+    } else if (!compilations.isEmpty()) {
+        QThreadPool pool;
+        for (QtResourceCompilation &compilation : compilations)
+            pool.start([&compilation] { createResource(&compilation); });
+        pool.waitForDone();
+    }
+
     for (const QString &path : newPaths) {
         if (resourceSet && !m_pathToResourceSet[path].contains(resourceSet))
             m_pathToResourceSet[path].append(resourceSet);
         const auto itMod = m_pathToModified.find(path);
         if (itMod == m_pathToModified.end() || itMod.value()) { // new path or path is already created, but needs to be recreated
-            QStringList contents;
-            int qrcErrorCount;
+            const auto itCompilation = std::find_if(compilations.cbegin(), compilations.cend(),
+                                                    [&path](const QtResourceCompilation &c) { return c.path == path; });
+            Q_ASSERT(itCompilation != compilations.cend());
+            const QStringList &contents = itCompilation->contents;
+            const int qrcErrorCount = itCompilation->errorCount;
+            const QtCompiledResource *data = itCompilation->resource;
+            errorStream.write(itCompilation->errors);
             generatedCount++;
-            const QByteArray *data = createResource(path, &contents, &qrcErrorCount, errorStream);
 
             newPathToData.insert(path, data);
             if (qrcErrorCount) // Count single failed files as sort of 1/2 error
@@ -270,8 +493,8 @@ void QtResourceModelPrivate::activate(QtResourceSet *resourceSet, const QStringL
     const auto oldData = m_pathToData.values();
     const auto newData = newPathToData.values();
 
-    QList<const QByteArray *> toDelete;
-    for (const QByteArray *array : oldData) {
+    QList<const QtCompiledResource *> toDelete;
+    for (const QtCompiledResource *array : oldData) {
         if (array && !newData.contains(array))
             toDelete.append(array);
     }
@@ -310,7 +533,7 @@ void QtResourceModelPrivate::activate(QtResourceSet *resourceSet, const QStringL
     }
 
     if (!newResourceSetChanged && !needReregister && (m_currentResourceSet == resourceSet)) {
-        for (const QByteArray *data : std::as_const(toDelete))
+        for (const QtCompiledResource *data : std::as_const(toDelete))
             deleteResource(data);
 
         return; // nothing changed
@@ -319,7 +542,7 @@ void QtResourceModelPrivate::activate(QtResourceSet *resourceSet, const QStringL
     if (needReregister)
         unregisterResourceSet(m_currentResourceSet);
 
-    for (const QByteArray *data : std::as_const(toDelete))
+    for (const QtCompiledResource *data : std::as_const(toDelete))
         deleteResource(data);
 
     m_pathToData = newPathToData;
@@ -33,6 +33,8 @@ static constexpr auto formTemplatePathsKey = "FormTemplatePaths"_L1;
 static constexpr auto formTemplateKey = "FormTemplate"_L1;
 static constexpr auto newFormSizeKey = "NewFormSize"_L1;
 static constexpr auto namingModeKey = "naming"_L1;
+static constexpr auto undoLimitKey = "UndoLimit"_L1;
+static constexpr int defaultUndoLimit = 1000;
 static constexpr auto underScoreNamingMode = "underscore"_L1;
 static constexpr auto camelCaseNamingMode =  "camelcase"_L1;
 
@@ -237,6 +239,16 @@ void QDesignerSharedSettings::setObjectNamingMode(ObjectNamingMode n)
     m_settings->setValue(namingModeKey, QVariant(value));
 }
 
+int QDesignerSharedSettings::undoLimit() const
+{
+    return qMax(0, m_settings->value(undoLimitKey, defaultUndoLimit).toInt());
+}
+
+void QDesignerSharedSettings::setUndoLimit(int limit)
+{
+    m_settings->setValue(undoLimitKey, limit);
+}
+
 bool QDesignerSharedSettings::zoomEnabled() const
 {
     return m_settings->value(zoomEnabledKey, false).toBool();
@@ -82,6 +82,10 @@ public:
     ObjectNamingMode objectNamingMode() const;
     void setObjectNamingMode(ObjectNamingMode n);
 
+    // Maximum number of commands kept in the undo stack of a form, 0 for unlimited
+    int undoLimit() const;
+    void setUndoLimit(int limit);
+
     // Embedded Design
     DeviceProfile currentDeviceProfile() const;
     void setCurrentDeviceProfileIndex(int i);
@@ -351,7 +351,38 @@ int WidgetDataBase::indexOfObject(QObject *object, bool /*resolveName*/) const
     if (id.isEmpty())
         id = WidgetFactory::classNameOf(m_core,object);
 
-    return QDesignerWidgetDataBaseInterface::indexOfClassName(id);
+    return indexOfClassName(id);
+}
+
+int WidgetDataBase::indexOfClassName(const QString &className, bool) const
+{
+    if (m_classNameIndex.isEmpty()) {
+        m_classNameIndex.reserve(m_items.size());
+        for (qsizetype i = 0, count = m_items.size(); i < count; ++i)
+            m_classNameIndex.try_emplace(m_items.at(i)->name(), int(i));
+    }
+    const auto it = m_classNameIndex.constFind(className);
+    if (it == m_classNameIndex.cend())
+        return -1;
+    // Guard against items renamed without invalidateClassNameIndex()
+    const int index = it.value();
+    if (index < m_items.size() && m_items.at(index)->name() == className)
+        return index;
+    m_classNameIndex.clear();
+    return QDesignerWidgetDataBaseInterface::indexOfClassName(className);
+}
+
+void WidgetDataBase::insert(int index, QDesignerWidgetDataBaseItemInterface *item)
+{
+    QDesignerWidgetDataBaseInterface::insert(index, item);
+    invalidateClassNameIndex();
+}
+
+void WidgetDataBase::append(QDesignerWidgetDataBaseItemInterface *item)
+{
+    QDesignerWidgetDataBaseInterface::append(item);
+    if (!m_classNameIndex.isEmpty())
+        m_classNameIndex.try_emplace(item->name(), int(m_items.size() - 1));
 }
 
 static WidgetDataBaseItem *createCustomWidgetItem(const QDesignerCustomWidgetInterface *c,
@@ -411,6 +442,7 @@ void WidgetDataBase::loadPlugins()
                 const auto existingIndex = existingIt.value();
                 delete m_items[existingIndex];
                 m_items[existingIndex] = pluginItem;
+                invalidateClassNameIndex();
                 existingCustomClasses.erase(existingIt);
                 replacedPlugins++;
 
@@ -434,6 +466,7 @@ void WidgetDataBase::remove(int index)
 {
     Q_ASSERT(index < m_items.size());
     delete m_items.takeAt(index);
+    invalidateClassNameIndex();
 }
 
 QList<QVariant> WidgetDataBase::defaultPropertyValues(const QString &name)
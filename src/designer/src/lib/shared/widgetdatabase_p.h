@@ -23,6 +23,7 @@
 #include <QtGui/qicon.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qvariant.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qstringlist.h>
 
@@ -130,9 +131,15 @@ public:
     QDesignerFormEditorInterface *core() const override;
 
     int indexOfObject(QObject *o, bool resolveName = true) const override;
+    int indexOfClassName(const QString &className, bool resolveName = true) const override;
 
+    void insert(int index, QDesignerWidgetDataBaseItemInterface *item) override;
+    void append(QDesignerWidgetDataBaseItemInterface *item) override;
     void remove(int index);
 
+    // Call after changing the name of an item.
+    void invalidateClassNameIndex() { m_classNameIndex.clear(); }
+
 
     void grabDefaultPropertyValues();
     void grabStandardWidgetBoxIcons();
@@ -152,6 +159,8 @@ private:
     QList<QVariant> defaultPropertyValues(const QString &name);
 
     QDesignerFormEditorInterface *m_core;
+    // Index of the first item of each class name, created on demand
+    mutable QHash<QString, int> m_classNameIndex;
 };
 
 QDESIGNER_SHARED_EXPORT QDesignerWidgetDataBaseItemInterface
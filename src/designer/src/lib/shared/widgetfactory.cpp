@@ -22,6 +22,8 @@
 #include "layout_p.h"
 #include "abstractintrospection_p.h"
 
+#include <QtDesigner/private/formbuilderextra_p.h>
+
 // sdk
 #include <QtDesigner/abstractformeditor.h>
 #include <QtDesigner/container.h>
@@ -386,26 +388,10 @@ QWidget *WidgetFactory::createWidget(const QString &widgetName, QWidget *parentW
             break;
 
         // 3) table
-        const QByteArray widgetNameBA = widgetName.toUtf8();
-        const char *widgetNameC = widgetNameBA.constData();
-
-        if (w) { // symmetry for macro
-        }
-
-#define DECLARE_LAYOUT(L, C)
-#define DECLARE_COMPAT_WIDGET(W, C) /*DECLARE_WIDGET(W, C)*/
-#define DECLARE_WIDGET(W, C) else if (!qstrcmp(widgetNameC, #W)) { Q_ASSERT(w == 0); w = new W(parentWidget); }
-#define DECLARE_WIDGET_1(W, C) else if (!qstrcmp(widgetNameC, #W)) { Q_ASSERT(w == 0); w = new W(0, parentWidget); }
-
-#include <widgets.table>
-
-#undef DECLARE_COMPAT_WIDGET
-#undef DECLARE_LAYOUT
-#undef DECLARE_WIDGET
-#undef DECLARE_WIDGET_1
-
-        if (w)
+        if (const auto constructor = QFormBuilderExtra::widgetConstructor(widgetName)) {
+            w = constructor(parentWidget);
             break;
+        }
         // 4) fallBack
         const QString fallBackBaseClass = "QWidget"_L1;
         QDesignerWidgetDataBaseInterface *db = core()->widgetDataBase();
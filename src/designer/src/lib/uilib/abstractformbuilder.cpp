@@ -867,7 +867,7 @@ void QAbstractFormBuilder::applyProperties(QObject *o, const QList<DomProperty*>
             if (attributeName == "numDigits"_L1 && o->inherits("QLCDNumber")) // Deprecated in Qt 4, removed in Qt 5.
                 attributeName = u"digitCount"_s;
             if (!d->applyPropertyInternally(o, attributeName, v))
-                o->setProperty(attributeName.toUtf8(), v);
+                setObjectProperty(o, attributeName, v);
         }
     }
 }
@@ -2360,6 +2360,40 @@ void QAbstractFormBuilder::setWorkingDirectory(const QDir &directory)
     d->m_workingDirectory = directory;
 }
 
+/*!
+    \since 6.10
+
+    If \a enabled is true, the icons that the form builder loads from
+    files and from the icon theme are kept in a cache. The cache is shared
+    by all form builders and holds up to 256 icons. Forms that use the
+    same icons then share them instead of reading their files again.
+
+    Only enable the cache if the icon files and resources do not change
+    while the application runs, since forms loaded afterwards would still
+    show the icons read before.
+
+    The cache is disabled by default.
+
+    \sa isIconCacheEnabled()
+*/
+void QAbstractFormBuilder::setIconCacheEnabled(bool enabled)
+{
+    d->setIconCacheEnabled(enabled);
+}
+
+/*!
+    \since 6.10
+
+    Returns true if the form builder keeps the icons it loads in a cache;
+    otherwise returns false.
+
+    \sa setIconCacheEnabled()
+*/
+bool QAbstractFormBuilder::isIconCacheEnabled() const
+{
+    return d->isIconCacheEnabled();
+}
+
 /*!
     \internal
 */
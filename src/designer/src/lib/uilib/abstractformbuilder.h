@@ -88,6 +88,9 @@ public:
 
     QString errorString() const;
 
+    void setIconCacheEnabled(bool enabled);
+    bool isIconCacheEnabled() const;
+
 protected:
 //
 // load
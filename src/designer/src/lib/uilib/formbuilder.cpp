@@ -3,6 +3,7 @@
 
 #include "formbuilder.h"
 #include "formbuilderextra_p.h"
+#include "properties_p.h"
 #include "ui4_p.h"
 
 #include <QtUiPlugin/customwidget.h>
@@ -153,25 +154,10 @@ QWidget *QFormBuilder::createWidget(const QString &widgetName, QWidget *parentWi
             static_cast<QFrame*>(w)->setFrameStyle(QFrame::HLine | QFrame::Sunken);
             break;
         }
-        const QByteArray widgetNameBA = widgetName.toUtf8();
-        const char *widgetNameC = widgetNameBA.constData();
-        if (w) { // symmetry for macro
-        }
-
-#define DECLARE_LAYOUT(L, C)
-#define DECLARE_COMPAT_WIDGET(W, C)
-#define DECLARE_WIDGET(W, C) else if (!qstrcmp(widgetNameC, #W)) { Q_ASSERT(w == 0); w = new W(parentWidget); }
-#define DECLARE_WIDGET_1(W, C) else if (!qstrcmp(widgetNameC, #W)) { Q_ASSERT(w == 0); w = new W(0, parentWidget); }
-
-#include "widgets.table"
-
-#undef DECLARE_COMPAT_WIDGET
-#undef DECLARE_LAYOUT
-#undef DECLARE_WIDGET
-#undef DECLARE_WIDGET_1
-
-        if (w)
+        if (const auto constructor = QFormBuilderExtra::widgetConstructor(widgetName)) {
+            w = constructor(parentWidget);
             break;
+        }
 
         // try with a registered custom widget
         QDesignerCustomWidgetInterface *factory = d->m_customWidgets.value(widgetName);
@@ -429,8 +415,14 @@ void QFormBuilder::updateCustomWidgets()
                 continue;
 
             QPluginLoader loader(path + u'/' + plugin);
-            if (loader.load())
+            const auto lazyCustomWidgets =
+                QFormBuilderExtra::lazyCustomWidgets(loader.fileName(), loader.metaData());
+            if (!lazyCustomWidgets.isEmpty()) {
+                for (QDesignerCustomWidgetInterface *iface : lazyCustomWidgets)
+                    d->m_customWidgets.insert(iface->name(), iface);
+            } else if (loader.load()) {
                 insertPlugins(loader.instance(), &d->m_customWidgets);
+            }
         }
     }
 #endif // QT_CONFIG(library)
@@ -477,7 +469,7 @@ void QFormBuilder::applyProperties(QObject *o, const QList<DomProperty*> &proper
             // ### special-casing for Line (QFrame) -- try to fix me
             o->setProperty("frameShape", v); // v is of QFrame::Shape enum
         } else {
-            o->setProperty(attributeName.toUtf8(), v);
+            setObjectProperty(o, attributeName, v);
         }
     }
 }
@@ -8,18 +8,166 @@
 #include "textbuilder_p.h"
 #include "ui4_p.h"
 
-#include <QtWidgets/qlabel.h>
+#include <QtUiPlugin/customwidget.h>
+
 #include <QtWidgets/qboxlayout.h>
+#include <QtWidgets/qdialog.h>
+#include <QtWidgets/qdialogbuttonbox.h>
+#include <QtWidgets/qframe.h>
 #include <QtWidgets/qgridlayout.h>
+#include <QtWidgets/qlabel.h>
+#include <QtWidgets/qwidget.h>
+
+// The widgets of widgets.table
+#if QT_CONFIG(abstractslider)
+#  include <QtWidgets/qabstractslider.h>
+#endif
+#if QT_CONFIG(calendarwidget)
+#  include <QtWidgets/qcalendarwidget.h>
+#endif
+#if QT_CONFIG(checkbox)
+#  include <QtWidgets/qcheckbox.h>
+#endif
+#if QT_CONFIG(columnview)
+#  include <QtWidgets/qcolumnview.h>
+#endif
+#if QT_CONFIG(combobox)
+#  include <QtWidgets/qcombobox.h>
+#endif
+#if QT_CONFIG(commandlinkbutton)
+#  include <QtWidgets/qcommandlinkbutton.h>
+#endif
+#if QT_CONFIG(datetimeedit)
+#  include <QtWidgets/qdatetimeedit.h>
+#endif
+#if QT_CONFIG(dial)
+#  include <QtWidgets/qdial.h>
+#endif
+#if QT_CONFIG(dockwidget)
+#  include <QtWidgets/qdockwidget.h>
+#endif
+#if QT_CONFIG(fontcombobox)
+#  include <QtWidgets/qfontcombobox.h>
+#endif
+#if !defined(QT_NO_GRAPHICSVIEW)
+#  include <QtWidgets/qgraphicsview.h>
+#endif
+#if QT_CONFIG(groupbox)
+#  include <QtWidgets/qgroupbox.h>
+#endif
+#if QT_CONFIG(keysequenceedit)
+#  include <QtWidgets/qkeysequenceedit.h>
+#endif
+#if QT_CONFIG(lcdnumber)
+#  include <QtWidgets/qlcdnumber.h>
+#endif
+#if QT_CONFIG(lineedit)
+#  include <QtWidgets/qlineedit.h>
+#endif
+#if QT_CONFIG(listview)
+#  include <QtWidgets/qlistview.h>
+#endif
+#if QT_CONFIG(listwidget)
+#  include <QtWidgets/qlistwidget.h>
+#endif
+#if QT_CONFIG(mainwindow)
+#  include <QtWidgets/qmainwindow.h>
+#endif
+#if QT_CONFIG(mdiarea)
+#  include <QtWidgets/qmdiarea.h>
+#endif
+#if QT_CONFIG(menu)
+#  include <QtWidgets/qmenu.h>
+#endif
+#if QT_CONFIG(menubar)
+#  include <QtWidgets/qmenubar.h>
+#endif
+#if QT_CONFIG(progressbar)
+#  include <QtWidgets/qprogressbar.h>
+#endif
+#if QT_CONFIG(pushbutton)
+#  include <QtWidgets/qpushbutton.h>
+#endif
+#if QT_CONFIG(radiobutton)
+#  include <QtWidgets/qradiobutton.h>
+#endif
+#if QT_CONFIG(scrollarea)
+#  include <QtWidgets/qabstractscrollarea.h>
+#  include <QtWidgets/qscrollarea.h>
+#endif
+#if QT_CONFIG(scrollbar)
+#  include <QtWidgets/qscrollbar.h>
+#endif
+#if QT_CONFIG(slider)
+#  include <QtWidgets/qslider.h>
+#endif
+#if QT_CONFIG(spinbox)
+#  include <QtWidgets/qabstractspinbox.h>
+#  include <QtWidgets/qspinbox.h>
+#endif
+#if QT_CONFIG(splitter)
+#  include <QtWidgets/qsplitter.h>
+#endif
+#if QT_CONFIG(stackedwidget)
+#  include <QtWidgets/qstackedwidget.h>
+#endif
+#if QT_CONFIG(statusbar)
+#  include <QtWidgets/qstatusbar.h>
+#endif
+#if QT_CONFIG(tableview)
+#  include <QtWidgets/qtableview.h>
+#endif
+#if QT_CONFIG(tablewidget)
+#  include <QtWidgets/qtablewidget.h>
+#endif
+#if QT_CONFIG(tabwidget)
+#  include <QtWidgets/qtabwidget.h>
+#endif
+#if QT_CONFIG(textbrowser)
+#  include <QtWidgets/qtextbrowser.h>
+#endif
+#if QT_CONFIG(textedit)
+#  include <QtWidgets/qplaintextedit.h>
+#  include <QtWidgets/qtextedit.h>
+#endif
+#if QT_CONFIG(toolbar)
+#  include <QtWidgets/qtoolbar.h>
+#endif
+#if QT_CONFIG(toolbox)
+#  include <QtWidgets/qtoolbox.h>
+#endif
+#if QT_CONFIG(toolbutton)
+#  include <QtWidgets/qtoolbutton.h>
+#endif
+#if QT_CONFIG(treeview)
+#  include <QtWidgets/qtreeview.h>
+#endif
+#if QT_CONFIG(treewidget)
+#  include <QtWidgets/qtreewidget.h>
+#endif
+#if QT_CONFIG(undoview)
+#  include <QtWidgets/qundoview.h>
+#endif
+#if QT_CONFIG(wizard)
+#  include <QtWidgets/qwizard.h>
+#endif
+#ifdef QT_OPENGLWIDGETS_LIB
+#  include <QtOpenGLWidgets/qopenglwidget.h>
+#endif
 
 #include <QtCore/qvariant.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qtextstream.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qpluginloader.h>
 #include <QtCore/qversionnumber.h>
 
 #include <limits.h>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -125,28 +273,202 @@ static bool inline readUiAttributes(QXmlStreamReader &reader, const QString &lan
 
 DomUI *QFormBuilderExtra::readUi(QIODevice *dev)
 {
-    QXmlStreamReader reader(dev);
-    m_errorString.clear();
-    if (!readUiAttributes(reader, m_language, &m_errorString)) {
+    DomUI *ui = readUi(dev, m_language, &m_errorString);
+    if (ui == nullptr)
         uiLibWarning(m_errorString);
+    return ui;
+}
+
+// Does not issue warnings, so that forms can be read on worker threads.
+DomUI *QFormBuilderExtra::readUi(QIODevice *dev, const QString &language,
+                                 QString *errorString)
+{
+    QXmlStreamReader reader(dev);
+    errorString->clear();
+    if (!readUiAttributes(reader, language, errorString))
         return nullptr;
-    }
     DomUI *ui = new DomUI;
     ui->read(reader);
     if (reader.hasError()) {
-        m_errorString = msgXmlError(reader);
-        uiLibWarning(m_errorString);
+        *errorString = msgXmlError(reader);
         delete ui;
         return nullptr;
     }
     return ui;
 }
 
+// Stands in for a custom widget of a plugin that describes its custom
+// widgets in its metadata, so that the plugin library is only loaded when
+// the first widget is created.
+class LazyCustomWidget : public QDesignerCustomWidgetInterface
+{
+public:
+    explicit LazyCustomWidget(const QString &pluginPath, const QJsonObject &description);
+
+    QString name() const override { return m_name; }
+    QString group() const override { return m_group; }
+    QString toolTip() const override { return m_toolTip; }
+    QString whatsThis() const override { return m_whatsThis; }
+    QString includeFile() const override { return m_includeFile; }
+    QIcon icon() const override;
+    bool isContainer() const override { return m_container; }
+    QWidget *createWidget(QWidget *parent) override;
+    bool isInitialized() const override { return m_initialized; }
+    void initialize(QDesignerFormEditorInterface *core) override;
+    QString domXml() const override;
+    QString codeTemplate() const override { return m_codeTemplate; }
+
+private:
+    QDesignerCustomWidgetInterface *customWidget();
+
+    const QString m_pluginPath;
+    const QString m_name;
+    const QString m_group;
+    const QString m_toolTip;
+    const QString m_whatsThis;
+    const QString m_includeFile;
+    const QString m_iconFile;
+    const QString m_domXml;
+    const QString m_codeTemplate;
+    const bool m_container;
+
+    QDesignerFormEditorInterface *m_core = nullptr;
+    QDesignerCustomWidgetInterface *m_customWidget = nullptr;
+    bool m_initialized = false;
+    bool m_loadFailed = false;
+};
+
+LazyCustomWidget::LazyCustomWidget(const QString &pluginPath, const QJsonObject &description) :
+    m_pluginPath(pluginPath),
+    m_name(description.value("name"_L1).toString()),
+    m_group(description.value("group"_L1).toString()),
+    m_toolTip(description.value("toolTip"_L1).toString()),
+    m_whatsThis(description.value("whatsThis"_L1).toString()),
+    m_includeFile(description.value("includeFile"_L1).toString()),
+    m_iconFile(description.value("icon"_L1).toString()),
+    m_domXml(description.value("domXml"_L1).toString()),
+    m_codeTemplate(description.value("codeTemplate"_L1).toString()),
+    m_container(description.value("isContainer"_L1).toBool())
+{
+}
+
+// Relative icon file names are relative to the directory of the plugin.
+QIcon LazyCustomWidget::icon() const
+{
+    if (m_iconFile.isEmpty())
+        return {};
+    return QIcon(QFileInfo(m_pluginPath).absoluteDir().absoluteFilePath(m_iconFile));
+}
+
+QString LazyCustomWidget::domXml() const
+{
+    return m_domXml.isEmpty() ? QDesignerCustomWidgetInterface::domXml() : m_domXml;
+}
+
+void LazyCustomWidget::initialize(QDesignerFormEditorInterface *core)
+{
+    m_core = core;
+    m_initialized = true;
+}
+
+QWidget *LazyCustomWidget::createWidget(QWidget *parent)
+{
+    QDesignerCustomWidgetInterface *c = customWidget();
+    return c != nullptr ? c->createWidget(parent) : nullptr;
+}
+
+QDesignerCustomWidgetInterface *LazyCustomWidget::customWidget()
+{
+#if QT_CONFIG(library)
+    if (m_customWidget == nullptr && !m_loadFailed) {
+        QPluginLoader loader(m_pluginPath);
+        QObject *o = loader.instance();
+        QList<QDesignerCustomWidgetInterface *> customWidgets;
+        if (auto *c = qobject_cast<QDesignerCustomWidgetInterface *>(o))
+            customWidgets.append(c);
+        else if (auto *coll = qobject_cast<QDesignerCustomWidgetCollectionInterface *>(o))
+            customWidgets = coll->customWidgets();
+        for (QDesignerCustomWidgetInterface *c : std::as_const(customWidgets)) {
+            if (c->name() == m_name) {
+                m_customWidget = c;
+                break;
+            }
+        }
+        if (m_customWidget == nullptr) {
+            m_loadFailed = true;
+            const QString pluginPath = QDir::toNativeSeparators(m_pluginPath);
+            if (o == nullptr) {
+                uiLibWarning(QCoreApplication::translate("QFormBuilder", "Cannot load the plugin %1: %2")
+                             .arg(pluginPath, loader.errorString()));
+            } else {
+                uiLibWarning(QCoreApplication::translate("QFormBuilder", "The plugin %1 does not provide the custom widget %2 of its metadata.")
+                             .arg(pluginPath, m_name));
+            }
+        }
+    }
+#endif // QT_CONFIG(library)
+    if (m_customWidget != nullptr && m_initialized && !m_customWidget->isInitialized())
+        m_customWidget->initialize(m_core);
+    return m_customWidget;
+}
+
+// The stand-ins live as long as the plugins, which are never unloaded.
+using LazyCustomWidgetHash = QHash<std::pair<QString, QString>, std::shared_ptr<LazyCustomWidget>>;
+Q_GLOBAL_STATIC(LazyCustomWidgetHash, lazyCustomWidgetHash)
+
+QList<QDesignerCustomWidgetInterface *>
+    QFormBuilderExtra::lazyCustomWidgets(const QString &pluginPath, const QJsonObject &metaData)
+{
+    QList<QDesignerCustomWidgetInterface *> result;
+    const QString iid = metaData.value("IID"_L1).toString();
+    if (iid != QLatin1StringView(QDesignerCustomWidgetInterface_iid)
+        && iid != QLatin1StringView(QDesignerCustomWidgetCollectionInterface_iid)) {
+        return result;
+    }
+
+    const QJsonArray descriptions =
+        metaData.value("MetaData"_L1).toObject().value("customWidgets"_L1).toArray();
+    for (const auto &value : descriptions) {
+        const QJsonObject description = value.toObject();
+        const QString name = description.value("name"_L1).toString();
+        if (name.isEmpty())
+            continue;
+        auto &customWidget = (*lazyCustomWidgetHash())[{pluginPath, name}];
+        if (!customWidget)
+            customWidget = std::make_shared<LazyCustomWidget>(pluginPath, description);
+        result.append(customWidget.get());
+    }
+    return result;
+}
+
 QString QFormBuilderExtra::msgInvalidUiFile()
 {
     return QCoreApplication::translate("QAbstractFormBuilder", "Invalid UI file");
 }
 
+// The widgets of the table are looked up by class name for every widget
+// of every form, so the table is hashed once instead of comparing the
+// name with each of its entries.
+QFormBuilderExtra::WidgetConstructor QFormBuilderExtra::widgetConstructor(const QString &className)
+{
+    static const QHash<QString, WidgetConstructor> constructors = [] {
+        QHash<QString, WidgetConstructor> result;
+#define DECLARE_LAYOUT(L, C)
+#define DECLARE_WIDGET(W, C) \
+        result.insert(QStringLiteral(#W), [](QWidget *parent) -> QWidget * { return new W(parent); });
+#define DECLARE_WIDGET_1(W, C) \
+        result.insert(QStringLiteral(#W), [](QWidget *parent) -> QWidget * { return new W(nullptr, parent); });
+
+#include "widgets.table"
+
+#undef DECLARE_LAYOUT
+#undef DECLARE_WIDGET
+#undef DECLARE_WIDGET_1
+        return result;
+    }();
+    return constructors.value(className);
+}
+
 bool QFormBuilderExtra::applyPropertyInternally(QObject *o, const QString &propertyName, const QVariant &value)
 {
     // Store buddies and apply them later on as the widgets might not exist yet.
@@ -250,6 +572,15 @@ void QFormBuilderExtra::setResourceBuilder(QResourceBuilder *builder)
         return;
     clearResourceBuilder();
     m_resourceBuilder = builder;
+    if (m_resourceBuilder)
+        m_resourceBuilder->setIconCacheEnabled(m_iconCacheEnabled);
+}
+
+void QFormBuilderExtra::setIconCacheEnabled(bool enabled)
+{
+    m_iconCacheEnabled = enabled;
+    if (m_resourceBuilder)
+        m_resourceBuilder->setIconCacheEnabled(enabled);
 }
 
 QResourceBuilder *QFormBuilderExtra::resourceBuilder() const
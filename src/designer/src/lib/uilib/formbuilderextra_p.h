@@ -27,6 +27,7 @@
 QT_BEGIN_NAMESPACE
 
 class QDesignerCustomWidgetInterface;
+class QJsonObject;
 class QObject;
 class QVariant;
 class QWidget;
@@ -77,8 +78,18 @@ public:
     void clear();
 
     DomUI *readUi(QIODevice *dev);
+    static DomUI *readUi(QIODevice *dev, const QString &language, QString *errorString);
     static QString msgInvalidUiFile();
 
+    // Creates a widget of one of the classes listed in widgets.table.
+    using WidgetConstructor = QWidget *(*)(QWidget *parent);
+    static WidgetConstructor widgetConstructor(const QString &className);
+
+    // Custom widgets described in the "customWidgets" array of the metadata
+    // of a plugin, which load the plugin when they are first used.
+    static QList<QDesignerCustomWidgetInterface *> lazyCustomWidgets(const QString &pluginPath,
+                                                                     const QJsonObject &metaData);
+
     bool applyPropertyInternally(QObject *o, const QString &propertyName, const QVariant &value);
 
     enum BuddyMode { BuddyApplyAll, BuddyApplyVisibleOnly };
@@ -95,6 +106,8 @@ public:
 
     void setResourceBuilder(QResourceBuilder *builder);
     QResourceBuilder *resourceBuilder() const;
+    bool isIconCacheEnabled() const { return m_iconCacheEnabled; }
+    void setIconCacheEnabled(bool enabled);
 
     void setTextBuilder(QTextBuilder *builder);
     QTextBuilder *textBuilder() const;
@@ -176,6 +189,7 @@ private:
 
     bool m_layoutWidget = false;
     QResourceBuilder *m_resourceBuilder = nullptr;
+    bool m_iconCacheEnabled = false;
     QTextBuilder *m_textBuilder = nullptr;
 
     QPointer<QWidget> m_parentWidget;
@@ -8,6 +8,8 @@
 #include "resourcebuilder_p.h"
 
 #include <QtCore/qdatetime.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qdebug.h>
 
@@ -18,6 +20,7 @@
 #include <QtWidgets/qabstractscrollarea.h>
 
 #include <limits>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -28,13 +31,97 @@ namespace QFormInternal
 {
 #endif
 
+// Forms set the same properties of the same classes over and over, while
+// QMetaObject::indexOfProperty() and QMetaEnum::keyToValue() compare the
+// names of all properties of a class hierarchy and of all enumeration keys.
+// The results are therefore kept for the whole process.
+class PropertyLookupCache
+{
+public:
+    int indexOfProperty(const QMetaObject *meta, const QString &name);
+    std::optional<int> enumValue(const QMetaObject *meta, int index, const QString &keys,
+                                 bool flags);
+
+private:
+    struct ValueKey
+    {
+        const QMetaObject *meta;
+        int index;
+        bool flags;
+        QString keys;
+
+        friend bool operator==(const ValueKey &lhs, const ValueKey &rhs) noexcept
+        {
+            return lhs.meta == rhs.meta && lhs.index == rhs.index && lhs.flags == rhs.flags
+                    && lhs.keys == rhs.keys;
+        }
+        friend size_t qHash(const ValueKey &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.meta, key.index, key.flags, key.keys);
+        }
+    };
+
+    QMutex m_mutex;
+    QHash<std::pair<const QMetaObject *, QString>, int> m_indexes;
+    QHash<ValueKey, std::optional<int>> m_values;
+};
+
+int PropertyLookupCache::indexOfProperty(const QMetaObject *meta, const QString &name)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_indexes.constFind({ meta, name });
+    if (it == m_indexes.cend())
+        it = m_indexes.insert({ meta, name }, meta->indexOfProperty(name.toUtf8().constData()));
+    return *it;
+}
+
+std::optional<int> PropertyLookupCache::enumValue(const QMetaObject *meta, int index,
+                                                  const QString &keys, bool flags)
+{
+    QMutexLocker locker(&m_mutex);
+    const ValueKey key{ meta, index, flags, keys };
+    auto it = m_values.constFind(key);
+    if (it == m_values.cend()) {
+        const QMetaEnum e = meta->property(index).enumerator();
+        const QByteArray keysUtf8 = keys.toUtf8();
+        bool ok{};
+        const int value = flags ? e.keysToValue(keysUtf8.constData(), &ok)
+                                : e.keyToValue(keysUtf8.constData(), &ok);
+        it = m_values.insert(key, ok ? std::optional<int>(value) : std::nullopt);
+    }
+    return *it;
+}
+
+Q_GLOBAL_STATIC(PropertyLookupCache, propertyLookupCache)
+
+int cachedIndexOfProperty(const QMetaObject *meta, const QString &name)
+{
+    return propertyLookupCache()->indexOfProperty(meta, name);
+}
+
+// Like QObject::setProperty(), which is still used for dynamic properties
+// and for the warning about read-only ones.
+void setObjectProperty(QObject *o, const QString &name, const QVariant &value)
+{
+    const QMetaObject *meta = o->metaObject();
+    const int index = cachedIndexOfProperty(meta, name);
+    if (index != -1) {
+        const QMetaProperty property = meta->property(index);
+        if (property.isWritable()) {
+            property.write(o, value);
+            return;
+        }
+    }
+    o->setProperty(name.toUtf8().constData(), value);
+}
+
 // Convert complex DOM types with the help of  QAbstractFormBuilder
 QVariant domPropertyToVariant(QAbstractFormBuilder *afb,const QMetaObject *meta,const  DomProperty *p)
 {
     // Complex types that need functions from QAbstractFormBuilder
     switch(p->kind()) {
     case DomProperty::String: {
-        const int index = meta->indexOfProperty(p->attributeName().toUtf8());
+        const int index = cachedIndexOfProperty(meta, p->attributeName());
         if (index != -1 && meta->property(index).metaType().id() == QMetaType::QKeySequence)
             return QVariant::fromValue(QKeySequence(p->elementString()->text()));
     }
@@ -58,29 +145,27 @@ QVariant domPropertyToVariant(QAbstractFormBuilder *afb,const QMetaObject *meta,
     }
 
     case DomProperty::Set: {
-        const QByteArray pname = p->attributeName().toUtf8();
-        const int index = meta->indexOfProperty(pname);
+        const int index = cachedIndexOfProperty(meta, p->attributeName());
         if (index == -1) {
             uiLibWarning(QCoreApplication::translate("QFormBuilder", "The set-type property %1 could not be read.").arg(p->attributeName()));
             return QVariant();
         }
 
-        const QMetaEnum e = meta->property(index).enumerator();
-        Q_ASSERT(e.isFlag() == true);
-        bool ok{};
-        QVariant result(e.keysToValue(p->elementSet().toUtf8().constData(), &ok));
-        if (!ok) {
+        Q_ASSERT(meta->property(index).enumerator().isFlag() == true);
+        const std::optional<int> result =
+                propertyLookupCache()->enumValue(meta, index, p->elementSet(), true);
+        if (!result) {
             uiLibWarning(QCoreApplication::translate("QFormBuilder",
                                                      "The value \"%1\" of the set-type property %2 could not be read.").
                                                      arg(p->attributeName(), p->elementSet()));
             return {};
         }
-        return result;
+        return QVariant(*result);
     }
 
     case DomProperty::Enum: {
-        const QByteArray pname = p->attributeName().toUtf8();
-        const int index = meta->indexOfProperty(pname);
+        const QString &pname = p->attributeName();
+        const int index = cachedIndexOfProperty(meta, pname);
         const auto &enumValue = p->elementEnum();
         // Triggers in case of objects in Designer like Spacer/Line for which properties
         // are serialized using language introspection. On preview, however, these objects are
@@ -88,23 +173,22 @@ QVariant domPropertyToVariant(QAbstractFormBuilder *afb,const QMetaObject *meta,
         if (index == -1) {
             // ### special-casing for Line (QFrame) -- fix for 4.2. Jambi hack for enumerations
             if (!qstrcmp(meta->className(), "QFrame")
-                && (pname == QByteArray("orientation"))) {
+                && (pname == "orientation"_L1)) {
                 return QVariant(enumValue.endsWith("Horizontal"_L1) ? QFrame::HLine : QFrame::VLine);
             }
             uiLibWarning(QCoreApplication::translate("QFormBuilder", "The enumeration-type property %1 could not be read.").arg(p->attributeName()));
             return QVariant();
         }
 
-        const QMetaEnum e = meta->property(index).enumerator();
-        bool ok{};
-        QVariant result(e.keyToValue(enumValue.toUtf8().constData(), &ok));
-        if (!ok) {
+        const std::optional<int> result =
+                propertyLookupCache()->enumValue(meta, index, enumValue, false);
+        if (!result) {
             uiLibWarning(QCoreApplication::translate("QFormBuilder",
                                                      "The value \"%1\" of the enum-type property %2 could not be read.").
                          arg(p->attributeName(), enumValue));
             return {};
         }
-        return result;
+        return QVariant(*result);
     }
     case DomProperty::Brush:
         return QVariant::fromValue(afb->setupBrush(p->elementBrush()));
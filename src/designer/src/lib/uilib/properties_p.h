@@ -42,6 +42,10 @@ QDESIGNER_UILIB_EXPORT DomProperty *variantToDomProperty(QAbstractFormBuilder *a
 QDESIGNER_UILIB_EXPORT QVariant domPropertyToVariant(const DomProperty *property);
 QDESIGNER_UILIB_EXPORT QVariant domPropertyToVariant(QAbstractFormBuilder *abstractFormBuilder, const QMetaObject *meta, const  DomProperty *property);
 
+// Property lookups by name, cached for all forms loaded by the process
+int cachedIndexOfProperty(const QMetaObject *meta, const QString &name);
+void setObjectProperty(QObject *o, const QString &name, const QVariant &value);
+
 // This class exists to provide meta information
 // for enumerations only.
 class QAbstractFormBuilderGadget: public QWidget
@@ -3,6 +3,7 @@
 
 #include "resourcebuilder_p.h"
 #include "ui4_p.h"
+#include <QtCore/qcache.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qdir.h>
@@ -20,6 +21,12 @@ namespace QFormInternal {
 
 enum { themeDebug = 0 };
 
+// The icons loaded so far, shared by all form builders. Copies of a QIcon
+// share the pixmaps it has read, so forms that use the same icons read
+// their files once. Pixmaps are cached by QPixmapCache already.
+using IconCache = QCache<QString, QIcon>;
+Q_GLOBAL_STATIC(IconCache, iconCache, 256)
+
 QResourceBuilder::QResourceBuilder() = default;
 
 QResourceBuilder::~QResourceBuilder() = default;
@@ -47,6 +54,66 @@ int QResourceBuilder::iconStateFlags(const DomResourceIcon *dpi)
     return rc;
 }
 
+static QIcon loadIcon(const QDir &workingDirectory, const DomResourceIcon *dpi)
+{
+    if (!dpi->attributeTheme().isEmpty()) {
+        const QString theme = dpi->attributeTheme();
+        const qsizetype themeEnum = theme.at(0).isUpper()
+            ? QResourceBuilder::themeIconNames().indexOf(theme) : -1;
+        if (themeEnum != -1) {
+            const auto themeEnumE = static_cast<QIcon::ThemeIcon>(themeEnum);
+            return QIcon::fromTheme(themeEnumE);
+        }
+        const bool known = QIcon::hasThemeIcon(theme);
+        if (themeDebug)
+            qDebug("Theme %s known %d", qPrintable(theme), known);
+        if (known)
+            return QIcon::fromTheme(theme);
+    } // non-empty theme
+    if (const int flags = QResourceBuilder::iconStateFlags(dpi)) { // new, post 4.4 format
+        QIcon icon;
+        if (flags & QResourceBuilder::NormalOff)
+            icon.addFile(QFileInfo(workingDirectory, dpi->elementNormalOff()->text()).absoluteFilePath(), QSize(), QIcon::Normal, QIcon::Off);
+        if (flags & QResourceBuilder::NormalOn)
+            icon.addFile(QFileInfo(workingDirectory, dpi->elementNormalOn()->text()).absoluteFilePath(), QSize(), QIcon::Normal, QIcon::On);
+        if (flags & QResourceBuilder::DisabledOff)
+            icon.addFile(QFileInfo(workingDirectory, dpi->elementDisabledOff()->text()).absoluteFilePath(), QSize(), QIcon::Disabled, QIcon::Off);
+        if (flags & QResourceBuilder::DisabledOn)
+            icon.addFile(QFileInfo(workingDirectory, dpi->elementDisabledOn()->text()).absoluteFilePath(), QSize(), QIcon::Disabled, QIcon::On);
+        if (flags & QResourceBuilder::ActiveOff)
+            icon.addFile(QFileInfo(workingDirectory, dpi->elementActiveOff()->text()).absoluteFilePath(), QSize(), QIcon::Active, QIcon::Off);
+        if (flags & QResourceBuilder::ActiveOn)
+            icon.addFile(QFileInfo(workingDirectory, dpi->elementActiveOn()->text()).absoluteFilePath(), QSize(), QIcon::Active, QIcon::On);
+        if (flags & QResourceBuilder::SelectedOff)
+            icon.addFile(QFileInfo(workingDirectory, dpi->elementSelectedOff()->text()).absoluteFilePath(), QSize(), QIcon::Selected, QIcon::Off);
+        if (flags & QResourceBuilder::SelectedOn)
+            icon.addFile(QFileInfo(workingDirectory, dpi->elementSelectedOn()->text()).absoluteFilePath(), QSize(), QIcon::Selected, QIcon::On);
+        return icon;
+    } else { // 4.3 legacy
+        return QIcon(QFileInfo(workingDirectory, dpi->text()).absoluteFilePath());
+    }
+}
+
+// The key of an icon in the cache: the current theme, the theme icon
+// name, and the files of all modes and states.
+static QString iconCacheKey(const QDir &workingDirectory, const DomResourceIcon *dpi)
+{
+    QString key = QIcon::themeName() + u'\n' + dpi->attributeTheme() + u'\n'
+            + workingDirectory.absolutePath() + u'\n' + dpi->text();
+    const DomResourcePixmap *files[] = {
+        dpi->elementNormalOff(), dpi->elementNormalOn(),
+        dpi->elementDisabledOff(), dpi->elementDisabledOn(),
+        dpi->elementActiveOff(), dpi->elementActiveOn(),
+        dpi->elementSelectedOff(), dpi->elementSelectedOn()
+    };
+    for (const DomResourcePixmap *file : files) {
+        key += u'\n';
+        if (file)
+            key += file->text();
+    }
+    return key;
+}
+
 QVariant QResourceBuilder::loadResource(const QDir &workingDirectory, const DomProperty *property) const
 {
     switch (property->kind()) {
@@ -57,43 +124,14 @@ QVariant QResourceBuilder::loadResource(const QDir &workingDirectory, const DomP
         }
         case DomProperty::IconSet: {
             const DomResourceIcon *dpi = property->elementIconSet();
-            if (!dpi->attributeTheme().isEmpty()) {
-                const QString theme = dpi->attributeTheme();
-                const qsizetype themeEnum = theme.at(0).isUpper()
-                    ? themeIconNames().indexOf(theme) : -1;
-                if (themeEnum != -1) {
-                    const auto themeEnumE = static_cast<QIcon::ThemeIcon>(themeEnum);
-                    return QVariant::fromValue(QIcon::fromTheme(themeEnumE));
-                }
-                const bool known = QIcon::hasThemeIcon(theme);
-                if (themeDebug)
-                    qDebug("Theme %s known %d", qPrintable(theme), known);
-                if (known)
-                    return QVariant::fromValue(QIcon::fromTheme(theme));
-            } // non-empty theme
-            if (const int flags = iconStateFlags(dpi)) { // new, post 4.4 format
-                QIcon icon;
-                if (flags & NormalOff)
-                    icon.addFile(QFileInfo(workingDirectory, dpi->elementNormalOff()->text()).absoluteFilePath(), QSize(), QIcon::Normal, QIcon::Off);
-                if (flags & NormalOn)
-                    icon.addFile(QFileInfo(workingDirectory, dpi->elementNormalOn()->text()).absoluteFilePath(), QSize(), QIcon::Normal, QIcon::On);
-                if (flags & DisabledOff)
-                    icon.addFile(QFileInfo(workingDirectory, dpi->elementDisabledOff()->text()).absoluteFilePath(), QSize(), QIcon::Disabled, QIcon::Off);
-                if (flags & DisabledOn)
-                    icon.addFile(QFileInfo(workingDirectory, dpi->elementDisabledOn()->text()).absoluteFilePath(), QSize(), QIcon::Disabled, QIcon::On);
-                if (flags & ActiveOff)
-                    icon.addFile(QFileInfo(workingDirectory, dpi->elementActiveOff()->text()).absoluteFilePath(), QSize(), QIcon::Active, QIcon::Off);
-                if (flags & ActiveOn)
-                    icon.addFile(QFileInfo(workingDirectory, dpi->elementActiveOn()->text()).absoluteFilePath(), QSize(), QIcon::Active, QIcon::On);
-                if (flags & SelectedOff)
-                    icon.addFile(QFileInfo(workingDirectory, dpi->elementSelectedOff()->text()).absoluteFilePath(), QSize(), QIcon::Selected, QIcon::Off);
-                if (flags & SelectedOn)
-                    icon.addFile(QFileInfo(workingDirectory, dpi->elementSelectedOn()->text()).absoluteFilePath(), QSize(), QIcon::Selected, QIcon::On);
-                return QVariant::fromValue(icon);
-            } else { // 4.3 legacy
-                const QIcon icon(QFileInfo(workingDirectory, dpi->text()).absoluteFilePath());
-                return QVariant::fromValue(icon);
-            }
+            if (!m_iconCacheEnabled)
+                return QVariant::fromValue(loadIcon(workingDirectory, dpi));
+            const QString key = iconCacheKey(workingDirectory, dpi);
+            if (const QIcon *cached = iconCache()->object(key))
+                return QVariant::fromValue(*cached);
+            const QIcon icon = loadIcon(workingDirectory, dpi);
+            iconCache()->insert(key, new QIcon(icon));
+            return QVariant::fromValue(icon);
         }
             break;
         default:
@@ -59,6 +59,14 @@ public:
     virtual bool isResourceType(const QVariant &value) const;
 
     static int iconStateFlags(const DomResourceIcon *resIcon);
+
+    // Whether loadResource() shares the icons it loads through a cache
+    // that is common to all resource builders.
+    bool isIconCacheEnabled() const { return m_iconCacheEnabled; }
+    void setIconCacheEnabled(bool enabled) { m_iconCacheEnabled = enabled; }
+
+private:
+    bool m_iconCacheEnabled = false;
 };
 
 
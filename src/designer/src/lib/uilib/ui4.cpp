@@ -5,6 +5,7 @@
 
 #include "ui4_p.h"
 
+#include <array>
 
 QT_BEGIN_NAMESPACE
 
@@ -14,6 +15,18 @@ using namespace Qt::StringLiterals;
 using namespace QFormInternal;
 #endif
 
+// Attribute values like class, object and property names repeat throughout
+// forms. Let the elements share the strings of recently seen values instead
+// of allocating one for each of them.
+static QString internedString(QStringView value)
+{
+    static thread_local std::array<QString, 512> strings;
+    QString &interned = strings[qHash(value) % strings.size()];
+    if (interned != value)
+        interned = value.toString();
+    return interned;
+}
+
 /*******************************************************************************
 ** Implementations
 */
@@ -39,15 +52,15 @@ void DomUI::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"version"_s) {
-            setAttributeVersion(attribute.value().toString());
+            setAttributeVersion(internedString(attribute.value()));
             continue;
         }
         if (name == u"language"_s) {
-            setAttributeLanguage(attribute.value().toString());
+            setAttributeLanguage(internedString(attribute.value()));
             continue;
         }
         if (name == u"displayname"_s) {
-            setAttributeDisplayname(attribute.value().toString());
+            setAttributeDisplayname(internedString(attribute.value()));
             continue;
         }
         if (name == u"idbasedtr"_s) {
@@ -601,11 +614,11 @@ void DomInclude::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"location"_s) {
-            setAttributeLocation(attribute.value().toString());
+            setAttributeLocation(internedString(attribute.value()));
             continue;
         }
         if (name == u"impldecl"_s) {
-            setAttributeImpldecl(attribute.value().toString());
+            setAttributeImpldecl(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -658,7 +671,7 @@ void DomResources::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -712,7 +725,7 @@ void DomResource::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"location"_s) {
-            setAttributeLocation(attribute.value().toString());
+            setAttributeLocation(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -761,7 +774,7 @@ void DomActionGroup::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -866,11 +879,11 @@ void DomAction::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         if (name == u"menu"_s) {
-            setAttributeMenu(attribute.value().toString());
+            setAttributeMenu(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -942,7 +955,7 @@ void DomActionRef::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -987,7 +1000,7 @@ void DomButtonGroup::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -1146,7 +1159,7 @@ void DomHeader::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"location"_s) {
-            setAttributeLocation(attribute.value().toString());
+            setAttributeLocation(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -1499,11 +1512,11 @@ void DomLayoutFunction::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"spacing"_s) {
-            setAttributeSpacing(attribute.value().toString());
+            setAttributeSpacing(internedString(attribute.value()));
             continue;
         }
         if (name == u"margin"_s) {
-            setAttributeMargin(attribute.value().toString());
+            setAttributeMargin(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -1595,31 +1608,31 @@ void DomLayout::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"class"_s) {
-            setAttributeClass(attribute.value().toString());
+            setAttributeClass(internedString(attribute.value()));
             continue;
         }
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         if (name == u"stretch"_s) {
-            setAttributeStretch(attribute.value().toString());
+            setAttributeStretch(internedString(attribute.value()));
             continue;
         }
         if (name == u"rowstretch"_s) {
-            setAttributeRowStretch(attribute.value().toString());
+            setAttributeRowStretch(internedString(attribute.value()));
             continue;
         }
         if (name == u"columnstretch"_s) {
-            setAttributeColumnStretch(attribute.value().toString());
+            setAttributeColumnStretch(internedString(attribute.value()));
             continue;
         }
         if (name == u"rowminimumheight"_s) {
-            setAttributeRowMinimumHeight(attribute.value().toString());
+            setAttributeRowMinimumHeight(internedString(attribute.value()));
             continue;
         }
         if (name == u"columnminimumwidth"_s) {
-            setAttributeColumnMinimumWidth(attribute.value().toString());
+            setAttributeColumnMinimumWidth(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -1755,7 +1768,7 @@ void DomLayoutItem::read(QXmlStreamReader &reader)
             continue;
         }
         if (name == u"alignment"_s) {
-            setAttributeAlignment(attribute.value().toString());
+            setAttributeAlignment(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -2081,11 +2094,11 @@ void DomWidget::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"class"_s) {
-            setAttributeClass(attribute.value().toString());
+            setAttributeClass(internedString(attribute.value()));
             continue;
         }
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         if (name == u"native"_s) {
@@ -2324,7 +2337,7 @@ void DomSpacer::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -2588,15 +2601,15 @@ void DomGradient::read(QXmlStreamReader &reader)
             continue;
         }
         if (name == u"type"_s) {
-            setAttributeType(attribute.value().toString());
+            setAttributeType(internedString(attribute.value()));
             continue;
         }
         if (name == u"spread"_s) {
-            setAttributeSpread(attribute.value().toString());
+            setAttributeSpread(internedString(attribute.value()));
             continue;
         }
         if (name == u"coordinatemode"_s) {
-            setAttributeCoordinateMode(attribute.value().toString());
+            setAttributeCoordinateMode(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -2704,7 +2717,7 @@ void DomBrush::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"brushstyle"_s) {
-            setAttributeBrushStyle(attribute.value().toString());
+            setAttributeBrushStyle(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -2825,7 +2838,7 @@ void DomColorRole::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"role"_s) {
-            setAttributeRole(attribute.value().toString());
+            setAttributeRole(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -3483,11 +3496,11 @@ void DomLocale::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"language"_s) {
-            setAttributeLanguage(attribute.value().toString());
+            setAttributeLanguage(internedString(attribute.value()));
             continue;
         }
         if (name == u"country"_s) {
-            setAttributeCountry(attribute.value().toString());
+            setAttributeCountry(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -3529,11 +3542,11 @@ void DomSizePolicy::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"hsizetype"_s) {
-            setAttributeHSizeType(attribute.value().toString());
+            setAttributeHSizeType(internedString(attribute.value()));
             continue;
         }
         if (name == u"vsizetype"_s) {
-            setAttributeVSizeType(attribute.value().toString());
+            setAttributeVSizeType(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -4006,19 +4019,19 @@ void DomStringList::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"notr"_s) {
-            setAttributeNotr(attribute.value().toString());
+            setAttributeNotr(internedString(attribute.value()));
             continue;
         }
         if (name == u"comment"_s) {
-            setAttributeComment(attribute.value().toString());
+            setAttributeComment(internedString(attribute.value()));
             continue;
         }
         if (name == u"extracomment"_s) {
-            setAttributeExtraComment(attribute.value().toString());
+            setAttributeExtraComment(internedString(attribute.value()));
             continue;
         }
         if (name == u"id"_s) {
-            setAttributeId(attribute.value().toString());
+            setAttributeId(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -4079,11 +4092,11 @@ void DomResourcePixmap::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"resource"_s) {
-            setAttributeResource(attribute.value().toString());
+            setAttributeResource(internedString(attribute.value()));
             continue;
         }
         if (name == u"alias"_s) {
-            setAttributeAlias(attribute.value().toString());
+            setAttributeAlias(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -4142,11 +4155,11 @@ void DomResourceIcon::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"theme"_s) {
-            setAttributeTheme(attribute.value().toString());
+            setAttributeTheme(internedString(attribute.value()));
             continue;
         }
         if (name == u"resource"_s) {
-            setAttributeResource(attribute.value().toString());
+            setAttributeResource(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -4443,19 +4456,19 @@ void DomString::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"notr"_s) {
-            setAttributeNotr(attribute.value().toString());
+            setAttributeNotr(internedString(attribute.value()));
             continue;
         }
         if (name == u"comment"_s) {
-            setAttributeComment(attribute.value().toString());
+            setAttributeComment(internedString(attribute.value()));
             continue;
         }
         if (name == u"extracomment"_s) {
-            setAttributeExtraComment(attribute.value().toString());
+            setAttributeExtraComment(internedString(attribute.value()));
             continue;
         }
         if (name == u"id"_s) {
-            setAttributeId(attribute.value().toString());
+            setAttributeId(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -4915,7 +4928,7 @@ void DomProperty::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         if (name == u"stdset"_s) {
@@ -5892,7 +5905,7 @@ void DomConnectionHint::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"type"_s) {
-            setAttributeType(attribute.value().toString());
+            setAttributeType(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -6130,7 +6143,7 @@ void DomPropertyToolTip::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -6169,15 +6182,15 @@ void DomStringPropertySpecification::read(QXmlStreamReader &reader)
     for (const QXmlStreamAttribute &attribute : attributes) {
         const auto name = attribute.name();
         if (name == u"name"_s) {
-            setAttributeName(attribute.value().toString());
+            setAttributeName(internedString(attribute.value()));
             continue;
         }
         if (name == u"type"_s) {
-            setAttributeType(attribute.value().toString());
+            setAttributeType(internedString(attribute.value()));
             continue;
         }
         if (name == u"notr"_s) {
-            setAttributeNotr(attribute.value().toString());
+            setAttributeNotr(internedString(attribute.value()));
             continue;
         }
         reader.raiseError("Unexpected attribute "_L1 + name);
@@ -0,0 +1,461 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "distancefieldfontwriter.h"
+#include "distancefieldmodel.h"
+
+#include <QtCore/qbuffer.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtGui/qfont.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include <QtGui/private/qdistancefield_p.h>
+#include <QtQuick/private/qsgareaallocator_p.h>
+#include <QtQuick/private/qsgadaptationlayer_p.h>
+
+QT_BEGIN_NAMESPACE
+
+#   pragma pack(1)
+struct FontDirectoryHeader
+{
+    quint32 sfntVersion;
+    quint16 numTables;
+    quint16 searchRange;
+    quint16 entrySelector;
+    quint16 rangeShift;
+};
+
+struct TableRecord
+{
+    quint32 tag;
+    quint32 checkSum;
+    quint32 offset;
+    quint32 length;
+};
+
+struct QtdfHeader
+{
+    quint8 majorVersion;
+    quint8 minorVersion;
+    quint16 pixelSize;
+    quint32 textureSize;
+    quint8 flags;
+    quint8 padding;
+    quint32 numGlyphs;
+};
+
+struct QtdfGlyphRecord
+{
+    quint32 glyphIndex;
+    quint32 textureOffsetX;
+    quint32 textureOffsetY;
+    quint32 textureWidth;
+    quint32 textureHeight;
+    quint32 xMargin;
+    quint32 yMargin;
+    qint32 boundingRectX;
+    qint32 boundingRectY;
+    quint32 boundingRectWidth;
+    quint32 boundingRectHeight;
+    quint16 textureIndex;
+};
+
+struct QtdfTextureRecord
+{
+    quint32 allocatedX;
+    quint32 allocatedY;
+    quint32 allocatedWidth;
+    quint32 allocatedHeight;
+    quint8 padding;
+};
+
+struct Head
+{
+    quint16 majorVersion;
+    quint16 minorVersion;
+    quint32 fontRevision;
+    quint32 checkSumAdjustment;
+};
+#   pragma pack()
+
+#define PAD_BUFFER(buffer, size) \
+    { \
+        int paddingNeed = size % 4; \
+        if (paddingNeed > 0) { \
+            const char padding[3] = { 0, 0, 0 }; \
+            buffer.write(padding, 4 - paddingNeed); \
+        } \
+    }
+
+#define ALIGN_OFFSET(offset) \
+    { \
+        int paddingNeed = offset % 4; \
+        if (paddingNeed > 0) \
+            offset += 4 - paddingNeed; \
+    }
+
+#define TO_FIXED_POINT(value) \
+    ((int)(value*qreal(65536)))
+
+DistanceFieldFontWriter::DistanceFieldFontWriter(const DistanceFieldModel *model)
+    : m_model(model)
+{
+}
+
+/*
+  Writes a copy of \a fontFile with a qtdf table holding the distance
+  fields of \a glyphs to \a fileName. Returns false and sets the error
+  string if that fails.
+*/
+bool DistanceFieldFontWriter::write(const QString &fontFile, const QString &fileName,
+                                    const QList<glyph_t> &glyphs)
+{
+    m_errorString.clear();
+    if (glyphs.isEmpty()) {
+        m_errorString = tr("No glyphs selected for saving.");
+        return false;
+    }
+
+    QFile inFile(fontFile);
+    if (!inFile.open(QIODevice::ReadOnly)) {
+        m_errorString = tr("Cannot open '%1' for reading. The original font file must remain in place until the new file has been saved.").arg(fontFile);
+        return false;
+    }
+
+    QByteArray output;
+    quint32 headOffset = 0;
+
+    {
+        QBuffer outBuffer(&output);
+        outBuffer.open(QIODevice::WriteOnly);
+
+        uchar *inData = inFile.map(0, inFile.size());
+        if (inData == nullptr) {
+            m_errorString = tr("Unable to memory map input file '%1'.").arg(fontFile);
+            return false;
+        }
+
+        uchar *end = inData + inFile.size();
+        if (inData + sizeof(FontDirectoryHeader) > end) {
+            m_errorString = tr("Input file seems to be invalid or corrupt.");
+            return false;
+        }
+
+        FontDirectoryHeader fontDirectoryHeader;
+        memcpy(&fontDirectoryHeader, inData, sizeof(FontDirectoryHeader));
+        quint16 numTables = qFromBigEndian(fontDirectoryHeader.numTables) + 1;
+        fontDirectoryHeader.numTables = qToBigEndian(numTables);
+        {
+            quint16 searchRange = qFromBigEndian(fontDirectoryHeader.searchRange);
+            if (searchRange / 16 < numTables) {
+                quint16 pot = (searchRange / 16) * 2;
+                searchRange = pot * 16;
+                fontDirectoryHeader.searchRange = qToBigEndian(searchRange);
+                fontDirectoryHeader.rangeShift = qToBigEndian(numTables * 16 - searchRange);
+
+                quint16 entrySelector = 0;
+                while (pot > 1) {
+                    pot >>= 1;
+                    entrySelector++;
+                }
+                fontDirectoryHeader.entrySelector = qToBigEndian(entrySelector);
+            }
+        }
+
+        outBuffer.write(reinterpret_cast<char *>(&fontDirectoryHeader),
+                        sizeof(FontDirectoryHeader));
+
+        QVarLengthArray<std::pair<quint32, quint32>> offsetLengthPairs;
+        offsetLengthPairs.reserve(numTables - 1);
+
+        // Copy the offset table, updating offsets
+        TableRecord *offsetTable = reinterpret_cast<TableRecord *>(inData + sizeof(FontDirectoryHeader));
+        quint32 currentOffset = sizeof(FontDirectoryHeader) + sizeof(TableRecord) * numTables;
+        for (int i = 0; i < numTables - 1; ++i) {
+            ALIGN_OFFSET(currentOffset)
+
+            quint32 originalOffset = qFromBigEndian(offsetTable->offset);
+            quint32 length = qFromBigEndian(offsetTable->length);
+            offsetLengthPairs.append({originalOffset, length});
+            if (offsetTable->tag == qFromBigEndian(QFont::Tag("head").value()))
+                headOffset = currentOffset;
+
+            TableRecord newTableRecord;
+            memcpy(&newTableRecord, offsetTable, sizeof(TableRecord));
+            newTableRecord.offset = qToBigEndian(currentOffset);
+            outBuffer.write(reinterpret_cast<char *>(&newTableRecord), sizeof(TableRecord));
+
+            offsetTable++;
+            currentOffset += length;
+        }
+
+        if (headOffset == 0) {
+            m_errorString = tr("Font file does not have 'head' table.");
+            return false;
+        }
+
+        QByteArray qtdf = createSfntTable(glyphs);
+        if (qtdf.isEmpty())
+            return false;
+
+        {
+            ALIGN_OFFSET(currentOffset)
+
+            TableRecord qtdfRecord;
+            qtdfRecord.offset = qToBigEndian(currentOffset);
+            qtdfRecord.length = qToBigEndian(qtdf.size());
+            qtdfRecord.tag = qFromBigEndian(QFont::Tag("qtdf").value());
+            quint32 checkSum = 0;
+            const quint32 *start = reinterpret_cast<const quint32 *>(qtdf.constData());
+            const quint32 *end = reinterpret_cast<const quint32 *>(qtdf.constData() + qtdf.size());
+            while (start < end)
+                checkSum += *(start++);
+            qtdfRecord.checkSum = qToBigEndian(checkSum);
+
+            outBuffer.write(reinterpret_cast<char *>(&qtdfRecord),
+                            sizeof(TableRecord));
+        }
+
+        // Copy all font tables
+        for (const std::pair<quint32, quint32> &offsetLengthPair : offsetLengthPairs) {
+            PAD_BUFFER(outBuffer, output.size())
+            outBuffer.write(reinterpret_cast<char *>(inData + offsetLengthPair.first),
+                            offsetLengthPair.second);
+        }
+
+        PAD_BUFFER(outBuffer, output.size())
+        outBuffer.write(qtdf);
+    }
+
+    // Clear 'head' checksum and calculate new check sum adjustment
+    Head *head = reinterpret_cast<Head *>(output.data() + headOffset);
+    head->checkSumAdjustment = 0;
+
+    quint32 checkSum = 0;
+    const quint32 *start = reinterpret_cast<const quint32 *>(output.constData());
+    const quint32 *end = reinterpret_cast<const quint32 *>(output.constData() + output.size());
+    while (start < end)
+        checkSum += *(start++);
+
+    head->checkSumAdjustment = qToBigEndian(0xB1B0AFBA - checkSum);
+
+    QSaveFile outFile(fileName);
+    if (!outFile.open(QIODevice::WriteOnly)) {
+        m_errorString = tr("Cannot open the file '%1' for writing").arg(fileName);
+        return false;
+    }
+
+    if (outFile.write(output) != output.size() || !outFile.commit()) {
+        m_errorString = tr("Unable to write the file '%1': %2").arg(fileName, outFile.errorString());
+        return false;
+    }
+    return true;
+}
+
+
+QByteArray DistanceFieldFontWriter::createSfntTable(const QList<glyph_t> &list)
+{
+    Q_ASSERT(!list.isEmpty());
+
+    QByteArray ret;
+    {
+        QBuffer buffer(&ret);
+        buffer.open(QIODevice::WriteOnly);
+
+        QtdfHeader header;
+        header.majorVersion = 5;
+        header.minorVersion = 12;
+        header.pixelSize = qToBigEndian(quint16(qRound(m_model->pixelSize())));
+
+        const quint8 padding = 2;
+        qreal scaleFactor = qreal(1) / QT_DISTANCEFIELD_SCALE(m_model->doubleGlyphResolution());
+        const int radius = QT_DISTANCEFIELD_RADIUS(m_model->doubleGlyphResolution())
+                / QT_DISTANCEFIELD_SCALE(m_model->doubleGlyphResolution());
+
+        quint32 textureSize = m_maximumTextureSize;
+
+        // Since we are using a single area allocator that spans all textures, we need
+        // to split the textures one row before the actual maximum size, otherwise
+        // glyphs that fall on the edge between two textures will expand the texture
+        // they are assigned to, and this will end up being larger than the max.
+        textureSize -= quint32(qCeil(m_model->pixelSize() * scaleFactor) + radius * 2 + padding * 2);
+        header.textureSize = qToBigEndian(textureSize);
+
+        header.padding = padding;
+        header.flags = m_model->doubleGlyphResolution() ? 1 : 0;
+        header.numGlyphs = qToBigEndian(quint32(list.size()));
+        buffer.write(reinterpret_cast<char *>(&header),
+                     sizeof(QtdfHeader));
+
+        // The size of every glyph does not depend on the layout, so it is
+        // computed once up front.
+        struct GlyphData {
+            QSGDistanceFieldGlyphCache::TexCoord texCoord;
+            QRectF boundingRect;
+            QSize glyphSize;
+            int textureIndex;
+        };
+        QList<GlyphData> glyphDatas(list.size());
+        qint64 totalArea = 0;
+        {
+            QTransform scaleDown;
+            scaleDown.scale(scaleFactor, scaleFactor);
+
+            for (int i = 0; i < list.size(); ++i) {
+                GlyphData &glyphData = glyphDatas[i];
+                const QPainterPath path = m_model->path(int(list.at(i)));
+                glyphData.boundingRect = scaleDown.mapRect(path.boundingRect());
+                int glyphWidth = qCeil(glyphData.boundingRect.width()) + radius * 2;
+                int glyphHeight = qCeil(glyphData.boundingRect.height()) + radius * 2;
+
+                glyphData.glyphSize = QSize(glyphWidth + padding * 2, glyphHeight + padding * 2);
+
+                if (glyphData.glyphSize.width() > qint32(textureSize)
+                        || glyphData.glyphSize.height() > qint32(textureSize)) {
+                    m_errorString = tr("Glyph %1 is too large to fit in texture of size %2.")
+                                            .arg(list.at(i)).arg(textureSize);
+                    return QByteArray();
+                }
+                totalArea += qint64(glyphData.glyphSize.width()) * glyphData.glyphSize.height();
+            }
+        }
+
+        // The allocator is serialized into the table, so that Qt Quick can
+        // keep allocating from it at run time. It packs much tighter when
+        // the tallest glyphs are allocated first.
+        QList<int> allocationOrder(list.size());
+        std::iota(allocationOrder.begin(), allocationOrder.end(), 0);
+        std::stable_sort(allocationOrder.begin(), allocationOrder.end(), [&](int a, int b) {
+            const QSize &sizeA = glyphDatas.at(a).glyphSize;
+            const QSize &sizeB = glyphDatas.at(b).glyphSize;
+            if (sizeA.height() != sizeB.height())
+                return sizeA.height() > sizeB.height();
+            return sizeA.width() > sizeB.width();
+        });
+
+        // Maximum height allocator to find optimal number of textures. No
+        // fewer textures than their total area can hold the glyphs.
+        QList<QRect> allocatedAreaPerTexture;
+        int textureCount = int(qMax<qint64>(
+                0, (totalArea - 1) / (qint64(textureSize) * textureSize)));
+
+        {
+            const qreal margin = QT_DISTANCEFIELD_RADIUS(m_model->doubleGlyphResolution())
+                    / qreal(QT_DISTANCEFIELD_SCALE(m_model->doubleGlyphResolution()));
+            bool foundOptimalSize = false;
+            while (!foundOptimalSize) {
+                allocatedAreaPerTexture.clear();
+
+                QSGAreaAllocator allocator(QSize(textureSize, textureSize * (++textureCount)));
+
+                int i;
+                for (i = 0; i < allocationOrder.size(); ++i) {
+                    GlyphData &glyphData = glyphDatas[allocationOrder.at(i)];
+
+                    QRect rect = allocator.allocate(glyphData.glyphSize);
+                    if (rect.isNull())
+                        break;
+
+                    glyphData.textureIndex = rect.y() / textureSize;
+                    while (glyphData.textureIndex >= allocatedAreaPerTexture.size())
+                        allocatedAreaPerTexture.append(QRect(0, 0, 1, 1));
+
+                    allocatedAreaPerTexture[glyphData.textureIndex] |= QRect(rect.x(),
+                                                        rect.y() % textureSize,
+                                                        rect.width(),
+                                                        rect.height());
+
+                    glyphData.texCoord.xMargin = margin;
+                    glyphData.texCoord.yMargin = margin;
+                    glyphData.texCoord.x = rect.x() + padding;
+                    glyphData.texCoord.y = rect.y() % textureSize + padding;
+                    glyphData.texCoord.width = glyphData.boundingRect.width();
+                    glyphData.texCoord.height = glyphData.boundingRect.height();
+                }
+
+                foundOptimalSize = i == allocationOrder.size();
+                if (foundOptimalSize)
+                    buffer.write(allocator.serialize());
+            }
+        }
+        while (allocatedAreaPerTexture.size() < textureCount)
+            allocatedAreaPerTexture.append(QRect(0, 0, 1, 1));
+
+        QList<QList<int>> glyphsPerTexture(textureCount);
+        for (int textureIndex = 0; textureIndex < textureCount; ++textureIndex) {
+            QRect rect = allocatedAreaPerTexture.at(textureIndex);
+
+            QtdfTextureRecord record;
+            record.allocatedX = qToBigEndian(rect.x());
+            record.allocatedY = qToBigEndian(rect.y());
+            record.allocatedWidth = qToBigEndian(rect.width());
+            record.allocatedHeight = qToBigEndian(rect.height());
+            record.padding = padding;
+            buffer.write(reinterpret_cast<char *>(&record),
+                         sizeof(QtdfTextureRecord));
+        }
+
+        for (int i = 0; i < list.size(); ++i) {
+            const int glyphIndex = int(list.at(i));
+            const GlyphData &glyphData = glyphDatas.at(i);
+
+            QtdfGlyphRecord glyphRecord;
+            glyphRecord.glyphIndex = qToBigEndian(glyphIndex);
+            glyphRecord.textureOffsetX = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.x));
+            glyphRecord.textureOffsetY = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.y));
+            glyphRecord.textureWidth = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.width));
+            glyphRecord.textureHeight = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.height));
+            glyphRecord.xMargin = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.xMargin));
+            glyphRecord.yMargin = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.yMargin));
+            glyphRecord.boundingRectX = qToBigEndian(TO_FIXED_POINT(glyphData.boundingRect.x()));
+            glyphRecord.boundingRectY = qToBigEndian(TO_FIXED_POINT(glyphData.boundingRect.y()));
+            glyphRecord.boundingRectWidth = qToBigEndian(TO_FIXED_POINT(glyphData.boundingRect.width()));
+            glyphRecord.boundingRectHeight = qToBigEndian(TO_FIXED_POINT(glyphData.boundingRect.height()));
+            glyphRecord.textureIndex = qToBigEndian(quint16(glyphData.textureIndex));
+            buffer.write(reinterpret_cast<char *>(&glyphRecord), sizeof(QtdfGlyphRecord));
+
+            glyphsPerTexture[glyphData.textureIndex].append(i);
+        }
+
+        // Only one texture is kept in memory at a time; it is written out
+        // as soon as its glyphs are copied into it.
+        for (int textureIndex = 0; textureIndex < textureCount; ++textureIndex) {
+            const QRect &allocatedArea = allocatedAreaPerTexture.at(textureIndex);
+            QDistanceField texture(allocatedArea.width(), allocatedArea.height());
+
+            for (int i : std::as_const(glyphsPerTexture.at(textureIndex))) {
+                const GlyphData &glyphData = glyphDatas.at(i);
+                QImage image = m_model->distanceField(int(list.at(i)));
+
+                int expectedWidth = qCeil(glyphData.texCoord.width + glyphData.texCoord.xMargin * 2);
+                image = image.copy(-padding, -padding,
+                                   expectedWidth + padding  * 2,
+                                   image.height() + padding * 2);
+
+                uchar *inBits = image.scanLine(0);
+                uchar *outBits = texture.scanLine(int(glyphData.texCoord.y) - padding)
+                                    + int(glyphData.texCoord.x) - padding;
+                for (int y = 0; y < image.height(); ++y) {
+                    memcpy(outBits, inBits, image.width());
+                    inBits += image.bytesPerLine();
+                    outBits += texture.width();
+                }
+            }
+
+            buffer.write(reinterpret_cast<const char *>(texture.constBits()),
+                       allocatedArea.width() * allocatedArea.height());
+        }
+
+        PAD_BUFFER(buffer, ret.size())
+    }
+
+    return ret;
+}
+
+QT_END_NAMESPACE
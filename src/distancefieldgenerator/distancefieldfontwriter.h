@@ -0,0 +1,40 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef DISTANCEFIELDFONTWRITER_H
+#define DISTANCEFIELDFONTWRITER_H
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtGui/private/qtextengine_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class DistanceFieldModel;
+
+// Saves the generated distance fields of a DistanceFieldModel as a qtdf
+// table in a copy of the font file. Needs no widgets.
+class DistanceFieldFontWriter
+{
+    Q_DECLARE_TR_FUNCTIONS(DistanceFieldFontWriter)
+public:
+    explicit DistanceFieldFontWriter(const DistanceFieldModel *model);
+
+    quint32 maximumTextureSize() const { return m_maximumTextureSize; }
+    void setMaximumTextureSize(quint32 size) { m_maximumTextureSize = size; }
+
+    bool write(const QString &fontFile, const QString &fileName, const QList<glyph_t> &glyphs);
+    QString errorString() const { return m_errorString; }
+
+private:
+    QByteArray createSfntTable(const QList<glyph_t> &list);
+
+    const DistanceFieldModel *m_model;
+    quint32 m_maximumTextureSize = 2048;
+    QString m_errorString;
+};
+
+QT_END_NAMESPACE
+
+#endif // DISTANCEFIELDFONTWRITER_H
@@ -18,6 +18,8 @@ DistanceFieldModel::DistanceFieldModel(QObject *parent)
 
     m_rangeEnum = metaObject()->enumerator(index);
 
+    qRegisterMetaType<QList<DistanceFieldModelWorker::DistanceField>>();
+
     m_workerThread.reset(new QThread);
 
     m_worker = new DistanceFieldModelWorker;
@@ -29,12 +31,10 @@ DistanceFieldModel::DistanceFieldModel(QObject *parent)
             this, &DistanceFieldModel::startGeneration);
     connect(m_worker, &DistanceFieldModelWorker::fontLoaded,
             this, &DistanceFieldModel::reserveSpace);
-    connect(m_worker, &DistanceFieldModelWorker::distanceFieldGenerated,
-            this, &DistanceFieldModel::addDistanceField);
+    connect(m_worker, &DistanceFieldModelWorker::distanceFieldsGenerated,
+            this, &DistanceFieldModel::addDistanceFields);
     connect(m_worker, &DistanceFieldModelWorker::fontGenerated,
             this, &DistanceFieldModel::stopGeneration);
-    connect(m_worker, &DistanceFieldModelWorker::distanceFieldGenerated,
-            this, &DistanceFieldModel::distanceFieldGenerated);
     connect(m_worker, &DistanceFieldModelWorker::error,
             this, &DistanceFieldModel::error);
 
@@ -75,7 +75,7 @@ QVariant DistanceFieldModel::data(const QModelIndex &index, int role) const
         return QVariant();
 
     if (role == Qt::DecorationRole) {
-        if (index.row() < m_distanceFields.size()) {
+        if (index.row() < m_distanceFields.size() && !m_distanceFields.at(index.row()).isNull()) {
             return QPixmap::fromImage(m_distanceFields.at(index.row()).scaled(64, 64));
         } else {
             return defaultImage;
@@ -99,17 +99,18 @@ void DistanceFieldModel::reserveSpace(quint16 glyphCount,
 {
     beginResetModel();
     m_glyphsPerUnicodeRange.clear();
-    m_distanceFields.clear();
+    m_glyphsPerUcs4.clear();
     m_glyphCount = glyphCount;
-    if (glyphCount > 0)
-        m_distanceFields.reserve(glyphCount);
+    // The batches of glyphs arrive in any order.
+    m_distanceFields = QList<QImage>(glyphCount);
+    m_paths = QList<QPainterPath>(glyphCount);
     endResetModel();
 
     m_doubleGlyphResolution = doubleResolution;
     m_pixelSize = pixelSize;
 
     QMetaObject::invokeMethod(m_worker,
-                              [this] { m_worker->generateOneDistanceField(); },
+                              [this] { m_worker->generateDistanceFields(); },
                               Qt::QueuedConnection);
 }
 
@@ -144,29 +145,35 @@ QString DistanceFieldModel::nameForUnicodeRange(UnicodeRange range) const
     return QString::fromLatin1(m_rangeEnum.valueToKey(int(range)));
 }
 
-void DistanceFieldModel::addDistanceField(const QImage &distanceField,
-                                          const QPainterPath &path,
-                                          glyph_t glyphId,
-                                          quint32 ucs4)
+void DistanceFieldModel::addDistanceFields(
+        const QList<DistanceFieldModelWorker::DistanceField> &distanceFields)
 {
-    if (glyphId >= quint16(m_distanceFields.size()))
-        m_distanceFields.resize(glyphId + 1);
-    m_distanceFields[glyphId] = distanceField;
-    if (glyphId >= quint16(m_paths.size()))
-        m_paths.resize(glyphId + 1);
-    m_paths[glyphId] = path;
-
-    if (ucs4 != 0) {
-        UnicodeRange range = unicodeRangeForUcs4(ucs4);
-        m_glyphsPerUnicodeRange.insert(range, glyphId);
-        m_glyphsPerUcs4.insert(ucs4, glyphId);
+    if (distanceFields.isEmpty())
+        return;
+
+    glyph_t firstGlyphId = distanceFields.first().glyphId;
+    glyph_t lastGlyphId = firstGlyphId;
+    for (const DistanceFieldModelWorker::DistanceField &distanceField : distanceFields) {
+        const glyph_t glyphId = distanceField.glyphId;
+        if (glyphId >= quint16(m_distanceFields.size()))
+            m_distanceFields.resize(glyphId + 1);
+        m_distanceFields[glyphId] = distanceField.image;
+        if (glyphId >= quint16(m_paths.size()))
+            m_paths.resize(glyphId + 1);
+        m_paths[glyphId] = distanceField.path;
+
+        const quint32 ucs4 = distanceField.cmapAssignment;
+        if (ucs4 != 0) {
+            UnicodeRange range = unicodeRangeForUcs4(ucs4);
+            m_glyphsPerUnicodeRange.insert(range, glyphId);
+            m_glyphsPerUcs4.insert(ucs4, glyphId);
+        }
+        firstGlyphId = qMin(firstGlyphId, glyphId);
+        lastGlyphId = qMax(lastGlyphId, glyphId);
     }
 
-    emit dataChanged(createIndex(glyphId, 0), createIndex(glyphId, 0));
-
-    QMetaObject::invokeMethod(m_worker,
-                             [this] { m_worker->generateOneDistanceField(); },
-                             Qt::QueuedConnection);
+    emit dataChanged(createIndex(int(firstGlyphId), 0), createIndex(int(lastGlyphId), 0));
+    emit distanceFieldsGenerated(int(distanceFields.size()));
 }
 
 glyph_t DistanceFieldModel::glyphIndexForUcs4(quint32 ucs4) const
@@ -4,6 +4,8 @@
 #ifndef DISTANCEFIELDMODEL_H
 #define DISTANCEFIELDMODEL_H
 
+#include "distancefieldmodelworker.h"
+
 #include <QAbstractListModel>
 #include <QRawFont>
 #include <QtGui/qpainterpath.h>
@@ -16,7 +18,6 @@
 QT_BEGIN_NAMESPACE
 
 class QThread;
-class DistanceFieldModelWorker;
 class DistanceFieldModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -180,14 +181,11 @@ public:
 signals:
     void startGeneration(quint16 glyphCount);
     void stopGeneration();
-    void distanceFieldGenerated();
+    void distanceFieldsGenerated(int count);
     void error(const QString &errorString);
 
 private slots:
-    void addDistanceField(const QImage &distanceField,
-                          const QPainterPath &path,
-                          glyph_t glyphId,
-                          quint32 ucs4);
+    void addDistanceFields(const QList<DistanceFieldModelWorker::DistanceField> &distanceFields);
     void reserveSpace(quint16 glyphCount,
                       bool doubleResolution,
                       qreal pixelSize);
@@ -5,6 +5,7 @@
 
 #include "distancefieldmodel.h"
 #include <qendian.h>
+#include <QFile>
 #include <QtGui/private/qdistancefield_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -83,11 +84,16 @@ struct SequentialMapGroup
 DistanceFieldModelWorker::DistanceFieldModelWorker(QObject *parent)
     : QObject(parent)
     , m_glyphCount(0)
-    , m_nextGlyphId(0)
     , m_doubleGlyphResolution(false)
 {
 }
 
+DistanceFieldModelWorker::~DistanceFieldModelWorker()
+{
+    m_generation.fetchAndAddRelaxed(1);
+    m_pool.waitForDone();
+}
+
 template <typename T>
 static void readCmapSubtable(DistanceFieldModelWorker *worker, const QByteArray &cmap, quint32 tableOffset, quint16 format)
 {
@@ -275,7 +281,6 @@ void DistanceFieldModelWorker::readCmap()
 
 void DistanceFieldModelWorker::readGlyphCount()
 {
-    m_nextGlyphId = 0;
     m_glyphCount = 0;
     if (m_font.isValid()) {
         QByteArray maxp = m_font.fontTable("maxp");
@@ -290,7 +295,14 @@ void DistanceFieldModelWorker::readGlyphCount()
 
 void DistanceFieldModelWorker::loadFont(const QString &fileName)
 {
-    m_font = QRawFont(fileName, 64);
+    // Stop generating the fields of the previous font.
+    m_generation.fetchAndAddRelaxed(1);
+    m_pool.waitForDone();
+    m_cmapping.clear();
+
+    QFile file(fileName);
+    m_fontData = file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    m_font = QRawFont(m_fontData, 64);
     if (!m_font.isValid())
         emit error(tr("File '%1' is not a valid font file.").arg(fileName));
 
@@ -305,23 +317,54 @@ void DistanceFieldModelWorker::loadFont(const QString &fileName)
                     pixelSize);
 }
 
-void DistanceFieldModelWorker::generateOneDistanceField()
+void DistanceFieldModelWorker::generateDistanceFields()
 {
-    Q_ASSERT(m_nextGlyphId <= m_glyphCount);
-
-    if (m_nextGlyphId == m_glyphCount) {
+    const int generation = m_generation.loadRelaxed();
+    if (m_glyphCount == 0) {
         emit fontGenerated();
         return;
     }
 
-    QPainterPath path = m_font.pathForGlyph(m_nextGlyphId);
-    QDistanceField distanceField(path, m_nextGlyphId, m_doubleGlyphResolution);
-    emit distanceFieldGenerated(distanceField.toImage(QImage::Format_Alpha8),
-                                path,
-                                m_nextGlyphId,
-                                m_cmapping.value(m_nextGlyphId));
+    // Every batch creates a QRawFont of its own, as the glyph outlines of
+    // one font cannot be read from several threads at once. The batches
+    // are large enough to make that negligible.
+    const quint16 batchSize = 256;
+    const int batchCount = (m_glyphCount + batchSize - 1) / batchSize;
+    m_remainingBatches.storeRelaxed(batchCount);
+    for (int batch = 0; batch < batchCount; ++batch) {
+        const quint16 firstGlyphId = quint16(batch * batchSize);
+        const quint16 glyphCount = qMin<quint16>(batchSize, m_glyphCount - firstGlyphId);
+        m_pool.start([this, generation, firstGlyphId, glyphCount] {
+            generateBatch(generation, firstGlyphId, glyphCount);
+        });
+    }
+}
 
-    m_nextGlyphId++;
+void DistanceFieldModelWorker::generateBatch(int generation, quint16 firstGlyphId,
+                                             quint16 glyphCount)
+{
+    if (m_generation.loadRelaxed() != generation)
+        return;
+
+    const QRawFont font(m_fontData, m_font.pixelSize());
+    QList<DistanceField> distanceFields;
+    distanceFields.reserve(glyphCount);
+    for (quint16 i = 0; i < glyphCount; ++i) {
+        if (m_generation.loadRelaxed() != generation)
+            return;
+        DistanceField distanceField;
+        distanceField.glyphId = firstGlyphId + i;
+        distanceField.path = font.pathForGlyph(distanceField.glyphId);
+        distanceField.image = QDistanceField(distanceField.path, distanceField.glyphId,
+                                             m_doubleGlyphResolution)
+                                      .toImage(QImage::Format_Alpha8);
+        distanceField.cmapAssignment = m_cmapping.value(distanceField.glyphId);
+        distanceFields.append(distanceField);
+    }
+
+    emit distanceFieldsGenerated(distanceFields);
+    if (m_remainingBatches.fetchAndSubOrdered(1) == 1)
+        emit fontGenerated();
 }
 
 QT_END_NAMESPACE
@@ -4,8 +4,13 @@
 #ifndef DISTANCEFIELDMODELWORKER_H
 #define DISTANCEFIELDMODELWORKER_H
 
+#include <QAtomicInt>
+#include <QImage>
+#include <QList>
 #include <QObject>
 #include <QRawFont>
+#include <QThreadPool>
+#include <QtGui/qpainterpath.h>
 #include <QtGui/private/qtextengine_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -19,9 +24,18 @@ class DistanceFieldModelWorker : public QObject
 {
     Q_OBJECT
 public:
+    struct DistanceField
+    {
+        QImage image;
+        QPainterPath path;
+        glyph_t glyphId = 0;
+        quint32 cmapAssignment = 0;
+    };
+
     explicit DistanceFieldModelWorker(QObject *parent = nullptr);
+    ~DistanceFieldModelWorker() override;
 
-    Q_INVOKABLE void generateOneDistanceField();
+    Q_INVOKABLE void generateDistanceFields();
     Q_INVOKABLE void loadFont(const QString &fileName);
 
     void readCmapSubtable(const CmapSubtable0 *subtable, const void *end);
@@ -33,23 +47,29 @@ public:
 signals:
     void fontLoaded(quint16 glyphCount, bool doubleResolution, qreal pixelSize);
     void fontGenerated();
-    void distanceFieldGenerated(const QImage &distanceField,
-                                const QPainterPath &path,
-                                glyph_t glyphId,
-                                quint32 cmapAssignment);
+    void distanceFieldsGenerated(const QList<DistanceFieldModelWorker::DistanceField> &distanceFields);
     void error(const QString &errorString);
 
 private:
     void readGlyphCount();
     void readCmap();
+    void generateBatch(int generation, quint16 firstGlyphId, quint16 glyphCount);
 
     QRawFont m_font;
+    QByteArray m_fontData;
     quint16 m_glyphCount;
-    quint16 m_nextGlyphId;
     bool m_doubleGlyphResolution;
     QHash<glyph_t, quint32> m_cmapping;
+
+    // The glyphs are generated in batches on a pool of their own, so that
+    // loading another font, or destroying the worker, can wait for it.
+    QThreadPool m_pool;
+    QAtomicInt m_generation;
+    QAtomicInt m_remainingBatches;
 };
 
 QT_END_NAMESPACE
 
+Q_DECLARE_METATYPE(QList<DistanceFieldModelWorker::DistanceField>)
+
 #endif // DISTANCEFIELDMODELWORKER_H
@@ -1,19 +1,99 @@
 // Copyright (C) 2018 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include "distancefieldfontwriter.h"
+#include "distancefieldmodel.h"
 #include "mainwindow.h"
 
 #include <QApplication>
 #include <QCommandLineParser>
+#include <QEventLoop>
+#include <QMetaEnum>
+#include <QTextStream>
+
+#include <algorithm>
+#include <memory>
 
 QT_USE_NAMESPACE
 
+static bool isBatchMode(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        const QByteArray arg(argv[i]);
+        if (arg == "-o" || arg == "--output" || arg.startsWith("--output="))
+            return true;
+    }
+    return false;
+}
+
+// Generates the distance fields of the glyphs of fontFile in the Unicode
+// ranges rangeNames, or of all glyphs, and saves them to outputFile.
+static int generateFontCache(const QString &fontFile, const QString &outputFile,
+                             const QStringList &rangeNames, quint32 maximumTextureSize)
+{
+    QTextStream err(stderr);
+    DistanceFieldModel model;
+    QObject::connect(&model, &DistanceFieldModel::error, &model, [&err](const QString &error) {
+        err << error << Qt::endl;
+    });
+
+    QEventLoop loop;
+    QObject::connect(&model, &DistanceFieldModel::stopGeneration, &loop, &QEventLoop::quit);
+    model.setFont(fontFile);
+    loop.exec();
+
+    QList<glyph_t> glyphs;
+    if (rangeNames.isEmpty()) {
+        glyphs.reserve(model.rowCount());
+        for (int i = 0; i < model.rowCount(); ++i)
+            glyphs.append(glyph_t(i));
+    } else {
+        const QMetaEnum rangeEnum = QMetaEnum::fromType<DistanceFieldModel::UnicodeRange>();
+        for (const QString &rangeName : rangeNames) {
+            int range = -1;
+            for (int i = 0; i < rangeEnum.keyCount() && range < 0; ++i) {
+                if (rangeName.compare(QLatin1String(rangeEnum.key(i)), Qt::CaseInsensitive) == 0)
+                    range = rangeEnum.value(i);
+            }
+            if (range < 0) {
+                err << QCoreApplication::translate("main", "Unknown Unicode range '%1'.")
+                                .arg(rangeName)
+                    << Qt::endl;
+                return 1;
+            }
+            if (!model.unicodeRanges().contains(DistanceFieldModel::UnicodeRange(range))) {
+                err << QCoreApplication::translate("main",
+                                                   "The font has no glyphs in the range '%1'.")
+                                .arg(rangeName)
+                    << Qt::endl;
+                continue;
+            }
+            glyphs += model.glyphIndexesForUnicodeRange(DistanceFieldModel::UnicodeRange(range));
+        }
+        std::sort(glyphs.begin(), glyphs.end());
+        glyphs.erase(std::unique(glyphs.begin(), glyphs.end()), glyphs.end());
+    }
+
+    DistanceFieldFontWriter writer(&model);
+    writer.setMaximumTextureSize(maximumTextureSize);
+    if (!writer.write(fontFile, outputFile, glyphs)) {
+        err << writer.errorString() << Qt::endl;
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
-    QApplication app(argc, argv);
-    app.setOrganizationName(QStringLiteral("QtProject"));
-    app.setApplicationName(QStringLiteral("Qt Distance Field Generator"));
-    app.setApplicationVersion(QStringLiteral(QT_VERSION_STR));
+    // The batch mode creates no widgets, and runs without a display.
+    const bool batchMode = isBatchMode(argc, argv);
+    if (batchMode && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    std::unique_ptr<QGuiApplication> app(batchMode ? new QGuiApplication(argc, argv)
+                                                   : new QApplication(argc, argv));
+    app->setOrganizationName(QStringLiteral("QtProject"));
+    app->setApplicationName(QStringLiteral("Qt Distance Field Generator"));
+    app->setApplicationVersion(QStringLiteral(QT_VERSION_STR));
 
     QCommandLineParser parser;
     parser.setApplicationDescription(
@@ -24,12 +104,54 @@ int main(int argc, char **argv)
     parser.addPositionalArgument(QLatin1String("file"),
                                  QCoreApplication::translate("main",
                                                              "Font file (*.ttf, *.otf)"));
-    parser.process(app);
+    QCommandLineOption outputOption(
+            { QStringLiteral("o"), QStringLiteral("output") },
+            QCoreApplication::translate("main",
+                                        "Generate the font cache without a user interface, "
+                                        "and save the font to <file>."),
+            QCoreApplication::translate("main", "file"));
+    parser.addOption(outputOption);
+    QCommandLineOption rangeOption(
+            { QStringLiteral("r"), QStringLiteral("range") },
+            QCoreApplication::translate("main",
+                                        "Only save the glyphs in the Unicode range <name>, "
+                                        "for instance BasicLatin. Can be given several times. "
+                                        "By default, all glyphs are saved."),
+            QCoreApplication::translate("main", "name"));
+    parser.addOption(rangeOption);
+    QCommandLineOption textureSizeOption(
+            QStringLiteral("texture-size"),
+            QCoreApplication::translate("main",
+                                        "The maximum size of the textures. The default is 2048."),
+            QCoreApplication::translate("main", "size"), QStringLiteral("2048"));
+    parser.addOption(textureSizeOption);
+    parser.process(*app);
+
+    if (batchMode) {
+        if (parser.positionalArguments().size() != 1) {
+            QTextStream(stderr) << QCoreApplication::translate("main",
+                                                               "Exactly one font file is needed.")
+                                << Qt::endl;
+            return 1;
+        }
+        bool ok = false;
+        const uint textureSize = parser.value(textureSizeOption).toUInt(&ok);
+        if (!ok || textureSize < 64) {
+            QTextStream(stderr) << QCoreApplication::translate("main",
+                                                               "Invalid texture size '%1'.")
+                                           .arg(parser.value(textureSizeOption))
+                                << Qt::endl;
+            return 1;
+        }
+        return generateFontCache(parser.positionalArguments().constFirst(),
+                                 parser.value(outputOption), parser.values(rangeOption),
+                                 textureSize);
+    }
 
     MainWindow mainWindow;
     if (!parser.positionalArguments().isEmpty())
         mainWindow.open(parser.positionalArguments().constFirst());
     mainWindow.show();
 
-    return app.exec();
+    return app->exec();
 }
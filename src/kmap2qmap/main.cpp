@@ -8,6 +8,7 @@
 #include <QDir>
 #include <QList>
 #include <QByteArray>
+#include <QHash>
 #include <QStringDecoder>
 #include <QStringList>
 #include <QTextStream>
@@ -363,6 +364,40 @@ static const symbol_synonyms_t symbol_synonyms[] = {
 
 static const int symbol_synonyms_size = sizeof(symbol_synonyms)/sizeof(symbol_synonyms_t);
 
+// parseSymbol() is called for every token of every keymap line, so the
+// symbol tables are looked up through hashes built on first use instead of
+// being scanned linearly. The first entry wins for duplicate symbols, as
+// with the linear scan.
+static quint32 qtCodeForSymbol(const QByteArray &sym)
+{
+    static const QHash<QByteArray, quint32> hash = [] {
+        QHash<QByteArray, quint32> result;
+        result.reserve(symbol_map_size);
+        for (int i = 0; i < symbol_map_size; ++i) {
+            const QByteArray symbol = QByteArray::fromRawData(symbol_map[i].symbol, qstrlen(symbol_map[i].symbol));
+            if (!result.contains(symbol))
+                result.insert(symbol, symbol_map[i].qtcode);
+        }
+        return result;
+    }();
+    return hash.value(sym, Qt::Key_unknown);
+}
+
+static QByteArray resolveSymbolSynonym(const QByteArray &sym)
+{
+    static const QHash<QByteArray, QByteArray> hash = [] {
+        QHash<QByteArray, QByteArray> result;
+        result.reserve(symbol_synonyms_size);
+        for (int i = 0; i < symbol_synonyms_size; ++i) {
+            const QByteArray from = QByteArray::fromRawData(symbol_synonyms[i].from, qstrlen(symbol_synonyms[i].from));
+            if (!result.contains(from))
+                result.insert(from, QByteArray::fromRawData(symbol_synonyms[i].to, qstrlen(symbol_synonyms[i].to)));
+        }
+        return result;
+    }();
+    return hash.value(sym, sym);
+}
+
 // makes the generated array in --header mode a bit more human readable
 QT_BEGIN_NAMESPACE
 namespace QEvdevKeyboardMap {
@@ -404,15 +439,64 @@ private:
 
 
 
+// Converts each kmap into a qmap of the same base name in outputDir, so that
+// a whole set of console keymaps can be converted by one process.
+static int convertBatch(const QString &outputDir, int argc, char **argv)
+{
+    const QDir dir(outputDir);
+    if (!dir.exists()) {
+        fprintf(stderr, "Output directory '%s' does not exist.\n", qPrintable(outputDir));
+        return 3;
+    }
+
+    int warningCount = 0;
+    for (int i = 0; i < argc; ++i) {
+        QFile kmap(QString::fromLocal8Bit(argv[i]));
+        if (!kmap.open(QIODevice::ReadOnly)) {
+            fprintf(stderr, "Could not read from '%s'.\n", argv[i]);
+            return 2;
+        }
+        const QString qmapName = dir.filePath(QFileInfo(kmap.fileName()).completeBaseName() + QLatin1String(".qmap"));
+        QFile qmap(qmapName);
+        if (!qmap.open(QIODevice::WriteOnly)) {
+            fprintf(stderr, "Could not write to '%s'.\n", qPrintable(qmapName));
+            return 3;
+        }
+
+        KeymapParser p;
+        if (!p.parseKmap(&kmap)) {
+            fprintf(stderr, "Parsing kmap '%s' failed.\n", qPrintable(kmap.fileName()));
+            return 4;
+        }
+        warningCount += p.parseWarningCount();
+        if (!p.generateQmap(&qmap)) {
+            fprintf(stderr, "Generating the qmap '%s' failed.\n", qPrintable(qmapName));
+            return 5;
+        }
+    }
+
+    if (warningCount) {
+        fprintf(stderr, "\nParsing the specified keymap(s) produced %d warning(s).\n" \
+                        "Your generated qmaps might not be complete.\n", \
+                        warningCount);
+    }
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
+    if (argc >= 4 && !qstrcmp(argv[1], "--batch"))
+        return convertBatch(QString::fromLocal8Bit(argv[2]), argc - 3, argv + 3);
+
     int header = 0;
     if (argc >= 2 && !qstrcmp(argv[1], "--header"))
         header = 1;
 
     if (argc < (3 + header)) {
         fprintf(stderr, "Usage: kmap2qmap [--header] <kmap> [<additional kmaps> ...] <qmap>\n");
+        fprintf(stderr, "       kmap2qmap --batch <output directory> <kmap> [<additional kmaps> ...]\n");
         fprintf(stderr, "  --header   can be used to generate Qt's default compiled in qmap.\n");
+        fprintf(stderr, "  --batch    converts each kmap into a separate qmap in the output directory.\n");
         return 1;
     }
 
@@ -852,12 +936,7 @@ bool KeymapParser::parseSymbol(const QByteArray &str, quint16 &unicode, quint32
         if (!ok)
             return false;
     } else { // symbolic
-        for (int i = 0; i < symbol_synonyms_size; ++i) {
-            if (sym == symbol_synonyms[i].from) {
-                sym = symbol_synonyms[i].to;
-                break;
-            }
-        }
+        sym = resolveSymbolSynonym(sym);
 
         quint32 qtmod = 0;
 
@@ -887,12 +966,7 @@ bool KeymapParser::parseSymbol(const QByteArray &str, quint16 &unicode, quint32
             }
 
             // map symbol to Qt key code
-            for  (int i = 0; i < symbol_map_size; ++i) {
-                if (sym == symbol_map[i].symbol) {
-                    qtcode = symbol_map[i].qtcode;
-                    break;
-                }
-            }
+            qtcode = qtCodeForSymbol(sym);
 
             // a-zA-Z is not in the table to save space
             if (qtcode == Qt::Key_unknown && sym.length() == 1) {
@@ -1,16 +1,34 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include "translationmemory.h"
 #include "translator.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QTranslator>
 #include <QtCore/QLibraryInfo>
 
+#include <algorithm>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#if defined(Q_OS_WIN)
+#  include <qt_windows.h>
+#  include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#  include <sys/resource.h>
+#endif
 
 QT_USE_NAMESPACE
 
@@ -76,8 +94,24 @@ static int usage(const QStringList &args)
         "           Drop line numbers from references to UI files.\n\n"
         "    -pluralonly\n"
         "           Drop non-plural form messages.\n\n"
+        "    -update-translation-memory <tmfile>\n"
+        "           Add the finished translations of the merged input to the\n"
+        "           translation memory <tmfile>, which is created if needed.\n"
+        "           They are stored under the target language of the result.\n"
+        "           Qt Linguist shows guesses from translation memories.\n"
+        "           No output file is written unless -o is given.\n\n"
         "    -verbose\n"
         "           be a bit more verbose\n\n"
+        "    -stats\n"
+        "           Report the number of messages, the time spent reading and\n"
+        "           writing them, and the peak memory use on standard error.\n\n"
+        "    -batch <batchfile>\n"
+        "           Run the conversions listed in <batchfile> in one process, several\n"
+        "           at a time. Each line holds the options and input files of one\n"
+        "           conversion, which must name an output file. Arguments with spaces\n"
+        "           are double-quoted. Empty lines and lines starting with '#' are\n"
+        "           ignored. No other options may be given. The return value is the\n"
+        "           highest one of all conversions.\n\n"
         "Long options can be specified with only one leading dash, too.\n\n"
         "Return value:\n"
         "    0 on success\n"
@@ -93,27 +127,62 @@ struct File
     QString format;
 };
 
-int main(int argc, char *argv[])
+struct LoadedFile
 {
-    QCoreApplication app(argc, argv);
-#ifndef QT_BOOTSTRAPPED
-#ifndef Q_OS_WIN32
-    QTranslator translator;
-    QTranslator qtTranslator;
-    QString sysLocale = QLocale::system().name();
-    QString resourceDir = QLibraryInfo::path(QLibraryInfo::TranslationsPath);
-    if (translator.load(QLatin1String("linguist_") + sysLocale, resourceDir)
-        && qtTranslator.load(QLatin1String("qt_") + sysLocale, resourceDir)) {
-        app.installTranslator(&translator);
-        app.installTranslator(&qtTranslator);
+    Translator translator;
+    ConversionData cd;
+    Translator::Duplicates duplicates;
+    bool ok = false;
+};
+
+// Returns the peak resident set size of the process in bytes, or -1.
+static qint64 peakMemoryUsage()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return qint64(counters.PeakWorkingSetSize);
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#  if defined(Q_OS_DARWIN)
+        return qint64(usage.ru_maxrss);
+#  else
+        return qint64(usage.ru_maxrss) * 1024;
+#  endif
     }
-#endif // Q_OS_WIN32
 #endif
+    return -1;
+}
 
-    QStringList args = app.arguments();
+static QString throughput(qint64 messages, qint64 msecs)
+{
+    return QString::number(msecs > 0 ? messages * 1000 / msecs : messages);
+}
+
+static std::unique_ptr<LoadedFile> loadFile(const File &file, const ConversionData &cd,
+                                            const QString &languageCode)
+{
+    auto loaded = std::make_unique<LoadedFile>();
+    loaded->cd = cd;
+    loaded->cd.clearErrors();
+    loaded->translator.setLanguageCode(languageCode);
+    loaded->ok = loaded->translator.load(file.name, loaded->cd, file.format);
+    if (loaded->ok)
+        loaded->duplicates = loaded->translator.resolveDuplicates();
+    return loaded;
+}
+
+/*
+  Converts the files given in the command line \a args and appends the
+  messages meant for standard error to \a errors. Returns the exit code.
+*/
+static int convert(QStringList args, bool inBatch, QString *errors)
+{
     QList<File> inFiles;
     QString inFormat(QLatin1String("auto"));
     QString outFileName;
+    QString translationMemoryFile;
     QString outFormat(QLatin1String("auto"));
     QString targetLanguage;
     QString sourceLanguage;
@@ -124,6 +193,7 @@ int main(int argc, char *argv[])
     bool verbose = false;
     bool noUiLines = false;
     bool pluralOnly = false;
+    bool stats = false;
     Translator::LocationsType locations = Translator::DefaultLocations;
 
     ConversionData cd;
@@ -193,10 +263,16 @@ int main(int argc, char *argv[])
                 return usage(args);
         } else if (args[i] == QLatin1String("-no-ui-lines")) {
             noUiLines = true;
+        } else if (args[i] == QLatin1String("-update-translation-memory")) {
+            if (++i >= args.size())
+                return usage(args);
+            translationMemoryFile = args[i];
         } else if (args[i] == QLatin1String("-pluralonly")) {
             pluralOnly = true;
         } else if (args[i] == QLatin1String("-verbose")) {
             verbose = true;
+        } else if (args[i] == QLatin1String("-stats")) {
+            stats = true;
         } else if (args[i].startsWith(QLatin1Char('-'))) {
             return usage(args);
         } else {
@@ -209,22 +285,52 @@ int main(int argc, char *argv[])
 
     if (inFiles.isEmpty())
         return usage(args);
+    if (inBatch && translationMemoryFile.isEmpty()
+        && (outFileName.isEmpty() || outFileName == QLatin1String("-"))) {
+        *errors += QStringLiteral("lconvert: Conversions of a batch must name an output file.\n");
+        return 1;
+    }
 
-    tr.setLanguageCode(Translator::guessLanguageCodeFromFileName(inFiles[0].name));
+    QElapsedTimer timer;
+    timer.start();
+    qint64 readMessages = 0;
 
-    if (!tr.load(inFiles[0].name, cd, inFiles[0].format)) {
-        std::cerr << qPrintable(cd.error());
-        return 2;
-    }
-    tr.reportDuplicates(tr.resolveDuplicates(), inFiles[0].name, verbose);
+    /*
+      Inputs are parsed ahead on worker threads, a few at a time so that
+      not all of them are held in memory, and merged in the given order.
+    */
+    const size_t window = std::max(2u, std::thread::hardware_concurrency());
+    std::deque<std::future<std::unique_ptr<LoadedFile>>> pending;
+    int nextToLoad = 0;
+    for (int i = 0; i < inFiles.size(); ++i) {
+        while (nextToLoad < inFiles.size() && pending.size() < window) {
+            const QString languageCode = nextToLoad == 0
+                    ? Translator::guessLanguageCodeFromFileName(inFiles[0].name) : QString();
+            pending.push_back(std::async(std::launch::async, loadFile, inFiles[nextToLoad], cd,
+                                         languageCode));
+            ++nextToLoad;
+        }
+        const std::unique_ptr<LoadedFile> loaded = pending.front().get();
+        pending.pop_front();
 
-    for (int i = 1; i < inFiles.size(); ++i) {
-        Translator tr2;
-        if (!tr2.load(inFiles[i].name, cd, inFiles[i].format)) {
-            std::cerr << qPrintable(cd.error());
+        cd.m_sourceDir = loaded->cd.m_sourceDir;
+        cd.m_sourceFileName = loaded->cd.m_sourceFileName;
+        for (const QString &error : loaded->cd.errors())
+            cd.appendError(error);
+        if (!loaded->ok) {
+            *errors += cd.error();
             return 2;
         }
-        tr2.reportDuplicates(tr2.resolveDuplicates(), inFiles[i].name, verbose);
+
+        Translator &tr2 = loaded->translator;
+        std::ostringstream duplicates;
+        tr2.reportDuplicates(loaded->duplicates, inFiles[i].name, verbose, duplicates);
+        *errors += QString::fromStdString(duplicates.str());
+        readMessages += tr2.messageCount();
+        if (i == 0) {
+            tr = std::move(tr2);
+            continue;
+        }
         for (int j = 0; j < tr2.messageCount(); ++j)
             tr.replaceSorted(tr2.message(j));
 
@@ -256,12 +362,155 @@ int main(int argc, char *argv[])
 
     tr.normalizeTranslations(cd);
     if (!cd.errors().isEmpty()) {
-        std::cerr << qPrintable(cd.error());
+        *errors += cd.error();
         cd.clearErrors();
     }
-    if (!tr.save(outFileName, cd, outFormat)) {
-        std::cerr << qPrintable(cd.error());
+    const qint64 readTime = timer.restart();
+    if (!translationMemoryFile.isEmpty()) {
+        qsizetype added = 0;
+        QString errorString;
+        // Jobs of a batch may update the same translation memory.
+        static std::mutex translationMemoryMutex;
+        std::lock_guard lock(translationMemoryMutex);
+        if (!TranslationMemoryDatabase::update(translationMemoryFile, { &tr }, &added,
+                                               &errorString)) {
+            *errors += errorString + u'\n';
+            return 3;
+        }
+        if (verbose) {
+            *errors += QStringLiteral("Added %1 translation(s) to %2\n")
+                               .arg(added).arg(translationMemoryFile);
+        }
+    }
+    if ((translationMemoryFile.isEmpty() || !outFileName.isEmpty())
+        && !tr.save(outFileName, cd, outFormat)) {
+        *errors += cd.error();
         return 3;
     }
+
+    if (stats) {
+        const qint64 writeTime = timer.elapsed();
+        const qint64 peak = peakMemoryUsage();
+        *errors += QStringLiteral(
+                "Read and merged %1 message(s) from %2 file(s) in %3 ms (%4 messages/s)\n"
+                "Wrote %5 message(s) in %6 ms (%7 messages/s)\n"
+                "Peak memory use: %8\n")
+                .arg(readMessages).arg(inFiles.size()).arg(readTime)
+                .arg(throughput(readMessages, readTime))
+                .arg(tr.messageCount()).arg(writeTime)
+                .arg(throughput(tr.messageCount(), writeTime))
+                .arg(peak < 0 ? QStringLiteral("unknown")
+                              : QStringLiteral("%1 MiB").arg(peak / (1024 * 1024)));
+    }
     return 0;
 }
+
+struct BatchJob
+{
+    int line;
+    QStringList args;
+};
+
+// Splits a line of a batch file into arguments. Double quotes group
+// arguments that contain spaces.
+static QStringList splitBatchLine(QStringView line)
+{
+    QStringList args;
+    QString arg;
+    bool inArg = false;
+    bool quoted = false;
+    for (QChar c : line) {
+        if (c == u'"') {
+            quoted = !quoted;
+            inArg = true;
+        } else if (!quoted && c.isSpace()) {
+            if (inArg)
+                args.append(std::exchange(arg, QString()));
+            inArg = false;
+        } else {
+            arg += c;
+            inArg = true;
+        }
+    }
+    if (inArg)
+        args.append(arg);
+    return args;
+}
+
+static int runBatch(const QString &program, const QString &batchFileName)
+{
+    QFile batchFile(batchFileName);
+    if (!batchFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        std::cerr << qPrintable(QStringLiteral("lconvert: Cannot open %1: %2\n")
+                                .arg(batchFileName, batchFile.errorString()));
+        return 2;
+    }
+    QList<BatchJob> jobs;
+    int lineNumber = 0;
+    while (!batchFile.atEnd()) {
+        ++lineNumber;
+        const QString line = QString::fromUtf8(batchFile.readLine()).trimmed();
+        if (line.isEmpty() || line.startsWith(u'#'))
+            continue;
+        jobs.append({ lineNumber, QStringList(program) + splitBatchLine(line) });
+    }
+
+    /*
+      The conversions run on worker threads, a few at a time, and their
+      messages are printed in the order of the batch file.
+    */
+    const size_t window = std::max(2u, std::thread::hardware_concurrency());
+    std::deque<std::future<std::pair<int, QString>>> pending;
+    qsizetype nextToRun = 0;
+    int result = 0;
+    for (const BatchJob &job : std::as_const(jobs)) {
+        while (nextToRun < jobs.size() && pending.size() < window) {
+            pending.push_back(std::async(std::launch::async, [args = jobs[nextToRun].args] {
+                QString errors;
+                const int exitCode = convert(args, true, &errors);
+                return std::make_pair(exitCode, errors);
+            }));
+            ++nextToRun;
+        }
+        const auto [exitCode, errors] = pending.front().get();
+        pending.pop_front();
+        if (!errors.isEmpty()) {
+            std::cerr << qPrintable(QStringLiteral("%1:%2:\n%3")
+                                    .arg(batchFileName).arg(job.line).arg(errors));
+        }
+        result = std::max(result, exitCode);
+    }
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+#ifndef QT_BOOTSTRAPPED
+#ifndef Q_OS_WIN32
+    QTranslator translator;
+    QTranslator qtTranslator;
+    QString sysLocale = QLocale::system().name();
+    QString resourceDir = QLibraryInfo::path(QLibraryInfo::TranslationsPath);
+    if (translator.load(QLatin1String("linguist_") + sysLocale, resourceDir)
+        && qtTranslator.load(QLatin1String("qt_") + sysLocale, resourceDir)) {
+        app.installTranslator(&translator);
+        app.installTranslator(&qtTranslator);
+    }
+#endif // Q_OS_WIN32
+#endif
+
+
+    QStringList args = app.arguments();
+    if (args.size() > 1 && (args[1] == QLatin1String("-batch")
+                            || args[1] == QLatin1String("--batch"))) {
+        if (args.size() != 3)
+            return usage(args);
+        return runBatch(args[0], args[2]);
+    }
+
+    QString errors;
+    const int exitCode = convert(args, false, &errors);
+    std::cerr << qPrintable(errors);
+    return exitCode;
+}
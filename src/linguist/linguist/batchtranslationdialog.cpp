@@ -5,10 +5,20 @@
 #include "phrase.h"
 #include "messagemodel.h"
 
+#include <QtCore/QEventLoop>
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QProgressDialog>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 CheckableListModel::CheckableListModel(QObject *parent)
@@ -71,8 +81,17 @@ void BatchTranslationDialog::setPhraseBooks(const QList<PhraseBook *> &phraseboo
     m_model.sort(0);
 }
 
+/*
+  The phrases of the checked phrase books are hashed by their source text,
+  in the order the user specified in the phrasebookList, so that the first
+  matching phrase wins. The messages are then matched against the hash on
+  the thread pool, and the translations are applied in a single pass.
+*/
 void BatchTranslationDialog::startTranslation()
 {
+    using Match = std::pair<MultiDataIndex, QString>;
+    using Messages = QList<std::pair<MultiDataIndex, QString>>;
+
     int translatedcount = 0;
     QCursor oldCursor = cursor();
     setCursor(Qt::BusyCursor);
@@ -82,41 +101,83 @@ void BatchTranslationDialog::startTranslation()
     dlgProgress = new QProgressDialog(tr("Searching, please wait..."), tr("&Cancel"), 0, messageCount, this);
     dlgProgress->show();
 
-    int msgidx = 0;
+    QHash<QString, QString> targets;
+    for (int b = 0; b < m_model.rowCount(); ++b) {
+        QModelIndex idx(m_model.index(b, 0));
+        QVariant checkState = m_model.data(idx, Qt::CheckStateRole);
+        if (checkState == Qt::Checked) {
+            PhraseBook *pb = m_phrasebooks[m_model.data(idx, Qt::UserRole).toInt()];
+            const auto phrases = pb->phrases();
+            for (const Phrase *ph : phrases) {
+                if (!targets.contains(ph->source()))
+                    targets.insert(ph->source(), ph->target());
+            }
+        }
+    }
+
     const bool translateTranslated = m_ui.ckTranslateTranslated->isChecked();
     const bool translateFinished = m_ui.ckTranslateFinished->isChecked();
+    const qsizetype chunkSize = std::max(1, messageCount / (4 * QThread::idealThreadCount()));
+    const auto matchedCount = std::make_shared<std::atomic<int>>(0);
+    QList<QFuture<QList<Match>>> chunks;
+    Messages messages;
+    const auto startChunk = [&] {
+        if (messages.isEmpty())
+            return;
+        chunks.append(QtFuture::makeReadyValueFuture(std::move(messages))
+                .then(QtFuture::Launch::Async,
+                      [targets, matchedCount](const Messages &messages) {
+                          QList<Match> matches;
+                          for (const auto &[index, text] : messages) {
+                              const auto it = targets.constFind(text);
+                              if (it != targets.cend())
+                                  matches.emplace_back(index, it.value());
+                          }
+                          *matchedCount += int(messages.size());
+                          return matches;
+                      }));
+        messages = Messages();
+    };
+    int candidateCount = 0;
     for (MultiDataModelIterator it(m_dataModel, m_modelIndex); it.isValid(); ++it) {
         if (MessageItem *m = it.current()) {
             if (!m->isObsolete()
                 && (translateTranslated || m->translation().isEmpty())
                 && (translateFinished || !m->isFinished())) {
-
-                // Go through them in the order the user specified in the phrasebookList
-                for (int b = 0; b < m_model.rowCount(); ++b) {
-                    QModelIndex idx(m_model.index(b, 0));
-                    QVariant checkState = m_model.data(idx, Qt::CheckStateRole);
-                    if (checkState == Qt::Checked) {
-                        PhraseBook *pb = m_phrasebooks[m_model.data(idx, Qt::UserRole).toInt()];
-                        const auto phrases = pb->phrases();
-                        for (const Phrase *ph : phrases) {
-                            if (ph->source() == m->text()) {
-                                m_dataModel->setTranslation(it, ph->target());
-                                m_dataModel->setFinished(it, m_ui.ckMarkFinished->isChecked());
-                                ++translatedcount;
-                                goto done; // break 2;
-                            }
-                        }
-                    }
-                }
+                messages.emplace_back(it, m->text());
+                ++candidateCount;
+                if (messages.size() == chunkSize)
+                    startChunk();
+            }
+        }
+    }
+    startChunk();
+
+    // Keep the dialog responsive until all chunks are matched.
+    QEventLoop loop;
+    QTimer progressTimer;
+    dlgProgress->setMaximum(candidateCount);
+    connect(&progressTimer, &QTimer::timeout, dlgProgress, [&] {
+        dlgProgress->setValue(matchedCount->load());
+    });
+    connect(dlgProgress, &QProgressDialog::canceled, &loop, &QEventLoop::quit);
+    progressTimer.start(50);
+    QtFuture::whenAll(chunks.begin(), chunks.end())
+            .then(&loop, [&loop](const QList<QFuture<QList<Match>>> &) { loop.quit(); });
+    if (!std::all_of(chunks.cbegin(), chunks.cend(), [](const auto &f) { return f.isFinished(); }))
+        loop.exec();
+    progressTimer.stop();
+
+    if (!dlgProgress->wasCanceled()) {
+        dlgProgress->setLabelText(tr("Translating, please wait..."));
+        const bool markFinished = m_ui.ckMarkFinished->isChecked();
+        for (const QFuture<QList<Match>> &chunk : std::as_const(chunks)) {
+            for (const auto &[index, target] : chunk.result()) {
+                m_dataModel->setTranslation(index, target);
+                m_dataModel->setFinished(index, markFinished);
+                ++translatedcount;
             }
         }
-      done:
-        ++msgidx;
-        if (!(msgidx & 15))
-            dlgProgress->setValue(msgidx);
-        qApp->processEvents();
-        if (dlgProgress->wasCanceled())
-            break;
     }
     dlgProgress->hide();
 
@@ -460,8 +460,10 @@ static void highlightTargets(const QList<TranslatableEntry> &targets, bool on)
         highlightTarget(target, on);
 }
 
+static const int MaxCachedForms = 4;
+
 FormPreviewView::FormPreviewView(QWidget *parent, MultiDataModel *dataModel)
-  : QMainWindow(parent), m_form(0), m_dataModel(dataModel)
+  : QMainWindow(parent), m_dataModel(dataModel)
 {
     m_mdiSubWindow = new QMdiSubWindow;
     m_mdiSubWindow->setWindowFlags(m_mdiSubWindow->windowFlags() & ~Qt::WindowSystemMenuHint);
@@ -472,22 +474,42 @@ FormPreviewView::FormPreviewView(QWidget *parent, MultiDataModel *dataModel)
     m_mdiArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
 }
 
-void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
+FormPreviewView::~FormPreviewView()
 {
-    if (model < 0 || !messageItem) {
-        m_lastModel = -1;
-        return;
+    for (Form &form : m_forms)
+        destroyTargets(&form.targets);
+}
+
+/*
+  Detaches the shown form from the sub window, and keeps it as a hidden
+  child of the view for later reuse.
+*/
+void FormPreviewView::hideForm()
+{
+    m_currentFileName.clear();
+    if (QWidget *widget = m_mdiSubWindow->widget()) {
+        m_mdiSubWindow->setWidget(nullptr);
+        widget->hide();
+        widget->setParent(this);
     }
+    m_mdiSubWindow->hide();
+}
 
-    QDir dir = QFileInfo(m_dataModel->srcFileName(model)).dir();
-    QString fileName = QDir::cleanPath(dir.absoluteFilePath(messageItem->fileName()));
-    if (m_lastFormName != fileName) {
-        delete m_form;
-        m_form = 0;
-        m_lastFormName.clear();
-        m_highlights.clear();
-        destroyTargets(&m_targets);
+/*
+  Shows the form \a fileName, loading it unless it is cached, and returns
+  it, or returns nullptr if it cannot be loaded.
+*/
+FormPreviewView::Form *FormPreviewView::showForm(const QString &fileName,
+                                                 const QString &className)
+{
+    hideForm();
 
+    qsizetype index = 0;
+    while (index < m_forms.size() && m_forms.at(index).fileName != fileName)
+        ++index;
+    if (index < m_forms.size()) {
+        m_forms.move(index, 0);
+    } else {
         static QUiLoader *uiLoader;
         if (!uiLoader) {
             uiLoader = new QUiLoader(this);
@@ -498,44 +520,73 @@ void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
         QFile file(fileName);
         if (!file.open(QIODevice::ReadOnly)) {
             qDebug() << "CANNOT OPEN FORM" << fileName;
-            m_mdiSubWindow->hide();
-            return;
+            return nullptr;
         }
-        m_form = uiLoader->load(&file, m_mdiSubWindow);
-        if (!m_form) {
+        Form form;
+        form.widget = uiLoader->load(&file, this);
+        if (!form.widget) {
             qDebug() << "CANNOT LOAD FORM" << fileName;
-            m_mdiSubWindow->hide();
-            return;
+            return nullptr;
         }
         file.close();
-        buildTargets(m_form, &m_targets);
-
-        setToolTip(fileName);
-
-        m_form->setWindowFlags(Qt::Widget);
-        m_form->setWindowModality(Qt::NonModal);
-        m_form->setFocusPolicy(Qt::NoFocus);
-        m_form->show(); // needed, otherwide the Qt::NoFocus is not propagated.
-        m_mdiSubWindow->setWidget(m_form);
-        m_mdiSubWindow->setWindowTitle(m_form->windowTitle());
-        m_mdiSubWindow->show();
-        m_mdiArea->cascadeSubWindows();
-        m_lastFormName = fileName;
-        m_lastClassName = messageItem->context();
+        form.fileName = fileName;
+        form.className = className;
+        buildTargets(form.widget, &form.targets);
+
+        form.widget->setWindowFlags(Qt::Widget);
+        form.widget->setWindowModality(Qt::NonModal);
+        form.widget->setFocusPolicy(Qt::NoFocus);
+        m_forms.prepend(form);
+        while (m_forms.size() > MaxCachedForms) {
+            Form evicted = m_forms.takeLast();
+            destroyTargets(&evicted.targets);
+            delete evicted.widget;
+        }
+    }
+
+    Form &form = m_forms.first();
+    setToolTip(fileName);
+    m_mdiSubWindow->setWidget(form.widget);
+    form.widget->show(); // needed, otherwide the Qt::NoFocus is not propagated.
+    m_mdiSubWindow->setWindowTitle(form.widget->windowTitle());
+    m_mdiSubWindow->show();
+    m_mdiArea->cascadeSubWindows();
+    m_currentFileName = fileName;
+    return &form;
+}
+
+void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
+{
+    if (model < 0 || !messageItem) {
         m_lastModel = -1;
+        return;
+    }
+
+    QDir dir = QFileInfo(m_dataModel->srcFileName(model)).dir();
+    QString fileName = QDir::cleanPath(dir.absoluteFilePath(messageItem->fileName()));
+    highlightTargets(m_highlights, false);
+    m_highlights.clear();
+    Form *form = nullptr;
+    if (m_currentFileName == fileName && !m_forms.isEmpty()) {
+        form = &m_forms.first();
     } else {
-        highlightTargets(m_highlights, false);
+        form = showForm(fileName, messageItem->context());
+        if (!form)
+            return;
+        // The translations may have changed while the form was not shown.
+        m_lastModel = -1;
     }
+
     QUiTranslatableStringValue tsv;
     tsv.setValue(messageItem->text().toUtf8());
     tsv.setQualifier(messageItem->comment().toUtf8());
-    m_highlights = m_targets.value(tsv);
+    m_highlights = form->targets.value(tsv);
     if (m_lastModel != model) {
-        for (auto it = m_targets.cbegin(), end = m_targets.cend(); it != end; ++it)
-            retranslateTargets(*it, it.key(), m_dataModel->model(model), m_lastClassName);
+        for (auto it = form->targets.cbegin(), end = form->targets.cend(); it != end; ++it)
+            retranslateTargets(*it, it.key(), m_dataModel->model(model), form->className);
         m_lastModel = model;
     } else {
-        retranslateTargets(m_highlights, tsv, m_dataModel->model(model), m_lastClassName);
+        retranslateTargets(m_highlights, tsv, m_dataModel->model(model), form->className);
     }
     highlightTargets(m_highlights, true);
 }
@@ -67,21 +67,32 @@ class FormPreviewView : public QMainWindow
     Q_OBJECT
 public:
     FormPreviewView(QWidget *parent, MultiDataModel *dataModel);
+    ~FormPreviewView();
 
     void setSourceContext(int model, MessageItem *messageItem);
 
 private:
+    struct Form
+    {
+        QString fileName;
+        QString className;
+        QWidget *widget = nullptr;
+        TargetsHash targets;
+    };
+
+    Form *showForm(const QString &fileName, const QString &className);
+    void hideForm();
+
     QString m_currentFileName;
     QMdiArea *m_mdiArea;
     QMdiSubWindow *m_mdiSubWindow;
-    QWidget *m_form;
-    TargetsHash m_targets;
+    // The most recently shown forms, the most recent one first. Switching
+    // back to one of them only retranslates it.
+    QList<Form> m_forms;
     QList<TranslatableEntry> m_highlights;
     MultiDataModel *m_dataModel;
 
-    QString m_lastFormName;
-    QString m_lastClassName;
-    int m_lastModel;
+    int m_lastModel = -1;
 };
 
 QT_END_NAMESPACE
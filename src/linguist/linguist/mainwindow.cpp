@@ -19,9 +19,11 @@
 #include "phrasemodel.h"
 #include "phraseview.h"
 #include "printout.h"
+#include "searchindex.h"
 #include "sourcecodeview.h"
 #include "statistics.h"
 #include "translatedialog.h"
+#include "translationmemory.h"
 #include "translationsettingsdialog.h"
 
 #include <QAction>
@@ -33,6 +35,7 @@
 #include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QFuture>
 #include <QHeaderView>
 #include <QInputDialog>
 #include <QItemDelegate>
@@ -61,6 +64,8 @@
 #include <QPrinter>
 #endif
 
+#include <algorithm>
+
 #include <ctype.h>
 
 QT_BEGIN_NAMESPACE
@@ -341,6 +346,7 @@ MainWindow::MainWindow()
     m_phrasesDock->setWindowTitle(tr("Phrases and guesses"));
 
     m_phraseView = new PhraseView(m_dataModel, &m_phraseDict, this);
+    m_searchIndex = new SearchIndex(m_dataModel, this);
     m_phrasesDock->setWidget(m_phraseView);
 
     // Set up source code and form preview dock widget
@@ -441,6 +447,15 @@ MainWindow::MainWindow()
             this, &MainWindow::translationChanged);
     connect(m_dataModel, &MultiDataModel::languageChanged,
             this, &MainWindow::updatePhraseDict);
+    // Pending validation results refer to messages by their index.
+    connect(m_dataModel, &MultiDataModel::modelDeleted, this, [this] {
+        m_validationSettings.clear();
+        ++m_validationGeneration;
+    });
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted, this, [this] {
+        m_validationSettings.clear();
+        ++m_validationGeneration;
+    });
 
     setWindowModified(m_dataModel->isModified());
     m_modifiedLabel->setVisible(m_dataModel->isModified());
@@ -766,12 +781,118 @@ QStringList MainWindow::pickTranslationFiles()
         fileFilters(true));
 }
 
+/*
+  Takes a snapshot of the messages of \a model, and writes it on the thread
+  pool. The model is marked as saved once the file has been written, unless
+  it was modified in the meantime.
+*/
 void MainWindow::saveInternal(int model)
 {
+    const QString fileName = m_dataModel->srcFileName(model);
+    // Never write the same file from two threads at once.
+    waitForSaves(fileName);
+
+    const int id = ++m_saveSequence;
+    PendingSave &save = m_pendingSaves[id];
+    save.fileName = fileName;
+    save.sourceFileName = fileName;
+    save.revision = m_dataModel->revision(model);
+    save.result = QtFuture::makeReadyValueFuture(m_dataModel->snapshot(model))
+            .then(QtFuture::Launch::Async, [fileName](Translator tor) {
+                SaveResult result;
+                result.ok = DataModel::write(&tor, fileName, &result.errors);
+                return result;
+            });
+    save.result.then(this, [this, id](const SaveResult &) { finishSave(id); });
+    statusBar()->showMessage(tr("Saving %n file(s)...", nullptr, pendingCount(false)));
+}
+
+/*
+  Like saveInternal(), for releasing \a model to the .qm file \a fileName.
+  Release All thus compiles the languages in parallel.
+*/
+void MainWindow::releaseInBackground(int model, const QString &fileName)
+{
+    waitForSaves(fileName);
+
+    const int id = ++m_saveSequence;
+    PendingSave &save = m_pendingSaves[id];
+    save.fileName = fileName;
+    save.sourceFileName = m_dataModel->srcFileName(model);
+    save.release = true;
+    save.result = QtFuture::makeReadyValueFuture(m_dataModel->releaseSnapshot(model))
+            .then(QtFuture::Launch::Async, [fileName](const Translator &tor) {
+                SaveResult result;
+                result.ok = DataModel::writeQm(tor, fileName, false, false, SaveEverything,
+                                               &result.errors);
+                return result;
+            });
+    save.result.then(this, [this, id](const SaveResult &) { finishSave(id); });
+    statusBar()->showMessage(tr("Releasing %n file(s)...", nullptr, pendingCount(true)));
+}
+
+int MainWindow::pendingCount(bool release) const
+{
+    return int(std::count_if(m_pendingSaves.cbegin(), m_pendingSaves.cend(),
+                             [release](const PendingSave &save) {
+                                 return save.release == release;
+                             }));
+}
+
+void MainWindow::finishSave(int id)
+{
+    const auto it = m_pendingSaves.find(id);
+    if (it == m_pendingSaves.end())
+        return;
+    const PendingSave save = it.value();
+    m_pendingSaves.erase(it);
+
+    const SaveResult result = save.result.result();
+    if (save.release) {
+        if (result.ok) {
+            statusBar()->showMessage(
+                    tr("Released %1").arg(DataModel::prettifyPlainFileName(save.fileName)),
+                    MessageMS);
+        }
+    } else {
+        const int model = m_dataModel->isFileLoaded(save.fileName);
+        if (result.ok && model >= 0 && m_dataModel->revision(model) == save.revision) {
+            m_dataModel->setModified(model, false);
+            updateCaption();
+        }
+        if (result.ok) {
+            statusBar()->showMessage(
+                    tr("Saved %1").arg(DataModel::prettifyPlainFileName(save.fileName)),
+                    MessageMS);
+        }
+    }
+    if (!result.errors.isEmpty())
+        QMessageBox::warning(this, tr("Qt Linguist"), result.errors);
+}
+
+/*
+  Blocks until the pending saves and releases of \a fileName, or of all
+  files if it is empty, are written, and applies their results. A .ts file
+  name also matches the releases of its model.
+*/
+void MainWindow::waitForSaves(const QString &fileName)
+{
+    QList<int> ids;
+    for (auto it = m_pendingSaves.cbegin(); it != m_pendingSaves.cend(); ++it) {
+        if (fileName.isEmpty() || it->fileName == fileName || it->sourceFileName == fileName)
+            ids.append(it.key());
+    }
+    if (ids.isEmpty())
+        return;
+
     QApplication::setOverrideCursor(Qt::WaitCursor);
-    if (m_dataModel->save(model, this)) {
-        updateCaption();
-        statusBar()->showMessage(tr("File saved."), MessageMS);
+    for (int id : std::as_const(ids)) {
+        const auto it = m_pendingSaves.constFind(id);
+        if (it != m_pendingSaves.cend()) {
+            QFuture<SaveResult> result = it->result;
+            result.waitForFinished();
+            finishSave(id);
+        }
     }
     QApplication::restoreOverrideCursor();
 }
@@ -800,6 +921,7 @@ void MainWindow::saveAs()
     QString newFilename = QFileDialog::getSaveFileName(this, QString(), m_dataModel->srcFileName(m_currentIndex.model()),
         fileFilters(false));
     if (!newFilename.isEmpty()) {
+        waitForSaves();
         if (m_dataModel->saveAs(m_currentIndex.model(), newFilename, this)) {
             updateCaption();
             statusBar()->showMessage(tr("File saved."), MessageMS);
@@ -819,10 +941,8 @@ void MainWindow::releaseAs()
 
     newFilename = QFileDialog::getSaveFileName(this, tr("Release"), newFilename,
         tr("Qt message files for released applications (*.qm)\nAll files (*)"));
-    if (!newFilename.isEmpty()) {
-        if (m_dataModel->release(m_currentIndex.model(), newFilename, false, false, SaveEverything, this))
-            statusBar()->showMessage(tr("File created."), MessageMS);
-    }
+    if (!newFilename.isEmpty())
+        releaseInBackground(m_currentIndex.model(), newFilename);
 }
 
 void MainWindow::releaseInternal(int model)
@@ -831,10 +951,8 @@ void MainWindow::releaseInternal(int model)
     QString newFilename = oldFile.path() + QLatin1Char('/')
                 + oldFile.completeBaseName() + QLatin1String(".qm");
 
-    if (!newFilename.isEmpty()) {
-        if (m_dataModel->release(model, newFilename, false, false, SaveEverything, this))
-            statusBar()->showMessage(tr("File created."), MessageMS);
-    }
+    if (!newFilename.isEmpty())
+        releaseInBackground(model, newFilename);
 }
 
 // No-question
@@ -968,16 +1086,24 @@ void MainWindow::findAgain(FindDirection direction)
     if (m_dataModel->contextCount() == 0)
         return;
 
+    // Messages which the search index rules out are skipped without looking at them.
+    QSet<SearchIndex::Message> candidates;
+    const bool useCandidates = !m_findOptions.testFlag(FindDialog::UseRegExp)
+            && m_searchIndex->findCandidates(m_findText, &candidates);
+
     const QModelIndex &startIndex = m_messageView->currentIndex();
     QModelIndex index = (direction == FindNext
             ? nextMessage(startIndex)
             : prevMessage(startIndex));
 
-    while (index.isValid()) {
+    while (index.isValid() && !(useCandidates && candidates.isEmpty())) {
         QModelIndex realIndex = m_sortedMessagesModel->mapToSource(index);
         MultiDataIndex dataIndex = m_messageModel->dataIndex(realIndex, -1);
+        const bool mayMatch = !useCandidates
+                || candidates.contains(SearchIndex::Message(dataIndex.context(),
+                                                            dataIndex.message()));
         bool hadMessage = false;
-        for (int i = 0; i < m_dataModel->modelCount(); ++i) {
+        for (int i = 0; mayMatch && i < m_dataModel->modelCount(); ++i) {
             if (MessageItem *m = m_dataModel->messageItem(dataIndex, i)) {
                 if (m_findStatusFilter != -1 && m_findStatusFilter != m->type())
                     continue;
@@ -1188,6 +1314,92 @@ void MainWindow::openPhraseBook()
     }
 }
 
+void MainWindow::openTranslationMemory()
+{
+    const QString name = QFileDialog::getOpenFileName(this, tr("Open Translation Memory"),
+            m_phraseBookDir, tr("Qt translation memories (*.qtm);;All files (*)"));
+    if (!name.isEmpty()) {
+        m_phraseBookDir = QFileInfo(name).absolutePath();
+        loadTranslationMemory(name);
+    }
+}
+
+/*
+  The index of a translation memory built from many translation files can
+  be large, so it is read on a worker thread. The phrase view keeps using
+  the previous one until it is available.
+*/
+void MainWindow::loadTranslationMemory(const QString &fileName)
+{
+    using Result = std::pair<std::shared_ptr<const TranslationMemoryDatabase>, QString>;
+    m_translationMemoryFile = fileName;
+    QtFuture::makeReadyValueFuture(fileName)
+            .then(QtFuture::Launch::Async, [](const QString &fileName) {
+                auto database = std::make_shared<TranslationMemoryDatabase>();
+                QString errorString;
+                if (!database->open(fileName, &errorString))
+                    return Result(nullptr, errorString);
+                return Result(std::move(database), QString());
+            })
+            .then(this, [this, fileName](const Result &result) {
+                if (fileName != m_translationMemoryFile)
+                    return;
+                if (!result.first) {
+                    m_translationMemoryFile.clear();
+                    QMessageBox::warning(this, tr("Qt Linguist"), result.second);
+                    return;
+                }
+                m_phraseView->setTranslationMemoryDatabase(result.first);
+                statusBar()->showMessage(tr("%n translation(s) in the translation memory.", 0,
+                                            int(result.first->size())), MessageMS);
+            });
+}
+
+void MainWindow::addToTranslationMemory()
+{
+    QString fileName = m_translationMemoryFile;
+    if (fileName.isEmpty()) {
+        fileName = QFileDialog::getSaveFileName(this, tr("Create Translation Memory"),
+                m_phraseBookDir, tr("Qt translation memories (*.qtm);;All files (*)"));
+        if (fileName.isEmpty())
+            return;
+        m_phraseBookDir = QFileInfo(fileName).absolutePath();
+    }
+
+    QList<Translator> translators(m_dataModel->modelCount());
+    for (int i = 0; i < m_dataModel->modelCount(); ++i) {
+        DataModel *model = m_dataModel->model(i);
+        for (DataModelIterator it(model); it.isValid(); ++it)
+            translators[i].append(it.current()->message());
+        translators[i].setLanguageCode(
+                Translator::makeLanguageCode(model->language(), model->territory()));
+    }
+
+    // The whole memory is rewritten, which is done on a worker thread.
+    m_ui.actionAddToTranslationMemory->setEnabled(false);
+    m_translationMemoryUpdate = QtFuture::makeReadyValueFuture(std::move(translators))
+            .then(QtFuture::Launch::Async, [fileName](const QList<Translator> &translators) {
+                QList<const Translator *> translatorPointers;
+                for (const Translator &translator : translators)
+                    translatorPointers.append(&translator);
+                TranslationMemoryUpdate result;
+                result.ok = TranslationMemoryDatabase::update(fileName, translatorPointers,
+                                                              &result.added,
+                                                              &result.errorString);
+                return result;
+            });
+    m_translationMemoryUpdate.then(this, [this, fileName](const TranslationMemoryUpdate &result) {
+        m_ui.actionAddToTranslationMemory->setEnabled(m_dataModel->modelCount() > 0);
+        if (!result.ok) {
+            QMessageBox::warning(this, tr("Qt Linguist"), result.errorString);
+            return;
+        }
+        statusBar()->showMessage(tr("%n translation(s) added to the translation memory.",
+                                    0, int(result.added)), MessageMS);
+        loadTranslationMemory(fileName);
+    });
+}
+
 void MainWindow::closePhraseBook(QAction *action)
 {
     PhraseBook *pb = m_phraseBookMenu[PhraseCloseMenu].value(action);
@@ -1373,14 +1585,19 @@ void MainWindow::setupPhrase()
 #if QT_CONFIG(printsupport)
     m_ui.menuPrintPhraseBook->setEnabled(enabled);
 #endif
+    m_ui.actionAddToTranslationMemory->setEnabled(m_dataModel->modelCount() > 0
+                                                  && m_translationMemoryUpdate.isFinished());
 }
 
 void MainWindow::closeEvent(QCloseEvent *e)
 {
-    if (maybeSaveAll() && maybeSavePhraseBooks())
+    if (maybeSaveAll() && maybeSavePhraseBooks()) {
+        waitForSaves();
+        m_translationMemoryUpdate.waitForFinished();
         e->accept();
-    else
+    } else {
         e->ignore();
+    }
 }
 
 bool MainWindow::maybeSaveAll()
@@ -1396,6 +1613,7 @@ bool MainWindow::maybeSaveAll()
             return false;
         case QMessageBox::Yes:
             saveAll();
+            waitForSaves();
             return !m_dataModel->isModified();
         default:
             break;
@@ -1416,6 +1634,7 @@ bool MainWindow::maybeSave(int model)
             return false;
         case QMessageBox::Yes:
             saveInternal(model);
+            waitForSaves(m_dataModel->srcFileName(model));
             return !m_dataModel->isModified(model);
         default:
             break;
@@ -1550,6 +1769,7 @@ void MainWindow::updateTranslation(const QStringList &translations)
         return;
 
     m->setTranslations(translations);
+    m_searchIndex->messageChanged(m_currentIndex);
     if (!m->fileName().isEmpty() && hasFormPreview(m->fileName()))
         m_formPreviewView->setSourceContext(m_currentIndex.model(), m);
     updateDanger(m_currentIndex, true);
@@ -1569,6 +1789,7 @@ void MainWindow::updateTranslatorComment(const QString &comment)
         return;
 
     m->setTranslatorComment(comment);
+    m_searchIndex->messageChanged(m_currentIndex);
 
     m_dataModel->setModified(m_currentIndex.model(), true);
 }
@@ -1783,21 +2004,9 @@ void MainWindow::findNext(const QString &text, DataModel::FindLocation where,
     findAgain();
 }
 
-void MainWindow::revalidate()
-{
-    for (MultiDataModelIterator it(m_dataModel, -1); it.isValid(); ++it)
-        updateDanger(it, false);
-
-    if (m_currentIndex.isValid())
-        updateDanger(m_currentIndex, true);
-}
-
 QString MainWindow::friendlyString(const QString& str)
 {
-    QString f = str.toLower();
-    f.replace(QRegularExpression(QString(QLatin1String("[.,:;!?()-]"))), QString(QLatin1String(" ")));
-    f.remove(QLatin1Char('&'));
-    return f.simplified();
+    return Phrase::friendlyString(str);
 }
 
 void MainWindow::setupMenuBar()
@@ -1923,6 +2132,10 @@ void MainWindow::setupMenuBar()
 #endif
     connect(m_ui.actionAddToPhraseBook, &QAction::triggered,
             this, &MainWindow::addToPhraseBook);
+    connect(m_ui.actionOpenTranslationMemory, &QAction::triggered,
+            this, &MainWindow::openTranslationMemory);
+    connect(m_ui.actionAddToTranslationMemory, &QAction::triggered,
+            this, &MainWindow::addToTranslationMemory);
 
     // Validation menu
     connect(m_ui.actionAccelerators, &QAction::triggered, this, &MainWindow::revalidate);
@@ -2266,6 +2479,8 @@ void MainWindow::setCurrentMessage(const QModelIndex &index, int model)
 void MainWindow::setCurrentMessageFromGuess(int modelIndex, const Candidate &cand)
 {
     int contextIndex = m_dataModel->findContextIndex(cand.context);
+    if (contextIndex < 0)
+        return;
     int messageIndex = m_dataModel->multiContextItem(contextIndex)->findMessage(cand.source,
                                                                                 cand.disambiguation);
     setCurrentMessage(m_messageModel->modelIndex(MultiDataIndex(modelIndex, contextIndex,
@@ -2393,6 +2608,7 @@ void MainWindow::updatePhraseBookActions()
 
 void MainWindow::updatePhraseDictInternal(int model)
 {
+    m_validationSettings.clear();
     QHash<QString, QList<Phrase *> > &pd = m_phraseDict[model];
 
     pd.clear();
@@ -2405,18 +2621,16 @@ void MainWindow::updatePhraseDictInternal(int model)
         } else {
             before = false;
         }
-        const auto phrases = pb->phrases();
-        for (Phrase *p : phrases) {
-            QString f = friendlyString(p->source());
-            if (f.size() > 0) {
-                f = f.split(QLatin1Char(' ')).first();
-                if (!pd.contains(f)) {
-                    pd.insert(f, QList<Phrase *>());
-                }
-                if (before)
-                    pd[f].prepend(p);
-                else
-                    pd[f].append(p);
+        const auto &wordIndex = pb->wordIndex();
+        for (auto it = wordIndex.cbegin(); it != wordIndex.cend(); ++it) {
+            QList<Phrase *> &phrases = pd[it.key()];
+            if (before) {
+                // Prepend in reverse book order, as the phrases used to be
+                // prepended one by one.
+                QList<Phrase *> reversed(it->crbegin(), it->crend());
+                phrases = reversed + phrases;
+            } else {
+                phrases += *it;
             }
         }
     }
@@ -2466,6 +2680,205 @@ static bool haveMnemonic(const QString &str)
     return false;
 }
 
+/*
+  The validation options and phrase books of one model, copied so that
+  messages can be validated on worker threads.
+*/
+struct ValidationSettings
+{
+    bool accelerators = false;
+    bool surroundingWhitespace = false;
+    bool endingPunctuation = false;
+    bool phraseMatches = false;
+    bool placeMarkers = false;
+    QLocale::Language sourceLanguage = QLocale::C;
+    QLocale::Language language = QLocale::C;
+    QList<bool> countRefNeeds;
+    // The first word of the friendly source text of each phrase, to the
+    // friendly source texts and targets of the phrases starting with it.
+    QHash<QString, QList<std::pair<QString, QString>>> phrases;
+};
+
+using ValidationErrors = QList<std::pair<ErrorsView::ErrorType, QString>>;
+
+/*
+  Returns whether the \a translations of a message with the given
+  \a source text are dangerous, and adds the reasons to \a errors if it is
+  not null. This only depends on its arguments, so it can be called from
+  any thread.
+*/
+static bool isDangerous(const ValidationSettings &settings, const QString &source,
+                        QStringList translations, bool plural, ValidationErrors *errors)
+{
+    const auto addError = [errors](ErrorsView::ErrorType type, const QString &arg = QString()) {
+        if (errors)
+            errors->emplace_back(type, arg);
+    };
+    bool danger = false;
+
+    // Truncated variants are permitted to be "denormalized"
+    for (int i = 0; i < translations.size(); ++i) {
+        int sep = translations.at(i).indexOf(Translator::BinaryVariantSeparator);
+        if (sep >= 0)
+            translations[i].truncate(sep);
+    }
+
+    if (settings.accelerators) {
+        bool sk = haveMnemonic(source);
+        bool tk = true;
+        for (int i = 0; i < translations.size() && tk; ++i) {
+            tk &= haveMnemonic(translations[i]);
+        }
+
+        if (!sk && tk) {
+            addError(ErrorsView::SuperfluousAccelerator);
+            danger = true;
+        } else if (sk && !tk) {
+            addError(ErrorsView::MissingAccelerator);
+            danger = true;
+        }
+    }
+    if (settings.surroundingWhitespace) {
+        bool whitespaceok = true;
+        for (int i = 0; i < translations.size() && whitespaceok; ++i) {
+            whitespaceok &= (leadingWhitespace(source) == leadingWhitespace(translations[i]));
+            whitespaceok &= (trailingWhitespace(source) == trailingWhitespace(translations[i]));
+        }
+
+        if (!whitespaceok) {
+            addError(ErrorsView::SurroundingWhitespaceDiffers);
+            danger = true;
+        }
+    }
+    if (settings.endingPunctuation) {
+        bool endingok = true;
+        for (int i = 0; i < translations.size() && endingok; ++i) {
+            endingok &= (ending(source, settings.sourceLanguage) ==
+                        ending(translations[i], settings.language));
+        }
+
+        if (!endingok) {
+            addError(ErrorsView::PunctuationDiffers);
+            danger = true;
+        }
+    }
+    if (settings.phraseMatches) {
+        QString fsource = MainWindow::friendlyString(source);
+        QString ftranslation = MainWindow::friendlyString(translations.first());
+        QStringList lookupWords = fsource.split(QLatin1Char(' '));
+
+        bool phraseFound;
+        for (const QString &s : std::as_const(lookupWords)) {
+            const auto it = settings.phrases.constFind(s);
+            if (it != settings.phrases.cend()) {
+                phraseFound = true;
+                for (const auto &[phraseSource, phraseTarget] : it.value()) {
+                    if (fsource == phraseSource) {
+                        if (ftranslation.indexOf(phraseTarget) >= 0) {
+                            phraseFound = true;
+                            break;
+                        } else {
+                            phraseFound = false;
+                        }
+                    }
+                }
+                if (!phraseFound) {
+                    addError(ErrorsView::IgnoredPhrasebook, s);
+                    danger = true;
+                }
+            }
+        }
+    }
+
+    if (settings.placeMarkers) {
+        // Stores the occurrence count of the place markers in the map placeMarkerIndexes.
+        // i.e. the occurrence count of %1 is stored at placeMarkerIndexes[1],
+        // count of %2 is stored at placeMarkerIndexes[2] etc.
+        // In the first pass, it counts all place markers in the sourcetext.
+        // In the second pass it (de)counts all place markers in the translation.
+        // When finished, all elements should have returned to a count of 0,
+        // if not there is a mismatch
+        // between place markers in the source text and the translation text.
+        QHash<int, int> placeMarkerIndexes;
+        QString translation;
+        int numTranslations = translations.size();
+        for (int pass = 0; pass < numTranslations + 1; ++pass) {
+            const QChar *uc_begin = source.unicode();
+            const QChar *uc_end = uc_begin + source.size();
+            if (pass >= 1) {
+                translation = translations[pass - 1];
+                uc_begin = translation.unicode();
+                uc_end = uc_begin + translation.size();
+            }
+            const QChar *c = uc_begin;
+            while (c < uc_end) {
+                if (c->unicode() == '%') {
+                    const QChar *escape_start = ++c;
+                    while (c->isDigit())
+                        ++c;
+                    const QChar *escape_end = c;
+                    bool ok = true;
+                    int markerIndex = QString::fromRawData(
+                            escape_start, escape_end - escape_start).toInt(&ok);
+                    if (ok)
+                        placeMarkerIndexes[markerIndex] += (pass == 0 ? numTranslations : -1);
+                } else {
+                    ++c;
+                }
+            }
+        }
+
+        for (int i : std::as_const(placeMarkerIndexes)) {
+            if (i != 0) {
+                addError(ErrorsView::PlaceMarkersDiffer);
+                danger = true;
+                break;
+            }
+        }
+
+        // Piggy-backed on the general place markers, we check the plural count marker.
+        if (plural) {
+            for (int i = 0; i < numTranslations; ++i)
+                if (settings.countRefNeeds.at(i)
+                    && !(translations[i].contains(QLatin1String("%n"))
+                    || translations[i].contains(QLatin1String("%Ln")))) {
+                    addError(ErrorsView::NumerusMarkerMissing);
+                    danger = true;
+                    break;
+                }
+        }
+    }
+    return danger;
+}
+
+const ValidationSettings &MainWindow::validationSettings(int model)
+{
+    if (m_validationSettings.size() != m_dataModel->modelCount()) {
+        m_validationSettings.clear();
+        for (int mi = 0; mi < m_dataModel->modelCount(); ++mi) {
+            ValidationSettings settings;
+            settings.accelerators = m_ui.actionAccelerators->isChecked();
+            settings.surroundingWhitespace = m_ui.actionSurroundingWhitespace->isChecked();
+            settings.endingPunctuation = m_ui.actionEndingPunctuation->isChecked();
+            settings.phraseMatches = m_ui.actionPhraseMatches->isChecked();
+            settings.placeMarkers = m_ui.actionPlaceMarkerMatches->isChecked();
+            settings.sourceLanguage = m_dataModel->sourceLanguage(mi);
+            settings.language = m_dataModel->language(mi);
+            settings.countRefNeeds = m_dataModel->model(mi)->countRefNeeds();
+            if (mi < m_phraseDict.size()) {
+                for (auto it = m_phraseDict.at(mi).cbegin(); it != m_phraseDict.at(mi).cend(); ++it) {
+                    auto &phrases = settings.phrases[it.key()];
+                    for (const Phrase *p : it.value())
+                        phrases.emplace_back(friendlyString(p->source()),
+                                             friendlyString(p->target()));
+                }
+            }
+            m_validationSettings.append(settings);
+        }
+    }
+    return m_validationSettings.at(model);
+}
+
 void MainWindow::updateDanger(const MultiDataIndex &index, bool verbose)
 {
     MultiDataIndex curIdx = index;
@@ -2487,155 +2900,116 @@ void MainWindow::updateDanger(const MultiDataIndex &index, bool verbose)
                 if (source.isEmpty())
                     source = m->text();
             }
-            QStringList translations = m->translations();
+            ValidationErrors errors;
+            danger = isDangerous(validationSettings(mi), source, m->translations(),
+                                 m->message().isPlural(), verbose ? &errors : nullptr);
+            for (const auto &[type, arg] : std::as_const(errors))
+                m_errorsView->addError(mi, type, arg);
+        }
 
-            // Truncated variants are permitted to be "denormalized"
-            for (int i = 0; i < translations.size(); ++i) {
-                int sep = translations.at(i).indexOf(Translator::BinaryVariantSeparator);
-                if (sep >= 0)
-                    translations[i].truncate(sep);
-            }
+        if (danger != m->danger())
+            m_dataModel->setDanger(curIdx, danger);
+    }
 
-            if (m_ui.actionAccelerators->isChecked()) {
-                bool sk = haveMnemonic(source);
-                bool tk = true;
-                for (int i = 0; i < translations.size() && tk; ++i) {
-                    tk &= haveMnemonic(translations[i]);
-                }
+    if (verbose)
+        statusBar()->showMessage(m_errorsView->firstError());
+}
 
-                if (!sk && tk) {
-                    if (verbose)
-                        m_errorsView->addError(mi, ErrorsView::SuperfluousAccelerator);
-                    danger = true;
-                } else if (sk && !tk) {
-                    if (verbose)
-                        m_errorsView->addError(mi, ErrorsView::MissingAccelerator);
-                    danger = true;
-                }
-            }
-            if (m_ui.actionSurroundingWhitespace->isChecked()) {
-                bool whitespaceok = true;
-                for (int i = 0; i < translations.size() && whitespaceok; ++i) {
-                    whitespaceok &= (leadingWhitespace(source) == leadingWhitespace(translations[i]));
-                    whitespaceok &= (trailingWhitespace(source) == trailingWhitespace(translations[i]));
-                }
+namespace {
 
-                if (!whitespaceok) {
-                    if (verbose)
-                        m_errorsView->addError(mi, ErrorsView::SurroundingWhitespaceDiffers);
-                    danger = true;
-                }
-            }
-            if (m_ui.actionEndingPunctuation->isChecked()) {
-                bool endingok = true;
-                for (int i = 0; i < translations.size() && endingok; ++i) {
-                    endingok &= (ending(source, m_dataModel->sourceLanguage(mi)) ==
-                                ending(translations[i], m_dataModel->language(mi)));
-                }
+struct ValidationItem
+{
+    MultiDataIndex index;
+    QString source;
+    QStringList translations;
+    bool plural = false;
+    bool danger = false;
+};
 
-                if (!endingok) {
-                    if (verbose)
-                        m_errorsView->addError(mi, ErrorsView::PunctuationDiffers);
-                    danger = true;
-                }
-            }
-            if (m_ui.actionPhraseMatches->isChecked()) {
-                QString fsource = friendlyString(source);
-                QString ftranslation = friendlyString(translations.first());
-                QStringList lookupWords = fsource.split(QLatin1Char(' '));
-
-                bool phraseFound;
-                for (const QString &s : std::as_const(lookupWords)) {
-                    if (m_phraseDict[mi].contains(s)) {
-                        phraseFound = true;
-                        const auto phrases = m_phraseDict[mi].value(s);
-                        for (const Phrase *p : phrases) {
-                            if (fsource == friendlyString(p->source())) {
-                                if (ftranslation.indexOf(friendlyString(p->target())) >= 0) {
-                                    phraseFound = true;
-                                    break;
-                                } else {
-                                    phraseFound = false;
-                                }
-                            }
-                        }
-                        if (!phraseFound) {
-                            if (verbose)
-                                m_errorsView->addError(mi, ErrorsView::IgnoredPhrasebook, s);
-                            danger = true;
-                        }
-                    }
-                }
-            }
+} // namespace
 
-            if (m_ui.actionPlaceMarkerMatches->isChecked()) {
-                // Stores the occurrence count of the place markers in the map placeMarkerIndexes.
-                // i.e. the occurrence count of %1 is stored at placeMarkerIndexes[1],
-                // count of %2 is stored at placeMarkerIndexes[2] etc.
-                // In the first pass, it counts all place markers in the sourcetext.
-                // In the second pass it (de)counts all place markers in the translation.
-                // When finished, all elements should have returned to a count of 0,
-                // if not there is a mismatch
-                // between place markers in the source text and the translation text.
-                QHash<int, int> placeMarkerIndexes;
-                QString translation;
-                int numTranslations = translations.size();
-                for (int pass = 0; pass < numTranslations + 1; ++pass) {
-                    const QChar *uc_begin = source.unicode();
-                    const QChar *uc_end = uc_begin + source.size();
-                    if (pass >= 1) {
-                        translation = translations[pass - 1];
-                        uc_begin = translation.unicode();
-                        uc_end = uc_begin + translation.size();
-                    }
-                    const QChar *c = uc_begin;
-                    while (c < uc_end) {
-                        if (c->unicode() == '%') {
-                            const QChar *escape_start = ++c;
-                            while (c->isDigit())
-                                ++c;
-                            const QChar *escape_end = c;
-                            bool ok = true;
-                            int markerIndex = QString::fromRawData(
-                                    escape_start, escape_end - escape_start).toInt(&ok);
-                            if (ok)
-                                placeMarkerIndexes[markerIndex] += (pass == 0 ? numTranslations : -1);
-                        } else {
-                            ++c;
-                        }
-                    }
-                }
+/*
+  Validates all messages on the thread pool, in chunks of messages that
+  are copied on the GUI thread. The danger flags of each chunk are applied
+  when it is done, unless the message has been edited in the meantime,
+  or the validation has been restarted or the files have changed.
+*/
+void MainWindow::revalidate()
+{
+    m_validationSettings.clear();
+    const quint64 generation = ++m_validationGeneration;
+    const int chunkSize = 1000;
 
-                for (int i : std::as_const(placeMarkerIndexes)) {
-                    if (i != 0) {
-                        if (verbose)
-                            m_errorsView->addError(mi, ErrorsView::PlaceMarkersDiffer);
-                        danger = true;
-                        break;
+    QList<ValidationItem> chunk;
+    const auto startChunk = [&] {
+        if (chunk.isEmpty())
+            return;
+        QtFuture::makeReadyValueFuture(std::move(chunk))
+                .then(QtFuture::Launch::Async,
+                      [settings = m_validationSettings](QList<ValidationItem> items) {
+                          for (ValidationItem &item : items) {
+                              if (!item.translations.isEmpty()) {
+                                  item.danger = isDangerous(settings.at(item.index.model()),
+                                                            item.source, item.translations,
+                                                            item.plural, nullptr);
+                              }
+                          }
+                          return items;
+                      })
+                .then(this, [this, generation](const QList<ValidationItem> &items) {
+                    if (generation != m_validationGeneration)
+                        return;
+                    m_applyingValidation = true;
+                    for (const ValidationItem &item : items) {
+                        MessageItem *m = m_dataModel->messageItem(item.index);
+                        if (!m || m->isObsolete() || item.index == m_currentIndex)
+                            continue;
+                        const QStringList translations =
+                                m->message().isTranslated() ? m->translations() : QStringList();
+                        if (translations != item.translations)
+                            continue;
+                        if (item.danger != m->danger())
+                            m_dataModel->setDanger(item.index, item.danger);
                     }
+                    m_applyingValidation = false;
+                    updateStatistics();
+                });
+        chunk = QList<ValidationItem>();
+    };
+
+    for (int mi = 0; mi < m_dataModel->modelCount(); ++mi)
+        validationSettings(mi);
+    for (MultiDataModelIterator it(m_dataModel, -1); it.isValid(); ++it) {
+        MultiDataIndex curIdx = it;
+        QString source;
+        for (int mi = 0; mi < m_dataModel->modelCount(); ++mi) {
+            if (!m_dataModel->isModelWritable(mi))
+                continue;
+            curIdx.setModel(mi);
+            MessageItem *m = m_dataModel->messageItem(curIdx);
+            if (!m || m->isObsolete())
+                continue;
+            ValidationItem item;
+            item.index = curIdx;
+            if (m->message().isTranslated()) {
+                if (source.isEmpty()) {
+                    source = m->pluralText();
+                    if (source.isEmpty())
+                        source = m->text();
                 }
-
-                // Piggy-backed on the general place markers, we check the plural count marker.
-                if (m->message().isPlural()) {
-                    for (int i = 0; i < numTranslations; ++i)
-                        if (m_dataModel->model(mi)->countRefNeeds().at(i)
-                            && !(translations[i].contains(QLatin1String("%n"))
-                            || translations[i].contains(QLatin1String("%Ln")))) {
-                            if (verbose)
-                                m_errorsView->addError(mi, ErrorsView::NumerusMarkerMissing);
-                            danger = true;
-                            break;
-                        }
-                }
+                item.source = source;
+                item.translations = m->translations();
+                item.plural = m->message().isPlural();
             }
+            chunk.append(std::move(item));
+            if (chunk.size() == chunkSize)
+                startChunk();
         }
-
-        if (danger != m->danger())
-            m_dataModel->setDanger(curIdx, danger);
     }
+    startChunk();
 
-    if (verbose)
-        statusBar()->showMessage(m_errorsView->firstError());
+    if (m_currentIndex.isValid())
+        updateDanger(m_currentIndex, true);
 }
 
 void MainWindow::readConfig()
@@ -2673,6 +3047,11 @@ void MainWindow::readConfig()
         doOpenPhraseBook(config.value(QLatin1String("FileName")).toString());
     }
     config.endArray();
+
+    const QString translationMemory =
+            config.value(settingPath("Options/TranslationMemory")).toString();
+    if (!translationMemory.isEmpty() && QFile::exists(translationMemory))
+        loadTranslationMemory(translationMemory);
 }
 
 void MainWindow::writeConfig()
@@ -2696,6 +3075,7 @@ void MainWindow::writeConfig()
         m_ui.actionVisualizeWhitespace->isChecked());
     config.setValue(settingPath("MainWindowState"),
         saveState());
+    config.setValue(settingPath("Options/TranslationMemory"), m_translationMemoryFile);
     m_recentFiles.writeConfig();
 
     config.setValue(settingPath("Options/EditorFontsize"), m_messageEditor->fontSize());
@@ -2756,6 +3136,9 @@ void MainWindow::toggleVisualizeWhitespace()
 
 void MainWindow::maybeUpdateStatistics(const MultiDataIndex &index)
 {
+    // Validation results are applied in batches, followed by a single update.
+    if (m_applyingValidation)
+        return;
     if (index.model() == m_currentIndex.model())
         updateStatistics();
 }
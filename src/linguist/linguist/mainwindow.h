@@ -12,6 +12,7 @@
 
 #include <QtCore/private/qconfig_p.h>
 
+#include <QtCore/QFuture>
 #include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QLocale>
@@ -39,10 +40,12 @@ class FocusWatcher;
 class FormPreviewView;
 class MessageEditor;
 class PhraseView;
+class SearchIndex;
 class SourceCodeView;
 class Statistics;
 class TranslateDialog;
 class TranslationSettingsDialog;
+struct ValidationSettings;
 
 class MainWindow : public QMainWindow
 {
@@ -93,6 +96,8 @@ private slots:
     void closePhraseBook(QAction *action);
     void editPhraseBook(QAction *action);
     void addToPhraseBook();
+    void openTranslationMemory();
+    void addToTranslationMemory();
     void manual();
     void resetSorting();
     void about();
@@ -166,6 +171,7 @@ private:
     bool savePhraseBook(QString *name, PhraseBook &pb);
     bool maybeSavePhraseBook(PhraseBook *phraseBook);
     bool maybeSavePhraseBooks();
+    void loadTranslationMemory(const QString &fileName);
     QStringList pickTranslationFiles();
     void doShowTranslationSettings(int model);
     void doUpdateLatestModel(int model);
@@ -173,7 +179,11 @@ private:
     void updatePhraseBookActions();
     void updatePhraseDictInternal(int model);
     void releaseInternal(int model);
+    void releaseInBackground(int model, const QString &fileName);
+    int pendingCount(bool release) const;
     void saveInternal(int model);
+    void finishSave(int id);
+    void waitForSaves(const QString &fileName = QString());
 
 #if QT_CONFIG(printsupport)
     QPrinter *printer();
@@ -181,6 +191,7 @@ private:
 
     // FIXME: move to DataModel
     void updateDanger(const MultiDataIndex &index, bool verbose);
+    const ValidationSettings &validationSettings(int model);
 
     bool searchItem(DataModel::FindLocation where, const QString &searchWhat);
 
@@ -193,6 +204,7 @@ private:
     QSortFilterProxyModel *m_sortedMessagesModel;
     MessageEditor *m_messageEditor;
     PhraseView *m_phraseView;
+    SearchIndex *m_searchIndex;
     QStackedWidget *m_sourceAndFormView;
     SourceCodeView *m_sourceCodeView;
     FormPreviewView *m_formPreviewView;
@@ -205,6 +217,38 @@ private:
     QList<QHash<QString, QList<Phrase *> > > m_phraseDict;
     QList<PhraseBook *> m_phraseBooks;
     QMap<QAction *, PhraseBook *> m_phraseBookMenu[3];
+    // Snapshots of the validation options and phrase books per model, see
+    // validationSettings(); cleared whenever either changes.
+    QList<ValidationSettings> m_validationSettings;
+    quint64 m_validationGeneration = 0;
+    bool m_applyingValidation = false;
+    QString m_translationMemoryFile;
+    // The rewrite of the translation memory running on the thread pool.
+    struct TranslationMemoryUpdate
+    {
+        bool ok = false;
+        qsizetype added = 0;
+        QString errorString;
+    };
+    QFuture<TranslationMemoryUpdate> m_translationMemoryUpdate;
+    // Saves and releases that are running on the thread pool, by the order
+    // they were started.
+    struct SaveResult
+    {
+        bool ok = false;
+        QString errors;
+    };
+    struct PendingSave
+    {
+        QString fileName;
+        // The .ts file of the model, which is fileName unless releasing.
+        QString sourceFileName;
+        int revision = 0;
+        bool release = false;
+        QFuture<SaveResult> result;
+    };
+    QMap<int, PendingSave> m_pendingSaves;
+    int m_saveSequence = 0;
 #if QT_CONFIG(printsupport)
     QPrinter *m_printer = nullptr;
 #endif
@@ -8,6 +8,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QSet>
 
 #include <QtWidgets/QMessageBox>
 #include <QtGui/QPainter>
@@ -78,7 +79,12 @@ static QString showNcr(const QString &str)
 
 static QString adjustNcrVisibility(const QString &str, bool ncrMode)
 {
-    return ncrMode ? showNcr(str) : resolveNcr(str);
+    if (ncrMode)
+        return showNcr(str);
+    // Share the string instead of copying it when there is nothing to resolve.
+    if (!str.contains(u"&#"))
+        return str;
+    return resolveNcr(str);
 }
 
 QT_BEGIN_NAMESPACE
@@ -108,6 +114,7 @@ bool MessageItem::compare(const QString &findText, bool matchSubstring,
 void MessageItem::setTranslation(const QString &translation)
 {
     m_message.setTranslation(resolveNcr(translation));
+    m_translationCounts.reset();
 }
 
 QString MessageItem::text() const
@@ -142,6 +149,18 @@ void MessageItem::setTranslations(const QStringList &translations)
         trans.append(resolveNcr(t));
 
     m_message.setTranslations(trans);
+    m_translationCounts.reset();
+}
+
+const MessageItem::TextCounts &MessageItem::translationCounts() const
+{
+    if (!m_translationCounts) {
+        TextCounts counts;
+        for (const QString &trnsl : translations())
+            DataModel::doCharCounting(trnsl, counts.words, counts.chars, counts.charsSpaces);
+        m_translationCounts = counts;
+    }
+    return *m_translationCounts;
 }
 
 /******************************************************************************
@@ -398,7 +417,11 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
     return true;
 }
 
-bool DataModel::save(const QString &fileName, QWidget *parent)
+/*
+  Returns a Translator with copies of all messages and the file settings,
+  which write() can save independently of this model.
+*/
+Translator DataModel::snapshot()
 {
     Translator tor;
     for (DataModelIterator it(this); it.isValid(); ++it)
@@ -409,13 +432,31 @@ bool DataModel::save(const QString &fileName, QWidget *parent)
     tor.setLocationsType(m_relativeLocations ? Translator::RelativeLocations
                                              : Translator::AbsoluteLocations);
     tor.setExtras(m_extra);
+    return tor;
+}
+
+/*
+  Saves the snapshot \a tor to \a fileName. Touches no model, so it may
+  run on any thread; errors and warnings are stored in \a errors.
+*/
+bool DataModel::write(Translator *tor, const QString &fileName, QString *errors)
+{
     ConversionData cd;
-    tor.normalizeTranslations(cd);
-    bool ok = tor.save(fileName, cd, QLatin1String("auto"));
+    tor->normalizeTranslations(cd);
+    bool ok = tor->save(fileName, cd, QLatin1String("auto"));
+    *errors = cd.error();
+    return ok;
+}
+
+bool DataModel::save(const QString &fileName, QWidget *parent)
+{
+    Translator tor = snapshot();
+    QString errors;
+    bool ok = write(&tor, fileName, &errors);
     if (ok)
         setModified(false);
-    if (!cd.error().isEmpty())
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), cd.error());
+    if (!errors.isEmpty())
+        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), errors);
     return ok;
 }
 
@@ -427,20 +468,32 @@ bool DataModel::saveAs(const QString &newFileName, QWidget *parent)
     return true;
 }
 
-bool DataModel::release(const QString &fileName, bool verbose, bool ignoreUnfinished,
-    TranslatorSaveMode mode, QWidget *parent)
+/*
+  Returns a Translator with copies of all messages and the language, which
+  writeQm() can release independently of this model.
+*/
+Translator DataModel::releaseSnapshot()
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::WriteOnly)) {
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"),
-            tr("Cannot create '%2': %1").arg(file.errorString()).arg(fileName));
-        return false;
-    }
     Translator tor;
     QLocale locale(m_language, m_territory);
     tor.setLanguageCode(locale.name());
     for (DataModelIterator it(this); it.isValid(); ++it)
         tor.append(it.current()->message());
+    return tor;
+}
+
+/*
+  Releases the snapshot \a tor to the .qm file \a fileName. Touches no model,
+  so it may run on any thread; errors are stored in \a errors.
+*/
+bool DataModel::writeQm(const Translator &tor, const QString &fileName, bool verbose,
+    bool ignoreUnfinished, TranslatorSaveMode mode, QString *errors)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *errors = tr("Cannot create '%2': %1").arg(file.errorString()).arg(fileName);
+        return false;
+    }
     ConversionData cd;
     cd.m_verbose = verbose;
     cd.m_ignoreUnfinished = ignoreUnfinished;
@@ -450,7 +503,7 @@ bool DataModel::release(const QString &fileName, bool verbose, bool ignoreUnfini
                         [](const TranslatorMessage &message) { return !message.id().isEmpty(); });
     bool ok = saveQM(tor, file, cd);
     if (!ok)
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), cd.error());
+        *errors = cd.error();
     return ok;
 }
 
@@ -529,22 +582,20 @@ void DataModel::updateStatistics()
         if (mi->isObsolete()) {
             stats.obsoleteMsg++;
         } else if (mi->isFinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsFinished, stats.charsFinished, stats.charsSpacesFinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
+            const MessageItem::TextCounts &counts = mi->translationCounts();
+            stats.wordsFinished += counts.words;
+            stats.charsFinished += counts.chars;
+            stats.charsSpacesFinished += counts.charsSpaces;
+            if (mi->danger())
                 stats.translatedMsgDanger++;
             else
                 stats.translatedMsgNoDanger++;
         } else if (mi->isUnfinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsUnfinished, stats.charsUnfinished, stats.charsSpacesUnfinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
+            const MessageItem::TextCounts &counts = mi->translationCounts();
+            stats.wordsUnfinished += counts.words;
+            stats.charsUnfinished += counts.chars;
+            stats.charsSpacesUnfinished += counts.charsSpaces;
+            if (mi->danger())
                 stats.unfinishedMsgDanger++;
             else
                 stats.unfinishedMsgNoDanger++;
@@ -558,6 +609,8 @@ void DataModel::updateStatistics()
 
 void DataModel::setModified(bool isModified)
 {
+    if (isModified)
+        ++m_revision;
     if (m_modified == isModified)
         return;
     m_modified = isModified;
@@ -616,12 +669,8 @@ MessageItem *DataModelIterator::current() const
  *
  *****************************************************************************/
 
-MultiMessageItem::MultiMessageItem(const MessageItem *m)
-    : m_id(m->id()),
-      m_text(m->text()),
-      m_pluralText(m->pluralText()),
-      m_comment(m->comment()),
-      m_nonnullCount(0),
+MultiMessageItem::MultiMessageItem()
+    : m_nonnullCount(0),
       m_nonobsoleteCount(0),
       m_editableCount(0),
       m_unfinishedCount(0)
@@ -647,7 +696,7 @@ MultiContextItem::MultiContextItem(int oldCount, ContextItem *ctx, bool writable
         MessageItem *m = ctx->messageItem(j);
         mList.append(m);
         eList.append(0);
-        m_multiMessageList.append(MultiMessageItem(m));
+        m_multiMessageList.append(MultiMessageItem());
     }
     for (int i = 0; i < oldCount; ++i) {
         m_messageLists.append(eList);
@@ -705,8 +754,7 @@ void MultiContextItem::appendMessageItems(const QList<MessageItem *> &m)
     for (int i = 0; i < m_messageLists.size() - 1; ++i)
         m_messageLists[i] += nullItems;
     m_messageLists.last() += m;
-    for (MessageItem *mi : m)
-        m_multiMessageList.append(MultiMessageItem(mi));
+    m_multiMessageList.resize(m_multiMessageList.size() + m.size());
 }
 
 void MultiContextItem::removeMultiMessageItem(int pos)
@@ -724,11 +772,24 @@ int MultiContextItem::firstNonobsoleteMessageIndex(int msgIdx) const
     return -1;
 }
 
+/*
+  Returns the message item of the first model that has the message
+  \a msgIdx, which provides its source text, comment and id.
+*/
+const MessageItem *MultiContextItem::firstMessageItem(int msgIdx) const
+{
+    for (const QList<MessageItem *> &messages : m_messageLists) {
+        if (const MessageItem *m = messages.at(msgIdx))
+            return m;
+    }
+    return nullptr;
+}
+
 int MultiContextItem::findMessage(const QString &sourcetext, const QString &comment) const
 {
     for (int i = 0, cnt = messageCount(); i < cnt; ++i) {
-        MultiMessageItem *m = multiMessageItem(i);
-        if (m->text() == sourcetext && m->comment() == comment)
+        const MessageItem *m = firstMessageItem(i);
+        if (m && m->text() == sourcetext && m->comment() == comment)
             return i;
     }
     return -1;
@@ -737,13 +798,39 @@ int MultiContextItem::findMessage(const QString &sourcetext, const QString &comm
 int MultiContextItem::findMessageById(const QString &id) const
 {
     for (int i = 0, cnt = messageCount(); i < cnt; ++i) {
-        MultiMessageItem *m = multiMessageItem(i);
-        if (m->id() == id)
+        const MessageItem *m = firstMessageItem(i);
+        if (m && m->id() == id)
             return i;
     }
     return -1;
 }
 
+/*
+  Merging a file looks up every one of its messages, so the lookup tables
+  are built once instead of calling findMessage() for each of them.
+*/
+QHash<std::pair<QString, QString>, int> MultiContextItem::messageIndexesByText() const
+{
+    QHash<std::pair<QString, QString>, int> indexes;
+    indexes.reserve(messageCount());
+    for (int i = messageCount(); --i >= 0;) {
+        if (const MessageItem *m = firstMessageItem(i))
+            indexes.insert({ m->text(), m->comment() }, i);
+    }
+    return indexes;
+}
+
+QHash<QString, int> MultiContextItem::messageIndexesById() const
+{
+    QHash<QString, int> indexes;
+    for (int i = messageCount(); --i >= 0;) {
+        const MessageItem *m = firstMessageItem(i);
+        if (m && !m->id().isEmpty())
+            indexes.insert(m->id(), i);
+    }
+    return indexes;
+}
+
 /******************************************************************************
  *
  * MultiDataModel
@@ -801,9 +888,10 @@ bool MultiDataModel::isWellMergeable(const DataModel *dm) const
     for (int i = 0; i < dm->contextCount(); ++i) {
         ContextItem *c = dm->contextItem(i);
         if (MultiContextItem *mc = findContext(c->context())) {
+            const auto indexes = mc->messageIndexesByText();
             for (int j = 0; j < c->messageCount(); ++j) {
                 MessageItem *m = c->messageItem(j);
-                if (mc->findMessage(m->text(), m->comment()) >= 0)
+                if (indexes.contains({ m->text(), m->comment() }))
                     ++inBothNew;
             }
         }
@@ -814,9 +902,15 @@ bool MultiDataModel::isWellMergeable(const DataModel *dm) const
     for (int k = 0; k < contextCount(); ++k) {
         MultiContextItem *mc = multiContextItem(k);
         if (ContextItem *c = dm->findContext(mc->context())) {
+            QSet<std::pair<QString, QString>> messages;
+            messages.reserve(c->messageCount());
+            for (int j = 0; j < c->messageCount(); ++j) {
+                MessageItem *m = c->messageItem(j);
+                messages.insert({ m->text(), m->comment() });
+            }
             for (int j = 0; j < mc->messageCount(); ++j) {
-                MultiMessageItem *m = mc->multiMessageItem(j);
-                if (c->findMessage(m->text(), m->comment()))
+                const MessageItem *m = mc->firstMessageItem(j);
+                if (m && messages.contains({ m->text(), m->comment() }))
                     ++inBothOld;
             }
         }
@@ -844,16 +938,18 @@ void MultiDataModel::append(DataModel *dm, bool readWrite)
         if (mcx >= 0) {
             MultiContextItem *mc = multiContextItem(mcx);
             mc->assignLastModel(c, readWrite);
+            const auto indexesById = mc->messageIndexesById();
+            const auto indexesByText = mc->messageIndexesByText();
             QList<MessageItem *> appendItems;
             for (int j = 0; j < c->messageCount(); ++j) {
                 MessageItem *m = c->messageItem(j);
 
                 int msgIdx = -1;
                 if (!m->id().isEmpty()) // id based translation
-                    msgIdx = mc->findMessageById(m->id());
+                    msgIdx = indexesById.value(m->id(), -1);
 
                 if (msgIdx == -1)
-                    msgIdx = mc->findMessage(m->text(), m->comment());
+                    msgIdx = indexesByText.value({ m->text(), m->comment() }, -1);
 
                 if (msgIdx >= 0)
                     mc->putMessageItem(msgIdx, m);
@@ -1417,7 +1513,9 @@ QVariant MessageModel::data(const QModelIndex &index, int role) const
             switch (column - numLangs) {
             case 0: // Source text
                 {
-                    MultiMessageItem *msgItem = mci->multiMessageItem(row);
+                    const MessageItem *msgItem = mci->firstMessageItem(row);
+                    if (!msgItem)
+                        return QVariant();
 
                     auto text = msgItem->text();
                     if (text.isEmpty())
@@ -1457,7 +1555,9 @@ QVariant MessageModel::data(const QModelIndex &index, int role) const
         else if (role == SortRole) {
             switch (column - numLangs) {
             case 0: // Source text
-                return mci->multiMessageItem(row)->text().simplified().remove(QLatin1Char('&'));
+                if (const MessageItem *msgItem = mci->firstMessageItem(row))
+                    return msgItem->text().simplified().remove(QLatin1Char('&'));
+                return QString();
             case 1: // Dummy column
                 return QVariant();
             default:
@@ -1479,7 +1579,8 @@ QVariant MessageModel::data(const QModelIndex &index, int role) const
             return QBrush(Qt::darkGray);
         }
         else if (role == Qt::ForegroundRole && column == numLangs
-                 && mci->multiMessageItem(row)->text().isEmpty()) {
+                 && mci->firstMessageItem(row)
+                 && mci->firstMessageItem(row)->text().isEmpty()) {
             return QBrush(QColor(0, 0xa0, 0xa0));
         }
         else if (role == Qt::BackgroundRole) {
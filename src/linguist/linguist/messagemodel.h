@@ -13,6 +13,9 @@
 #include <QtGui/QColor>
 #include <QtGui/QBitmap>
 
+#include <optional>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 class DataModel;
@@ -27,7 +30,12 @@ public:
     bool danger() const { return m_danger; }
     void setDanger(bool danger) { m_danger = danger; }
     bool ncrMode() const { return m_ncrMode; }
-    void setNcrMode(bool mode) { m_ncrMode = mode; }
+    void setNcrMode(bool mode)
+    {
+        if (m_ncrMode != mode)
+            m_translationCounts.reset();
+        m_ncrMode = mode;
+    }
 
     void setTranslation(const QString &translation);
 
@@ -57,8 +65,19 @@ public:
     bool compare(const QString &findText, bool matchSubstring,
         Qt::CaseSensitivity cs) const;
 
+    // The words and characters of the translations, for the statistics.
+    // They are counted on first use after the translations changed.
+    struct TextCounts
+    {
+        int words = 0;
+        int chars = 0;
+        int charsSpaces = 0;
+    };
+    const TextCounts &translationCounts() const;
+
 private:
     TranslatorMessage m_message;
+    mutable std::optional<TextCounts> m_translationCounts;
     bool m_danger;
     bool m_ncrMode;
 };
@@ -160,6 +179,9 @@ public:
     bool isEmpty() const { return m_numMessages == 0; }
     bool isModified() const { return m_modified; }
     void setModified(bool dirty);
+    // Incremented on every modification, so that an asynchronous save can
+    // tell whether the model changed after its snapshot was taken.
+    int revision() const { return m_revision; }
     bool isWritable() const { return m_writable; }
     void setWritable(bool writable) { m_writable = writable; }
 
@@ -167,8 +189,11 @@ public:
     bool load(const QString &fileName, bool *langGuessed, QWidget *parent);
     bool save(QWidget *parent) { return save(m_srcFileName, parent); }
     bool saveAs(const QString &newFileName, QWidget *parent);
-    bool release(const QString &fileName, bool verbose,
-        bool ignoreUnfinished, TranslatorSaveMode mode, QWidget *parent);
+    Translator snapshot();
+    static bool write(Translator *tor, const QString &fileName, QString *errors);
+    Translator releaseSnapshot();
+    static bool writeQm(const Translator &tor, const QString &fileName, bool verbose,
+        bool ignoreUnfinished, TranslatorSaveMode mode, QString *errors);
     QString srcFileName(bool pretty = false) const
         { return pretty ? prettifyPlainFileName(m_srcFileName) : m_srcFileName; }
 
@@ -187,7 +212,7 @@ public:
     const QList<bool> &countRefNeeds() const { return m_countRefNeeds; }
 
     QStringList normalizedTranslations(const MessageItem &m) const;
-    void doCharCounting(const QString& text, int& trW, int& trC, int& trCS);
+    static void doCharCounting(const QString& text, int& trW, int& trC, int& trCS);
     void updateStatistics();
 
     int getSrcWords() const { return m_srcWords; }
@@ -209,6 +234,7 @@ private:
 
     bool m_writable;
     bool m_modified;
+    int m_revision = 0;
 
     int m_numMessages;
 
@@ -231,14 +257,12 @@ private:
 };
 
 
+// The texts of a message are not copied here; they are taken from the
+// MessageItems when needed, see MultiContextItem::firstMessageItem().
 struct MultiMessageItem
 {
 public:
-    MultiMessageItem(const MessageItem *m);
-    QString id() const { return m_id; }
-    QString text() const { return m_text; }
-    QString pluralText() const { return m_pluralText; }
-    QString comment() const { return m_comment; }
+    MultiMessageItem();
     bool isEmpty() const { return !m_nonnullCount; }
     // The next two include also read-only
     bool isObsolete() const { return m_nonnullCount && !m_nonobsoleteCount; }
@@ -259,10 +283,6 @@ private:
     void incrementUnfinishedCount() { ++m_unfinishedCount; }
     void decrementUnfinishedCount() { --m_unfinishedCount; }
 
-    QString m_id;
-    QString m_text;
-    QString m_pluralText;
-    QString m_comment;
     int m_nonnullCount; // all
     int m_nonobsoleteCount; // all
     int m_editableCount; // read-write
@@ -279,9 +299,13 @@ public:
     MultiMessageItem *multiMessageItem(int msgIdx) const
         { return const_cast<MultiMessageItem *>(&m_multiMessageList[msgIdx]); }
     MessageItem *messageItem(int model, int msgIdx) const { return m_messageLists[model][msgIdx]; }
+    const MessageItem *firstMessageItem(int msgIdx) const;
     int firstNonobsoleteMessageIndex(int msgIdx) const;
     int findMessage(const QString &sourcetext, const QString &comment) const;
     int findMessageById(const QString &id) const;
+    // Source text and comment, or id, to the index of the first message with them.
+    QHash<std::pair<QString, QString>, int> messageIndexesByText() const;
+    QHash<QString, int> messageIndexesById() const;
 
     QString context() const { return m_context; }
     QString comment() const { return m_comment; }
@@ -370,8 +394,6 @@ public:
     bool save(int model, QWidget *parent) { return m_dataModels[model]->save(parent); }
     bool saveAs(int model, const QString &newFileName, QWidget *parent)
         { return m_dataModels[model]->saveAs(newFileName, parent); }
-    bool release(int model, const QString &fileName, bool verbose, bool ignoreUnfinished, TranslatorSaveMode mode, QWidget *parent)
-        { return m_dataModels[model]->release(fileName, verbose, ignoreUnfinished, mode, parent); }
     void close(int model);
     void closeAll();
     int isFileLoaded(const QString &name) const;
@@ -393,6 +415,9 @@ public:
     bool isModelWritable(int model) const { return m_dataModels[model]->isWritable(); }
     bool isModified(int model) const { return m_dataModels[model]->isModified(); }
     void setModified(int model, bool dirty) { m_dataModels[model]->setModified(dirty); }
+    int revision(int model) const { return m_dataModels[model]->revision(); }
+    Translator snapshot(int model) const { return m_dataModels[model]->snapshot(); }
+    Translator releaseSnapshot(int model) const { return m_dataModels[model]->releaseSnapshot(); }
     QLocale::Language language(int model) const { return m_dataModels[model]->language(); }
     QLocale::Language sourceLanguage(int model) const { return m_dataModels[model]->sourceLanguage(); }
 
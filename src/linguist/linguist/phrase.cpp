@@ -3,15 +3,23 @@
 
 #include "phrase.h"
 #include "translator.h"
-#include "xmlparser.h"
 
 #include <QApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QTextStream>
 #include <QXmlStreamReader>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 static QString xmlProtect(const QString & str)
@@ -76,88 +84,33 @@ bool operator==(const Phrase &p, const Phrase &q)
         p.definition() == q.definition() && p.phraseBook() == q.phraseBook();
 }
 
-class QphHandler : public XmlParser
-{
-public:
-    QphHandler(PhraseBook *phraseBook, QXmlStreamReader &reader)
-        : XmlParser(reader), pb(phraseBook), ferrorCount(0)
-    {
-    }
-    ~QphHandler() override = default;
-
-    QString language() const { return m_language; }
-    QString sourceLanguage() const { return m_sourceLanguage; }
-
-private:
-    bool startElement(QStringView namespaceURI, QStringView localName,
-                      QStringView qName, const QXmlStreamAttributes &atts) override;
-    bool endElement(QStringView namespaceURI, QStringView localName,
-                    QStringView qName) override;
-    bool characters(QStringView ch) override;
-    bool fatalError(qint64 line, qint64 column, const QString &message) override;
-
-    PhraseBook *pb;
-    QString source;
-    QString target;
-    QString definition;
-    QString m_language;
-    QString m_sourceLanguage;
+/*
+  Phrase books are cached in a binary form next to the other cached data
+  of Qt Linguist, so that large terminology books do not need to be parsed
+  again every time they are opened. The cache is keyed by the path of the
+  phrase book and is valid as long as its size and time stamp match.
+*/
+static const quint32 PhraseCacheMagic = 0x51504843; // "QPHC"
+static const quint32 PhraseCacheVersion = 1;
 
-    QString accum;
-    int ferrorCount;
-};
-
-bool QphHandler::startElement(QStringView namespaceURI, QStringView localName,
-                              QStringView qName, const QXmlStreamAttributes &atts)
-{
-    Q_UNUSED(namespaceURI);
-    Q_UNUSED(localName);
-
-    if (qName == QLatin1String("QPH")) {
-        m_language = atts.value(QLatin1String("language")).toString();
-        m_sourceLanguage = atts.value(QLatin1String("sourcelanguage")).toString();
-    } else if (qName == QLatin1String("phrase")) {
-        source.truncate(0);
-        target.truncate(0);
-        definition.truncate(0);
-    }
-    accum.truncate(0);
-    return true;
-}
-
-bool QphHandler::endElement(QStringView namespaceURI, QStringView localName,
-                            QStringView qName)
+static QString phraseCacheFileName(const QString &fileName)
 {
-    Q_UNUSED(namespaceURI);
-    Q_UNUSED(localName);
-
-    if (qName == QLatin1String("source"))
-        source = accum;
-    else if (qName == QLatin1String("target"))
-        target = accum;
-    else if (qName == QLatin1String("definition"))
-        definition = accum;
-    else if (qName == QLatin1String("phrase"))
-        pb->m_phrases.append(new Phrase(source, target, definition, pb));
-    return true;
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (dir.isEmpty())
+        return QString();
+    const QByteArray key = QCryptographicHash::hash(
+            QFileInfo(fileName).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1);
+    return dir + QLatin1String("/phrasebooks/") + QLatin1String(key.toHex())
+            + QLatin1String(".qphc");
 }
 
-bool QphHandler::characters(QStringView ch)
+QString Phrase::friendlyString(const QString &str)
 {
-    accum += ch;
-    return true;
-}
-
-bool QphHandler::fatalError(qint64 line, qint64 column, const QString &message)
-{
-    if (ferrorCount++ == 0) {
-        QString msg = PhraseBook::tr("Parse error at line %1, column %2 (%3).")
-                              .arg(line)
-                              .arg(column)
-                              .arg(message);
-        QMessageBox::information(nullptr, QObject::tr("Qt Linguist"), msg);
-    }
-    return false;
+    static const QRegularExpression punctuation(QStringLiteral("[.,:;!?()-]"));
+    QString f = str.toLower();
+    f.replace(punctuation, QString(QLatin1String(" ")));
+    f.remove(QLatin1Char('&'));
+    return f.simplified();
 }
 
 PhraseBook::PhraseBook() :
@@ -199,13 +152,18 @@ bool PhraseBook::load(const QString &fileName, bool *langGuessed)
         return false;
 
     m_fileName = fileName;
+    invalidateWordIndex();
 
-    QXmlStreamReader reader(&f);
-    QphHandler *hand = new QphHandler(this, reader);
-    reader.setNamespaceProcessing(false);
-    bool ok = hand->parse();
+    QString language;
+    QString sourceLanguage;
+    bool ok = readCache(&language, &sourceLanguage);
+    if (!ok) {
+        ok = parse(f, &language, &sourceLanguage);
+        if (ok)
+            writeCache(language, sourceLanguage);
+    }
 
-    Translator::languageAndTerritory(hand->language(), &m_language, &m_territory);
+    Translator::languageAndTerritory(language, &m_language, &m_territory);
     *langGuessed = false;
     if (m_language == QLocale::C) {
         QLocale sys;
@@ -214,15 +172,13 @@ bool PhraseBook::load(const QString &fileName, bool *langGuessed)
         *langGuessed = true;
     }
 
-    QString lang = hand->sourceLanguage();
-    if (lang.isEmpty()) {
+    if (sourceLanguage.isEmpty()) {
         m_sourceLanguage = QLocale::C;
         m_sourceTerritory = QLocale::AnyTerritory;
     } else {
-        Translator::languageAndTerritory(lang, &m_sourceLanguage, &m_sourceTerritory);
+        Translator::languageAndTerritory(sourceLanguage, &m_sourceLanguage, &m_sourceTerritory);
     }
 
-    delete hand;
     f.close();
     if (!ok) {
         qDeleteAll(m_phrases);
@@ -234,6 +190,124 @@ bool PhraseBook::load(const QString &fileName, bool *langGuessed)
     return ok;
 }
 
+/*
+  Reads the phrases of \a file in a single pass over the XML stream.
+*/
+bool PhraseBook::parse(QFile &file, QString *language, QString *sourceLanguage)
+{
+    QXmlStreamReader reader(&file);
+    reader.setNamespaceProcessing(false);
+
+    QString source;
+    QString target;
+    QString definition;
+    const auto elementText = [&reader] {
+        QString text = reader.readElementText(QXmlStreamReader::IncludeChildElements);
+        return text.trimmed().isEmpty() ? QString() : text;
+    };
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QXmlStreamReader::StartElement: {
+            const QStringView name = reader.qualifiedName();
+            if (name == QLatin1String("QPH")) {
+                *language = reader.attributes().value(QLatin1String("language")).toString();
+                *sourceLanguage =
+                        reader.attributes().value(QLatin1String("sourcelanguage")).toString();
+            } else if (name == QLatin1String("phrase")) {
+                source.clear();
+                target.clear();
+                definition.clear();
+            } else if (name == QLatin1String("source")) {
+                source = elementText();
+            } else if (name == QLatin1String("target")) {
+                target = elementText();
+            } else if (name == QLatin1String("definition")) {
+                definition = elementText();
+            }
+            break;
+        }
+        case QXmlStreamReader::EndElement:
+            if (reader.qualifiedName() == QLatin1String("phrase"))
+                m_phrases.append(new Phrase(source, target, definition, this));
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (reader.hasError()) {
+        QString msg = tr("Parse error at line %1, column %2 (%3).")
+                              .arg(reader.lineNumber())
+                              .arg(reader.columnNumber())
+                              .arg(reader.errorString());
+        QMessageBox::information(nullptr, QObject::tr("Qt Linguist"), msg);
+        return false;
+    }
+    return true;
+}
+
+bool PhraseBook::readCache(QString *language, QString *sourceLanguage)
+{
+    const QString cacheFileName = phraseCacheFileName(m_fileName);
+    if (cacheFileName.isEmpty())
+        return false;
+    QFile cache(cacheFileName);
+    if (!cache.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&cache);
+    in.setVersion(QDataStream::Qt_6_0);
+    const QFileInfo info(m_fileName);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 size = -1;
+    qint64 lastModified = 0;
+    in >> magic >> version >> size >> lastModified;
+    if (magic != PhraseCacheMagic || version != PhraseCacheVersion || size != info.size()
+        || lastModified != info.lastModified().toMSecsSinceEpoch()) {
+        return false;
+    }
+
+    quint32 count = 0;
+    in >> *language >> *sourceLanguage >> count;
+    QList<Phrase *> phrases;
+    phrases.reserve(qsizetype(std::min<quint64>(count, quint64(cache.size()))));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString source;
+        QString target;
+        QString definition;
+        in >> source >> target >> definition;
+        phrases.append(new Phrase(source, target, definition, this));
+    }
+    if (in.status() != QDataStream::Ok) {
+        qDeleteAll(phrases);
+        return false;
+    }
+    m_phrases = std::move(phrases);
+    return true;
+}
+
+void PhraseBook::writeCache(const QString &language, const QString &sourceLanguage) const
+{
+    const QString cacheFileName = phraseCacheFileName(m_fileName);
+    if (cacheFileName.isEmpty() || !QDir().mkpath(QFileInfo(cacheFileName).absolutePath()))
+        return;
+    QSaveFile cache(cacheFileName);
+    if (!cache.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&cache);
+    out.setVersion(QDataStream::Qt_6_0);
+    const QFileInfo info(m_fileName);
+    out << PhraseCacheMagic << PhraseCacheVersion << qint64(info.size())
+        << qint64(info.lastModified().toMSecsSinceEpoch());
+    out << language << sourceLanguage << quint32(m_phrases.size());
+    for (const Phrase *p : m_phrases)
+        out << p->source() << p->target() << p->definition();
+    if (out.status() == QDataStream::Ok)
+        cache.commit();
+}
+
 bool PhraseBook::save(const QString &fileName)
 {
     QFile f(fileName);
@@ -263,11 +337,42 @@ bool PhraseBook::save(const QString &fileName)
     t << "</QPH>\n";
     f.close();
     setModified(false);
+    writeCache(language() != QLocale::C
+                       ? Translator::makeLanguageCode(language(), territory()) : QString(),
+               sourceLanguage() != QLocale::C
+                       ? Translator::makeLanguageCode(sourceLanguage(), sourceTerritory())
+                       : QString());
     return true;
 }
 
+/*
+  Returns the phrases of this book by the first word of their friendly
+  source text, in the order of the book. The index is built on first use
+  and shared by all translation files the book applies to.
+*/
+const QHash<QString, QList<Phrase *>> &PhraseBook::wordIndex() const
+{
+    if (!m_wordIndexValid) {
+        m_wordIndex.clear();
+        for (Phrase *p : m_phrases) {
+            const QString f = Phrase::friendlyString(p->source());
+            if (!f.isEmpty())
+                m_wordIndex[f.section(QLatin1Char(' '), 0, 0)].append(p);
+        }
+        m_wordIndexValid = true;
+    }
+    return m_wordIndex;
+}
+
+void PhraseBook::invalidateWordIndex()
+{
+    m_wordIndexValid = false;
+    m_wordIndex.clear();
+}
+
 void PhraseBook::append(Phrase *phrase)
 {
+    invalidateWordIndex();
     m_phrases.append(phrase);
     phrase->setPhraseBook(this);
     setModified(true);
@@ -276,6 +381,7 @@ void PhraseBook::append(Phrase *phrase)
 
 void PhraseBook::remove(Phrase *phrase)
 {
+    invalidateWordIndex();
     m_phrases.removeOne(phrase);
     phrase->setPhraseBook(0);
     setModified(true);
@@ -294,6 +400,7 @@ void PhraseBook::phraseChanged(Phrase *p)
 {
     Q_UNUSED(p);
 
+    invalidateWordIndex();
     setModified(true);
 }
 
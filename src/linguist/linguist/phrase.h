@@ -4,6 +4,7 @@
 #ifndef PHRASE_H
 #define PHRASE_H
 
+#include <QHash>
 #include <QObject>
 #include <QString>
 #include <QList>
@@ -35,6 +36,8 @@ public:
     PhraseBook *phraseBook() const { return m_phraseBook; }
     void setPhraseBook(PhraseBook *book) { m_phraseBook = book; }
 
+    static QString friendlyString(const QString &str);
+
 private:
     int shrtc;
     QString s;
@@ -49,7 +52,7 @@ inline bool operator!=(const Phrase &p, const Phrase &q) {
     return !(p == q);
 }
 
-class QphHandler;
+class QFile;
 
 class PhraseBook : public QObject
 {
@@ -61,6 +64,7 @@ public:
     bool load(const QString &fileName, bool *langGuessed);
     bool save(const QString &fileName);
     QList<Phrase *> phrases() const { return m_phrases; }
+    const QHash<QString, QList<Phrase *>> &wordIndex() const;
     void append(Phrase *phrase);
     void remove(Phrase *phrase);
     QString fileName() const { return m_fileName; }
@@ -85,8 +89,15 @@ private:
 
     void setModified(bool modified);
     void phraseChanged(Phrase *phrase);
+    void invalidateWordIndex();
+
+    bool parse(QFile &file, QString *language, QString *sourceLanguage);
+    bool readCache(QString *language, QString *sourceLanguage);
+    void writeCache(const QString &language, const QString &sourceLanguage) const;
 
     QList<Phrase *> m_phrases;
+    mutable QHash<QString, QList<Phrase *>> m_wordIndex;
+    mutable bool m_wordIndexValid = false;
     QString m_fileName;
     bool m_changed;
 
@@ -95,7 +106,6 @@ private:
     QLocale::Territory m_territory;
     QLocale::Territory m_sourceTerritory;
 
-    friend class QphHandler;
     friend class Phrase;
 };
 
@@ -8,7 +8,10 @@
 #include "phraseview.h"
 #include "phrasemodel.h"
 #include "simtexth.h"
+#include "translationmemory.h"
+#include "translator.h"
 
+#include <QFuture>
 #include <QHeaderView>
 #include <QKeyEvent>
 #include <QSettings>
@@ -17,6 +20,7 @@
 #include <QWidget>
 #include <QDebug>
 
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -56,6 +60,14 @@ PhraseView::PhraseView(MultiDataModel *model, QList<QHash<QString, QList<Phrase
 
     connect(this, &QAbstractItemView::activated,
             this, &PhraseView::selectPhrase);
+
+    // Adding or removing a model changes which messages each model iterates over.
+    connect(m_dataModel, &MultiDataModel::modelAppended,
+            this, &PhraseView::rebuildTranslationMemories);
+    connect(m_dataModel, &MultiDataModel::modelDeleted,
+            this, &PhraseView::rebuildTranslationMemories);
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted,
+            this, &PhraseView::rebuildTranslationMemories);
 }
 
 PhraseView::~PhraseView()
@@ -97,7 +109,8 @@ void PhraseView::contextMenuEvent(QContextMenuEvent *event)
     QAction *gotoAction = new QAction(tr("Go to"), contextMenu);
     connect(gotoAction, &QAction::triggered,
             this, &PhraseView::gotoMessageFromGuess);
-    gotoAction->setEnabled(!isFromPhraseBook);
+    gotoAction->setEnabled(!isFromPhraseBook
+                           && !m_phraseModel->phrase(index)->candidate().context.isEmpty());
 
     contextMenu->addAction(insertAction);
     contextMenu->addAction(editAction);
@@ -172,58 +185,194 @@ void PhraseView::resetNumGuesses()
     setSourceText(m_modelIndex, m_sourceText);
 }
 
-static CandidateList similarTextHeuristicCandidates(MultiDataModel *model, int mi,
-    const char *text, int maxCandidates)
+/*
+  The translation memory of each model is built on a worker thread when
+  files are opened or closed, because these change which messages each
+  model iterates over. Source texts do not change while a model is loaded,
+  so the CoMatrix values are reused for every message that is looked at.
+  Translations and states are read when the guesses are shown, so that
+  edits are taken into account.
+*/
+void PhraseView::rebuildTranslationMemories()
 {
-    QList<int> scores;
-    CandidateList candidates;
+    ++m_guessRequest;
+    m_translationMemories.clear();
+    for (int model = 0; model < m_dataModel->modelCount(); ++model) {
+        TranslationMemory memory;
+        QStringList texts;
+        for (MultiDataModelIterator it(m_dataModel, model); it.isValid(); ++it) {
+            if (MessageItem *m = it.current()) {
+                memory.messages.append(m);
+                texts.append(m->text());
+            }
+        }
+        memory.matrices = QtFuture::makeReadyValueFuture(std::move(texts))
+                .then(QtFuture::Launch::Async, [](const QStringList &texts) {
+                    QList<SimilarityCandidate> matrices;
+                    matrices.reserve(texts.size());
+                    for (const QString &text : texts)
+                        matrices.append(SimilarityCandidate(text));
+                    return matrices;
+                });
+        // The only continuation of the matrices; each guess request starts
+        // its own chain once they are ready.
+        memory.matrices.then(this, [this, model](const QList<SimilarityCandidate> &) {
+            translationMemoryReady(model);
+        });
+        m_translationMemories.append(memory);
+    }
+}
 
-    StringSimilarityMatcher stringmatcher(QString::fromLatin1(text));
+void PhraseView::translationMemoryReady(int model)
+{
+    if (m_pendingGuess.request == m_guessRequest && m_pendingGuess.model == model) {
+        const PendingGuess pending = std::exchange(m_pendingGuess, {});
+        requestGuesses(pending.model, pending.text);
+    }
+}
 
-    for (MultiDataModelIterator it(model, mi); it.isValid(); ++it) {
-        MessageItem *m = it.current();
-        if (!m)
-            continue;
+/*
+  Scores \a text against the translation memory of \a model on a worker
+  thread, and adds the guesses once they are available, unless another
+  message has become current in the meantime. While the matrices of the
+  model are still computed, only the latest request is kept, and started
+  when they are ready.
+*/
+void PhraseView::requestGuesses(int model, const QString &text)
+{
+    if (model >= m_translationMemories.size())
+        return;
+    const quint64 request = ++m_guessRequest;
+    const TranslationMemory &memory = m_translationMemories.at(model);
+    if (!memory.matrices.isFinished()) {
+        m_pendingGuess = { request, model, text };
+        return;
+    }
+    const DataModel *dataModel = m_dataModel->model(model);
+    const QString languageCode =
+            Translator::makeLanguageCode(dataModel->language(), dataModel->territory());
+    QtFuture::makeReadyValueFuture(memory.matrices.result())
+            .then(QtFuture::Launch::Async,
+                  [text, languageCode, database = m_database, maxCandidates = m_maxCandidates](
+                          const QList<SimilarityCandidate> &matrices) {
+                      QList<int> scores(matrices.size());
+                      const StringSimilarityMatcher stringmatcher(text);
+                      stringmatcher.getSimilarityScores(matrices.constData(), matrices.size(),
+                                                        scores.data());
+                      GuessResults results;
+                      ScoredMessages &scored = results.first;
+                      for (qsizetype i = 0; i < scores.size(); ++i) {
+                          if (scores.at(i) >= textSimilarityThreshold)
+                              scored.emplace_back(scores.at(i), i);
+                      }
+                      std::stable_sort(scored.begin(), scored.end(),
+                                       [](const auto &a, const auto &b) {
+                                           return a.first > b.first;
+                                       });
+                      if (database)
+                          results.second = database->lookup(text, languageCode, maxCandidates);
+                      return results;
+                  })
+            .then(this, [this, model, request](const GuessResults &results) {
+                if (request == m_guessRequest) {
+                    addGuesses(similarTextHeuristicCandidates(model, results.first,
+                                                              m_maxCandidates),
+                               results.second);
+                }
+            });
+}
 
-        TranslatorMessage mtm = m->message();
+CandidateList PhraseView::similarTextHeuristicCandidates(int model, const ScoredMessages &scored,
+                                                         int maxCandidates) const
+{
+    const QList<MessageItem *> &messages = m_translationMemories.at(model).messages;
+    QList<int> scores;
+    CandidateList candidates;
+    for (const auto &[score, index] : scored) {
+        if (candidates.size() == maxCandidates)
+            break;
+        const MessageItem *m = messages.at(index);
+        const TranslatorMessage &mtm = m->message();
         if (mtm.type() == TranslatorMessage::Unfinished
             || mtm.translation().isEmpty())
             continue;
 
-        QString s = m->text();
-
-        int score = stringmatcher.getSimilarityScore(s);
-
-        if (candidates.size() == maxCandidates && score > scores[maxCandidates - 1])
-            candidates.removeLast();
-        if (candidates.size() < maxCandidates && score >= textSimilarityThreshold ) {
-            Candidate cand(mtm.context(), s, mtm.comment(), mtm.translation());
-
-            int i;
-            for (i = 0; i < candidates.size(); ++i) {
-                if (score >= scores.at(i)) {
-                    if (score == scores.at(i)) {
-                        if (candidates.at(i) == cand)
-                            goto continue_outer_loop;
-                    } else {
-                        break;
-                    }
-                }
+        const Candidate cand(mtm.context(), m->text(), mtm.comment(), mtm.translation());
+        bool duplicate = false;
+        for (qsizetype i = candidates.size() - 1; i >= 0 && scores.at(i) == score; --i) {
+            if (candidates.at(i) == cand) {
+                duplicate = true;
+                break;
             }
-            scores.insert(i, score);
-            candidates.insert(i, cand);
         }
-        continue_outer_loop:
-        ;
+        if (!duplicate) {
+            scores.append(score);
+            candidates.append(cand);
+        }
     }
     return candidates;
 }
 
+/*
+  Adds the guesses from the open files, and fills the remaining places
+  with the translations from the translation memory database that are not
+  among them.
+*/
+void PhraseView::addGuesses(const CandidateList &candidates,
+                            const CandidateList &databaseCandidates)
+{
+    int n = 0;
+    for (const Candidate &candidate : candidates) {
+        QString def;
+        if (n < 9)
+            def = tr("Guess from '%1' (%2)")
+                  .arg(candidate.context, QKeySequence(Qt::CTRL | (Qt::Key_0 + (n + 1)))
+                                          .toString(QKeySequence::NativeText));
+        else
+            def = tr("Guess from '%1'").arg(candidate.context);
+        Phrase *guess = new Phrase(candidate.source, candidate.translation, def, candidate, n);
+        m_guesses.append(guess);
+        m_phraseModel->addPhrase(guess);
+        ++n;
+    }
+    for (const Candidate &candidate : databaseCandidates) {
+        if (n == m_maxCandidates)
+            break;
+        const auto sameText = [&candidate](const Candidate &c) {
+            return c.source == candidate.source && c.translation == candidate.translation;
+        };
+        if (std::any_of(candidates.cbegin(), candidates.cend(), sameText))
+            continue;
+        QString def;
+        if (n < 9)
+            def = tr("Translation memory '%1' (%2)")
+                  .arg(candidate.context, QKeySequence(Qt::CTRL | (Qt::Key_0 + (n + 1)))
+                                          .toString(QKeySequence::NativeText));
+        else
+            def = tr("Translation memory '%1'").arg(candidate.context);
+        // There is no message to go to.
+        const Candidate memoryCandidate(QString(), candidate.source, candidate.disambiguation,
+                                        candidate.translation);
+        Phrase *guess = new Phrase(candidate.source, candidate.translation, def,
+                                   memoryCandidate, n);
+        m_guesses.append(guess);
+        m_phraseModel->addPhrase(guess);
+        ++n;
+    }
+}
+
+void PhraseView::setTranslationMemoryDatabase(
+        std::shared_ptr<const TranslationMemoryDatabase> database)
+{
+    m_database = std::move(database);
+    update();
+}
 
 void PhraseView::setSourceText(int model, const QString &sourceText)
 {
     m_modelIndex = model;
     m_sourceText = sourceText;
+    ++m_guessRequest;
     m_phraseModel->removePhrases();
     deleteGuesses();
 
@@ -234,24 +383,8 @@ void PhraseView::setSourceText(int model, const QString &sourceText)
     for (Phrase *p : phrases)
         m_phraseModel->addPhrase(p);
 
-    if (!sourceText.isEmpty() && m_doGuesses) {
-        const CandidateList cl = similarTextHeuristicCandidates(m_dataModel, model,
-            sourceText.toLatin1(), m_maxCandidates);
-        int n = 0;
-        for (const Candidate &candidate : cl) {
-            QString def;
-            if (n < 9)
-                def = tr("Guess from '%1' (%2)")
-                      .arg(candidate.context, QKeySequence(Qt::CTRL | (Qt::Key_0 + (n + 1)))
-                                              .toString(QKeySequence::NativeText));
-            else
-                def = tr("Guess from '%1'").arg(candidate.context);
-            Phrase *guess = new Phrase(candidate.source, candidate.translation, def, candidate, n);
-            m_guesses.append(guess);
-            m_phraseModel->addPhrase(guess);
-            ++n;
-        }
-    }
+    if (!sourceText.isEmpty() && m_doGuesses)
+        requestGuesses(model, QString::fromLatin1(sourceText.toLatin1()));
 }
 
 QList<Phrase *> PhraseView::getPhrases(int model, const QString &source)
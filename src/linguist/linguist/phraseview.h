@@ -4,16 +4,23 @@
 #ifndef PHRASEVIEW_H
 #define PHRASEVIEW_H
 
+#include <QFuture>
 #include <QList>
 #include <QTreeView>
 #include "phrase.h"
+#include "simtexth.h"
+
+#include <memory>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
 static const int DefaultMaxCandidates = 5;
 
+class MessageItem;
 class MultiDataModel;
 class PhraseModel;
+class TranslationMemoryDatabase;
 
 class PhraseView : public QTreeView
 {
@@ -23,6 +30,7 @@ public:
     PhraseView(MultiDataModel *model, QList<QHash<QString, QList<Phrase *> > > *phraseDict, QWidget *parent = 0);
     ~PhraseView();
     void setSourceText(int model, const QString &sourceText);
+    void setTranslationMemoryDatabase(std::shared_ptr<const TranslationMemoryDatabase> database);
 
 public slots:
     void toggleGuessing();
@@ -51,10 +59,29 @@ private slots:
     void selectCurrentPhrase();
     void editPhrase();
     void gotoMessageFromGuess();
+    void rebuildTranslationMemories();
 
 private:
+    // The score and the message index of each similar message, best first.
+    using ScoredMessages = QList<std::pair<int, qsizetype>>;
+    // The similar messages of the model, and the matches from the database.
+    using GuessResults = std::pair<ScoredMessages, CandidateList>;
+
+    // The messages of one model in iteration order, with the CoMatrix of
+    // each source text. The matrices are computed on a worker thread.
+    struct TranslationMemory
+    {
+        QList<MessageItem *> messages;
+        QFuture<QList<SimilarityCandidate>> matrices;
+    };
+
     QList<Phrase *> getPhrases(int model, const QString &sourceText);
     void deleteGuesses();
+    void requestGuesses(int model, const QString &text);
+    void translationMemoryReady(int model);
+    CandidateList similarTextHeuristicCandidates(int model, const ScoredMessages &scored,
+                                                 int maxCandidates) const;
+    void addGuesses(const CandidateList &candidates, const CandidateList &databaseCandidates);
 
     MultiDataModel *m_dataModel;
     QList<QHash<QString, QList<Phrase *> > > *m_phraseDict;
@@ -64,6 +91,18 @@ private:
     int m_modelIndex;
     bool m_doGuesses;
     int m_maxCandidates = DefaultMaxCandidates;
+    QList<TranslationMemory> m_translationMemories;
+    std::shared_ptr<const TranslationMemoryDatabase> m_database;
+    // Identifies the latest guess request; older results are dropped.
+    quint64 m_guessRequest = 0;
+    // The latest request made before the translation memory was ready.
+    struct PendingGuess
+    {
+        quint64 request = 0;
+        int model = -1;
+        QString text;
+    };
+    PendingGuess m_pendingGuess;
 };
 
 QT_END_NAMESPACE
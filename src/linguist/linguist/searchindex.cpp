@@ -0,0 +1,144 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "searchindex.h"
+#include "messagemodel.h"
+
+#include <algorithm>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  Searches are case insensitive by default, and may ignore accelerators,
+  so trigrams are taken from the case folded text without any '&'. This
+  yields a superset of the messages that match with any find option.
+*/
+static QString normalized(const QString &text)
+{
+    QString folded = text.toCaseFolded();
+    folded.remove(QLatin1Char('&'));
+    return folded;
+}
+
+static void appendTrigrams(const QString &text, QList<quint64> *trigrams)
+{
+    const QString folded = normalized(text);
+    for (qsizetype i = 0; i + 3 <= folded.size(); ++i) {
+        trigrams->append(quint64(folded.at(i).unicode()) << 32
+                         | quint64(folded.at(i + 1).unicode()) << 16
+                         | quint64(folded.at(i + 2).unicode()));
+    }
+}
+
+SearchIndex::SearchIndex(MultiDataModel *dataModel, QObject *parent)
+    : QObject(parent), m_dataModel(dataModel)
+{
+    // Opening or closing files renumbers the messages.
+    connect(m_dataModel, &MultiDataModel::modelAppended, this, &SearchIndex::rebuild);
+    connect(m_dataModel, &MultiDataModel::modelDeleted, this, &SearchIndex::rebuild);
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted, this, &SearchIndex::rebuild);
+    connect(m_dataModel, &MultiDataModel::translationChanged,
+            this, &SearchIndex::messageChanged);
+}
+
+/*
+  Collects the searchable texts on the GUI thread, and indexes them on a
+  worker thread. Until the index is available, findCandidates() returns
+  false, and searches look at every message.
+*/
+void SearchIndex::rebuild()
+{
+    m_changed.clear();
+    QList<std::pair<Message, QStringList>> texts;
+    texts.reserve(m_dataModel->messageCount());
+    for (MultiDataModelIterator it(m_dataModel, 0); it.isValid(); ++it) {
+        QStringList messageTexts;
+        for (int model = 0; model < m_dataModel->modelCount(); ++model) {
+            if (const MessageItem *m = m_dataModel->messageItem(it, model)) {
+                messageTexts << m->text() << m->pluralText() << m->comment()
+                             << m->extraComment() << m->translatorComment()
+                             << m->translations();
+            }
+        }
+        texts.emplace_back(Message(it.context(), it.message()), messageTexts);
+    }
+    m_index = QtFuture::makeReadyValueFuture(std::move(texts))
+            .then(QtFuture::Launch::Async, &SearchIndex::buildIndex);
+}
+
+SearchIndex::Index SearchIndex::buildIndex(const QList<std::pair<Message, QStringList>> &texts)
+{
+    Index index;
+    index.messages.reserve(texts.size());
+    QList<quint64> trigrams;
+    for (const auto &[message, messageTexts] : texts) {
+        trigrams.clear();
+        for (const QString &text : messageTexts)
+            appendTrigrams(text, &trigrams);
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+        const int id = int(index.messages.size());
+        index.messages.append(message);
+        for (quint64 trigram : std::as_const(trigrams))
+            index.trigrams[trigram].append(id);
+    }
+    return index;
+}
+
+/*
+  Edited messages are not reindexed; they are reported as candidates
+  until the next rebuild instead.
+*/
+void SearchIndex::messageChanged(const MultiDataIndex &index)
+{
+    m_changed.insert(Message(index.context(), index.message()));
+}
+
+/*
+  Stores the messages that may contain \a text in \a candidates, and
+  returns true, or returns false if the index cannot narrow down the
+  search, in which case every message has to be looked at.
+*/
+bool SearchIndex::findCandidates(const QString &text, QSet<Message> *candidates) const
+{
+    if (!m_index.isValid() || !m_index.isFinished() || text.contains(QLatin1Char('&')))
+        return false;
+    QList<quint64> trigrams;
+    appendTrigrams(text, &trigrams);
+    if (trigrams.isEmpty())
+        return false;
+
+    const Index index = m_index.result();
+    QList<const QList<int> *> postings;
+    postings.reserve(trigrams.size());
+    for (quint64 trigram : std::as_const(trigrams)) {
+        const auto it = index.trigrams.constFind(trigram);
+        if (it == index.trigrams.cend()) {
+            postings.clear();
+            break;
+        }
+        postings.append(&it.value());
+    }
+
+    *candidates = m_changed;
+    if (postings.isEmpty())
+        return true;
+    std::sort(postings.begin(), postings.end(),
+              [](const QList<int> *a, const QList<int> *b) { return a->size() < b->size(); });
+    QList<int> ids = *postings.first();
+    QList<int> intersection;
+    for (qsizetype i = 1; i < postings.size() && !ids.isEmpty(); ++i) {
+        intersection.clear();
+        std::set_intersection(ids.cbegin(), ids.cend(),
+                              postings.at(i)->cbegin(), postings.at(i)->cend(),
+                              std::back_inserter(intersection));
+        ids.swap(intersection);
+    }
+    for (int id : std::as_const(ids))
+        candidates->insert(index.messages.at(id));
+    return true;
+}
+
+QT_END_NAMESPACE
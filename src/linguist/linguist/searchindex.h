@@ -0,0 +1,59 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+class MultiDataIndex;
+class MultiDataModel;
+
+/*
+  A trigram index over the case folded texts of all messages of all
+  models, which narrows down the messages that can contain a literal
+  search string. It is built on a worker thread whenever files are opened
+  or closed. Messages that are edited afterwards are always reported as
+  candidates, so the index never needs to be updated in place.
+*/
+class SearchIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    // The context and the message number of a message in the MultiDataModel.
+    using Message = std::pair<int, int>;
+
+    explicit SearchIndex(MultiDataModel *dataModel, QObject *parent = nullptr);
+
+    bool findCandidates(const QString &text, QSet<Message> *candidates) const;
+
+public slots:
+    void rebuild();
+    void messageChanged(const MultiDataIndex &index);
+
+private:
+    struct Index
+    {
+        QList<Message> messages;
+        QHash<quint64, QList<int>> trigrams;
+    };
+
+    static Index buildIndex(const QList<std::pair<Message, QStringList>> &texts);
+
+    MultiDataModel *m_dataModel;
+    QFuture<Index> m_index;
+    QSet<Message> m_changed;
+};
+
+QT_END_NAMESPACE
+
+#endif // SEARCHINDEX_H
@@ -5,78 +5,156 @@
 
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QFuture>
 #include <QtCore/QTextStream>
 
 #include <QtGui/QTextCharFormat>
 #include <QtGui/QTextBlock>
 #include <QtGui/QTextCursor>
+#include <QtGui/QTextDocument>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+const int MaxDocuments = 8;
+const int UpdateDelayMS = 50;
+
+struct SourceFile
+{
+    enum Status { Loaded, Missing, Unreadable };
+    Status status = Missing;
+    QString text;
+};
+
+SourceFile readSourceFile(const QString &fileName)
+{
+    SourceFile result;
+    QFile file(fileName);
+    if (!file.exists())
+        return result;
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        result.status = SourceFile::Unreadable;
+        return result;
+    }
+    result.status = SourceFile::Loaded;
+    result.text = QString::fromUtf8(file.readAll());
+    return result;
+}
+
+} // namespace
+
 SourceCodeView::SourceCodeView(QWidget *parent)
   : QPlainTextEdit(parent),
     m_isActive(true),
     m_lineNumToLoad(0)
 {
     setReadOnly(true);
+    // The default document of the editor is deleted when another one is
+    // set, so the messages are shown in a document of the view.
+    m_messageDocument = new QTextDocument(this);
+    m_messageDocument->setDocumentLayout(new QPlainTextDocumentLayout(m_messageDocument));
+    m_messageDocument->setDefaultFont(font());
+    setDocument(m_messageDocument);
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(UpdateDelayMS);
+    connect(&m_updateTimer, &QTimer::timeout, this, &SourceCodeView::loadPendingSourceCode);
 }
 
 void SourceCodeView::setSourceContext(const QString &fileName, const int lineNum)
 {
     m_fileToLoad.clear();
+    m_updateTimer.stop();
+    ++m_loadRequest;
     setToolTip(fileName);
 
     if (fileName.isEmpty()) {
-        clear();
-        m_currentFileName.clear();
-        appendHtml(tr("<i>Source code not available</i>"));
+        showMessage(tr("<i>Source code not available</i>"));
         return;
     }
 
-    if (m_isActive) {
-        showSourceCode(fileName, lineNum);
-    } else {
-        m_fileToLoad = fileName;
-        m_lineNumToLoad = lineNum;
-    }
+    m_fileToLoad = fileName;
+    m_lineNumToLoad = lineNum;
+    if (m_isActive)
+        m_updateTimer.start();
 }
 
 void SourceCodeView::setActivated(bool activated)
 {
     m_isActive = activated;
-    if (activated && !m_fileToLoad.isEmpty()) {
-        showSourceCode(m_fileToLoad, m_lineNumToLoad);
-        m_fileToLoad.clear();
-    }
+    if (activated && !m_fileToLoad.isEmpty())
+        m_updateTimer.start();
 }
 
-void SourceCodeView::showSourceCode(const QString &absFileName, const int lineNum)
+void SourceCodeView::loadPendingSourceCode()
 {
-    QString fileText = fileHash.value(absFileName);
-
-    if (fileText.isNull()) { // File not in hash
-        m_currentFileName.clear();
-
-        // Assume fileName is relative to directory
-        QFile file(absFileName);
+    if (!m_isActive || m_fileToLoad.isEmpty())
+        return;
+    const QString fileName = std::exchange(m_fileToLoad, QString());
+    showSourceCode(fileName, m_lineNumToLoad);
+}
 
-        if (!file.exists()) {
-            clear();
-            appendHtml(tr("<i>File %1 not available</i>").arg(absFileName));
-            return;
-        }
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            clear();
-            appendHtml(tr("<i>File %1 not readable</i>").arg(absFileName));
+/*
+  Shows the cached document of \a absFileName right away, or reads the
+  file on a worker thread first. The previous file stays visible until
+  the new one is loaded.
+*/
+void SourceCodeView::showSourceCode(const QString &absFileName, const int lineNum)
+{
+    for (qsizetype i = 0; i < m_documents.size(); ++i) {
+        if (m_documents.at(i).first == absFileName) {
+            m_documents.move(i, 0);
+            showDocument(m_documents.first().second, absFileName, lineNum);
             return;
         }
-        fileText = QString::fromUtf8(file.readAll());
-        fileHash.insert(absFileName, fileText);
     }
 
+    const int request = ++m_loadRequest;
+    QtFuture::makeReadyValueFuture(absFileName)
+            .then(QtFuture::Launch::Async, readSourceFile)
+            .then(this, [this, request, absFileName, lineNum](const SourceFile &file) {
+                if (request != m_loadRequest)
+                    return;
+                switch (file.status) {
+                case SourceFile::Missing:
+                    showMessage(tr("<i>File %1 not available</i>").arg(absFileName));
+                    return;
+                case SourceFile::Unreadable:
+                    showMessage(tr("<i>File %1 not readable</i>").arg(absFileName));
+                    return;
+                case SourceFile::Loaded:
+                    break;
+                }
+                QTextDocument *doc = new QTextDocument(this);
+                doc->setDocumentLayout(new QPlainTextDocumentLayout(doc));
+                doc->setDefaultFont(font());
+                doc->setPlainText(file.text);
+                addDocument(absFileName, doc);
+                showDocument(doc, absFileName, lineNum);
+            });
+}
+
+void SourceCodeView::addDocument(const QString &fileName, QTextDocument *doc)
+{
+    m_documents.prepend({ fileName, doc });
+    while (m_documents.size() > MaxDocuments)
+        delete m_documents.takeLast().second;
+}
 
+void SourceCodeView::showMessage(const QString &message)
+{
+    setDocument(m_messageDocument);
+    setExtraSelections({});
+    m_currentFileName.clear();
+    clear();
+    appendHtml(message);
+}
+
+void SourceCodeView::showDocument(QTextDocument *doc, const QString &absFileName,
+                                  const int lineNum)
+{
     if (m_currentFileName != absFileName) {
-        setPlainText(fileText);
+        setDocument(doc);
         m_currentFileName = absFileName;
     }
 
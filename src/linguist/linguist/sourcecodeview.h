@@ -5,11 +5,16 @@
 #define SOURCECODEVIEW_H
 
 #include <QDir>
-#include <QHash>
+#include <QList>
 #include <QPlainTextEdit>
+#include <QTimer>
+
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
+class QTextDocument;
+
 class SourceCodeView : public QPlainTextEdit
 {
     Q_OBJECT
@@ -21,14 +26,25 @@ public slots:
     void setActivated(bool activated);
 
 private:
+    void loadPendingSourceCode();
     void showSourceCode(const QString &fileName, const int lineNum);
+    void showDocument(QTextDocument *doc, const QString &fileName, const int lineNum);
+    void showMessage(const QString &message);
+    void addDocument(const QString &fileName, QTextDocument *doc);
 
     bool m_isActive;
     QString m_fileToLoad;
     int m_lineNumToLoad;
     QString m_currentFileName;
-
-    QHash<QString, QString> fileHash;
+    // Coalesces the updates of rapid navigation between messages.
+    QTimer m_updateTimer;
+    int m_loadRequest = 0;
+
+    // Shows the "not available" notes.
+    QTextDocument *m_messageDocument;
+    // The most recently shown source files, already laid out, the most
+    // recent one first.
+    QList<std::pair<QString, QTextDocument *>> m_documents;
 };
 
 QT_END_NAMESPACE
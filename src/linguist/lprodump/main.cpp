@@ -15,14 +15,21 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 using namespace Qt::StringLiterals;
 
@@ -31,9 +38,16 @@ static void printOut(const QString &out)
     std::cout << qPrintable(out);
 }
 
+// Subprojects are evaluated on worker threads. Their messages are
+// collected here and printed in project order once all siblings are done.
+static thread_local QString *messageBuffer = nullptr;
+
 static void printErr(const QString &out)
 {
-    std::cerr << qPrintable(out);
+    if (messageBuffer)
+        messageBuffer->append(out);
+    else
+        std::cerr << qPrintable(out);
 }
 
 static QJsonValue toJsonValue(const QJsonValue &v)
@@ -228,14 +242,23 @@ static void excludeProjects(const ProFileEvaluator &visitor, QStringList *subPro
     }
 }
 
+// Subprojects are evaluated on this pool, which has one thread per core.
+// A thread that waits for subprojects runs those that did not start yet
+// itself, so nested SUBDIRS never wait for a free thread.
+static QThreadPool &evaluationPool()
+{
+    static QThreadPool pool;
+    return pool;
+}
+
 static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
         const QStringList &translationsVariables,
         const QHash<QString, QString> &outDirMap,
-        ProFileGlobals *option, QMakeVfs *vfs, QMakeParser *parser,
+        ProFileGlobals *option, QMakeVfs *vfs, ProFileCache *cache, QMakeParser *parser,
         bool *fail);
 
 static QJsonObject processProject(const QString &proFile, const QStringList &translationsVariables,
-                                  ProFileGlobals *option, QMakeVfs *vfs,
+                                  ProFileGlobals *option, QMakeVfs *vfs, ProFileCache *cache,
                                   QMakeParser *parser, ProFileEvaluator &visitor)
 {
     QJsonObject result;
@@ -264,8 +287,8 @@ static QJsonObject processProject(const QString &proFile, const QStringList &tra
             }
         }
         QJsonArray subResults = processProjects(false, subProFiles, translationsVariables,
-                                                QHash<QString, QString>(), option, vfs, parser,
-                                                nullptr);
+                                                QHash<QString, QString>(), option, vfs, cache,
+                                                parser, nullptr);
         if (!subResults.isEmpty())
             setValue(result, "subProjects", subResults);
     } else {
@@ -278,54 +301,108 @@ static QJsonObject processProject(const QString &proFile, const QStringList &tra
     return result;
 }
 
+static std::optional<QJsonObject> processProjectFile(bool topLevel, const QString &proFile,
+        const QStringList &translationsVariables,
+        ProFileGlobals *option, QMakeVfs *vfs, ProFileCache *cache, QMakeParser *parser,
+        bool *fail)
+{
+    ProFile *pro;
+    if (!(pro = parser->parsedProFile(proFile, topLevel ? QMakeParser::ParseReportMissing
+                                                        : QMakeParser::ParseDefault))) {
+        if (topLevel)
+            *fail = true;
+        return std::nullopt;
+    }
+    ProFileEvaluator visitor(option, parser, vfs, &evalHandler);
+    visitor.setCumulative(true);
+    visitor.setOutputDir(option->shadowedPath(pro->directoryName()));
+    if (!visitor.accept(pro)) {
+        if (topLevel)
+            *fail = true;
+        pro->deref();
+        return std::nullopt;
+    }
+
+    QJsonObject prj = processProject(proFile, translationsVariables, option, vfs, cache, parser,
+                                     visitor);
+    setValue(prj, "projectFile", proFile);
+    QStringList tsFiles;
+    for (const QString &varName : translationsVariables) {
+        if (!visitor.contains(varName))
+            continue;
+        QDir proDir(QFileInfo(proFile).path());
+        const QStringList translations = visitor.values(varName);
+        for (const QString &tsFile : translations)
+            tsFiles << proDir.filePath(tsFile);
+    }
+    if (!tsFiles.isEmpty())
+        setValue(prj, "translations", tsFiles);
+    if (visitor.contains(QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"))) {
+        const QStringList thepathjson = visitor.values(
+            QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"));
+        setValue(prj, "compileCommands", thepathjson.value(0));
+    }
+    pro->deref();
+    return prj;
+}
+
 static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
         const QStringList &translationsVariables,
         const QHash<QString, QString> &outDirMap,
-        ProFileGlobals *option, QMakeVfs *vfs, QMakeParser *parser, bool *fail)
+        ProFileGlobals *option, QMakeVfs *vfs, ProFileCache *cache, QMakeParser *parser,
+        bool *fail)
 {
     QJsonArray result;
-    for (const QString &proFile : proFiles) {
-        if (!outDirMap.isEmpty())
-            option->setDirectories(QFileInfo(proFile).path(), outDirMap[proFile]);
-
-        ProFile *pro;
-        if (!(pro = parser->parsedProFile(proFile, topLevel ? QMakeParser::ParseReportMissing
-                                                            : QMakeParser::ParseDefault))) {
-            if (topLevel)
-                *fail = true;
-            continue;
-        }
-        ProFileEvaluator visitor(option, parser, vfs, &evalHandler);
-        visitor.setCumulative(true);
-        visitor.setOutputDir(option->shadowedPath(pro->directoryName()));
-        if (!visitor.accept(pro)) {
-            if (topLevel)
-                *fail = true;
-            pro->deref();
-            continue;
+    if (topLevel) {
+        for (const QString &proFile : proFiles) {
+            if (!outDirMap.isEmpty())
+                option->setDirectories(QFileInfo(proFile).path(), outDirMap[proFile]);
+
+            if (auto prj = processProjectFile(true, proFile, translationsVariables, option, vfs,
+                                              cache, parser, fail)) {
+                result.append(*prj);
+            }
         }
+        return result;
+    }
 
-        QJsonObject prj = processProject(proFile, translationsVariables, option, vfs, parser,
-                                         visitor);
-        setValue(prj, "projectFile", proFile);
-        QStringList tsFiles;
-        for (const QString &varName : translationsVariables) {
-            if (!visitor.contains(varName))
-                continue;
-            QDir proDir(QFileInfo(proFile).path());
-            const QStringList translations = visitor.values(varName);
-            for (const QString &tsFile : translations)
-                tsFiles << proDir.filePath(tsFile);
-        }
-        if (!tsFiles.isEmpty())
-            setValue(prj, "translations", tsFiles);
-        if (visitor.contains(QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"))) {
-            const QStringList thepathjson = visitor.values(
-                QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"));
-            setValue(prj, "compileCommands", thepathjson.value(0));
-        }
-        result.append(prj);
-        pro->deref();
+    // Sibling subprojects are independent, so evaluate them on the pool.
+    // Each task has its own parser, sharing the cache and the VFS; the
+    // results are put together in the order of SUBDIRS.
+    struct Task
+    {
+        std::unique_ptr<QRunnable> runnable;
+        std::optional<QJsonObject> project;
+        QString messages;
+        QSemaphore done;
+    };
+    const size_t count = size_t(proFiles.size());
+    std::vector<Task> tasks(count);
+    for (size_t i = 0; i < count; ++i) {
+        Task &task = tasks[i];
+        task.runnable.reset(QRunnable::create([&, i] {
+            Task &current = tasks[i];
+            QString *const previousBuffer = std::exchange(messageBuffer, &current.messages);
+            QMakeParser taskParser(cache, vfs, &evalHandler);
+            current.project = processProjectFile(false, proFiles.at(i), translationsVariables,
+                                                 option, vfs, cache, &taskParser, nullptr);
+            messageBuffer = previousBuffer;
+            current.done.release();
+        }));
+        task.runnable->setAutoDelete(false);
+        evaluationPool().start(task.runnable.get());
+    }
+
+    for (Task &task : tasks) {
+        if (evaluationPool().tryTake(task.runnable.get()))
+            task.runnable->run();
+        task.done.acquire();
+    }
+
+    for (const Task &task : tasks) {
+        printErr(task.messages);
+        if (task.project)
+            result.append(*task.project);
     }
     return result;
 }
@@ -423,10 +500,12 @@ int main(int argc, char **argv)
     option.setCommandLineArguments(QDir::currentPath(),
                                    QStringList() << QLatin1String("CONFIG+=lupdate_run"));
     QMakeVfs vfs;
-    QMakeParser parser(0, &vfs, &evalHandler);
+    // The .prf and .pri files that all subprojects load are parsed once
+    ProFileCache proFileCache;
+    QMakeParser parser(&proFileCache, &vfs, &evalHandler);
 
     QJsonArray results = processProjects(true, proFiles, translationsVariables, outDirMap, &option,
-                                         &vfs, &parser, &fail);
+                                         &vfs, &proFileCache, &parser, &fail);
     if (fail)
         return 1;
 
@@ -3,6 +3,7 @@
 
 #include "translator.h"
 
+#include <chrometrace_p.h>
 #include <profileutils.h>
 #include <projectdescriptionreader.h>
 #include <runqttool.h>
@@ -20,22 +21,56 @@
 #include <QtCore/QTextStream>
 #include <QtCore/QLibraryInfo>
 
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 QT_USE_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+struct OutputChunk
+{
+    bool isError;
+    QString text;
+};
+
+// When releasing files in parallel, the output for each file is collected
+// here and printed once the file is done, so messages do not interleave.
+static thread_local QList<OutputChunk> *capturedOutput = nullptr;
+
 static void printOut(const QString & out)
 {
+    if (capturedOutput) {
+        capturedOutput->append({ false, out });
+        return;
+    }
     QTextStream stream(stdout);
     stream << out;
 }
 
 static void printErr(const QString & out)
 {
+    if (capturedOutput) {
+        capturedOutput->append({ true, out });
+        return;
+    }
     QTextStream stream(stderr);
     stream << out;
 }
 
+static void printCapturedOutput(const QList<OutputChunk> &output)
+{
+    for (const OutputChunk &chunk : output) {
+        if (chunk.isError)
+            printErr(chunk.text);
+        else
+            printOut(chunk.text);
+    }
+}
+
 static void printUsage()
 {
     printOut(uR"(Usage:
@@ -64,9 +99,15 @@ Options:
     -markuntranslated <prefix>
            If a message has no real translation, use the source text
            prefixed with the given string instead
+    -perfecthash
+           Add a perfect hash table of the messages to the QM files. Readers
+           that do not know the table ignore it
     -project <filename>
            Name of a file containing the project's description in JSON format.
            Such a file may be generated from a .pro file using the lprodump tool.
+    -j <n>
+           Release up to <n> TS files at the same time. The output is still
+           reported file by file, in the order the files were given.
     -silent
            Do not explain what is being done
     -version
@@ -76,6 +117,7 @@ Options:
 
 static bool loadTsFile(Translator &tor, const QString &tsFileName, bool /* verbose */)
 {
+    const ChromeTrace::Span span("load"_L1, tsFileName);
     ConversionData cd;
     bool ok = tor.load(tsFileName, cd, QLatin1String("auto"));
     if (!ok) {
@@ -91,7 +133,11 @@ static bool loadTsFile(Translator &tor, const QString &tsFileName, bool /* verbo
 static bool releaseTranslator(Translator &tor, const QString &qmFileName,
     ConversionData &cd, bool removeIdentical)
 {
-    tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose());
+    const ChromeTrace::Span span("release"_L1, qmFileName);
+    std::ostringstream duplicates;
+    tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose(), duplicates);
+    if (!duplicates.str().empty())
+        printErr(QString::fromLocal8Bit(duplicates.str().c_str()));
 
     if (cd.isVerbose())
         printOut(QLatin1String("Updating '%1'...\n").arg(qmFileName));
@@ -110,7 +156,11 @@ static bool releaseTranslator(Translator &tor, const QString &qmFileName,
     }
 
     tor.normalizeTranslations(cd);
-    bool ok = saveQM(tor, file, cd);
+    bool ok;
+    {
+        const ChromeTrace::Span saveSpan("squeeze and save"_L1, qmFileName);
+        ok = saveQM(tor, file, cd);
+    }
     file.close();
 
     if (!ok) {
@@ -141,6 +191,62 @@ static bool releaseTsFile(const QString& tsFileName,
     return releaseTranslator(tor, qmFileName, cd, removeIdentical);
 }
 
+/*
+  Releases the given TS files, using up to \a jobs threads. As in the
+  serial case, the first file that fails stops the release: its output is
+  the last one reported, and no files after it are started.
+*/
+static bool releaseTsFiles(const QStringList &tsFileNames, ConversionData &cd,
+    bool removeIdentical, int jobs)
+{
+    const qsizetype count = tsFileNames.size();
+    if (jobs <= 1 || count <= 1) {
+        for (const QString &tsFileName : tsFileNames) {
+            if (!releaseTsFile(tsFileName, cd, removeIdentical))
+                return false;
+        }
+        return true;
+    }
+
+    struct Result
+    {
+        QList<OutputChunk> output;
+        bool ok = false;
+    };
+    std::vector<Result> results(count);
+    std::atomic<qsizetype> next = 0;
+    std::atomic<qsizetype> firstFailure = count;
+
+    const auto worker = [&] {
+        for (qsizetype i = next++; i < count && i < firstFailure; i = next++) {
+            Result &result = results[i];
+            ConversionData fileCd = cd;
+            capturedOutput = &result.output;
+            result.ok = releaseTsFile(tsFileNames.at(i), fileCd, removeIdentical);
+            capturedOutput = nullptr;
+            if (!result.ok) {
+                qsizetype failure = firstFailure;
+                while (i < failure && !firstFailure.compare_exchange_weak(failure, i)) { }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const qsizetype threadCount = std::min<qsizetype>(jobs, count);
+    threads.reserve(threadCount);
+    for (qsizetype t = 0; t < threadCount; ++t)
+        threads.emplace_back(worker);
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (const Result &result : results) {
+        printCapturedOutput(result.output);
+        if (!result.ok)
+            return false;
+    }
+    return true;
+}
+
 static QStringList translationsFromProjects(const Projects &projects, bool topLevel);
 
 static QStringList translationsFromProject(const Project &project, bool topLevel)
@@ -168,10 +274,12 @@ static QStringList translationsFromProjects(const Projects &projects, bool topLe
 int main(int argc, char **argv)
 {
     QCoreApplication app(argc, argv);
+    ChromeTrace::initialize("lrelease"_L1);
 
     ConversionData cd;
     cd.m_verbose = true; // the default is true starting with Qt 4.2
     bool removeIdentical = false;
+    int jobs = 1;
     Translator tor;
     QStringList inputFiles;
     QString outputFile;
@@ -190,6 +298,9 @@ int main(int argc, char **argv)
         } else if (!strcmp(argv[i], "-removeidentical")) {
             removeIdentical = true;
             continue;
+        } else if (!strcmp(argv[i], "-perfecthash")) {
+            cd.m_qmPerfectHash = true;
+            continue;
         } else if (!strcmp(argv[i], "-nounfinished")) {
             cd.m_ignoreUnfinished = true;
             continue;
@@ -209,6 +320,14 @@ int main(int argc, char **argv)
                 return 1;
             }
             projectDescriptionFile = QString::fromLocal8Bit(argv[++i]);
+        } else if (!strcmp(argv[i], "-j")) {
+            bool ok = false;
+            if (i < argc - 1)
+                jobs = QString::fromLocal8Bit(argv[++i]).toInt(&ok);
+            if (!ok || jobs < 1) {
+                printErr(QLatin1String("The option -j requires a positive number.\n"));
+                return 1;
+            }
         } else if (!strcmp(argv[i], "-silent")) {
             cd.m_verbose = false;
             continue;
@@ -260,18 +379,13 @@ int main(int argc, char **argv)
         inputFiles = translationsFromProjects(projectDescription);
     }
 
+    if (outputFile.isEmpty())
+        return releaseTsFiles(inputFiles, cd, removeIdentical, jobs) ? 0 : 1;
+
     for (const QString &inputFile : std::as_const(inputFiles)) {
-        if (outputFile.isEmpty()) {
-            if (!releaseTsFile(inputFile, cd, removeIdentical))
-                return 1;
-        } else {
-            if (!loadTsFile(tor, inputFile, cd.isVerbose()))
-                return 1;
-        }
+        if (!loadTsFile(tor, inputFile, cd.isVerbose()))
+            return 1;
     }
 
-    if (!outputFile.isEmpty())
-        return releaseTranslator(tor, outputFile, cd, removeIdentical) ? 0 : 1;
-
-    return 0;
+    return releaseTranslator(tor, outputFile, cd, removeIdentical) ? 0 : 1;
 }
@@ -2,12 +2,19 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "cpp.h"
+#include "lupdatestats.h"
 
 #include <translator.h>
 #include <QtCore/QBitArray>
-#include <QtCore/QTextStream>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QStringConverter>
 #include <QtCore/QRegularExpression>
 
+#include <algorithm>
+#include <deque>
+#include <future>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -71,7 +78,7 @@ class CppParser : private CppParserState {
 public:
     CppParser(ParseResults *results = 0);
     void setInput(const QString &in);
-    void setInput(QTextStream &ts, const QString &fileName);
+    void setInput(const QString &in, const QString &fileName, QStringConverter::Encoding encoding);
     void setTranslator(Translator *_tor) { tor = _tor; }
     void parse(ConversionData &cd, const QStringList &includeStack, QSet<QString> &inclusions);
     bool parseTranslate(QString &prefix);
@@ -273,11 +280,12 @@ void CppParser::setInput(const QString &in)
     yySourceEncoding = QStringConverter::Utf8;
 }
 
-void CppParser::setInput(QTextStream &ts, const QString &fileName)
+void CppParser::setInput(const QString &in, const QString &fileName,
+                         QStringConverter::Encoding encoding)
 {
-    yyInStr = ts.readAll();
+    yyInStr = in;
     yyFileName = fileName;
-    yySourceEncoding = ts.encoding();
+    yySourceEncoding = encoding;
 }
 
 /*
@@ -1319,6 +1327,47 @@ static bool isHeader(const QString &name)
     return fileExt.isEmpty() || fileExt.startsWith(QLatin1Char('h'), Qt::CaseInsensitive);
 }
 
+struct CppSourceText
+{
+    bool opened = false;
+    QString text;
+    QStringConverter::Encoding encoding = QStringConverter::Utf8;
+    QString errorString;
+    bool mayContainMessages = true;
+};
+
+/*
+  Reads the file \a filename, decoding it according to its byte order
+  mark or, if it has none, as \a e. The file is mapped into memory and
+  decoded in one go. Only touches its own data, so that it can run on
+  any thread.
+*/
+static CppSourceText readCppSource(const QString &filename, QStringConverter::Encoding e)
+{
+    CppSourceText source;
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        source.errorString = file.errorString();
+        return source;
+    }
+
+    QByteArray buffer;
+    QByteArrayView bytes;
+    const qint64 size = file.size();
+    if (const uchar *data = size > 0 ? file.map(0, size) : nullptr) {
+        bytes = QByteArrayView(data, size);
+    } else {
+        buffer = file.readAll();
+        bytes = buffer;
+    }
+
+    source.encoding = QStringConverter::encodingForData(bytes).value_or(e);
+    QStringDecoder decoder(source.encoding);
+    source.text = decoder.decode(bytes);
+    source.opened = true;
+    return source;
+}
+
 void CppParser::processInclude(const QString &file, ConversionData &cd, const QStringList &includeStack,
                                QSet<QString> &inclusions)
 {
@@ -1353,17 +1402,13 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
         isIndirect = true;
     }
 
-    QFile f(cleanFile);
-    if (!f.open(QIODevice::ReadOnly)) {
+    const CppSourceText source = readCppSource(cleanFile, yySourceEncoding);
+    if (!source.opened) {
         yyMsg() << qPrintable(
-            QStringLiteral("Cannot open %1: %2\n").arg(cleanFile, f.errorString()));
+            QStringLiteral("Cannot open %1: %2\n").arg(cleanFile, source.errorString));
         return;
     }
 
-    QTextStream ts(&f);
-    ts.setEncoding(yySourceEncoding);
-    ts.setAutoDetectUnicode(true);
-
     inclusions.insert(cleanFile);
     if (isIndirect) {
         CppParser parser;
@@ -1372,7 +1417,7 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
                 parser.setTranslator(new Translator);
                 break;
             }
-        parser.setInput(ts, cleanFile);
+        parser.setInput(source.text, cleanFile, source.encoding);
         QStringList stack = includeStack;
         stack << cleanFile;
         parser.parse(cd, stack, inclusions);
@@ -1382,7 +1427,7 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
         parser.namespaces = namespaces;
         parser.functionContext = functionContext;
         parser.functionContextUnresolved = functionContextUnresolved;
-        parser.setInput(ts, cleanFile);
+        parser.setInput(source.text, cleanFile, source.encoding);
         parser.setTranslator(tor);
         QStringList stack = includeStack;
         stack << cleanFile;
@@ -2357,31 +2402,107 @@ const ParseResults *CppParser::recordResults(bool isHeader)
     }
 }
 
+static bool isIdentifierChar(char16_t c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static bool lessThan(QStringView lhs, QStringView rhs)
+{
+    return lhs.compare(rhs) < 0;
+}
+
+/*
+  Returns false if \a text cannot yield any message when parsed, because
+  none of its identifiers is one of the sorted \a names, and it does not
+  directly scan another source file through an #include.
+
+  Errs on the side of returning true; non-ASCII characters end identifiers.
+*/
+static bool mayContainMessages(QStringView text, const QStringList &names)
+{
+    const qsizetype size = text.size();
+    for (qsizetype i = 0; i < size;) {
+        if (!isIdentifierChar(text[i].unicode())) {
+            ++i;
+            continue;
+        }
+        const qsizetype start = i;
+        while (i < size && isIdentifierChar(text[i].unicode()))
+            ++i;
+        const QStringView word = text.sliced(start, i - start);
+        if (std::binary_search(names.cbegin(), names.cend(), word, lessThan))
+            return true;
+
+        if (word == u"include") {
+            qsizetype j = i;
+            while (j < size && (text[j] == u' ' || text[j] == u'\t'))
+                ++j;
+            if (j == size || (text[j] != u'"' && text[j] != u'<'))
+                continue;
+            const char16_t close = text[j] == u'"' ? u'"' : u'>';
+            const qsizetype end = text.indexOf(close, j + 1);
+            if (end != -1 && !isHeader(text.sliced(j + 1, end - j - 1).toString()))
+                return true;
+        }
+    }
+    return false;
+}
+
 void loadCPP(Translator &translator, const QStringList &filenames, ConversionData &cd)
 {
     QStringConverter::Encoding e = cd.m_sourceIsUtf16 ? QStringConverter::Utf16 : QStringConverter::Utf8;
 
+    // The parser shares its caches between the files, which therefore
+    // have to be parsed one after another. Reading and decoding them is
+    // independent, though, so let worker threads do that ahead.
+    const size_t jobs = std::max(lupdateThreadCount(), 1u);
+    const auto policy = jobs > 1 ? std::launch::async : std::launch::deferred;
+    std::deque<std::future<CppSourceText>> pending;
+    qsizetype next = 0;
+
+    // Files that do not mention any of the active tr() functions, their
+    // aliases or the TRANSLATOR comment do not need to be parsed. If
+    // another file includes them for their declarations, they are
+    // parsed at that point.
+    QStringList trNames = trFunctionAliasManager.nameToTrFunctionMap().keys();
+    trNames << CppMagicComment;
+    std::sort(trNames.begin(), trNames.end(), lessThan);
+    const auto read = [&trNames, e](const QString &filename) {
+        CppSourceText source = readCppSource(filename, e);
+        source.mayContainMessages = source.opened && mayContainMessages(source.text, trNames);
+        return source;
+    };
+
     for (const QString &filename : filenames) {
+        while (pending.size() < jobs && next < filenames.size())
+            pending.push_back(std::async(policy, read, filenames.at(next++)));
+        const CppSourceText source = pending.front().get();
+        pending.pop_front();
+
         if (!CppFiles::getResults(ResultsCacheKey(filename)).isEmpty() || CppFiles::isBlacklisted(filename))
             continue;
 
-        QFile file(filename);
-        if (!file.open(QIODevice::ReadOnly)) {
+        if (!source.opened) {
             cd.appendError(QStringLiteral("Cannot open %1: %2").arg(filename,
-                                                                    file.errorString()));
+                                                                    source.errorString));
             continue;
         }
 
+        if (!source.mayContainMessages)
+            continue;
+
+        QElapsedTimer timer;
+        timer.start();
         CppParser parser;
-        QTextStream ts(&file);
-        ts.setEncoding(e);
-        ts.setAutoDetectUnicode(true);
-        parser.setInput(ts, filename);
+        parser.setInput(source.text, filename, source.encoding);
         Translator *tor = new Translator;
         parser.setTranslator(tor);
         QSet<QString> inclusions;
         parser.parse(cd, QStringList(), inclusions);
         parser.recordResults(isHeader(filename));
+        // Includes parsed for this file the first time count towards it.
+        LupdateStats::addFileTime(filename, timer.nsecsElapsed());
     }
 
     for (const QString &filename : filenames) {
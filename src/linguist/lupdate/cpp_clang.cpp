@@ -4,12 +4,15 @@
 #include "cpp_clang.h"
 #include "clangtoolastreader.h"
 #include "filesignificancecheck.h"
+#include "lupdatestats.h"
 #include "lupdatepreprocessoraction.h"
+#include "sharedfilecache.h"
 #include "synchronized.h"
 #include "translator.h"
 
 #include <QLibraryInfo>
 #include <QtCore/qdir.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
@@ -40,6 +43,7 @@ QT_BEGIN_NAMESPACE
 using namespace Qt::StringLiterals;
 
 Q_LOGGING_CATEGORY(lcClang, "qt.lupdate.clang");
+Q_LOGGING_CATEGORY(lcClangStats, "qt.lupdate.clang.stats", QtWarningMsg);
 
 static QString getSysCompiler()
 {
@@ -457,21 +461,48 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     TranslationStores ast, qdecl, qnoop;
     Stores stores(ast, qdecl, qnoop);
 
+    // Producers pull the next file from a shared queue as soon as they are
+    // done with the previous one. Start with the largest files, so that a
+    // few big translation units are not left running alone at the end.
+    std::vector<std::string> schedule = sources;
+    {
+        std::vector<std::pair<qint64, std::string>> bySize;
+        bySize.reserve(sources.size());
+        for (const QString &filename : files)
+            bySize.emplace_back(QFileInfo(filename).size(), filename.toStdString());
+        std::stable_sort(bySize.begin(), bySize.end(),
+                         [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+        std::transform(bySize.begin(), bySize.end(), schedule.begin(),
+                       [](auto &entry) { return std::move(entry.second); });
+    }
+
     std::vector<std::thread> producers;
-    ReadSynchronizedRef<std::string> ppSources(sources);
+    ReadSynchronizedRef<std::string> ppSources(schedule);
     WriteSynchronizedRef<TranslationRelatedStore> ppStore(stores.Preprocessor);
-    size_t idealProducerCount = std::min(ppSources.size(), size_t(std::thread::hardware_concurrency()));
+    size_t idealProducerCount = std::min(ppSources.size(), size_t(lupdateThreadCount()));
     clang::tooling::ArgumentsAdjuster argumentsAdjusterSyntaxOnly =
             clang::tooling::getClangSyntaxOnlyAdjuster();
     clang::tooling::ArgumentsAdjuster argumentsAdjusterLocal = getClangArgumentAdjuster();
     clang::tooling::ArgumentsAdjuster argumentsAdjuster =
             clang::tooling::combineAdjusters(argumentsAdjusterLocal, argumentsAdjusterSyntaxOnly);
 
+    // Both passes over all the translation units read the same headers.
+    SharedFileCache fileCache;
+
+    QElapsedTimer stageTimer;
+    stageTimer.start();
     for (size_t i = 0; i < idealProducerCount; ++i) {
-        std::thread producer([&ppSources, &db, &ppStore, &argumentsAdjuster]() {
+        std::thread producer([&ppSources, &db, &ppStore, &argumentsAdjuster, &fileCache]() {
+            const auto fileSystem = fileCache.createFileSystem();
             std::string file;
             while (ppSources.next(&file)) {
-                clang::tooling::ClangTool tool(*db, file);
+                const ChromeTrace::Span span("clang preprocessor"_L1,
+                                             ChromeTrace::isEnabled()
+                                                     ? QString::fromStdString(file)
+                                                     : QString());
+                clang::tooling::ClangTool tool(*db, file,
+                                               std::make_shared<clang::PCHContainerOperations>(),
+                                               fileSystem);
                 tool.appendArgumentsAdjuster(argumentsAdjuster);
                 tool.run(new LupdatePreprocessorActionFactory(&ppStore));
             }
@@ -481,14 +512,23 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     for (auto &producer : producers)
         producer.join();
     producers.clear();
+    LupdateStats::addStageTime("clang preprocessor pass"_L1, stageTimer.nsecsElapsed());
 
-    ReadSynchronizedRef<std::string> astSources(sources);
-    idealProducerCount = std::min(astSources.size(), size_t(std::thread::hardware_concurrency()));
+    ReadSynchronizedRef<std::string> astSources(schedule);
+    stageTimer.restart();
+    idealProducerCount = std::min(astSources.size(), size_t(lupdateThreadCount()));
     for (size_t i = 0; i < idealProducerCount; ++i) {
-        std::thread producer([&astSources, &db, &stores, &argumentsAdjuster]() {
+        std::thread producer([&astSources, &db, &stores, &argumentsAdjuster, &fileCache]() {
+            const auto fileSystem = fileCache.createFileSystem();
             std::string file;
             while (astSources.next(&file)) {
-                clang::tooling::ClangTool tool(*db, file);
+                const ChromeTrace::Span span("clang AST"_L1,
+                                             ChromeTrace::isEnabled()
+                                                     ? QString::fromStdString(file)
+                                                     : QString());
+                clang::tooling::ClangTool tool(*db, file,
+                                               std::make_shared<clang::PCHContainerOperations>(),
+                                               fileSystem);
                 tool.appendArgumentsAdjuster(argumentsAdjuster);
                 tool.run(new LupdateToolActionFactory(&stores));
             }
@@ -498,6 +538,7 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     for (auto &producer : producers)
         producer.join();
     producers.clear();
+    LupdateStats::addStageTime("clang AST pass"_L1, stageTimer.nsecsElapsed());
 
     TranslationStores finalStores;
     WriteSynchronizedRef<TranslationRelatedStore> wsv(finalStores);
@@ -510,6 +551,15 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     //(because Q_DECLARE_TR_FUNCTION context is already applied).
     ClangCppParser::finalize(rsvQNoop, wsv);
 
+    const auto waitTime = [](const WriteSynchronizedRef<TranslationRelatedStore> &store) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(store.waitTime()).count();
+    };
+    qCInfo(lcClangStats) << "Time spent waiting on stores (ms): preprocessor"
+                         << waitTime(ppStore) << "AST" << waitTime(stores.AST)
+                         << "Q_DECLARE_TR_FUNCTIONS" << waitTime(stores.QDeclareTrWithContext)
+                         << "QT_TR_NOOP" << waitTime(stores.QNoopTranlsationWithContext)
+                         << "final" << waitTime(wsv);
+
     TranslatorMessageVector messages;
     for (auto &store : finalStores)
         ClangCppParser::collectMessages(messages, store);
@@ -674,20 +724,24 @@ TranslatorMessage ClangCppParser::translatorMessage(const TranslationRelatedStor
 
 #define START_THREADS(RSV, WSV) \
     std::vector<std::thread> producers; \
-    const size_t idealProducerCount = std::min(RSV.size(), size_t(std::thread::hardware_concurrency())); \
+    const size_t idealProducerCount = std::min(RSV.size(), size_t(lupdateThreadCount())); \
     \
     for (size_t i = 0; i < idealProducerCount; ++i) { \
         std::thread producer([&]() { \
+            /* Collect into a per-thread shard and publish it once, */ \
+            /* instead of locking the shared store for every entry. */ \
+            TranslationStores shard; \
             TranslationRelatedStore store; \
             while (RSV.next(&store)) { \
                 if (!store.contextArg.isEmpty()) { \
-                    WSV.emplace_back(std::move(store)); \
+                    shard.emplace_back(std::move(store)); \
                     continue; \
                 }
 
 #define JOIN_THREADS(WSV) \
-                WSV.emplace_back(std::move(store)); \
+                shard.emplace_back(std::move(store)); \
             } \
+            WSV.emplace_bulk(std::move(shard)); \
         }); \
         producers.emplace_back(std::move(producer)); \
     } \
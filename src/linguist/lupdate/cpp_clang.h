@@ -32,6 +32,7 @@ QT_WARNING_POP
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(lcClang)
+Q_DECLARE_LOGGING_CATEGORY(lcClangStats)
 
 inline QString toQt(llvm::StringRef str)
 {
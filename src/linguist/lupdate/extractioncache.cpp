@@ -0,0 +1,311 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "extractioncache.h"
+
+#include <translator.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static const quint32 cacheMagic = 0x4c554343; // "LUCC"
+static const quint32 cacheVersion = 1;
+static const QString extraCommentSeparator = u"\n----------\n"_s;
+
+QString &ExtractionCache::directory()
+{
+    static QString dir;
+    return dir;
+}
+
+void ExtractionCache::setDirectory(const QString &dir)
+{
+    directory() = dir;
+}
+
+bool ExtractionCache::isEnabled()
+{
+    return !directory().isEmpty();
+}
+
+// Everything besides the file contents that affects what the extractors produce.
+static QByteArray configurationKey(const ConversionData &cd)
+{
+    static const QByteArray toolKey = [] {
+        const QFileInfo tool(QCoreApplication::applicationFilePath());
+        return QByteArray(QT_VERSION_STR) + '\0' + QByteArray::number(tool.size()) + '\0'
+                + QByteArray::number(tool.lastModified().toMSecsSinceEpoch());
+    }();
+
+    QByteArray key = toolKey;
+    key += '\0' + trFunctionAliasManager.availableFunctionsWithAliases().join(u',').toUtf8();
+    key += '\0' + cd.m_defaultContext.toUtf8();
+    key += '\0';
+    key += cd.m_sourceIsUtf16 ? '1' : '0';
+    key += cd.m_noUiLines ? '1' : '0';
+    key += cd.m_idBased ? '1' : '0';
+    return key;
+}
+
+static void writeMessage(QDataStream &out, const TranslatorMessage &msg)
+{
+    out << msg.id() << msg.context() << msg.sourceText() << msg.comment() << msg.userData()
+        << msg.extras() << msg.extraComment() << msg.translatorComment() << msg.warning()
+        << msg.translations() << qint32(msg.type()) << msg.isPlural() << msg.warningOnly();
+    const TranslatorMessage::References refs = msg.allReferences();
+    out << quint32(refs.size());
+    for (const TranslatorMessage::Reference &ref : refs)
+        out << ref.fileName() << qint32(ref.lineNumber());
+}
+
+static bool readMessage(QDataStream &in, TranslatorMessage &msg)
+{
+    QString id, context, sourceText, comment, userData, extraComment, translatorComment, warning;
+    TranslatorMessage::ExtraData extras;
+    QStringList translations;
+    qint32 type;
+    bool plural, warningOnly;
+    quint32 refCount;
+    in >> id >> context >> sourceText >> comment >> userData >> extras >> extraComment
+        >> translatorComment >> warning >> translations >> type >> plural >> warningOnly
+        >> refCount;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    msg.setId(id);
+    msg.setContext(context);
+    msg.setSourceText(sourceText);
+    msg.setComment(comment);
+    msg.setUserData(userData);
+    msg.setExtras(extras);
+    msg.setExtraComment(extraComment);
+    msg.setTranslatorComment(translatorComment);
+    msg.setWarning(warning);
+    msg.setTranslations(translations);
+    msg.setType(TranslatorMessage::Type(type));
+    msg.setPlural(plural);
+    msg.setWarningOnly(warningOnly);
+    for (quint32 i = 0; i < refCount; ++i) {
+        QString fileName;
+        qint32 lineNumber;
+        in >> fileName >> lineNumber;
+        if (in.status() != QDataStream::Ok)
+            return false;
+        msg.addReference(fileName, lineNumber);
+    }
+    return true;
+}
+
+/*
+  Adds \a msg, which was extracted into a translator of its own, to
+  \a translator. Translator::extend() only looks at the primary reference
+  of a message, so the references and the merged extra comments are
+  replayed one by one, as if the extractor had reported each occurrence.
+*/
+static void extendWithExtracted(Translator &translator, const TranslatorMessage &msg,
+                                ConversionData &cd)
+{
+    const TranslatorMessage::References refs = msg.allReferences();
+    const QStringList extraComments = msg.extraComment().split(extraCommentSeparator);
+    const qsizetype occurrences = std::max(refs.size(), extraComments.size());
+    for (qsizetype i = 0; i < occurrences; ++i) {
+        TranslatorMessage occurrence = msg;
+        occurrence.clearReferences();
+        const TranslatorMessage::Reference ref =
+                refs.value(i, refs.isEmpty() ? TranslatorMessage::Reference(QString(), -1)
+                                             : refs.first());
+        occurrence.setFileName(ref.fileName());
+        occurrence.setLineNumber(ref.lineNumber());
+        occurrence.setExtraComment(extraComments.value(i));
+        translator.extend(occurrence, cd);
+    }
+}
+
+// Records what an extractor writes to std::cerr and through qWarning(),
+// so that it can be shown again when the cache entry is used. The message
+// handler and the stream buffer of std::cerr are replaced for the lifetime
+// of the recorder only, and messages of other threads are passed on to
+// the previous handler.
+class DiagnosticsRecorder
+{
+public:
+    DiagnosticsRecorder()
+        : m_thread(QThread::currentThread()),
+          m_previousRecorder(std::exchange(current(), this))
+    {
+        m_previousBuffer = std::cerr.rdbuf(m_stream.rdbuf());
+        m_previousHandler = qInstallMessageHandler(&DiagnosticsRecorder::handleMessage);
+    }
+
+    ~DiagnosticsRecorder() { restore(); }
+
+    QByteArray finish()
+    {
+        restore();
+        m_text += m_stream.str();
+        m_stream.str(std::string());
+        return m_text;
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(DiagnosticsRecorder)
+
+    void restore()
+    {
+        if (!m_recording)
+            return;
+        m_recording = false;
+        qInstallMessageHandler(m_previousHandler);
+        std::cerr.rdbuf(m_previousBuffer);
+        current() = m_previousRecorder;
+    }
+
+    static DiagnosticsRecorder *&current()
+    {
+        static DiagnosticsRecorder *recorder = nullptr;
+        return recorder;
+    }
+
+    static void handleMessage(QtMsgType type, const QMessageLogContext &context,
+                              const QString &message)
+    {
+        DiagnosticsRecorder *recorder = current();
+        if (QThread::currentThread() != recorder->m_thread) {
+            if (recorder->m_previousHandler)
+                recorder->m_previousHandler(type, context, message);
+            return;
+        }
+        recorder->m_text += recorder->m_stream.str();
+        recorder->m_stream.str(std::string());
+        recorder->m_text += qFormatLogMessage(type, context, message).toLocal8Bit() + '\n';
+    }
+
+    QThread *const m_thread;
+    DiagnosticsRecorder *const m_previousRecorder;
+    std::ostringstream m_stream;
+    std::streambuf *m_previousBuffer = nullptr;
+    QtMessageHandler m_previousHandler = nullptr;
+    QByteArray m_text;
+    bool m_recording = true;
+};
+
+static bool loadEntry(const QString &entryPath, Translator &translator, ConversionData &cd)
+{
+    QFile file(entryPath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic, version, count;
+    QByteArray diagnostics;
+    in >> magic >> version;
+    if (magic != cacheMagic || version != cacheVersion)
+        return false;
+    in >> diagnostics >> count;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    QList<TranslatorMessage> messages;
+    messages.reserve(count);
+    for (quint32 i = 0; i < count; ++i) {
+        TranslatorMessage msg;
+        if (!readMessage(in, msg))
+            return false;
+        messages.append(msg);
+    }
+
+    std::cerr << diagnostics.constData();
+    for (const TranslatorMessage &msg : std::as_const(messages))
+        extendWithExtracted(translator, msg, cd);
+    return true;
+}
+
+static void saveEntry(const QString &entryPath, const Translator &extracted,
+                      const QByteArray &diagnostics)
+{
+    QSaveFile file(entryPath);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << cacheMagic << cacheVersion << diagnostics << quint32(extracted.messageCount());
+    for (const TranslatorMessage &msg : extracted.messages())
+        writeMessage(out, msg);
+    file.commit();
+}
+
+/*
+  Runs \a extractor on \a fileName, adding the extracted messages to
+  \a translator. If a cache directory is set, the result is looked up by
+  a hash of the file name, its contents, and all options that influence
+  extraction. Results are only stored if the extractor succeeded without
+  reporting errors, so that errors are reported on every run.
+*/
+bool ExtractionCache::extract(Extractor extractor, Translator &translator,
+                              const QString &fileName, ConversionData &cd)
+{
+    if (!isEnabled())
+        return extractor(translator, fileName, cd);
+
+    QFile source(fileName);
+    if (!source.open(QIODevice::ReadOnly))
+        return extractor(translator, fileName, cd);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(configurationKey(cd));
+    hash.addData(QByteArrayView("", 1));
+    hash.addData(fileName.toUtf8());
+    hash.addData(QByteArrayView("", 1));
+    if (!hash.addData(&source))
+        return extractor(translator, fileName, cd);
+    source.close();
+
+    const QString entryPath =
+            directory() + u'/' + QString::fromLatin1(hash.result().toHex()) + u".msgs"_s;
+    if (loadEntry(entryPath, translator, cd))
+        return true;
+
+    Translator extracted;
+    const qsizetype errorCount = cd.errors().size();
+    DiagnosticsRecorder recorder;
+    const bool ok = extractor(extracted, fileName, cd);
+    const QByteArray diagnostics = recorder.finish();
+    std::cerr << diagnostics.constData();
+
+    addExtracted(translator, extracted, cd);
+
+    if (ok && cd.errors().size() == errorCount && QDir().mkpath(directory()))
+        saveEntry(entryPath, extracted, diagnostics);
+    return ok;
+}
+
+/*
+  Adds the messages of \a extracted, which an extractor filled for a single
+  file, to \a translator, as if the extractor had run on \a translator.
+*/
+void ExtractionCache::addExtracted(Translator &translator, const Translator &extracted,
+                                   ConversionData &cd)
+{
+    for (const TranslatorMessage &msg : extracted.messages())
+        extendWithExtracted(translator, msg, cd);
+}
+
+QT_END_NAMESPACE
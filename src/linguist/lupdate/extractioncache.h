@@ -0,0 +1,37 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef EXTRACTIONCACHE_H
+#define EXTRACTIONCACHE_H
+
+#include "lupdate.h"
+
+#include <QtCore/QString>
+
+QT_BEGIN_NAMESPACE
+
+class ConversionData;
+class Translator;
+
+// On-disk cache for the messages extracted from self-contained source
+// files (QML, JavaScript, UI, Java and Python). C++ sources are not
+// cached: the messages of a C++ file depend on the headers it includes.
+class ExtractionCache {
+public:
+    using Extractor = bool (*)(Translator &, const QString &, ConversionData &);
+
+    static void setDirectory(const QString &directory);
+    static bool isEnabled();
+
+    static bool extract(Extractor extractor, Translator &translator, const QString &fileName,
+                        ConversionData &cd);
+    static void addExtracted(Translator &translator, const Translator &extracted,
+                             ConversionData &cd);
+
+private:
+    static QString &directory();
+};
+
+QT_END_NAMESPACE
+
+#endif // EXTRACTIONCACHE_H
@@ -73,7 +73,7 @@ static QStack<Scope*> yyScope;
 
 std::ostream &yyMsg(int line = 0)
 {
-    return std::cerr << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
+    return extractorDiagnostics() << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
 }
 
 static QChar getChar()
@@ -14,6 +14,8 @@
 #include <QtCore/QStringList>
 #include <QtCore/QTranslator>
 
+#include <iosfwd>
+
 QT_BEGIN_NAMESPACE
 
 class ConversionData;
@@ -38,6 +40,15 @@ enum UpdateOption {
 Q_DECLARE_FLAGS(UpdateOptions, UpdateOption)
 Q_DECLARE_OPERATORS_FOR_FLAGS(UpdateOptions)
 
+// Maximum number of worker threads lupdate uses, as set with -j.
+// Defaults to the number of CPU cores.
+unsigned lupdateThreadCount();
+void setLupdateThreadCount(unsigned count);
+
+// The stream the extractors write their warnings to. This is std::cerr,
+// unless the file is extracted on a worker thread.
+std::ostream &extractorDiagnostics();
+
 Translator merge(
     const Translator &tor, const Translator &virginTor, const QList<Translator> &aliens,
     UpdateOptions options, QString &err);
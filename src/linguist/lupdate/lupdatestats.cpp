@@ -0,0 +1,169 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "lupdatestats.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <utility>
+
+#if defined(Q_OS_WIN)
+#  include <qt_windows.h>
+#  include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#  include <sys/resource.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static constexpr qsizetype slowestFileCount = 10;
+
+namespace {
+struct Stats
+{
+    QMutex mutex;
+    QList<std::pair<QLatin1StringView, qint64>> stages; // In the order they were first used
+    QList<std::pair<QString, qint64>> files;
+};
+}
+
+static std::atomic<bool> statsEnabled = false;
+
+static Stats &stats()
+{
+    static Stats s;
+    return s;
+}
+
+void LupdateStats::setEnabled(bool enabled)
+{
+    statsEnabled = enabled;
+}
+
+bool LupdateStats::isEnabled()
+{
+    return statsEnabled;
+}
+
+void LupdateStats::addStageTime(QLatin1StringView stage, qint64 nsecs)
+{
+    if (!isEnabled())
+        return;
+    Stats &s = stats();
+    QMutexLocker locker(&s.mutex);
+    auto it = std::find_if(s.stages.begin(), s.stages.end(),
+                           [stage](const auto &entry) { return entry.first == stage; });
+    if (it == s.stages.end())
+        s.stages.emplace_back(stage, nsecs);
+    else
+        it->second += nsecs;
+}
+
+void LupdateStats::reset()
+{
+    Stats &s = stats();
+    QMutexLocker locker(&s.mutex);
+    s.stages.clear();
+    s.files.clear();
+}
+
+void LupdateStats::addFileTime(const QString &fileName, qint64 nsecs)
+{
+    if (!isEnabled())
+        return;
+    Stats &s = stats();
+    QMutexLocker locker(&s.mutex);
+    s.files.emplace_back(fileName, nsecs);
+}
+
+// Returns the peak resident set size of the process in bytes, or -1.
+static qint64 peakMemoryUsage()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return qint64(counters.PeakWorkingSetSize);
+    return -1;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#  if defined(Q_OS_DARWIN)
+    return qint64(usage.ru_maxrss);
+#  else
+    return qint64(usage.ru_maxrss) * 1024;
+#  endif
+#else
+    return -1;
+#endif
+}
+
+static QList<std::pair<QString, qint64>> slowestFiles(const Stats &s)
+{
+    QList<std::pair<QString, qint64>> files = s.files;
+    const qsizetype count = std::min(files.size(), slowestFileCount);
+    std::partial_sort(files.begin(), files.begin() + count, files.end(),
+                      [](const auto &a, const auto &b) { return a.second > b.second; });
+    files.resize(count);
+    return files;
+}
+
+static qint64 toMsecs(qint64 nsecs)
+{
+    return (nsecs + 500000) / 1000000;
+}
+
+void LupdateStats::printReport()
+{
+    Stats &s = stats();
+    QMutexLocker locker(&s.mutex);
+    QString report = u"Timing:\n"_s;
+    for (const auto &[stage, nsecs] : std::as_const(s.stages))
+        report += u"    %1 ms  %2\n"_s.arg(toMsecs(nsecs), 8).arg(stage);
+    const auto files = slowestFiles(s);
+    if (!files.isEmpty()) {
+        report += u"Slowest files:\n"_s;
+        for (const auto &[fileName, nsecs] : files)
+            report += u"    %1 ms  %2\n"_s.arg(toMsecs(nsecs), 8).arg(fileName);
+    }
+    const qint64 peak = peakMemoryUsage();
+    if (peak >= 0)
+        report += u"Peak memory usage: %1 MiB\n"_s.arg(peak / (1024 * 1024));
+    std::cout << qPrintable(report);
+}
+
+bool LupdateStats::writeJson(const QString &fileName, QString *errorString)
+{
+    Stats &s = stats();
+    QMutexLocker locker(&s.mutex);
+    QJsonArray stages;
+    for (const auto &[stage, nsecs] : std::as_const(s.stages))
+        stages.append(QJsonObject{ { "name"_L1, QString(stage) }, { "msecs"_L1, toMsecs(nsecs) } });
+    QJsonArray files;
+    for (const auto &[fileName, nsecs] : slowestFiles(s))
+        files.append(QJsonObject{ { "file"_L1, fileName }, { "msecs"_L1, toMsecs(nsecs) } });
+    QJsonObject root{ { "stages"_L1, stages }, { "slowestFiles"_L1, files } };
+    const qint64 peak = peakMemoryUsage();
+    if (peak >= 0)
+        root.insert("peakMemoryBytes"_L1, peak);
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
+
+QT_END_NAMESPACE
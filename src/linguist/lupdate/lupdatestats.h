@@ -0,0 +1,59 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef LUPDATESTATS_H
+#define LUPDATESTATS_H
+
+#include <chrometrace_p.h>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QString>
+
+QT_BEGIN_NAMESPACE
+
+// Collects where lupdate spends its time, for -timing and -stats-json.
+// Stages that run on several threads at once add up the time of each
+// thread. All functions may be called from any thread.
+class LupdateStats
+{
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    static void addStageTime(QLatin1StringView stage, qint64 nsecs);
+    static void addFileTime(const QString &fileName, qint64 nsecs);
+
+    static void printReport();
+    static bool writeJson(const QString &fileName, QString *errorString);
+    // Forgets the times collected so far, for the next run of -watch.
+    static void reset();
+
+    // Adds the time until its destruction to a stage, and records it as a
+    // span when tracing.
+    class StageTimer
+    {
+    public:
+        explicit StageTimer(QLatin1StringView stage)
+            : m_stage(stage), m_span(stage)
+        {
+            if (isEnabled())
+                m_timer.start();
+        }
+        ~StageTimer()
+        {
+            if (m_timer.isValid())
+                addStageTime(m_stage, m_timer.nsecsElapsed());
+        }
+
+    private:
+        Q_DISABLE_COPY_MOVE(StageTimer)
+
+        QLatin1StringView m_stage;
+        QElapsedTimer m_timer;
+        ChromeTrace::Span m_span;
+    };
+};
+
+QT_END_NAMESPACE
+
+#endif // LUPDATESTATS_H
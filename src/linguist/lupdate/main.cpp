@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "lupdate.h"
+#include "extractioncache.h"
+#include "lupdatestats.h"
 #if QT_CONFIG(clangcpp)
 #include "cpp_clang.h"
 #endif
@@ -14,16 +16,27 @@
 #include <translator.h>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QHash>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
+#include <QtCore/QThread>
 #include <QtCore/QTranslator>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace Qt::StringLiterals;
 
@@ -137,6 +150,20 @@ QStringList TrFunctionAliasManager::listAliases() const
 
 TrFunctionAliasManager trFunctionAliasManager;
 
+static unsigned threadCountOverride = 0;
+
+unsigned lupdateThreadCount()
+{
+    if (threadCountOverride)
+        return threadCountOverride;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void setLupdateThreadCount(unsigned count)
+{
+    threadCountOverride = count;
+}
+
 QString ParserTool::transcode(const QString &str)
 {
     static const char tab[] = "abfnrtv";
@@ -197,14 +224,42 @@ QString ParserTool::transcode(const QString &str)
 
 static QString m_defaultExtensions;
 
+// Console output of a TS file that is updated on a worker thread. It is
+// printed once the file is done, so that the output keeps the order of
+// the TS files.
+struct ConsoleOutput
+{
+    QList<std::pair<bool, QString>> chunks; // Whether it goes to stderr, text
+
+    void flush() const;
+};
+
+static thread_local ConsoleOutput *consoleOutput = nullptr;
+
 static void printOut(const QString & out)
 {
-    std::cout << qPrintable(out);
+    if (consoleOutput)
+        consoleOutput->chunks.emplace_back(false, out);
+    else
+        std::cout << qPrintable(out);
 }
 
 static void printErr(const QString & out)
 {
-    std::cerr << qPrintable(out);
+    if (consoleOutput)
+        consoleOutput->chunks.emplace_back(true, out);
+    else
+        std::cerr << qPrintable(out);
+}
+
+void ConsoleOutput::flush() const
+{
+    for (const auto &[toStdErr, text] : chunks) {
+        if (toStdErr)
+            printErr(text);
+        else
+            printOut(text);
+    }
 }
 
 static void printWarning(UpdateOptions options,
@@ -321,6 +376,25 @@ static void printUsage()
         "           A directory specified on the command line takes precedence.\n"
         "           If no path is given, the compilation database will be searched\n"
         "           in all parent paths of the first input file.\n"
+        "    -extraction-cache <directory>\n"
+        "           Store the messages extracted from QML, JavaScript, UI, Java and\n"
+        "           Python files in <directory>, and reuse them in later runs for files\n"
+        "           whose contents and extraction options did not change.\n"
+        "           C++ files are always parsed.\n"
+        "    -j <n>\n"
+        "           Use at most <n> threads for parsing. Defaults to the number of\n"
+        "           CPU cores.\n"
+        "    -timing\n"
+        "           Print the time spent in each stage, the slowest source files,\n"
+        "           and the peak memory usage when done.\n"
+        "    -stats-json <filename>\n"
+        "           Write the information printed by -timing to <filename> in JSON\n"
+        "           format.\n"
+        "    -watch\n"
+        "           Keep running after the update, and update the TS files again\n"
+        "           whenever one of the source, resource, project description or TS\n"
+        "           files changes. Combine with -extraction-cache to parse only the\n"
+        "           changed files again.\n"
         "    -project-roots <directory>...\n"
         "           Specify one or more project root directories.\n"
         "           Only files below a project root are considered for translation when using\n"
@@ -363,6 +437,138 @@ static bool handleTrFunctionAliases(const QString &arg)
     return true;
 }
 
+// The result of merging one TS file, kept until the file is saved.
+struct TsFileUpdate
+{
+    ConsoleOutput output;
+    ConversionData cd;
+    Translator translator;
+    bool save = false;
+    bool abort = false; // Stops the update at this file (-Werror)
+    bool fail = false;
+};
+
+// Calls func for each index below count, on up to lupdateThreadCount()
+// threads.
+template <typename Func>
+static void forEachInParallel(size_t count, Func func)
+{
+    std::atomic<size_t> next = 0;
+    std::vector<std::thread> workers;
+    const size_t workerCount = std::min(count, size_t(lupdateThreadCount()));
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back([&]() {
+            for (size_t index; (index = next++) < count;)
+                func(index);
+        });
+    }
+    for (auto &worker : workers)
+        worker.join();
+}
+
+static void mergeTsFile(const Translator &fetchedTor, const QList<Translator> &aliens,
+    const QString &fileName,
+    const QString &sourceLanguage, const QString &targetLanguage,
+    UpdateOptions options, TsFileUpdate *update)
+{
+    QString fn = QDir().relativeFilePath(fileName);
+    ConversionData &cd = update->cd;
+    Translator tor;
+    cd.m_sortContexts = !(options & NoSort);
+    if (QFile(fileName).exists()) {
+        if (!tor.load(fileName, cd, QLatin1String("auto"))) {
+            printErr(cd.error());
+            update->fail = true;
+            return;
+        }
+        tor.resolveDuplicates();
+        cd.clearErrors();
+        if (!targetLanguage.isEmpty() && targetLanguage != tor.languageCode()) {
+            printWarning(options,
+                         "Specified target language '%1' disagrees with"
+                                        " existing file's language '%2'.\n"_L1
+                                 .arg(targetLanguage, tor.languageCode()),
+                         u"Ignoring.\n"_s);
+            if (options & Werror) {
+                update->abort = true;
+                return;
+            }
+        }
+        if (!sourceLanguage.isEmpty() && sourceLanguage != tor.sourceLanguageCode()) {
+            printWarning(options,
+                         "Specified source language '%1' disagrees with"
+                                 " existing file's language '%2'.\n"_L1
+                                 .arg(sourceLanguage, tor.sourceLanguageCode()),
+                         u"Ignoring.\n"_s);
+            if (options & Werror) {
+                update->abort = true;
+                return;
+            }
+        }
+        // If there is translation in the file, the language should be recognized
+        // (when the language is not recognized, plural translations are lost)
+        if (tor.translationsExist()) {
+
+            if (tor.languageCode().isEmpty()) {
+                printErr("File %1 won't be updated: it does not specify any "
+                         "target languages. To set a target language, open "
+                         "the file in Qt Linguist.\n"_L1.arg(fileName));
+                return;
+            }
+            QLocale::Language l;
+            QLocale::Territory c;
+            tor.languageAndTerritory(tor.languageCode(), &l, &c);
+            QStringList forms;
+            if (!getNumerusInfo(l, c, 0, &forms, 0)) {
+                printErr(QStringLiteral("File %1 won't be updated: it contains translation but the"
+                " target language is not recognized\n").arg(fileName));
+                return;
+            }
+        }
+    } else {
+        if (!targetLanguage.isEmpty())
+            tor.setLanguageCode(targetLanguage);
+        else
+            tor.setLanguageCode(Translator::guessLanguageCodeFromFileName(fileName));
+        if (!sourceLanguage.isEmpty())
+            tor.setSourceLanguageCode(sourceLanguage);
+    }
+    tor.makeFileNamesAbsolute(QFileInfo(fileName).absoluteDir());
+    if (options & NoLocations)
+        tor.setLocationsType(Translator::NoLocations);
+    else if (options & RelativeLocations)
+        tor.setLocationsType(Translator::RelativeLocations);
+    else if (options & AbsoluteLocations)
+        tor.setLocationsType(Translator::AbsoluteLocations);
+    if (options & Verbose)
+        printOut(QStringLiteral("Updating '%1'...\n").arg(fn));
+
+    UpdateOptions theseOptions = options;
+    if (tor.locationsType() == Translator::NoLocations) // Could be set from file
+        theseOptions |= NoLocations;
+    QString err;
+    Translator out = merge(tor, fetchedTor, aliens, theseOptions, err);
+
+    if ((options & Verbose) && !err.isEmpty())
+        printOut(err);
+    if (options & PluralOnly) {
+        if (options & Verbose)
+            printOut(QStringLiteral("Stripping non plural forms in '%1'...\n").arg(fn));
+        out.stripNonPluralForms();
+    }
+    if (options & NoObsolete)
+        out.stripObsoleteMessages();
+    out.stripEmptyContexts();
+
+    out.normalizeTranslations(cd);
+    if (!cd.errors().isEmpty()) {
+        printErr(cd.error());
+        cd.clearErrors();
+    }
+    update->translator = std::move(out);
+    update->save = true;
+}
+
 static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFileNames,
     const QStringList &alienFiles,
     const QString &sourceLanguage, const QString &targetLanguage,
@@ -389,104 +595,44 @@ static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFil
         tor.resolveDuplicates();
         aliens << tor;
     }
-    QDir dir;
-    QString err;
-    for (const QString &fileName : tsFileNames) {
-        QString fn = dir.relativeFilePath(fileName);
-        ConversionData cd;
-        Translator tor;
-        cd.m_sortContexts = !(options & NoSort);
-        if (QFile(fileName).exists()) {
-            if (!tor.load(fileName, cd, QLatin1String("auto"))) {
-                printErr(cd.error());
-                *fail = true;
-                continue;
-            }
-            tor.resolveDuplicates();
-            cd.clearErrors();
-            if (!targetLanguage.isEmpty() && targetLanguage != tor.languageCode()) {
-                printWarning(options,
-                             "Specified target language '%1' disagrees with"
-                                            " existing file's language '%2'.\n"_L1
-                                     .arg(targetLanguage, tor.languageCode()),
-                             u"Ignoring.\n"_s);
-                if (options & Werror)
-                    return;
-            }
-            if (!sourceLanguage.isEmpty() && sourceLanguage != tor.sourceLanguageCode()) {
-                printWarning(options,
-                             "Specified source language '%1' disagrees with"
-                                     " existing file's language '%2'.\n"_L1
-                                     .arg(sourceLanguage, tor.sourceLanguageCode()),
-                             u"Ignoring.\n"_s);
-                if (options & Werror)
-                    return;
-            }
-            // If there is translation in the file, the language should be recognized
-            // (when the language is not recognized, plural translations are lost)
-            if (tor.translationsExist()) {
-
-                if (tor.languageCode().isEmpty()) {
-                    printErr("File %1 won't be updated: it does not specify any "
-                             "target languages. To set a target language, open "
-                             "the file in Qt Linguist.\n"_L1.arg(fileName));
-                    continue;
-                }
-                QLocale::Language l;
-                QLocale::Territory c;
-                tor.languageAndTerritory(tor.languageCode(), &l, &c);
-                QStringList forms;
-                if (!getNumerusInfo(l, c, 0, &forms, 0)) {
-                    printErr(QStringLiteral("File %1 won't be updated: it contains translation but the"
-                    " target language is not recognized\n").arg(fileName));
-                    continue;
-                }
-            }
-        } else {
-            if (!targetLanguage.isEmpty())
-                tor.setLanguageCode(targetLanguage);
-            else
-                tor.setLanguageCode(Translator::guessLanguageCodeFromFileName(fileName));
-            if (!sourceLanguage.isEmpty())
-                tor.setSourceLanguageCode(sourceLanguage);
-        }
-        tor.makeFileNamesAbsolute(QFileInfo(fileName).absoluteDir());
-        if (options & NoLocations)
-            tor.setLocationsType(Translator::NoLocations);
-        else if (options & RelativeLocations)
-            tor.setLocationsType(Translator::RelativeLocations);
-        else if (options & AbsoluteLocations)
-            tor.setLocationsType(Translator::AbsoluteLocations);
-        if (options & Verbose)
-            printOut(QStringLiteral("Updating '%1'...\n").arg(fn));
+    // The TS files are merged and saved concurrently. fetchedTor and the
+    // aliens are only read from, so their lookup index is built up front.
+    fetchedTor.ensureIndexed();
+    const size_t count = size_t(tsFileNames.size());
+    std::vector<TsFileUpdate> updates(count);
+    {
+        LupdateStats::StageTimer timer("merge TS files"_L1);
+        forEachInParallel(count, [&](size_t i) {
+            consoleOutput = &updates[i].output;
+            mergeTsFile(fetchedTor, aliens, tsFileNames.at(int(i)), sourceLanguage,
+                        targetLanguage, options, &updates[i]);
+            consoleOutput = nullptr;
+        });
+    }
 
-        UpdateOptions theseOptions = options;
-        if (tor.locationsType() == Translator::NoLocations) // Could be set from file
-            theseOptions |= NoLocations;
-        Translator out = merge(tor, fetchedTor, aliens, theseOptions, err);
+    // Files after the one that stopped the update are left untouched.
+    size_t end = 0;
+    while (end < count && !updates[end++].abort) { }
 
-        if ((options & Verbose) && !err.isEmpty()) {
-            printOut(err);
-            err.clear();
-        }
-        if (options & PluralOnly) {
-            if (options & Verbose)
-                printOut(QStringLiteral("Stripping non plural forms in '%1'...\n").arg(fn));
-            out.stripNonPluralForms();
-        }
-        if (options & NoObsolete)
-            out.stripObsoleteMessages();
-        out.stripEmptyContexts();
+    {
+        LupdateStats::StageTimer timer("write TS files"_L1);
+        forEachInParallel(end, [&](size_t i) {
+            TsFileUpdate &update = updates[i];
+            if (!update.save)
+                return;
+            consoleOutput = &update.output;
+            if (!update.translator.save(tsFileNames.at(int(i)), update.cd, "auto"_L1)) {
+                printErr(update.cd.error());
+                update.fail = true;
+            }
+            consoleOutput = nullptr;
+        });
+    }
 
-        out.normalizeTranslations(cd);
-        if (!cd.errors().isEmpty()) {
-            printErr(cd.error());
-            cd.clearErrors();
-        }
-        if (!out.save(fileName, cd, QLatin1String("auto"))) {
-            printErr(cd.error());
+    for (size_t i = 0; i < end; ++i) {
+        updates[i].output.flush();
+        if (updates[i].fail)
             *fail = true;
-        }
     }
 }
 
@@ -587,38 +733,250 @@ static bool processTs(Translator &fetchedTor, const QString &file, ConversionDat
     return false;
 }
 
+// The languages of self-contained source files, in the order of the
+// table in processSources().
+enum SourceLanguageId {
+    JavaSource,
+    UiSource,
+    JsSource,
+    MjsSource,
+    QmlSource,
+    PythonSource,
+    OtherSource
+};
+
+static SourceLanguageId sourceLanguage(const QString &sourceFile)
+{
+    const auto hasSuffix = [&sourceFile](QLatin1StringView suffix) {
+        return sourceFile.endsWith(suffix, Qt::CaseInsensitive);
+    };
+    if (hasSuffix(".java"_L1))
+        return JavaSource;
+    if (hasSuffix(".ui"_L1) || hasSuffix(".jui"_L1))
+        return UiSource;
+    if (hasSuffix(".js"_L1) || hasSuffix(".qs"_L1))
+        return JsSource;
+    if (hasSuffix(".mjs"_L1))
+        return MjsSource;
+    if (hasSuffix(".qml"_L1))
+        return QmlSource;
+    if (hasSuffix(".py"_L1))
+        return PythonSource;
+    return OtherSource;
+}
+
+static thread_local std::ostream *diagnosticsStream = nullptr;
+
+std::ostream &extractorDiagnostics()
+{
+    return diagnosticsStream ? *diagnosticsStream : std::cerr;
+}
+
+// The result of extracting one self-contained source file.
+struct ExtractedFile
+{
+    Translator translator;
+    QStringList errors;
+    QString sourceFileName;
+    std::string diagnostics;
+    qint64 nsecs = 0;
+};
+
+// Subprojects often list the same sources, so ProjectProcessor keeps the
+// extracted files for all the projects of a project description. They are
+// stored by file name and extractionKey(), and a file is dropped once the
+// last project that lists it has used it.
+struct ExtractedFiles
+{
+    QHash<QString, QHash<QString, ExtractedFile>> files;
+    QHash<QString, int> remainingUses;
+};
+
+// The options of a project that the extractors of self-contained files
+// depend on.
+static QString extractionKey(const ConversionData &cd)
+{
+    QString key;
+    key += QChar(cd.m_sourceIsUtf16 ? u'1' : u'0');
+    key += QChar(cd.m_noUiLines ? u'1' : u'0');
+    key += QChar(cd.m_idBased ? u'1' : u'0');
+    key += cd.m_defaultContext;
+    return key;
+}
+
 static void processSources(Translator &fetchedTor, const QStringList &sourceFiles,
-                           ConversionData &cd, UpdateOptions options, bool *fail)
+                           ConversionData &cd, UpdateOptions options, bool *fail,
+                           ExtractedFiles *extractedFiles = nullptr)
 {
+    struct SourceLanguage
+    {
+        QLatin1StringView name;
+        QLatin1StringView stage; // For LupdateStats
+        ExtractionCache::Extractor extractor;
+        // The Java and Python extractors keep their state in globals, so
+        // their files are extracted one after another.
+        bool serial;
+        int fileCount = 0;
+        qint64 nsecs = 0;
+    };
+    SourceLanguage languages[] = {
+        { "Java"_L1, "extract Java files"_L1, loadJava, true },
+        { "UI"_L1, "extract UI files"_L1, loadUI, false },
+#ifndef QT_NO_QML
+        { "JavaScript"_L1, "extract JavaScript files"_L1, loadQScript, false },
+        { "JavaScript module"_L1, "extract JavaScript module files"_L1, loadJSModule, false },
+        { "QML"_L1, "extract QML files"_L1, loadQml, false },
+#else
+        { "JavaScript"_L1, {}, nullptr, false },
+        { "JavaScript module"_L1, {}, nullptr, false },
+        { "QML"_L1, {}, nullptr, false },
+#endif
+        { "Python"_L1, "extract Python files"_L1, loadPython, true },
+    };
+
+    std::vector<SourceLanguageId> languageIds(sourceFiles.size());
+    for (qsizetype i = 0; i < sourceFiles.size(); ++i)
+        languageIds[i] = sourceLanguage(sourceFiles.at(i));
+
+    // Without the extraction cache, which redirects std::cerr while it
+    // extracts, self-contained files are extracted on worker threads up front.
+    // Their messages are added in the loop below, in the order of the files.
+    // Files that another project already extracted with the same options
+    // are not extracted again.
+    std::vector<ExtractedFile> extractions;
+    std::vector<qsizetype> extractionFiles;
+    std::vector<qsizetype> extractionIndexes(sourceFiles.size(), -1);
+    std::vector<const ExtractedFile *> reused(sourceFiles.size(), nullptr);
+    QStringList keys;
+    if (!ExtractionCache::isEnabled()) {
+        std::vector<std::vector<qsizetype>> tasks(OtherSource);
+        if (extractedFiles)
+            keys.resize(sourceFiles.size());
+        for (qsizetype i = 0; i < sourceFiles.size(); ++i) {
+            const SourceLanguageId id = languageIds[i];
+            if (id == OtherSource || !languages[id].extractor)
+                continue;
+            if (extractedFiles) {
+                keys[i] = extractionKey(cd);
+                const auto file = extractedFiles->files.constFind(sourceFiles.at(i));
+                if (file != extractedFiles->files.constEnd()) {
+                    const auto it = file->constFind(keys.at(i));
+                    if (it != file->constEnd()) {
+                        reused[i] = &it.value();
+                        continue;
+                    }
+                }
+            }
+            extractionIndexes[i] = qsizetype(extractions.size());
+            extractions.emplace_back();
+            extractionFiles.push_back(i);
+            if (languages[id].serial)
+                tasks[id].push_back(extractionIndexes[i]);
+            else
+                tasks.push_back({ extractionIndexes[i] });
+        }
+
+        trFunctionAliasManager.nameToTrFunctionMap(); // Build the lookup before sharing it
+        forEachInParallel(tasks.size(), [&](size_t task) {
+            for (qsizetype index : tasks[task]) {
+                ExtractedFile &extraction = extractions[index];
+                const QString &sourceFile = sourceFiles.at(extractionFiles[index]);
+                ConversionData extractionCd = cd;
+                extractionCd.clearErrors();
+                std::ostringstream diagnostics;
+                diagnosticsStream = &diagnostics;
+                const ChromeTrace::Span span("extract"_L1, sourceFile);
+                QElapsedTimer timer;
+                timer.start();
+                languages[languageIds[extractionFiles[index]]].extractor(
+                        extraction.translator, sourceFile, extractionCd);
+                extraction.nsecs = timer.nsecsElapsed();
+                diagnosticsStream = nullptr;
+                extraction.diagnostics = diagnostics.str();
+                extraction.errors = extractionCd.errors();
+                extraction.sourceFileName = extractionCd.m_sourceFileName;
+            }
+        });
+    }
+
 #ifdef QT_NO_QML
     bool requireQmlSupport = false;
 #endif
     QStringList sourceFilesCpp;
-    for (const auto &sourceFile : sourceFiles) {
-        if (sourceFile.endsWith(QLatin1String(".java"), Qt::CaseInsensitive))
-            loadJava(fetchedTor, sourceFile, cd);
-        else if (sourceFile.endsWith(QLatin1String(".ui"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".jui"), Qt::CaseInsensitive))
-            loadUI(fetchedTor, sourceFile, cd);
-#ifndef QT_NO_QML
-        else if (sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive)) {
-            loadQScript(fetchedTor, sourceFile, cd);
-        } else if (sourceFile.endsWith(QLatin1String(".mjs"), Qt::CaseInsensitive)) {
-            loadJSModule(fetchedTor, sourceFile, cd);
-        } else if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive))
-            loadQml(fetchedTor, sourceFile, cd);
-#else
-        else if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".mjs"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive))
+    for (qsizetype i = 0; i < sourceFiles.size(); ++i) {
+        const QString &sourceFile = sourceFiles.at(i);
+        if (languageIds[i] == OtherSource) {
+            if (!processTs(fetchedTor, sourceFile, cd))
+                sourceFilesCpp << sourceFile;
+            continue;
+        }
+        SourceLanguage &language = languages[languageIds[i]];
+        if (!language.extractor) {
+#ifdef QT_NO_QML
             requireQmlSupport = true;
-#endif // QT_NO_QML
-        else if (sourceFile.endsWith(u".py", Qt::CaseInsensitive))
-            loadPython(fetchedTor, sourceFile, cd);
-        else if (!processTs(fetchedTor, sourceFile, cd))
-            sourceFilesCpp << sourceFile;
+#endif
+            continue;
+        }
+        ++language.fileCount;
+        const ExtractedFile *extraction = reused[i];
+        if (!extraction && extractionIndexes[i] >= 0) {
+            extraction = &extractions[extractionIndexes[i]];
+            language.nsecs += extraction->nsecs;
+            LupdateStats::addFileTime(sourceFile, extraction->nsecs);
+        }
+        if (extraction) {
+            std::cerr << extraction->diagnostics;
+            for (const QString &error : extraction->errors)
+                cd.appendError(error);
+            cd.m_sourceFileName = extraction->sourceFileName;
+            ExtractionCache::addExtracted(fetchedTor, extraction->translator, cd);
+        } else {
+            const ChromeTrace::Span span("extract"_L1, sourceFile);
+            QElapsedTimer timer;
+            timer.start();
+            ExtractionCache::extract(language.extractor, fetchedTor, sourceFile, cd);
+            const qint64 nsecs = timer.nsecsElapsed();
+            language.nsecs += nsecs;
+            LupdateStats::addFileTime(sourceFile, nsecs);
+        }
+    }
+
+    if (extractedFiles && !keys.isEmpty()) {
+        // Count the uses only now, the reused results must stay in place
+        // until all files were added.
+        QSet<QString> usedUp;
+        for (qsizetype i = 0; i < sourceFiles.size(); ++i) {
+            if (keys.at(i).isEmpty())
+                continue;
+            const auto it = extractedFiles->remainingUses.find(sourceFiles.at(i));
+            if (it == extractedFiles->remainingUses.end() || --*it <= 0)
+                usedUp.insert(sourceFiles.at(i));
+        }
+        for (qsizetype index = 0; index < qsizetype(extractions.size()); ++index) {
+            const qsizetype i = extractionFiles[index];
+            if (!usedUp.contains(sourceFiles.at(i)))
+                extractedFiles->files[sourceFiles.at(i)].insert(keys.at(i),
+                                                                std::move(extractions[index]));
+        }
+        for (const QString &sourceFile : std::as_const(usedUp)) {
+            extractedFiles->files.remove(sourceFile);
+            extractedFiles->remainingUses.remove(sourceFile);
+        }
+    }
+
+    for (const SourceLanguage &language : languages) {
+        if (language.fileCount)
+            LupdateStats::addStageTime(language.stage, language.nsecs);
+    }
+
+    if (options & Verbose) {
+        for (const SourceLanguage &language : languages) {
+            if (language.fileCount) {
+                printOut(u"Extracted %1 %2 file(s) in %3 ms.\n"_s.arg(language.fileCount)
+                                 .arg(language.name)
+                                 .arg(language.nsecs / 1000000));
+            }
+        }
     }
 
 #ifdef QT_NO_QML
@@ -628,10 +986,10 @@ static void processSources(Translator &fetchedTor, const QStringList &sourceFile
         if (options & Werror)
             return;
     }
-#else
-    Q_UNUSED(options)
 #endif
 
+    QElapsedTimer cppTimer;
+    cppTimer.start();
     if (useClangToParseCpp) {
 #if QT_CONFIG(clangcpp)
         ClangCppParser::loadCPP(fetchedTor, sourceFilesCpp, cd, fail);
@@ -642,6 +1000,13 @@ static void processSources(Translator &fetchedTor, const QStringList &sourceFile
     }
     else
         loadCPP(fetchedTor, sourceFilesCpp, cd);
+    if (!sourceFilesCpp.isEmpty()) {
+        LupdateStats::addStageTime("extract C++ files"_L1, cppTimer.nsecsElapsed());
+        if (options & Verbose) {
+            printOut(u"Extracted %1 C++ file(s) in %2 ms.\n"_s.arg(sourceFilesCpp.size())
+                             .arg(cppTimer.elapsed()));
+        }
+    }
 
     if (!cd.error().isEmpty())
         printErr(cd.error());
@@ -677,12 +1042,25 @@ public:
     void processProjects(bool topLevel, UpdateOptions options, const Projects &projects,
                          bool nestComplain, Translator *parentTor, bool *fail) const
     {
+        if (topLevel)
+            countSourceUses(projects);
         for (const Project &prj : projects)
             processProject(options, prj, topLevel, nestComplain, parentTor, fail);
     }
 
 private:
 
+    void countSourceUses(const Projects &projects) const
+    {
+        for (const Project &prj : projects) {
+            for (const QString &sourceFile : prj.sources) {
+                if (sourceLanguage(sourceFile) != OtherSource)
+                    ++m_extractedFiles.remainingUses[sourceFile];
+            }
+            countSourceUses(prj.subProjects);
+        }
+    }
+
     void processProject(UpdateOptions options, const Project &prj, bool topLevel,
                         bool nestComplain, Translator *parentTor, bool *fail) const
     {
@@ -750,7 +1128,7 @@ private:
             }
             Translator tor;
             processProjects(false, options, prj.subProjects, false, &tor, fail);
-            processSources(tor, sources, cd, options, fail);
+            processSources(tor, sources, cd, options, fail, &m_extractedFiles);
             updateTsFiles(tor, tsFiles, QStringList(), m_sourceLanguage, m_targetLanguage,
                           options, fail);
             return;
@@ -769,20 +1147,50 @@ private:
             }
             Translator tor;
             processProjects(false, options, prj.subProjects, nestComplain, &tor, fail);
-            processSources(tor, sources, cd, options, fail);
+            processSources(tor, sources, cd, options, fail, &m_extractedFiles);
         } else {
             processProjects(false, options, prj.subProjects, nestComplain, parentTor, fail);
-            processSources(*parentTor, sources, cd, options, fail);
+            processSources(*parentTor, sources, cd, options, fail, &m_extractedFiles);
         }
     }
 
     QString m_sourceLanguage;
     QString m_targetLanguage;
+    // Self-contained files extracted for one project, reused by the others
+    // until their last use
+    mutable ExtractedFiles m_extractedFiles;
 };
 
+// The files -watch looks at, with their modification times and sizes.
+using FileStamps = QHash<QString, std::pair<QDateTime, qint64>>;
+
+static constexpr unsigned long watchInterval = 500; // ms
+
+static FileStamps fileStamps(const QStringList &files)
+{
+    FileStamps stamps;
+    stamps.reserve(files.size());
+    for (const QString &file : files) {
+        const QFileInfo fi(file);
+        stamps.insert(file, { fi.lastModified(), fi.exists() ? fi.size() : qint64(-1) });
+    }
+    return stamps;
+}
+
+static void collectProjectFiles(const Projects &projects, QStringList *files)
+{
+    for (const Project &project : projects) {
+        *files += project.sources;
+        if (project.translations)
+            *files += *project.translations;
+        collectProjectFiles(project.subProjects, files);
+    }
+}
+
 int main(int argc, char **argv)
 {
     QCoreApplication app(argc, argv);
+    ChromeTrace::initialize("lupdate"_L1);
 #ifndef QT_BOOTSTRAPPED
 #ifndef Q_OS_WIN32
     QTranslator translator;
@@ -823,6 +1231,9 @@ int main(int argc, char **argv)
     bool recursiveScan = true;
 
     bool fail = false;
+    bool printTiming = false;
+    QString statsJsonFile;
+    bool watch = false;
 
     QString extensions = m_defaultExtensions;
     QSet<QString> extensionsNameFilters;
@@ -917,6 +1328,22 @@ int main(int argc, char **argv)
         } else if (arg == QLatin1String("-verbose")) {
             options |= Verbose;
             continue;
+        } else if (arg == QLatin1String("-timing")) {
+            printTiming = true;
+            LupdateStats::setEnabled(true);
+            continue;
+        } else if (arg == QLatin1String("-stats-json")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -stats-json option should be followed by a file name.\n"_s);
+                return 1;
+            }
+            statsJsonFile = args[i];
+            LupdateStats::setEnabled(true);
+            continue;
+        } else if (arg == QLatin1String("-watch")) {
+            watch = true;
+            continue;
         } else if (arg == QLatin1String("-warnings-are-errors")) {
             options |= Werror;
             continue;
@@ -968,6 +1395,24 @@ int main(int argc, char **argv)
             proFiles += file;
             numFiles++;
             continue;
+        } else if (arg == QLatin1String("-extraction-cache")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -extraction-cache option should be followed by a directory name.\n"_s);
+                return 1;
+            }
+            ExtractionCache::setDirectory(QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath()));
+            continue;
+        } else if (arg == QLatin1String("-j")) {
+            ++i;
+            bool ok = false;
+            const uint count = i < argc ? args[i].toUInt(&ok) : 0;
+            if (!ok || count == 0) {
+                printErr(u"The -j option should be followed by a positive number.\n"_s);
+                return 1;
+            }
+            setLupdateThreadCount(count);
+            continue;
         } else if (arg == QLatin1String("-pro-out")) {
             ++i;
             if (i == argc) {
@@ -1157,22 +1602,27 @@ int main(int argc, char **argv)
     }
 
     Projects projectDescription;
-    if (!projectDescriptionFile.isEmpty()) {
-        projectDescription = readProjectDescription(projectDescriptionFile, &errorString);
+    const auto readProjectDescriptionFile = [&] {
+        LupdateStats::StageTimer timer("read project description"_L1);
+        Projects projects = readProjectDescription(projectDescriptionFile, &errorString);
         if (!errorString.isEmpty()) {
             printErr(QStringLiteral("lupdate error: %1\n").arg(errorString));
-            return 1;
+            return false;
         }
-        if (projectDescription.empty()) {
+        if (projects.empty()) {
             printErr(QStringLiteral("lupdate error:"
                             " Could not find project descriptions in %1.\n")
                      .arg(projectDescriptionFile));
-            return 1;
+            return false;
         }
-        removeExcludedSources(projectDescription);
-        for (Project &project : projectDescription)
+        removeExcludedSources(projects);
+        for (Project &project : projects)
             expandQrcFiles(project);
-    }
+        projectDescription = std::move(projects);
+        return true;
+    };
+    if (!projectDescriptionFile.isEmpty() && !readProjectDescriptionFile())
+        return 1;
 
     if (projectDescription.empty()) {
         if (tsFileNames.isEmpty()) {
@@ -1182,41 +1632,111 @@ int main(int argc, char **argv)
             if (options & Werror)
                 return 1;
         }
+    } else if (!sourceFiles.isEmpty() || !resourceFiles.isEmpty() || !includePath.isEmpty()) {
+        printErr(QStringLiteral("lupdate error:"
+                        " Both project and source files / include paths specified.\n"));
+        return 1;
+    }
 
-        Translator fetchedTor;
-        ConversionData cd;
-        cd.m_noUiLines = options & NoUiLines;
-        cd.m_sourceIsUtf16 = options & SourceIsUtf16;
-        cd.m_projectRoots = projectRoots;
-        cd.m_includePath = includePath;
-        cd.m_allCSources = allCSources;
-        cd.m_compilationDatabaseDir = commandLineCompilationDatabaseDir;
-        cd.m_rootDirs = rootDirs;
-        for (const QString &resource : std::as_const(resourceFiles))
-            sourceFiles << getResources(resource);
-        processSources(fetchedTor, sourceFiles, cd, options, &fail);
-        updateTsFiles(fetchedTor, tsFileNames, alienFiles,
-                      sourceLanguage, targetLanguage, options, &fail);
-    } else {
-        if (!sourceFiles.isEmpty() || !resourceFiles.isEmpty() || !includePath.isEmpty()) {
-            printErr(QStringLiteral("lupdate error:"
-                            " Both project and source files / include paths specified.\n"));
-            return 1;
-        }
-        QString errorString;
-        ProjectProcessor projectProcessor(sourceLanguage, targetLanguage);
-        if (!tsFileNames.isEmpty()) {
+    const auto update = [&](bool *fail) {
+        if (projectDescription.empty()) {
             Translator fetchedTor;
-            projectProcessor.processProjects(true, options, projectDescription, true, &fetchedTor,
-                                             &fail);
-            if (!fail) {
-                updateTsFiles(fetchedTor, tsFileNames, alienFiles,
-                              sourceLanguage, targetLanguage, options, &fail);
+            ConversionData cd;
+            cd.m_noUiLines = options & NoUiLines;
+            cd.m_sourceIsUtf16 = options & SourceIsUtf16;
+            cd.m_projectRoots = projectRoots;
+            cd.m_includePath = includePath;
+            cd.m_allCSources = allCSources;
+            cd.m_compilationDatabaseDir = commandLineCompilationDatabaseDir;
+            cd.m_rootDirs = rootDirs;
+            QStringList sources = sourceFiles;
+            for (const QString &resource : std::as_const(resourceFiles))
+                sources << getResources(resource);
+            processSources(fetchedTor, sources, cd, options, fail);
+            updateTsFiles(fetchedTor, tsFileNames, alienFiles,
+                          sourceLanguage, targetLanguage, options, fail);
+        } else {
+            ProjectProcessor projectProcessor(sourceLanguage, targetLanguage);
+            if (!tsFileNames.isEmpty()) {
+                Translator fetchedTor;
+                projectProcessor.processProjects(true, options, projectDescription, true,
+                                                 &fetchedTor, fail);
+                if (!*fail) {
+                    updateTsFiles(fetchedTor, tsFileNames, alienFiles,
+                                  sourceLanguage, targetLanguage, options, fail);
+                }
+            } else {
+                projectProcessor.processProjects(true, options, projectDescription, false,
+                                                 nullptr, fail);
             }
+        }
+
+        if (printTiming)
+            LupdateStats::printReport();
+        if (!statsJsonFile.isEmpty() && !LupdateStats::writeJson(statsJsonFile, &errorString)) {
+            printErr(u"lupdate error: Cannot write %1: %2\n"_s.arg(statsJsonFile, errorString));
+            *fail = true;
+        }
+    };
+
+    update(&fail);
+    if (!watch)
+        return fail ? 1 : 0;
+
+    // Everything that was parsed above stays in memory: the project
+    // description, the extraction cache, and the state of the parsers.
+    // Only the files whose changes affect the result are looked at again.
+    const auto watchedFiles = [&] {
+        QStringList files = tsFileNames + alienFiles;
+        if (projectDescription.empty()) {
+            files += sourceFiles;
+            files += resourceFiles;
+            for (const QString &resource : std::as_const(resourceFiles))
+                files += getResources(resource);
         } else {
-            projectProcessor.processProjects(true, options, projectDescription, false, nullptr,
-                                             &fail);
+            files += projectDescriptionFile;
+            collectProjectFiles(projectDescription, &files);
+        }
+        files.removeDuplicates();
+        return files;
+    };
+
+    FileStamps stamps = fileStamps(watchedFiles());
+    printOut(u"Watching %1 files for changes. Press Ctrl+C to stop.\n"_s
+             .arg(stamps.size()));
+    for (;;) {
+        QThread::msleep(watchInterval);
+        FileStamps current = fileStamps(watchedFiles());
+        if (current == stamps)
+            continue;
+        // Wait for editors and build tools to finish writing.
+        for (;;) {
+            QThread::msleep(watchInterval);
+            FileStamps settled = fileStamps(watchedFiles());
+            if (settled == current)
+                break;
+            current = std::move(settled);
+        }
+
+        if (!projectDescriptionFile.isEmpty()
+            && current.value(projectDescriptionFile) != stamps.value(projectDescriptionFile)
+            && !readProjectDescriptionFile()) {
+            stamps = std::move(current);
+            continue;
+        }
+
+        if (options & Verbose) {
+            QStringList changed;
+            for (auto it = current.cbegin(); it != current.cend(); ++it) {
+                if (stamps.value(it.key()) != it.value())
+                    changed << it.key();
+            }
+            printOut(u"Updating after changes to %1\n"_s.arg(changed.join(u", "_s)));
         }
+        LupdateStats::reset();
+        bool runFailed = false;
+        update(&runFailed);
+        // Do not react to the TS files just written.
+        stamps = fileStamps(watchedFiles());
     }
-    return fail ? 1 : 0;
 }
@@ -2,18 +2,25 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "lupdate.h"
+#include "lupdatestats.h"
 
 #include "simtexth.h"
 #include "translator.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QMap>
 #include <QtCore/QStringList>
 
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 /*
   Augments a Translator with trivially derived translations.
 
@@ -67,7 +74,66 @@ int applySameTextHeuristic(Translator &tor)
     return inserted;
 }
 
+/*
+  Lookup of messages by context, comment and source location, as done by
+  Translator::find(context, comment, refs). That function scans all messages,
+  which makes the similar-text heuristic quadratic in the number of messages.
+  The index is built once per merge and returns the same message, namely the
+  first one in the translator that shares at least one reference.
+*/
+
+class ReferenceIndex
+{
+public:
+    explicit ReferenceIndex(const Translator &tor)
+    {
+        const QList<TranslatorMessage> &messages = tor.messages();
+        m_index.reserve(messages.size());
+        // Walk backwards so that the first message with a reference wins.
+        for (int i = int(messages.size()) - 1; i >= 0; --i) {
+            const TranslatorMessage &msg = messages.at(i);
+            for (const TranslatorMessage::Reference &ref : msg.allReferences())
+                m_index.insert(Key{ msg.context(), msg.comment(), ref.fileName(),
+                                    ref.lineNumber() },
+                               i);
+        }
+    }
 
+    int find(const QString &context, const QString &comment,
+             const TranslatorMessage::References &refs) const
+    {
+        int found = -1;
+        for (const TranslatorMessage::Reference &ref : refs) {
+            const auto it = m_index.constFind(
+                    Key{ context, comment, ref.fileName(), ref.lineNumber() });
+            if (it != m_index.constEnd() && (found < 0 || *it < found))
+                found = *it;
+        }
+        return found;
+    }
+
+private:
+    struct Key
+    {
+        QString context;
+        QString comment;
+        QString fileName;
+        int lineNumber;
+
+        friend bool operator==(const Key &a, const Key &b)
+        {
+            return a.lineNumber == b.lineNumber && a.fileName == b.fileName
+                    && a.context == b.context && a.comment == b.comment;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.context, key.comment, key.fileName, key.lineNumber);
+        }
+    };
+
+    // Maps each reference to the first message that has it.
+    QHash<Key, int> m_index;
+};
 
 /*
   Merges two Translator objects. The first one
@@ -91,6 +157,13 @@ Translator merge(
     outTor.setSourceLanguageCode(tor.sourceLanguageCode());
     outTor.setLocationsType(tor.locationsType());
 
+    // Only needed by the similar-text heuristic, so built on first use.
+    std::optional<ReferenceIndex> virginRefs;
+    std::optional<ReferenceIndex> torRefs;
+
+    const bool timing = LupdateStats::isEnabled();
+    qint64 similarTextNsecs = 0;
+
     /*
       The types of all the messages from the vernacular translator
       are updated according to the virgin translator.
@@ -120,20 +193,25 @@ Translator merge(
                 }
                 m.clearReferences();
             } else {
-                mvi = virginTor.find(m.context(), m.comment(), m.allReferences());
-                if (mvi < 0) {
-                    // did not find it in the virgin, mark it as obsolete
+                QElapsedTimer timer;
+                if (timing)
+                    timer.start();
+                if (!virginRefs)
+                    virginRefs.emplace(virginTor);
+                mvi = virginRefs->find(m.context(), m.comment(), m.allReferences());
+                // If it is not found in the virgin, it is obsolete. Do not just
+                // accept it if it is on the same line number, but different source
+                // text: the texts have to be more or less similar to represent the
+                // same message.
+                const bool similar = mvi >= 0
+                        && getSimilarityScore(m.sourceText(),
+                                              virginTor.constMessage(mvi).sourceText())
+                                >= textSimilarityThreshold;
+                if (timing)
+                    similarTextNsecs += timer.nsecsElapsed();
+                if (!similar)
                     goto makeObsolete;
-                }
                 mv = &virginTor.constMessage(mvi);
-                // Do not just accept it if its on the same line number,
-                // but different source text.
-                // Also check if the texts are more or less similar before
-                // we consider them to represent the same message...
-                if (getSimilarityScore(m.sourceText(), mv->sourceText()) < textSimilarityThreshold) {
-                    // The virgin and vernacular sourceTexts are so different that we could not find it
-                    goto makeObsolete;
-                }
                 // It is just slightly modified, assume that it is the same string
 
                 extras = mv->extras();
@@ -216,16 +294,21 @@ Translator merge(
         if (tor.find(mv) >= 0)
             continue;
         if (options & HeuristicSimilarText) {
-            int mi = tor.find(mv.context(), mv.comment(), mv.allReferences());
-            if (mi >= 0) {
-                // The similar message found in tor (ts file) must NOT correspond exactly
-                // to an other message is virginTor
-                if (virginTor.find(tor.constMessage(mi)) < 0) {
-                    if (getSimilarityScore(tor.constMessage(mi).sourceText(), mv.sourceText())
-                            >= textSimilarityThreshold)
-                        continue;
-                }
-            }
+            QElapsedTimer timer;
+            if (timing)
+                timer.start();
+            if (!torRefs)
+                torRefs.emplace(tor);
+            int mi = torRefs->find(mv.context(), mv.comment(), mv.allReferences());
+            // The similar message found in tor (ts file) must NOT correspond exactly
+            // to an other message is virginTor
+            const bool similar = mi >= 0 && virginTor.find(tor.constMessage(mi)) < 0
+                    && getSimilarityScore(tor.constMessage(mi).sourceText(), mv.sourceText())
+                            >= textSimilarityThreshold;
+            if (timing)
+                similarTextNsecs += timer.nsecsElapsed();
+            if (similar)
+                continue;
         }
 
         if (options & NoLocations)
@@ -276,7 +359,13 @@ Translator merge(
       The same-text heuristic handles cases where a message has an
       obsolete counterpart with a different context or comment.
     */
-    int sameTextHeuristicCount = (options & HeuristicSameText) ? applySameTextHeuristic(outTor) : 0;
+    int sameTextHeuristicCount = 0;
+    if (options & HeuristicSameText) {
+        LupdateStats::StageTimer timer("same-text heuristic"_L1);
+        sameTextHeuristicCount = applySameTextHeuristic(outTor);
+    }
+    if (options & HeuristicSimilarText)
+        LupdateStats::addStageTime("similar-text heuristic"_L1, similarTextNsecs);
 
     if (options & Verbose) {
         int totalFound = neww + known;
@@ -15,6 +15,7 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <ostream>
 
 QT_BEGIN_NAMESPACE
 
@@ -276,10 +277,8 @@ static Token parseString(StringType stringType = StringType::NoString)
     yyString[yyStringLen] = '\0';
 
     if (yyCh != quoteChar) {
-        printf("%c\n", yyCh);
-
-        qWarning("%s:%d: Unterminated string",
-                 qPrintable(yyFileName), yyLineNo);
+        extractorDiagnostics() << qPrintable(yyFileName) << ':' << yyLineNo
+                               << ": Unterminated string\n";
     }
 
     if (yyCh == EOF)
@@ -748,8 +747,8 @@ static void parse(Translator &tor, ConversionData &cd,
     }
 
     if (yyParenDepth != 0) {
-        qWarning("%s: Unbalanced parentheses in Python code",
-                 qPrintable(yyFileName));
+        extractorDiagnostics() << qPrintable(yyFileName)
+                               << ": Unbalanced parentheses in Python code\n";
     }
 }
 
@@ -35,9 +35,10 @@ using namespace Qt::StringLiterals;
 class FindTrCalls: protected AST::Visitor
 {
 public:
-    FindTrCalls(Engine *engine, ConversionData &cd)
+    FindTrCalls(Engine *engine, ConversionData &cd, std::ostream &diagnostics)
         : engine(engine)
         , m_cd(cd)
+        , m_diagnostics(diagnostics)
     {
     }
 
@@ -210,13 +211,13 @@ protected:
 private:
     std::ostream &yyMsg(int line)
     {
-        return std::cerr << qPrintable(m_fileName) << ':' << line << ": ";
+        return m_diagnostics << qPrintable(m_fileName) << ':' << line << ": ";
     }
 
     void throwRecursionDepthError() final
     {
-        std::cerr << qPrintable(m_fileName) << ": "
-                  << "Maximum statement or expression depth exceeded";
+        m_diagnostics << qPrintable(m_fileName) << ": "
+                      << "Maximum statement or expression depth exceeded";
     }
 
 
@@ -245,6 +246,7 @@ private:
     Engine *engine;
     Translator *m_translator;
     ConversionData &m_cd;
+    std::ostream &m_diagnostics;
     QString m_fileName;
     QString m_component;
 
@@ -461,7 +463,7 @@ static bool load(Translator &translator, const QString &filename, ConversionData
         rc = parser.parseModule();
 
     if (rc) {
-        FindTrCalls trCalls(&driver, cd);
+        FindTrCalls trCalls(&driver, cd, extractorDiagnostics());
 
         //find all tr calls in the code
         trCalls(&translator, filename, parser.rootNode());
@@ -0,0 +1,173 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "sharedfilecache.h"
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_MSVC(4100)
+QT_WARNING_DISABLE_MSVC(4146)
+QT_WARNING_DISABLE_MSVC(4267)
+QT_WARNING_DISABLE_MSVC(4624)
+QT_WARNING_DISABLE_GCC("-Wnonnull")
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Path.h>
+
+QT_WARNING_POP
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// A file whose contents are owned by the cache.
+class CachedFile : public llvm::vfs::File
+{
+public:
+    CachedFile(llvm::vfs::Status status, const llvm::MemoryBuffer *buffer)
+        : m_status(std::move(status)), m_buffer(buffer)
+    {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status() override { return m_status; }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+    getBuffer(const llvm::Twine &name, int64_t fileSize, bool requiresNullTerminator,
+              bool isVolatile) override
+    {
+        (void)fileSize;
+        (void)isVolatile;
+        // The cached buffers are null-terminated, so they can always be shared.
+        return llvm::MemoryBuffer::getMemBuffer(m_buffer->getBuffer(), name.str(),
+                                                requiresNullTerminator);
+    }
+
+    std::error_code close() override { return {}; }
+
+private:
+    llvm::vfs::Status m_status;
+    const llvm::MemoryBuffer *m_buffer;
+};
+
+// The file system of one thread. The working directory is per thread, as
+// each compile command sets its own.
+class CachingFileSystem : public llvm::vfs::FileSystem
+{
+public:
+    explicit CachingFileSystem(SharedFileCache &cache)
+        : m_cache(cache), m_fs(llvm::vfs::createPhysicalFileSystem())
+    {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine &path) override
+    {
+        const auto status = m_cache.status(absolutePath(path), *m_fs);
+        if (!status)
+            return status.getError();
+        return llvm::vfs::Status::copyWithNewName(*status, path.str());
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+    openFileForRead(const llvm::Twine &path) override
+    {
+        const std::string absolute = absolutePath(path);
+        const auto buffer = m_cache.buffer(absolute, *m_fs);
+        if (!buffer)
+            return buffer.getError();
+        const auto status = m_cache.status(absolute, *m_fs);
+        if (!status)
+            return status.getError();
+        return std::unique_ptr<llvm::vfs::File>(std::make_unique<CachedFile>(
+                llvm::vfs::Status::copyWithNewName(*status, path.str()), *buffer));
+    }
+
+    llvm::vfs::directory_iterator dir_begin(const llvm::Twine &dir, std::error_code &ec) override
+    {
+        return m_fs->dir_begin(dir, ec);
+    }
+
+    llvm::ErrorOr<std::string> getCurrentWorkingDirectory() const override
+    {
+        return m_fs->getCurrentWorkingDirectory();
+    }
+
+    std::error_code setCurrentWorkingDirectory(const llvm::Twine &path) override
+    {
+        return m_fs->setCurrentWorkingDirectory(path);
+    }
+
+    std::error_code getRealPath(const llvm::Twine &path,
+                                llvm::SmallVectorImpl<char> &output) const override
+    {
+        return m_fs->getRealPath(path, output);
+    }
+
+    std::error_code isLocal(const llvm::Twine &path, bool &result) override
+    {
+        return m_fs->isLocal(path, result);
+    }
+
+private:
+    std::string absolutePath(const llvm::Twine &path) const
+    {
+        llvm::SmallString<256> absolute;
+        path.toVector(absolute);
+        m_fs->makeAbsolute(absolute);
+        // Only drop the "." components: ".." may follow a symbolic link.
+        llvm::sys::path::remove_dots(absolute, false);
+        return std::string(absolute.str());
+    }
+
+    SharedFileCache &m_cache;
+    std::unique_ptr<llvm::vfs::FileSystem> m_fs;
+};
+
+} // unnamed namespace
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> SharedFileCache::createFileSystem()
+{
+    return llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem>(new CachingFileSystem(*this));
+}
+
+/*
+    Returns the status of the file at \a absolutePath, asking \a fs
+    the first time. Missing files are cached as well, as most of the
+    lookups are for headers in include paths that do not have them.
+*/
+llvm::ErrorOr<llvm::vfs::Status> SharedFileCache::status(const std::string &absolutePath,
+                                                         llvm::vfs::FileSystem &fs)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_statuses.find(absolutePath);
+        if (it != m_statuses.end())
+            return it->second;
+    }
+    auto status = fs.status(absolutePath);
+    std::lock_guard lock(m_mutex);
+    return m_statuses.try_emplace(absolutePath, std::move(status)).first->second;
+}
+
+/*
+    Returns the contents of the file at \a absolutePath, reading it with
+    \a fs the first time. Files that cannot be read are not cached.
+*/
+llvm::ErrorOr<const llvm::MemoryBuffer *>
+SharedFileCache::buffer(const std::string &absolutePath, llvm::vfs::FileSystem &fs)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_buffers.find(absolutePath);
+        if (it != m_buffers.end())
+            return it->second.get();
+    }
+    auto file = fs.openFileForRead(absolutePath);
+    if (!file)
+        return file.getError();
+    auto buffer = (*file)->getBuffer(absolutePath, -1, true, false);
+    if (!buffer)
+        return buffer.getError();
+    std::lock_guard lock(m_mutex);
+    return m_buffers.try_emplace(absolutePath, std::move(*buffer)).first->second.get();
+}
+
+QT_END_NAMESPACE
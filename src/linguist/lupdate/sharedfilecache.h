@@ -0,0 +1,56 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef SHAREDFILECACHE_H
+#define SHAREDFILECACHE_H
+
+#include <QtCore/qglobal.h>
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_MSVC(4100)
+QT_WARNING_DISABLE_MSVC(4146)
+QT_WARNING_DISABLE_MSVC(4267)
+QT_WARNING_DISABLE_MSVC(4624)
+QT_WARNING_DISABLE_GCC("-Wnonnull")
+
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+QT_WARNING_POP
+
+#include <memory>
+#include <mutex>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Caches the status and the contents of the files that clang reads, for
+    all the producer threads and both passes of lupdate. The Qt and project
+    headers are then read from disk once per run, instead of once per
+    translation unit and pass.
+
+    The files are assumed not to change while lupdate runs.
+*/
+class SharedFileCache
+{
+public:
+    // Returns a file system for one thread, with its own working directory,
+    // that reads through the cache.
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> createFileSystem();
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const std::string &absolutePath,
+                                            llvm::vfs::FileSystem &fs);
+    llvm::ErrorOr<const llvm::MemoryBuffer *> buffer(const std::string &absolutePath,
+                                                     llvm::vfs::FileSystem &fs);
+
+private:
+    std::mutex m_mutex;
+    llvm::StringMap<llvm::ErrorOr<llvm::vfs::Status>> m_statuses;
+    llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> m_buffers;
+};
+
+QT_END_NAMESPACE
+
+#endif // SHAREDFILECACHE_H
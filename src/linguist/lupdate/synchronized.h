@@ -4,9 +4,12 @@
 #ifndef SYNCHRONIZED_H
 #define SYNCHRONIZED_H
 
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qmutex.h>
 
 #include <atomic>
+#include <chrono>
+#include <mutex>
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -22,19 +25,21 @@ public:
 
     void emplace_back(T &&value)
     {
-        QMutexLocker lock(&m_mutex);
+        const std::lock_guard<QMutex> lock(acquire(), std::adopt_lock);
         m_vector.push_back(std::move(value));
     }
 
     void emplace_back(const T &value)
     {
-        QMutexLocker lock(&m_mutex);
+        const std::lock_guard<QMutex> lock(acquire(), std::adopt_lock);
         m_vector.emplace_back(value);
     }
 
     void emplace_bulk(std::vector<T> && values)
     {
-        QMutexLocker lock(&m_mutex);
+        if (values.empty())
+            return;
+        const std::lock_guard<QMutex> lock(acquire(), std::adopt_lock);
         if (!m_vector.empty()) {
             m_vector.insert(m_vector.cend(), std::make_move_iterator(values.begin()),
                 std::make_move_iterator(values.end()));
@@ -43,9 +48,27 @@ public:
         }
     }
 
+    // Total time writers spent blocked on the mutex held by other writers.
+    std::chrono::nanoseconds waitTime() const
+    {
+        return std::chrono::nanoseconds(m_waitTime.load(std::memory_order_relaxed));
+    }
+
 private:
+    QMutex &acquire()
+    {
+        if (!m_mutex.tryLock()) {
+            QElapsedTimer timer;
+            timer.start();
+            m_mutex.lock();
+            m_waitTime.fetch_add(timer.nsecsElapsed(), std::memory_order_relaxed);
+        }
+        return m_mutex;
+    }
+
     mutable QMutex m_mutex;
     std::vector<T> &m_vector;
+    std::atomic<qint64> m_waitTime = 0;
 };
 
 template<typename T> class ReadSynchronizedRef
@@ -4,12 +4,14 @@
 #include "translator.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QFileDevice>
 #include <QtCore/QIODevice>
 #include <QtCore/QHash>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QScopeGuard>
 #include <QtCore/QString>
 #include <QtCore/QStringConverter>
-#include <QtCore/QTextStream>
+#include <QtCore/QVarLengthArray>
 
 #include <ctype.h>
 
@@ -21,123 +23,151 @@ QT_BEGIN_NAMESPACE
 
 static const int MAX_LEN = 79;
 
-static QString poEscapedString(const QString &prefix, const QString &keyword,
-                               bool noWrap, const QString &ba)
+// Escapes \a ba and appends it to \a out as the string of \a keyword,
+// wrapped at MAX_LEN unless \a noWrap is set.
+static void appendPoEscapedString(QString &out, QStringView prefix, QStringView keyword,
+                                  bool noWrap, QStringView ba)
 {
-    QStringList lines;
-    int off = 0;
-    QString res;
+    QString escaped;
+    escaped.reserve(ba.size() + ba.size() / 8);
+    // The ends of the lines of the escaped string, which end after each "\n".
+    QVarLengthArray<qsizetype, 16> lineEnds;
+    qsizetype off = 0;
     while (off < ba.size()) {
+        // Copy the run of characters that need no escaping at once.
+        qsizetype end = off;
+        while (end < ba.size()) {
+            const char16_t c = ba[end].unicode();
+            if (c < 32 || c == '"' || c == '\\')
+                break;
+            ++end;
+        }
+        escaped += ba.sliced(off, end - off);
+        off = end;
+        if (off == ba.size())
+            break;
+
         ushort c = ba[off++].unicode();
         switch (c) {
         case '\n':
-            res += QLatin1String("\\n");
-            lines.append(res);
-            res.clear();
+            escaped += QLatin1String("\\n");
+            lineEnds.append(escaped.size());
             break;
         case '\r':
-            res += QLatin1String("\\r");
+            escaped += QLatin1String("\\r");
             break;
         case '\t':
-            res += QLatin1String("\\t");
+            escaped += QLatin1String("\\t");
             break;
         case '\v':
-            res += QLatin1String("\\v");
+            escaped += QLatin1String("\\v");
             break;
         case '\a':
-            res += QLatin1String("\\a");
+            escaped += QLatin1String("\\a");
             break;
         case '\b':
-            res += QLatin1String("\\b");
+            escaped += QLatin1String("\\b");
             break;
         case '\f':
-            res += QLatin1String("\\f");
+            escaped += QLatin1String("\\f");
             break;
         case '"':
-            res += QLatin1String("\\\"");
+            escaped += QLatin1String("\\\"");
             break;
         case '\\':
-            res += QLatin1String("\\\\");
+            escaped += QLatin1String("\\\\");
             break;
         default:
-            if (c < 32) {
-                res += QLatin1String("\\x");
-                res += QString::number(c, 16);
-                if (off < ba.size() && isxdigit(ba[off].unicode()))
-                    res += QLatin1String("\"\"");
-            } else {
-                res += QChar(c);
-            }
+            escaped += QLatin1String("\\x");
+            escaped += QString::number(c, 16);
+            if (off < ba.size() && isxdigit(ba[off].unicode()))
+                escaped += QLatin1String("\"\"");
             break;
         }
     }
-    if (!res.isEmpty())
-        lines.append(res);
-    if (!lines.isEmpty()) {
-        if (!noWrap) {
-            if (lines.size() != 1 ||
-                lines.first().size() > MAX_LEN - keyword.size() - prefix.size() - 3)
-            {
-                const QStringList olines = lines;
-                lines = QStringList(QString());
-                const int maxlen = MAX_LEN - prefix.size() - 2;
-                for (const QString &line : olines) {
-                    int off = 0;
-                    while (off + maxlen < line.size()) {
-                        int idx = line.lastIndexOf(QLatin1Char(' '), off + maxlen - 1) + 1;
-                        if (idx == off) {
+    if (escaped.size() > (lineEnds.isEmpty() ? 0 : lineEnds.last()))
+        lineEnds.append(escaped.size());
+
+    out += prefix;
+    out += keyword;
+    out += QLatin1String(" \"");
+    bool first = true;
+    const auto appendLine = [&](QStringView line) {
+        if (!first) {
+            out += QLatin1String("\"\n");
+            out += prefix;
+            out += QLatin1Char('"');
+        }
+        first = false;
+        out += line;
+    };
+
+    const qsizetype lineCount = lineEnds.size();
+    const bool wrap = !noWrap && lineCount > 0
+            && (lineCount != 1 || lineEnds.first() > MAX_LEN - keyword.size() - prefix.size() - 3);
+    if (wrap || (noWrap && lineCount > 1))
+        appendLine({});
+    const qsizetype maxlen = MAX_LEN - prefix.size() - 2;
+    qsizetype lineStart = 0;
+    for (qsizetype lineEnd : lineEnds) {
+        const QStringView line = QStringView(escaped).sliced(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd;
+        if (!wrap) {
+            appendLine(line);
+            continue;
+        }
+        qsizetype off = 0;
+        while (off + maxlen < line.size()) {
+            qsizetype idx = line.lastIndexOf(QLatin1Char(' '), off + maxlen - 1) + 1;
+            if (idx == off) {
 #ifdef HARD_WRAP_LONG_WORDS
-                            // This doesn't seem too nice, but who knows ...
-                            idx = off + maxlen;
+                // This doesn't seem too nice, but who knows ...
+                idx = off + maxlen;
 #else
-                            idx = line.indexOf(QLatin1Char(' '), off + maxlen) + 1;
-                            if (!idx)
-                                break;
+                idx = line.indexOf(QLatin1Char(' '), off + maxlen) + 1;
+                if (!idx)
+                    break;
 #endif
-                        }
-                        lines.append(line.mid(off, idx - off));
-                        off = idx;
-                    }
-                    lines.append(line.mid(off));
-                }
             }
-        } else if (lines.size() > 1) {
-            lines.prepend(QString());
+            appendLine(line.sliced(off, idx - off));
+            off = idx;
         }
+        appendLine(line.sliced(off));
     }
-    return prefix + keyword + QLatin1String(" \"") +
-           lines.join(QLatin1String("\"\n") + prefix + QLatin1Char('"')) +
-           QLatin1String("\"\n");
+    out += QLatin1String("\"\n");
 }
 
-static QString poEscapedLines(const QString &prefix, bool addSpace, const QStringList &lines)
+static void appendPoEscapedLine(QString &out, QStringView prefix, bool addSpace, QStringView line)
 {
-    QString out;
-    for (const QString &line : lines) {
-        out += prefix;
-        if (addSpace && !line.isEmpty())
-            out += QLatin1Char(' ' );
-        out += line;
-        out += QLatin1Char('\n');
-    }
-    return out;
+    out += prefix;
+    if (addSpace && !line.isEmpty())
+        out += QLatin1Char(' ' );
+    out += line;
+    out += QLatin1Char('\n');
 }
 
-static QString poEscapedLines(const QString &prefix, bool addSpace, const QString &in0)
+static void appendPoEscapedLines(QString &out, QStringView prefix, bool addSpace, QStringView in)
 {
-    QString in = in0;
-    if (in == QString::fromLatin1("\n"))
+    if (in == QLatin1String("\n"))
         in.chop(1);
-    return poEscapedLines(prefix, addSpace, in.split(QLatin1Char('\n')));
+    for (qsizetype off = 0; ; ) {
+        const qsizetype idx = in.indexOf(QLatin1Char('\n'), off);
+        if (idx < 0) {
+            appendPoEscapedLine(out, prefix, addSpace, in.sliced(off));
+            break;
+        }
+        appendPoEscapedLine(out, prefix, addSpace, in.sliced(off, idx - off));
+        off = idx + 1;
+    }
 }
 
-static QString poWrappedEscapedLines(const QString &prefix, bool addSpace, const QString &line)
+static void appendPoWrappedEscapedLines(QString &out, QStringView prefix, bool addSpace,
+                                        QStringView line)
 {
-    const int maxlen = MAX_LEN - prefix.size() - addSpace;
-    QStringList lines;
-    int off = 0;
+    const qsizetype maxlen = MAX_LEN - prefix.size() - addSpace;
+    qsizetype off = 0;
     while (off + maxlen < line.size()) {
-        int idx = line.lastIndexOf(QLatin1Char(' '), off + maxlen - 1);
+        qsizetype idx = line.lastIndexOf(QLatin1Char(' '), off + maxlen - 1);
         if (idx < off) {
 #if 0 //def HARD_WRAP_LONG_WORDS
             // This cannot work without messing up semantics, so do not even try.
@@ -147,11 +177,10 @@ static QString poWrappedEscapedLines(const QString &prefix, bool addSpace, const
                 break;
 #endif
         }
-        lines.append(line.mid(off, idx - off));
+        appendPoEscapedLine(out, prefix, addSpace, line.sliced(off, idx - off));
         off = idx + 1;
     }
-    lines.append(line.mid(off));
-    return poEscapedLines(prefix, addSpace, lines);
+    appendPoEscapedLine(out, prefix, addSpace, line.sliced(off));
 }
 
 struct PoItem
@@ -181,19 +210,19 @@ public:
 };
 
 
-static bool isTranslationLine(const QByteArray &line)
+static bool isTranslationLine(QByteArrayView line)
 {
     return line.startsWith("#~ msgstr") || line.startsWith("msgstr");
 }
 
-static QByteArray slurpEscapedString(const QList<QByteArray> &lines, int &l,
-        int offset, const QByteArray &prefix, ConversionData &cd)
+static QByteArray slurpEscapedString(const QList<QByteArrayView> &lines, int &l,
+        int offset, QByteArrayView prefix, ConversionData &cd)
 {
     QByteArray msg;
     int stoff;
 
     for (; l < lines.size(); ++l) {
-        const QByteArray &line = lines.at(l);
+        const QByteArrayView line = lines.at(l);
         if (line.isEmpty() || !line.startsWith(prefix))
             break;
         while (isspace(line[offset])) // No length check, as string has no trailing spaces.
@@ -280,7 +309,12 @@ static QByteArray slurpEscapedString(const QList<QByteArray> &lines, int &l,
                     break;
                 }
             } else {
-                msg += c;
+                // Copy the run of characters up to the next quote or escape at once.
+                int end = offset;
+                while (end < line.size() && line[end] != '"' && line[end] != '\\')
+                    ++end;
+                msg.append(line.sliced(offset - 1, end - offset + 1));
+                offset = end;
             }
         }
         offset = prefix.size();
@@ -294,10 +328,10 @@ premature_eol:
     return QByteArray();
 }
 
-static void slurpComment(QByteArray &msg, const QList<QByteArray> &lines, int & l)
+static void slurpComment(QByteArray &msg, const QList<QByteArrayView> &lines, int & l)
 {
     int firstLine = l;
-    QByteArray prefix = lines.at(l);
+    QByteArrayView prefix = lines.at(l);
     for (int i = 1; ; i++) {
         if (prefix.at(i) != ' ') {
             prefix.truncate(i);
@@ -305,11 +339,11 @@ static void slurpComment(QByteArray &msg, const QList<QByteArray> &lines, int &
         }
     }
     for (; l < lines.size(); ++l) {
-        const QByteArray &line = lines.at(l);
+        const QByteArrayView line = lines.at(l);
         if (line.startsWith(prefix)) {
             if (l > firstLine)
                 msg += '\n';
-            msg += line.mid(prefix.size());
+            msg.append(line.sliced(prefix.size()));
         } else if (line == "#") {
             msg += '\n';
         } else {
@@ -347,7 +381,7 @@ static QString makePoHeader(const QString &str)
     return QLatin1String("po-header-") + str.toLower().replace(QLatin1Char('-'), QLatin1Char('_'));
 }
 
-static QByteArray QByteArrayList_join(const QList<QByteArray> &that, char sep)
+static QByteArray QByteArrayList_join(const QList<QByteArrayView> &that, char sep)
 {
     int totalLength = 0;
     const int size = that.size();
@@ -365,7 +399,7 @@ static QByteArray QByteArrayList_join(const QList<QByteArray> &that, char sep)
     for (int i = 0; i < that.size(); ++i) {
         if (i)
             res += sep;
-        res += that.at(i);
+        res.append(that.at(i));
     }
     return res;
 }
@@ -393,22 +427,48 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
     // msgstr[0] translated-string
     // ...
 
-    // we need line based lookahead below.
-    QList<QByteArray> lines;
-    while (!dev.atEnd())
-        lines.append(dev.readLine().trimmed());
-    lines.append(QByteArray());
+    // The file is mapped, or read at once, and split into trimmed lines
+    // in place, as we need line based lookahead below.
+    QByteArray data;
+    uchar *mapped = nullptr;
+    auto *file = qobject_cast<QFileDevice *>(&dev);
+    const qint64 fileSize = file && !file->isSequential() && !file->pos() ? file->size() : 0;
+    if (fileSize > 0)
+        mapped = file->map(0, fileSize);
+    const auto unmap = qScopeGuard([&] {
+        if (mapped)
+            file->unmap(mapped);
+    });
+    QByteArrayView buffer;
+    if (mapped) {
+        buffer = QByteArrayView(mapped, fileSize);
+        file->seek(fileSize);
+    } else {
+        data = dev.readAll();
+        buffer = data;
+    }
+
+    QList<QByteArrayView> lines;
+    lines.reserve(buffer.count('\n') + 2);
+    for (qsizetype start = 0; start < buffer.size(); ) {
+        qsizetype end = buffer.indexOf('\n', start);
+        if (end < 0)
+            end = buffer.size();
+        lines.append(buffer.sliced(start, end - start).trimmed());
+        start = end + 1;
+    }
+    lines.append(QByteArrayView());
 
     int l = 0, lastCmtLine = -1;
     bool qtContexts = false;
     PoItem item;
     for (; l != lines.size(); ++l) {
-        QByteArray line = lines.at(l);
+        QByteArrayView line = lines.at(l);
         if (line.isEmpty())
            continue;
         if (isTranslationLine(line)) {
             bool isObsolete = line.startsWith("#~ msgstr");
-            const QByteArray prefix = isObsolete ? "#~ " : "";
+            const QByteArrayView prefix = isObsolete ? "#~ " : "";
             while (true) {
                 int idx = line.indexOf(' ', prefix.size());
                 QByteArray str = slurpEscapedString(lines, l, idx, prefix, cd);
@@ -494,8 +554,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                 for (int cho = 0; cho < hdrOrder.size(); cho++) {
                     for (;; cdh++) {
                         if (cdh == sizeof(dfltHdrs)/sizeof(dfltHdrs[0])) {
-                            extras[QLatin1String("po-headers")] =
-                                    QByteArrayList_join(hdrOrder, ',');
+                            extras[QLatin1String("po-headers")] = hdrOrder.join(',');
                             goto doneho;
                         }
                         if (hdrOrder.at(cho) == dfltHdrs[cdh]) {
@@ -573,7 +632,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
         } else if (line.startsWith('#')) {
             switch (line.size() < 2 ? 0 : line.at(1)) {
                 case ':':
-                    item.references += line.mid(3);
+                    item.references.append(line.mid(3));
                     item.references += '\n';
                     break;
                 case ',': {
@@ -598,11 +657,11 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                     break;
                 case '.':
                     if (line.startsWith("#. ts-context ")) { // legacy
-                        item.context = line.mid(14);
+                        item.context = line.mid(14).toByteArray();
                     } else if (line.startsWith("#. ts-id ")) {
-                        item.id = line.mid(9);
+                        item.id = line.mid(9).toByteArray();
                     } else {
-                        item.automaticComments += line.mid(3);
+                        item.automaticComments.append(line.mid(3));
 
                     }
                     break;
@@ -662,13 +721,13 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
             }
             lastCmtLine = l;
         } else if (line.startsWith("msgctxt ")) {
-            item.tscomment = slurpEscapedString(lines, l, 8, QByteArray(), cd);
+            item.tscomment = slurpEscapedString(lines, l, 8, {}, cd);
             if (qtContexts)
                 splitContext(&item.tscomment, &item.context);
         } else if (line.startsWith("msgid ")) {
-            item.msgId = slurpEscapedString(lines, l, 6, QByteArray(), cd);
+            item.msgId = slurpEscapedString(lines, l, 6, {}, cd);
         } else if (line.startsWith("msgid_plural ")) {
-            QByteArray extra = slurpEscapedString(lines, l, 13, QByteArray(), cd);
+            QByteArray extra = slurpEscapedString(lines, l, 13, {}, cd);
             if (extra != item.msgId)
                 item.extra[QLatin1String("po-msgid_plural")] = toUnicode(extra);
             item.isPlural = true;
@@ -705,7 +764,16 @@ bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
     QString str_format = QLatin1String("-format");
 
     bool ok = true;
-    QTextStream out(&dev);
+    // The entries are escaped and wrapped into one buffer, which is
+    // written out as UTF-8 whenever it gets large.
+    constexpr qsizetype flushSize = 64 * 1024;
+    QString out;
+    out.reserve(flushSize + 4 * 1024);
+    const auto flush = [&] {
+        if (dev.write(out.toUtf8()) < 0)
+            ok = false;
+        out.clear();
+    };
 
     bool qtContexts = false;
     for (const TranslatorMessage &msg : translator.messages())
@@ -715,9 +783,11 @@ bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
         }
 
     QString cmt = translator.extra(QLatin1String("po-header_comment"));
-    if (!cmt.isEmpty())
-        out << cmt << '\n';
-    out << "msgid \"\"\n";
+    if (!cmt.isEmpty()) {
+        out += cmt;
+        out += QLatin1Char('\n');
+    }
+    out += QLatin1String("msgid \"\"\n");
     Translator::ExtraData headers = translator.extras();
     QStringList hdrOrder = translator.extra(QLatin1String("po-headers")).split(
             QLatin1Char(','), Qt::SkipEmptyParts);
@@ -746,29 +816,42 @@ bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
         hdrStr += headers.value(makePoHeader(hdr));
         hdrStr += QLatin1Char('\n');
     }
-    out << poEscapedString(QString(), QString::fromLatin1("msgstr"), true, hdrStr);
+    appendPoEscapedString(out, {}, u"msgstr", true, hdrStr);
 
+    QString keyword;
     for (const TranslatorMessage &msg : translator.messages()) {
-        out << Qt::endl;
+        if (out.size() >= flushSize)
+            flush();
+        out += QLatin1Char('\n');
 
         if (!msg.translatorComment().isEmpty())
-            out << poEscapedLines(QLatin1String("#"), true, msg.translatorComment());
+            appendPoEscapedLines(out, u"#", true, msg.translatorComment());
 
         if (!msg.extraComment().isEmpty())
-            out << poEscapedLines(QLatin1String("#."), true, msg.extraComment());
+            appendPoEscapedLines(out, u"#.", true, msg.extraComment());
 
-        if (!msg.id().isEmpty())
-            out << QLatin1String("#. ts-id ") << msg.id() << '\n';
+        if (!msg.id().isEmpty()) {
+            out += QLatin1String("#. ts-id ");
+            out += msg.id();
+            out += QLatin1Char('\n');
+        }
 
         QString xrefs = msg.extra(QLatin1String("po-references"));
         if (!msg.fileName().isEmpty() || !xrefs.isEmpty()) {
-            QStringList refs;
-            for (const TranslatorMessage::Reference &ref : msg.allReferences())
-                refs.append(QString(QLatin1String("%2:%1"))
-                                    .arg(ref.lineNumber()).arg(ref.fileName()));
-            if (!xrefs.isEmpty())
-                refs << xrefs;
-            out << poWrappedEscapedLines(QLatin1String("#:"), true, refs.join(QLatin1Char(' ')));
+            QString refs;
+            for (const TranslatorMessage::Reference &ref : msg.allReferences()) {
+                if (!refs.isEmpty())
+                    refs += QLatin1Char(' ');
+                refs += ref.fileName();
+                refs += QLatin1Char(':');
+                refs += QString::number(ref.lineNumber());
+            }
+            if (!xrefs.isEmpty()) {
+                if (!refs.isEmpty())
+                    refs += QLatin1Char(' ');
+                refs += xrefs;
+            }
+            appendPoWrappedEscapedLines(out, u"#:", true, refs);
         }
 
         bool noWrap = false;
@@ -790,7 +873,7 @@ bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
             flags.append(*itr);
         }
         if (!skipFormat) {
-            QString source = msg.sourceText();
+            const QString &source = msg.sourceText();
             // This is fuzzy logic, as we don't know whether the string is
             // actually used with QString::arg().
             for (int off = 0; (off = source.indexOf(QLatin1Char('%'), off)) >= 0; ) {
@@ -802,48 +885,54 @@ bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
                 }
             }
         }
-        if (!flags.isEmpty())
-            out << "#, " << flags.join(QLatin1String(", ")) << '\n';
+        if (!flags.isEmpty()) {
+            out += QLatin1String("#, ");
+            out += flags.join(QLatin1String(", "));
+            out += QLatin1Char('\n');
+        }
 
         bool isObsolete = (msg.type() == TranslatorMessage::Obsolete
                            || msg.type() == TranslatorMessage::Vanished);
-        QString prefix = QLatin1String(isObsolete ? "#~| " : "#| ");
+        QStringView prefix = isObsolete ? u"#~| " : u"#| ";
         if (!msg.oldComment().isEmpty())
-            out << poEscapedString(prefix, QLatin1String("msgctxt"), noWrap,
-                                   escapeComment(msg.oldComment(), qtContexts));
+            appendPoEscapedString(out, prefix, u"msgctxt", noWrap,
+                                  escapeComment(msg.oldComment(), qtContexts));
         if (!msg.oldSourceText().isEmpty())
-            out << poEscapedString(prefix, QLatin1String("msgid"), noWrap, msg.oldSourceText());
+            appendPoEscapedString(out, prefix, u"msgid", noWrap, msg.oldSourceText());
         QString plural = msg.extra(QLatin1String("po-old_msgid_plural"));
         if (!plural.isEmpty())
-            out << poEscapedString(prefix, QLatin1String("msgid_plural"), noWrap, plural);
-        prefix = QLatin1String(isObsolete ? "#~ " : "");
+            appendPoEscapedString(out, prefix, u"msgid_plural", noWrap, plural);
+        prefix = isObsolete ? u"#~ " : u"";
         if (!msg.context().isEmpty())
-            out << poEscapedString(prefix, QLatin1String("msgctxt"), noWrap,
-                                   escapeComment(msg.context(), true) + QLatin1Char('|')
-                                   + escapeComment(msg.comment(), true));
+            appendPoEscapedString(out, prefix, u"msgctxt", noWrap,
+                                  escapeComment(msg.context(), true) + QLatin1Char('|')
+                                  + escapeComment(msg.comment(), true));
         else if (!msg.comment().isEmpty())
-            out << poEscapedString(prefix, QLatin1String("msgctxt"), noWrap,
-                                   escapeComment(msg.comment(), qtContexts));
-        out << poEscapedString(prefix, QLatin1String("msgid"), noWrap, msg.sourceText());
+            appendPoEscapedString(out, prefix, u"msgctxt", noWrap,
+                                  escapeComment(msg.comment(), qtContexts));
+        appendPoEscapedString(out, prefix, u"msgid", noWrap, msg.sourceText());
         if (!msg.isPlural()) {
             QString transl = msg.translation();
             transl.replace(Translator::BinaryVariantSeparator, Translator::TextVariantSeparator);
-            out << poEscapedString(prefix, QLatin1String("msgstr"), noWrap, transl);
+            appendPoEscapedString(out, prefix, u"msgstr", noWrap, transl);
         } else {
             QString plural = msg.extra(QLatin1String("po-msgid_plural"));
             if (plural.isEmpty())
                 plural = msg.sourceText();
-            out << poEscapedString(prefix, QLatin1String("msgid_plural"), noWrap, plural);
+            appendPoEscapedString(out, prefix, u"msgid_plural", noWrap, plural);
             const QStringList &translations = msg.translations();
             for (int i = 0; i != translations.size(); ++i) {
                 QString str = translations.at(i);
                 str.replace(QChar(Translator::BinaryVariantSeparator),
                             QChar(Translator::TextVariantSeparator));
-                out << poEscapedString(prefix, QString::fromLatin1("msgstr[%1]").arg(i), noWrap,
-                                       str);
+                keyword = QLatin1String("msgstr[");
+                keyword += QString::number(i);
+                keyword += QLatin1Char(']');
+                appendPoEscapedString(out, prefix, keyword, noWrap, str);
             }
         }
     }
+    flush();
     return ok;
 }
 
@@ -11,9 +11,17 @@
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QScopeGuard>
 #include <QtCore/QString>
 #include <QtCore/QStringDecoder>
+#include <QtCore/qendian.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -68,6 +76,22 @@ static uint elfHash(const QByteArray &ba)
     return h;
 }
 
+/*
+  Mixes a message hash with a seed for the perfect hash table, using the
+  finalizer of MurmurHash3. Readers of the PerfectHashes section have to
+  use exactly this function.
+*/
+static quint32 perfectHashMix(quint32 h, quint32 seed)
+{
+    h ^= seed * 0x9e3779b9u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
 class ByteTranslatorMessage
 {
 public:
@@ -126,7 +150,7 @@ public:
         uint o;
     };
 
-    enum { Contexts = 0x2f, Hashes = 0x42, Messages = 0x69, NumerusRules = 0x88, Dependencies = 0x96, Language = 0xa7 };
+    enum { Contexts = 0x2f, Hashes = 0x42, PerfectHashes = 0x4b, Messages = 0x69, NumerusRules = 0x88, Dependencies = 0x96, Language = 0xa7 };
 
     Releaser(const QString &language) : m_language(language) {}
 
@@ -139,6 +163,7 @@ public:
 
     void setNumerusRules(const QByteArray &rules);
     void setDependencies(const QStringList &dependencies);
+    void setPerfectHash(bool enabled) { m_perfectHash = enabled; }
 
 private:
     Q_DISABLE_COPY(Releaser)
@@ -147,10 +172,16 @@ private:
     // on turn should be the same as passed to the actual tr(...) calls
     QByteArray originalBytes(const QString &str) const;
 
-    static Prefix commonPrefix(const ByteTranslatorMessage &m1, const ByteTranslatorMessage &m2);
+    static Prefix commonPrefix(const ByteTranslatorMessage &m1, uint h1,
+                               const ByteTranslatorMessage &m2, uint h2);
 
     static uint msgHash(const ByteTranslatorMessage &msg);
 
+    static QByteArray perfectHashTable(const std::vector<Offset> &offsets);
+    static QByteArray sharedPerfectHashTable(const std::vector<Offset> &offsets);
+
+    static qsizetype messageSize(const ByteTranslatorMessage &msg, TranslatorSaveMode mode,
+                                 Prefix prefix);
     void writeMessage(const ByteTranslatorMessage & msg, QDataStream & stream,
         TranslatorSaveMode strip, Prefix prefix) const;
 
@@ -158,11 +189,13 @@ private:
     // for squeezed but non-file data, this is what needs to be deleted
     QByteArray m_messageArray;
     QByteArray m_offsetArray;
+    QByteArray m_perfectHashArray;
     QByteArray m_contextArray;
     QMap<ByteTranslatorMessage, void *> m_messages;
     QByteArray m_numerusRules;
     QStringList m_dependencies;
     QByteArray m_dependencyArray;
+    bool m_perfectHash = false;
 };
 
 QByteArray Releaser::originalBytes(const QString &str) const
@@ -180,9 +213,10 @@ uint Releaser::msgHash(const ByteTranslatorMessage &msg)
     return elfHash(msg.sourceText() + msg.comment());
 }
 
-Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, const ByteTranslatorMessage &m2)
+Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, uint h1,
+                              const ByteTranslatorMessage &m2, uint h2)
 {
-    if (msgHash(m1) != msgHash(m2))
+    if (h1 != h2)
         return NoPrefix;
     if (m1.context() != m2.context())
         return Hash;
@@ -193,6 +227,35 @@ Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, const ByteTransla
     return HashContextSourceTextComment;
 }
 
+// The number of bytes writeMessage() produces for the same arguments.
+qsizetype Releaser::messageSize(const ByteTranslatorMessage &msg, TranslatorSaveMode mode,
+                                Prefix prefix)
+{
+    // A tag, followed by the length and the data as written by QDataStream.
+    const auto field = [](qsizetype bytes) { return 1 + 4 + bytes; };
+
+    qsizetype size = 1; // Tag_End
+    for (const QString &translation : msg.translations())
+        size += field(translation.isNull() ? 0 : translation.size() * 2);
+
+    if (mode == SaveEverything)
+        prefix = HashContextSourceTextComment;
+
+    switch (prefix) {
+    default:
+    case HashContextSourceTextComment:
+        size += field(msg.comment().size());
+        Q_FALLTHROUGH();
+    case HashContextSourceText:
+        size += field(msg.sourceText().size());
+        Q_FALLTHROUGH();
+    case HashContext:
+        size += field(msg.context().size());
+        break;
+    }
+    return size;
+}
+
 void Releaser::writeMessage(const ByteTranslatorMessage &msg, QDataStream &stream,
     TranslatorSaveMode mode, Prefix prefix) const
 {
@@ -219,6 +282,134 @@ void Releaser::writeMessage(const ByteTranslatorMessage &msg, QDataStream &strea
     stream << quint8(Tag_End);
 }
 
+/*
+  Builds a minimal perfect hash over the distinct message hashes in the
+  sorted \a offsets, using the hash-and-displace (CHD) scheme. The table
+  has the following format:
+
+      quint32 bucketCount;
+      quint32 slotCount;
+      quint32 displacement[bucketCount];
+      quint32 slot[slotCount];
+
+  To look up a message hash h, compute
+  b = perfectHashMix(h, 0) % bucketCount and
+  s = perfectHashMix(h, displacement[b]) % slotCount. Then slot[s] is the
+  index of the first entry in the Hashes table whose hash is h, provided
+  that this entry actually has hash h. Otherwise there is no message with
+  that hash. Entries with the same hash follow, as before.
+
+  Returns an empty array if no displacement can be found in bounded
+  time; the section is then not written.
+*/
+QByteArray Releaser::perfectHashTable(const std::vector<Offset> &offsets)
+{
+    std::vector<quint32> keys;
+    std::vector<quint32> firstEntries;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (i == 0 || offsets[i].h != offsets[i - 1].h) {
+            keys.push_back(offsets[i].h);
+            firstEntries.push_back(quint32(i));
+        }
+    }
+    if (keys.empty())
+        return QByteArray();
+
+    const quint32 slotCount = quint32(keys.size());
+    const quint32 bucketCount = (slotCount + 3) / 4;
+    std::vector<std::vector<quint32>> buckets(bucketCount);
+    for (quint32 k = 0; k < slotCount; ++k)
+        buckets[perfectHashMix(keys[k], 0) % bucketCount].push_back(k);
+
+    // Place the largest buckets first, while most slots are still free.
+    std::vector<quint32> order(bucketCount);
+    for (quint32 b = 0; b < bucketCount; ++b)
+        order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&buckets](quint32 a, quint32 b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    const quint32 maxDisplacement = 1u << 24;
+    std::vector<quint32> displacements(bucketCount, 0);
+    std::vector<quint32> slots(slotCount, 0);
+    std::vector<bool> taken(slotCount, false);
+    std::vector<quint32> positions;
+    for (quint32 b : order) {
+        const std::vector<quint32> &bucket = buckets[b];
+        if (bucket.empty())
+            break;
+        quint32 d = 1;
+        for (; d < maxDisplacement; ++d) {
+            positions.clear();
+            for (quint32 k : bucket) {
+                const quint32 p = perfectHashMix(keys[k], d) % slotCount;
+                if (taken[p] || std::find(positions.cbegin(), positions.cend(), p)
+                                        != positions.cend()) {
+                    break;
+                }
+                positions.push_back(p);
+            }
+            if (positions.size() == bucket.size())
+                break;
+        }
+        if (d == maxDisplacement)
+            return QByteArray();
+        displacements[b] = d;
+        for (size_t j = 0; j < bucket.size(); ++j) {
+            taken[positions[j]] = true;
+            slots[positions[j]] = firstEntries[bucket[j]];
+        }
+    }
+
+    QByteArray table(8 + 4 * (qsizetype(bucketCount) + slotCount), Qt::Uninitialized);
+    uchar *data = reinterpret_cast<uchar *>(table.data());
+    qToBigEndian(bucketCount, data);
+    qToBigEndian(slotCount, data + 4);
+    data += 8;
+    for (quint32 d : displacements) {
+        qToBigEndian(d, data);
+        data += 4;
+    }
+    for (quint32 slot : slots) {
+        qToBigEndian(slot, data);
+        data += 4;
+    }
+    return table;
+}
+
+/*
+  The table only depends on the sorted hashes, not on the translations.
+  The languages of a project mostly have the same messages, in particular
+  when released by ID, and lrelease releases them in one process. So the
+  tables are shared between the releases, which only pay for building
+  the table of a set of hashes once.
+*/
+QByteArray Releaser::sharedPerfectHashTable(const std::vector<Offset> &offsets)
+{
+    static constexpr qsizetype maxTables = 16;
+    static std::mutex mutex;
+    static QHash<QByteArray, QByteArray> tables;
+
+    QByteArray hashes(qsizetype(offsets.size()) * 4, Qt::Uninitialized);
+    uchar *data = reinterpret_cast<uchar *>(hashes.data());
+    for (const Offset &offset : offsets) {
+        qToBigEndian(quint32(offset.h), data);
+        data += 4;
+    }
+    {
+        std::lock_guard lock(mutex);
+        const auto it = tables.constFind(hashes);
+        if (it != tables.cend())
+            return *it;
+    }
+
+    QByteArray table = perfectHashTable(offsets);
+    std::lock_guard lock(mutex);
+    if (tables.size() >= maxTables)
+        tables.clear();
+    tables.insert(hashes, table);
+    return table;
+}
 
 bool Releaser::save(QIODevice *iod)
 {
@@ -241,6 +432,11 @@ bool Releaser::save(QIODevice *iod)
         s << quint8(Hashes) << oas;
         s.writeRawData(m_offsetArray.constData(), oas);
     }
+    if (!m_perfectHashArray.isEmpty()) {
+        quint32 phs = quint32(m_perfectHashArray.size());
+        s << quint8(PerfectHashes) << phs;
+        s.writeRawData(m_perfectHashArray.constData(), phs);
+    }
     if (!m_messageArray.isEmpty()) {
         quint32 mas = quint32(m_messageArray.size());
         s << quint8(Messages) << mas;
@@ -269,41 +465,70 @@ void Releaser::squeeze(TranslatorSaveMode mode)
     if (m_messages.isEmpty() && mode == SaveEverything)
         return;
 
-    const auto messages = m_messages;
-
-    // re-build contents
-    m_messageArray.clear();
-    m_offsetArray.clear();
-    m_contextArray.clear();
-    m_messages.clear();
-
-    QMap<Offset, void *> offsets;
-
-    QDataStream ms(&m_messageArray, QIODevice::WriteOnly);
+    /*
+      The messages are written in two passes over the sorted map. The first
+      one computes the hashes, the shared prefixes and the exact size of the
+      message array; the second one writes the messages into the buffer
+      allocated for them and records the offsets.
+    */
+    const qsizetype count = m_messages.size();
+    std::vector<uint> hashes;
+    hashes.reserve(count);
+    for (auto it = m_messages.cbegin(), end = m_messages.cend(); it != end; ++it)
+        hashes.push_back(msgHash(it.key()));
+
+    std::vector<quint8> prefixes(count);
+    qsizetype messageArraySize = 0;
     int cpPrev = 0, cpNext = 0;
-    for (auto it = messages.cbegin(), end = messages.cend(); it != end; ++it) {
+    qsizetype i = 0;
+    for (auto it = m_messages.cbegin(), end = m_messages.cend(); it != end; ++it, ++i) {
         cpPrev = cpNext;
         const auto next = std::next(it);
         if (next == end)
             cpNext = 0;
         else
-            cpNext = commonPrefix(it.key(), next.key());
-        offsets.insert(Offset(msgHash(it.key()), ms.device()->pos()), (void *)0);
-        writeMessage(it.key(), ms, mode, Prefix(qMax(cpPrev, cpNext + 1)));
+            cpNext = commonPrefix(it.key(), hashes[i], next.key(), hashes[i + 1]);
+        prefixes[i] = quint8(qMax(cpPrev, cpNext + 1));
+        messageArraySize += messageSize(it.key(), mode, Prefix(prefixes[i]));
     }
 
-    auto offset = offsets.cbegin();
-    QDataStream ds(&m_offsetArray, QIODevice::WriteOnly);
-    while (offset != offsets.cend()) {
-        Offset k = offset.key();
-        ++offset;
-        ds << quint32(k.h) << quint32(k.o);
+    m_messageArray.clear();
+    m_offsetArray.clear();
+    m_perfectHashArray.clear();
+    m_contextArray.clear();
+
+    std::vector<Offset> offsets;
+    offsets.reserve(count);
+
+    QDataStream ms(&m_messageArray, QIODevice::WriteOnly);
+    m_messageArray.reserve(messageArraySize);
+    i = 0;
+    for (auto it = m_messages.cbegin(), end = m_messages.cend(); it != end; ++it, ++i) {
+        offsets.emplace_back(hashes[i], uint(ms.device()->pos()));
+        writeMessage(it.key(), ms, mode, Prefix(prefixes[i]));
+    }
+    std::vector<quint8>().swap(prefixes);
+
+    // The offsets are already unique, since every message has its own position.
+    std::sort(offsets.begin(), offsets.end());
+    m_offsetArray.resize(qsizetype(offsets.size()) * 8);
+    uchar *offsetData = reinterpret_cast<uchar *>(m_offsetArray.data());
+    for (const Offset &offset : offsets) {
+        qToBigEndian(quint32(offset.h), offsetData);
+        qToBigEndian(quint32(offset.o), offsetData + 4);
+        offsetData += 8;
     }
+    if (m_perfectHash)
+        m_perfectHashArray = sharedPerfectHashTable(offsets);
+    std::vector<Offset>().swap(offsets);
 
     if (mode == SaveStripped) {
-        QMap<QByteArray, int> contextSet;
-        for (auto it = messages.cbegin(), end = messages.cend(); it != end; ++it)
-            ++contextSet[it.key().context()];
+        // The messages are sorted by context, so equal contexts are adjacent.
+        QList<QByteArray> contextSet;
+        for (auto it = m_messages.cbegin(), end = m_messages.cend(); it != end; ++it) {
+            if (contextSet.isEmpty() || contextSet.constLast() != it.key().context())
+                contextSet.append(it.key().context());
+        }
 
         quint16 hTableSize;
         if (contextSet.size() < 200)
@@ -314,8 +539,8 @@ void Releaser::squeeze(TranslatorSaveMode mode)
             hTableSize = (contextSet.size() < 10000) ? 15013 : 3 * contextSet.size() / 2;
 
         QMultiMap<int, QByteArray> hashMap;
-        for (auto c = contextSet.cbegin(), end = contextSet.cend(); c != end; ++c)
-            hashMap.insert(elfHash(c.key()) % hTableSize, c.key());
+        for (const QByteArray &context : std::as_const(contextSet))
+            hashMap.insert(elfHash(context) % hTableSize, context);
 
         /*
           The contexts found in this translator are stored in a hash
@@ -380,6 +605,8 @@ void Releaser::squeeze(TranslatorSaveMode mode)
             m_contextArray.clear();
         }
     }
+
+    m_messages.clear();
 }
 
 void Releaser::insert(const TranslatorMessage &message, const QStringList &tlns, bool forceComment)
@@ -425,6 +652,37 @@ static quint32 read32(const uchar *data)
     return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | (data[3]);
 }
 
+/*
+  Checks that the PerfectHashes section in \a table resolves every hash in
+  the \a offsetArray of the Hashes section to its first entry.
+*/
+static bool checkPerfectHashTable(const uchar *table, quint32 length,
+                                  const uchar *offsetArray, quint32 offsetLength)
+{
+    if (length < 8)
+        return false;
+    const quint32 bucketCount = read32(table);
+    const quint32 slotCount = read32(table + 4);
+    if (!bucketCount || !slotCount || length != 8 + 4 * (quint64(bucketCount) + slotCount))
+        return false;
+    const uchar *displacements = table + 8;
+    const uchar *slots = displacements + 4 * bucketCount;
+
+    const quint32 entryCount = offsetLength / 8;
+    quint32 keyCount = 0;
+    for (quint32 i = 0; i < entryCount; ++i) {
+        const quint32 h = read32(offsetArray + 8 * i);
+        if (i > 0 && read32(offsetArray + 8 * (i - 1)) == h)
+            continue;
+        ++keyCount;
+        const quint32 b = perfectHashMix(h, 0) % bucketCount;
+        const quint32 slot = perfectHashMix(h, read32(displacements + 4 * b)) % slotCount;
+        if (read32(slots + 4 * slot) != i)
+            return false;
+    }
+    return keyCount == slotCount;
+}
+
 static void fromBytes(const char *str, int len, QString *out, bool *utf8Fail)
 {
     QStringDecoder toUnicode(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
@@ -434,20 +692,36 @@ static void fromBytes(const char *str, int len, QString *out, bool *utf8Fail)
 
 bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
 {
-    QByteArray ba = dev.readAll();
-    const uchar *data = (uchar*)ba.data();
-    int len = ba.size();
+    // Map files instead of copying them to the heap, where possible.
+    QByteArray ba;
+    uchar *mapped = nullptr;
+    auto *file = qobject_cast<QFileDevice *>(&dev);
+    const qint64 fileSize = file && !file->isSequential() && !file->pos() ? file->size() : 0;
+    if (fileSize > 0 && fileSize <= std::numeric_limits<int>::max())
+        mapped = file->map(0, fileSize);
+    const auto unmap = qScopeGuard([&] {
+        if (mapped)
+            file->unmap(mapped);
+    });
+    if (mapped)
+        file->seek(fileSize);
+    else
+        ba = dev.readAll();
+    const uchar *data = mapped ? mapped : (uchar*)ba.data();
+    int len = mapped ? int(fileSize) : ba.size();
     if (len < MagicLength || memcmp(data, magic, MagicLength) != 0) {
         cd.appendError(QLatin1String("QM-Format error: magic marker missing"));
         return false;
     }
 
-    enum { Contexts = 0x2f, Hashes = 0x42, Messages = 0x69, NumerusRules = 0x88, Dependencies = 0x96, Language = 0xa7 };
+    enum { Contexts = 0x2f, Hashes = 0x42, PerfectHashes = 0x4b, Messages = 0x69, NumerusRules = 0x88, Dependencies = 0x96, Language = 0xa7 };
 
     // for squeezed but non-file data, this is what needs to be deleted
     const uchar *messageArray = nullptr;
     const uchar *offsetArray = nullptr;
     uint offsetLength = 0;
+    const uchar *perfectHashArray = nullptr;
+    uint perfectHashLength = 0;
 
     bool ok = true;
     bool utf8Fail = false;
@@ -471,6 +745,9 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
             offsetArray = data;
             offsetLength = blockLen;
             //qDebug() << "HASHES: " << blockLen << QByteArray((const char *)data, blockLen).toHex();
+        } else if (tag == PerfectHashes) {
+            perfectHashArray = data;
+            perfectHashLength = blockLen;
         } else if (tag == Messages) {
             messageArray = data;
             //qDebug() << "MESSAGES: " << blockLen << QByteArray((const char *)data, blockLen).toHex();
@@ -493,6 +770,16 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
     }
 
 
+    // The messages are read sequentially, so the table is only validated.
+    if (perfectHashArray
+        && (!offsetArray
+            || !checkPerfectHashTable(perfectHashArray, perfectHashLength, offsetArray,
+                                      offsetLength))) {
+        cd.appendError(QLatin1String("QM-Format error: perfect hash table does not match the "
+                                     "message hashes"));
+        return false;
+    }
+
     size_t numItems = offsetLength / (2 * sizeof(quint32));
     //qDebug() << "NUMITEMS: " << numItems;
 
@@ -507,6 +794,10 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
 
     QString context, sourcetext, comment;
     QStringList translations;
+    // Consecutive messages mostly have the same context, which is then
+    // decoded only once and shared.
+    QByteArrayView contextBytes;
+    bool contextUtf8Fail = false;
 
     for (const uchar *start = offsetArray; start != offsetArray + (numItems << 3); start += 8) {
         //quint32 hash = read32(start);
@@ -531,15 +822,12 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
                     return false;
                 }
                 QString str;
-                if (len != -1)
-                    str = QString((const QChar *)m, len / 2);
-                if (QSysInfo::ByteOrder == QSysInfo::LittleEndian) {
-                    for (int i = 0; i < str.size(); ++i)
-                        str[i] = QChar((str.at(i).unicode() >> 8) +
-                            ((str.at(i).unicode() << 8) & 0xff00));
+                if (len != -1) {
+                    str.resize(len / 2);
+                    qFromBigEndian<char16_t>(m, len / 2, str.data());
+                    m += len;
                 }
                 translations << str;
-                m += len;
                 break;
             }
             case Tag_Obsolete1:
@@ -560,7 +848,12 @@ bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
                 m += 4;
                 //qDebug() << "CONTEXT LEN: " << len;
                 //qDebug() << "CONTEXT: " << QByteArray((const char*)m, len);
-                fromBytes((const char*)m, len, &context, &utf8Fail);
+                const QByteArrayView bytes(m, len);
+                if (bytes != contextBytes || context.isNull()) {
+                    fromBytes((const char*)m, len, &context, &contextUtf8Fail);
+                    contextBytes = bytes;
+                }
+                utf8Fail = contextUtf8Fail;
                 m += len;
                 break;
             }
@@ -687,6 +980,7 @@ bool saveQM(const Translator &translator, QIODevice &dev, ConversionData &cd)
             droppedData));
 
     releaser.setDependencies(translator.dependencies());
+    releaser.setPerfectHash(cd.m_qmPerfectHash);
     releaser.squeeze(cd.m_saveMode);
     bool saved = releaser.save(&dev);
     if (saved && cd.isVerbose()) {
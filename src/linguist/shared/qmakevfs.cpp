@@ -31,7 +31,7 @@ QMakeVfs::~QMakeVfs()
 void QMakeVfs::ref()
 {
 #ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&s_mutex);
+    QWriteLocker locker(&s_lock);
 #endif
     ++s_refCount;
 }
@@ -39,7 +39,7 @@ void QMakeVfs::ref()
 void QMakeVfs::deref()
 {
 #ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&s_mutex);
+    QWriteLocker locker(&s_lock);
 #endif
     if (!--s_refCount) {
         s_fileIdCounter = 0;
@@ -48,8 +48,8 @@ void QMakeVfs::deref()
     }
 }
 
-#ifdef PROPARSER_THREAD_SAFE
-QMutex QMakeVfs::s_mutex;
+#ifdef PROEVALUATOR_THREAD_SAFE
+QReadWriteLock QMakeVfs::s_lock;
 #endif
 int QMakeVfs::s_refCount;
 QAtomicInt QMakeVfs::s_fileIdCounter;
@@ -60,7 +60,7 @@ int QMakeVfs::idForFileName(const QString &fn, VfsFlags flags)
 {
 #ifdef PROEVALUATOR_DUAL_VFS
     {
-# ifdef PROPARSER_THREAD_SAFE
+# ifdef PROEVALUATOR_THREAD_SAFE
         QMutexLocker locker(&m_vmutex);
 # endif
         int idx = (flags & VfsCumulative) ? 1 : 0;
@@ -77,8 +77,14 @@ int QMakeVfs::idForFileName(const QString &fn, VfsFlags flags)
             return id;
     }
 #endif
-#ifdef PROPARSER_THREAD_SAFE
-    QMutexLocker locker(&s_mutex);
+#ifdef PROEVALUATOR_THREAD_SAFE
+    {
+        QReadLocker locker(&s_lock);
+        auto it = s_fileIdMap.constFind(fn);
+        if (it != s_fileIdMap.constEnd())
+            return *it;
+    }
+    QWriteLocker locker(&s_lock);
 #endif
     if (!(flags & VfsAccessedOnly)) {
         int &id = s_fileIdMap[fn];
@@ -95,7 +101,7 @@ QString QMakeVfs::fileNameForId(int id)
 {
 #ifdef PROEVALUATOR_DUAL_VFS
     {
-# ifdef PROPARSER_THREAD_SAFE
+# ifdef PROEVALUATOR_THREAD_SAFE
         QMutexLocker locker(&m_vmutex);
 # endif
         const QString &fn = m_virtualIdFileMap.value(id);
@@ -103,8 +109,8 @@ QString QMakeVfs::fileNameForId(int id)
             return fn;
     }
 #endif
-#ifdef PROPARSER_THREAD_SAFE
-    QMutexLocker locker(&s_mutex);
+#ifdef PROEVALUATOR_THREAD_SAFE
+    QReadLocker locker(&s_lock);
 #endif
     return s_idFileMap.value(id);
 }
@@ -162,21 +168,42 @@ bool QMakeVfs::writeFile(int id, QIODevice::OpenMode mode, VfsFlags flags,
 #endif
 }
 
+#ifndef PROEVALUATOR_FULL
+// Records whether a real file exists, unless virtual contents were
+// written for it in the meantime. The file system is accessed without
+// holding m_mutex, so concurrent evaluators do not wait on each other's I/O.
+void QMakeVfs::cacheFileState(int id, bool exists)
+{
+# ifdef PROEVALUATOR_THREAD_SAFE
+    QMutexLocker locker(&m_mutex);
+# endif
+    const QString &state = exists ? m_magicExisting : m_magicMissing;
+    auto it = m_files.find(id);
+    if (it == m_files.end())
+        m_files.insert(id, state);
+    else if (it->constData() == m_magicMissing.constData()
+             || it->constData() == m_magicExisting.constData())
+        *it = state;
+}
+#endif
+
 QMakeVfs::ReadResult QMakeVfs::readFile(int id, QString *contents, QString *errStr)
 {
 #ifndef PROEVALUATOR_FULL
+    {
 # ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&m_mutex);
+        QMutexLocker locker(&m_mutex);
 # endif
-    auto it = m_files.constFind(id);
-    if (it != m_files.constEnd()) {
-        if (it->constData() == m_magicMissing.constData()) {
-            *errStr = fL1S("No such file or directory");
-            return ReadNotFound;
-        }
-        if (it->constData() != m_magicExisting.constData()) {
-            *contents = *it;
-            return ReadOk;
+        auto it = m_files.constFind(id);
+        if (it != m_files.constEnd()) {
+            if (it->constData() == m_magicMissing.constData()) {
+                *errStr = fL1S("No such file or directory");
+                return ReadNotFound;
+            }
+            if (it->constData() != m_magicExisting.constData()) {
+                *contents = *it;
+                return ReadOk;
+            }
         }
     }
 #endif
@@ -185,7 +212,7 @@ QMakeVfs::ReadResult QMakeVfs::readFile(int id, QString *contents, QString *errS
     if (!file.open(QIODevice::ReadOnly)) {
         if (!file.exists()) {
 #ifndef PROEVALUATOR_FULL
-            m_files[id] = m_magicMissing;
+            cacheFileState(id, false);
 #endif
             *errStr = fL1S("No such file or directory");
             return ReadNotFound;
@@ -194,7 +221,7 @@ QMakeVfs::ReadResult QMakeVfs::readFile(int id, QString *contents, QString *errS
         return ReadOtherError;
     }
 #ifndef PROEVALUATOR_FULL
-    m_files[id] = m_magicExisting;
+    cacheFileState(id, true);
 #endif
 
     QByteArray bcont = file.readAll();
@@ -210,19 +237,21 @@ QMakeVfs::ReadResult QMakeVfs::readFile(int id, QString *contents, QString *errS
 bool QMakeVfs::exists(const QString &fn, VfsFlags flags)
 {
 #ifndef PROEVALUATOR_FULL
+    int id = idForFileName(fn, flags);
+    {
 # ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&m_mutex);
+        QMutexLocker locker(&m_mutex);
 # endif
-    int id = idForFileName(fn, flags);
-    auto it = m_files.constFind(id);
-    if (it != m_files.constEnd())
-        return it->constData() != m_magicMissing.constData();
+        auto it = m_files.constFind(id);
+        if (it != m_files.constEnd())
+            return it->constData() != m_magicMissing.constData();
+    }
 #else
     Q_UNUSED(flags);
 #endif
     bool ex = IoUtils::fileType(fn) == IoUtils::FileIsRegular;
 #ifndef PROEVALUATOR_FULL
-    m_files[id] = ex ? m_magicExisting : m_magicMissing;
+    cacheFileState(id, ex);
 #endif
     return ex;
 }
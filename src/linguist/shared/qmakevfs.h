@@ -11,6 +11,7 @@
 #include <qstring.h>
 #ifdef PROEVALUATOR_THREAD_SAFE
 # include <qmutex.h>
+# include <qreadwritelock.h>
 #endif
 
 #ifdef PROEVALUATOR_DUAL_VFS
@@ -64,8 +65,14 @@ public:
 #endif
 
 private:
+#ifndef PROEVALUATOR_FULL
+    void cacheFileState(int id, bool exists);
+#endif
+
 #ifdef PROEVALUATOR_THREAD_SAFE
-    static QMutex s_mutex;
+    // Ids are looked up for every include and exists() call, but they are
+    // only assigned once per file, so lookups take a shared lock.
+    static QReadWriteLock s_lock;
 #endif
     static int s_refCount;
     static QAtomicInt s_fileIdCounter;
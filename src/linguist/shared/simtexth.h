@@ -51,6 +51,22 @@ struct CoMatrix
     };
 };
 
+/**
+ * A candidate string whose CoMatrix is computed once, so that it can be
+ * scored against many strings, for example when the same set of messages
+ * is searched for every source text that is looked at.
+ * \sa StringSimilarityMatcher
+ */
+struct SimilarityCandidate
+{
+    SimilarityCandidate() = default;
+    explicit SimilarityCandidate(const QString &str);
+
+    CoMatrix matrix;
+    int length = 0;
+    int worth = 0;
+};
+
 /**
  * This class is more efficient for searching through a large array of candidate strings, since we only
  * have to construct the CoMatrix for the \a stringToMatch once,
@@ -61,10 +77,14 @@ class StringSimilarityMatcher {
 public:
     StringSimilarityMatcher(const QString &stringToMatch);
     int getSimilarityScore(const QString &strCandidate);
+    int getSimilarityScore(const SimilarityCandidate &candidate) const;
+    void getSimilarityScores(const SimilarityCandidate *candidates, qsizetype count,
+                             int *scores) const;
 
 private:
     CoMatrix m_cm;
     int m_length;
+    int m_worth;
 };
 
 /**
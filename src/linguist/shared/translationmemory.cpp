@@ -0,0 +1,304 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "translationmemory.h"
+#include "translator.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QSet>
+
+#include <algorithm>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+const quint32 Magic = 0x5174544d; // "QtTM"
+const quint32 Version = 1;
+const int MatrixSize = int(sizeof(CoMatrix::b));
+// The magic and the version
+const qint64 HeaderSize = 2 * qint64(sizeof(quint32));
+
+struct Record
+{
+    QString language;
+    QString source;
+    QString translation;
+    QString context;
+    QString comment;
+};
+
+QString tr(const char *text)
+{
+    return QCoreApplication::translate("TranslationMemoryDatabase", text);
+}
+
+void prepareStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+}
+
+// Reads the record at \a offset, which has to end before \a end.
+bool readRecord(QFile &file, quint64 offset, quint64 end, Record *record)
+{
+    if (offset >= end || !file.seek(qint64(offset)))
+        return false;
+    QDataStream stream(&file);
+    prepareStream(stream);
+    stream >> record->source >> record->translation >> record->context >> record->comment;
+    return stream.status() == QDataStream::Ok && quint64(file.pos()) <= end;
+}
+
+} // namespace
+
+/*
+  Opens the translation memory \a fileName and reads its index. Returns
+  false and sets \a errorString if the file cannot be read.
+*/
+bool TranslationMemoryDatabase::open(const QString &fileName, QString *errorString)
+{
+    close();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *errorString = tr("Cannot open %1: %2").arg(fileName, file.errorString());
+        return false;
+    }
+    QDataStream stream(&file);
+    prepareStream(stream);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    const qint64 indexEnd = file.size() - qint64(sizeof(quint64));
+    if (magic != Magic || version != Version || indexEnd < HeaderSize) {
+        *errorString = tr("%1 is not a translation memory.").arg(fileName);
+        return false;
+    }
+
+    // The records have to lie between the header and the index, and the
+    // index has to end where the offset of the index starts.
+    const auto corrupt = [&] {
+        *errorString = tr("%1 is corrupt.").arg(fileName);
+        m_languages.clear();
+        m_entries.clear();
+        return false;
+    };
+    quint64 indexOffset = 0;
+    file.seek(indexEnd);
+    stream >> indexOffset;
+    if (indexOffset < quint64(HeaderSize) || indexOffset > quint64(indexEnd)
+        || !file.seek(qint64(indexOffset))) {
+        return corrupt();
+    }
+
+    quint64 count = 0;
+    stream >> m_languages >> count;
+    m_entries.reserve(qsizetype(std::min<quint64>(count, file.size() / MatrixSize)));
+    for (quint64 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        Entry entry;
+        qint32 length = 0;
+        qint32 worth = 0;
+        stream.readRawData(reinterpret_cast<char *>(entry.matrix.matrix.b), MatrixSize);
+        stream >> length >> worth >> entry.language >> entry.offset;
+        if (stream.status() != QDataStream::Ok)
+            break;
+        if (entry.offset < quint64(HeaderSize) || entry.offset >= indexOffset
+            || entry.language >= m_languages.size()
+            || (!m_entries.isEmpty() && worth < m_entries.constLast().matrix.worth)) {
+            return corrupt();
+        }
+        entry.matrix.length = length;
+        entry.matrix.worth = worth;
+        m_entries.append(entry);
+    }
+    if (stream.status() != QDataStream::Ok || file.pos() != indexEnd)
+        return corrupt();
+
+    m_fileName = fileName;
+    m_indexOffset = indexOffset;
+    m_fileSize = file.size();
+    m_lastModified = QFileInfo(file).lastModified();
+    return true;
+}
+
+void TranslationMemoryDatabase::close()
+{
+    m_fileName.clear();
+    m_languages.clear();
+    m_entries.clear();
+    m_indexOffset = 0;
+    m_fileSize = 0;
+    m_lastModified = {};
+}
+
+/*
+  Returns up to \a maxCandidates stored translations into \a languageCode
+  whose source texts are similar to \a text, the most similar first. An
+  empty \a languageCode matches all languages.
+
+  The score of two texts cannot exceed (min + 1) * 1024 / (max + 1), where
+  min and max are the smaller and the larger worth of their CoMatrix, so
+  only the part of the index whose worth is in range can reach the
+  threshold and needs to be scored.
+*/
+CandidateList TranslationMemoryDatabase::lookup(const QString &text, const QString &languageCode,
+                                                int maxCandidates) const
+{
+    CandidateList candidates;
+    if (m_entries.isEmpty() || text.isEmpty() || maxCandidates <= 0)
+        return candidates;
+
+    int language = -1;
+    if (!languageCode.isEmpty()) {
+        language = int(m_languages.indexOf(languageCode));
+        if (language < 0)
+            return candidates;
+    }
+
+    const StringSimilarityMatcher matcher(text);
+    const int worth = SimilarityCandidate(text).worth;
+    const int minWorth = (textSimilarityThreshold * (worth + 1) + 1023) / 1024 - 1;
+    const int maxWorth = ((worth + 1) << 10) / textSimilarityThreshold - 1;
+    const auto byWorth = [](const Entry &entry, int worth) { return entry.matrix.worth < worth; };
+    const auto begin = std::lower_bound(m_entries.cbegin(), m_entries.cend(), minWorth, byWorth);
+    const auto end = std::lower_bound(begin, m_entries.cend(), maxWorth + 1, byWorth);
+
+    QList<std::pair<int, qsizetype>> scored;
+    for (auto it = begin; it != end; ++it) {
+        if (language >= 0 && it->language != language)
+            continue;
+        const int score = matcher.getSimilarityScore(it->matrix);
+        if (score >= textSimilarityThreshold)
+            scored.emplace_back(score, it - m_entries.cbegin());
+    }
+    std::stable_sort(scored.begin(), scored.end(),
+                     [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    // The offsets of the index are only valid for the file that was opened,
+    // not for one that has been rewritten since.
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() != m_fileSize
+        || QFileInfo(file).lastModified() != m_lastModified) {
+        return candidates;
+    }
+    for (const auto &[score, index] : std::as_const(scored)) {
+        Record record;
+        if (!readRecord(file, m_entries.at(index).offset, m_indexOffset, &record))
+            break;
+        const Candidate cand(record.context, record.source, record.comment, record.translation);
+        if (!candidates.contains(cand)) {
+            candidates.append(cand);
+            if (candidates.size() == maxCandidates)
+                break;
+        }
+    }
+    return candidates;
+}
+
+/*
+  Adds the finished translations of \a translators to the translation
+  memory \a fileName, creating it if it does not exist yet. Translations
+  that are stored already are not added again. The number of added
+  translations is stored in \a added.
+*/
+bool TranslationMemoryDatabase::update(const QString &fileName,
+                                       const QList<const Translator *> &translators,
+                                       qsizetype *added, QString *errorString)
+{
+    QList<Record> records;
+    QSet<QStringList> known;
+    const auto addRecord = [&](Record &&record) {
+        QStringList key { record.language, record.source, record.translation, record.context,
+                          record.comment };
+        if (!known.contains(key)) {
+            known.insert(std::move(key));
+            records.append(std::move(record));
+        }
+    };
+
+    if (QFile::exists(fileName)) {
+        TranslationMemoryDatabase existing;
+        if (!existing.open(fileName, errorString))
+            return false;
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            *errorString = tr("Cannot open %1: %2").arg(fileName, file.errorString());
+            return false;
+        }
+        for (const Entry &entry : std::as_const(existing.m_entries)) {
+            Record record;
+            if (!readRecord(file, entry.offset, existing.m_indexOffset, &record)) {
+                *errorString = tr("%1 is corrupt.").arg(fileName);
+                return false;
+            }
+            record.language = existing.m_languages.value(entry.language);
+            addRecord(std::move(record));
+        }
+    }
+
+    const qsizetype existingCount = records.size();
+    for (const Translator *translator : translators) {
+        for (const TranslatorMessage &msg : translator->messages()) {
+            if (msg.type() == TranslatorMessage::Unfinished || msg.sourceText().isEmpty()
+                || msg.translation().isEmpty()) {
+                continue;
+            }
+            addRecord({ translator->languageCode(), msg.sourceText(), msg.translation(),
+                        msg.context(), msg.comment() });
+        }
+    }
+    if (added)
+        *added = records.size() - existingCount;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *errorString = tr("Cannot create %1: %2").arg(fileName, file.errorString());
+        return false;
+    }
+    QDataStream stream(&file);
+    prepareStream(stream);
+    stream << Magic << Version;
+
+    QStringList languages;
+    QList<Entry> entries;
+    entries.reserve(records.size());
+    for (const Record &record : std::as_const(records)) {
+        Entry entry;
+        entry.matrix = SimilarityCandidate(record.source);
+        qsizetype language = languages.indexOf(record.language);
+        if (language < 0) {
+            language = languages.size();
+            languages.append(record.language);
+        }
+        entry.language = quint16(language);
+        entry.offset = quint64(file.pos());
+        stream << record.source << record.translation << record.context << record.comment;
+        entries.append(entry);
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.matrix.worth < b.matrix.worth;
+    });
+
+    const quint64 indexOffset = quint64(file.pos());
+    stream << languages << quint64(entries.size());
+    for (const Entry &entry : std::as_const(entries)) {
+        stream.writeRawData(reinterpret_cast<const char *>(entry.matrix.matrix.b), MatrixSize);
+        stream << qint32(entry.matrix.length) << qint32(entry.matrix.worth) << entry.language
+               << entry.offset;
+    }
+    stream << indexOffset;
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        *errorString = tr("Cannot write %1: %2").arg(fileName, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef TRANSLATIONMEMORY_H
+#define TRANSLATIONMEMORY_H
+
+#include "simtexth.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+QT_BEGIN_NAMESPACE
+
+class Translator;
+
+/*
+  An on-disk store of finished translations, collected from any number of
+  translation files, that can be searched for source texts similar to a
+  given one.
+
+  The file holds the messages followed by an index with the CoMatrix of
+  every source text, sorted by its worth. Only the index is read when the
+  file is opened; the messages are read from the file when they match.
+*/
+class TranslationMemoryDatabase
+{
+public:
+    bool open(const QString &fileName, QString *errorString);
+    void close();
+    bool isOpen() const { return !m_fileName.isEmpty(); }
+    QString fileName() const { return m_fileName; }
+    qsizetype size() const { return m_entries.size(); }
+
+    // Safe to call from several threads at once.
+    CandidateList lookup(const QString &text, const QString &languageCode,
+                         int maxCandidates) const;
+
+    static bool update(const QString &fileName, const QList<const Translator *> &translators,
+                       qsizetype *added, QString *errorString);
+
+private:
+    struct Entry
+    {
+        SimilarityCandidate matrix;
+        quint16 language = 0;
+        quint64 offset = 0;
+    };
+
+    QString m_fileName;
+    QStringList m_languages;
+    QList<Entry> m_entries;
+    quint64 m_indexOffset = 0;
+    qint64 m_fileSize = 0;
+    QDateTime m_lastModified;
+};
+
+QT_END_NAMESPACE
+
+#endif // TRANSLATIONMEMORY_H
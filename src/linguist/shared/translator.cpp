@@ -19,6 +19,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QLocale>
+#include <QtCore/QSaveFile>
 #include <QtCore/QTextStream>
 
 #include <private/qtranslator_p.h>
@@ -27,7 +28,8 @@ QT_BEGIN_NAMESPACE
 
 Translator::Translator() :
     m_locationsType(AbsoluteLocations),
-    m_indexOk(true)
+    m_indexOk(true),
+    m_indexAmbiguous(false)
 {
 }
 
@@ -51,11 +53,16 @@ QList<Translator::FileFormat> &Translator::registeredFileFormats()
 
 void Translator::addIndex(int idx, const TranslatorMessage &msg) const
 {
-
+    const qsizetype keyCount = m_msgIdx.size();
     m_msgIdx[TMMKey(msg)] = idx;
-    if (!msg.id().isEmpty())
+    if (m_msgIdx.size() == keyCount)
+        m_indexAmbiguous = true;
+    if (!msg.id().isEmpty()) {
+        const qsizetype idCount = m_idMsgIdx.size();
         m_idMsgIdx[msg.id()] = idx;
-
+        if (m_idMsgIdx.size() == idCount)
+            m_indexAmbiguous = true;
+    }
 }
 
 void Translator::delIndex(int idx) const
@@ -72,6 +79,7 @@ void Translator::ensureIndexed() const
 {
     if (!m_indexOk) {
         m_indexOk = true;
+        m_indexAmbiguous = false;
         m_idMsgIdx.clear();
         m_msgIdx.clear();
         for (int i = 0; i < m_messages.size(); i++)
@@ -79,6 +87,42 @@ void Translator::ensureIndexed() const
     }
 }
 
+/*
+  Removes the messages for which \a pred returns true. Unless the index is
+  stale anyway, or ambiguous because of duplicate keys, it is updated in
+  place instead of being rebuilt on the next lookup.
+*/
+template <typename Predicate>
+void Translator::removeMessagesIf(Predicate pred)
+{
+    if (!m_indexOk || m_indexAmbiguous) {
+        m_messages.removeIf(pred);
+        m_indexOk = false;
+        return;
+    }
+
+    // The new position of every kept message.
+    QList<int> newIndex(m_messages.size(), -1);
+    int kept = 0;
+    for (int i = 0; i < m_messages.size(); ++i) {
+        if (pred(m_messages.at(i))) {
+            delIndex(i);
+            continue;
+        }
+        if (kept != i)
+            m_messages[kept] = std::move(m_messages[i]);
+        newIndex[i] = kept++;
+    }
+    if (kept == m_messages.size())
+        return;
+    m_messages.resize(kept);
+
+    for (int &i : m_msgIdx)
+        i = newIndex.at(i);
+    for (int &i : m_idMsgIdx)
+        i = newIndex.at(i);
+}
+
 void Translator::replaceSorted(const TranslatorMessage &msg)
 {
     int index = find(msg);
@@ -148,12 +192,23 @@ void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
 
 void Translator::insert(int idx, const TranslatorMessage &msg)
 {
-    if (m_indexOk) {
-        if (idx == m_messages.size())
-            addIndex(idx, msg);
-        else
+    if (m_indexOk && idx != m_messages.size()) {
+        // With a duplicate key, a rebuilt index would point to the last
+        // message having it, which is not necessarily the inserted one.
+        if (m_indexAmbiguous || m_msgIdx.contains(TMMKey(msg))
+            || (!msg.id().isEmpty() && m_idMsgIdx.contains(msg.id()))) {
             m_indexOk = false;
+        } else {
+            for (int &i : m_msgIdx)
+                if (i >= idx)
+                    ++i;
+            for (int &i : m_idMsgIdx)
+                if (i >= idx)
+                    ++i;
+        }
     }
+    if (m_indexOk)
+        addIndex(idx, msg);
     m_messages.insert(idx, msg);
 }
 
@@ -162,6 +217,13 @@ void Translator::append(const TranslatorMessage &msg)
     insert(m_messages.size(), msg);
 }
 
+void Translator::reserve(int size)
+{
+    m_messages.reserve(size);
+    if (m_indexOk)
+        m_msgIdx.reserve(size);
+}
+
 void Translator::appendSorted(const TranslatorMessage &msg)
 {
     int msgLine = msg.lineNumber();
@@ -291,28 +353,48 @@ bool Translator::load(const QString &filename, ConversionData &cd, const QString
 }
 
 
+/*
+  Named files are written through a QSaveFile, so that an existing file is
+  only replaced once the new contents have been written completely. Where
+  no temporary file can be created next to it, as in a read-only directory,
+  the file is written directly like before.
+*/
 bool Translator::save(const QString &filename, ConversionData &cd, const QString &format) const
 {
-    QFile file;
     if (filename.isEmpty() || filename == QLatin1String("-")) {
 #ifdef Q_OS_WIN
         // QFile is broken for text files
         ::_setmode(1, _O_BINARY);
 #endif
+        QFile file;
         if (!file.open(stdout, QIODevice::WriteOnly)) {
             cd.appendError(QString::fromLatin1("Cannot open stdout!? (%1)")
                 .arg(file.errorString()));
             return false;
         }
-    } else {
-        file.setFileName(filename);
-        if (!file.open(QIODevice::WriteOnly)) {
-            cd.appendError(QString::fromLatin1("Cannot create %1: %2")
-                .arg(filename, file.errorString()));
-            return false;
-        }
+        return save(file, filename, cd, format);
     }
 
+    QSaveFile file(filename);
+    file.setDirectWriteFallback(true);
+    if (!file.open(QIODevice::WriteOnly)) {
+        cd.appendError(QString::fromLatin1("Cannot create %1: %2")
+            .arg(filename, file.errorString()));
+        return false;
+    }
+    if (!save(file, filename, cd, format))
+        return false;
+    if (!file.commit()) {
+        cd.appendError(QString::fromLatin1("Cannot write %1: %2")
+            .arg(filename, file.errorString()));
+        return false;
+    }
+    return true;
+}
+
+bool Translator::save(QIODevice &file, const QString &filename, ConversionData &cd,
+                      const QString &format) const
+{
     QString fmt = guessFormat(filename, format);
     cd.m_targetDir = QFileInfo(filename).absoluteDir();
 
@@ -405,32 +487,24 @@ int Translator::find(const QString &context,
 
 void Translator::stripObsoleteMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->type() == TranslatorMessage::Obsolete || it->type() == TranslatorMessage::Vanished)
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &msg) {
+        return msg.type() == TranslatorMessage::Obsolete
+                || msg.type() == TranslatorMessage::Vanished;
+    });
 }
 
 void Translator::stripFinishedMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->type() == TranslatorMessage::Finished)
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &msg) {
+        return msg.type() == TranslatorMessage::Finished;
+    });
 }
 
 void Translator::stripUntranslatedMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (!it->isTranslated())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &msg) {
+        return !msg.isTranslated();
+    });
 }
 
 bool Translator::translationsExist() const
@@ -444,34 +518,24 @@ bool Translator::translationsExist() const
 
 void Translator::stripEmptyContexts()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->sourceText() == QLatin1String(ContextComment))
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &msg) {
+        return msg.sourceText() == QLatin1String(ContextComment);
+    });
 }
 
 void Translator::stripNonPluralForms()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (!it->isPlural())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &msg) {
+        return !msg.isPlural();
+    });
 }
 
 void Translator::stripIdenticalSourceTranslations()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); ) {
+    removeMessagesIf([](const TranslatorMessage &msg) {
         // we need to have just one translation, and it be equal to the source
-        if (it->translations().size() == 1 && it->translation() == it->sourceText())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    }
-    m_indexOk = false;
+        return msg.translations().size() == 1 && msg.translation() == msg.sourceText();
+    });
 }
 
 void Translator::dropTranslations()
@@ -503,11 +567,17 @@ void Translator::dropUiLines()
     }
 }
 
+/*
+    Refers to a message of a Translator by its index, and carries the hash
+    of the part of the message that is compared, so that it is computed
+    once per message. The strings are only compared when the hashes are
+    equal.
+*/
 class TranslatorMessagePtrBase
 {
 public:
-    explicit TranslatorMessagePtrBase(const Translator *tor, int messageIndex)
-        : tor(tor), messageIndex(messageIndex)
+    explicit TranslatorMessagePtrBase(const Translator *tor, int messageIndex, size_t hash)
+        : tor(tor), messageIndex(messageIndex), hash(hash)
     {
     }
 
@@ -517,46 +587,60 @@ public:
     }
 
     const Translator *tor;
-    const int messageIndex;
+    int messageIndex;
+    size_t hash;
 };
 
 class TranslatorMessageIdPtr : public TranslatorMessagePtrBase
 {
 public:
-    using TranslatorMessagePtrBase::TranslatorMessagePtrBase;
+    TranslatorMessageIdPtr(const Translator *tor, int messageIndex)
+        : TranslatorMessagePtrBase(tor, messageIndex, qHash(tor->message(messageIndex).id()))
+    {
+    }
 };
 
 Q_DECLARE_TYPEINFO(TranslatorMessageIdPtr, Q_RELOCATABLE_TYPE);
 
 inline size_t qHash(TranslatorMessageIdPtr tmp)
 {
-    return qHash(tmp->id());
+    return tmp.hash;
 }
 
 inline bool operator==(TranslatorMessageIdPtr tmp1, TranslatorMessageIdPtr tmp2)
 {
-    return tmp1->id() == tmp2->id();
+    return tmp1.hash == tmp2.hash && tmp1->id() == tmp2->id();
+}
+
+static size_t contentHash(const TranslatorMessage &msg)
+{
+    size_t hash = qHash(msg.context()) ^ qHash(msg.sourceText());
+    if (!msg.sourceText().isEmpty())
+        // Special treatment for context comments (empty source).
+        hash ^= qHash(msg.comment());
+    return hash;
 }
 
 class TranslatorMessageContentPtr : public TranslatorMessagePtrBase
 {
 public:
-    using TranslatorMessagePtrBase::TranslatorMessagePtrBase;
+    TranslatorMessageContentPtr(const Translator *tor, int messageIndex, size_t hash)
+        : TranslatorMessagePtrBase(tor, messageIndex, hash)
+    {
+    }
 };
 
 Q_DECLARE_TYPEINFO(TranslatorMessageContentPtr, Q_RELOCATABLE_TYPE);
 
 inline size_t qHash(TranslatorMessageContentPtr tmp)
 {
-    size_t hash = qHash(tmp->context()) ^ qHash(tmp->sourceText());
-    if (!tmp->sourceText().isEmpty())
-        // Special treatment for context comments (empty source).
-        hash ^= qHash(tmp->comment());
-    return hash;
+    return tmp.hash;
 }
 
 inline bool operator==(TranslatorMessageContentPtr tmp1, TranslatorMessageContentPtr tmp2)
 {
+    if (tmp1.hash != tmp2.hash)
+        return false;
     if (tmp1->context() != tmp2->context() || tmp1->sourceText() != tmp2->sourceText())
         return false;
     // Special treatment for context comments (empty source).
@@ -565,13 +649,21 @@ inline bool operator==(TranslatorMessageContentPtr tmp1, TranslatorMessageConten
     return tmp1->comment() == tmp2->comment();
 }
 
+/*
+    Drops the duplicates of earlier messages in one pass. The messages that
+    are kept are moved to the front of the list, so that the indexes in the
+    sets always refer to their final position.
+*/
 Translator::Duplicates Translator::resolveDuplicates()
 {
     Duplicates dups;
     QSet<TranslatorMessageIdPtr> idRefs;
     QSet<TranslatorMessageContentPtr> contentRefs;
-    for (int i = 0; i < m_messages.size();) {
+    contentRefs.reserve(m_messages.size());
+    int kept = 0;
+    for (int i = 0; i < m_messages.size(); ++i) {
         const TranslatorMessage &msg = m_messages.at(i);
+        const size_t hash = contentHash(msg);
         TranslatorMessage *omsg;
         int oi;
         DuplicateEntries *pDup;
@@ -585,7 +677,7 @@ Translator::Duplicates Translator::resolveDuplicates()
             }
         }
         {
-            const auto it = contentRefs.constFind(TranslatorMessageContentPtr(this, i));
+            const auto it = contentRefs.constFind(TranslatorMessageContentPtr(this, i, hash));
             if (it != contentRefs.constEnd()) {
                 oi = it->messageIndex;
                 omsg = &m_messages[oi];
@@ -600,56 +692,67 @@ Translator::Duplicates Translator::resolveDuplicates()
                 // This is really a content dupe, but with two distinct IDs.
             }
         }
-        if (!msg.id().isEmpty())
-            idRefs.insert(TranslatorMessageIdPtr(this, i));
-        contentRefs.insert(TranslatorMessageContentPtr(this, i));
-        ++i;
+        if (kept != i)
+            m_messages[kept] = std::move(m_messages[i]);
+        if (!m_messages.at(kept).id().isEmpty())
+            idRefs.insert(TranslatorMessageIdPtr(this, kept));
+        contentRefs.insert(TranslatorMessageContentPtr(this, kept, hash));
+        ++kept;
         continue;
       gotDupe:
         (*pDup)[oi].append(msg.tsLineNumber());
         if (!omsg->isTranslated() && msg.isTranslated())
             omsg->setTranslations(msg.translations());
+    }
+    if (kept != m_messages.size()) {
         m_indexOk = false;
-        m_messages.removeAt(i);
+        m_messages.resize(kept);
     }
     return dups;
 }
 
 void Translator::reportDuplicates(const Duplicates &dupes,
                                   const QString &fileName, bool verbose)
+{
+    reportDuplicates(dupes, fileName, verbose, std::cerr);
+}
+
+void Translator::reportDuplicates(const Duplicates &dupes, const QString &fileName,
+                                  bool verbose, std::ostream &out)
 {
     if (!dupes.byId.isEmpty() || !dupes.byContents.isEmpty()) {
-        std::cerr << "Warning: dropping duplicate messages in '" << qPrintable(fileName);
+        out << "Warning: dropping duplicate messages in '" << qPrintable(fileName);
         if (!verbose) {
-            std::cerr << "'\n(try -verbose for more info).\n";
+            out << "'\n(try -verbose for more info).\n";
         } else {
-            std::cerr << "':\n";
+            out << "':\n";
             for (auto it = dupes.byId.begin(); it != dupes.byId.end(); ++it) {
                 const TranslatorMessage &msg = message(it.key());
-                std::cerr << "\n* ID: " << qPrintable(msg.id()) << std::endl;
-                reportDuplicatesLines(msg, it.value());
+                out << "\n* ID: " << qPrintable(msg.id()) << std::endl;
+                reportDuplicatesLines(msg, it.value(), out);
             }
             for (auto it = dupes.byContents.begin(); it != dupes.byContents.end(); ++it) {
                 const TranslatorMessage &msg = message(it.key());
-                std::cerr << "\n* Context: " << qPrintable(msg.context())
-                          << "\n* Source: " << qPrintable(msg.sourceText()) << std::endl;
+                out << "\n* Context: " << qPrintable(msg.context())
+                    << "\n* Source: " << qPrintable(msg.sourceText()) << std::endl;
                 if (!msg.comment().isEmpty())
-                    std::cerr << "* Comment: " << qPrintable(msg.comment()) << std::endl;
-                reportDuplicatesLines(msg, it.value());
+                    out << "* Comment: " << qPrintable(msg.comment()) << std::endl;
+                reportDuplicatesLines(msg, it.value(), out);
             }
-            std::cerr << std::endl;
+            out << std::endl;
         }
     }
 }
 
 void Translator::reportDuplicatesLines(const TranslatorMessage &msg,
-                                       const DuplicateEntries::value_type &dups) const
+                                       const DuplicateEntries::value_type &dups,
+                                       std::ostream &out) const
 {
     if (msg.tsLineNumber() >= 0) {
-        std::cerr << "* Line in .ts file: " << msg.tsLineNumber() << std::endl;
+        out << "* Line in .ts file: " << msg.tsLineNumber() << std::endl;
         for (int tsLineNumber : dups) {
             if (tsLineNumber >= 0)
-                std::cerr << "* Duplicate at line: " << tsLineNumber << std::endl;
+                out << "* Duplicate at line: " << tsLineNumber << std::endl;
         }
     }
 }
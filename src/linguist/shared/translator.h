@@ -17,6 +17,8 @@
 #include <QSet>
 #include <QVector>
 
+#include <iosfwd>
+
 QT_BEGIN_NAMESPACE
 
 class QIODevice;
@@ -31,6 +33,7 @@ public:
         m_sortContexts(false),
         m_noUiLines(false),
         m_idBased(false),
+        m_qmPerfectHash(false),
         m_saveMode(SaveEverything)
     {}
 
@@ -67,6 +70,7 @@ public:
     bool m_sortContexts;
     bool m_noUiLines;
     bool m_idBased;
+    bool m_qmPerfectHash; // QM specific
     TranslatorSaveMode m_saveMode;
     QStringList m_rootDirs;
 };
@@ -98,11 +102,17 @@ public:
         const QString &comment, const TranslatorMessage::References &refs) const;
 
     int find(const QString &context) const;
+    // Builds the lookup index used by find(), so that a translator that is
+    // no longer modified can be searched from several threads.
+    void ensureIndexed() const;
 
     void replaceSorted(const TranslatorMessage &msg);
     void extend(const TranslatorMessage &msg, ConversionData &cd); // Only for single-location messages
     void append(const TranslatorMessage &msg);
     void appendSorted(const TranslatorMessage &msg);
+    // Makes room for \a size messages, for loaders that know roughly
+    // how many messages a file has.
+    void reserve(int size);
 
     void stripObsoleteMessages();
     void stripFinishedMessages();
@@ -122,8 +132,11 @@ public:
     };
     Duplicates resolveDuplicates();
     void reportDuplicates(const Duplicates &dupes, const QString &fileName, bool verbose);
+    void reportDuplicates(const Duplicates &dupes, const QString &fileName, bool verbose,
+                          std::ostream &out);
     void reportDuplicatesLines(const TranslatorMessage &msg,
-                               const DuplicateEntries::value_type &dups) const;
+                               const DuplicateEntries::value_type &dups,
+                               std::ostream &out) const;
 
     QString languageCode() const { return m_language; }
     QString sourceLanguageCode() const { return m_sourceLanguage; }
@@ -185,10 +198,13 @@ public:
     static constexpr QChar BinaryVariantSeparator{0x9c}; // unicode "STRING TERMINATOR"
 
 private:
+    bool save(QIODevice &file, const QString &filename, ConversionData &cd,
+              const QString &format) const;
     void insert(int idx, const TranslatorMessage &msg);
     void addIndex(int idx, const TranslatorMessage &msg) const;
     void delIndex(int idx) const;
-    void ensureIndexed() const;
+    template <typename Predicate>
+    void removeMessagesIf(Predicate pred);
 
     typedef QList<TranslatorMessage> TMM;       // int stores the sequence position.
 
@@ -210,6 +226,9 @@ private:
     ExtraData m_extra;
 
     mutable bool m_indexOk;
+    // Set when two messages share a key, so that some index updates
+    // cannot be done in place.
+    mutable bool m_indexAmbiguous;
     mutable QHash<QString, int> m_idMsgIdx;
     mutable QHash<TMMKey, int> m_msgIdx;
 };
@@ -7,6 +7,8 @@
 #include <QString>
 #include <QStringList>
 #include <QHash>
+#include <QSharedData>
+#include <QSharedDataPointer>
 
 
 QT_BEGIN_NAMESPACE
@@ -48,13 +50,15 @@ public:
 
     QString sourceText() const { return m_sourcetext; }
     void setSourceText(const QString &sourcetext) { m_sourcetext = sourcetext; }
-    QString oldSourceText() const { return m_oldsourcetext; }
-    void setOldSourceText(const QString &oldsourcetext) { m_oldsourcetext = oldsourcetext; }
+    QString oldSourceText() const { return m_rare ? m_rare->oldSourceText : QString(); }
+    void setOldSourceText(const QString &oldsourcetext)
+        { if (m_rare || !oldsourcetext.isEmpty()) rare().oldSourceText = oldsourcetext; }
 
     QString comment() const { return m_comment; }
     void setComment(const QString &comment) { m_comment = comment; }
-    QString oldComment() const { return m_oldcomment; }
-    void setOldComment(const QString &oldcomment) { m_oldcomment = oldcomment; }
+    QString oldComment() const { return m_rare ? m_rare->oldComment : QString(); }
+    void setOldComment(const QString &oldcomment)
+        { if (m_rare || !oldcomment.isEmpty()) rare().oldComment = oldcomment; }
 
     QStringList translations() const { return m_translations; }
     void setTranslations(const QStringList &translations) { m_translations = translations; }
@@ -80,16 +84,20 @@ public:
     void addReference(const QString &fileName, int lineNumber);
     void addReference(const Reference &ref) { addReference(ref.fileName(), ref.lineNumber()); }
     void addReferenceUniq(const QString &fileName, int lineNumber);
-    References extraReferences() const { return m_extraRefs; }
+    References extraReferences() const { return m_rare ? m_rare->extraRefs : References(); }
     References allReferences() const;
-    QString userData() const { return m_userData; }
-    void setUserData(const QString &userData) { m_userData = userData; }
-    QString extraComment() const { return m_extraComment; }
-    void setExtraComment(const QString &extraComment) { m_extraComment = extraComment; }
-    QString translatorComment() const { return m_translatorComment; }
-    void setTranslatorComment(const QString &translatorComment) { m_translatorComment = translatorComment; }
-    QString warning() const {return m_warning;}
-    void setWarning(const QString &warning) {m_warning = warning;}
+    QString userData() const { return m_rare ? m_rare->userData : QString(); }
+    void setUserData(const QString &userData)
+        { if (m_rare || !userData.isEmpty()) rare().userData = userData; }
+    QString extraComment() const { return m_rare ? m_rare->extraComment : QString(); }
+    void setExtraComment(const QString &extraComment)
+        { if (m_rare || !extraComment.isEmpty()) rare().extraComment = extraComment; }
+    QString translatorComment() const { return m_rare ? m_rare->translatorComment : QString(); }
+    void setTranslatorComment(const QString &translatorComment)
+        { if (m_rare || !translatorComment.isEmpty()) rare().translatorComment = translatorComment; }
+    QString warning() const { return m_rare ? m_rare->warning : QString(); }
+    void setWarning(const QString &warning)
+        { if (m_rare || !warning.isEmpty()) rare().warning = warning; }
 
 
     bool isNull() const { return m_sourcetext.isNull() && m_lineNumber == -1 && m_translations.isEmpty(); }
@@ -104,8 +112,9 @@ public:
     QString extra(const QString &ba) const;
     void setExtra(const QString &ba, const QString &var);
     bool hasExtra(const QString &ba) const;
-    const ExtraData &extras() const { return m_extra; }
-    void setExtras(const ExtraData &extras) { m_extra = extras; }
+    const ExtraData &extras() const;
+    void setExtras(const ExtraData &extras)
+        { if (m_rare || !extras.isEmpty()) rare().extra = extras; }
     void unsetExtra(const QString &key);
 
     bool warningOnly() const { return m_warningOnly; }
@@ -114,22 +123,36 @@ public:
     void dump() const;
 
 private:
+    // The members that most messages leave empty. They are only allocated
+    // when one of them is set, and shared between copies of the message.
+    struct RareData : QSharedData
+    {
+        QString     oldSourceText;
+        QString     oldComment;
+        QString     userData;
+        ExtraData   extra; // PO flags, PO plurals
+        QString     extraComment;
+        QString     translatorComment;
+        QString     warning;
+        References  extraRefs;
+    };
+
+    RareData &rare()
+    {
+        if (!m_rare)
+            m_rare = new RareData;
+        return *m_rare;
+    }
+
     QString     m_id;
     QString     m_context;
     QString     m_sourcetext;
-    QString     m_oldsourcetext;
     QString     m_comment;
-    QString     m_oldcomment;
-    QString     m_userData;
-    ExtraData   m_extra; // PO flags, PO plurals
-    QString     m_extraComment;
-    QString     m_translatorComment;
-    QString     m_warning;
     QStringList m_translations;
     QString     m_fileName;
+    QSharedDataPointer<RareData> m_rare;
     int         m_lineNumber;
     int         m_tsLineNumber = -1;
-    References  m_extraRefs;
     bool        m_warningOnly = false;
 
     Type m_type;
@@ -5,7 +5,9 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSet>
 #include <QtCore/QTextStream>
 
 #include <QtCore/QXmlStreamReader>
@@ -28,6 +30,9 @@ public:
     TSReader(QIODevice &dev, ConversionData &cd)
       : QXmlStreamReader(&dev), m_cd(cd)
     {}
+    TSReader(const QByteArray &data, ConversionData &cd)
+      : QXmlStreamReader(data), m_cd(cd)
+    {}
 
     // the "real thing"
     bool read(Translator &translator);
@@ -40,7 +45,7 @@ private:
 
     bool isWhiteSpace() const
     {
-        return isCharacters() && text().toString().trimmed().isEmpty();
+        return isCharacters() && text().trimmed().isEmpty();
     }
 
     // needed to expand <byte ... />
@@ -208,6 +213,7 @@ bool TSReader::read(Translator &translator)
             //qDebug() << "TS " << attributes();
             QHash<QString, int> currentLine;
             QString currentFile;
+            QSet<QString> fileNames;
             bool maybeRelative = false, maybeAbsolute = false;
 
             QXmlStreamAttributes atts = attributes();
@@ -221,8 +227,7 @@ bool TSReader::read(Translator &translator)
                     break;
                 } else if (isWhiteSpace()) {
                     // ignore these, just whitespace
-                } else if (isStartElement()
-                        && name().toString().startsWith(strextrans)) {
+                } else if (isStartElement() && name().startsWith(strextrans)) {
                     // <extra-...>
                     QString tag = name().toString();
                     translator.setExtra(tag.mid(6), readContents());
@@ -307,11 +312,19 @@ bool TSReader::read(Translator &translator)
                                     // <location/>
                                     maybeAbsolute = true;
                                     QXmlStreamAttributes atts = attributes();
-                                    QString fileName = atts.value(strfilename).toString();
-                                    if (fileName.isEmpty()) {
+                                    const QStringView fileNameAttr = atts.value(strfilename);
+                                    QString fileName;
+                                    if (fileNameAttr.isEmpty()) {
                                         fileName = currentMsgFile;
                                         maybeRelative = true;
                                     } else {
+                                        // Share the name between all messages of the file.
+                                        if (fileNameAttr == currentMsgFile)
+                                            fileName = currentMsgFile;
+                                        else if (fileNameAttr == currentFile)
+                                            fileName = currentFile;
+                                        else
+                                            fileName = *fileNames.insert(fileNameAttr.toString());
                                         if (refs.isEmpty())
                                             currentFile = fileName;
                                         currentMsgFile = fileName;
@@ -368,7 +381,7 @@ bool TSReader::read(Translator &translator)
                                     }
                                     // </translation>
                                 } else if (isStartElement()
-                                        && name().toString().startsWith(strextrans)) {
+                                        && name().startsWith(strextrans)) {
                                     // <extra-...>
                                     QString tag = name().toString();
                                     msg.setExtra(tag.mid(6), readContents());
@@ -645,6 +658,25 @@ bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
 
 bool loadTS(Translator &translator, QIODevice &dev, ConversionData &cd)
 {
+    // Parse regular files straight from a memory mapping instead of
+    // copying them through the device in chunks.
+    if (auto file = qobject_cast<QFile *>(&dev); file && file->pos() == 0) {
+        const qint64 size = file->size();
+        if (size > 0) {
+            if (uchar *data = file->map(0, size)) {
+                bool ok;
+                {
+                    TSReader reader(QByteArray::fromRawData(reinterpret_cast<const char *>(data),
+                                                            qsizetype(size)),
+                                    cd);
+                    ok = reader.read(translator);
+                }
+                file->unmap(data);
+                return ok;
+            }
+        }
+    }
+
     TSReader reader(dev, cd);
     return reader.read(translator);
 }
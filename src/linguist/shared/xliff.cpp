@@ -4,7 +4,9 @@
 #include "translator.h"
 #include "xmlparser.h"
 
+#include <QtCore/QByteArrayMatcher>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStack>
@@ -380,6 +382,7 @@ private:
     XliffContext currentContext() const;
     bool hasContext(XliffContext ctx) const;
     bool finalizeMessage(bool isPlural);
+    const QString &intern(QStringView str);
 
 private:
     Translator &m_translator;
@@ -411,6 +414,9 @@ private:
     const QString m_URI;  // ...
     const QString m_URI12;  // ...
     QStack<int> m_contextStack;
+    // The file names and contexts seen so far, as they repeat for
+    // many messages.
+    QHash<QStringView, QString> m_strings;
 };
 
 XLIFFHandler::XLIFFHandler(Translator &translator, ConversionData &cd, QXmlStreamReader &reader)
@@ -448,6 +454,23 @@ XLIFFHandler::XliffContext XLIFFHandler::currentContext() const
     return XC_xliff;
 }
 
+// Returns a string equal to str that shares its data with the equal
+// strings returned before.
+const QString &XLIFFHandler::intern(QStringView str)
+{
+    static const QString empty;
+    if (str.isEmpty())
+        return empty;
+    auto it = m_strings.constFind(str);
+    if (it == m_strings.cend()) {
+        QString string = str.toString();
+        // The key refers to the data of the value, which does not move.
+        const QStringView key = string;
+        it = m_strings.insert(key, std::move(string));
+    }
+    return it.value();
+}
+
 // traverses to the top to check all of the parent contexes.
 bool XLIFFHandler::hasContext(XliffContext ctx) const
 {
@@ -472,7 +495,7 @@ bool XLIFFHandler::startElement(QStringView namespaceURI, QStringView localName,
         // make sure that the stack is not empty during parsing
         pushContext(XC_xliff);
     } else if (localName == QLatin1String("file")) {
-        m_fileName = atts.value(QLatin1String("original")).toString();
+        m_fileName = intern(atts.value(QLatin1String("original")));
         m_language = atts.value(QLatin1String("target-language")).toString();
         m_language.replace(QLatin1Char('-'), QLatin1Char('_'));
         m_sourceLanguage = atts.value(QLatin1String("source-language")).toString();
@@ -481,7 +504,7 @@ bool XLIFFHandler::startElement(QStringView namespaceURI, QStringView localName,
             m_sourceLanguage.clear();
     } else if (localName == QLatin1String("group")) {
         if (atts.value(QLatin1String("restype")) == QLatin1String(restypeContext)) {
-            m_context = atts.value(QLatin1String("resname")).toString();
+            m_context = intern(atts.value(QLatin1String("resname")));
             pushContext(XC_restype_context);
         } else {
             if (atts.value(QLatin1String("restype")) == QLatin1String(restypePlurals)) {
@@ -542,9 +565,9 @@ bool XLIFFHandler::startElement(QStringView namespaceURI, QStringView localName,
         else
             pushContext(XC_translator_comment);
     } else if (localName == QLatin1String("ph")) {
-        QString ctype = atts.value(QLatin1String("ctype")).toString();
+        const QStringView ctype = atts.value(QLatin1String("ctype"));
         if (ctype.startsWith(QLatin1String("x-ch-")))
-            m_ctype = ctype.mid(5);
+            m_ctype = ctype.sliced(5).toString();
         pushContext(XC_ph);
     }
 bail:
@@ -603,7 +626,7 @@ bool XLIFFHandler::endElement(QStringView namespaceURI, QStringView localName,
             if (!ok)
                 m_lineNumber = -1;
         } else if (popContext(XC_context_filename)) {
-            m_extraFileName = accum;
+            m_extraFileName = intern(accum);
         } else if (popContext(XC_context_comment)) {
             m_comment = accum;
         } else if (popContext(XC_context_old_comment)) {
@@ -656,9 +679,14 @@ bool XLIFFHandler::characters(QStringView ch)
                 accum.append(chr);
         }
     } else {
-        QString t = ch.toString();
-        t.replace(QLatin1String("\r"), QLatin1String(""));
-        accum.append(t);
+        // Append the text without the carriage returns, without copying it first.
+        for (qsizetype off = 0; off < ch.size(); ) {
+            qsizetype idx = ch.indexOf(QLatin1Char('\r'), off);
+            if (idx < 0)
+                idx = ch.size();
+            accum.append(ch.sliced(off, idx - off));
+            off = idx + 1;
+        }
     }
     return true;
 }
@@ -726,8 +754,32 @@ bool XLIFFHandler::fatalError(qint64 line, qint64 column, const QString &message
     return false;
 }
 
+// Counts the trans-units in a file that can be read again, so that the
+// messages can be allocated at once.
+static int countTransUnits(QIODevice &dev)
+{
+    if (dev.isSequential())
+        return 0;
+    const qint64 start = dev.pos();
+    static const QByteArrayMatcher matcher("<trans-unit");
+    constexpr qint64 chunkSize = 1024 * 1024;
+    const qsizetype overlap = matcher.pattern().size() - 1;
+    QByteArray chunk;
+    int count = 0;
+    while (!dev.atEnd()) {
+        // Keep the end of the previous chunk, for a tag that spans both.
+        chunk = chunk.right(overlap) + dev.read(chunkSize);
+        for (qsizetype pos = 0; (pos = matcher.indexIn(chunk, pos)) >= 0; pos += overlap)
+            ++count;
+    }
+    dev.seek(start);
+    return count;
+}
+
 bool loadXLIFF(Translator &translator, QIODevice &dev, ConversionData &cd)
 {
+    if (const int count = countTransUnits(dev))
+        translator.reserve(translator.messageCount() + count);
     QXmlStreamReader reader(&dev);
     XLIFFHandler hand(translator, cd, reader);
     return hand.parse();
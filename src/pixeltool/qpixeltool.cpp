@@ -5,6 +5,7 @@
 
 #include <qapplication.h>
 #include <qdir.h>
+#include <qelapsedtimer.h>
 #include <qscreen.h>
 #if QT_CONFIG(clipboard)
 #include <qclipboard.h>
@@ -41,6 +42,13 @@ static constexpr auto initialSizeKey = "initialSize"_L1;
 static constexpr auto positionKey = "position"_L1;
 static constexpr auto lcdModeKey = "lcdMode"_L1;
 
+// The cursor is polled quickly while it moves, and less often once it has
+// rested for a while. Without continuous update, nothing is grabbed then.
+static constexpr int movingUpdateInterval = 16;
+static constexpr int continuousUpdateInterval = 30;
+static constexpr int idleUpdateInterval = 100;
+static constexpr int idleUpdatesBeforeSlowdown = 10;
+
 static QPoint initialPos(const QSettings &settings, QSize initialSize)
 {
     const QPoint defaultPos = QGuiApplication::primaryScreen()->availableGeometry().topLeft();
@@ -68,7 +76,7 @@ QPixelTool::QPixelTool(QWidget *parent)
 
     setMouseTracking(true);
     setAttribute(Qt::WA_OpaquePaintEvent);
-    m_updateId = startTimer(30);
+    setUpdateInterval(continuousUpdateInterval);
 }
 
 QPixelTool::~QPixelTool()
@@ -90,10 +98,30 @@ void QPixelTool::setPreviewImage(const QImage &image)
     m_freeze = true;
 }
 
+void QPixelTool::setUpdateInterval(int interval)
+{
+    if (interval == m_updateInterval)
+        return;
+    if (m_updateId)
+        killTimer(m_updateId);
+    m_updateInterval = interval;
+    m_updateId = startTimer(interval, Qt::PreciseTimer);
+}
+
 void QPixelTool::timerEvent(QTimerEvent *event)
 {
-    if (event->timerId() == m_updateId && !m_freeze) {
+    if (event->timerId() == m_updateId) {
+        if (m_freeze)
+            return;
+        const bool moved = QCursor::pos() != m_lastMousePos;
         grabScreen();
+        m_idleUpdates = moved ? 0 : m_idleUpdates + 1;
+        if (moved)
+            setUpdateInterval(movingUpdateInterval);
+        else if (m_autoUpdate)
+            setUpdateInterval(continuousUpdateInterval);
+        else if (m_idleUpdates > idleUpdatesBeforeSlowdown)
+            setUpdateInterval(idleUpdateInterval);
     } else if (event->timerId() == m_displayZoomId) {
         killTimer(m_displayZoomId);
         m_displayZoomId = 0;
@@ -201,7 +229,11 @@ void QPixelTool::paintEvent(QPaintEvent *)
             p.scale(m_zoom / 3.0, m_zoom);
         else
             p.scale(m_zoom, m_zoom / 3.0);
-        p.drawImage(0, 0, imageLCDFilter(m_buffer.toImage(), m_lcdMode));
+        if (m_lcdImage.isNull() || m_lcdImageMode != m_lcdMode) {
+            m_lcdImage = imageLCDFilter(m_bufferImage, m_lcdMode);
+            m_lcdImageMode = m_lcdMode;
+        }
+        p.drawImage(0, 0, m_lcdImage);
     }
     p.restore();
 
@@ -246,6 +278,12 @@ void QPixelTool::paintEvent(QPaintEvent *)
                       Qt::AlignBottom | Qt::AlignRight);
     }
 
+    if (m_displayFrameTime) {
+        render_string(&p, w, h,
+                      QString::asprintf("Grab: %.2f ms", m_frameTime / 1000000.0),
+                      Qt::AlignTop | Qt::AlignLeft);
+    }
+
     if (m_mouseDown && m_dragStart != m_dragCurrent) {
         int x1 = (m_dragStart.x() / m_zoom) * m_zoom;
         int y1 = (m_dragStart.y() / m_zoom) * m_zoom;
@@ -293,6 +331,9 @@ void QPixelTool::keyPressEvent(QKeyEvent *e)
     case Qt::Key_A:
         m_autoUpdate = !m_autoUpdate;
         break;
+    case Qt::Key_T:
+        toggleFrameTime();
+        break;
 #if QT_CONFIG(clipboard)
     case Qt::Key_C:
         if (e->modifiers().testFlag(Qt::ControlModifier))
@@ -341,9 +382,8 @@ void QPixelTool::mouseMoveEvent(QMouseEvent *e)
     const int x = pos.x() / m_zoom;
     const int y = pos.y() / m_zoom;
 
-    QImage im = m_buffer.toImage().convertToFormat(QImage::Format_ARGB32);
-    if (x < im.width() && y < im.height() && x >= 0 && y >= 0) {
-        m_currentColor = im.pixel(x, y);
+    if (x < m_bufferImage.width() && y < m_bufferImage.height() && x >= 0 && y >= 0) {
+        m_currentColor = m_bufferImage.pixel(x, y);
         update();
     }
 }
@@ -431,6 +471,8 @@ void QPixelTool::contextMenuEvent(QContextMenuEvent *e)
                                          tmpFreeze, Qt::Key_Space);
     QAction *autoUpdate = addCheckableAction(menu, "Continuous update"_L1,
                                              m_autoUpdate, Qt::Key_A);
+    QAction *frameTime = addCheckableAction(menu, "Show grab time"_L1,
+                                            m_displayFrameTime, Qt::Key_T);
     menu.addSeparator();
 
     // Copy to clipboard / save
@@ -477,6 +519,7 @@ void QPixelTool::contextMenuEvent(QContextMenuEvent *e)
 
     m_autoUpdate = autoUpdate->isChecked();
     m_freeze = freeze->isChecked();
+    m_displayFrameTime = frameTime->isChecked();
 
     // LCD mode looks off unless zoom is dividable by 3
     if (m_lcdMode && (m_zoom % 3) != 0)
@@ -504,6 +547,8 @@ void QPixelTool::grabScreen()
         int w = qMin(width() / m_zoom + 1, m_preview_image.width());
         int h = qMin(height() / m_zoom + 1, m_preview_image.height());
         m_buffer = QPixmap::fromImage(m_preview_image).copy(0, 0, w, h);
+        m_bufferImage = m_buffer.toImage().convertToFormat(QImage::Format_ARGB32);
+        m_lcdImage = QImage();
         update();
         return;
     }
@@ -524,8 +569,12 @@ void QPixelTool::grabScreen()
     const QSize size{int(std::ceil(width() * factor)), int(std::ceil(height() * factor))};
     const QPoint pos = mousePos - QPoint{size.width(), size.height()} / 2;
 
+    QElapsedTimer grabTimer;
+    grabTimer.start();
+    const QImage previousImage = m_bufferImage;
     const QBrush darkBrush = palette().color(QPalette::Dark);
     if (screen != nullptr) {
+        // Only the area around the cursor that is shown zoomed is grabbed.
         const QPoint screenPos = pos - screen->geometry().topLeft();
         m_buffer = screen->grabWindow(0, screenPos.x(), screenPos.y(), size.width(), size.height());
     } else {
@@ -549,10 +598,16 @@ void QPixelTool::grabScreen()
         p.drawRects(geom.begin(), rectsInRegion);
     }
 
-    update();
-
-    m_currentColor = m_buffer.toImage().pixel(m_buffer.rect().center());
+    m_bufferImage = m_buffer.toImage().convertToFormat(QImage::Format_ARGB32);
+    m_frameTime = grabTimer.nsecsElapsed();
+    m_currentColor = m_bufferImage.pixel(m_bufferImage.rect().center());
     m_lastMousePos = mousePos;
+
+    // Continuous updates of a still picture need no repaint.
+    if (m_bufferImage != previousImage || m_displayFrameTime) {
+        m_lcdImage = QImage();
+        update();
+    }
 }
 
 void QPixelTool::startZoomVisibleTimer()
@@ -580,6 +635,12 @@ void QPixelTool::setZoomVisible(bool visible)
     update();
 }
 
+void QPixelTool::toggleFrameTime()
+{
+    m_displayFrameTime = !m_displayFrameTime;
+    update();
+}
+
 void QPixelTool::toggleFreeze()
 {
     m_freeze = !m_freeze;
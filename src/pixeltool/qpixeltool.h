@@ -25,6 +25,7 @@ public slots:
     void setGridSize(int gridSize);
     void toggleGrid();
     void toggleFreeze();
+    void toggleFrameTime();
     void setZoomVisible(bool visible);
 #if QT_CONFIG(clipboard)
     void copyToClipboard();
@@ -52,6 +53,7 @@ protected:
 
 private:
     void grabScreen();
+    void setUpdateInterval(int interval);
     void startZoomVisibleTimer();
     void startGridSizeVisibleTimer();
     QString aboutText() const;
@@ -62,6 +64,7 @@ private:
     bool m_mouseDown = false;
     bool m_autoUpdate;
     bool m_preview_mode = false;
+    bool m_displayFrameTime = false;
 
     int m_gridActive;
     int m_zoom;
@@ -69,6 +72,8 @@ private:
     int m_lcdMode;
 
     int m_updateId = 0;
+    int m_updateInterval = 0;
+    int m_idleUpdates = 0;
     int m_displayZoomId = 0;
     int m_displayGridSizeId = 0;
 
@@ -78,6 +83,10 @@ private:
     QPoint m_dragStart;
     QPoint m_dragCurrent;
     QPixmap m_buffer;
+    QImage m_bufferImage; // m_buffer as ARGB32, for reading pixels
+    QImage m_lcdImage; // m_bufferImage filtered for m_lcdImageMode
+    int m_lcdImageMode = 0;
+    qint64 m_frameTime = 0; // nanoseconds taken by the last grab
 
     QSize m_initialSize;
 
@@ -5,6 +5,8 @@
 #include <stdlib.h>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QEventLoop>
+#include <QtCore/QQueue>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStringList>
 #include <QtCore/qmetaobject.h>
@@ -16,19 +18,23 @@
 #include <QtDBus/QDBusVariant>
 #include <QtDBus/QDBusArgument>
 #include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusPendingCallWatcher>
 #include <QtDBus/QDBusReply>
 #include <private/qdbusutil_p.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 Q_DBUS_EXPORT extern bool qt_dbus_metaobject_skip_annotations;
 QT_END_NAMESPACE
 
 static QDBusConnection connection(QLatin1String(""));
 static bool printArgumentsLiterally = false;
+static int maxPendingCalls = 16;
 
 static void showUsage()
 {
-    printf("Usage: qdbus [--system] [--bus busaddress] [--literal] [servicename] [path] [method] [args]\n"
+    printf("Usage: qdbus [--system] [--bus busaddress] [--literal] [--max-pending count] [servicename] [path] [method] [args]\n"
            "\n"
            "  servicename       the service to connect to (e.g., org.freedesktop.DBus)\n"
            "  path              the path to the object (e.g., /)\n"
@@ -42,6 +48,9 @@ static void showUsage()
            "  --system          connect to the system bus\n"
            "  --bus busaddress  connect to a custom bus\n"
            "  --literal         print replies literally\n"
+           "  --max-pending count\n"
+           "                    the number of calls sent at the same time when listing\n"
+           "                    services or objects (default 16, 1 to send them one by one)\n"
            );
 }
 
@@ -83,45 +92,130 @@ static void printArg(const QVariant &v)
     }
 }
 
-static void listObjects(const QString &service, const QString &path)
+// Sends calls without waiting for the replies, with at most maxPendingCalls
+// of them in flight at the same time, and calls the handler of each call
+// with its reply. Handlers may enqueue further calls.
+class PendingCalls
 {
-    // make a low-level call, to avoid introspecting the Introspectable interface
-    QDBusMessage call = QDBusMessage::createMethodCall(service, path.isEmpty() ? QLatin1String("/") : path,
-                                                       QLatin1String("org.freedesktop.DBus.Introspectable"),
-                                                       QLatin1String("Introspect"));
-    QDBusReply<QString> xml = connection.call(call);
-
-    if (path.isEmpty()) {
-        // top-level
-        if (xml.isValid()) {
-            printf("/\n");
-        } else {
-            QDBusError err = xml.error();
-            if (err.type() == QDBusError::ServiceUnknown)
-                fprintf(stderr, "Service '%s' does not exist.\n", qPrintable(service));
-            else
-                printf("Error: %s\n%s\n", qPrintable(err.name()), qPrintable(err.message()));
-            exit(2);
-        }
-    } else if (!xml.isValid()) {
-        // this is not the first object, just fail silently
-        return;
+public:
+    using Handler = std::function<void(const QDBusMessage &reply)>;
+
+    void enqueue(const QDBusMessage &call, const Handler &handler)
+    {
+        m_queue.enqueue({ call, handler });
+        startCalls();
     }
 
-    QDomDocument doc;
-    doc.setContent(xml.value());
-    QDomElement node = doc.documentElement();
-    QDomElement child = node.firstChildElement();
-    while (!child.isNull()) {
-        if (child.tagName() == QLatin1String("node")) {
-            QString sub = path + QLatin1Char('/') + child.attribute(QLatin1String("name"));
-            printf("%s\n", qPrintable(sub));
-            listObjects(service, sub);
+    void waitForFinished()
+    {
+        if (m_pending > 0)
+            m_loop.exec();
+    }
+
+private:
+    struct Call
+    {
+        QDBusMessage message;
+        Handler handler;
+    };
+
+    void startCalls()
+    {
+        while (m_pending < qMax(1, maxPendingCalls) && !m_queue.isEmpty()) {
+            const Call call = m_queue.dequeue();
+            auto *watcher = new QDBusPendingCallWatcher(connection.asyncCall(call.message));
+            ++m_pending;
+            QObject::connect(watcher, &QDBusPendingCallWatcher::finished, watcher,
+                             [this, watcher, handler = call.handler] {
+                                 watcher->deleteLater();
+                                 --m_pending;
+                                 handler(watcher->reply());
+                                 startCalls();
+                                 if (m_pending == 0)
+                                     m_loop.quit();
+                             });
         }
-        child = child.nextSiblingElement();
+    }
+
+    QQueue<Call> m_queue;
+    int m_pending = 0;
+    QEventLoop m_loop;
+};
+
+static QDBusMessage introspectCall(const QString &service, const QString &path)
+{
+    // make a low-level call, to avoid introspecting the Introspectable interface
+    return QDBusMessage::createMethodCall(service, path.isEmpty() ? QLatin1String("/") : path,
+                                          QLatin1String("org.freedesktop.DBus.Introspectable"),
+                                          QLatin1String("Introspect"));
+}
+
+struct ObjectNode
+{
+    QString path;
+    QList<qsizetype> children;
+};
+
+static void printObjects(const QList<ObjectNode> &nodes, qsizetype index)
+{
+    for (qsizetype child : nodes.at(index).children) {
+        printf("%s\n", qPrintable(nodes.at(child).path));
+        printObjects(nodes, child);
     }
 }
 
+// Introspects all objects below path at the same time, and prints them in
+// the same order as a depth-first walk would.
+static void introspectObjects(PendingCalls &calls, QList<ObjectNode> &nodes, qsizetype index,
+                              const QString &service)
+{
+    const QString path = nodes.at(index).path;
+    calls.enqueue(introspectCall(service, path),
+                  [&calls, &nodes, index, service, path](const QDBusMessage &reply) {
+        QDBusReply<QString> xml = reply;
+
+        if (path.isEmpty()) {
+            // top-level
+            if (!xml.isValid()) {
+                QDBusError err = xml.error();
+                if (err.type() == QDBusError::ServiceUnknown)
+                    fprintf(stderr, "Service '%s' does not exist.\n", qPrintable(service));
+                else
+                    printf("Error: %s\n%s\n", qPrintable(err.name()), qPrintable(err.message()));
+                exit(2);
+            }
+        } else if (!xml.isValid()) {
+            // this is not the first object, just fail silently
+            return;
+        }
+
+        QDomDocument doc;
+        doc.setContent(xml.value());
+        QDomElement node = doc.documentElement();
+        QDomElement child = node.firstChildElement();
+        while (!child.isNull()) {
+            if (child.tagName() == QLatin1String("node")) {
+                nodes.append({ path + QLatin1Char('/') + child.attribute(QLatin1String("name")),
+                               {} });
+                nodes[index].children.append(nodes.size() - 1);
+                introspectObjects(calls, nodes, nodes.size() - 1, service);
+            }
+            child = child.nextSiblingElement();
+        }
+    });
+}
+
+static void listObjects(const QString &service)
+{
+    PendingCalls calls;
+    QList<ObjectNode> nodes = { { QString(), {} } };
+    introspectObjects(calls, nodes, 0, service);
+    calls.waitForFinished();
+
+    printf("/\n");
+    printObjects(nodes, 0);
+}
+
 static void listInterface(const QString &service, const QString &path, const QString &interface)
 {
     QDBusInterface iface(service, path, interface, connection);
@@ -178,11 +272,7 @@ static void listInterface(const QString &service, const QString &path, const QSt
 
 static void listAllInterfaces(const QString &service, const QString &path)
 {
-    // make a low-level call, to avoid introspecting the Introspectable interface
-    QDBusMessage call = QDBusMessage::createMethodCall(service, path.isEmpty() ? QLatin1String("/") : path,
-                                                       QLatin1String("org.freedesktop.DBus.Introspectable"),
-                                                       QLatin1String("Introspect"));
-    QDBusReply<QString> xml = connection.call(call);
+    QDBusReply<QString> xml = connection.call(introspectCall(service, path));
 
     if (!xml.isValid()) {
         QDBusError err = xml.error();
@@ -398,13 +488,20 @@ static void printAllServices(QDBusConnectionInterface *bus)
     const QStringList services = bus->registeredServiceNames();
     QMap<QString, QStringList> servicesWithAliases;
 
+    PendingCalls calls;
     for (const QString &serviceName : services) {
-        QDBusReply<QString> reply = bus->serviceOwner(serviceName);
-        QString owner = reply;
-        if (owner.isEmpty())
-            owner = serviceName;
-        servicesWithAliases[owner].append(serviceName);
+        QDBusMessage call = QDBusMessage::createMethodCall(bus->service(), bus->path(),
+                                                           bus->interface(),
+                                                           QLatin1String("GetNameOwner"));
+        call << serviceName;
+        calls.enqueue(call, [&servicesWithAliases, serviceName](const QDBusMessage &reply) {
+            QString owner = QDBusReply<QString>(reply);
+            if (owner.isEmpty())
+                owner = serviceName;
+            servicesWithAliases[owner].append(serviceName);
+        });
     }
+    calls.waitForFinished();
 
     for (QMap<QString,QStringList>::const_iterator it = servicesWithAliases.constBegin();
          it != servicesWithAliases.constEnd(); ++it) {
@@ -434,6 +531,18 @@ int main(int argc, char **argv)
             }
         } else if (arg == QLatin1String("--literal")) {
             printArgumentsLiterally = true;
+        } else if (arg == QLatin1String("--max-pending")) {
+            if (args.isEmpty()) {
+                fprintf(stderr, "The option --max-pending requires a count.\n");
+                showUsage();
+                return 1;
+            }
+            bool ok = false;
+            maxPendingCalls = args.takeFirst().toInt(&ok);
+            if (!ok || maxPendingCalls < 1) {
+                fprintf(stderr, "The number of pending calls must be a positive number.\n");
+                return 1;
+            }
         } else if (arg == QLatin1String("--help")) {
             showUsage();
             return 0;
@@ -473,7 +582,7 @@ int main(int argc, char **argv)
     }
 
     if (args.isEmpty()) {
-        listObjects(service, QString());
+        listObjects(service);
         return 0;
     }
 
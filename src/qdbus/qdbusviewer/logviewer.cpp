@@ -3,19 +3,312 @@
 
 #include "logviewer.h"
 
-#include <QtGui/QContextMenuEvent>
-#include <QtWidgets/QMenu>
+#include <QtCore/QHash>
+#include <QtCore/QUrl>
+#include <QtGui/QAbstractTextDocumentLayout>
+#include <QtGui/QAction>
+#include <QtGui/QClipboard>
+#include <QtGui/QFont>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QMouseEvent>
+#include <QtGui/QPainter>
+#include <QtGui/QTextDocument>
+#include <QtGui/QTextDocumentFragment>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QListView>
+#include <QtWidgets/QScrollBar>
+#include <QtWidgets/QStyledItemDelegate>
+#include <QtWidgets/QVBoxLayout>
 
+#include <algorithm>
+
+static const int logCapacity = 10000;
+
+LogModel::LogModel(int capacity, QObject *parent)
+    : QAbstractListModel(parent), m_capacity(capacity)
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(100);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LogModel::flush);
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_count)
+        return QVariant();
+
+    switch (role) {
+    case HtmlRole:
+        return entry(index.row());
+    case EntryIdRole:
+        return m_firstId + index.row();
+    case Qt::DisplayRole:
+        return QTextDocumentFragment::fromHtml(entry(index.row())).toPlainText();
+    default:
+        return QVariant();
+    }
+}
+
+const QString &LogModel::entry(int row) const
+{
+    return m_entries.at((m_first + row) % m_capacity);
+}
+
+void LogModel::append(const QString &html)
+{
+    ++m_received;
+    m_pending.append(html);
+    // Entries that would be pushed out before they are shown are dropped
+    // right away.
+    if (m_pending.size() > m_capacity) {
+        m_pending.removeFirst();
+        ++m_dropped;
+    }
+    if (!m_flushTimer.isActive())
+        m_flushTimer.start();
+}
+
+void LogModel::clear()
+{
+    m_flushTimer.stop();
+    m_pending.clear();
+    beginResetModel();
+    m_entries.clear();
+    m_first = 0;
+    m_firstId += m_count;
+    m_count = 0;
+    endResetModel();
+}
+
+void LogModel::flush()
+{
+    const int added = int(m_pending.size());
+    if (added == 0)
+        return;
+    if (m_entries.isEmpty())
+        m_entries.resize(m_capacity);
+
+    // Only the oldest rows that do not fit next to the new ones are
+    // evicted, the others stay in place.
+    const int evicted = std::clamp(m_count + added - m_capacity, 0, m_count);
+    if (evicted > 0) {
+        beginRemoveRows(QModelIndex(), 0, evicted - 1);
+        for (int i = 0; i < evicted; ++i)
+            m_entries[(m_first + i) % m_capacity].clear();
+        m_first = (m_first + evicted) % m_capacity;
+        m_firstId += evicted;
+        m_count -= evicted;
+        m_dropped += evicted;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), m_count, m_count + added - 1);
+    for (QString &html : m_pending)
+        m_entries[(m_first + m_count++) % m_capacity] = std::move(html);
+    m_pending.clear();
+    endInsertRows();
+
+    emit countsChanged();
+}
+
+// Draws the entries as rich text, so that object paths are links. Laying
+// out an entry is expensive and the view asks for the size of every row,
+// so the sizes are cached by entry until the width or the font changes.
+class LogDelegate : public QStyledItemDelegate
+{
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void forget(const QModelIndex &index) const
+    {
+        m_sizes.remove(index.data(LogModel::EntryIdRole).toLongLong());
+    }
+
+    void forgetAll() const { m_sizes.clear(); }
+
+    static void setupDocument(QTextDocument *document, const QStyleOptionViewItem &option,
+                              const QModelIndex &index)
+    {
+        document->setDocumentMargin(2);
+        document->setDefaultFont(option.font);
+        document->setHtml(index.data(LogModel::HtmlRole).toString());
+        document->setTextWidth(option.rect.width());
+    }
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override
+    {
+        QStyleOptionViewItem opt = option;
+        initStyleOption(&opt, index);
+        opt.text.clear();
+        const QWidget *widget = option.widget;
+        QStyle *style = widget ? widget->style() : QApplication::style();
+        style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+        QTextDocument document;
+        setupDocument(&document, option, index);
+        QAbstractTextDocumentLayout::PaintContext context;
+        context.palette = option.palette;
+        if (option.state & QStyle::State_Selected) {
+            context.palette.setColor(QPalette::Text,
+                                     option.palette.color(QPalette::HighlightedText));
+        }
+        painter->save();
+        painter->translate(option.rect.topLeft());
+        painter->setClipRect(option.rect.translated(-option.rect.topLeft()));
+        document.documentLayout()->draw(painter, context);
+        painter->restore();
+    }
+
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override
+    {
+        QStyleOptionViewItem opt = option;
+        if (auto *view = qobject_cast<const QAbstractItemView *>(option.widget))
+            opt.rect.setWidth(view->viewport()->width());
+        if (opt.rect.width() != m_width || opt.font != m_font) {
+            m_sizes.clear();
+            m_width = opt.rect.width();
+            m_font = opt.font;
+        }
+
+        const qint64 id = index.data(LogModel::EntryIdRole).toLongLong();
+        const auto it = m_sizes.constFind(id);
+        if (it != m_sizes.constEnd())
+            return *it;
+        QTextDocument document;
+        setupDocument(&document, opt, index);
+        const QSize size = document.size().toSize();
+        m_sizes.insert(id, size);
+        return size;
+    }
+
+private:
+    mutable QHash<qint64, QSize> m_sizes;
+    mutable int m_width = -1;
+    mutable QFont m_font;
+};
+
+/*
+    Shows the log in a list view, which only lays out the visible entries.
+    The view follows the newest entries unless it is scrolled up.
+*/
 LogViewer::LogViewer(QWidget *parent)
-    : QTextBrowser(parent)
+    : QWidget(parent),
+      m_model(new LogModel(logCapacity, this)),
+      m_view(new QListView),
+      m_delegate(new LogDelegate(m_view)),
+      m_countsLabel(new QLabel)
 {
+    m_view->setModel(m_model);
+    m_view->setItemDelegate(m_delegate);
+    m_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_view->setLayoutMode(QListView::Batched);
+    m_view->setBatchSize(200);
+    m_view->setResizeMode(QListView::Adjust);
+    m_view->setWordWrap(true);
+    m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_view->viewport()->setMouseTracking(true);
+    m_view->viewport()->installEventFilter(this);
+
+    m_view->setContextMenuPolicy(Qt::ActionsContextMenu);
+    QAction *copyAction = new QAction(tr("&Copy"), m_view);
+    copyAction->setShortcut(QKeySequence::Copy);
+    copyAction->setShortcutContext(Qt::WidgetShortcut);
+    connect(copyAction, &QAction::triggered, this, &LogViewer::copySelection);
+    m_view->addAction(copyAction);
+    QAction *clearAction = new QAction(tr("Clear"), m_view);
+    connect(clearAction, &QAction::triggered, this, &LogViewer::clear);
+    m_view->addAction(clearAction);
+
+    connect(m_model, &QAbstractItemModel::rowsAboutToBeInserted, this, [this] {
+        const QScrollBar *bar = m_view->verticalScrollBar();
+        m_followTail = bar->value() == bar->maximum();
+    });
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, [this] {
+        if (m_followTail)
+            m_view->scrollToBottom();
+    });
+    connect(m_model, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+            [this](const QModelIndex &, int first, int last) {
+        for (int row = first; row <= last; ++row)
+            m_delegate->forget(m_model->index(row));
+    });
+    connect(m_model, &QAbstractItemModel::modelReset, m_delegate, [this] {
+        m_delegate->forgetAll();
+    });
+    connect(m_model, &LogModel::countsChanged, this, &LogViewer::updateCounts);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(QMargins());
+    layout->addWidget(m_view);
+    layout->addWidget(m_countsLabel);
+    updateCounts();
 }
 
-void LogViewer::contextMenuEvent(QContextMenuEvent *event)
+void LogViewer::append(const QString &html)
 {
-    QMenu *menu = createStandardContextMenu();
-    QAction *action = menu->addAction(tr("Clear"));
-    connect(action, &QAction::triggered, this, &QTextEdit::clear);
-    menu->exec(event->globalPos());
-    delete menu;
+    m_model->append(html);
+}
+
+void LogViewer::clear()
+{
+    m_model->clear();
+    updateCounts();
+}
+
+void LogViewer::updateCounts()
+{
+    m_countsLabel->setText(tr("Received: %1, dropped: %2")
+                                   .arg(m_model->receivedCount())
+                                   .arg(m_model->droppedCount()));
+}
+
+void LogViewer::copySelection()
+{
+    QModelIndexList indexes = m_view->selectionModel()->selectedIndexes();
+    std::sort(indexes.begin(), indexes.end());
+    QStringList lines;
+    for (const QModelIndex &index : std::as_const(indexes))
+        lines.append(index.data().toString());
+    if (!lines.isEmpty())
+        QGuiApplication::clipboard()->setText(lines.join(u'\n'));
+}
+
+bool LogViewer::eventFilter(QObject *object, QEvent *event)
+{
+    if (object != m_view->viewport()
+        || (event->type() != QEvent::MouseMove && event->type() != QEvent::MouseButtonRelease)) {
+        return QWidget::eventFilter(object, event);
+    }
+
+    // Find the link under the mouse, if any.
+    const QPoint pos = static_cast<QMouseEvent *>(event)->position().toPoint();
+    const QModelIndex index = m_view->indexAt(pos);
+    QString anchor;
+    if (index.isValid()) {
+        QStyleOptionViewItem option;
+        option.initFrom(m_view);
+        option.rect = m_view->visualRect(index);
+        QTextDocument document;
+        LogDelegate::setupDocument(&document, option, index);
+        anchor = document.documentLayout()->anchorAt(pos - option.rect.topLeft());
+    }
+
+    if (event->type() == QEvent::MouseMove) {
+        if (anchor.isEmpty())
+            m_view->viewport()->unsetCursor();
+        else
+            m_view->viewport()->setCursor(Qt::PointingHandCursor);
+    } else if (!anchor.isEmpty()
+               && static_cast<QMouseEvent *>(event)->button() == Qt::LeftButton) {
+        emit anchorClicked(QUrl(anchor));
+    }
+    return false;
 }
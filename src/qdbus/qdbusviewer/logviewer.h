@@ -4,16 +4,79 @@
 #ifndef LOGVIEWER_H
 #define LOGVIEWER_H
 
-#include <QtWidgets/QTextBrowser>
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QList>
+#include <QtCore/QTimer>
+#include <QtWidgets/QWidget>
 
-class LogViewer : public QTextBrowser
+QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QListView)
+
+class LogDelegate;
+
+// The latest log entries, as rich text, in a ring buffer of fixed size.
+// Appended entries are added to the model in batches, at most every
+// 100 ms, so that a flood of messages does not update the view for each
+// of them.
+class LogModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum { HtmlRole = Qt::UserRole, EntryIdRole };
+
+    explicit LogModel(int capacity, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void append(const QString &html);
+    void clear();
+
+    qint64 receivedCount() const { return m_received; }
+    qint64 droppedCount() const { return m_dropped; }
+
+signals:
+    void countsChanged();
+
+private:
+    void flush();
+    const QString &entry(int row) const;
+
+    const int m_capacity;
+    QList<QString> m_entries; // the ring buffer
+    int m_first = 0;
+    int m_count = 0;
+    qint64 m_firstId = 0; // EntryIdRole of row 0, stays with the entry
+    QList<QString> m_pending;
+    QTimer m_flushTimer;
+    qint64 m_received = 0;
+    qint64 m_dropped = 0;
+};
+
+class LogViewer : public QWidget
 {
     Q_OBJECT
 public:
     explicit LogViewer(QWidget *parent = 0);
 
+    void append(const QString &html);
+    void clear();
+
+signals:
+    void anchorClicked(const QUrl &url);
+
 protected:
-    void contextMenuEvent(QContextMenuEvent *event) override;
+    bool eventFilter(QObject *object, QEvent *event) override;
+
+private:
+    void updateCounts();
+    void copySelection();
+
+    LogModel *m_model;
+    QListView *m_view;
+    LogDelegate *m_delegate;
+    QLabel *m_countsLabel;
+    bool m_followTail = true;
 };
 
 #endif // LOGVIEWER_H
@@ -5,13 +5,13 @@
 
 #include <QtCore/QDebug>
 #include <QtCore/QList>
+#include <QtCore/QXmlStreamReader>
 
+#include <QtDBus/QDBusMessage>
 #include <QtDBus/QDBusObjectPath>
-#include <QtDBus/QDBusInterface>
+#include <QtDBus/QDBusPendingCallWatcher>
 #include <QtDBus/QDBusReply>
 
-#include <QtXml/QDomDocument>
-
 using namespace Qt::StringLiterals;
 
 struct QDBusItem
@@ -43,28 +43,128 @@ struct QDBusItem
     QDBusItem *parent;
     QList<QDBusItem *> children;
     bool isPrefetched;
+    bool isFetching = false;
     QString name;
     QString caption;
     QString typeSignature;
 };
 
-QDomDocument QDBusModel::introspect(const QString &path)
+const QDBusIntrospectedObject *QDBusIntrospectionCache::find(const QString &service,
+                                                             const QString &path) const
+{
+    const auto it = services.constFind(service);
+    if (it == services.cend())
+        return nullptr;
+    const auto objectIt = it->constFind(path);
+    return objectIt == it->cend() ? nullptr : &*objectIt;
+}
+
+void QDBusIntrospectionCache::insert(const QString &service, const QString &path,
+                                     const QDBusIntrospectedObject &object)
+{
+    services[service].insert(path, object);
+}
+
+// Removes path and all objects below it.
+void QDBusIntrospectionCache::removeObjects(const QString &service, const QString &path)
+{
+    const auto it = services.find(service);
+    if (it == services.end())
+        return;
+    const QString prefix = path.endsWith('/'_L1) ? path : path + '/'_L1;
+    it->removeIf([&](const auto &object) {
+        return object.key() == path || object.key().startsWith(prefix);
+    });
+}
+
+void QDBusIntrospectionCache::removeService(const QString &service)
+{
+    services.remove(service);
+}
+
+static QList<QDBusIntrospectedObject::Member> parseMembers(QXmlStreamReader &xml)
 {
-    QDomDocument doc;
-
-    QDBusInterface iface(service, path, "org.freedesktop.DBus.Introspectable"_L1, c);
-    if (!iface.isValid()) {
-        QDBusError err(iface.lastError());
-        emit busError(tr("Cannot introspect object %1 at %2:\n  %3 (%4)\n")
-                              .arg(path)
-                              .arg(service)
-                              .arg(err.name())
-                              .arg(err.message()));
-        return doc;
+    QList<QDBusIntrospectedObject::Member> members;
+    while (xml.readNextStartElement()) {
+        const QStringView tag = xml.name();
+        const QString name = xml.attributes().value("name"_L1).toString();
+        if (tag == "method"_L1) {
+            QDBusIntrospectedObject::Member method{ QDBusModel::MethodItem, name, QString() };
+            //get "type" from <arg> where "direction" is "in"
+            while (xml.readNextStartElement()) {
+                if (xml.attributes().value("direction"_L1) == "in"_L1)
+                    method.typeSignature += xml.attributes().value("type"_L1);
+                xml.skipCurrentElement();
+            }
+            members.append(method);
+            continue;
+        }
+        if (tag == "signal"_L1)
+            members.append({ QDBusModel::SignalItem, name, QString() });
+        else if (tag == "property"_L1)
+            members.append({ QDBusModel::PropertyItem, name, QString() });
+        else
+            qDebug() << "addMethods: unknown tag:" << tag;
+        xml.skipCurrentElement();
     }
+    return members;
+}
 
-    QDBusReply<QString> xml = iface.call("Introspect"_L1);
+static QDBusIntrospectedObject parseIntrospection(const QString &data)
+{
+    QDBusIntrospectedObject object;
+    QXmlStreamReader xml(data);
+    if (!xml.readNextStartElement())
+        return object;
+    while (xml.readNextStartElement()) {
+        const QStringView tag = xml.name();
+        const QString name = xml.attributes().value("name"_L1).toString();
+        if (tag == "node"_L1) {
+            object.children.append({ QDBusModel::PathItem, name + '/'_L1, {} });
+            xml.skipCurrentElement();
+        } else if (tag == "interface"_L1) {
+            object.children.append({ QDBusModel::InterfaceItem, name, parseMembers(xml) });
+        } else {
+            qDebug() << "addPath: Unknown tag name:" << tag;
+            xml.skipCurrentElement();
+        }
+    }
+    return object;
+}
 
+// Starts an asynchronous introspection of the object of item, unless it is
+// in the cache already.
+void QDBusModel::introspect(QDBusItem *item)
+{
+    if (item->isPrefetched || item->isFetching)
+        return;
+
+    const QString path = item->path();
+    if (const QDBusIntrospectedObject *object = cache->find(service, path)) {
+        addPath(item, *object);
+        return;
+    }
+
+    item->isFetching = true;
+    // make a low-level call, to avoid introspecting the Introspectable interface
+    const QDBusMessage call = QDBusMessage::createMethodCall(
+            service, path, "org.freedesktop.DBus.Introspectable"_L1, "Introspect"_L1);
+    auto *watcher = new QDBusPendingCallWatcher(c.asyncCall(call), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, path] {
+        watcher->deleteLater();
+        introspectFinished(path, watcher->reply());
+    });
+}
+
+void QDBusModel::introspectFinished(const QString &path, const QDBusMessage &reply)
+{
+    // The item is gone if it was refreshed in the meantime.
+    QDBusItem *item = findPath(path);
+    if (!item || !item->isFetching)
+        return;
+    item->isFetching = false;
+
+    QDBusReply<QString> xml = reply;
     if (!xml.isValid()) {
         QDBusError err(xml.error());
         if (err.isValid()) {
@@ -76,79 +176,79 @@ QDomDocument QDBusModel::introspect(const QString &path)
         } else {
             emit busError(tr("Invalid XML received from object %1 at %2\n").arg(path).arg(service));
         }
-        return doc;
+        addPath(item, QDBusIntrospectedObject());
+        return;
     }
 
-    doc.setContent(xml.value());
-    return doc;
+    const QDBusIntrospectedObject object = parseIntrospection(xml.value());
+    cache->insert(service, path, object);
+    addPath(item, object);
 }
 
-void QDBusModel::addMethods(QDBusItem *parent, const QDomElement &iface)
+void QDBusModel::addPath(QDBusItem *parent, const QDBusIntrospectedObject &object)
 {
     Q_ASSERT(parent);
 
-    QDomElement child = iface.firstChildElement();
-    while (!child.isNull()) {
-        QDBusItem *item = nullptr;
-        if (child.tagName() == "method"_L1) {
-            item = new QDBusItem(QDBusModel::MethodItem, child.attribute("name"_L1), parent);
-            item->caption = tr("Method: %1").arg(item->name);
-            //get "type" from <arg> where "direction" is "in"
-            QDomElement n = child.firstChildElement();
-            while (!n.isNull()) {
-                if (n.attribute("direction"_L1) == "in"_L1)
-                    item->typeSignature += n.attribute("type"_L1);
-                n = n.nextSiblingElement();
+    if (!object.children.isEmpty())
+        beginInsertRows(indexOf(parent), 0, object.children.size() - 1);
+    for (const QDBusIntrospectedObject::Child &child : object.children) {
+        QDBusItem *item = new QDBusItem(child.type, child.name, parent);
+        parent->children.append(item);
+        for (const QDBusIntrospectedObject::Member &member : child.members) {
+            QDBusItem *memberItem = new QDBusItem(member.type, member.name, item);
+            memberItem->typeSignature = member.typeSignature;
+            switch (member.type) {
+            case MethodItem:
+                memberItem->caption = tr("Method: %1").arg(member.name);
+                break;
+            case SignalItem:
+                memberItem->caption = tr("Signal: %1").arg(member.name);
+                break;
+            default:
+                memberItem->caption = tr("Property: %1").arg(member.name);
+                break;
             }
-        } else if (child.tagName() == "signal"_L1) {
-            item = new QDBusItem(QDBusModel::SignalItem, child.attribute("name"_L1), parent);
-            item->caption = tr("Signal: %1").arg(item->name);
-        } else if (child.tagName() == "property"_L1) {
-            item = new QDBusItem(QDBusModel::PropertyItem, child.attribute("name"_L1), parent);
-            item->caption = tr("Property: %1").arg(item->name);
-        } else {
-            qDebug() << "addMethods: unknown tag:" << child.tagName();
+            item->children.append(memberItem);
         }
-        if (item)
-            parent->children.append(item);
-
-        child = child.nextSiblingElement();
     }
+    parent->isPrefetched = true;
+    if (!object.children.isEmpty())
+        endInsertRows();
+
+    if (!pendingFind.isEmpty())
+        continueFind();
 }
 
-void QDBusModel::addPath(QDBusItem *parent)
+QDBusItem *QDBusModel::findPath(const QString &path) const
 {
-    Q_ASSERT(parent);
-
-    QString path = parent->path();
-
-    QDomDocument doc = introspect(path);
-    QDomElement node = doc.documentElement();
-    QDomElement child = node.firstChildElement();
-    while (!child.isNull()) {
-        if (child.tagName() == "node"_L1) {
-            QDBusItem *item = new QDBusItem(QDBusModel::PathItem,
-                                            child.attribute("name"_L1) + '/'_L1, parent);
-            parent->children.append(item);
-
-            addMethods(item, child);
-        } else if (child.tagName() == "interface"_L1) {
-            QDBusItem *item =
-                    new QDBusItem(QDBusModel::InterfaceItem, child.attribute("name"_L1), parent);
-            parent->children.append(item);
-
-            addMethods(item, child);
-        } else {
-            qDebug() << "addPath: Unknown tag name:" << child.tagName();
+    const QStringList branches = path.split('/'_L1, Qt::SkipEmptyParts);
+    QDBusItem *item = root;
+    for (const QString &name : branches) {
+        const QString branch = name + '/'_L1;
+        QDBusItem *next = nullptr;
+        for (QDBusItem *child : std::as_const(item->children)) {
+            if (child->type == PathItem && child->name == branch) {
+                next = child;
+                break;
+            }
         }
-        child = child.nextSiblingElement();
+        if (!next)
+            return nullptr;
+        item = next;
     }
+    return item;
+}
 
-    parent->isPrefetched = true;
+QModelIndex QDBusModel::indexOf(QDBusItem *item) const
+{
+    if (!item || !item->parent)
+        return QModelIndex();
+    return createIndex(item->parent->children.indexOf(item), 0, item);
 }
 
-QDBusModel::QDBusModel(const QString &aService, const QDBusConnection &connection)
-    : service(aService), c(connection), root(0)
+QDBusModel::QDBusModel(const QString &aService, const QDBusConnection &connection,
+                       QDBusIntrospectionCache *aCache)
+    : service(aService), c(connection), cache(aCache), root(0)
 {
     root = new QDBusItem(QDBusModel::PathItem, "/"_L1);
 }
@@ -181,15 +281,37 @@ QModelIndex QDBusModel::parent(const QModelIndex &child) const
 
 int QDBusModel::rowCount(const QModelIndex &parent) const
 {
-    QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    const QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
     if (!item)
         item = root;
-    if (!item->isPrefetched)
-        const_cast<QDBusModel *>(this)->addPath(item);
 
     return item->children.size();
 }
 
+bool QDBusModel::hasChildren(const QModelIndex &parent) const
+{
+    const QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    if (!item)
+        item = root;
+
+    return !item->isPrefetched || !item->children.isEmpty();
+}
+
+bool QDBusModel::canFetchMore(const QModelIndex &parent) const
+{
+    const QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    if (!item)
+        item = root;
+
+    return !item->isPrefetched && !item->isFetching;
+}
+
+void QDBusModel::fetchMore(const QModelIndex &parent)
+{
+    QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    introspect(item ? item : root);
+}
+
 int QDBusModel::columnCount(const QModelIndex &) const
 {
     return 1;
@@ -239,11 +361,10 @@ void QDBusModel::refresh(const QModelIndex &aIndex)
         endRemoveRows();
     }
 
-    addPath(item);
-    if (!item->children.isEmpty()) {
-        beginInsertRows(index, 0, item->children.size() - 1);
-        endInsertRows();
-    }
+    cache->removeObjects(service, item->path());
+    item->isPrefetched = false;
+    item->isFetching = false;
+    introspect(item);
 }
 
 QString QDBusModel::dBusPath(const QModelIndex &aIndex) const
@@ -284,39 +405,46 @@ QString QDBusModel::dBusTypeSignature(const QModelIndex &index) const
     return item ? item->typeSignature : QString();
 }
 
-QModelIndex QDBusModel::findObject(const QDBusObjectPath &objectPath)
+/*
+    Finds the object at objectPath, introspecting the objects on the way
+    to it as needed, and emits objectFound() once it is there.
+*/
+void QDBusModel::findObject(const QDBusObjectPath &objectPath)
 {
-    QStringList path = objectPath.path().split('/'_L1, Qt::SkipEmptyParts);
+    pendingFind = objectPath.path();
+    continueFind();
+}
+
+void QDBusModel::continueFind()
+{
+    QStringList path = pendingFind.split('/'_L1, Qt::SkipEmptyParts);
 
     QDBusItem *item = root;
-    int childIdx = -1;
-    while (item && !path.isEmpty()) {
-        const QString branch = path.takeFirst() + '/'_L1;
-        childIdx = -1;
+    while (!path.isEmpty()) {
+        if (!item->isPrefetched) {
+            // continued from addPath()
+            introspect(item);
+            return;
+        }
 
-        // do a linear search over all the children
-        for (int i = 0; i < item->children.size(); ++i) {
-            QDBusItem *child = item->children.at(i);
+        const QString branch = path.takeFirst() + '/'_L1;
+        QDBusItem *next = nullptr;
+        for (QDBusItem *child : std::as_const(item->children)) {
             if (child->type == PathItem && child->name == branch) {
-                item = child;
-                childIdx = i;
-
-                // prefetch the found branch
-                if (!item->isPrefetched)
-                    addPath(item);
+                next = child;
                 break;
             }
         }
 
         // branch not found - bail out
-        if (childIdx == -1)
-            return QModelIndex();
+        if (!next) {
+            pendingFind.clear();
+            return;
+        }
+        item = next;
     }
 
-    // found the right item
-    if (childIdx != -1 && item && path.isEmpty())
-        return createIndex(childIdx, 0, item);
-
-    return QModelIndex();
+    pendingFind.clear();
+    if (item != root)
+        emit objectFound(indexOf(item));
 }
-
@@ -5,12 +5,15 @@
 #define QDBUSMODEL_H
 
 #include <QtCore/qabstractitemmodel.h>
+#include <QtCore/qhash.h>
 #include <QtDBus/QDBusConnection>
 
 struct QDBusItem;
+struct QDBusIntrospectedObject;
 
-QT_FORWARD_DECLARE_CLASS(QDomDocument);
-QT_FORWARD_DECLARE_CLASS(QDomElement);
+class QDBusIntrospectionCache;
+
+QT_FORWARD_DECLARE_CLASS(QDBusMessage)
 QT_FORWARD_DECLARE_CLASS(QDBusObjectPath)
 
 
@@ -21,7 +24,8 @@ class QDBusModel: public QAbstractItemModel
 public:
     enum Type { InterfaceItem, PathItem, MethodItem, SignalItem, PropertyItem };
 
-    QDBusModel(const QString &service, const QDBusConnection &connection);
+    QDBusModel(const QString &service, const QDBusConnection &connection,
+               QDBusIntrospectionCache *cache);
     ~QDBusModel();
 
 
@@ -31,6 +35,9 @@ public:
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
 
     Type itemType(const QModelIndex &index) const;
     QString dBusPath(const QModelIndex &index) const;
@@ -40,19 +47,63 @@ public:
 
     void refresh(const QModelIndex &index = QModelIndex());
 
-    QModelIndex findObject(const QDBusObjectPath &objectPath);
+    void findObject(const QDBusObjectPath &objectPath);
 
 Q_SIGNALS:
     void busError(const QString &text);
+    void objectFound(const QModelIndex &index);
 
 private:
-    QDomDocument introspect(const QString &path);
-    void addMethods(QDBusItem *parent, const QDomElement &iface);
-    void addPath(QDBusItem *parent);
+    void introspect(QDBusItem *item);
+    void introspectFinished(const QString &path, const QDBusMessage &reply);
+    void addPath(QDBusItem *parent, const QDBusIntrospectedObject &object);
+    QDBusItem *findPath(const QString &path) const;
+    QModelIndex indexOf(QDBusItem *item) const;
+    void continueFind();
 
     QString service;
     QDBusConnection c;
+    QDBusIntrospectionCache *cache;
     QDBusItem *root;
+    QString pendingFind;
+};
+
+// The child objects and the interfaces of an object, as introspected.
+struct QDBusIntrospectedObject
+{
+    struct Member
+    {
+        QDBusModel::Type type;
+        QString name;
+        QString typeSignature;
+    };
+
+    struct Child
+    {
+        QDBusModel::Type type; // PathItem or InterfaceItem
+        QString name;
+        QList<Member> members;
+    };
+
+    QList<Child> children;
+};
+
+/*
+    The introspected objects of all services, so that objects are only
+    introspected again when their service changes owner, or when they
+    are refreshed.
+*/
+class QDBusIntrospectionCache
+{
+public:
+    const QDBusIntrospectedObject *find(const QString &service, const QString &path) const;
+    void insert(const QString &service, const QString &path,
+                const QDBusIntrospectedObject &object);
+    void removeObjects(const QString &service, const QString &path);
+    void removeService(const QString &service);
+
+private:
+    QHash<QString, QHash<QString, QDBusIntrospectedObject>> services;
 };
 
 #endif
@@ -37,8 +37,9 @@ using namespace Qt::StringLiterals;
 class QDBusViewModel: public QDBusModel
 {
 public:
-    inline QDBusViewModel(const QString &service, const QDBusConnection &connection)
-        : QDBusModel(service, connection)
+    inline QDBusViewModel(const QString &service, const QDBusConnection &connection,
+                          QDBusIntrospectionCache *cache)
+        : QDBusModel(service, connection, cache)
     {}
 
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
@@ -110,7 +111,7 @@ QDBusViewer::QDBusViewer(const QDBusConnection &connection, QWidget *parent)
     layout->addWidget(topSplitter);
 
     log = new LogViewer;
-    connect(log, &QTextBrowser::anchorClicked, this, &QDBusViewer::anchorClicked);
+    connect(log, &LogViewer::anchorClicked, this, &QDBusViewer::anchorClicked);
 
     splitter = new QSplitter(topSplitter);
     splitter->addWidget(servicesView);
@@ -168,7 +169,7 @@ void QDBusViewer::restoreState(const QSettings *settings)
 
 void QDBusViewer::logMessage(const QString &msg)
 {
-    log->append(msg + '\n'_L1);
+    log->append(msg.toHtmlEscaped());
 }
 
 void QDBusViewer::showEvent(QShowEvent *)
@@ -487,9 +488,13 @@ void QDBusViewer::serviceChanged(const QModelIndex &index)
         return;
     currentService = index.data().toString();
 
-    QDBusViewModel *model = new QDBusViewModel(currentService, c);
+    QDBusViewModel *model = new QDBusViewModel(currentService, c, &introspectionCache);
     tree->setModel(model);
     connect(model, &QDBusModel::busError, this, &QDBusViewer::logError);
+    connect(model, &QDBusModel::objectFound, this, [this](const QModelIndex &idx) {
+        tree->scrollTo(idx);
+        tree->setCurrentIndex(idx);
+    });
 }
 
 void QDBusViewer::serviceRegistered(const QString &service)
@@ -513,6 +518,8 @@ static QModelIndex findItem(QStringListModel *servicesModel, const QString &name
 void QDBusViewer::serviceOwnerChanged(const QString &name, const QString &oldOwner,
                                       const QString &newOwner)
 {
+    introspectionCache.removeService(name);
+
     QModelIndex hit = findItem(servicesModel, name);
 
     if (!hit.isValid() && oldOwner.isEmpty() && !newOwner.isEmpty())
@@ -548,17 +555,9 @@ void QDBusViewer::anchorClicked(const QUrl &url)
         // not ours
         return;
 
-    // swallow the click without setting a new document
-    log->setSource(QUrl());
-
     QDBusModel *model = qobject_cast<QDBusModel *>(tree->model());
     if (!model)
         return;
 
-    QModelIndex idx = model->findObject(QDBusObjectPath(url.path()));
-    if (!idx.isValid())
-        return;
-
-    tree->scrollTo(idx);
-    tree->setCurrentIndex(idx);
+    model->findObject(QDBusObjectPath(url.path()));
 }
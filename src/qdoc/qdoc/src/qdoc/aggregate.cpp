@@ -460,81 +460,127 @@ static bool keep(FunctionNode *fn)
     return true;
 }
 
-/*!
-  Insert all functions declared in this aggregate into the
-  \a functionIndex. Call the function recursively for each
-  child that is an aggregate.
+/*
+  Inserts the node into the maps of new nodes if a since command
+  appeared in its qdoc comment, and sorts it according to the kind
+  of node. Enum values with their own since are inserted as well.
 
-  Only include functions that are in the public API and
-  that are not constructors or destructors.
+  The maps are used for generating the "New Classes... in x.y"
+  section on the What's New in Qt x.y page.
  */
-void Aggregate::findAllFunctions(NodeMapMap &functionIndex)
+static void insertIntoSinceMaps(Node *node)
 {
-    for (auto functions : m_functionMap) {
-        std::for_each(functions.begin(), functions.end(),
-            [&functionIndex](FunctionNode *fn) {
-                if (keep(fn))
-                    functionIndex[fn->name()].insert(fn->parent()->fullDocumentName(), fn);
-            }
-        );
+    QString sinceString = node->since();
+    // Insert a new entry into each map for each new since string found.
+    if (node->isInAPI() && !sinceString.isEmpty()) {
+        // operator[] will insert a default-constructed value into the
+        // map if key is not found, which is what we want here.
+        auto &nsmap = QDocDatabase::newSinceMaps()[sinceString];
+        auto &ncmap = QDocDatabase::newClassMaps()[sinceString];
+        auto &nqcmap = QDocDatabase::newQmlTypeMaps()[sinceString];
+
+        if (node->isFunction()) {
+            // Insert functions into the general since map.
+            auto *fn = static_cast<FunctionNode *>(node);
+            if (!fn->isDeprecated() && !fn->isSomeCtor() && !fn->isDtor())
+                nsmap.insert(fn->name(), fn);
+        } else if (node->isClassNode()) {
+            // Insert classes into the since and class maps.
+            QString name = node->qualifyWithParentName();
+            nsmap.insert(name, node);
+            ncmap.insert(name, node);
+        } else if (node->isQmlType()) {
+            // Insert QML elements into the since and element maps.
+            QString name = node->qualifyWithParentName();
+            nsmap.insert(name, node);
+            nqcmap.insert(name, node);
+        } else if (node->isQmlProperty()) {
+            // Insert QML properties into the since map.
+            nsmap.insert(node->name(), node);
+        } else {
+            // Insert external documents into the general since map.
+            QString name = node->qualifyWithParentName();
+            nsmap.insert(name, node);
+        }
     }
-
-    for (Node *node : std::as_const(m_children)) {
-        if (node->isAggregate() && !node->isPrivate() && !node->isDontDocument())
-            static_cast<Aggregate *>(node)->findAllFunctions(functionIndex);
+    // Enum values - a special case as EnumItem is not a Node subclass
+    if (node->isInAPI() && node->isEnumType()) {
+        for (const auto &val : static_cast<EnumNode *>(node)->items()) {
+            sinceString = val.since();
+            if (sinceString.isEmpty())
+                continue;
+            // Insert to enum value map
+            QDocDatabase::newEnumValueMaps()[sinceString].insert(
+                    node->name() + "::" + val.name(), node);
+            // Ugly hack: Insert into general map with an empty key -
+            // we need something in there to mark the corresponding
+            // section populated. See Sections class constructor.
+            QDocDatabase::newSinceMaps()[sinceString].replace(QString(), node);
+        }
     }
 }
 
 /*!
-  For each child of this node, if the child is a namespace node,
-  insert the child into the \a namespaces multimap. If the child
-  is an aggregate, call this function recursively for that child.
-
-  When the function called with the root node of a tree, it finds
-  all the namespace nodes in that tree and inserts them into the
-  \a namespaces multimap.
-
-  The root node of a tree is a namespace, but it has no name, so
-  it is not inserted into the map. So, if this function is called
-  for each tree in the qdoc database, it finds all the namespace
-  nodes in the database.
-  */
-void Aggregate::findAllNamespaces(NodeMultiMap &namespaces)
+  Walks this aggregate and its descendants once, running each
+  collector selected by \a flags on the nodes it applies to, and
+  inserts the nodes found into the maps of the QDocDatabase.
+  Functions go into \a functionIndex, attribution pages into
+  \a attributions, and nodes with legalese text into
+  \a legaleseTexts.
+
+  Each collector descends into the same children, and in the same
+  order, as it would in a walk of its own, so the maps do not depend
+  on which collectors run together. A child is only entered if at
+  least one collector needs to look inside it.
+
+  The function index only includes functions that are in the public
+  API and that are not constructors or destructors.
+ */
+void Aggregate::findAll(FindFlags flags, NodeMapMap &functionIndex,
+                        NodeMultiMap &attributions,
+                        QMultiMap<Text, const Node *> &legaleseTexts)
 {
-    for (auto *node : std::as_const(m_children)) {
-        if (node->isAggregate() && !node->isPrivate()) {
-            if (node->isNamespace() && !node->name().isEmpty())
-                namespaces.insert(node->name(), node);
-            static_cast<Aggregate *>(node)->findAllNamespaces(namespaces);
+    if (flags & FindFunctions) {
+        for (auto functions : m_functionMap) {
+            std::for_each(functions.begin(), functions.end(),
+                [&functionIndex](FunctionNode *fn) {
+                    if (keep(fn))
+                        functionIndex[fn->name()].insert(fn->parent()->fullDocumentName(), fn);
+                }
+            );
         }
     }
-}
 
-/*!
-  Returns true if this aggregate contains at least one child
-  that is marked obsolete. Otherwise returns false.
- */
-bool Aggregate::hasObsoleteMembers() const
-{
-    for (const auto *node : m_children)
-        if (!node->isPrivate() && node->isDeprecated()) {
-            if (node->isFunction() || node->isProperty() || node->isEnumType() || node->isTypedef()
-                || node->isTypeAlias() || node->isVariable() || node->isQmlProperty())
-                return true;
+    for (auto *node : std::as_const(m_children)) {
+        const bool isAggregate = node->isAggregate();
+        FindFlags childFlags;
+
+        if ((flags & FindClasses) && !node->isPrivate() && !node->isInternal()
+            && !node->isDontDocument()
+            && node->tree()->camelCaseModuleName() != QString("QDoc")) {
+            if (node->isClassNode()) {
+                QDocDatabase::cppClasses().insert(node->qualifyCppName().toLower(), node);
+            } else if (node->isQmlType()) {
+                QString name = node->name().toLower();
+                QDocDatabase::qmlTypes().insert(name, node);
+                // also add to the QML basic type map
+                if (node->isQmlBasicType())
+                    QDocDatabase::qmlBasicTypes().insert(name, node);
+            } else if (node->isExample()) {
+                // use the module index title as key for the example map
+                QString title = node->tree()->indexTitle();
+                if (!QDocDatabase::examples().contains(title, node))
+                    QDocDatabase::examples().insert(title, node);
+            } else if (isAggregate) {
+                childFlags |= FindClasses;
+            }
         }
-    return false;
-}
 
-/*!
-  Finds all the obsolete C++ classes and QML types in this
-  aggregate and all the C++ classes and QML types with obsolete
-  members, and inserts them into maps used elsewhere for
-  generating documentation.
- */
-void Aggregate::findAllObsoleteThings()
-{
-    for (auto *node : std::as_const(m_children)) {
-        if (!node->isPrivate()) {
+        if ((flags & FindFunctions) && isAggregate && !node->isPrivate()
+            && !node->isDontDocument())
+            childFlags |= FindFunctions;
+
+        if ((flags & FindObsoleteThings) && !node->isPrivate()) {
             if (node->isDeprecated()) {
                 if (node->isClassNode())
                     QDocDatabase::obsoleteClasses().insert(node->qualifyCppName(), node);
@@ -549,125 +595,75 @@ void Aggregate::findAllObsoleteThings()
                 if (a->hasObsoleteMembers())
                     QDocDatabase::qmlTypesWithObsoleteMembers().insert(node->qualifyQmlName(),
                                                                        node);
-            } else if (node->isAggregate()) {
-                static_cast<Aggregate *>(node)->findAllObsoleteThings();
+            } else if (isAggregate) {
+                childFlags |= FindObsoleteThings;
             }
         }
-    }
-}
 
-/*!
-  Finds all the C++ classes, QML types, QML basic types, and examples
-  in this aggregate and inserts them into appropriate maps for later
-  use in generating documentation.
- */
-void Aggregate::findAllClasses()
-{
-    for (auto *node : std::as_const(m_children)) {
-        if (!node->isPrivate() && !node->isInternal() && !node->isDontDocument()
-            && node->tree()->camelCaseModuleName() != QString("QDoc")) {
-            if (node->isClassNode()) {
-                QDocDatabase::cppClasses().insert(node->qualifyCppName().toLower(), node);
-            } else if (node->isQmlType()) {
-                QString name = node->name().toLower();
-                QDocDatabase::qmlTypes().insert(name, node);
-                // also add to the QML basic type map
-                if (node->isQmlBasicType())
-                    QDocDatabase::qmlBasicTypes().insert(name, node);
-            } else if (node->isExample()) {
-                // use the module index title as key for the example map
-                QString title = node->tree()->indexTitle();
-                if (!QDocDatabase::examples().contains(title, node))
-                    QDocDatabase::examples().insert(title, node);
-            } else if (node->isAggregate()) {
-                static_cast<Aggregate *>(node)->findAllClasses();
-            }
+        if ((flags & FindLegaleseTexts) && !node->isPrivate()) {
+            if (!node->doc().legaleseText().isEmpty())
+                legaleseTexts.insert(node->doc().legaleseText(), node);
+            if (isAggregate)
+                childFlags |= FindLegaleseTexts;
+        }
+
+        if ((flags & FindAttributions) && !node->isPrivate()) {
+            if (node->isPageNode() && static_cast<PageNode *>(node)->isAttribution())
+                attributions.insert(node->tree()->indexTitle(), node);
+            else if (isAggregate)
+                childFlags |= FindAttributions;
+        }
+
+        if ((flags & FindSince) && !(node->isRelatedNonmember() && node->parent() != this)) {
+            insertIntoSinceMaps(node);
+            if (isAggregate)
+                childFlags |= FindSince;
         }
+
+        if (childFlags)
+            static_cast<Aggregate *>(node)->findAll(childFlags, functionIndex, attributions,
+                                                    legaleseTexts);
     }
 }
 
 /*!
-  Find all the attribution pages in this node and insert them
-  into \a attributions.
- */
-void Aggregate::findAllAttributions(NodeMultiMap &attributions)
+  For each child of this node, if the child is a namespace node,
+  insert the child into the \a namespaces multimap. If the child
+  is an aggregate, call this function recursively for that child.
+
+  When the function called with the root node of a tree, it finds
+  all the namespace nodes in that tree and inserts them into the
+  \a namespaces multimap.
+
+  The root node of a tree is a namespace, but it has no name, so
+  it is not inserted into the map. So, if this function is called
+  for each tree in the qdoc database, it finds all the namespace
+  nodes in the database.
+  */
+void Aggregate::findAllNamespaces(NodeMultiMap &namespaces)
 {
     for (auto *node : std::as_const(m_children)) {
-        if (!node->isPrivate()) {
-            if (node->isPageNode() && static_cast<PageNode*>(node)->isAttribution())
-                attributions.insert(node->tree()->indexTitle(), node);
-            else if (node->isAggregate())
-                static_cast<Aggregate *>(node)->findAllAttributions(attributions);
+        if (node->isAggregate() && !node->isPrivate()) {
+            if (node->isNamespace() && !node->name().isEmpty())
+                namespaces.insert(node->name(), node);
+            static_cast<Aggregate *>(node)->findAllNamespaces(namespaces);
         }
     }
 }
 
 /*!
-  Finds all the nodes in this node where a \e{since} command appeared
-  in the qdoc comment and sorts them into maps according to the kind
-  of node.
-
-  This function is used for generating the "New Classes... in x.y"
-  section on the \e{What's New in Qt x.y} page.
+  Returns true if this aggregate contains at least one child
+  that is marked obsolete. Otherwise returns false.
  */
-void Aggregate::findAllSince()
+bool Aggregate::hasObsoleteMembers() const
 {
-    for (auto *node : std::as_const(m_children)) {
-        if (node->isRelatedNonmember() && node->parent() != this)
-            continue;
-        QString sinceString = node->since();
-        // Insert a new entry into each map for each new since string found.
-        if (node->isInAPI() && !sinceString.isEmpty()) {
-            // operator[] will insert a default-constructed value into the
-            // map if key is not found, which is what we want here.
-            auto &nsmap = QDocDatabase::newSinceMaps()[sinceString];
-            auto &ncmap = QDocDatabase::newClassMaps()[sinceString];
-            auto &nqcmap = QDocDatabase::newQmlTypeMaps()[sinceString];
-
-            if (node->isFunction()) {
-                // Insert functions into the general since map.
-                auto *fn = static_cast<FunctionNode *>(node);
-                if (!fn->isDeprecated() && !fn->isSomeCtor() && !fn->isDtor())
-                    nsmap.insert(fn->name(), fn);
-            } else if (node->isClassNode()) {
-                // Insert classes into the since and class maps.
-                QString name = node->qualifyWithParentName();
-                nsmap.insert(name, node);
-                ncmap.insert(name, node);
-            } else if (node->isQmlType()) {
-                // Insert QML elements into the since and element maps.
-                QString name = node->qualifyWithParentName();
-                nsmap.insert(name, node);
-                nqcmap.insert(name, node);
-            } else if (node->isQmlProperty()) {
-                // Insert QML properties into the since map.
-                nsmap.insert(node->name(), node);
-            } else {
-                // Insert external documents into the general since map.
-                QString name = node->qualifyWithParentName();
-                nsmap.insert(name, node);
-            }
-        }
-        // Enum values - a special case as EnumItem is not a Node subclass
-        if (node->isInAPI() && node->isEnumType()) {
-            for (const auto &val : static_cast<EnumNode *>(node)->items()) {
-                sinceString = val.since();
-                if (sinceString.isEmpty())
-                    continue;
-                // Insert to enum value map
-                QDocDatabase::newEnumValueMaps()[sinceString].insert(
-                        node->name() + "::" + val.name(), node);
-                // Ugly hack: Insert into general map with an empty key -
-                // we need something in there to mark the corresponding
-                // section populated. See Sections class constructor.
-                QDocDatabase::newSinceMaps()[sinceString].replace(QString(), node);
-            }
+    for (const auto *node : m_children)
+        if (!node->isPrivate() && node->isDeprecated()) {
+            if (node->isFunction() || node->isProperty() || node->isEnumType() || node->isTypedef()
+                || node->isTypeAlias() || node->isVariable() || node->isQmlProperty())
+                return true;
         }
-
-        // Recursively find child nodes with since commands.
-        if (node->isAggregate())
-            static_cast<Aggregate *>(node)->findAllSince();
-    }
+    return false;
 }
 
 /*!
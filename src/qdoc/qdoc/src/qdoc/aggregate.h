@@ -17,12 +17,24 @@ QT_BEGIN_NAMESPACE
 class FunctionNode;
 class QmlTypeNode;
 class QmlPropertyNode;
+class Text;
 
 class Aggregate : public PageNode
 {
 public:
     using FunctionMap = QMap<QString, std::vector<FunctionNode*>>;
 
+    enum FindFlag : unsigned char {
+        FindClasses         = 0x01,
+        FindFunctions       = 0x02,
+        FindObsoleteThings  = 0x04,
+        FindLegaleseTexts   = 0x08,
+        FindSince           = 0x10,
+        FindAttributions    = 0x20,
+        FindAll             = 0x3f
+    };
+    Q_DECLARE_FLAGS(FindFlags, FindFlag)
+
     [[nodiscard]] Node *findChildNode(const QString &name, Node::Genus genus,
                                       int findFlags = 0) const;
     Node *findNonfunctionChild(const QString &name, bool (Node::*)() const);
@@ -57,13 +69,10 @@ public:
     void adoptChild(Node *child);
 
     FunctionMap &functionMap() { return m_functionMap; }
-    void findAllFunctions(NodeMapMap &functionIndex);
+    void findAll(FindFlags flags, NodeMapMap &functionIndex, NodeMultiMap &attributions,
+                 QMultiMap<Text, const Node *> &legaleseTexts);
     void findAllNamespaces(NodeMultiMap &namespaces);
-    void findAllAttributions(NodeMultiMap &attributions);
     [[nodiscard]] bool hasObsoleteMembers() const;
-    void findAllObsoleteThings();
-    void findAllClasses();
-    void findAllSince();
     void resolveQmlInheritance();
     bool hasOverloads(const FunctionNode *fn) const;
     void appendToRelatedByProxy(const NodeList &t) { m_relatedByProxy.append(t); }
@@ -113,6 +122,8 @@ private:
     NodeList m_nonfunctionList {};
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(Aggregate::FindFlags)
+
 QT_END_NAMESPACE
 
 #endif // AGGREGATE_H
@@ -109,35 +109,35 @@ public:
 
     friend class LinkAtom;
 
-    explicit Atom(AtomType type, const QString &string = "") : m_type(type), m_strs(string) { }
+    explicit Atom(AtomType type, const QString &string = "") : m_type(type), m_str(string) { }
 
-    Atom(AtomType type, const QString &p1, const QString &p2) : m_type(type), m_strs(p1)
+    Atom(AtomType type, const QString &p1, const QString &p2) : m_type(type), m_str(p1)
     {
         if (!p2.isEmpty())
-            m_strs << p2;
+            m_extraStrs << p2;
     }
 
     Atom(Atom *previous, AtomType type, const QString &string)
-        : m_next(previous->m_next), m_type(type), m_strs(string)
+        : m_next(previous->m_next), m_type(type), m_str(string)
     {
         previous->m_next = this;
     }
 
     Atom(Atom *previous, AtomType type, const QString &p1, const QString &p2)
-        : m_next(previous->m_next), m_type(type), m_strs(p1)
+        : m_next(previous->m_next), m_type(type), m_str(p1)
     {
         if (!p2.isEmpty())
-            m_strs << p2;
+            m_extraStrs << p2;
         previous->m_next = this;
     }
 
     virtual ~Atom() = default;
 
-    void appendChar(QChar ch) { m_strs[0] += ch; }
-    void concatenateString(const QString &string) { m_strs[0] += string; }
-    void append(const QString &string) { m_strs << string; }
-    void chopString() { m_strs[0].chop(1); }
-    void setString(const QString &string) { m_strs[0] = string; }
+    void appendChar(QChar ch) { m_str += ch; }
+    void concatenateString(const QString &string) { m_str += string; }
+    void append(const QString &string) { m_extraStrs << string; }
+    void chopString() { m_str.chop(1); }
+    void setString(const QString &string) { m_str = string; }
     Atom *next() { return m_next; }
     void setNext(Atom *newNext) { m_next = newNext; }
 
@@ -148,11 +148,14 @@ public:
     [[nodiscard]] const Atom *next(AtomType t, const QString &s) const;
     [[nodiscard]] AtomType type() const { return m_type; }
     [[nodiscard]] QString typeString() const;
-    [[nodiscard]] const QString &string() const { return m_strs[0]; }
-    [[nodiscard]] const QString &string(int i) const { return m_strs[i]; }
-    [[nodiscard]] qsizetype count() const { return m_strs.size(); }
+    [[nodiscard]] const QString &string() const { return m_str; }
+    [[nodiscard]] const QString &string(int i) const { return i ? m_extraStrs[i - 1] : m_str; }
+    [[nodiscard]] qsizetype count() const { return 1 + m_extraStrs.size(); }
+    [[nodiscard]] const QString &lastString() const
+    {
+        return m_extraStrs.isEmpty() ? m_str : m_extraStrs.last();
+    }
     [[nodiscard]] QString linkText() const;
-    [[nodiscard]] const QStringList &strings() const { return m_strs; }
 
     [[nodiscard]] virtual bool isLinkAtom() const { return false; }
     virtual Node::Genus genus() { return Node::DontCare; }
@@ -162,7 +165,10 @@ public:
 protected:
     Atom *m_next = nullptr;
     AtomType m_type {};
-    QStringList m_strs {};
+    // Nearly all atoms have a single string, which is stored inline
+    // so that they do not need a list allocation of their own.
+    QString m_str {};
+    QStringList m_extraStrs {};
 };
 
 class LinkAtom : public Atom
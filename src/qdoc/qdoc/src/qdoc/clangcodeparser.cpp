@@ -17,14 +17,21 @@
 #include "sourcefileparser.h"
 #include "utilities.h"
 
+#include <QtCore/qcache.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qlockfile.h>
+#include <QtCore/qsavefile.h>
 #include <QtCore/qscopedvaluerollback.h>
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/qtextstream.h>
 #include <QtCore/qvarlengtharray.h>
 
+#include <chrometrace_p.h>
+
 #include <clang-c/Index.h>
 
 #include <clang/AST/Decl.h>
@@ -41,10 +48,17 @@
 #include "clang/AST/QualTypeNames.h"
 #include "template_declaration.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 struct CompilationIndex {
     CXIndex index = nullptr;
 
@@ -439,47 +453,71 @@ static Access fromCX_CXXAccessSpecifier(CX_CXXAccessSpecifier spec)
     }
 }
 
-/*!
-   Returns the spelling in the file for a source range
+/*
+  The contents of a source file, mapped into memory where possible.
  */
-
 struct FileCacheEntry
 {
-    QByteArray fileName;
+    QFile file;
     QByteArray content;
 };
 
 static inline QString fromCache(const QByteArray &cache,
                                 unsigned int offset1, unsigned int offset2)
 {
-    return QString::fromUtf8(cache.mid(offset1, offset2 - offset1));
+    if (qsizetype(offset1) >= cache.size())
+        return QString();
+    const qsizetype end = std::min(qsizetype(offset2), cache.size());
+    return QString::fromUtf8(QByteArrayView(cache).sliced(offset1, end - offset1));
+}
+
+/*
+  Returns a key identifying \a cxFile across translation units, as
+  CXFile handles are only valid for the translation unit they belong to.
+ */
+static QByteArray fileCacheKey(CXFile cxFile, const QByteArray &fileName)
+{
+    CXFileUniqueID id;
+    if (clang_getFileUniqueID(cxFile, &id) == 0)
+        return QByteArray(reinterpret_cast<const char *>(id.data), sizeof(id.data));
+    return fileName;
 }
 
 static QString readFile(CXFile cxFile, unsigned int offset1, unsigned int offset2)
 {
-    using FileCache = QList<FileCacheEntry>;
-    static FileCache cache;
+    // Keep the contents of the recently read files up to a total size,
+    // as the declarations and comments of a header are read repeatedly.
+    static QCache<QByteArray, FileCacheEntry> cache(64 * 1024 * 1024);
 
     CXString cxFileName = clang_getFileName(cxFile);
     const QByteArray fileName = clang_getCString(cxFileName);
     clang_disposeString(cxFileName);
 
-    for (const auto &entry : std::as_const(cache)) {
-        if (fileName == entry.fileName)
-            return fromCache(entry.content, offset1, offset2);
-    }
+    const QByteArray key = fileCacheKey(cxFile, fileName);
+    if (const FileCacheEntry *entry = cache.object(key))
+        return fromCache(entry->content, offset1, offset2);
 
-    QFile file(QString::fromUtf8(fileName));
-    if (file.open(QIODeviceBase::ReadOnly)) { // binary to match clang offsets
-        FileCacheEntry entry{fileName, file.readAll()};
-        cache.prepend(entry);
-        while (cache.size() > 5)
-            cache.removeLast();
-        return fromCache(entry.content, offset1, offset2);
-    }
-    return {};
+    auto entry = std::make_unique<FileCacheEntry>();
+    entry->file.setFileName(QString::fromUtf8(fileName));
+    if (!entry->file.open(QIODeviceBase::ReadOnly)) // binary to match clang offsets
+        return {};
+
+    const qint64 size = entry->file.size();
+    if (uchar *data = size > 0 ? entry->file.map(0, size) : nullptr)
+        entry->content = QByteArray::fromRawData(reinterpret_cast<const char *>(data), size);
+    else
+        entry->content = entry->file.readAll();
+
+    const QString spelling = fromCache(entry->content, offset1, offset2);
+    const qsizetype cost = std::max(entry->content.size(), qsizetype(1));
+    if (cost <= cache.maxCost())
+        cache.insert(key, entry.release(), cost);
+    return spelling;
 }
 
+/*!
+   Returns the spelling in the file for a source range
+ */
 static QString getSpelling(CXSourceRange range)
 {
     auto start = clang_getRangeStart(range);
@@ -559,11 +597,39 @@ static QString reconstructQualifiedPathForCursor(CXCursor cur)
     return path;
 }
 
+// The nodes found by findNodeForCursor(), by the USR of the cursor.
+// Cleared by ClangCodeParser for every documentation project, as the
+// nodes belong to the primary tree of the project.
+static QHash<QByteArray, Node *> s_nodesByUsr;
+
+static Node *lookUpNodeForCursor(QDocDatabase *qdb, CXCursor cur);
+
 /*!
   Find the node from the QDocDatabase \a qdb that corresponds to the declaration
   represented by the cursor \a cur, if it exists.
+
+  As the same declarations are looked up repeatedly, for their own
+  cursors and as the semantic parents of others, the nodes found are
+  kept by the unified symbol resolution (USR) of their cursor.
  */
 static Node *findNodeForCursor(QDocDatabase *qdb, CXCursor cur)
+{
+    CXString cxUsr = clang_getCursorUSR(cur);
+    const QByteArray usr = clang_getCString(cxUsr);
+    clang_disposeString(cxUsr);
+    if (usr.isEmpty())
+        return lookUpNodeForCursor(qdb, cur);
+
+    if (const auto it = s_nodesByUsr.constFind(usr); it != s_nodesByUsr.cend())
+        return *it;
+
+    Node *node = lookUpNodeForCursor(qdb, cur);
+    if (node)
+        s_nodesByUsr.insert(usr, node);
+    return node;
+}
+
+static Node *lookUpNodeForCursor(QDocDatabase *qdb, CXCursor cur)
 {
     auto kind = clang_getCursorKind(cur);
     if (clang_isInvalid(kind))
@@ -784,6 +850,26 @@ public:
         return ret ? CXChildVisit_Break : CXChildVisit_Continue;
     }
 
+    /*
+      Like visitFnArg(), but only visits the declarations on the
+      lines \a firstLine to \a lastLine of the main file.
+     */
+    CXChildVisitResult visitFnArg(CXCursor cursor, Node **fnNode, bool &ignoreSignature,
+                                  unsigned firstLine, unsigned lastLine)
+    {
+        auto ret = visitChildrenLambda(cursor, [&](CXCursor cur) {
+            auto loc = clang_getCursorLocation(cur);
+            if (!clang_Location_isFromMainFile(loc))
+                return CXChildVisit_Continue;
+            unsigned line = 0;
+            clang_getPresumedLocation(loc, nullptr, &line, nullptr);
+            if (line < firstLine || line > lastLine)
+                return CXChildVisit_Continue;
+            return visitFnSignature(cur, loc, fnNode, ignoreSignature);
+        });
+        return ret ? CXChildVisit_Break : CXChildVisit_Continue;
+    }
+
     Node *nodeForCommentAtLocation(CXSourceLocation loc, CXSourceLocation nextCommentLoc);
 
 private:
@@ -927,6 +1013,19 @@ CXChildVisitResult ClangVisitor::visitFnSignature(CXCursor cursor, CXSourceLocat
     return CXChildVisit_Continue;
 }
 
+/*!
+    Creates or updates the node for the declaration at \a cursor, found
+    in one of the module's headers at \a loc.
+
+    The nodes found here are not cached per header across runs. They
+    cannot be rebuilt from a summary of one header. Parameters, template
+    declarations, base classes and overrides point at nodes of other
+    headers and trees, and are resolved through findNodeForCursor() while
+    the AST is walked. Declarations already found through another
+    translation unit are skipped, so what a header contributes also
+    depends on the order in which headers are visited. What is reused
+    across runs is the precompiled module header, see -pch-cache-dir.
+ */
 CXChildVisitResult ClangVisitor::visitHeader(CXCursor cursor, CXSourceLocation loc)
 {
     auto kind = clang_getCursorKind(cursor);
@@ -1466,6 +1565,96 @@ Node *ClangVisitor::nodeForCommentAtLocation(CXSourceLocation loc, CXSourceLocat
     return node;
 }
 
+/*!
+  \internal
+  \class TranslationUnitPrefetcher
+
+  Parses translation units with libclang on worker threads, ahead of
+  the calls to ClangCodeParser::parse_cpp_file() that need them.
+
+  Only clang_parseTranslationUnit2() runs on the workers, each with its
+  own CXIndex. Visiting the resulting translation units, which creates
+  nodes in the QDocDatabase and parses the documentation comments,
+  still happens on the calling thread in source order, so the output
+  is identical to that of a serial run.
+
+  At most \c jobs translation units are parsed or waiting to be taken
+  at any time, which bounds the memory used by parsed ASTs.
+ */
+class TranslationUnitPrefetcher
+{
+public:
+    struct Result
+    {
+        CompilationIndex index;
+        TranslationUnit tu;
+        CXErrorCode error { CXError_Failure };
+        std::vector<const char *> args;
+    };
+    using ArgumentsForFile = std::function<std::vector<const char *>(const QString &)>;
+
+    TranslationUnitPrefetcher(std::vector<QString> filePaths, int jobs,
+                              ArgumentsForFile argumentsForFile)
+        : m_filePaths{std::move(filePaths)},
+          m_jobs{jobs},
+          m_argumentsForFile{std::move(argumentsForFile)}
+    {
+        fill();
+    }
+
+    /*!
+      Returns the parsed translation unit for \a filePath, waiting for
+      it if necessary, or \nullptr if \a filePath is not the next file
+      in the prefetch order.
+     */
+    std::unique_ptr<Result> take(const QString &filePath)
+    {
+        if (m_pending.empty() || m_pending.front().first != filePath)
+            return nullptr;
+
+        std::unique_ptr<Result> result = m_pending.front().second.get();
+        m_pending.pop_front();
+        fill();
+        return result;
+    }
+
+    static std::unique_ptr<Result> parse(const QString &filePath,
+                                         std::vector<const char *> args)
+    {
+        const auto flags = static_cast<CXTranslationUnit_Flags>(
+                CXTranslationUnit_Incomplete | CXTranslationUnit_SkipFunctionBodies
+                | CXTranslationUnit_KeepGoing);
+
+        const ChromeTrace::Span span("clang parse"_L1, filePath);
+        auto result = std::make_unique<Result>();
+        result->args = std::move(args);
+        result->index.index = clang_createIndex(1, kClangDontDisplayDiagnostics);
+        result->error = clang_parseTranslationUnit2(
+                result->index, filePath.toLocal8Bit().constData(), result->args.data(),
+                static_cast<int>(result->args.size()), nullptr, 0, flags, &result->tu.tu);
+        return result;
+    }
+
+private:
+    void fill()
+    {
+        while (m_pending.size() < static_cast<size_t>(m_jobs) && m_next < m_filePaths.size()) {
+            const QString &filePath = m_filePaths[m_next++];
+            // Arguments are computed here, on the calling thread, as
+            // they depend on Config.
+            m_pending.emplace_back(filePath,
+                                   std::async(std::launch::async, &TranslationUnitPrefetcher::parse,
+                                              filePath, m_argumentsForFile(filePath)));
+        }
+    }
+
+    std::vector<QString> m_filePaths;
+    size_t m_next { 0 };
+    int m_jobs { 1 };
+    ArgumentsForFile m_argumentsForFile;
+    std::deque<std::pair<QString, std::future<std::unique_ptr<Result>>>> m_pending;
+};
+
 ClangCodeParser::ClangCodeParser(
     QDocDatabase* qdb,
     Config& config,
@@ -1478,6 +1667,34 @@ ClangCodeParser::ClangCodeParser(
     m_pch{pch}
 {
     m_allHeaders = config.getHeaderFiles();
+    s_nodesByUsr.clear();
+}
+
+ClangCodeParser::~ClangCodeParser()
+{
+    s_nodesByUsr.clear();
+}
+
+/*!
+  Starts parsing the translation units for the C++ source files in
+  \a filePaths on up to \a jobs worker threads. \a filePaths must be
+  in the order in which parse_cpp_file() is later called for them;
+  files that are requested out of that order are parsed on demand.
+
+  Does nothing if \a jobs is less than two.
+ */
+void ClangCodeParser::prefetch(const std::vector<QString> &filePaths, int jobs)
+{
+    if (jobs < 2 || filePaths.empty()) {
+        m_prefetcher.reset();
+        return;
+    }
+
+    qCDebug(lcQdoc) << "Parsing" << filePaths.size() << "translation units using" << jobs
+                    << "threads";
+    m_prefetcher = std::make_unique<TranslationUnitPrefetcher>(
+            filePaths, jobs,
+            [this](const QString &filePath) { return argumentsForFile(filePath); });
 }
 
 static const char *defaultArgs_[] = {
@@ -1565,17 +1782,109 @@ void getMoreArgs(
     }
 }
 
+/*!
+  \internal
+
+  Returns a key that identifies a precompiled module header in the
+  PCH cache. The key covers the libclang version, the clang
+  \a arguments, and the contents of the synthesized module header
+  \a headerContents. The headers the PCH is built from are checked
+  separately, with pchDependencies().
+ */
+static QByteArray pchCacheKey(const std::vector<const char *> &arguments,
+                              const QByteArray &headerContents)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(fromCXString(clang_getClangVersion()).toUtf8());
+    for (const char *argument : arguments) {
+        hash.addData(QByteArrayView(argument));
+        hash.addData(QByteArrayView("", 1));
+    }
+    hash.addData(headerContents);
+    return hash.result().toHex();
+}
+
+/*!
+  \internal
+
+  Returns a line with the size, modification time, and path of the
+  file \a fileInfo.
+ */
+static QByteArray fileStamp(const QFileInfo &fileInfo)
+{
+    return QByteArray::number(fileInfo.size()) + ' '
+            + QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()) + ' '
+            + fileInfo.absoluteFilePath().toUtf8() + '\n';
+}
+
+/*!
+  \internal
+
+  Returns the stamps of all files the translation unit \a tu was
+  built from, including every header it includes directly or
+  indirectly, sorted by path.
+ */
+static QByteArray pchDependencies(CXTranslationUnit tu)
+{
+    QStringList files;
+    clang_getInclusions(
+            tu,
+            [](CXFile file, CXSourceLocation *, unsigned, CXClientData data) {
+                static_cast<QStringList *>(data)->append(fromCXString(clang_getFileName(file)));
+            },
+            &files);
+    files.sort();
+    files.removeDuplicates();
+
+    QByteArray dependencies;
+    for (const QString &file : std::as_const(files))
+        dependencies += fileStamp(QFileInfo(file));
+    return dependencies;
+}
+
+/*!
+  \internal
+
+  Returns \c true if all files listed in \a dependencyFile, written
+  from pchDependencies(), are unchanged.
+ */
+static bool pchDependenciesUpToDate(const QString &dependencyFile)
+{
+    QFile file(dependencyFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        const qsizetype sizeEnd = line.indexOf(' ');
+        const qsizetype timeEnd = sizeEnd < 0 ? -1 : line.indexOf(' ', sizeEnd + 1);
+        if (timeEnd < 0 || !line.endsWith('\n'))
+            return false;
+        const QByteArray path = line.sliced(timeEnd + 1).chopped(1);
+        if (fileStamp(QFileInfo(QString::fromUtf8(path))) != line)
+            return false;
+    }
+    return true;
+}
+
 /*!
   Building the PCH must be possible when there are no .cpp
   files, so it is moved here to its own member function, and
   it is called after the list of header files is complete.
+
+  If \a cache_dir is not empty, the PCH is stored in a
+  subdirectory of \a cache_dir named after the module and a
+  hash of the clang version and arguments, and reused by later
+  runs as long as none of the headers it was built from has
+  changed since. Concurrent qdoc processes serialize on a lock
+  file in that subdirectory while the PCH is being built.
  */
 std::optional<PCHFile> buildPCH(
     QDocDatabase* qdb,
     QString module_header,
     const std::set<Config::HeaderFilePath>& all_headers,
     const std::vector<QByteArray>& include_paths,
-    const QList<QByteArray>& defines
+    const QList<QByteArray>& defines,
+    const QString& cache_dir
 ) {
     static std::vector<const char*> arguments{};
 
@@ -1641,31 +1950,82 @@ std::optional<PCHFile> buildPCH(
     }
     arguments.push_back("-xc++");
 
-    TranslationUnit tu;
+    QByteArray headerContents;
+    if (header.isEmpty()) {
+        for (const auto& [header_path, header_name] : all_headers) {
+            if (!header_name.endsWith(QLatin1String("_p.h"))
+                && !header_name.startsWith(QLatin1String("moc_"))) {
+                headerContents += "#include \"" + header_path.toUtf8() + "/"
+                        + header_name.toUtf8() + "\"\n";
+            }
+        }
+    } else {
+        QFileInfo headerFile(header);
+        if (!headerFile.exists()) {
+            qWarning() << "Could not find module header file" << header;
+            return std::nullopt;
+        }
+        headerContents = "#include \"" + header + "\"";
+    }
 
-    QString tmpHeader = pch_directory.path() + "/" + module;
-    if (QFile tmpHeaderFile(tmpHeader); tmpHeaderFile.open(QIODevice::Text | QIODevice::WriteOnly)) {
-        QTextStream out(&tmpHeaderFile);
-        if (header.isEmpty()) {
-            for (const auto& [header_path, header_name] : all_headers) {
-                if (!header_name.endsWith(QLatin1String("_p.h"))
-                    && !header_name.startsWith(QLatin1String("moc_"))) {
-                    QString line = QLatin1String("#include \"") + header_path
-                            + QLatin1String("/") + header_name + QLatin1String("\"");
-                    out << line << "\n";
+    // Visit the header now, as token from pre-compiled header won't be visited
+    // later
+    const auto visitPCH = [&](CXTranslationUnit tu) {
+        CXCursor cur = clang_getTranslationUnitCursor(tu);
+        ClangVisitor visitor(qdb, all_headers);
+        visitor.visitChildren(cur);
+        qCDebug(lcQdoc) << "PCH built and visited for" << module_header;
+    };
 
-                }
+    QString pch_path = pch_directory.path();
+    std::unique_ptr<QLockFile> cache_lock;
+    if (!cache_dir.isEmpty()) {
+        const QString entry = cache_dir + QLatin1Char('/') + module_header + QLatin1Char('-')
+                + QString::fromLatin1(pchCacheKey(arguments, headerContents));
+        if (QDir().mkpath(entry)) {
+            cache_lock = std::make_unique<QLockFile>(entry + QLatin1String("/.lock"));
+            // Building the PCH for a large module can take minutes; only
+            // consider the lock stale if its owner is gone.
+            cache_lock->setStaleLockTime(0);
+            if (cache_lock->lock()) {
+                pch_path = entry;
+            } else {
+                qCWarning(lcQdoc) << "Could not lock PCH cache entry" << entry;
+                cache_lock.reset();
             }
         } else {
-            QFileInfo headerFile(header);
-            if (!headerFile.exists()) {
-                qWarning() << "Could not find module header file" << header;
-                return std::nullopt;
-            }
-            out << QLatin1String("#include \"") + header + QLatin1String("\"");
+            qCWarning(lcQdoc) << "Could not create PCH cache directory" << entry;
         }
     }
 
+    QByteArray pch_name = pch_path.toUtf8() + "/" + module + ".pch";
+    // Lists the stamps of every file the cached PCH was built from
+    const QString dependency_file = QString::fromUtf8(pch_name) + QLatin1String(".deps");
+
+    if (cache_lock && QFile::exists(QString::fromUtf8(pch_name))
+        && pchDependenciesUpToDate(dependency_file)) {
+        cache_lock->unlock();
+        TranslationUnit tu;
+        if (clang_createTranslationUnit2(index, pch_name.constData(), &tu.tu) == CXError_Success
+            && tu) {
+            qCDebug(lcQdoc) << "Reusing cached PCH" << pch_name << "for" << module_header;
+            visitPCH(tu);
+            return std::make_optional(PCHFile{std::move(pch_directory), pch_name});
+        }
+        // Fall back to an uncached build rather than racing other
+        // processes that may be using the cache entry.
+        qCWarning(lcQdoc) << "Could not load cached PCH" << pch_name << ", rebuilding it";
+        cache_lock.reset();
+        pch_path = pch_directory.path();
+        pch_name = pch_path.toUtf8() + "/" + module + ".pch";
+    }
+
+    TranslationUnit tu;
+
+    QString tmpHeader = pch_path + "/" + module;
+    if (QFile tmpHeaderFile(tmpHeader); tmpHeaderFile.open(QIODevice::Text | QIODevice::WriteOnly))
+        tmpHeaderFile.write(headerContents);
+
     CXErrorCode err =
             clang_parseTranslationUnit2(index, tmpHeader.toLatin1().data(), arguments.data(),
                                         static_cast<int>(arguments.size()), nullptr, 0,
@@ -1680,20 +2040,35 @@ std::optional<PCHFile> buildPCH(
         return std::nullopt;
     }
 
-    QByteArray pch_name = pch_directory.path().toUtf8() + "/" + module + ".pch";
-    auto error = clang_saveTranslationUnit(tu, pch_name.constData(),
+    // Save cache entries under a temporary name so that readers never
+    // see a partially written PCH.
+    const QByteArray save_name = cache_lock ? pch_name + ".tmp" : pch_name;
+    auto error = clang_saveTranslationUnit(tu, save_name.constData(),
                                             clang_defaultSaveOptions(tu));
+    if (!error && cache_lock) {
+        // Drop the outdated entry first; the new dependencies are only
+        // written once the new PCH is in place.
+        QFile::remove(dependency_file);
+        QFile::remove(QString::fromUtf8(pch_name));
+        if (QFile::rename(QString::fromUtf8(save_name), QString::fromUtf8(pch_name))) {
+            QSaveFile dependencies(dependency_file);
+            if (dependencies.open(QIODevice::WriteOnly)) {
+                dependencies.write(pchDependencies(tu));
+                dependencies.commit();
+            }
+        } else {
+            QFile::remove(QString::fromUtf8(save_name));
+            error = CXSaveError_Unknown;
+        }
+    }
+    if (cache_lock)
+        cache_lock->unlock();
     if (error) {
         qCCritical(lcQdoc) << "Could not save PCH file for" << module_header;
         return std::nullopt;
     }
 
-    // Visit the header now, as token from pre-compiled header won't be visited
-    // later
-    CXCursor cur = clang_getTranslationUnitCursor(tu);
-    ClangVisitor visitor(qdb, all_headers);
-    visitor.visitChildren(cur);
-    qCDebug(lcQdoc) << "PCH built and visited for" << module_header;
+    visitPCH(tu);
 
     return std::make_optional(PCHFile{std::move(pch_directory), pch_name});
 }
@@ -1706,36 +2081,45 @@ static float getUnpatchedVersion(QString t)
 }
 
 /*!
-  Get ready to parse the C++ cpp file identified by \a filePath
-  and add its parsed contents to the database. \a location is
-  used for reporting errors.
+  Returns the clang arguments for parsing the C++ file \a filePath.
 
   If parsing C++ header file as source, do not use the precompiled
   header as the source file itself is likely already included in the
   PCH and therefore interferes visiting the TU's children.
  */
-ParsedCppFileIR ClangCodeParser::parse_cpp_file(const QString &filePath)
+std::vector<const char *> ClangCodeParser::argumentsForFile(const QString &filePath) const
 {
-    flags_ = static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
-                                                  | CXTranslationUnit_SkipFunctionBodies
-                                                  | CXTranslationUnit_KeepGoing);
-
-    CompilationIndex index{ clang_createIndex(1, kClangDontDisplayDiagnostics) };
-
-    getDefaultArgs(m_defines, m_args);
+    std::vector<const char *> args;
+    getDefaultArgs(m_defines, args);
     if (m_pch && !filePath.endsWith(".mm")
             && !std::holds_alternative<CppHeaderSourceFile>(tag_source_file(filePath).second)) {
-        m_args.push_back("-w");
-        m_args.push_back("-include-pch");
-        m_args.push_back((*m_pch).get().name.constData());
+        args.push_back("-w");
+        args.push_back("-include-pch");
+        args.push_back((*m_pch).get().name.constData());
     }
-    getMoreArgs(m_includePaths, m_allHeaders, m_args);
+    getMoreArgs(m_includePaths, m_allHeaders, args);
+    return args;
+}
 
-    TranslationUnit tu;
-    CXErrorCode err =
-            clang_parseTranslationUnit2(index, filePath.toLocal8Bit(), m_args.data(),
-                                        static_cast<int>(m_args.size()), nullptr, 0, flags_, &tu.tu);
-    qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << filePath << m_args
+/*!
+  Get ready to parse the C++ cpp file identified by \a filePath
+  and add its parsed contents to the database. \a location is
+  used for reporting errors.
+
+  If prefetch() was called for \a filePath, the translation unit
+  parsed on a worker thread is used.
+ */
+ParsedCppFileIR ClangCodeParser::parse_cpp_file(const QString &filePath)
+{
+    std::unique_ptr<TranslationUnitPrefetcher::Result> parsed;
+    if (m_prefetcher)
+        parsed = m_prefetcher->take(filePath);
+    if (!parsed)
+        parsed = TranslationUnitPrefetcher::parse(filePath, argumentsForFile(filePath));
+
+    TranslationUnit &tu = parsed->tu;
+    const CXErrorCode err = parsed->error;
+    qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << filePath << parsed->args
                     << ") returns" << err;
     printDiagnostics(tu);
 
@@ -1826,6 +2210,122 @@ ParsedCppFileIR ClangCodeParser::parse_cpp_file(const QString &filePath)
     return parse_result;
 }
 
+/*!
+  \internal
+  \class FnSignatureBatch
+
+  Holds a translation unit that declares the signatures of all \\fn
+  commands of a source file, each on lines of its own, so that they
+  are parsed in one go instead of one translation unit per command.
+ */
+class FnSignatureBatch
+{
+public:
+    struct Lines
+    {
+        unsigned first;
+        unsigned last;
+        bool clean;
+    };
+
+    static QString key(const QString &signature, const QStringList &context)
+    {
+        return context.join(u'\n') + u'\0' + signature;
+    }
+
+    CompilationIndex index;
+    TranslationUnit tu;
+    QHash<QString, Lines> lines;
+};
+
+/*!
+  Returns the source code that declares \a fnSignature within the
+  namespaces of \a context, for parsing it with clang.
+ */
+static QByteArray fnSignatureSource(const QString &fnSignature, const QStringList &context)
+{
+    QByteArray s_fn{};
+    for (const auto &ns : std::as_const(context))
+        s_fn.prepend("namespace " + ns.toUtf8() + " {");
+    s_fn += fnSignature.toUtf8();
+    if (!s_fn.endsWith(";"))
+        s_fn += "{ }";
+    s_fn.append(context.size(), '}');
+    return s_fn;
+}
+
+/*!
+  Parses \a signatures, the arguments of the \\fn commands of one
+  source file, as one translation unit. operator() then looks up the
+  nodes for these signatures in it, and only parses a signature on its
+  own if clang reported diagnostics for the lines of the signature or
+  the lookup failed, as declarations can affect one another.
+
+  Replaces the signatures parsed by earlier calls.
+ */
+void FnCommandParser::parseSignatures(const std::vector<Signature> &signatures)
+{
+    m_batch.reset();
+    if (signatures.size() < 2)
+        return;
+
+    auto batch = std::make_shared<FnSignatureBatch>();
+    QByteArray source;
+    // The key of the signature declared on each line, starting with line 1
+    std::vector<QString> keys{ QString() };
+    for (const auto &[signature, context] : signatures) {
+        const QString key = FnSignatureBatch::key(signature, context);
+        if (batch->lines.contains(key))
+            continue;
+        const QByteArray declaration = fnSignatureSource(signature, context);
+        const auto line = unsigned(keys.size());
+        const auto lineCount = unsigned(declaration.count('\n')) + 1;
+        batch->lines.insert(key, { line, line + lineCount - 1, true });
+        keys.insert(keys.end(), lineCount, key);
+        source += declaration + '\n';
+    }
+
+    auto flags = static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
+                                                      | CXTranslationUnit_SkipFunctionBodies
+                                                      | CXTranslationUnit_KeepGoing);
+    batch->index.index = clang_createIndex(1, kClangDontDisplayDiagnostics);
+
+    getDefaultArgs(m_defines, m_args);
+    if (m_pch) {
+        m_args.push_back("-w");
+        m_args.push_back("-include-pch");
+        m_args.push_back((*m_pch).get().name.constData());
+    }
+
+    const char *dummyFileName = fnDummyFileName;
+    CXUnsavedFile unsavedFile { dummyFileName, source.constData(),
+                                static_cast<unsigned long>(source.size()) };
+    CXErrorCode err = clang_parseTranslationUnit2(batch->index, dummyFileName, m_args.data(),
+                                                  int(m_args.size()), &unsavedFile, 1, flags,
+                                                  &batch->tu.tu);
+    qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << dummyFileName
+                    << signatures.size() << "signatures ) returns" << err;
+    if (err || !batch->tu)
+        return;
+
+    // The diagnostics are not printed here. Each of them makes the
+    // signatures it concerns be parsed on their own, which prints it.
+    for (unsigned i = 0, count = clang_getNumDiagnostics(batch->tu); i < count; ++i) {
+        CXDiagnostic diagnostic = clang_getDiagnostic(batch->tu, i);
+        CXSourceLocation loc = clang_getDiagnosticLocation(diagnostic);
+        clang_disposeDiagnostic(diagnostic);
+        unsigned diagnosticLine = 0;
+        clang_getPresumedLocation(loc, nullptr, &diagnosticLine, nullptr);
+        if (!clang_Location_isFromMainFile(loc) || diagnosticLine == 0
+            || diagnosticLine >= keys.size()) {
+            // Not attributable to a signature; parse each of them on their own
+            return;
+        }
+        batch->lines[keys[diagnosticLine]].clean = false;
+    }
+    m_batch = std::move(batch);
+}
+
 /*!
   Use clang to parse the function signature from a function
   command. \a location is used for reporting errors. \a fnSignature
@@ -1887,6 +2387,19 @@ std::variant<Node*, FnMatchError> FnCommandParser::operator()(const Location &lo
         }
         return fnNode;
     }
+
+    if (m_batch) {
+        const auto it = m_batch->lines.constFind(FnSignatureBatch::key(fnSignature, context));
+        if (it != m_batch->lines.cend() && it->clean) {
+            CXCursor cur = clang_getTranslationUnitCursor(m_batch->tu);
+            ClangVisitor visitor(m_qdb, m_allHeaders);
+            bool ignoreSignature = false;
+            visitor.visitFnArg(cur, &fnNode, ignoreSignature, it->first, it->last);
+            if (fnNode)
+                return fnNode;
+        }
+    }
+
     auto flags = static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
                                                       | CXTranslationUnit_SkipFunctionBodies
                                                       | CXTranslationUnit_KeepGoing);
@@ -1902,13 +2415,7 @@ std::variant<Node*, FnMatchError> FnCommandParser::operator()(const Location &lo
     }
 
     TranslationUnit tu;
-    QByteArray s_fn{};
-    for (const auto &ns : std::as_const(context))
-        s_fn.prepend("namespace " + ns.toUtf8() + " {");
-    s_fn += fnSignature.toUtf8();
-    if (!s_fn.endsWith(";"))
-        s_fn += "{ }";
-    s_fn.append(context.size(), '}');
+    const QByteArray s_fn = fnSignatureSource(fnSignature, context);
 
     const char *dummyFileName = fnDummyFileName;
     CXUnsavedFile unsavedFile { dummyFileName, s_fn.constData(),
@@ -11,6 +11,7 @@
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/QStringList>
 
+#include <memory>
 #include <optional>
 
 typedef struct CXTranslationUnitImpl *CXTranslationUnit;
@@ -34,10 +35,19 @@ std::optional<PCHFile> buildPCH(
     QString module_header,
     const std::set<Config::HeaderFilePath>& all_headers,
     const std::vector<QByteArray>& include_paths,
-    const QList<QByteArray>& defines
+    const QList<QByteArray>& defines,
+    const QString& cache_dir = QString()
 );
 
+class FnSignatureBatch;
+
 struct FnCommandParser {
+    // The argument of an \fn command and the namespaces it is in
+    struct Signature {
+        QString signature;
+        QStringList context;
+    };
+
     FnCommandParser(
         QDocDatabase* qdb,
         const std::set<Config::HeaderFilePath>& all_headers,
@@ -57,14 +67,19 @@ struct FnCommandParser {
         QStringList context
    );
 
+    void parseSignatures(const std::vector<Signature> &signatures);
+
 private:
     QDocDatabase* m_qdb;
     const std::set<Config::HeaderFilePath>& m_allHeaders; // file name->path
     QList<QByteArray> m_defines {};
     std::vector<const char *> m_args {};
     std::optional<std::reference_wrapper<const PCHFile>> m_pch;
+    std::shared_ptr<FnSignatureBatch> m_batch;
 };
 
+class TranslationUnitPrefetcher;
+
 class ClangCodeParser
 {
 public:
@@ -75,18 +90,24 @@ public:
         const QList<QByteArray>& defines,
         std::optional<std::reference_wrapper<const PCHFile>> pch
     );
+    ~ClangCodeParser();
 
+    void prefetch(const std::vector<QString> &filePaths, int jobs);
     ParsedCppFileIR parse_cpp_file(const QString &filePath);
 
 private:
+    std::vector<const char *> argumentsForFile(const QString &filePath) const;
+
     QDocDatabase* m_qdb{};
     std::set<Config::HeaderFilePath> m_allHeaders {}; // file name->path
     const std::vector<QByteArray>& m_includePaths;
     QList<QByteArray> m_defines {};
-    std::vector<const char *> m_args {};
     QStringList m_namespaceScope {};
     QByteArray s_fn;
     std::optional<std::reference_wrapper<const PCHFile>> m_pch;
+    // Declared last so that pending parses finish before the
+    // arguments they refer to are destroyed.
+    std::unique_ptr<TranslationUnitPrefetcher> m_prefetcher;
 };
 
 QT_END_NAMESPACE
@@ -9,6 +9,7 @@
 #include "node.h"
 #include "propertynode.h"
 #include "qmlpropertynode.h"
+#include "utilities.h"
 
 #include <QtCore/qobjectdefs.h>
 
@@ -264,61 +265,14 @@ QString CodeMarker::extraSynopsis(const Node *node, Section::Style style)
     return extraStr;
 }
 
-static const QString samp = QLatin1String("&amp;");
-static const QString slt = QLatin1String("&lt;");
-static const QString sgt = QLatin1String("&gt;");
-static const QString squot = QLatin1String("&quot;");
-
 QString CodeMarker::protect(const QString &str)
 {
-    qsizetype n = str.size();
-    QString marked;
-    marked.reserve(n * 2 + 30);
-    const QChar *data = str.constData();
-    for (int i = 0; i != n; ++i) {
-        switch (data[i].unicode()) {
-        case '&':
-            marked += samp;
-            break;
-        case '<':
-            marked += slt;
-            break;
-        case '>':
-            marked += sgt;
-            break;
-        case '"':
-            marked += squot;
-            break;
-        default:
-            marked += data[i];
-        }
-    }
-    return marked;
+    return Utilities::protect(str);
 }
 
 void CodeMarker::appendProtectedString(QString *output, QStringView str)
 {
-    qsizetype n = str.size();
-    output->reserve(output->size() + n * 2 + 30);
-    const QChar *data = str.constData();
-    for (int i = 0; i != n; ++i) {
-        switch (data[i].unicode()) {
-        case '&':
-            *output += samp;
-            break;
-        case '<':
-            *output += slt;
-            break;
-        case '>':
-            *output += sgt;
-            break;
-        case '"':
-            *output += squot;
-            break;
-        default:
-            *output += data[i];
-        }
-    }
+    Utilities::appendProtected(output, str);
 }
 
 QString CodeMarker::typified(const QString &string, bool trailingSpace)
@@ -0,0 +1,120 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "compressedoutput.h"
+
+#include "config.h"
+#include "utilities.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+#include <algorithm>
+#include <deque>
+#include <future>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+  \class CompressedOutput
+  \internal
+
+  Writes gzip-compressed copies of generated files next to them, with
+  the \c .gz suffix, when QDoc runs with \c{-precompress}. Web servers
+  can then serve the compressed copies directly instead of compressing
+  the files on every request or in a separate pass over the output.
+
+  The files are compressed on up to Config::jobs() worker threads
+  while the generators carry on.
+ */
+
+namespace {
+
+std::deque<std::future<void>> s_pending;
+
+void writeCompressed(const QString &filePath, const QByteArray &contents)
+{
+    QSaveFile file(filePath + ".gz"_L1);
+    if (!file.open(QIODevice::WriteOnly) || file.write(Utilities::gzip(contents)) < 0
+        || !file.commit()) {
+        qCWarning(lcQdoc) << "Cannot write compressed file" << file.fileName() << ":"
+                          << file.errorString();
+    }
+}
+
+} // namespace
+
+/*!
+  Returns \c true if compressed copies of the generated files are
+  written.
+ */
+bool CompressedOutput::isEnabled()
+{
+    return Config::instance().precompress();
+}
+
+/*!
+  Writes the gzip-compressed \a contents of the file at \a filePath to
+  \a filePath with the \c .gz suffix, on a worker thread if QDoc uses
+  more than one job.
+
+  The compressed copy is written in binary mode, so \a contents must be
+  the bytes of the file as they are on disk.
+ */
+void CompressedOutput::write(const QString &filePath, const QByteArray &contents)
+{
+    const size_t jobs = std::max(Config::instance().jobs(), 1);
+    if (jobs == 1) {
+        writeCompressed(filePath, contents);
+        return;
+    }
+
+    while (s_pending.size() >= jobs) {
+        s_pending.front().get();
+        s_pending.pop_front();
+    }
+    s_pending.push_back(std::async(std::launch::async, writeCompressed, filePath, contents));
+}
+
+/*!
+  Writes a compressed copy of the file at \a filePath, which was written
+  in text mode with \a contents. The copy gets the same line endings as
+  the file, so that both decompress to the same bytes.
+ */
+void CompressedOutput::writeText(const QString &filePath, const QByteArray &contents)
+{
+#ifdef Q_OS_WIN
+    write(filePath, QByteArray(contents).replace('\n', "\r\n"));
+#else
+    write(filePath, contents);
+#endif
+}
+
+/*!
+  Writes a compressed copy of the file at \a filePath, which was just
+  written or copied to the output directory.
+ */
+void CompressedOutput::writeCopy(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(lcQdoc) << "Cannot read" << filePath << "for compression:"
+                          << file.errorString();
+        return;
+    }
+    write(filePath, file.readAll());
+}
+
+/*!
+  Waits until all compressed copies are written.
+ */
+void CompressedOutput::waitForFinished()
+{
+    for (auto &pending : s_pending)
+        pending.get();
+    s_pending.clear();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,24 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef COMPRESSEDOUTPUT_H
+#define COMPRESSEDOUTPUT_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class CompressedOutput
+{
+public:
+    [[nodiscard]] static bool isEnabled();
+    static void write(const QString &filePath, const QByteArray &contents);
+    static void writeText(const QString &filePath, const QByteArray &contents);
+    static void writeCopy(const QString &filePath);
+    static void waitForFinished();
+};
+
+QT_END_NAMESPACE
+
+#endif // COMPRESSEDOUTPUT_H
@@ -4,13 +4,19 @@
 #include "config.h"
 #include "utilities.h"
 
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qtemporaryfile.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qtextstream.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qregularexpression.h>
 
+#include <algorithm>
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 QString ConfigStrings::AUTOLINKERRORS = QStringLiteral("autolinkerrors");
@@ -434,24 +440,23 @@ void Config::expandVariables()
      for (auto &configVar : m_configVars) {
         for (auto it = configVar.m_expandVars.crbegin(); it != configVar.m_expandVars.crend(); ++it) {
             Q_ASSERT(it->m_valueIndex < configVar.m_values.size());
-            const QString &key = it->m_var;
-            const auto &refVar = m_configVars.value(key);
-            if (refVar.m_name.isEmpty()) {
+            const auto ref = m_configVars.constFind(it->m_var);
+            if (ref == m_configVars.cend() || ref->m_name.isEmpty()) {
                 configVar.m_location.fatal(
                         QStringLiteral("Environment or configuration variable '%1' undefined")
                                 .arg(it->m_var));
-            } else if (!refVar.m_expandVars.empty()) {
+            }
+            const ConfigVar &refVar = *ref;
+            if (!refVar.m_expandVars.empty()) {
                 configVar.m_location.fatal(
                         QStringLiteral("Nested variable expansion not allowed"),
                         QStringLiteral("When expanding '%1' at %2:%3")
                                 .arg(refVar.m_name, refVar.m_location.filePath(),
                                      QString::number(refVar.m_location.lineNo())));
             }
-            QString expanded;
-            if (it->m_delim.isNull())
-                expanded = m_configVars.value(key).asStringList().join(QString());
-            else
-                expanded = m_configVars.value(key).asStringList().join(it->m_delim);
+            const QString expanded = it->m_delim.isNull()
+                    ? refVar.asStringList().join(QString())
+                    : refVar.asStringList().join(it->m_delim);
             configVar.m_values[it->m_valueIndex].m_value.insert(it->m_index, expanded);
         }
         configVar.m_expandVars.clear();
@@ -511,6 +516,31 @@ void Config::processCommandLineOptions(const QStringList &args)
         setStringList(CONFIG_TIMESTAMPS, QStringList("true"));
     if (m_parser.isSet(m_parser.useDocBookExtensions))
         setStringList(CONFIG_DOCBOOKEXTENSIONS, QStringList("true"));
+
+    const QString pchCacheDir = m_parser.isSet(m_parser.pchCacheDirOption)
+            ? m_parser.value(m_parser.pchCacheDirOption)
+            : qEnvironmentVariable("QDOC_PCH_CACHE_DIR");
+    if (!pchCacheDir.isEmpty())
+        m_pchCacheDir = QDir(pchCacheDir).absolutePath();
+
+    if (m_parser.isSet(m_parser.depFileOption))
+        m_depFile = QDir(m_parser.value(m_parser.depFileOption)).absolutePath();
+
+    if (m_parser.isSet(m_parser.timingReportOption))
+        m_timingReport = QDir(m_parser.value(m_parser.timingReportOption)).absolutePath();
+
+    m_precompress = m_parser.isSet(m_parser.precompressOption);
+    m_releaseDocs = m_parser.isSet(m_parser.releaseDocsOption);
+
+    if (m_parser.isSet(m_parser.jobsOption)) {
+        bool ok = false;
+        const int jobs = m_parser.value(m_parser.jobsOption).toInt(&ok);
+        if (!ok || jobs < 0)
+            qCWarning(lcQdoc) << "Ignoring invalid value for -j:"
+                              << m_parser.value(m_parser.jobsOption);
+        else
+            m_jobs = jobs ? jobs : QThread::idealThreadCount();
+    }
 }
 
 void Config::setIncludePaths()
@@ -935,6 +965,17 @@ QString Config::findFile(const Location &location, const QStringList &files,
 // output directory, split its responsabilities into smaller elements
 // instead of forcing the logic together.
 
+/*!
+  Records \a filePath as a file QDoc read, to be listed in the
+  dependency file. Does nothing unless a dependency file was
+  requested with \c{--depfile}.
+ */
+void Config::addInputFile(const QString &filePath)
+{
+    if (!m_depFile.isEmpty())
+        m_inputFiles.insert(QFileInfo(filePath).absoluteFilePath());
+}
+
 /*!
   Copies the \a sourceFilePath to the file name constructed by
   concatenating \a targetDirPath and the file name from the
@@ -954,6 +995,7 @@ QString Config::copyFile(const Location &location, const QString &sourceFilePath
     // copying files into an appropriate subsystem and have a better
     // understanding of call-site usages.
 
+    Config::instance().addInputFile(sourceFilePath);
     QFile inFile(sourceFilePath);
     if (!inFile.open(QFile::ReadOnly)) {
         location.warning(QStringLiteral("Cannot open input file for copy: '%1': %2")
@@ -1005,24 +1047,40 @@ QString Config::copyFile(const Location &location, const QString &sourceFilePath
     if (!targetDir.exists())
         targetDir.mkpath(".");
 
-    QFile outFile(outFileName);
-    if (!outFile.open(QFile::WriteOnly)) {
+    // The same images and template files are copied for every module
+    // and output format, so targets that have the contents of the
+    // source already are left alone. The hashes of the sources, and of
+    // the targets written, are computed once per process.
+    static QHash<QString, QByteArray> hashes;
+    const auto hashOf = [](const QString &filePath, QFile *file) {
+        auto it = hashes.constFind(filePath);
+        if (it != hashes.cend())
+            return *it;
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(file);
+        return *hashes.insert(filePath, hash.result());
+    };
+
+    const QByteArray sourceHash = hashOf(sourceFilePath, &inFile);
+    inFile.close();
+    if (QFile outFile(outFileName); outFile.size() == inFile.size()
+        && outFile.open(QFile::ReadOnly) && hashOf(outFileName, &outFile) == sourceHash) {
+        return outFileName;
+    }
+
+    // Let the system copy the file, which clones it on file systems
+    // that support it.
+    hashes.remove(outFileName);
+    QFile::remove(outFileName);
+    if (!inFile.copy(outFileName)) {
         // TODO: [uncrentralized-warning]
         location.warning(QStringLiteral("Cannot open output file for copy: '%1': %2")
-                                 .arg(outFileName, outFile.errorString()));
+                                 .arg(outFileName, inFile.errorString()));
         return QString();
     }
-
-    // TODO: There shouldn't be any particular advantage to copying
-    // the file by readying its content and writing it compared to
-    // asking the underlying system to do the copy for us.
-    // Consider simplifying this part by avoiding doing the manual
-    // work ourselves.
-
-    char buffer[1024];
-    qsizetype len;
-    while ((len = inFile.read(buffer, sizeof(buffer))) > 0)
-        outFile.write(buffer, len);
+    // Copies of read-only sources would otherwise be read-only
+    QFile::setPermissions(outFileName, QFile::permissions(outFileName) | QFile::WriteOwner);
+    hashes.insert(outFileName, sourceHash);
     return outFileName;
 }
 
@@ -1082,16 +1140,101 @@ QStringList Config::loadMaster(const QString &fileName)
     return qdocFiles;
 }
 
+/*
+  One statement of a qdoc configuration file: either an \c{include}
+  of another file, or an assignment of values to one or more keys.
+ */
+struct ConfigStatement
+{
+    int lineNo { 1 };
+    int columnNo { 1 };
+    QString includeFile {};
+    QStringList keys {};
+    bool plus { false };
+    QStringList values {};
+    QList<ExpandVar> expandVars {};
+};
+
+/*
+  A parsed qdoc configuration file. The statements only depend on the
+  contents of the file and on environment variables, so each file is
+  parsed once per process, even when it is included by the
+  configuration of many modules, and across the prepare and generate
+  phases of a single execution.
+ */
+struct ConfigFile
+{
+    QString filePath {};
+    QList<ConfigStatement> statements {};
+};
+
+static QHash<QString, ConfigFile> s_configFiles;
+
 /*!
   Load, parse, and process a qdoc configuration file. This
   function is only called by the other load() function, but
   this one is recursive, i.e., it calls itself when it sees
   an \c{include} statement in the qdoc configuration file.
+
+  Each file is parsed only once; subsequent loads replay the
+  statements parsed the first time.
  */
 void Config::load(Location location, const QString &fileName)
 {
     QFileInfo fileInfo(fileName);
+    const QString absoluteFilePath = fileInfo.absoluteFilePath();
     pushWorkingDir(fileInfo.canonicalPath());
+
+    if (location.depth() > 16)
+        location.fatal(QStringLiteral("Too many nested includes"));
+
+    // Copy the file, as the included files are inserted in the cache
+    // while its statements are processed
+    ConfigFile file;
+    if (auto it = s_configFiles.constFind(absoluteFilePath); it != s_configFiles.cend()) {
+        file = *it;
+    } else {
+        file = parseFile(location, fileName);
+        s_configFiles.insert(absoluteFilePath, file);
+    }
+
+    addInputFile(file.filePath);
+    location.push(fileName);
+
+    for (const ConfigStatement &statement : std::as_const(file.statements)) {
+        location.setLineNo(statement.lineNo);
+        location.setColumnNo(statement.columnNo);
+
+        if (!statement.includeFile.isNull()) {
+            /*
+              Here is the recursive call.
+             */
+            load(location, QFileInfo(QDir(m_workingDirs.top()), statement.includeFile).filePath());
+            continue;
+        }
+
+        for (const auto &key : statement.keys) {
+            ConfigVar configVar(key, statement.values, QDir::currentPath(), location,
+                                statement.expandVars);
+            if (statement.plus && m_configVars.contains(key)) {
+                m_configVars[key].append(configVar);
+            } else {
+                m_configVars.insert(key, configVar);
+            }
+        }
+    }
+    popWorkingDir();
+}
+
+/*!
+  Parses the qdoc configuration file \a fileName, which is included
+  at \a location, into a list of statements. Reports a fatal error if
+  the file cannot be read or contains a syntax error.
+ */
+ConfigFile Config::parseFile(Location location, const QString &fileName)
+{
+    QFileInfo fileInfo(fileName);
+    ConfigFile file;
     static const QRegularExpression keySyntax(QRegularExpression::anchoredPattern(QLatin1String("\\w+(?:\\.\\w+)*")));
 
 #define SKIP_CHAR()                                                                                \
@@ -1110,9 +1253,6 @@ void Config::load(Location location, const QString &fileName)
     word += c;                                                                                     \
     SKIP_CHAR();
 
-    if (location.depth() > 16)
-        location.fatal(QStringLiteral("Too many nested includes"));
-
     QFile fin(fileInfo.fileName());
     if (!fin.open(QFile::ReadOnly | QFile::Text)) {
         if (!Config::installDir.isEmpty()) {
@@ -1124,6 +1264,7 @@ void Config::load(Location location, const QString &fileName)
             location.fatal(
                     QStringLiteral("Cannot open file '%1': %2").arg(fileName, fin.errorString()));
     }
+    file.filePath = QFileInfo(fin).absoluteFilePath();
 
     QTextStream stream(&fin);
     QString text = stream.readAll();
@@ -1203,10 +1344,11 @@ void Config::load(Location location, const QString &fileName)
                 if (cc != '#' && cc != '\n')
                     location.fatal(QStringLiteral("Trailing garbage"));
 
-                /*
-                  Here is the recursive call.
-                 */
-                load(location, QFileInfo(QDir(m_workingDirs.top()), includeFile).filePath());
+                ConfigStatement statement;
+                statement.lineNo = location.lineNo();
+                statement.columnNo = location.columnNo();
+                statement.includeFile = includeFile;
+                file.statements.append(statement);
             } else {
                 /*
                   It wasn't an include statement, so it's something else.
@@ -1310,20 +1452,22 @@ void Config::load(Location location, const QString &fileName)
                 for (const auto &key : keys) {
                     if (!keySyntax.match(key).hasMatch())
                         keyLoc.fatal(QStringLiteral("Invalid key '%1'").arg(key));
-
-                    ConfigVar configVar(key, rhsValues, QDir::currentPath(), keyLoc, expandVars);
-                    if (plus && m_configVars.contains(key)) {
-                        m_configVars[key].append(configVar);
-                    } else {
-                        m_configVars.insert(key, configVar);
-                    }
                 }
+
+                ConfigStatement statement;
+                statement.lineNo = keyLoc.lineNo();
+                statement.columnNo = keyLoc.columnNo();
+                statement.keys = keys;
+                statement.plus = plus;
+                statement.values = rhsValues;
+                statement.expandVars = expandVars;
+                file.statements.append(statement);
             }
         } else {
             location.fatal(QStringLiteral("Unexpected character '%1' at beginning of line").arg(c));
         }
     }
-    popWorkingDir();
+    return file;
 
 #undef SKIP_CHAR
 #undef SKIP_SPACES
@@ -1380,6 +1524,94 @@ QStringList Config::getFilesHere(const QString &uncleanDir, const QString &nameF
     return result;
 }
 
+namespace {
+struct FileFilters
+{
+    QList<QList<QRegularExpression>> nameFilters;
+    QList<QRegularExpression> excludedPatterns;
+    const QSet<QString> &excludedDirs;
+    const QSet<QString> &excludedFiles;
+};
+}
+
+static void collectFilesHere(const QString &uncleanDir, const FileFilters &filters,
+                             QList<QStringList> &result)
+{
+    const QString dir = QDir::cleanPath(uncleanDir);
+    if (filters.excludedDirs.contains(dir))
+        return;
+
+    QDir dirInfo(dir);
+    dirInfo.setSorting(QDir::Name);
+    dirInfo.setFilter(QDir::Files);
+    const QStringList fileNames = dirInfo.entryList();
+    for (const auto &file : fileNames) {
+        if (file.startsWith(QLatin1Char('~')))
+            continue;
+        QString path;
+        std::optional<bool> excluded;
+        for (qsizetype i = 0; i < filters.nameFilters.size(); ++i) {
+            const auto &patterns = filters.nameFilters.at(i);
+            const bool matches = std::any_of(patterns.cbegin(), patterns.cend(),
+                                             [&file](const QRegularExpression &re) {
+                                                 return re.match(file).hasMatch();
+                                             });
+            if (!matches)
+                continue;
+            if (!excluded) {
+                path = QDir::cleanPath(dirInfo.filePath(file));
+                excluded = filters.excludedFiles.contains(path)
+                        || std::any_of(filters.excludedPatterns.cbegin(),
+                                       filters.excludedPatterns.cend(),
+                                       [&path](const QRegularExpression &re) {
+                                           return re.match(path).hasMatch();
+                                       });
+            }
+            if (!*excluded)
+                result[i].append(path);
+        }
+    }
+
+    dirInfo.setFilter(QDir::Dirs | QDir::NoDotAndDotDot);
+    const QStringList subDirs = dirInfo.entryList();
+    for (const auto &subDir : subDirs)
+        collectFilesHere(dirInfo.filePath(subDir), filters, result);
+}
+
+/*!
+  Finds the files below \a dir for several name filters at once,
+  listing each directory only once. Each entry of \a nameFilters
+  is a space-separated list of wildcards, as for getFilesHere().
+
+  Returns one list of files for each entry of \a nameFilters, in
+  the order that getFilesHere() returns them for that entry alone.
+  The directories in \a excludedDirs are avoided, and the files
+  in \a excludedFiles are not included.
+ */
+QList<QStringList> Config::getFilesHereForFilters(const QString &dir,
+                                                  const QStringList &nameFilters,
+                                                  const QSet<QString> &excludedDirs,
+                                                  const QSet<QString> &excludedFiles)
+{
+    FileFilters filters { {}, {}, excludedDirs, excludedFiles };
+    for (const auto &nameFilter : nameFilters) {
+        QList<QRegularExpression> patterns;
+        // Like QDir, match the file names case-insensitively
+        for (const auto &wildcard : nameFilter.split(QLatin1Char(' ')))
+            patterns.append(QRegularExpression::fromWildcard(wildcard, Qt::CaseInsensitive));
+        filters.nameFilters.append(patterns);
+    }
+    for (const QString &entry : excludedFiles) {
+        if (entry.contains(QLatin1Char('*')) || entry.contains(QLatin1Char('?')))
+            filters.excludedPatterns.append(
+                    QRegularExpression(QRegularExpression::wildcardToRegularExpression(entry)));
+    }
+
+    QList<QStringList> result(nameFilters.size());
+    collectFilesHere(dir, filters, result);
+    return result;
+}
+
 /*!
   Set \a dir as the working directory and push it onto the
   stack of working directories.
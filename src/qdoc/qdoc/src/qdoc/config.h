@@ -19,6 +19,7 @@
 QT_BEGIN_NAMESPACE
 
 class Config;
+struct ConfigFile;
 
 /*
  Contains information about a location
@@ -108,6 +109,14 @@ public:
     [[nodiscard]] bool getDebug() const { return m_debug; }
     [[nodiscard]] bool getAtomsDump() const { return m_atomsDump; }
     [[nodiscard]] bool showInternal() const { return m_showInternal; }
+    [[nodiscard]] const QString &pchCacheDir() const { return m_pchCacheDir; }
+    [[nodiscard]] int jobs() const { return m_jobs; }
+    [[nodiscard]] const QString &depFile() const { return m_depFile; }
+    [[nodiscard]] const QString &timingReport() const { return m_timingReport; }
+    [[nodiscard]] bool precompress() const { return m_precompress; }
+    [[nodiscard]] bool releaseDocs() const { return m_releaseDocs; }
+    void addInputFile(const QString &filePath);
+    [[nodiscard]] const QSet<QString> &inputFiles() const { return m_inputFiles; }
 
     void clear();
     void reset();
@@ -149,6 +158,10 @@ public:
                                     const Location &location = Location(),
                                     const QSet<QString> &excludedDirs = QSet<QString>(),
                                     const QSet<QString> &excludedFiles = QSet<QString>());
+    static QList<QStringList> getFilesHereForFilters(const QString &dir,
+                                                     const QStringList &nameFilters,
+                                                     const QSet<QString> &excludedDirs,
+                                                     const QSet<QString> &excludedFiles);
     static QString findFile(const Location &location, const QStringList &files,
                             const QStringList &dirs, const QString &fileName,
                             QString *userFriendlyFilePath = nullptr);
@@ -214,6 +227,13 @@ private:
     std::optional<ExcludedPaths> m_excludedPaths{};
 
     bool m_showInternal { false };
+    QString m_pchCacheDir {};
+    int m_jobs { 1 };
+    QString m_depFile {};
+    QString m_timingReport {};
+    bool m_precompress { false };
+    bool m_releaseDocs { false };
+    QSet<QString> m_inputFiles {};
     static bool m_debug;
 
     // An option that can be set trough a similarly named command-line option.
@@ -224,6 +244,7 @@ private:
 
     static bool isMetaKeyChar(QChar ch);
     void load(Location location, const QString &fileName);
+    static ConfigFile parseFile(Location location, const QString &fileName);
 
     QString m_prog {};
     Location m_location {};
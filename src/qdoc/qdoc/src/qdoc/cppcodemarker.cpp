@@ -15,7 +15,9 @@
 #include "variablenode.h"
 
 #include <QtCore/qdebug.h>
-#include <QtCore/qregularexpression.h>
+
+#include <algorithm>
+#include <iterator>
 
 QT_BEGIN_NAMESPACE
 
@@ -57,10 +59,19 @@ Atom::AtomType CppCodeMarker::atomType() const
     return Atom::Code;
 }
 
+/*!
+  Returns the marked up \a code. The result is cached by the code, as the
+  same snippets and code lines are marked up for several pages and
+  formats.
+ */
 QString CppCodeMarker::markedUpCode(const QString &code, const Node *relative,
                                     const Location &location)
 {
-    return addMarkUp(code, relative, location);
+    if (const QString *cached = m_markedUpCode.object(code))
+        return *cached;
+    QString result = addMarkUp(code, relative, location);
+    m_markedUpCode.insert(code, new QString(result), result.size());
+    return result;
 }
 
 QString CppCodeMarker::markedUpSynopsis(const Node *node, const Node * /* relative */,
@@ -318,61 +329,104 @@ QString CppCodeMarker::markedUpEnumValue(const QString &enumValue, const Node *r
     return parts.join(QLatin1String("<@op>::</@op>"));
 }
 
-QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
-                                 const Location & /* location */)
+// The words are sorted, for containsWord().
+static constexpr QLatin1StringView s_types[] = {
+    "bool"_L1, "char"_L1, "cond"_L1, "double"_L1, "float"_L1, "int"_L1, "long"_L1, "qint"_L1,
+    "qint16"_L1, "qint32"_L1, "qint64"_L1, "qint8"_L1, "qlonglong"_L1, "qreal"_L1, "quint"_L1,
+    "quint16"_L1, "quint32"_L1, "quint64"_L1, "quint8"_L1, "qulonglong"_L1, "short"_L1, "signed"_L1,
+    "uchar"_L1, "uint"_L1, "ulong"_L1, "unsigned"_L1, "ushort"_L1, "void"_L1
+};
+
+static constexpr QLatin1StringView s_keywords[] = {
+    "and"_L1, "and_eq"_L1, "asm"_L1, "auto"_L1, "bitand"_L1, "bitor"_L1, "break"_L1, "case"_L1,
+    "catch"_L1, "class"_L1, "compl"_L1, "const"_L1, "const_cast"_L1, "continue"_L1, "default"_L1,
+    "delete"_L1, "do"_L1, "dynamic_cast"_L1, "else"_L1, "emit"_L1, "enum"_L1, "explicit"_L1,
+    "export"_L1, "extern"_L1, "false"_L1, "for"_L1, "friend"_L1, "goto"_L1, "if"_L1, "include"_L1,
+    "inline"_L1, "monitor"_L1, "mutable"_L1, "namespace"_L1, "new"_L1, "not"_L1, "not_eq"_L1,
+    "operator"_L1, "or"_L1, "or_eq"_L1, "private"_L1, "protected"_L1, "public"_L1, "register"_L1,
+    "reinterpret_cast"_L1, "return"_L1, "signals"_L1, "sizeof"_L1, "slots"_L1, "static"_L1,
+    "static_cast"_L1, "struct"_L1, "switch"_L1, "synchronized"_L1, "template"_L1, "this"_L1,
+    "throw"_L1, "true"_L1, "try"_L1, "typedef"_L1, "typeid"_L1, "typename"_L1, "union"_L1,
+    "using"_L1, "virtual"_L1, "volatile"_L1, "wchar_t"_L1, "while"_L1, "xor"_L1, "xor_eq"_L1
+};
+
+template <std::size_t N>
+static bool containsWord(const QLatin1StringView (&words)[N], QStringView word)
 {
-    static QSet<QString> types{
-        QLatin1String("bool"),       QLatin1String("char"),    QLatin1String("double"),
-        QLatin1String("float"),      QLatin1String("int"),     QLatin1String("long"),
-        QLatin1String("short"),      QLatin1String("signed"),  QLatin1String("unsigned"),
-        QLatin1String("uint"),       QLatin1String("ulong"),   QLatin1String("ushort"),
-        QLatin1String("uchar"),      QLatin1String("void"),    QLatin1String("qlonglong"),
-        QLatin1String("qulonglong"), QLatin1String("qint"),    QLatin1String("qint8"),
-        QLatin1String("qint16"),     QLatin1String("qint32"),  QLatin1String("qint64"),
-        QLatin1String("quint"),      QLatin1String("quint8"),  QLatin1String("quint16"),
-        QLatin1String("quint32"),    QLatin1String("quint64"), QLatin1String("qreal"),
-        QLatin1String("cond")
-    };
+    const auto it = std::lower_bound(std::begin(words), std::end(words), word,
+                                     [](QLatin1StringView a, QStringView b) {
+                                         return a.compare(b) < 0;
+                                     });
+    return it != std::end(words) && *it == word;
+}
+
+static constexpr bool isAsciiUpper(QChar ch)
+{
+    return ch >= u'A' && ch <= u'Z';
+}
 
-    static QSet<QString> keywords{
-        QLatin1String("and"), QLatin1String("and_eq"), QLatin1String("asm"), QLatin1String("auto"),
-        QLatin1String("bitand"), QLatin1String("bitor"), QLatin1String("break"),
-        QLatin1String("case"), QLatin1String("catch"), QLatin1String("class"),
-        QLatin1String("compl"), QLatin1String("const"), QLatin1String("const_cast"),
-        QLatin1String("continue"), QLatin1String("default"), QLatin1String("delete"),
-        QLatin1String("do"), QLatin1String("dynamic_cast"), QLatin1String("else"),
-        QLatin1String("enum"), QLatin1String("explicit"), QLatin1String("export"),
-        QLatin1String("extern"), QLatin1String("false"), QLatin1String("for"),
-        QLatin1String("friend"), QLatin1String("goto"), QLatin1String("if"),
-        QLatin1String("include"), QLatin1String("inline"), QLatin1String("monitor"),
-        QLatin1String("mutable"), QLatin1String("namespace"), QLatin1String("new"),
-        QLatin1String("not"), QLatin1String("not_eq"), QLatin1String("operator"),
-        QLatin1String("or"), QLatin1String("or_eq"), QLatin1String("private"),
-        QLatin1String("protected"), QLatin1String("public"), QLatin1String("register"),
-        QLatin1String("reinterpret_cast"), QLatin1String("return"), QLatin1String("sizeof"),
-        QLatin1String("static"), QLatin1String("static_cast"), QLatin1String("struct"),
-        QLatin1String("switch"), QLatin1String("template"), QLatin1String("this"),
-        QLatin1String("throw"), QLatin1String("true"), QLatin1String("try"),
-        QLatin1String("typedef"), QLatin1String("typeid"), QLatin1String("typename"),
-        QLatin1String("union"), QLatin1String("using"), QLatin1String("virtual"),
-        QLatin1String("volatile"), QLatin1String("wchar_t"), QLatin1String("while"),
-        QLatin1String("xor"), QLatin1String("xor_eq"), QLatin1String("synchronized"),
-        // Qt specific
-        QLatin1String("signals"), QLatin1String("slots"), QLatin1String("emit")
+static constexpr bool isAsciiLower(QChar ch)
+{
+    return ch >= u'a' && ch <= u'z';
+}
+
+/*
+  Returns \c true if \a ident is a Qt class name, that is, if it matches
+  \c {Qt?(?:[A-Z3]+[a-z][A-Za-z]*|t)}.
+ */
+static bool isQtClassName(QStringView ident)
+{
+    const auto matchesRest = [](QStringView rest) {
+        if (rest == u"t")
+            return true;
+        qsizetype i = 0;
+        while (i < rest.size() && (isAsciiUpper(rest[i]) || rest[i] == u'3'))
+            ++i;
+        if (i == 0 || i == rest.size() || !isAsciiLower(rest[i]))
+            return false;
+        for (++i; i < rest.size(); ++i) {
+            if (!isAsciiUpper(rest[i]) && !isAsciiLower(rest[i]))
+                return false;
+        }
+        return true;
     };
 
+    if (!ident.startsWith(u'Q'))
+        return false;
+    ident = ident.sliced(1);
+    return matchesRest(ident) || (ident.startsWith(u't') && matchesRest(ident.sliced(1)));
+}
+
+/*
+  Returns \c true if \a ident is a Qt global function name, that is,
+  if it matches \c {q([A-Z][a-z]+)+}.
+ */
+static bool isQtFunctionName(QStringView ident)
+{
+    if (ident.size() < 3 || ident.front() != u'q')
+        return false;
+    qsizetype i = 1;
+    while (i < ident.size()) {
+        if (!isAsciiUpper(ident[i++]))
+            return false;
+        if (i == ident.size() || !isAsciiLower(ident[i]))
+            return false;
+        while (i < ident.size() && isAsciiLower(ident[i]))
+            ++i;
+    }
+    return true;
+}
+
+QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
+                                 const Location & /* location */)
+{
     QString code = in;
     QString out;
     QStringView text;
-    int braceDepth = 0;
-    int parenDepth = 0;
     int i = 0;
     int start = 0;
     int finish = 0;
     QChar ch;
-    static const QRegularExpression classRegExp(QRegularExpression::anchoredPattern("Qt?(?:[A-Z3]+[a-z][A-Za-z]*|t)"));
-    static const QRegularExpression functionRegExp(QRegularExpression::anchoredPattern("q([A-Z][a-z]+)+"));
-    static const QRegularExpression findFunctionRegExp(QStringLiteral("^\\s*\\("));
     bool atEOF = false;
 
     auto readChar = [&]() {
@@ -388,26 +442,21 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
         bool target = false;
 
         if (ch.isLetter() || ch == '_') {
-            QString ident;
             do {
-                ident += ch;
                 finish = i;
                 readChar();
             } while (!atEOF && (ch.isLetterOrNumber() || ch == '_'));
+            const QStringView ident = QStringView{code}.sliced(start, finish - start);
 
-            if (classRegExp.match(ident).hasMatch()) {
+            if (isQtClassName(ident)) {
                 tag = QStringLiteral("type");
-            } else if (functionRegExp.match(ident).hasMatch()) {
+            } else if (isQtFunctionName(ident)) {
                 tag = QStringLiteral("func");
                 target = true;
-            } else if (types.contains(ident)) {
+            } else if (containsWord(s_types, ident)) {
                 tag = QStringLiteral("type");
-            } else if (keywords.contains(ident)) {
+            } else if (containsWord(s_keywords, ident)) {
                 tag = QStringLiteral("keyword");
-            } else if (braceDepth == 0 && parenDepth == 0) {
-                if (code.indexOf(findFunctionRegExp, i - 1) == i - 1)
-                    tag = QStringLiteral("func");
-                target = true;
             }
         } else if (ch.isDigit()) {
             do {
@@ -475,16 +524,6 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
                 readChar();
                 tag = QStringLiteral("char");
                 break;
-            case '(':
-                finish = i;
-                readChar();
-                ++parenDepth;
-                break;
-            case ')':
-                finish = i;
-                readChar();
-                --parenDepth;
-                break;
             case ':':
                 finish = i;
                 readChar();
@@ -527,16 +566,6 @@ QString CppCodeMarker::addMarkUp(const QString &in, const Node * /* relative */,
                     tag = QStringLiteral("op");
                 }
                 break;
-            case '{':
-                finish = i;
-                readChar();
-                braceDepth++;
-                break;
-            case '}':
-                finish = i;
-                readChar();
-                braceDepth--;
-                break;
             default:
                 finish = i;
                 readChar();
@@ -6,6 +6,8 @@
 
 #include "codemarker.h"
 
+#include <QtCore/qcache.h>
+
 QT_BEGIN_NAMESPACE
 
 class CppCodeMarker : public CodeMarker
@@ -25,6 +27,10 @@ public:
     QString markedUpName(const Node *node) override;
     QString markedUpEnumValue(const QString &enumValue, const Node *relative) override;
 
+protected:
+    // The marked up code by the code, with the size of the result as cost.
+    QCache<QString, QString> m_markedUpCode { 8 * 1024 * 1024 };
+
 private:
     QString addMarkUp(const QString &protectedCode, const Node *relative, const Location &location);
 };
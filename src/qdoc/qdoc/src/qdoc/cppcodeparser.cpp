@@ -744,13 +744,19 @@ void CppCodeParser::setExampleFileLists(ExampleNode *en)
 
     const auto& [excludeDirs, excludeFiles] = config.getExcludedPaths();
 
-    QStringList exampleFiles = Config::getFilesHere(exampleDir.path(), m_exampleNameFilter,
-                                                    Location(), excludeDirs, excludeFiles);
+    // Find the sources, images, and resource and project files in one pass over the example
+    const QList<QStringList> files = Config::getFilesHereForFilters(
+            exampleDir.path(),
+            { m_exampleNameFilter, m_exampleImageFilter,
+              QLatin1String("*.qrc *.pro *.qmlproject *.pyproject CMakeLists.txt qmldir") },
+            excludeDirs, excludeFiles);
+    QStringList exampleFiles = files.at(0);
     // Search for all image files under the example project, excluding doc/images directory.
-    QSet<QString> excludeDocDirs(excludeDirs);
-    excludeDocDirs.insert(exampleDir.path() + QLatin1String("/doc/images"));
-    QStringList imageFiles = Config::getFilesHere(exampleDir.path(), m_exampleImageFilter,
-                                                  Location(), excludeDocDirs, excludeFiles);
+    const QString docImagesDir = exampleDir.path() + QLatin1String("/doc/images/");
+    QStringList imageFiles = files.at(1);
+    imageFiles.removeIf([&docImagesDir](const QString &file) {
+        return file.startsWith(docImagesDir);
+    });
     if (!exampleFiles.isEmpty()) {
         // move main.cpp to the end, if it exists
         QString mainCpp;
@@ -773,9 +779,7 @@ void CppCodeParser::setExampleFileLists(ExampleNode *en)
             exampleFiles.append(mainCpp);
 
         // Add any resource and project files
-        exampleFiles += Config::getFilesHere(exampleDir.path(),
-                QLatin1String("*.qrc *.pro *.qmlproject *.pyproject CMakeLists.txt qmldir"),
-                Location(), excludeDirs, excludeFiles);
+        exampleFiles += files.at(2);
     }
 
     const qsizetype pathLen = exampleDir.path().size() - en->name().size();
@@ -807,6 +811,28 @@ bool CppCodeParser::isQMLPropertyTopic(const QString &t)
     return (t == COMMAND_QMLPROPERTY || t == COMMAND_QMLATTACHEDPROPERTY);
 }
 
+/*!
+  Lets the \\fn command parser parse the signatures of all \\fn
+  commands in \a untied at once, before processTopicArgs() is called
+  for each of them. Signatures with a tag are not parsed by clang.
+ */
+void CppCodeParser::prepareFnTopics(const std::vector<UntiedDocumentation> &untied)
+{
+    std::vector<FnCommandParser::Signature> signatures;
+    for (const auto &documentation : untied) {
+        const Doc &doc = documentation.documentation;
+        if (doc.topicsUsed().isEmpty() || doc.topicsUsed().first().m_topic != COMMAND_FN)
+            continue;
+        if (!Config::instance().showInternal() && doc.isInternal())
+            continue;
+        for (const auto &[signature, idTag] : doc.metaCommandArgs(COMMAND_FN)) {
+            if (idTag.isEmpty())
+                signatures.push_back({ signature, documentation.context });
+        }
+    }
+    fn_parser.parseSignatures(signatures);
+}
+
 std::pair<std::vector<TiedDocumentation>, std::vector<FnMatchError>>
 CppCodeParser::processTopicArgs(const UntiedDocumentation &untied)
 {
@@ -44,6 +44,7 @@ public:
     static bool isQMLMethodTopic(const QString &t);
     static bool isQMLPropertyTopic(const QString &t);
 
+    void prepareFnTopics(const std::vector<UntiedDocumentation> &untied);
     std::pair<std::vector<TiedDocumentation>, std::vector<FnMatchError>>
     processTopicArgs(const UntiedDocumentation &untied);
 
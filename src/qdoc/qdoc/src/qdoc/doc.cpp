@@ -47,7 +47,7 @@ DocUtilities &Doc::m_utilities = DocUtilities::instance();
 Doc::Doc(const Location &start_loc, const Location &end_loc, const QString &source,
          const QSet<QString> &metaCommandSet, const QSet<QString> &topics)
 {
-    m_priv = new DocPrivate(start_loc, end_loc, source);
+    m_priv = new DocPrivate(start_loc, end_loc, source.isEmpty());
     DocParser parser;
     parser.parse(source, m_priv, metaCommandSet, topics);
 
@@ -101,15 +101,9 @@ const Location &Doc::startLocation() const
     return location();
 }
 
-const QString &Doc::source() const
-{
-    static QString null;
-    return m_priv == nullptr ? null : m_priv->m_src;
-}
-
 bool Doc::isEmpty() const
 {
-    return m_priv == nullptr || m_priv->m_src.isEmpty();
+    return m_priv == nullptr || m_priv->m_isEmpty;
 }
 
 const Text &Doc::body() const
@@ -299,6 +293,36 @@ QMultiMap<ComparisonCategory, Text> *Doc::comparesWithMap() const
     return m_priv && m_priv->extra ? &m_priv->extra->m_comparesWithMap : nullptr;
 }
 
+/*!
+  Releases the body and the \sa list of this documentation, keeping
+  only its brief text and its images, once the page that shows them
+  has been written. Later pages still list the brief text, and the help
+  project still collects the images.
+
+  Nothing is released if the documentation is shared with other
+  nodes, or if it has legalese, keywords, targets, a table of
+  contents, or meta tags, as those are found through the body.
+  The documentation is not empty after its body is released.
+ */
+void Doc::releaseBody()
+{
+    if (m_priv == nullptr || m_priv->count > 1 || m_priv->extra || m_priv->m_hasLegalese)
+        return;
+
+    Text retained;
+    bool inBrief = false;
+    for (const Atom *atom = m_priv->m_text.firstAtom(); atom; atom = atom->next()) {
+        if (atom->type() == Atom::BriefLeft)
+            inBrief = true;
+        if (inBrief || atom->type() == Atom::Image || atom->type() == Atom::InlineImage)
+            retained << *atom;
+        if (atom->type() == Atom::BriefRight)
+            inBrief = false;
+    }
+    m_priv->m_text = retained;
+    m_priv->m_alsoList.clear();
+}
+
 void Doc::constructExtra() const
 {
     if (m_priv)
@@ -355,6 +379,10 @@ void Doc::initialize(FileResolver& file_resolver)
     }
 }
 
+// The quoted files, split into lines and marked up, as many documents
+// quote snippets from the same example files.
+static QHash<QString, Quoter::Lines> s_quotedFiles;
+
 /*!
   All the heap allocated variables are deleted.
  */
@@ -362,6 +390,7 @@ void Doc::terminate()
 {
     m_utilities.cmdHash.clear();
     m_utilities.macroHash.clear();
+    s_quotedFiles.clear();
 }
 
 /*!
@@ -411,16 +440,24 @@ void Doc::quoteFromFile(const Location &location, Quoter &quoter, ResolvedFile r
     // spread resposability should be removed, together with quoteFromFile.
     quoter.reset();
 
+    const QString &path = resolved_file.get_path();
+    if (const auto it = s_quotedFiles.constFind(path); it != s_quotedFiles.cend()) {
+        quoter.quoteFromLines(path, *it);
+        return;
+    }
+
+    Config::instance().addInputFile(path);
     QString code;
     {
-        QFile input_file{resolved_file.get_path()};
+        QFile input_file{path};
         if (!input_file.open(QFile::ReadOnly))
             return;
         code = DocParser::untabifyEtc(QTextStream{&input_file}.readAll());
     }
 
-    CodeMarker *marker = CodeMarker::markerForFileName(resolved_file.get_path());
-    quoter.quoteFromFile(resolved_file.get_path(), code, marker->markedUpCode(code, nullptr, location));
+    CodeMarker *marker = CodeMarker::markerForFileName(path);
+    quoter.quoteFromFile(path, code, marker->markedUpCode(code, nullptr, location));
+    s_quotedFiles.insert(path, quoter.lines());
 }
 
 QT_END_NAMESPACE
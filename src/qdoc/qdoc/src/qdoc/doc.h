@@ -50,7 +50,6 @@ public:
     [[nodiscard]] const Location &location() const;
     [[nodiscard]] const Location &startLocation() const;
     [[nodiscard]] bool isEmpty() const;
-    [[nodiscard]] const QString &source() const;
     [[nodiscard]] const Text &body() const;
     [[nodiscard]] Text briefText(bool inclusive = false) const;
     [[nodiscard]] Text trimmedBriefText(const QString &className) const;
@@ -74,6 +73,7 @@ public:
     [[nodiscard]] QStringMultiMap *metaTagMap() const;
     [[nodiscard]] QMultiMap<ComparisonCategory, Text> *comparesWithMap() const;
     void constructExtra() const;
+    void releaseBody();
 
     static void initialize(FileResolver& file_resolver);
     static void terminate();
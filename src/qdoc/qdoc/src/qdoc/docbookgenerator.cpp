@@ -373,10 +373,10 @@ qsizetype DocBookGenerator::generateAtom(const Atom *atom, const Node *relative,
         break;
     case Atom::AnnotatedList: {
         if (const CollectionNode *cn = m_qdb->getCollectionNode(atom->string(), Node::Group))
-            generateList(cn, atom->string(), Generator::sortOrder(atom->strings().last()));
+            generateList(cn, atom->string(), Generator::sortOrder(atom->lastString()));
         } break;
     case Atom::GeneratedList: {
-        const auto sortOrder{Generator::sortOrder(atom->strings().last())};
+        const auto sortOrder{Generator::sortOrder(atom->lastString())};
         bool hasGeneratedSomething = false;
         if (atom->string() == QLatin1String("annotatedclasses")
             || atom->string() == QLatin1String("attributions")
@@ -2960,14 +2960,15 @@ void DocBookGenerator::generateAlsoList(const Node *node)
 }
 
 /*!
-  Open a new file to write XML contents, including the DocBook
-  opening tag.
+  Start a new subpage to write XML contents, including the DocBook
+  opening tag. The page is collected in memory and written to its
+  file by endDocument().
  */
 QXmlStreamWriter *DocBookGenerator::startGenericDocument(const Node *node, const QString &fileName)
 {
     Q_ASSERT(node->isPageNode());
-    QFile *outFile = openSubPageFile(static_cast<const PageNode*>(node), fileName);
-    m_writer = new QXmlStreamWriter(outFile);
+    beginSubPage(node, fileName);
+    m_writer = new QXmlStreamWriter(subPageDevice());
     m_writer->setAutoFormatting(false); // We need a precise handling of line feeds.
 
     m_writer->writeStartDocument();
@@ -3012,10 +3013,9 @@ void DocBookGenerator::endDocument()
     m_writer->writeEndElement(); // article
     m_writer->writeEndDocument();
 
-    m_writer->device()->close();
-    delete m_writer->device();
     delete m_writer;
     m_writer = nullptr;
+    endSubPage();
 }
 
 /*!
@@ -4574,8 +4574,10 @@ void DocBookGenerator::generateDocumentation(Node *node)
             if ((node->isClassNode() || node->isHeader() || node->isNamespace())
                 && node->docMustBeGenerated()) {
                 generateCppReferencePage(static_cast<Aggregate *>(node));
+                releaseMemberDocs(static_cast<Aggregate *>(node));
             } else if (node->isQmlType()) { // Includes QML value types
                 generateQmlTypePage(static_cast<QmlTypeNode *>(node));
+                releaseMemberDocs(static_cast<Aggregate *>(node));
             } else if (node->isProxyNode()) {
                 generateProxyPage(static_cast<Aggregate *>(node));
             }
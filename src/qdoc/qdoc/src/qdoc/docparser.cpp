@@ -11,6 +11,8 @@
 #include "tokenizer.h"
 
 #include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qregularexpression.h>
 #include <QtCore/qtextstream.h>
 
@@ -316,18 +318,11 @@ void DocParser::parse(const QString &source, DocPrivate *docPrivate,
 
         switch (ch.unicode()) {
         case '\\': {
-            QString cmdStr;
             m_backslashPosition = m_position;
             ++m_position;
-            while (m_position < m_inputLength) {
-                ch = m_input.at(m_position);
-                if (ch.isLetterOrNumber()) {
-                    cmdStr += ch;
-                    ++m_position;
-                } else {
-                    break;
-                }
-            }
+            m_position = commandNameEnd(m_position);
+            const QString cmdStr =
+                    m_input.sliced(m_backslashPosition + 1, m_position - m_backslashPosition - 1);
             m_endPosition = m_position;
             if (cmdStr.isEmpty()) {
                 if (m_position < m_inputLength) {
@@ -1082,8 +1077,9 @@ void DocParser::parse(const QString &source, DocPrivate *docPrivate,
                             if (!cmdStr.endsWith(QLatin1String("propertygroup")))
                                 m_private->m_topics.append(Topic(cmdStr, arg));
                         }
-                    } else if (s_utilities.macroHash.contains(cmdStr)) {
-                        const Macro &macro = s_utilities.macroHash.value(cmdStr);
+                    } else if (const auto macroIt = s_utilities.macroHash.constFind(cmdStr);
+                               macroIt != s_utilities.macroHash.cend()) {
+                        const Macro &macro = *macroIt;
                         QStringList macroArgs;
                         int numPendingFi = 0;
                         int numFormatDefs = 0;
@@ -1297,6 +1293,17 @@ void DocParser::parse(const QString &source, DocPrivate *docPrivate,
     m_private->m_text.stripFirstAtom();
 }
 
+/*!
+  Returns the position after the name of the command or macro that
+  starts at \a position in the input.
+ */
+qsizetype DocParser::commandNameEnd(qsizetype position) const
+{
+    while (position < m_inputLength && m_input.at(position).isLetterOrNumber())
+        ++position;
+    return position;
+}
+
 /*!
   Returns the current location.
  */
@@ -1313,12 +1320,13 @@ Location &DocParser::location()
 
 QString DocParser::detailsUnknownCommand(const QSet<QString> &metaCommandSet, const QString &str)
 {
-    QSet<QString> commandSet = metaCommandSet;
-    int i = 0;
-    while (cmds[i].name != nullptr) {
-        commandSet.insert(cmds[i].name);
-        ++i;
-    }
+    static const QSet<QString> builtinCommands = [] {
+        QSet<QString> commands;
+        for (int i = 0; cmds[i].name != nullptr; ++i)
+            commands.insert(cmds[i].name);
+        return commands;
+    }();
+    const QSet<QString> commandSet = metaCommandSet + builtinCommands;
 
     QString best = nearestName(str, commandSet);
     if (best.isEmpty())
@@ -1400,6 +1408,67 @@ void DocParser::insertKeyword(const QString &keyword)
     m_private->extra->m_keywords.append(m_private->m_text.lastAtom());
 }
 
+namespace {
+struct IncludedFragment
+{
+    QString text;
+    bool found = false;
+};
+
+/*
+  The text of the files included with \include, and of the snippets
+  taken from them, before their arguments are expanded. Boilerplate
+  .qdocinc files are included many times, so each file is read, and
+  each snippet is extracted, only once.
+ */
+struct IncludeCache
+{
+    QMutex mutex;
+    QHash<QString, QString> files;
+    QHash<std::pair<QString, QString>, IncludedFragment> fragments;
+};
+}
+
+Q_GLOBAL_STATIC(IncludeCache, includeCache)
+
+/*
+  Returns the lines of \a content between the two lines that start
+  with "//!" and contain \a identifier, or all of \a content if
+  \a identifier is empty.
+ */
+static IncludedFragment extractFragment(const QString &content, const QString &identifier)
+{
+    if (identifier.isEmpty())
+        return { content, true };
+
+    QStringList lineBuffer = content.split(QLatin1Char('\n'));
+    qsizetype bufLen{lineBuffer.size()};
+    qsizetype i;
+    QStringView trimmedLine;
+    for (i = 0; i < bufLen; ++i) {
+        trimmedLine = QStringView{lineBuffer[i]}.trimmed();
+        if (trimmedLine.startsWith(QLatin1String("//!")) &&
+            trimmedLine.contains(identifier))
+            break;
+    }
+    if (i < bufLen - 1)
+        ++i;
+    else
+        return {};
+
+    QString result;
+    do {
+        trimmedLine = QStringView{lineBuffer[i]}.trimmed();
+        if (trimmedLine.startsWith(QLatin1String("//!")) &&
+            trimmedLine.contains(identifier))
+            break;
+        else
+            result += lineBuffer[i] + QLatin1Char('\n');
+        ++i;
+    } while (i < bufLen);
+    return { result, true };
+}
+
 void DocParser::include(const QString &fileName, const QString &identifier, const QStringList &parameters)
 {
     if (location().depth() > 16)
@@ -1407,62 +1476,48 @@ void DocParser::include(const QString &fileName, const QString &identifier, cons
     QString filePath = Config::instance().getIncludeFilePath(fileName);
     if (filePath.isEmpty()) {
         location().warning(QStringLiteral("Cannot find qdoc include file '%1'").arg(fileName));
-    } else {
-        QFile inFile(filePath);
-        if (!inFile.open(QFile::ReadOnly)) {
-            location().warning(
-                    QStringLiteral("Cannot open qdoc include file '%1'").arg(filePath));
-        } else {
-            location().push(fileName);
-            QTextStream inStream(&inFile);
-            QString includedContent = inStream.readAll();
-            inFile.close();
-
-            if (identifier.isEmpty()) {
-                expandArgumentsInString(includedContent, parameters);
-                m_input.insert(m_position, includedContent);
-                m_inputLength = m_input.size();
-                m_openedInputs.push(m_position + includedContent.size());
-            } else {
-                QStringList lineBuffer = includedContent.split(QLatin1Char('\n'));
-                qsizetype bufLen{lineBuffer.size()};
-                qsizetype i;
-                QStringView trimmedLine;
-                for (i = 0; i < bufLen; ++i) {
-                    trimmedLine = QStringView{lineBuffer[i]}.trimmed();
-                    if (trimmedLine.startsWith(QLatin1String("//!")) &&
-                        trimmedLine.contains(identifier))
-                        break;
-                }
-                if (i < bufLen - 1) {
-                    ++i;
-                } else {
+        return;
+    }
+    Config::instance().addInputFile(filePath);
+
+    IncludedFragment fragment;
+    {
+        IncludeCache *cache = includeCache();
+        QMutexLocker locker(&cache->mutex);
+        const std::pair<QString, QString> key(filePath, identifier);
+        auto it = cache->fragments.constFind(key);
+        if (it == cache->fragments.constEnd()) {
+            auto fileIt = cache->files.constFind(filePath);
+            if (fileIt == cache->files.constEnd()) {
+                QFile inFile(filePath);
+                if (!inFile.open(QFile::ReadOnly)) {
                     location().warning(
-                            QStringLiteral("Cannot find '%1' in '%2'").arg(identifier, filePath));
+                            QStringLiteral("Cannot open qdoc include file '%1'").arg(filePath));
                     return;
                 }
-                QString result;
-                do {
-                    trimmedLine = QStringView{lineBuffer[i]}.trimmed();
-                    if (trimmedLine.startsWith(QLatin1String("//!")) &&
-                        trimmedLine.contains(identifier))
-                        break;
-                    else
-                        result += lineBuffer[i] + QLatin1Char('\n');
-                    ++i;
-                } while (i < bufLen);
-
-                expandArgumentsInString(result, parameters);
-                if (result.isEmpty()) {
-                    location().warning(QStringLiteral("Empty qdoc snippet '%1' in '%2'")
-                                               .arg(identifier, filePath));
-                } else {
-                    m_input.insert(m_position, result);
-                    m_inputLength = m_input.size();
-                    m_openedInputs.push(m_position + result.size());
-                }
+                QTextStream inStream(&inFile);
+                fileIt = cache->files.insert(filePath, inStream.readAll());
             }
+            it = cache->fragments.insert(key, extractFragment(*fileIt, identifier));
         }
+        fragment = *it;
+    }
+
+    location().push(fileName);
+    if (!fragment.found) {
+        location().warning(QStringLiteral("Cannot find '%1' in '%2'").arg(identifier, filePath));
+        return;
+    }
+
+    QString result = fragment.text;
+    expandArgumentsInString(result, parameters);
+    if (!identifier.isEmpty() && result.isEmpty()) {
+        location().warning(QStringLiteral("Empty qdoc snippet '%1' in '%2'")
+                                   .arg(identifier, filePath));
+    } else {
+        m_input.insert(m_position, result);
+        m_inputLength = m_input.size();
+        m_openedInputs.push(m_position + result.size());
     }
 }
 
@@ -2037,15 +2092,15 @@ bool DocParser::expandMacro(ArgumentParsingOptions options)
     if (options == ArgumentParsingOptions::Verbatim)
         return false;
 
-    QString cmdStr;
     qsizetype backslashPos = m_position++;
-    while (m_position < m_input.size() && m_input[m_position].isLetterOrNumber())
-        cmdStr += m_input[m_position++];
+    m_position = commandNameEnd(m_position);
+    const QString cmdStr = m_input.sliced(backslashPos + 1, m_position - backslashPos - 1);
 
     m_endPosition = m_position;
     if (!cmdStr.isEmpty()) {
-        if (s_utilities.macroHash.contains(cmdStr)) {
-            const Macro &macro = s_utilities.macroHash.value(cmdStr);
+        if (const auto macroIt = s_utilities.macroHash.constFind(cmdStr);
+            macroIt != s_utilities.macroHash.cend()) {
+            const Macro &macro = *macroIt;
             if (!macro.m_defaultDef.isEmpty()) {
                 QString expanded = expandMacroToString(cmdStr, macro);
                 m_input.replace(backslashPos, m_position - backslashPos, expanded);
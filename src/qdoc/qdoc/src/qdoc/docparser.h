@@ -92,6 +92,7 @@ private:
     inline bool isAutoLinkString(const QString &word);
     bool isAutoLinkString(const QString &word, qsizetype &curPos);
     bool isBlankLine();
+    [[nodiscard]] qsizetype commandNameEnd(qsizetype position) const;
     bool isLeftBraceAhead();
     bool isLeftBracketAhead();
     void skipSpacesOnLine();
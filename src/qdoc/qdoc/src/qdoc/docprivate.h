@@ -43,9 +43,10 @@ struct DocPrivateExtra
 class DocPrivate
 {
 public:
+    // The comment text itself is not kept once it is parsed, only whether it was empty
     explicit DocPrivate(const Location &start = Location(), const Location &end = Location(),
-                        QString source = QString())
-        : m_start_loc(start), m_end_loc(end), m_src(std::move(source)), m_hasLegalese(false) {};
+                        bool isEmpty = true)
+        : m_start_loc(start), m_end_loc(end), m_hasLegalese(false), m_isEmpty(isEmpty) {};
     ~DocPrivate();
 
     void addAlso(const Text &also);
@@ -57,7 +58,6 @@ public:
     // ### move some of this in DocPrivateExtra
     Location m_start_loc {};
     Location m_end_loc {};
-    QString m_src {};
     Text m_text {};
     QSet<QString> m_params {};
     QList<Text> m_alsoList {};
@@ -69,6 +69,7 @@ public:
     TopicList m_topics {};
 
     bool m_hasLegalese : 1;
+    bool m_isEmpty : 1;
 };
 
 QT_END_NAMESPACE
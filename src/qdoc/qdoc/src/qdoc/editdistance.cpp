@@ -3,6 +3,10 @@
 
 #include "editdistance.h"
 
+#include <QtCore/qvarlengtharray.h>
+
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 int editDistance(const QString &s, const QString &t)
@@ -37,18 +41,59 @@ int editDistance(const QString &s, const QString &t)
 #undef D
 }
 
+/*
+  Returns the edit distance between \a s and \a t if it is at most
+  \a maxDistance, and \a maxDistance + 1 otherwise. Only two rows of the
+  distance matrix are kept, and the computation stops as soon as no
+  cell of a row is within \a maxDistance anymore.
+*/
+int boundedEditDistance(QStringView s, QStringView t, int maxDistance)
+{
+    if (qAbs(s.size() - t.size()) > maxDistance)
+        return maxDistance + 1;
+
+    const qsizetype n = t.size() + 1;
+    QVarLengthArray<int, 64> previous(n);
+    QVarLengthArray<int, 64> current(n);
+    for (qsizetype j = 0; j < n; ++j)
+        previous[j] = int(j);
+
+    for (qsizetype i = 1; i <= s.size(); ++i) {
+        current[0] = int(i);
+        int rowMinimum = current[0];
+        for (qsizetype j = 1; j < n; ++j) {
+            if (s[i - 1] == t[j - 1])
+                current[j] = previous[j - 1];
+            else
+                current[j] = 1 + qMin(qMin(previous[j], previous[j - 1]), current[j - 1]);
+            rowMinimum = qMin(rowMinimum, current[j]);
+        }
+        if (rowMinimum > maxDistance)
+            return maxDistance + 1;
+        std::swap(previous, current);
+    }
+    return qMin(previous[n - 1], maxDistance + 1);
+}
+
+/*
+  Returns the candidate closest to \a actual if it is the only one within
+  an edit distance of two, and the names are not trivially short.
+  Candidates further away than that cannot be suggested, so the distance
+  to them is not computed in full.
+*/
 QString nearestName(const QString &actual, const QSet<QString> &candidates)
 {
+    constexpr int maxDistance = 2;
     if (actual.isEmpty())
         return QString();
 
-    int deltaBest = 10000;
+    int deltaBest = maxDistance + 1;
     int numBest = 0;
     QString best;
 
     for (const auto &candidate : candidates) {
         if (candidate[0] == actual[0]) {
-            int delta = editDistance(actual, candidate);
+            int delta = boundedEditDistance(actual, candidate, qMin(deltaBest, maxDistance));
             if (delta < deltaBest) {
                 deltaBest = delta;
                 numBest = 1;
@@ -59,7 +104,7 @@ QString nearestName(const QString &actual, const QSet<QString> &candidates)
         }
     }
 
-    if (numBest == 1 && deltaBest <= 2 && actual.size() + best.size() >= 5)
+    if (numBest == 1 && deltaBest <= maxDistance && actual.size() + best.size() >= 5)
         return best;
 
     return QString();
@@ -10,6 +10,7 @@
 QT_BEGIN_NAMESPACE
 
 int editDistance(const QString &s, const QString &t);
+int boundedEditDistance(QStringView s, QStringView t, int maxDistance);
 QString nearestName(const QString &actual, const QSet<QString> &candidates);
 
 QT_END_NAMESPACE
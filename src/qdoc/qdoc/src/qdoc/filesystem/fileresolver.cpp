@@ -27,6 +27,12 @@
  * A file is considered to be resolved if, from any root directory,
  * the query represents an existing file.
  *
+ * To avoid querying the filesystem for each candidate path, the
+ * entries of each directory that a query leads to are listed once,
+ * the first time they are needed, and kept for the lifetime of the
+ * instance. Files that are created afterwards in a directory that
+ * was already listed are not found.
+ *
  * For example, consider the following directory structure on some
  * filesystem:
  *
@@ -145,13 +151,55 @@ FileResolver::FileResolver(std::vector<DirectoryPath>&& search_directories)
 */
 [[nodiscard]] std::optional<ResolvedFile> FileResolver::resolve(QString query) const {
     for (auto& directory_path : search_directories) {
-        auto maybe_filepath = FilePath::refine(QDir(directory_path.value() + "/" + query).path());
+        QString path = QDir(directory_path.value() + "/" + query).path();
+        if (!may_contain_file(path)) continue;
+
+        auto maybe_filepath = FilePath::refine(path);
         if (maybe_filepath) return ResolvedFile{std::move(query), std::move(*maybe_filepath)};
     }
 
     return std::nullopt;
 }
 
+// Names are compared the way the filesystems that are commonly used
+// on the platform compare them.
+static QString comparable_entry_name(const QString& name) {
+#if defined(Q_OS_WIN) || defined(Q_OS_DARWIN)
+    return name.normalized(QString::NormalizationForm_C).toCaseFolded();
+#else
+    return name;
+#endif
+}
+
+/*!
+ * \internal
+ *
+ * Returns \c false if the directory containing \a path is known not
+ * to contain a file with the name of \a path, and \c true otherwise.
+ *
+ * The entries of the directory are listed the first time that it is
+ * inspected.
+ */
+bool FileResolver::may_contain_file(const QString& path) const {
+    qsizetype separator = path.lastIndexOf(u'/');
+    if (separator < 0 || separator == path.size() - 1) return true;
+
+    // Keep the separator, so that root directories are listed as such
+    QString directory = path.first(separator + 1);
+    auto entries = directory_entries.constFind(directory);
+    if (entries == directory_entries.cend()) {
+        QSet<QString> names;
+        const QStringList listing =
+                QDir(directory).entryList(QDir::Files | QDir::Hidden | QDir::System);
+        names.reserve(listing.size());
+        for (const QString& name : listing) names.insert(comparable_entry_name(name));
+
+        entries = directory_entries.insert(directory, std::move(names));
+    }
+
+    return entries->contains(comparable_entry_name(path.sliced(separator + 1)));
+}
+
 /*!
  * \fn FileResolver::get_search_directories() const
  *
@@ -9,6 +9,8 @@
 #include <optional>
 #include <vector>
 
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstring.h>
 
 class FileResolver {
@@ -20,5 +22,8 @@ public:
     [[nodiscard]] const std::vector<DirectoryPath>& get_search_directories() const { return search_directories; }
 
 private:
+    [[nodiscard]] bool may_contain_file(const QString& path) const;
+
     std::vector<DirectoryPath> search_directories;
+    mutable QHash<QString, QSet<QString>> directory_entries;
 };
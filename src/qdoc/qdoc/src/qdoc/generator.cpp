@@ -9,6 +9,7 @@
 #include "codemarker.h"
 #include "collectionnode.h"
 #include "comparisoncategory.h"
+#include "compressedoutput.h"
 #include "config.h"
 #include "doc.h"
 #include "editdistance.h"
@@ -22,11 +23,14 @@
 #include "qmltypenode.h"
 #include "qmlpropertynode.h"
 #include "quoter.h"
+#include "sections.h"
 #include "sharedcommentnode.h"
+#include "timingreport.h"
 #include "tokenizer.h"
 #include "typedefnode.h"
 #include "utilities.h"
 
+#include <QtCore/qbuffer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qregularexpression.h>
@@ -50,6 +54,7 @@ QList<Generator *> Generator::s_generators;
 QString Generator::s_outDir;
 QString Generator::s_outSubdir;
 QStringList Generator::s_outFileNames;
+QSet<QString> Generator::s_outFileNameSet;
 QSet<QString> Generator::s_trademarks;
 QSet<QString> Generator::s_outputFormats;
 QHash<QString, QString> Generator::s_outputPrefixes;
@@ -59,6 +64,7 @@ bool Generator::s_noLinkErrors = false;
 bool Generator::s_autolinkErrors = false;
 bool Generator::s_redirectDocumentationToDevNull = false;
 bool Generator::s_useOutputSubdirs = true;
+bool Generator::s_releaseDocs = false;
 QmlTypeNode *Generator::s_qmlTypeContext = nullptr;
 
 static QRegularExpression tag("</?@[^>]*>");
@@ -190,69 +196,151 @@ int Generator::appendSortedQmlNames(Text &text, const Node *base, const QStringL
 }
 
 /*!
-  Creates the file named \a fileName in the output directory
-  and returns a QFile pointing to this file. In particular,
-  this method deals with errors when opening the file:
-  the returned QFile is always valid and can be written to.
-
-  \sa beginSubPage()
+  Returns the path of the file named \a fileName in the output
+  directory, warning about files that were already generated,
+  and records \a fileName as an output file.
  */
-QFile *Generator::openSubPageFile(const PageNode *node, const QString &fileName)
+QString Generator::subPageFilePath(const PageNode *node, const QString &fileName)
 {
     // Skip generating a warning for license attribution pages, as their source
     // is generated by qtattributionsscanner and may potentially include duplicates
-    if (s_outFileNames.contains(fileName) && !node->isAttribution())
+    if (s_outFileNameSet.contains(fileName) && !node->isAttribution())
         node->location().warning("Already generated %1 for this project"_L1.arg(fileName));
 
     QString path = outputDir() + QLatin1Char('/') + fileName;
 
     auto outPath = s_redirectDocumentationToDevNull ? QStringLiteral("/dev/null") : path;
-    auto outFile = new QFile(outPath);
 
-    if (!s_redirectDocumentationToDevNull && outFile->exists()) {
-        const QString warningText {"Output file already exists, overwriting %1"_L1.arg(outFile->fileName())};
+    if (!s_redirectDocumentationToDevNull && QFile::exists(outPath)) {
+        const QString warningText {"Output file already exists, overwriting %1"_L1.arg(outPath)};
         if (qEnvironmentVariableIsSet("QDOC_ALL_OVERWRITES_ARE_WARNINGS"))
             node->location().warning(warningText);
         else
             qCDebug(lcQdoc) << qUtf8Printable(warningText);
     }
 
-    if (!outFile->open(QFile::WriteOnly | QFile::Text)) {
-        node->location().fatal(
-                QStringLiteral("Cannot open output file '%1'").arg(outFile->fileName()));
-    }
-
     qCDebug(lcQdoc, "Writing: %s", qPrintable(path));
     s_outFileNames << fileName;
+    s_outFileNameSet.insert(fileName);
     s_trademarks.clear();
-    return outFile;
+    return outPath;
+}
+
+/*
+  Collects the contents of a subpage in memory, so that the page is
+  written with a single write at the end. Pages whose output file
+  already has the same contents are not rewritten, which keeps the
+  timestamps of unchanged pages for incremental deployments.
+
+  The buffer reserves the size of the previous output file up front,
+  so that regenerating a page does not grow the buffer repeatedly.
+ */
+class SubPageBuffer : public QBuffer
+{
+public:
+    SubPageBuffer(const QString &fileName, const Location &location)
+        : m_fileName(fileName), m_location(location), m_previousSize(QFileInfo(fileName).size())
+    {
+        buffer().reserve(qMax(m_previousSize, qint64(4096)));
+        open(QIODevice::WriteOnly);
+    }
+
+    [[nodiscard]] const QString &fileName() const { return m_fileName; }
+    void commit();
+
+private:
+    QString m_fileName;
+    Location m_location;
+    qint64 m_previousSize;
+};
+
+void SubPageBuffer::commit()
+{
+    const QByteArray &contents = data();
+    TimingReport::addPage(m_fileName, contents.size());
+    const bool compress = CompressedOutput::isEnabled() && m_fileName != "/dev/null"_L1;
+    QFile file(m_fileName);
+    // In text mode, the file is never shorter than the contents it was written with
+    if (m_previousSize >= contents.size() && file.open(QFile::ReadOnly | QFile::Text)) {
+        const bool unchanged = file.readAll() == contents;
+        file.close();
+        if (unchanged) {
+            if (compress && !QFile::exists(m_fileName + ".gz"_L1))
+                CompressedOutput::writeText(m_fileName, contents);
+            return;
+        }
+    }
+
+    if (!file.open(QFile::WriteOnly | QFile::Text))
+        m_location.fatal(QStringLiteral("Cannot open output file '%1'").arg(m_fileName));
+    file.write(contents);
+    if (compress)
+        CompressedOutput::writeText(m_fileName, contents);
 }
 
 /*!
-  Creates the file named \a fileName in the output directory.
-  Attaches a QTextStream to the created file, which is written
-  to all over the place using out().
+  Starts the subpage that is written to the file named \a fileName
+  in the output directory. Attaches a QTextStream to the buffer
+  collecting the contents of the subpage, which is written to all
+  over the place using out().
  */
 void Generator::beginSubPage(const Node *node, const QString &fileName)
 {
     Q_ASSERT(node->isPageNode());
-    QFile *outFile = openSubPageFile(static_cast<const PageNode*>(node), fileName);
-    auto *out = new QTextStream(outFile);
+    const QString path = subPageFilePath(static_cast<const PageNode *>(node), fileName);
+    auto *out = new QTextStream(new SubPageBuffer(path, node->location()));
     outStreamStack.push(out);
 }
 
 /*!
-  Flush the text stream associated with the subpage, and
-  then pop it off the text stream stack and delete it.
-  This terminates output of the subpage.
+  Flush the text stream associated with the subpage, write the
+  contents of the subpage to its file, and then pop the text
+  stream off the text stream stack and delete it. This terminates
+  output of the subpage.
  */
 void Generator::endSubPage()
 {
     outStreamStack.top()->flush();
-    delete outStreamStack.top()->device();
+    auto *buffer = static_cast<SubPageBuffer *>(outStreamStack.top()->device());
+    buffer->commit();
+    delete buffer;
     delete outStreamStack.pop();
 }
 
+/*!
+  Releases the documentation bodies of the members of \a aggregate
+  after the page of \a aggregate has been written, if QDoc runs with
+  \c {-release-docs} and is generating the last output format.
+
+  The members are the functions, properties, enums, and other nodes
+  that have no page of their own and are only documented on the page
+  of their parent. Nodes that \\relates moved here are kept, as they
+  are also listed elsewhere.
+
+  \sa Doc::releaseBody()
+ */
+void Generator::releaseMemberDocs(Aggregate *aggregate)
+{
+    if (!s_releaseDocs)
+        return;
+    for (auto *child : aggregate->childNodes()) {
+        if (child->isPageNode() || child->parent() != aggregate || child->isRelatedNonmember())
+            continue;
+        child->releaseDocBody();
+    }
+}
+
+/*!
+  Returns the device collecting the contents of the current subpage.
+  Generators that produce XML write to it with a QXmlStreamWriter
+  directly, which avoids encoding the page twice through out().
+ */
+QIODevice *Generator::subPageDevice()
+{
+    out().flush();
+    return out().device();
+}
+
 QString Generator::fileBase(const Node *node) const
 {
     if (!node->isPageNode() && !node->isCollectionNode())
@@ -881,7 +969,9 @@ void Generator::addImageToCopy(const ExampleNode *en, const ResolvedFile& resolv
     // Understand if we really need this information and where it should
     // belong, considering that it should be part of whichever system
     // would actually store the file itself.
-    s_outFileNames << prefix.mid(1) + "/" + resolved_file.get_query();
+    const QString imageFileName = prefix.mid(1) + "/" + resolved_file.get_query();
+    s_outFileNames << imageFileName;
+    s_outFileNameSet.insert(imageFileName);
 
 
     // TODO: [uncentralized-output-directory-structure]
@@ -1031,11 +1121,13 @@ void Generator::generateDocumentation(Node *node)
                 beginSubPage(node, fileName(node));
                 generateCppReferencePage(static_cast<Aggregate *>(node), marker);
                 endSubPage();
+                releaseMemberDocs(static_cast<Aggregate *>(node));
             } else if (node->isQmlType()) {
                 beginSubPage(node, fileName(node));
                 auto *qcn = static_cast<QmlTypeNode *>(node);
                 generateQmlTypePage(qcn, marker);
                 endSubPage();
+                releaseMemberDocs(qcn);
             } else if (node->isProxyNode()) {
                 beginSubPage(node, fileName(node));
                 generateProxyPage(static_cast<Aggregate *>(node), marker);
@@ -1797,9 +1889,14 @@ void Generator::copyTemplateFiles(const QString &configVar, const QString &subDi
             // TODO: [uncentralized-admonition]
             loc.fatal(QStringLiteral("Cannot create %1 directory '%2'").arg(subDir, templateDir));
         } else {
+            // Images are compressed already.
+            const bool compress = CompressedOutput::isEnabled() && subDir != "images"_L1;
             for (const auto &file : files) {
-                if (!file.isEmpty())
-                    Config::copyFile(loc, file, file, templateDir);
+                if (file.isEmpty())
+                    continue;
+                const QString copy = Config::copyFile(loc, file, file, templateDir);
+                if (compress && !copy.isEmpty())
+                    CompressedOutput::writeCopy(copy);
             }
         }
     }
@@ -1814,6 +1911,7 @@ void Generator::initializeFormat()
 {
     Config &config = Config::instance();
     s_outFileNames.clear();
+    s_outFileNameSet.clear();
     s_useOutputSubdirs = true;
     if (config.get(format() + Config::dot + "nosubdirs").asBool())
         resetUseOutputSubdirs();
@@ -1884,7 +1982,7 @@ QTextStream &Generator::out()
 
 QString Generator::outFileName()
 {
-    return QFileInfo(static_cast<QFile *>(out().device())->fileName()).fileName();
+    return QFileInfo(static_cast<SubPageBuffer *>(out().device())->fileName()).fileName();
 }
 
 QString Generator::outputPrefix(const Node *node)
@@ -2120,6 +2218,7 @@ void Generator::terminate()
         if (s_outputFormats.contains(generator->format()))
             generator->terminateGenerator();
     }
+    Sections::clearCaches();
 
     // REMARK: Generators currently, due to recent changes and the
     // transitive nature of the current codebase, receive some of
@@ -66,6 +66,7 @@ public:
     static QString defaultModuleName() { return s_project; }
     static void resetUseOutputSubdirs() { s_useOutputSubdirs = false; }
     static bool useOutputSubdirs() { return s_useOutputSubdirs; }
+    static void setReleaseDocs(bool release) { s_releaseDocs = release; }
     static void setQmlTypeContext(QmlTypeNode *t) { s_qmlTypeContext = t; }
     static QmlTypeNode *qmlTypeContext() { return s_qmlTypeContext; }
     static QString cleanRef(const QString &ref, bool xmlCompliant = false);
@@ -73,9 +74,11 @@ public:
     virtual QString fileBase(const Node *node) const;
 
 protected:
-    static QFile *openSubPageFile(const PageNode *node, const QString &fileName);
+    static QString subPageFilePath(const PageNode *node, const QString &fileName);
     void beginSubPage(const Node *node, const QString &fileName);
     void endSubPage();
+    static void releaseMemberDocs(Aggregate *aggregate);
+    QIODevice *subPageDevice();
     [[nodiscard]] virtual QString fileExtension() const = 0;
     virtual void generateExampleFilePage(const Node *, ResolvedFile, CodeMarker * = nullptr) {}
     virtual void generateAlsoList(const Node *node, CodeMarker *marker);
@@ -178,6 +181,8 @@ private:
     static QString s_outDir;
     static QString s_outSubdir;
     static QStringList s_outFileNames;
+    // Mirrors s_outFileNames for constant-time duplicate checks.
+    static QSet<QString> s_outFileNameSet;
     static QSet<QString> s_outputFormats;
     static QSet<QString> s_trademarks;
     static QHash<QString, QString> s_outputPrefixes;
@@ -186,6 +191,7 @@ private:
     static bool s_autolinkErrors;
     static bool s_redirectDocumentationToDevNull;
     static bool s_useOutputSubdirs;
+    static bool s_releaseDocs;
     static QmlTypeNode *s_qmlTypeContext;
 
     void generateReimplementsClause(const FunctionNode *fn, CodeMarker *marker);
@@ -20,6 +20,7 @@
 #include "qmlpropertynode.h"
 #include "sharedcommentnode.h"
 #include "tagfilewriter.h"
+#include "timingreport.h"
 #include "tree.h"
 #include "quoter.h"
 #include "utilities.h"
@@ -242,6 +243,7 @@ void HtmlGenerator::generateDocs()
         Generator::generateDocs();
 
     if (!config->generating()) {
+        TimingReport::Phase phase(u"index file"_s);
         QString fileBase =
                 m_project.toLower().simplified().replace(QLatin1Char(' '), QLatin1Char('-'));
         m_qdb->generateIndex(outputDir() + QLatin1Char('/') + fileBase + ".index", m_projectUrl,
@@ -249,12 +251,19 @@ void HtmlGenerator::generateDocs()
     }
 
     if (!config->preparing()) {
-        m_helpProjectWriter->generate();
-        m_manifestWriter->generateManifestFiles();
+        {
+            TimingReport::Phase phase(u"help project"_s);
+            m_helpProjectWriter->generate();
+        }
+        {
+            TimingReport::Phase phase(u"manifest files"_s);
+            m_manifestWriter->generateManifestFiles();
+        }
         /*
           Generate the XML tag file, if it was requested.
         */
         if (!tagFile_.isEmpty()) {
+            TimingReport::Phase phase(u"tag file"_s);
             TagFileWriter tagFileWriter;
             tagFileWriter.generateTagFile(tagFile_, this);
         }
@@ -444,10 +453,10 @@ qsizetype HtmlGenerator::generateAtom(const Atom *atom, const Node *relative, Co
         break;
     case Atom::AnnotatedList: {
         if (const auto *cn = m_qdb->getCollectionNode(atom->string(), Node::Group); cn)
-            generateList(cn, marker, atom->string(), Generator::sortOrder(atom->strings().last()));
+            generateList(cn, marker, atom->string(), Generator::sortOrder(atom->lastString()));
     } break;
     case Atom::GeneratedList: {
-        const auto sortOrder{Generator::sortOrder(atom->strings().last())};
+        const auto sortOrder{Generator::sortOrder(atom->lastString())};
         if (atom->string() == QLatin1String("annotatedclasses")) {
             generateAnnotatedList(relative, marker, m_qdb->getCppClasses().values(), sortOrder);
         } else if (atom->string() == QLatin1String("annotatedexamples")) {
@@ -3363,42 +3372,7 @@ QString HtmlGenerator::protectEnc(const QString &string)
 
 QString HtmlGenerator::protect(const QString &string)
 {
-#define APPEND(x)                                                                                  \
-    if (html.isEmpty()) {                                                                          \
-        html = string;                                                                             \
-        html.truncate(i);                                                                          \
-    }                                                                                              \
-    html += (x);
-
-    QString html;
-    qsizetype n = string.size();
-
-    for (int i = 0; i < n; ++i) {
-        QChar ch = string.at(i);
-
-        if (ch == QLatin1Char('&')) {
-            APPEND("&amp;");
-        } else if (ch == QLatin1Char('<')) {
-            APPEND("&lt;");
-        } else if (ch == QLatin1Char('>')) {
-            APPEND("&gt;");
-        } else if (ch == QChar(8211)) {
-            APPEND("&ndash;");
-        } else if (ch == QChar(8212)) {
-            APPEND("&mdash;");
-        } else if (ch == QLatin1Char('"')) {
-            APPEND("&quot;");
-        } else {
-            if (!html.isEmpty())
-                html += ch;
-        }
-    }
-
-    if (!html.isEmpty())
-        return html;
-    return string;
-
-#undef APPEND
+    return Utilities::protect(string, true);
 }
 
 QString HtmlGenerator::fileBase(const Node *node) const
@@ -4,6 +4,7 @@
 #include "clangcodeparser.h"
 #include "codemarker.h"
 #include "codeparser.h"
+#include "compressedoutput.h"
 #include "config.h"
 #include "cppcodemarker.h"
 #include "doc.h"
@@ -15,6 +16,7 @@
 #include "qmlcodemarker.h"
 #include "qmlcodeparser.h"
 #include "sourcefileparser.h"
+#include "timingreport.h"
 #include "utilities.h"
 #include "tokenizer.h"
 #include "tree.h"
@@ -28,6 +30,8 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qglobal.h>
 #include <QtCore/qhashfunctions.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qtextstream.h>
 
 #include <set>
 
@@ -63,6 +67,7 @@ bool creationTimeBefore(const QFileInfo &fi1, const QFileInfo &fi2)
 */
 static void parseSourceFiles(
     std::vector<QString>&& sources,
+    ClangCodeParser& clang_parser,
     SourceFileParser& source_file_parser,
     CppCodeParser& cpp_code_parser
 ) {
@@ -74,19 +79,35 @@ static void parseSourceFiles(
         sources.end()
     );
 
+    for (const auto &source : sources)
+        Config::instance().addInputFile(source);
+
     auto qml_sources =
         std::stable_partition(sources.begin(), sources.end(), [](const QString& source){
             return CodeParser::parserForSourceFile(source) == CodeParser::parserForLanguage("QML");
         });
 
 
+    // Let libclang parse translation units ahead on worker threads;
+    // their contents are still visited in source order below.
+    std::vector<QString> cpp_sources{};
+    std::copy_if(qml_sources, sources.end(), std::back_inserter(cpp_sources),
+                 [](const QString &source) {
+                     const SourceFileTag tag = tag_source_file(source).second;
+                     return std::holds_alternative<CppSourceFile>(tag)
+                             || std::holds_alternative<CppHeaderSourceFile>(tag);
+                 });
+    clang_parser.prefetch(cpp_sources, Config::instance().jobs());
+
     std::for_each(qml_sources, sources.end(),
             [&source_file_parser, &cpp_code_parser, &error_handler](const QString& source){
         qCDebug(lcQdoc, "Parsing %s", qPrintable(source));
+        TimingReport::SourceFile timing(source);
 
         auto [untied_documentation, tied_documentation] = source_file_parser(tag_source_file(source));
         std::vector<FnMatchError> errors{};
 
+        cpp_code_parser.prepareFnTopics(untied_documentation);
         for (auto untied : untied_documentation) {
             auto result = cpp_code_parser.processTopicArgs(untied);
             tied_documentation.insert(tied_documentation.end(), result.first.begin(), result.first.end());
@@ -99,11 +120,18 @@ static void parseSourceFiles(
             error_handler(e);
     });
 
+    // Likewise, let the QML files be read and parsed ahead; the nodes
+    // they document are still created in source order below.
+    static_cast<QmlCodeParser *>(CodeParser::parserForLanguage("QML"))
+            ->prefetch(std::vector<QString>(sources.begin(), qml_sources),
+                       Config::instance().jobs());
+
     std::for_each(sources.begin(), qml_sources, [&cpp_code_parser](const QString& source){
         auto *codeParser = CodeParser::parserForSourceFile(source);
         if (!codeParser) return;
 
         qCDebug(lcQdoc, "Parsing %s", qPrintable(source));
+        TimingReport::SourceFile timing(source);
         codeParser->parseSourceFile(Config::instance().location(), source, cpp_code_parser);
     });
 
@@ -259,9 +287,51 @@ static void loadIndexFiles(const QSet<QString> &formats)
                                   "There will probably be errors for missing links."));
         }
     }
+    for (const auto &indexFile : std::as_const(indexFiles))
+        config.addInputFile(indexFile);
     qdb->readIndexes(indexFiles);
 }
 
+/*!
+    \internal
+    Escapes \a path for use in a Makefile-style dependency file.
+ */
+static QString escapeDependencyPath(QString path)
+{
+    path.replace(u'$', "$$"_L1);
+    path.replace(u'#', "\\#"_L1);
+    path.replace(u' ', "\\ "_L1);
+    return path;
+}
+
+/*!
+    \internal
+    Writes the dependency file requested with \c{--depfile}, with
+    the output directory \a target depending on all files QDoc read.
+ */
+static void writeDependencyFile(const Config &config, const QString &target)
+{
+    const QString &depFile = config.depFile();
+    if (depFile.isEmpty())
+        return;
+
+    QStringList inputs = config.inputFiles().values();
+    inputs.sort();
+
+    QSaveFile file(depFile);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QTextStream out(&file);
+        out << escapeDependencyPath(target) << ':';
+        for (const auto &input : std::as_const(inputs))
+            out << " \\\n  " << escapeDependencyPath(input);
+        out << '\n';
+        out.flush();
+        if (file.commit())
+            return;
+    }
+    qCWarning(lcQdoc) << "Cannot write dependency file" << depFile << ':' << file.errorString();
+}
+
 /*!
     \internal
     Prints to stderr the name of the project that QDoc is running for,
@@ -296,6 +366,10 @@ static void processQdocconfFile(const QString &fileName)
 {
     Config &config = Config::instance();
     config.setPreviousCurrentDir(QDir::currentPath());
+    TimingReport::setContext(fileName,
+                             config.preparing() ? u"prepare"_s
+                                                : config.generating() ? u"generate"_s : QString());
+    TimingReport::Phase processPhase(u"total"_s);
 
     /*
       With the default configuration values in place, load
@@ -307,7 +381,10 @@ static void processQdocconfFile(const QString &fileName)
       purposes.
      */
     Location::initialize();
-    config.load(fileName);
+    {
+        TimingReport::Phase phase(u"config"_s);
+        config.load(fileName);
+    }
     QString project{config.get(CONFIG_PROJECT).asString()};
     if (project.isEmpty()) {
         qCCritical(lcQdoc) << QLatin1String("qdoc can't run; no project set in qdocconf file");
@@ -450,6 +527,7 @@ static void processQdocconfFile(const QString &fileName)
     if (!config.singleExec()) {
         if (!config.preparing()) {
             qCDebug(lcQdoc, "  loading index files");
+            TimingReport::Phase phase(u"index files"_s);
             loadIndexFiles(outputFormats);
             qCDebug(lcQdoc, "  done loading index files");
         }
@@ -509,12 +587,14 @@ static void processQdocconfFile(const QString &fileName)
     std::optional<PCHFile> pch = std::nullopt;
     if (config.dualExec() || config.preparing()) {
         const QString moduleHeader = config.get(CONFIG_MODULEHEADER).asString();
+        TimingReport::Phase phase(u"pch"_s);
         pch = buildPCH(
             QDocDatabase::qdocDB(),
             moduleHeader.isNull() ? project : moduleHeader,
             Config::instance().getHeaderFiles(),
             include_paths,
-            clang_defines
+            clang_defines,
+            config.pchCacheDir()
         );
     }
 
@@ -571,10 +651,13 @@ static void processQdocconfFile(const QString &fileName)
 
 
         auto headers = config.getHeaderFiles();
+        for (const auto &header : headers)
+            config.addInputFile(header.path + u'/' + header.filename);
         CppCodeParser cpp_code_parser(FnCommandParser(qdb, headers, clang_defines, pch));
 
         SourceFileParser source_file_parser{clangParser, docParser};
-        parseSourceFiles(std::move(sources), source_file_parser, cpp_code_parser);
+        TimingReport::Phase phase(u"parse"_s);
+        parseSourceFiles(std::move(sources), clangParser, source_file_parser, cpp_code_parser);
 
         if (config.get(CONFIG_LOGPROGRESS).asBool())
             qCInfo(lcQdoc) << "Source files parsed for" << project;
@@ -585,7 +668,10 @@ static void processQdocconfFile(const QString &fileName)
       targets, URLs, links, and other stuff that needs resolving.
     */
     qCDebug(lcQdoc, "Resolving stuff prior to generating docs");
-    qdb->resolveStuff();
+    {
+        TimingReport::Phase phase(u"resolve"_s);
+        qdb->resolveStuff();
+    }
 
     /*
       The primary tree is built and all the stuff that needed
@@ -595,9 +681,15 @@ static void processQdocconfFile(const QString &fileName)
       one.
      */
     qCDebug(lcQdoc, "Generating docs");
+    qsizetype remainingFormats = outputFormats.size();
     for (const auto &format : outputFormats) {
         auto *generator = Generator::generatorForFormat(format);
+        // Member docs can only be released while generating the last format, and
+        // when no index file is written afterwards.
+        const bool lastFormat = --remainingFormats == 0;
+        Generator::setReleaseDocs(config.releaseDocs() && config.generating() && lastFormat);
         if (generator) {
+            TimingReport::Phase phase(u"generate "_s + format);
             generator->initializeFormat();
             generator->generateDocs();
         } else {
@@ -607,6 +699,9 @@ static void processQdocconfFile(const QString &fileName)
         }
     }
 
+    CompressedOutput::waitForFinished();
+    writeDependencyFile(config, Generator::outputDir());
+
     qCDebug(lcQdoc, "Terminating qdoc classes");
     if (Utilities::debugging())
         Utilities::stopDebugging(project);
@@ -685,6 +780,7 @@ int main(int argc, char **argv)
 #endif
     QCoreApplication app(argc, argv);
     app.setApplicationVersion(QLatin1String(QT_VERSION_STR));
+    ChromeTrace::initialize("qdoc"_L1);
 
     // Instantiate various singletons (used via static methods):
     /*
@@ -708,6 +804,7 @@ int main(int argc, char **argv)
     QmlCodeMarker qmlMarker;
 
     Config::instance().init("QDoc", app.arguments());
+    TimingReport::setEnabled(!Config::instance().timingReport().isEmpty());
 
     if (Config::instance().qdocFiles().isEmpty())
         Config::instance().showHelp();
@@ -718,6 +815,8 @@ int main(int argc, char **argv)
         dualExecutionMode();
     }
 
+    TimingReport::write(Config::instance().timingReport());
+
     // Tidy everything away:
     QmlTypeNode::terminate();
     QDocDatabase::destroyQdocDB();
@@ -17,6 +17,7 @@
 #include "tokenizer.h"
 #include "tree.h"
 
+#include <QtCore/qset.h>
 #include <QtCore/quuid.h>
 #include <QtCore/qversionnumber.h>
 
@@ -26,6 +27,25 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+/*!
+  \internal
+
+  Returns a copy of \a string that shares its data with all other strings
+  equal to it that were passed to this function. The module names and
+  versions are repeated for a large number of nodes, which then refer to
+  one copy instead of each holding its own.
+ */
+static QString internString(const QString &string)
+{
+    static QSet<QString> pool;
+    if (string.isEmpty())
+        return string;
+    auto it = pool.constFind(string);
+    if (it == pool.cend())
+        it = pool.insert(string);
+    return *it;
+}
+
 /*!
   \class Node
   \brief The Node class is the base class for all the nodes in QDoc's parse tree.
@@ -569,7 +589,7 @@ void Node::setStatus(Status t)
             break;
         Q_FALLTHROUGH();
     case DontDocument:
-        m_url = QStringLiteral("");
+        extra().m_url = QStringLiteral("");
         break;
     default:
         break;
@@ -789,7 +809,64 @@ void Node::setSince(const QString &since)
     if (!cutoff.isNull() && QVersionNumber::fromString(parts.last()).normalized() < cutoff)
         return;
 
-    m_since = parts.join(QLatin1Char(' '));
+    m_since = internString(parts.join(QLatin1Char(' ')));
+}
+
+/*!
+  Sets the name of the physical module the node belongs to to \a name.
+ */
+void Node::setPhysicalModuleName(const QString &name)
+{
+    m_physicalModuleName = internString(name);
+}
+
+/*!
+  Sets the template declaration of the node to \a t.
+ */
+void Node::setTemplateDecl(std::optional<RelaxedTemplateDeclaration> t)
+{
+    if (t || m_extra)
+        extra().m_templateDecl = std::move(t);
+}
+
+/*!
+  Returns the template declaration of the node, if any.
+ */
+const std::optional<RelaxedTemplateDeclaration> &Node::templateDecl() const
+{
+    static const std::optional<RelaxedTemplateDeclaration> none;
+    return m_extra ? m_extra->m_templateDecl : none;
+}
+
+/*!
+  Returns the brief read from the index file for the node, if any.
+ */
+const QString &Node::reconstitutedBrief() const
+{
+    static const QString empty;
+    return m_extra ? m_extra->m_reconstitutedBrief : empty;
+}
+
+/*!
+  Returns the version the node was deprecated in, if any.
+ */
+const QString &Node::deprecatedSince() const
+{
+    static const QString empty;
+    return m_extra ? m_extra->m_deprecatedSince : empty;
+}
+
+/*!
+  \internal
+
+  Returns the members that few nodes set, allocating them on the first
+  call and detaching them from the clones of this node.
+ */
+Node::ExtraData &Node::extra()
+{
+    if (!m_extra)
+        m_extra = new ExtraData;
+    return *m_extra;
 }
 
 /*!
@@ -1008,12 +1085,13 @@ QString Node::fullDocumentName() const
 void Node::setDeprecated(const QString &sinceVersion)
 {
 
-    if (!m_deprecatedSince.isEmpty())
+    if (!deprecatedSince().isEmpty())
         qCWarning(lcQdoc) << QStringLiteral(
                                      "Setting deprecated since version for %1 to %2 even though it "
                                      "was already set to %3. This is very unexpected.")
-                                     .arg(this->m_name, sinceVersion, this->m_deprecatedSince);
-    m_deprecatedSince = sinceVersion;
+                                     .arg(this->m_name, sinceVersion, deprecatedSince());
+    if (!sinceVersion.isEmpty() || m_extra)
+        extra().m_deprecatedSince = internString(sinceVersion);
 
     if (!sinceVersion.isEmpty()) {
         QVersionNumber since = QVersionNumber::fromString(sinceVersion).normalized();
@@ -1092,10 +1170,6 @@ void Node::setDeprecated(const QString &sinceVersion)
   \sa ThreadSafeness
 */
 
-/*! \fn void Node::setPhysicalModuleName(const QString &name)
-  Sets the node's physical module \a name.
-*/
-
 /*! \fn void Node::setReconstitutedBrief(const QString &t)
   When reading an index file, this function is called with the
   reconstituted brief clause \a t to set the node's brief clause.
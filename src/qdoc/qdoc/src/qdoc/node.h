@@ -16,6 +16,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qshareddata.h>
 #include <QtCore/qstringlist.h>
 
 #include <optional>
@@ -203,13 +204,14 @@ public:
     void setAccess(Access t) { m_access = t; }
     void setLocation(const Location &t);
     void setDoc(const Doc &doc, bool replace = false);
+    void releaseDocBody() { m_doc.releaseBody(); }
     void setStatus(Status t);
     void setThreadSafeness(ThreadSafeness t) { m_safeness = t; }
     void setSince(const QString &since);
-    void setPhysicalModuleName(const QString &name) { m_physicalModuleName = name; }
-    void setUrl(const QString &url) { m_url = url; }
-    void setTemplateDecl(std::optional<RelaxedTemplateDeclaration> t) { m_templateDecl = t; }
-    void setReconstitutedBrief(const QString &t) { m_reconstitutedBrief = t; }
+    void setPhysicalModuleName(const QString &name);
+    void setUrl(const QString &url) { extra().m_url = url; }
+    void setTemplateDecl(std::optional<RelaxedTemplateDeclaration> t);
+    void setReconstitutedBrief(const QString &t) { extra().m_reconstitutedBrief = t; }
     void setParent(Aggregate *n) { m_parent = n; }
     void setIndexNodeFlag(bool isIndexNode = true) { m_indexNodeFlag = isIndexNode; }
     void setHadDoc() { m_hadDoc = true; }
@@ -244,7 +246,7 @@ public:
     [[nodiscard]] Aggregate *parent() const { return m_parent; }
     [[nodiscard]] const QString &name() const { return m_name; }
     [[nodiscard]] QString physicalModuleName() const { return m_physicalModuleName; }
-    [[nodiscard]] QString url() const { return m_url; }
+    [[nodiscard]] QString url() const { return m_extra ? m_extra->m_url : QString(); }
     virtual void setQtVariable(const QString &) {}
     [[nodiscard]] virtual QString qtVariable() const { return QString(); }
     virtual void setCMakePackage(const QString &) {}
@@ -256,7 +258,7 @@ public:
     [[nodiscard]] virtual bool hasTag(const QString &) const { return false; }
 
     void setDeprecated(const QString &sinceVersion);
-    [[nodiscard]] const QString &deprecatedSince() const { return m_deprecatedSince; }
+    [[nodiscard]] const QString &deprecatedSince() const;
 
     [[nodiscard]] const QMap<LinkType, std::pair<QString, QString>> &links() const { return m_linkMap; }
     void setLink(LinkType linkType, const QString &link, const QString &desc);
@@ -279,8 +281,8 @@ public:
     [[nodiscard]] ThreadSafeness threadSafeness() const;
     [[nodiscard]] ThreadSafeness inheritedThreadSafeness() const;
     [[nodiscard]] QString since() const { return m_since; }
-    [[nodiscard]] const std::optional<RelaxedTemplateDeclaration>& templateDecl() const { return m_templateDecl; }
-    [[nodiscard]] const QString &reconstitutedBrief() const { return m_reconstitutedBrief; }
+    [[nodiscard]] const std::optional<RelaxedTemplateDeclaration>& templateDecl() const;
+    [[nodiscard]] const QString &reconstitutedBrief() const;
 
     [[nodiscard]] bool isSharingComment() const { return (m_sharedCommentNode != nullptr); }
     void setSharedCommentNode(SharedCommentNode *t) { m_sharedCommentNode = t; }
@@ -313,6 +315,18 @@ protected:
     Node(NodeType type, Aggregate *parent, QString name);
 
 private:
+    // The members that only few nodes set, allocated on the first set and
+    // shared between a node and its clones until either changes them.
+    struct ExtraData : public QSharedData
+    {
+        QString m_url {};
+        QString m_reconstitutedBrief {};
+        QString m_deprecatedSince {};
+        std::optional<RelaxedTemplateDeclaration> m_templateDecl { std::nullopt };
+    };
+
+    ExtraData &extra();
+
     NodeType m_nodeType {};
     Genus m_genus {};
     Access m_access { Access::Public };
@@ -332,11 +346,8 @@ private:
     QMap<LinkType, std::pair<QString, QString>> m_linkMap {};
     QString m_fileNameBase {};
     QString m_physicalModuleName {};
-    QString m_url {};
     QString m_since {};
-    std::optional<RelaxedTemplateDeclaration> m_templateDecl{std::nullopt};
-    QString m_reconstitutedBrief {};
-    QString m_deprecatedSince {};
+    QSharedDataPointer<ExtraData> m_extra {};
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Node::SignatureOptions)
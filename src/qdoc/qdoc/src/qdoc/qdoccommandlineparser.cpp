@@ -35,7 +35,13 @@ QDocCommandLineParser::QDocCommandLineParser()
       frameworkOption("F", "Add macOS framework to the include path for header files.",
                       "framework"),
       timestampsOption(QStringList() << QStringLiteral("timestamps")),
-      useDocBookExtensions(QStringList() << QStringLiteral("docbook-extensions"))
+      useDocBookExtensions(QStringList() << QStringLiteral("docbook-extensions")),
+      pchCacheDirOption(QStringList() << QStringLiteral("pch-cache-dir")),
+      jobsOption(QStringList() << QStringLiteral("j")),
+      depFileOption(QStringList() << QStringLiteral("depfile")),
+      timingReportOption(QStringList() << QStringLiteral("timing-report")),
+      precompressOption(QStringList() << QStringLiteral("precompress")),
+      releaseDocsOption(QStringList() << QStringLiteral("release-docs"))
 {
     setApplicationDescription(QStringLiteral("Qt documentation generator"));
     addHelpOption();
@@ -132,6 +138,44 @@ QDocCommandLineParser::QDocCommandLineParser()
     useDocBookExtensions.setDescription(
             QStringLiteral("Use the DocBook Library extensions for metadata."));
     addOption(useDocBookExtensions);
+
+    pchCacheDirOption.setDescription(
+            QStringLiteral("Specify a directory where QDoc keeps precompiled module headers "
+                           "between runs. Overrides the environment variable QDOC_PCH_CACHE_DIR."));
+    pchCacheDirOption.setValueName(QStringLiteral("dir"));
+    addOption(pchCacheDirOption);
+
+    jobsOption.setDescription(
+            QStringLiteral("Use up to N threads for parsing C++ source files. "
+                           "0 uses one thread per CPU core. The default is 1."));
+    jobsOption.setValueName(QStringLiteral("N"));
+    jobsOption.setFlags(QCommandLineOption::ShortOptionStyle);
+    addOption(jobsOption);
+
+    depFileOption.setDescription(
+            QStringLiteral("Write a Makefile-style dependency file listing all files QDoc "
+                           "read, so that build systems only run QDoc again when one of "
+                           "them changes."));
+    depFileOption.setValueName(QStringLiteral("file"));
+    addOption(depFileOption);
+
+    timingReportOption.setDescription(
+            QStringLiteral("Write a JSON report of the time and memory used by each phase, "
+                           "the slowest source files, and the largest generated pages."));
+    timingReportOption.setValueName(QStringLiteral("file"));
+    addOption(timingReportOption);
+
+    precompressOption.setDescription(
+            QStringLiteral("Write a gzip-compressed copy, with the .gz suffix, next to each "
+                           "generated page, style sheet, script, and index file, for web "
+                           "servers that serve precompressed files."));
+    addOption(precompressOption);
+
+    releaseDocsOption.setDescription(
+            QStringLiteral("With -generate or -single-exec, release the documentation of "
+                           "class and QML type members once their pages are written, "
+                           "to reduce peak memory use."));
+    addOption(releaseDocsOption);
 }
 
 /*!
@@ -21,6 +21,8 @@ struct QDocCommandLineParser : public QCommandLineParser
     QCommandLineOption prepareOption, generateOption, logProgressOption, singleExecOption;
     QCommandLineOption includePathOption, includePathSystemOption, frameworkOption;
     QCommandLineOption timestampsOption, useDocBookExtensions;
+    QCommandLineOption pchCacheDirOption, jobsOption, depFileOption,
+            timingReportOption, precompressOption, releaseDocsOption;
 };
 
 QT_END_NAMESPACE
@@ -115,6 +115,7 @@ void QDocForest::setPrimaryTree(const QString &t)
     QString T = t.toLower();
     m_primaryTree = findTree(T);
     m_forest.remove(T);
+    clearQmlTypeCache();
     if (m_primaryTree == nullptr)
         qCCritical(lcQdoc) << "Error: Could not set primary tree to" << t;
 }
@@ -127,6 +128,7 @@ void QDocForest::setSearchOrder(const QStringList &t)
 {
     if (!m_searchOrder.isEmpty())
         return;
+    clearQmlTypeCache();
 
     /* Allocate space for the search order. */
     m_searchOrder.reserve(m_forest.size() + 1);
@@ -241,6 +243,7 @@ NamespaceNode *QDocForest::newIndexTree(const QString &module)
 {
     m_primaryTree = new Tree(module, m_qdb);
     m_forest.insert(module.toLower(), m_primaryTree);
+    clearQmlTypeCache();
     return m_primaryTree->root();
 }
 
@@ -251,6 +254,38 @@ NamespaceNode *QDocForest::newIndexTree(const QString &module)
 void QDocForest::newPrimaryTree(const QString &module)
 {
     m_primaryTree = new Tree(module, m_qdb);
+    clearQmlTypeCache();
+}
+
+/*!
+  Returns the QML type \a name in the QML module \a module from
+  the first tree in the search order that has it, or \c nullptr
+  if none has. If \a module is empty, \a name is the qualified
+  name of the type.
+
+  Once the search order is set, the results, including the types
+  that were not found, are cached until a tree gets a new QML type
+  or the search order changes, so that resolving the many QML type
+  references of a module does not search all the trees each time.
+ */
+QmlTypeNode *QDocForest::lookupQmlType(const QString &module, const QString &name)
+{
+    const bool cached = !m_searchOrder.isEmpty();
+    const std::pair key{ module, name };
+    if (cached) {
+        if (auto it = m_qmlTypeCache.constFind(key); it != m_qmlTypeCache.cend())
+            return it.value();
+    }
+
+    const QString qualifiedName = module.isEmpty() ? name : module + "::"_L1 + name;
+    QmlTypeNode *qcn = nullptr;
+    for (const auto *tree : searchOrder()) {
+        if ((qcn = tree->lookupQmlType(qualifiedName)))
+            break;
+    }
+    if (cached)
+        m_qmlTypeCache.insert(key, qcn);
+    return qcn;
 }
 
 /*!
@@ -637,7 +672,7 @@ void QDocDatabase::initializeDB()
 QmlTypeNode *QDocDatabase::findQmlType(const QString &qmid, const QString &name)
 {
     if (!qmid.isEmpty()) {
-        if (auto *qcn = m_forest.lookupQmlType(qmid + u"::"_s + name); qcn)
+        if (auto *qcn = m_forest.lookupQmlType(qmid, name); qcn)
             return qcn;
     }
 
@@ -659,15 +694,14 @@ QmlTypeNode *QDocDatabase::findQmlType(const ImportRec &record, const QString &n
 
     // If the import is under a namespace (id) and the type name is not prefixed with that id,
     // then we know the type is not available under this import.
-    if (!record.m_importId.isEmpty()) {
-        const QString namespacePrefix{"%1."_L1.arg(record.m_importId)};
-        if (!type.startsWith(namespacePrefix))
+    if (const qsizetype idSize = record.m_importId.size()) {
+        if (type.size() <= idSize || type.at(idSize) != u'.' || !type.startsWith(record.m_importId))
             return nullptr;
-        type.remove(0, namespacePrefix.size());
+        type.remove(0, idSize + 1);
     }
 
-    const QString qmName = record.m_importUri.isEmpty() ? record.m_moduleName : record.m_importUri;
-    return m_forest.lookupQmlType(qmName + u"::"_s + type);
+    const QString &qmName = record.m_importUri.isEmpty() ? record.m_moduleName : record.m_importUri;
+    return m_forest.lookupQmlType(qmName, type);
 }
 
 /*!
@@ -685,36 +719,39 @@ QmlTypeNode *QDocDatabase::findQmlTypeInPrimaryTree(const QString &qmid, const Q
 }
 
 /*!
-  This function calls a set of functions for each tree in the
-  forest that has not already been analyzed. In this way, when
-  running qdoc in \e singleExec mode, each tree is analyzed in
-  turn, and its classes and types are added to the appropriate
-  node maps.
+  This function collects the classes, functions, obsolete things,
+  legalese texts, \e{since} information, and attributions of each
+  tree in the forest that has not already been analyzed. In this
+  way, when running qdoc in \e singleExec mode, each tree is
+  analyzed in turn, and its classes and types are added to the
+  appropriate node maps.
  */
 void QDocDatabase::processForest()
 {
-    processForest(&QDocDatabase::findAllClasses);
-    processForest(&QDocDatabase::findAllFunctions);
-    processForest(&QDocDatabase::findAllObsoleteThings);
-    processForest(&QDocDatabase::findAllLegaleseTexts);
-    processForest(&QDocDatabase::findAllSince);
-    processForest(&QDocDatabase::findAllAttributions);
+    processForest(Aggregate::FindAll);
     resolveNamespaces();
 }
 
 /*!
-  This function calls \a func for each tree in the forest,
-  ensuring that \a func is called only once per tree.
+  Makes sure that the collectors in \a flags have run on each tree
+  in the forest, running each collector only once per tree.
 
-  \sa processForest()
+  When a tree still lacks any of the requested collectors, all the
+  collectors that have not run on it yet run together, in a single
+  walk of the tree. Generators ask for the maps one at a time, so
+  this avoids walking each tree again for every map.
+
+  \sa processForest(), Aggregate::findAll()
  */
-void QDocDatabase::processForest(FindFunctionPtr func)
+void QDocDatabase::processForest(Aggregate::FindFlags flags)
 {
     Tree *t = m_forest.firstTree();
     while (t) {
-        if (!m_completedFindFunctions.values(t).contains(func)) {
-            (this->*(func))(t->root());
-            m_completedFindFunctions.insert(t, func);
+        Aggregate::FindFlags &completed = m_completedFinds[t];
+        if (!completed.testFlags(flags)) {
+            const Aggregate::FindFlags pending = ~completed & Aggregate::FindAll;
+            t->root()->findAll(pending, m_functionIndex, m_attributions, m_legaleseTexts);
+            completed |= pending;
         }
         t = m_forest.nextTree();
     }
@@ -725,7 +762,7 @@ void QDocDatabase::processForest(FindFunctionPtr func)
  */
 TextToNodeMap &QDocDatabase::getLegaleseTexts()
 {
-    processForest(&QDocDatabase::findAllLegaleseTexts);
+    processForest(Aggregate::FindLegaleseTexts);
     return m_legaleseTexts;
 }
 
@@ -734,7 +771,7 @@ TextToNodeMap &QDocDatabase::getLegaleseTexts()
  */
 NodeMultiMap &QDocDatabase::getClassesWithObsoleteMembers()
 {
-    processForest(&QDocDatabase::findAllObsoleteThings);
+    processForest(Aggregate::FindObsoleteThings);
     return s_classesWithObsoleteMembers;
 }
 
@@ -743,7 +780,7 @@ NodeMultiMap &QDocDatabase::getClassesWithObsoleteMembers()
  */
 NodeMultiMap &QDocDatabase::getObsoleteQmlTypes()
 {
-    processForest(&QDocDatabase::findAllObsoleteThings);
+    processForest(Aggregate::FindObsoleteThings);
     return s_obsoleteQmlTypes;
 }
 
@@ -752,7 +789,7 @@ NodeMultiMap &QDocDatabase::getObsoleteQmlTypes()
  */
 NodeMultiMap &QDocDatabase::getQmlTypesWithObsoleteMembers()
 {
-    processForest(&QDocDatabase::findAllObsoleteThings);
+    processForest(Aggregate::FindObsoleteThings);
     return s_qmlTypesWithObsoleteMembers;
 }
 
@@ -761,7 +798,7 @@ NodeMultiMap &QDocDatabase::getQmlTypesWithObsoleteMembers()
  */
 NodeMultiMap &QDocDatabase::getQmlValueTypes()
 {
-    processForest(&QDocDatabase::findAllClasses);
+    processForest(Aggregate::FindClasses);
     return s_qmlBasicTypes;
 }
 
@@ -770,7 +807,7 @@ NodeMultiMap &QDocDatabase::getQmlValueTypes()
  */
 NodeMultiMap &QDocDatabase::getQmlTypes()
 {
-    processForest(&QDocDatabase::findAllClasses);
+    processForest(Aggregate::FindClasses);
     return s_qmlTypes;
 }
 
@@ -779,7 +816,7 @@ NodeMultiMap &QDocDatabase::getQmlTypes()
  */
 NodeMultiMap &QDocDatabase::getExamples()
 {
-    processForest(&QDocDatabase::findAllClasses);
+    processForest(Aggregate::FindClasses);
     return s_examples;
 }
 
@@ -788,7 +825,7 @@ NodeMultiMap &QDocDatabase::getExamples()
  */
 NodeMultiMap &QDocDatabase::getAttributions()
 {
-    processForest(&QDocDatabase::findAllAttributions);
+    processForest(Aggregate::FindAttributions);
     return m_attributions;
 }
 
@@ -797,7 +834,7 @@ NodeMultiMap &QDocDatabase::getAttributions()
  */
 NodeMultiMap &QDocDatabase::getObsoleteClasses()
 {
-    processForest(&QDocDatabase::findAllObsoleteThings);
+    processForest(Aggregate::FindObsoleteThings);
     return s_obsoleteClasses;
 }
 
@@ -806,7 +843,7 @@ NodeMultiMap &QDocDatabase::getObsoleteClasses()
  */
 NodeMultiMap &QDocDatabase::getCppClasses()
 {
-    processForest(&QDocDatabase::findAllClasses);
+    processForest(Aggregate::FindClasses);
     return s_cppClasses;
 }
 
@@ -816,45 +853,10 @@ NodeMultiMap &QDocDatabase::getCppClasses()
  */
 NodeMapMap &QDocDatabase::getFunctionIndex()
 {
-    processForest(&QDocDatabase::findAllFunctions);
+    processForest(Aggregate::FindFunctions);
     return m_functionIndex;
 }
 
-/*!
-  Finds all the nodes containing legalese text and puts them
-  in a map.
- */
-void QDocDatabase::findAllLegaleseTexts(Aggregate *node)
-{
-    for (const auto &childNode : node->childNodes()) {
-        if (childNode->isPrivate())
-            continue;
-        if (!childNode->doc().legaleseText().isEmpty())
-            m_legaleseTexts.insert(childNode->doc().legaleseText(), childNode);
-        if (childNode->isAggregate())
-            findAllLegaleseTexts(static_cast<Aggregate *>(childNode));
-    }
-}
-
-/*!
-  \fn void QDocDatabase::findAllObsoleteThings(Aggregate *node)
-
-  Finds all nodes with status = Deprecated and sorts them into
-  maps. They can be C++ classes, QML types, or they can be
-  functions, enum types, typedefs, methods, etc.
- */
-
-/*!
-  \fn void QDocDatabase::findAllSince(Aggregate *node)
-
-  Finds all the nodes in \a node where a \e{since} command appeared
-  in the qdoc comment and sorts them into maps according to the kind
-  of node.
-
-  This function is used for generating the "New Classes... in x.y"
-  section on the \e{What's New in Qt x.y} page.
- */
-
 /*!
   Find the \a key in the map of new class maps, and return a
   reference to the value, which is a NodeMap. If \a key is not
@@ -862,7 +864,7 @@ void QDocDatabase::findAllLegaleseTexts(Aggregate *node)
  */
 const NodeMultiMap &QDocDatabase::getClassMap(const QString &key)
 {
-    processForest(&QDocDatabase::findAllSince);
+    processForest(Aggregate::FindSince);
     auto it = s_newClassMaps.constFind(key);
     return (it != s_newClassMaps.constEnd()) ? it.value() : emptyNodeMultiMap_;
 }
@@ -874,7 +876,7 @@ const NodeMultiMap &QDocDatabase::getClassMap(const QString &key)
  */
 const NodeMultiMap &QDocDatabase::getQmlTypeMap(const QString &key)
 {
-    processForest(&QDocDatabase::findAllSince);
+    processForest(Aggregate::FindSince);
     auto it = s_newQmlTypeMaps.constFind(key);
     return (it != s_newQmlTypeMaps.constEnd()) ? it.value() : emptyNodeMultiMap_;
 }
@@ -886,7 +888,7 @@ const NodeMultiMap &QDocDatabase::getQmlTypeMap(const QString &key)
  */
 const NodeMultiMap &QDocDatabase::getSinceMap(const QString &key)
 {
-    processForest(&QDocDatabase::findAllSince);
+    processForest(Aggregate::FindSince);
     auto it = s_newSinceMaps.constFind(key);
     return (it != s_newSinceMaps.constEnd()) ? it.value() : emptyNodeMultiMap_;
 }
@@ -931,11 +933,24 @@ void QDocDatabase::resolveStuff()
         QDocIndexFiles::destroyQDocIndexFiles();
 }
 
+/*!
+  Resolves the base classes of the classes in all the trees of
+  the forest.
+
+  The base classes are looked up once per path for the whole
+  forest. A tree is only resolved once, as the forest no longer
+  changes after the first call, which matters when generating
+  many modules with \c -single-exec.
+ */
 void QDocDatabase::resolveBaseClasses()
 {
+    QHash<QStringList, ClassNode *> lookups;
     Tree *t = m_forest.firstTree();
     while (t) {
-        t->resolveBaseClasses(t->root());
+        if (!m_baseClassesResolved.contains(t)) {
+            t->resolveBaseClasses(t->root(), &lookups);
+            m_baseClassesResolved.insert(t);
+        }
         t = m_forest.nextTree();
     }
 }
@@ -1171,6 +1186,11 @@ QStringList QDocDatabase::groupNamesForNode(Node *node)
 
 /*!
   Reads and parses the qdoc index files listed in \a indexFiles.
+
+  Trees stay in the forest until the database is destroyed. When
+  several projects are processed by one QDoc process, the index
+  files loaded for an earlier project are therefore not read again;
+  their trees are shared by the later projects instead.
  */
 void QDocDatabase::readIndexes(const QStringList &indexFiles)
 {
@@ -1180,7 +1200,7 @@ void QDocDatabase::readIndexes(const QStringList &indexFiles)
         if (!isLoaded(fn))
             filesToRead << file;
         else
-            qCCritical(lcQdoc) << "Index file" << file << "is already in memory.";
+            qCDebug(lcQdoc) << "Reusing the tree already loaded from index file" << file;
     }
     QDocIndexFiles::qdocIndexFiles()->readIndexes(filesToRead);
 }
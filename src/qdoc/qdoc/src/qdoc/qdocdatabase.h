@@ -11,7 +11,9 @@
 #include "tree.h"
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstring.h>
 
 QT_BEGIN_NAMESPACE
@@ -137,17 +139,15 @@ private:
         return nullptr;
     }
 
-    QmlTypeNode *lookupQmlType(const QString &name)
+    QmlTypeNode *lookupQmlType(const QString &name) { return lookupQmlType(QString(), name); }
+    QmlTypeNode *lookupQmlType(const QString &module, const QString &name);
+    void clearQmlTypeCache() { m_qmlTypeCache.clear(); }
+
+    void clearSearchOrder()
     {
-        for (const auto *tree : searchOrder()) {
-            QmlTypeNode *qcn = tree->lookupQmlType(name);
-            if (qcn)
-                return qcn;
-        }
-        return nullptr;
+        m_searchOrder.clear();
+        clearQmlTypeCache();
     }
-
-    void clearSearchOrder() { m_searchOrder.clear(); }
     void newPrimaryTree(const QString &module);
     void setPrimaryTree(const QString &t);
     NamespaceNode *newIndexTree(const QString &module);
@@ -160,6 +160,7 @@ private:
     QList<Tree *> m_searchOrder;
     QList<Tree *> m_indexSearchOrder;
     QList<QString> m_moduleNames;
+    QHash<std::pair<QString, QString>, QmlTypeNode *> m_qmlTypeCache;
 };
 
 class QDocDatabase
@@ -169,8 +170,6 @@ public:
     static void destroyQdocDB();
     ~QDocDatabase() = default;
 
-    using FindFunctionPtr = void (QDocDatabase::*)(Aggregate *);
-
     Tree *findTree(const QString &t) { return m_forest.findTree(t); }
 
     const CNMap &groups() { return primaryTree()->groups(); }
@@ -218,14 +217,6 @@ public:
     static NodeMultiMapMap &newEnumValueMaps() { return s_newEnumValueMaps; }
     static NodeMultiMapMap &newSinceMaps() { return s_newSinceMaps; }
 
-private:
-    void findAllClasses(Aggregate *node) { node->findAllClasses(); }
-    void findAllFunctions(Aggregate *node) { node->findAllFunctions(m_functionIndex); }
-    void findAllAttributions(Aggregate *node) { node->findAllAttributions(m_attributions); }
-    void findAllLegaleseTexts(Aggregate *node);
-    void findAllObsoleteThings(Aggregate *node) { node->findAllObsoleteThings(); }
-    void findAllSince(Aggregate *node) { node->findAllSince(); }
-
 public:
     /*******************************************************************
      special collection access functions
@@ -337,8 +328,16 @@ public:
     void setPrimaryTree(const QString &t) { m_forest.setPrimaryTree(t); }
     NamespaceNode *newIndexTree(const QString &module) { return m_forest.newIndexTree(module); }
     const QList<Tree *> &searchOrder() { return m_forest.searchOrder(); }
-    void setLocalSearch() { m_forest.m_searchOrder = QList<Tree *>(1, primaryTree()); }
-    void setSearchOrder(const QList<Tree *> &searchOrder) { m_forest.m_searchOrder = searchOrder; }
+    void setLocalSearch()
+    {
+        m_forest.m_searchOrder = QList<Tree *>(1, primaryTree());
+        m_forest.clearQmlTypeCache();
+    }
+    void setSearchOrder(const QList<Tree *> &searchOrder)
+    {
+        m_forest.m_searchOrder = searchOrder;
+        m_forest.clearQmlTypeCache();
+    }
     void setSearchOrder(QStringList &t) { m_forest.setSearchOrder(t); }
     void mergeCollections(Node::NodeType type, CNMap &cnm, const Node *relative);
     void mergeCollections(CollectionNode *c);
@@ -352,7 +351,7 @@ public:
 private:
     friend class Tree;
 
-    void processForest(FindFunctionPtr func);
+    void processForest(Aggregate::FindFlags flags);
     bool isLoaded(const QString &t) { return m_forest.isLoaded(t); }
     static void initializeDB();
 
@@ -384,10 +383,11 @@ private:
     QDocForest m_forest;
 
     NodeMultiMap m_namespaceIndex {};
+    QSet<const Tree *> m_baseClassesResolved {};
     NodeMultiMap m_attributions {};
     NodeMapMap m_functionIndex {};
     TextToNodeMap m_legaleseTexts {};
-    QMultiHash<Tree*, FindFunctionPtr> m_completedFindFunctions {};
+    QHash<Tree *, Aggregate::FindFlags> m_completedFinds {};
 };
 
 QT_END_NAMESPACE
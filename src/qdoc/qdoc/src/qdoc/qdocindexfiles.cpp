@@ -8,6 +8,7 @@
 #include "classnode.h"
 #include "collectionnode.h"
 #include "comparisoncategory.h"
+#include "compressedoutput.h"
 #include "config.h"
 #include "enumnode.h"
 #include "examplenode.h"
@@ -23,9 +24,14 @@
 #include "typedefnode.h"
 #include "variablenode.h"
 
+#include <QtCore/qsavefile.h>
 #include <QtCore/qxmlstream.h>
 
 #include <algorithm>
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -90,31 +96,163 @@ void QDocIndexFiles::destroyQDocIndexFiles()
     }
 }
 
+/*!
+  \internal
+  \class IndexReader
+
+  Holds the start and end elements of an index file. The file is
+  tokenized by the constructor, which does not access any qdoc state, so
+  that several index files can be tokenized concurrently while the nodes
+  are created from them in order. The functions that read the elements
+  behave like their QXmlStreamReader counterparts.
+ */
+class IndexReader
+{
+public:
+    explicit IndexReader(const QString &path);
+
+    [[nodiscard]] bool isOpen() const { return m_open; }
+    bool readNext();
+    bool readNextStartElement();
+    void skipCurrentElement();
+    [[nodiscard]] bool isEndElement() const { return current() && !current()->isStart; }
+    [[nodiscard]] QStringView name() const { return current() ? current()->name : QStringView(); }
+    [[nodiscard]] QXmlStreamAttributes attributes() const
+    {
+        return current() ? current()->attributes : QXmlStreamAttributes();
+    }
+
+private:
+    struct Element
+    {
+        QString name;
+        QXmlStreamAttributes attributes;
+        bool isStart;
+    };
+
+    [[nodiscard]] const Element *current() const
+    {
+        return m_current < m_elements.size() ? &m_elements[m_current] : nullptr;
+    }
+
+    std::vector<Element> m_elements;
+    size_t m_current { size_t(-1) };
+    bool m_open { false };
+};
+
+IndexReader::IndexReader(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
+        return;
+    m_open = true;
+
+    // Index files of large modules are tens of megabytes; map them into
+    // memory where possible so that the XML reader does not read them
+    // through QIODevice buffers. It still decodes the text into QStrings.
+    QByteArray contents;
+    const qint64 size = file.size();
+    if (uchar *data = size > 0 ? file.map(0, size) : nullptr)
+        contents = QByteArray::fromRawData(reinterpret_cast<const char *>(data), size);
+    else
+        contents = file.readAll();
+
+    QXmlStreamReader reader(contents);
+    reader.setNamespaceProcessing(false);
+
+    // Share the element names, as there are only a few distinct ones.
+    QSet<QString> names;
+    while (!reader.atEnd()) {
+        const QXmlStreamReader::TokenType token = reader.readNext();
+        if (token != QXmlStreamReader::StartElement && token != QXmlStreamReader::EndElement)
+            continue;
+        const QString name = *names.insert(reader.name().toString());
+        if (token == QXmlStreamReader::StartElement)
+            m_elements.push_back({ name, reader.attributes(), true });
+        else
+            m_elements.push_back({ name, {}, false });
+    }
+}
+
+/*!
+  Advances to the next element. Returns \c false if there are no more
+  elements.
+ */
+bool IndexReader::readNext()
+{
+    if (m_current + 1 >= m_elements.size()) {
+        m_current = m_elements.size();
+        return false;
+    }
+    ++m_current;
+    return true;
+}
+
+/*!
+  Advances to the next start element within the current element, and
+  returns \c true if one was found.
+ */
+bool IndexReader::readNextStartElement()
+{
+    return readNext() && !isEndElement();
+}
+
+/*!
+  Advances to the end element of the current element, skipping its
+  children.
+ */
+void IndexReader::skipCurrentElement()
+{
+    int depth = 1;
+    while (depth && readNext()) {
+        if (isEndElement())
+            --depth;
+        else
+            ++depth;
+    }
+}
+
 /*!
   Reads and parses the list of index files in \a indexFiles.
+
+  The files are tokenized on up to Config::jobs() worker threads; the
+  trees are created from them on the calling thread, in the order of
+  \a indexFiles.
  */
 void QDocIndexFiles::readIndexes(const QStringList &indexFiles)
 {
+    const size_t jobs = std::max(Config::instance().jobs(), 1);
+    std::deque<std::future<std::unique_ptr<IndexReader>>> pending;
+    qsizetype next = 0;
+    const auto fill = [&] {
+        while (pending.size() < jobs && next < indexFiles.size()) {
+            pending.push_back(std::async(
+                    jobs > 1 ? std::launch::async : std::launch::deferred,
+                    [](const QString &path) { return std::make_unique<IndexReader>(path); },
+                    indexFiles.at(next++)));
+        }
+    };
+
     for (const QString &file : indexFiles) {
+        fill();
+        std::unique_ptr<IndexReader> reader = pending.front().get();
+        pending.pop_front();
         qCDebug(lcQdoc) << "Loading index file: " << file;
-        readIndexFile(file);
+        readIndexFile(file, *reader);
     }
 }
 
 /*!
-  Reads and parses the index file at \a path.
+  Creates the tree for the index file at \a path from the elements
+  read by \a reader.
  */
-void QDocIndexFiles::readIndexFile(const QString &path)
+void QDocIndexFiles::readIndexFile(const QString &path, IndexReader &reader)
 {
-    QFile file(path);
-    if (!file.open(QFile::ReadOnly)) {
+    if (!reader.isOpen()) {
         qWarning() << "Could not read index file" << path;
         return;
     }
 
-    QXmlStreamReader reader(&file);
-    reader.setNamespaceProcessing(false);
-
     if (!reader.readNextStartElement())
         return;
 
@@ -164,7 +302,7 @@ void QDocIndexFiles::readIndexFile(const QString &path)
   Read a <section> element from the index file and create the
   appropriate node(s).
  */
-void QDocIndexFiles::readIndexSection(QXmlStreamReader &reader, Node *current,
+void QDocIndexFiles::readIndexSection(IndexReader &reader, Node *current,
                                       const QString &indexUrl)
 {
     QXmlStreamAttributes attributes = reader.attributes();
@@ -617,7 +755,7 @@ void QDocIndexFiles::readIndexSection(QXmlStreamReader &reader, Node *current,
 
 done:
     while (!reader.isEndElement()) {
-        if (reader.readNext() == QXmlStreamReader::Invalid) {
+        if (!reader.readNext()) {
             break;
         }
     }
@@ -1424,15 +1562,14 @@ void QDocIndexFiles::generateIndexSections(QXmlStreamWriter &writer, Node *node,
 void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
                                    const QString &title, Generator *g)
 {
-    QFile file(fileName);
-    if (!file.open(QFile::WriteOnly | QFile::Text))
-        return;
-
     qCDebug(lcQdoc) << "Writing index file:" << fileName;
 
+    // Write the index into memory, with few large writes to the file
+    // instead of one for each piece the XML writer outputs.
+    QByteArray contents;
     m_gen = g;
     m_relatedNodes.clear();
-    QXmlStreamWriter writer(&file);
+    QXmlStreamWriter writer(&contents);
     writer.setAutoFormatting(true);
     writer.writeStartDocument();
     writer.writeDTD("<!DOCTYPE QDOCINDEX>");
@@ -1452,7 +1589,29 @@ void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
     writer.writeEndElement(); // INDEX
     writer.writeEndElement(); // QDOCINDEX
     writer.writeEndDocument();
-    file.close();
+
+    // Keep an unchanged index file, and its time stamp, so that build
+    // systems do not consider the modules that depend on it outdated.
+    const bool compress = CompressedOutput::isEnabled();
+    if (QFile existing(fileName); existing.size() >= contents.size()
+        && existing.open(QFile::ReadOnly | QFile::Text) && existing.readAll() == contents) {
+        if (compress && !QFile::exists(fileName + QLatin1String(".gz")))
+            CompressedOutput::writeText(fileName, contents);
+        return;
+    }
+
+    // Replace the file atomically, as other QDoc processes may be
+    // reading the index of this module at the same time.
+    QSaveFile file(fileName);
+    if (file.open(QFile::WriteOnly | QFile::Text)) {
+        file.write(contents);
+        if (file.commit()) {
+            if (compress)
+                CompressedOutput::writeText(fileName, contents);
+            return;
+        }
+    }
+    qCWarning(lcQdoc) << "Cannot write index file" << fileName << ':' << file.errorString();
 }
 
 QT_END_NAMESPACE
@@ -12,9 +12,9 @@ QT_BEGIN_NAMESPACE
 class Atom;
 class FunctionNode;
 class Generator;
+class IndexReader;
 class QDocDatabase;
 class WebXMLGenerator;
-class QXmlStreamReader;
 class QXmlStreamWriter;
 class QXmlStreamAttributes;
 
@@ -39,8 +39,8 @@ private:
     ~QDocIndexFiles();
 
     void readIndexes(const QStringList &indexFiles);
-    void readIndexFile(const QString &path);
-    void readIndexSection(QXmlStreamReader &reader, Node *current, const QString &indexUrl);
+    void readIndexFile(const QString &path, IndexReader &reader);
+    void readIndexSection(IndexReader &reader, Node *current, const QString &indexUrl);
     void insertTarget(TargetRec::TargetType type, const QXmlStreamAttributes &attributes,
                       Node *node);
     void resolveIndex();
@@ -65,10 +65,21 @@ Atom::AtomType QmlCodeMarker::atomType() const
     return Atom::Qml;
 }
 
+/*!
+  Returns the marked up QML \a code. As for C++, the result is cached by
+  the code, unless the code could not be fully analyzed, so that every
+  location quoting it gets the warning.
+ */
 QString QmlCodeMarker::markedUpCode(const QString &code, const Node *relative,
                                     const Location &location)
 {
-    return addMarkUp(code, relative, location);
+    if (const QString *cached = m_markedUpCode.object(code))
+        return *cached;
+    bool complete = false;
+    QString result = addMarkUp(code, relative, location, &complete);
+    if (complete)
+        m_markedUpCode.insert(code, new QString(result), result.size());
+    return result;
 }
 
 /*!
@@ -85,8 +96,9 @@ QString QmlCodeMarker::markedUpName(const Node *node)
 }
 
 QString QmlCodeMarker::addMarkUp(const QString &code, const Node * /* relative */,
-                                 const Location &location)
+                                 const Location &location, bool *complete)
 {
+    *complete = false;
     QQmlJS::Engine engine;
     QQmlJS::Lexer lexer(&engine);
 
@@ -107,6 +119,8 @@ QString QmlCodeMarker::addMarkUp(const QString &code, const Node * /* relative *
             location.warning(
                     location.fileName()
                     + QStringLiteral("Unable to analyze QML snippet. The output is incomplete."));
+        } else {
+            *complete = true;
         }
         output = visitor.markedUpCode();
     } else {
@@ -29,7 +29,8 @@ public:
     QList<QQmlJS::SourceLocation> extractPragmas(QString &script);
 
 private:
-    QString addMarkUp(const QString &code, const Node *relative, const Location &location);
+    QString addMarkUp(const QString &code, const Node *relative, const Location &location,
+                      bool *complete);
 };
 
 QT_END_NAMESPACE
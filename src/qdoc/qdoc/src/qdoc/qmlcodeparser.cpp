@@ -9,10 +9,112 @@
 
 #include <private/qqmljsast_p.h>
 
+#include <QtCore/qelapsedtimer.h>
 #include <qdebug.h>
 
+#include <deque>
+#include <future>
+
 QT_BEGIN_NAMESPACE
 
+/*
+  The result of reading and parsing one QML file. The AST is
+  allocated by the engine, which must outlive any visitor of it.
+ */
+struct ParsedQmlFile
+{
+    bool opened { false };
+    bool parsed { false };
+    qint64 msecs { 0 };
+    QString code;
+    QQmlJS::Engine engine;
+    QQmlJS::Lexer lexer { &engine };
+    QQmlJS::Parser parser { &engine };
+};
+
+/*!
+  \internal
+
+  Reads the file at \a filePath, removes its pragmas, and parses it.
+  Only touches the returned object, so it can run on any thread.
+ */
+static std::unique_ptr<ParsedQmlFile> parseQmlFile(const QString &filePath)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    auto result = std::make_unique<ParsedQmlFile>();
+    QFile in(filePath);
+    if (!in.open(QIODevice::ReadOnly))
+        return result;
+
+    result->opened = true;
+    result->code = QString::fromUtf8(in.readAll());
+    in.close();
+
+    QmlCodeParser::extractPragmas(result->code);
+    result->lexer.setCode(result->code, 1);
+    result->parsed = result->parser.parse();
+    result->msecs = timer.elapsed();
+    return result;
+}
+
+/*
+  Reads and parses QML files ahead on worker threads, keeping at most
+  as many files in flight as there are jobs. The results are handed
+  out in the order of the file paths, so that the nodes they document
+  are created in the same order as when parsing serially.
+ */
+class QmlFilePrefetcher
+{
+public:
+    QmlFilePrefetcher(const std::vector<QString> &filePaths, int jobs)
+        : m_filePaths(filePaths), m_jobs(jobs)
+    {
+        fill();
+    }
+
+    ~QmlFilePrefetcher()
+    {
+        for (auto &pending : m_pending)
+            pending.second.wait();
+    }
+
+    /*
+      Returns the parsed file for \a filePath, or \c nullptr if the
+      file is not the next one in the prefetch order.
+     */
+    std::unique_ptr<ParsedQmlFile> take(const QString &filePath)
+    {
+        if (m_pending.empty() || m_pending.front().first != filePath)
+            return nullptr;
+
+        std::unique_ptr<ParsedQmlFile> result = m_pending.front().second.get();
+        m_pending.pop_front();
+        fill();
+        return result;
+    }
+
+private:
+    void fill()
+    {
+        while (m_pending.size() < static_cast<size_t>(m_jobs) && m_next < m_filePaths.size()) {
+            const QString &filePath = m_filePaths[m_next++];
+            m_pending.emplace_back(filePath,
+                                   std::async(std::launch::async, &parseQmlFile, filePath));
+        }
+    }
+
+    std::vector<QString> m_filePaths;
+    size_t m_next { 0 };
+    int m_jobs { 1 };
+    std::deque<std::pair<QString, std::future<std::unique_ptr<ParsedQmlFile>>>> m_pending;
+};
+
+QmlCodeParser::QmlCodeParser() = default;
+
+QmlCodeParser::~QmlCodeParser() = default;
+
 /*!
   Returns "QML".
  */
@@ -30,6 +132,26 @@ QStringList QmlCodeParser::sourceFileNameFilter()
     return QStringList() << "*.qml";
 }
 
+/*!
+  Lets worker threads read and parse the QML files in \a filePaths,
+  using up to \a jobs threads. The files must subsequently be passed
+  to parseSourceFile() in the same order; only visiting the parsed
+  files, which inserts their contents into the database, is done on
+  the calling thread.
+
+  Does nothing if \a jobs is less than two.
+ */
+void QmlCodeParser::prefetch(const std::vector<QString> &filePaths, int jobs)
+{
+    if (jobs < 2 || filePaths.empty()) {
+        m_prefetcher.reset();
+        return;
+    }
+
+    qCDebug(lcQdoc) << "Parsing" << filePaths.size() << "QML files using" << jobs << "threads";
+    m_prefetcher = std::make_unique<QmlFilePrefetcher>(filePaths, jobs);
+}
+
 /*!
   Parses the source file at \a filePath and inserts the contents
   into the database. The \a location is used for error reporting.
@@ -46,33 +168,27 @@ void QmlCodeParser::parseSourceFile(const Location &location, const QString &fil
         COMMAND_QMLVALUETYPE, COMMAND_QMLBASICTYPE,
     };
 
-    QFile in(filePath);
-    if (!in.open(QIODevice::ReadOnly)) {
+    std::unique_ptr<ParsedQmlFile> file;
+    if (m_prefetcher)
+        file = m_prefetcher->take(filePath);
+    if (!file)
+        file = parseQmlFile(filePath);
+
+    if (!file->opened) {
         location.error(QStringLiteral("Cannot open QML file '%1'").arg(filePath));
         return;
     }
+    qCDebug(lcQdoc, "Parsed %s in %lld ms", qUtf8Printable(filePath), file->msecs);
 
-    QString document = in.readAll();
-    in.close();
-
-    QString newCode = document;
-    extractPragmas(newCode);
-
-    QQmlJS::Engine engine{};
-    QQmlJS::Lexer lexer{&engine};
-    lexer.setCode(newCode, 1);
-
-    QQmlJS::Parser parser{&engine};
-
-    if (parser.parse()) {
-        QQmlJS::AST::UiProgram *ast = parser.ast();
-        QmlDocVisitor visitor(filePath, newCode, &engine, topic_commands + CodeParser::common_meta_commands,
-                              topic_commands);
+    if (file->parsed) {
+        QQmlJS::AST::UiProgram *ast = file->parser.ast();
+        QmlDocVisitor visitor(filePath, file->code, &file->engine,
+                              topic_commands + CodeParser::common_meta_commands, topic_commands);
         QQmlJS::AST::Node::accept(ast, &visitor);
         if (visitor.hasError())
             Location(filePath).warning("Could not analyze QML file, output is incomplete.");
     }
-    const auto &messages = parser.diagnosticMessages();
+    const auto &messages = file->parser.diagnosticMessages();
     for (const auto &msg : messages) {
         qCDebug(lcQdoc, "%s: %d: %d: QML syntax error: %s", qUtf8Printable(filePath),
                 msg.loc.startLine, msg.loc.startColumn, qUtf8Printable(msg.message));
@@ -8,6 +8,9 @@
 
 #include <QtCore/qset.h>
 
+#include <memory>
+#include <vector>
+
 #include <private/qqmljsengine_p.h>
 #include <private/qqmljslexer_p.h>
 #include <private/qqmljsparser_p.h>
@@ -16,21 +19,26 @@ QT_BEGIN_NAMESPACE
 
 class Node;
 class QString;
+class QmlFilePrefetcher;
 
 class QmlCodeParser : public CodeParser
 {
 public:
-    QmlCodeParser() = default;
-    ~QmlCodeParser() override = default;
+    QmlCodeParser();
+    ~QmlCodeParser() override;
 
     void initializeParser() override {}
     void terminateParser() override {}
     QString language() override;
     QStringList sourceFileNameFilter() override;
     void parseSourceFile(const Location &location, const QString &filePath, CppCodeParser&) override;
+    void prefetch(const std::vector<QString> &filePaths, int jobs);
 
     /* Copied from src/declarative/qml/qdeclarativescriptparser.cpp */
-    void extractPragmas(QString &script);
+    static void extractPragmas(QString &script);
+
+private:
+    std::unique_ptr<QmlFilePrefetcher> m_prefetcher;
 };
 
 QT_END_NAMESPACE
@@ -3,6 +3,8 @@
 
 #include "qmlmarkupvisitor.h"
 
+#include "utilities.h"
+
 #include <QtCore/qglobal.h>
 #include <QtCore/qstringlist.h>
 
@@ -50,38 +52,9 @@ QmlMarkupVisitor::QmlMarkupVisitor(const QString &source,
     }
 }
 
-// The protect() function is a copy of the one from CppCodeMarker.
-
-static const QString samp = QLatin1String("&amp;");
-static const QString slt = QLatin1String("&lt;");
-static const QString sgt = QLatin1String("&gt;");
-static const QString squot = QLatin1String("&quot;");
-
 QString QmlMarkupVisitor::protect(const QString &str)
 {
-    qsizetype n = str.size();
-    QString marked;
-    marked.reserve(n * 2 + 30);
-    const QChar *data = str.constData();
-    for (int i = 0; i != n; ++i) {
-        switch (data[i].unicode()) {
-        case '&':
-            marked += samp;
-            break;
-        case '<':
-            marked += slt;
-            break;
-        case '>':
-            marked += sgt;
-            break;
-        case '"':
-            marked += squot;
-            break;
-        default:
-            marked += data[i];
-        }
-    }
-    return marked;
+    return Utilities::protect(str);
 }
 
 QString QmlMarkupVisitor::markedUpCode()
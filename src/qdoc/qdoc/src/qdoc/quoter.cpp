@@ -155,6 +155,19 @@ void Quoter::quoteFromFile(const QString &userFriendlyFilePath, const QString &p
     m_codeLocation.start();
 }
 
+/*!
+  Starts quoting from \a userFriendlyFilePath, reusing the \a lines
+  returned by lines() after an earlier quoteFromFile() of the file.
+ */
+void Quoter::quoteFromLines(const QString &userFriendlyFilePath, const Lines &lines)
+{
+    m_silent = false;
+    m_codeLocation = Location(userFriendlyFilePath);
+    m_plainLines = lines.plain;
+    m_markedLines = lines.marked;
+    m_codeLocation.start();
+}
+
 QString Quoter::quoteLine(const Location &docLocation, const QString &command,
                           const QString &pattern)
 {
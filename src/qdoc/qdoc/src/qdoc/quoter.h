@@ -14,11 +14,20 @@ QT_BEGIN_NAMESPACE
 class Quoter
 {
 public:
+    // The logical lines of a quoted file, as split by quoteFromFile()
+    struct Lines
+    {
+        QStringList plain;
+        QStringList marked;
+    };
+
     Quoter();
 
     void reset();
     void quoteFromFile(const QString &userFriendlyFileName, const QString &plainCode,
                        const QString &markedCode);
+    void quoteFromLines(const QString &userFriendlyFileName, const Lines &lines);
+    [[nodiscard]] Lines lines() const { return { m_plainLines, m_markedLines }; }
     QString quoteLine(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteTo(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteUntil(const Location &docLocation, const QString &command, const QString &pattern);
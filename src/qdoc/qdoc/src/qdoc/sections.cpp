@@ -17,6 +17,7 @@
 #include "typedefnode.h"
 #include "variablenode.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qobjectdefs.h>
 
 QT_BEGIN_NAMESPACE
@@ -198,6 +199,30 @@ QString sortName(const Node *node)
     return QLatin1Char('B') + nodeName;
 }
 
+static QHash<const Node *, QString> s_sortNames;
+
+/*!
+  Returns the sortName() of \a node, computing it only the first time
+  it is requested for \a node. The names are kept until
+  Sections::clearCaches() is called.
+ */
+static const QString &cachedSortName(const Node *node)
+{
+    auto it = s_sortNames.find(node);
+    if (it == s_sortNames.end())
+        it = s_sortNames.insert(node, sortName(node));
+    return *it;
+}
+
+/*!
+  Clears the data cached for the nodes of the documentation trees;
+  this must be done before the nodes are deleted.
+ */
+void Sections::clearCaches()
+{
+    s_sortNames.clear();
+}
+
 /*!
   Inserts the \a node into this section if it is appropriate
   for this section.
@@ -230,7 +255,6 @@ void Section::insert(Node *node)
     }
 
     if (!irrelevant) {
-        QString key = sortName(node);
         if (node->isDeprecated()) {
             m_obsoleteMembers.push_back(node);
         } else {
@@ -263,7 +287,7 @@ bool Section::insertReimplementedMember(Node *node)
         const auto *fn = static_cast<const FunctionNode *>(node);
         if (!fn->overridesThis().isEmpty()) {
             if (fn->parent() == m_aggregate) {
-                QString key = sortName(fn);
+                const QString &key = cachedSortName(fn);
                 if (!m_reimplementedMemberMap.contains(key)) {
                     m_reimplementedMemberMap.insert(key, node);
                     return true;
@@ -305,9 +329,9 @@ void Section::reduce()
     // used as a comparator, can be called multiple times for each
     // Node, while before it would have been called almost-once.
     //
-    // Instead of fixing this issue, by for example caching the
-    // sortName of each Node instance, we temporarily keep the
-    // pessimization while the various maps are removed.
+    // To offset this, the sortName of each Node is cached, see
+    // cachedSortName(), which also shares the keys between the
+    // generators of all output formats.
     //
     // When all the maps are removed, we can remove `sortName`, which
     // produces strings to use as key requiring a few allocations and
@@ -315,7 +339,7 @@ void Section::reduce()
     // should be more lightweight and more than offset the
     // multiple-calls.
     static auto node_less_than = [](const Node* left, const Node* right) {
-      return sortName(left) < sortName(right);
+      return cachedSortName(left) < cachedSortName(right);
     };
 
     std::stable_sort(m_members.begin(), m_members.end(), node_less_than);
@@ -150,6 +150,8 @@ public:
 
     bool hasObsoleteMembers(SectionPtrVector *summary_spv, SectionPtrVector *details_spv) const;
 
+    static void clearCaches();
+
     static Section &allMembersSection() { return s_allMembers[0]; }
     SectionVector &sinceSections() { return s_sinceSections; }
     SectionVector &stdSummarySections() { return s_stdSummarySections; }
@@ -0,0 +1,262 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "timingreport.h"
+
+#include "utilities.h"
+
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qsavefile.h>
+
+#include <algorithm>
+
+#if defined(Q_OS_WIN)
+#    include <QtCore/qt_windows.h>
+#    include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#    include <sys/resource.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+  \class TimingReport
+  \internal
+
+  Collects the wall and CPU time spent in each phase of a QDoc run,
+  the peak memory use at the end of each phase, the time spent on each
+  source file, and the size of each generated page. The report is
+  written as JSON to the file passed with \c{-timing-report}.
+
+  Phases can be nested; a phase includes the time of the phases it
+  contains.
+ */
+
+namespace {
+
+struct PhaseRecord
+{
+    QString qdocconf;
+    QString pass;
+    QString name;
+    int depth;
+    double wallMSecs;
+    double cpuMSecs;
+    qint64 peakRssKiB;
+};
+
+struct FileRecord
+{
+    QString qdocconf;
+    QString filePath;
+    double value;
+};
+
+struct Report
+{
+    bool enabled { false };
+    QString qdocconf;
+    QString pass;
+    int depth { 0 };
+    QList<PhaseRecord> phases;
+    QList<FileRecord> sourceFiles;
+    QList<FileRecord> pages;
+};
+
+} // namespace
+
+static constexpr qsizetype hotSpotCount = 20;
+
+static Report &report()
+{
+    static Report r;
+    return r;
+}
+
+static qint64 processCpuTimeMSecs()
+{
+#if defined(Q_OS_WIN)
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0;
+    const auto toMSecs = [](const FILETIME &time) {
+        return ((qint64(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10000;
+    };
+    return toMSecs(kernel) + toMSecs(user);
+#elif defined(Q_OS_UNIX)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return (qint64(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000
+            + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+#else
+    return 0;
+#endif
+}
+
+static qint64 peakRssKiB()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return qint64(counters.PeakWorkingSetSize) / 1024;
+#elif defined(Q_OS_UNIX)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#    if defined(Q_OS_DARWIN)
+    return qint64(usage.ru_maxrss) / 1024;
+#    else
+    return qint64(usage.ru_maxrss);
+#    endif
+#else
+    return 0;
+#endif
+}
+
+/*!
+  Starts the phase \a name, if the report is enabled.
+ */
+TimingReport::Phase::Phase(const QString &name)
+    : m_span(name)
+{
+    Report &r = report();
+    if (!r.enabled)
+        return;
+
+    // Reserve the entry so that phases are listed in the order they start
+    m_index = r.phases.size();
+    r.phases.append({ r.qdocconf, r.pass, name, r.depth++, 0, 0, 0 });
+    m_cpuMSecs = processCpuTimeMSecs();
+    m_timer.start();
+}
+
+TimingReport::Phase::~Phase()
+{
+    if (m_index < 0)
+        return;
+
+    Report &r = report();
+    PhaseRecord &record = r.phases[m_index];
+    record.wallMSecs = m_timer.nsecsElapsed() / 1e6;
+    record.cpuMSecs = double(processCpuTimeMSecs() - m_cpuMSecs);
+    record.peakRssKiB = peakRssKiB();
+    --r.depth;
+}
+
+TimingReport::SourceFile::SourceFile(const QString &filePath)
+    : m_span("process source file"_L1, filePath)
+{
+    if (!report().enabled)
+        return;
+
+    m_filePath = filePath;
+    m_timer.start();
+}
+
+TimingReport::SourceFile::~SourceFile()
+{
+    if (!m_timer.isValid())
+        return;
+
+    Report &r = report();
+    r.sourceFiles.append({ r.qdocconf, m_filePath, m_timer.nsecsElapsed() / 1e6 });
+}
+
+void TimingReport::setEnabled(bool enabled)
+{
+    report().enabled = enabled;
+}
+
+bool TimingReport::isEnabled()
+{
+    return report().enabled;
+}
+
+/*!
+  Sets the qdocconf file and the pass, \c prepare or \c generate, that
+  the following phases are recorded for.
+ */
+void TimingReport::setContext(const QString &qdocconf, const QString &pass)
+{
+    Report &r = report();
+    r.qdocconf = qdocconf;
+    r.pass = pass;
+}
+
+/*!
+  Records that the page \a filePath of \a size bytes was generated.
+ */
+void TimingReport::addPage(const QString &filePath, qint64 size)
+{
+    Report &r = report();
+    if (r.enabled)
+        r.pages.append({ r.qdocconf, filePath, double(size) });
+}
+
+// Returns the hotSpotCount records of \a records with the highest values
+static QJsonArray hotSpots(QList<FileRecord> records, const QString &valueName)
+{
+    const qsizetype count = std::min(records.size(), hotSpotCount);
+    std::partial_sort(records.begin(), records.begin() + count, records.end(),
+                      [](const FileRecord &a, const FileRecord &b) { return a.value > b.value; });
+
+    QJsonArray array;
+    for (qsizetype i = 0; i < count; ++i) {
+        array.append(QJsonObject{ { "qdocconf"_L1, records[i].qdocconf },
+                                  { "file"_L1, records[i].filePath },
+                                  { valueName, records[i].value } });
+    }
+    return array;
+}
+
+/*!
+  Writes the report to \a fileName. Does nothing if the report is
+  not enabled.
+ */
+void TimingReport::write(const QString &fileName)
+{
+    const Report &r = report();
+    if (!r.enabled)
+        return;
+
+    QJsonArray phases;
+    for (const PhaseRecord &phase : r.phases) {
+        phases.append(QJsonObject{ { "qdocconf"_L1, phase.qdocconf },
+                                   { "pass"_L1, phase.pass },
+                                   { "phase"_L1, phase.name },
+                                   { "depth"_L1, phase.depth },
+                                   { "wallMs"_L1, phase.wallMSecs },
+                                   { "cpuMs"_L1, phase.cpuMSecs },
+                                   { "peakRssKiB"_L1, phase.peakRssKiB } });
+    }
+
+    double pageBytes = 0;
+    for (const FileRecord &page : r.pages)
+        pageBytes += page.value;
+
+    const QJsonObject root{
+        { "phases"_L1, phases },
+        { "sourceFileCount"_L1, qint64(r.sourceFiles.size()) },
+        { "slowestSourceFiles"_L1, hotSpots(r.sourceFiles, "wallMs"_L1) },
+        { "pageCount"_L1, qint64(r.pages.size()) },
+        { "pageBytes"_L1, pageBytes },
+        { "largestPages"_L1, hotSpots(r.pages, "bytes"_L1) },
+    };
+
+    QSaveFile file(fileName);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson());
+        if (file.commit())
+            return;
+    }
+    qCWarning(lcQdoc) << "Cannot write timing report" << fileName << ':' << file.errorString();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,57 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef TIMINGREPORT_H
+#define TIMINGREPORT_H
+
+#include <chrometrace_p.h>
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class TimingReport
+{
+public:
+    // Records the time and memory spent from construction to destruction,
+    // and a span when tracing
+    class Phase
+    {
+    public:
+        explicit Phase(const QString &name);
+        ~Phase();
+        Q_DISABLE_COPY_MOVE(Phase)
+
+    private:
+        QElapsedTimer m_timer;
+        qint64 m_cpuMSecs { 0 };
+        qsizetype m_index { -1 };
+        ChromeTrace::Span m_span;
+    };
+
+    // Records the time spent processing one source file, and a span when
+    // tracing
+    class SourceFile
+    {
+    public:
+        explicit SourceFile(const QString &filePath);
+        ~SourceFile();
+        Q_DISABLE_COPY_MOVE(SourceFile)
+
+    private:
+        QString m_filePath;
+        QElapsedTimer m_timer;
+        ChromeTrace::Span m_span;
+    };
+
+    static void setEnabled(bool enabled);
+    [[nodiscard]] static bool isEnabled();
+    static void setContext(const QString &qdocconf, const QString &pass);
+    static void addPage(const QString &filePath, qint64 size);
+    static void write(const QString &fileName);
+};
+
+QT_END_NAMESPACE
+
+#endif // TIMINGREPORT_H
@@ -116,10 +116,20 @@ static void insertKwordIntoHash(const char *s, int number)
     kwordHashTable[k] = number;
 }
 
+/*!
+  Constructs a tokenizer for the contents of the file \a in, which must
+  outlive the tokenizer, as the contents are mapped into memory from it
+  where possible. Only the comments and lexemes that are requested are
+  decoded.
+ */
 Tokenizer::Tokenizer(const Location &loc, QFile &in)
 {
     init();
-    m_in = in.readAll();
+    const qint64 size = in.size();
+    if (uchar *data = size > 0 ? in.map(0, size) : nullptr)
+        m_in = QByteArray::fromRawData(reinterpret_cast<const char *>(data), size);
+    else
+        m_in = in.readAll();
     m_pos = 0;
     start(loc);
 }
@@ -111,7 +111,7 @@ private:
     */
     enum { yyLexBufSize = 1048576 };
 
-    int getch() { return m_pos == m_in.size() ? EOF : m_in[m_pos++]; }
+    int getch() { return m_pos == m_in.size() ? EOF : m_in.at(m_pos++); }
 
     inline int getChar()
     {
@@ -181,9 +181,13 @@ void Tree::addPropertyFunction(PropertyNode *property, const QString &funcName,
   at \a n. It also calls itself recursively for each C++ class
   node or namespace node it encounters.
 
+  If \a lookups is not \c nullptr, the base classes found in the
+  forest are taken from and added to it, so that base classes
+  shared by many classes are only searched for once.
+
   This function does not resolve QML inheritance.
  */
-void Tree::resolveBaseClasses(Aggregate *n)
+void Tree::resolveBaseClasses(Aggregate *n, QHash<QStringList, ClassNode *> *lookups)
 {
     for (auto it = n->constBegin(); it != n->constEnd(); ++it) {
         if ((*it)->isClassNode()) {
@@ -191,7 +195,15 @@ void Tree::resolveBaseClasses(Aggregate *n)
             QList<RelatedClass> &bases = cn->baseClasses();
             for (auto &base : bases) {
                 if (base.m_node == nullptr) {
-                    Node *n = m_qdb->findClassNode(base.m_path);
+                    Node *n = nullptr;
+                    if (lookups) {
+                        auto lookup = lookups->constFind(base.m_path);
+                        if (lookup == lookups->cend())
+                            lookup = lookups->insert(base.m_path, m_qdb->findClassNode(base.m_path));
+                        n = lookup.value();
+                    } else {
+                        n = m_qdb->findClassNode(base.m_path);
+                    }
                     /*
                       If the node for the base class was not found,
                       the reason might be that the subclass is in a
@@ -216,9 +228,9 @@ void Tree::resolveBaseClasses(Aggregate *n)
                     }
                 }
             }
-            resolveBaseClasses(cn);
+            resolveBaseClasses(cn, lookups);
         } else if ((*it)->isNamespace()) {
-            resolveBaseClasses(static_cast<NamespaceNode *>(*it));
+            resolveBaseClasses(static_cast<NamespaceNode *>(*it), lookups);
         }
     }
 }
@@ -734,23 +746,21 @@ const Node *Tree::findEnumNode(const Node *node, const Node *aggregate, const QS
  */
 QString Tree::getRef(const QString &target, const Node *node) const
 {
-    auto it = m_nodesByTargetTitle.constFind(target);
-    if (it != m_nodesByTargetTitle.constEnd()) {
-        do {
-            if (it.value()->m_node == node)
-                return it.value()->m_ref;
-            ++it;
-        } while (it != m_nodesByTargetTitle.constEnd() && it.key() == target);
-    }
-    QString key = Utilities::asAsciiPrintable(target);
-    it = m_nodesByTargetRef.constFind(key);
-    if (it != m_nodesByTargetRef.constEnd()) {
-        do {
+    // Returns the ref of the first target inserted for node; the
+    // values of a key are iterated most recently inserted first.
+    auto findRef = [node](const TargetMap &tgtMap, const QString &key) -> const TargetRec * {
+        const TargetRec *found = nullptr;
+        for (auto [it, end] = tgtMap.equal_range(key); it != end; ++it) {
             if (it.value()->m_node == node)
-                return it.value()->m_ref;
-            ++it;
-        } while (it != m_nodesByTargetRef.constEnd() && it.key() == key);
-    }
+                found = it.value();
+        }
+        return found;
+    };
+
+    if (const TargetRec *found = findRef(m_nodesByTargetTitle, target))
+        return found->m_ref;
+    if (const TargetRec *found = findRef(m_nodesByTargetRef, Utilities::asAsciiPrintable(target)))
+        return found->m_ref;
     return QString();
 }
 
@@ -930,7 +940,8 @@ const TargetRec *Tree::findUnambiguousTarget(const QString &target, Node::Genus
         while (it != end) {
             TargetRec *candidate = it.value();
             if ((genus == Node::DontCare) || (genus & candidate->genus())) {
-                if (!best || (candidate->m_priority < best->m_priority))
+                // Of equal priorities, the first one inserted wins
+                if (!best || (candidate->m_priority <= best->m_priority))
                     best = candidate;
             }
             ++it;
@@ -950,35 +961,26 @@ const TargetRec *Tree::findUnambiguousTarget(const QString &target, Node::Genus
  */
 const PageNode *Tree::findPageNodeByTitle(const QString &title) const
 {
-    PageNodeMultiMap::const_iterator it;
-    if (title.contains(QChar(' ')))
-        it = m_pageNodesByTitle.constFind(Utilities::asAsciiPrintable(title));
-    else
-        it = m_pageNodesByTitle.constFind(title);
-    if (it != m_pageNodesByTitle.constEnd()) {
-        /*
-          Reporting all these duplicate section titles is probably
-          overkill. We should report the duplicate file and let
-          that suffice.
-        */
-        PageNodeMultiMap::const_iterator j = it;
-        ++j;
-        if (j != m_pageNodesByTitle.constEnd() && j.key() == it.key()) {
-            while (j != m_pageNodesByTitle.constEnd()) {
-                if (j.key() == it.key() && j.value()->url().isEmpty()) {
-                    break; // Just report one duplicate for now.
-                }
-                ++j;
-            }
-            if (j != m_pageNodesByTitle.cend()) {
-                it.value()->location().warning("This page title exists in more than one file: "
-                                               + title);
-                j.value()->location().warning("[It also exists here]");
-            }
-        }
-        return it.value();
+    const QString key = title.contains(QChar(' ')) ? Utilities::asAsciiPrintable(title) : title;
+    // The values of a key are iterated most recently inserted first;
+    // return the first one inserted.
+    PageNode *first = nullptr;
+    PageNode *duplicate = nullptr;
+    for (auto [it, end] = m_pageNodesByTitle.equal_range(key); it != end; ++it) {
+        if (first && first->url().isEmpty())
+            duplicate = first;
+        first = it.value();
     }
-    return nullptr;
+    /*
+      Reporting all these duplicate section titles is probably
+      overkill. We should report the duplicate file and let
+      that suffice.
+    */
+    if (duplicate) {
+        first->location().warning("This page title exists in more than one file: " + title);
+        duplicate->location().warning("[It also exists here]");
+    }
+    return first;
 }
 
 /*!
@@ -1211,12 +1213,15 @@ CollectionNode *Tree::addToQmlModule(const QString &name, Node *node)
 
 /*!
   If the QML type map does not contain \a key, insert node
-  \a n with the specified \a key.
+  \a n with the specified \a key, and drop the QML types the
+  forest has looked up so far.
  */
 void Tree::insertQmlType(const QString &key, QmlTypeNode *n)
 {
-    if (!m_qmlTypeMap.contains(key))
+    if (!m_qmlTypeMap.contains(key)) {
         m_qmlTypeMap.insert(key, n);
+        m_qdb->m_forest.clearQmlTypeCache();
+    }
 }
 
 /*!
@@ -11,6 +11,7 @@
 #include "proxynode.h"
 #include "qmltypenode.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qstack.h>
 
 #include <utility>
@@ -47,8 +48,10 @@ public:
     int m_priority {};
 };
 
-typedef QMultiMap<QString, TargetRec *> TargetMap;
-typedef QMultiMap<QString, PageNode *> PageNodeMultiMap;
+// Hashed, as every link resolution looks up targets and titles in each
+// tree. Values with equal keys are iterated most recently inserted first.
+typedef QMultiHash<QString, TargetRec *> TargetMap;
+typedef QMultiHash<QString, PageNode *> PageNodeMultiMap;
 typedef QMap<QString, QmlTypeNode *> QmlTypeMap;
 typedef QMultiMap<QString, const ExampleNode *> ExampleNodeMap;
 
@@ -114,7 +117,7 @@ private: // The rest of the class is private.
 
     void addPropertyFunction(PropertyNode *property, const QString &funcName,
                              PropertyNode::FunctionRole funcRole);
-    void resolveBaseClasses(Aggregate *n);
+    void resolveBaseClasses(Aggregate *n, QHash<QStringList, ClassNode *> *lookups = nullptr);
     void resolvePropertyOverriddenFromPtrs(Aggregate *n);
     void resolveProperties();
     void resolveCppToQmlLinks();
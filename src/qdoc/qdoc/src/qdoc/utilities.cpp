@@ -6,6 +6,8 @@
 #include "location.h"
 #include "utilities.h"
 
+#include <array>
+
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcQdoc, "qt.qdoc")
@@ -151,6 +153,92 @@ QString asAsciiPrintable(const QString &str)
     return result;
 }
 
+// Returns the entity for c, or a null string if c needs no escaping.
+static QLatin1StringView entityFor(char16_t c, bool encodeDashes)
+{
+    switch (c) {
+    case u'&':
+        return QLatin1StringView("&amp;");
+    case u'<':
+        return QLatin1StringView("&lt;");
+    case u'>':
+        return QLatin1StringView("&gt;");
+    case u'"':
+        return QLatin1StringView("&quot;");
+    case u'\u2013':
+        return encodeDashes ? QLatin1StringView("&ndash;") : QLatin1StringView();
+    case u'\u2014':
+        return encodeDashes ? QLatin1StringView("&mdash;") : QLatin1StringView();
+    default:
+        return QLatin1StringView();
+    }
+}
+
+// Appends string to output, escaping it from index from on. Runs of
+// characters that need no escaping are appended in one go.
+static void appendProtectedFrom(QString *output, QStringView string, qsizetype from,
+                                bool encodeDashes)
+{
+    const QChar *data = string.constData();
+    const qsizetype n = string.size();
+    qsizetype runStart = 0;
+    for (qsizetype i = from; i < n; ++i) {
+        const char16_t c = data[i].unicode();
+        // Most characters are above '>' and below the dashes
+        if (c > u'>' && c < u'\u2013')
+            continue;
+        const QLatin1StringView entity = entityFor(c, encodeDashes);
+        if (entity.isNull())
+            continue;
+        output->append(string.sliced(runStart, i - runStart));
+        output->append(entity);
+        runStart = i + 1;
+    }
+    output->append(string.sliced(runStart));
+}
+
+static qsizetype indexOfFirstToProtect(QStringView string, bool encodeDashes)
+{
+    const QChar *data = string.constData();
+    const qsizetype n = string.size();
+    for (qsizetype i = 0; i < n; ++i) {
+        const char16_t c = data[i].unicode();
+        if ((c <= u'>' || c >= u'\u2013') && !entityFor(c, encodeDashes).isNull())
+            return i;
+    }
+    return -1;
+}
+
+/*!
+    \internal
+    Returns \a string with the characters \c{&}, \c{<}, \c{>} and \c{"}
+    replaced by their HTML and XML entities. If \a encodeDashes is
+    \c true, en and em dashes are replaced by \c{&ndash;} and \c{&mdash;}.
+
+    As most text has nothing to escape, \a string is returned without
+    a copy in that case.
+*/
+QString protect(const QString &string, bool encodeDashes)
+{
+    const qsizetype first = indexOfFirstToProtect(string, encodeDashes);
+    if (first < 0)
+        return string;
+
+    QString result;
+    result.reserve(string.size() + string.size() / 8 + 16);
+    appendProtectedFrom(&result, string, first, encodeDashes);
+    return result;
+}
+
+/*!
+    \internal
+    Appends \a string to \a output, escaped like protect() does.
+*/
+void appendProtected(QString *output, QStringView string, bool encodeDashes)
+{
+    appendProtectedFrom(output, string, 0, encodeDashes);
+}
+
 /*!
     \internal
 */
@@ -249,6 +337,58 @@ QStringList getInternalIncludePaths(const QString &compiler)
     return result;
 }
 
+static quint32 crc32(const QByteArray &data)
+{
+    static const std::array<quint32, 256> table = [] {
+        std::array<quint32, 256> t {};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    quint32 crc = 0xffffffffu;
+    for (char ch : data)
+        crc = table[(crc ^ uchar(ch)) & 0xff] ^ (crc >> 8);
+    return crc ^ 0xffffffffu;
+}
+
+static void appendLittleEndian(QByteArray &out, quint32 value)
+{
+    for (int i = 0; i < 4; ++i)
+        out += char((value >> (8 * i)) & 0xff);
+}
+
+/*!
+  Returns \a data compressed in the gzip format.
+
+  The deflate stream comes from qCompress(), which wraps it with its own
+  length prefix and the zlib header and checksum; those are replaced by
+  the gzip header and trailer. The header carries no file name and no
+  modification time, so that the output is reproducible.
+ */
+QByteArray gzip(const QByteArray &data)
+{
+    // ID1, ID2, CM (deflate), FLG, MTIME (4), XFL (maximum compression), OS (unknown)
+    static const char header[] = { '\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00',
+                                   '\x00', '\x00', '\x02', '\xff' };
+    const QByteArray compressed = qCompress(data, 9);
+    // Skip the length prefix and the zlib header, and drop the Adler-32 checksum
+    constexpr qsizetype prefixSize = 4 + 2;
+    constexpr qsizetype suffixSize = 4;
+
+    QByteArray out(header, sizeof(header));
+    if (compressed.size() > prefixSize + suffixSize)
+        out += QByteArrayView(compressed).sliced(prefixSize, compressed.size() - prefixSize - suffixSize);
+    else
+        out += QByteArrayView("\x03\x00", 2); // an empty final block
+    appendLittleEndian(out, crc32(data));
+    appendLittleEndian(out, quint32(data.size()));
+    return out;
+}
+
 } // namespace Utilities
 
 QT_END_NAMESPACE
@@ -4,6 +4,7 @@
 #ifndef UTILITIES_H
 #define UTILITIES_H
 
+#include <QtCore/qbytearray.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qloggingcategory.h>
 
@@ -20,7 +21,10 @@ bool debugging();
 QString separator(qsizetype wordPosition, qsizetype numberOfWords);
 QString comma(qsizetype wordPosition, qsizetype numberOfWords);
 QString asAsciiPrintable(const QString &name);
+QString protect(const QString &string, bool encodeDashes = false);
+void appendProtected(QString *output, QStringView string, bool encodeDashes = false);
 QStringList getInternalIncludePaths(const QString &compiler);
+QByteArray gzip(const QByteArray &data);
 }
 
 QT_END_NAMESPACE
@@ -61,10 +61,9 @@ qsizetype WebXMLGenerator::generateAtom(const Atom *atom, const Node *relative,
 
 void WebXMLGenerator::generateCppReferencePage(Aggregate *aggregate, CodeMarker * /* marker */)
 {
-    QByteArray data;
-    QXmlStreamWriter writer(&data);
-    writer.setAutoFormatting(true);
     beginSubPage(aggregate, Generator::fileName(aggregate, "webxml"));
+    QXmlStreamWriter writer(subPageDevice());
+    writer.setAutoFormatting(true);
     writer.writeStartDocument();
     writer.writeStartElement("WebXML");
     writer.writeStartElement("document");
@@ -75,16 +74,14 @@ void WebXMLGenerator::generateCppReferencePage(Aggregate *aggregate, CodeMarker
     writer.writeEndElement(); // WebXML
     writer.writeEndDocument();
 
-    out() << data;
     endSubPage();
 }
 
 void WebXMLGenerator::generatePageNode(PageNode *pn, CodeMarker * /* marker */)
 {
-    QByteArray data;
-    currentWriter.reset(new QXmlStreamWriter(&data));
-    currentWriter->setAutoFormatting(true);
     beginSubPage(pn, Generator::fileName(pn, "webxml"));
+    currentWriter.reset(new QXmlStreamWriter(subPageDevice()));
+    currentWriter->setAutoFormatting(true);
     currentWriter->writeStartDocument();
     currentWriter->writeStartElement("WebXML");
     currentWriter->writeStartElement("document");
@@ -94,8 +91,8 @@ void WebXMLGenerator::generatePageNode(PageNode *pn, CodeMarker * /* marker */)
     currentWriter->writeEndElement(); // document
     currentWriter->writeEndElement(); // WebXML
     currentWriter->writeEndDocument();
+    currentWriter.reset();
 
-    out() << data;
     endSubPage();
 }
 
@@ -103,10 +100,9 @@ void WebXMLGenerator::generateExampleFilePage(const Node *en, ResolvedFile resol
 {
     // TODO: [generator-insufficient-structural-abstraction]
 
-    QByteArray data;
-    QXmlStreamWriter writer(&data);
-    writer.setAutoFormatting(true);
     beginSubPage(en, linkForExampleFile(resolved_file.get_query(), "webxml"));
+    QXmlStreamWriter writer(subPageDevice());
+    writer.setAutoFormatting(true);
     writer.writeStartDocument();
     writer.writeStartElement("WebXML");
     writer.writeStartElement("document");
@@ -136,7 +132,6 @@ void WebXMLGenerator::generateExampleFilePage(const Node *en, ResolvedFile resol
     writer.writeEndElement(); // WebXML
     writer.writeEndDocument();
 
-    out() << data;
     endSubPage();
 }
 
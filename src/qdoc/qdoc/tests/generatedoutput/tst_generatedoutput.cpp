@@ -28,6 +28,8 @@ private slots:
     void preparePhase();
     void generatePhase();
     void noAutoList();
+    void releaseDocs_data();
+    void releaseDocs();
 
 private:
     QScopedPointer<QTemporaryDir> m_outputDir;
@@ -269,6 +271,54 @@ void tst_generatedOutput::noAutoList()
                    "noautolist-docbook/qdoc-test-qmlmodule.xml");
 }
 
+void tst_generatedOutput::releaseDocs_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<QByteArray>("outNames");
+    QTest::addColumn<QByteArray>("extraParams");
+
+    QTest::newRow("cpp") << QByteArray("testdata/configs/testcpp.qdocconf")
+                         << QByteArray("testcpp-module.html "
+                                       "testqdoc-test.html "
+                                       "testqdoc-test-members.html "
+                                       "testqdoc-test-obsolete.html "
+                                       "testqdoc-testderived.html "
+                                       "testqdoc-testderived-members.html "
+                                       "testqdoc-testderived-obsolete.html "
+                                       "obsolete-classes.html "
+                                       "autolinking.html "
+                                       "cpptypes.html "
+                                       "testqdoc.html")
+                         << QByteArray("-release-docs");
+    QTest::newRow("qml") << QByteArray("testdata/qmlpropertygroups/qmlpropertygroups.qdocconf")
+                         << QByteArray("qmlpropertygroups/qml-qdoc-test-anotherchild-members.html "
+                                       "qmlpropertygroups/qml-qdoc-test-parent.html "
+                                       "qmlpropertygroups-docbook/qml-qdoc-test-parent.xml")
+                         << QByteArray("-release-docs");
+    QTest::newRow("singleexec") << QByteArray("testdata/singleexec/singleexec.qdocconf")
+                                << QByteArray("testcpp/testcpp-module.html "
+                                              "testcpp/testqdoc-test.html "
+                                              "testcpp/testqdoc-test-members.html "
+                                              "testcpp/testqdoc.html "
+                                              "testcpp/crossmoduleref.html "
+                                              "crossmodule/crossmodule/all-namespaces.html "
+                                              "crossmodule/crossmodule/testtype.html "
+                                              "crossmodule/crossmodule/testtype-members.html")
+                                << QByteArray("-single-exec -release-docs");
+}
+
+void tst_generatedOutput::releaseDocs()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(QByteArray, outNames);
+    QFETCH(QByteArray, extraParams);
+
+    // Releasing member documentation once its page is written must not
+    // change any page, so compare against the output of the other tests.
+    QScopedValueRollback<bool> skipRegen(m_regen, false);
+    testAndCompare(input.constData(), outNames.constData(), extraParams.constData());
+}
+
 int main(int argc, char *argv[])
 {
     tst_generatedOutput tc;
@@ -305,3 +305,27 @@ TEST_CASE(
         QFileInfo{greatest_lower_bound.value() + "/" + relative_path}.canonicalFilePath()
     );
 }
+
+TEST_CASE(
+    "When a query was resolved, other files in the same directory can be resolved as well",
+    "[ResolvingFiles][File][Path][Validation][SpecialCase]"
+) {
+    QString relative_path = GENERATE(take(10, qdoc::catch_generators::native_relative_file_path()));
+    CAPTURE(relative_path);
+
+    QTemporaryDir working_directory{};
+    REQUIRE(working_directory.isValid());
+
+    QString sibling_path = QFileInfo{relative_path}.path() + "/" + QFileInfo{relative_path}.fileName() + ".sibling";
+    CAPTURE(sibling_path);
+
+    REQUIRE(QDir{working_directory.path()}.mkpath(QFileInfo{relative_path}.path()));
+    REQUIRE(QFile{working_directory.path() + "/" + relative_path}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+    REQUIRE(QFile{working_directory.path() + "/" + sibling_path}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+
+    FileResolver file_resolver{std::vector{*DirectoryPath::refine(working_directory.path())}};
+
+    REQUIRE(file_resolver.resolve(relative_path));
+    REQUIRE(file_resolver.resolve(sibling_path));
+    REQUIRE(!file_resolver.resolve(sibling_path + ".missing"));
+}
@@ -20,8 +20,37 @@ private slots:
     void callCommaForOneWord();
     void callCommaForTwoWords();
     void callCommaForThreeWords();
+    void gzipRoundTrip_data();
+    void gzipRoundTrip();
+    void gzipChecksum();
+    void gzipTool();
 };
 
+static quint32 readLittleEndian(const QByteArray &data, qsizetype at)
+{
+    quint32 value = 0;
+    for (int i = 3; i >= 0; --i)
+        value = (value << 8) | uchar(data.at(at + i));
+    return value;
+}
+
+static void appendBigEndian(QByteArray &out, quint32 value)
+{
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out += char((value >> shift) & 0xff);
+}
+
+static quint32 adler32(const QByteArray &data)
+{
+    quint32 a = 1;
+    quint32 b = 0;
+    for (char ch : data) {
+        a = (a + uchar(ch)) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
 void tst_Utilities::loggingCategoryName()
 {
     const QString expected = "qt.qdoc";
@@ -129,6 +158,75 @@ void tst_Utilities::callCommaForThreeWords()
     QCOMPARE(result, expected);
 }
 
+void tst_Utilities::gzipRoundTrip_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("word") << QByteArray("hello");
+    QByteArray page = "<!DOCTYPE html>\n<html lang=\"en\">\n";
+    for (int i = 0; i < 2000; ++i)
+        page += "<tr><td class=\"memItemLeft\">int</td><td>" + QByteArray::number(i) + "</td></tr>\n";
+    QTest::newRow("page") << page;
+    QByteArray binary(70000, Qt::Uninitialized);
+    for (qsizetype i = 0; i < binary.size(); ++i)
+        binary[i] = char((i * 7919) >> 3);
+    QTest::newRow("binary") << binary;
+}
+
+void tst_Utilities::gzipRoundTrip()
+{
+    QFETCH(QByteArray, data);
+
+    const QByteArray compressed = Utilities::gzip(data);
+    constexpr qsizetype headerSize = 10;
+    constexpr qsizetype trailerSize = 8;
+    QVERIFY(compressed.size() >= headerSize + trailerSize);
+    QCOMPARE(compressed.first(4), QByteArray("\x1f\x8b\x08\x00", 4));
+    // No modification time, so that the output is reproducible
+    QCOMPARE(readLittleEndian(compressed, 4), 0u);
+    QCOMPARE(readLittleEndian(compressed, compressed.size() - 4), quint32(data.size()));
+
+    // Inflate the deflate stream by framing it the way qUncompress()
+    // expects: a big-endian length, a zlib header, and the Adler-32
+    // checksum of the data, which zlib verifies.
+    QByteArray zlib;
+    appendBigEndian(zlib, quint32(data.size()));
+    zlib += "\x78\xda";
+    zlib += compressed.sliced(headerSize, compressed.size() - headerSize - trailerSize);
+    appendBigEndian(zlib, adler32(data));
+    QCOMPARE(qUncompress(zlib), data);
+}
+
+void tst_Utilities::gzipChecksum()
+{
+    // The trailer holds the CRC-32 of the uncompressed data.
+    const QByteArray empty = Utilities::gzip(QByteArray());
+    QCOMPARE(readLittleEndian(empty, empty.size() - 8), 0u);
+    const QByteArray hello = Utilities::gzip("hello");
+    QCOMPARE(readLittleEndian(hello, hello.size() - 8), 0x3610a686u);
+    const QByteArray check = Utilities::gzip("123456789");
+    QCOMPARE(readLittleEndian(check, check.size() - 8), 0xcbf43926u);
+}
+
+void tst_Utilities::gzipTool()
+{
+    const QString tool = QStandardPaths::findExecutable(QStringLiteral("gzip"));
+    if (tool.isEmpty())
+        QSKIP("gzip is not available.");
+
+    const QByteArray data = QByteArray("Hello, compressed world!\n").repeated(500);
+    QProcess process;
+    process.start(tool, { QStringLiteral("-dc") });
+    QVERIFY(process.waitForStarted());
+    process.write(Utilities::gzip(data));
+    process.closeWriteChannel();
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(process.exitCode(), 0);
+    QCOMPARE(process.readAllStandardOutput(), data);
+}
+
 QTEST_APPLESS_MAIN(tst_Utilities)
 
 #include "tst_utilities.moc"
@@ -3,14 +3,113 @@
 
 #include <QWidget>
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QHash>
+#include <QMetaEnum>
 #include <qevent.h>
 
+#include <algorithm>
+
 QT_USE_NAMESPACE
 
 QIODevice *qout;
 
+// Writes one JSON object per line and event, with the time since start in
+// nanoseconds, without going through QDebug and without flushing.
+class JsonTracer
+{
+public:
+    JsonTracer() { m_timer.start(); }
+
+    void trace(const QEvent *e)
+    {
+        const qint64 time = m_timer.nsecsElapsed();
+        ++m_counts[e->type()];
+
+        QByteArray line;
+        line.reserve(128);
+        line += "{\"t\":";
+        line += QByteArray::number(time);
+        line += ",\"type\":\"";
+        line += typeName(e->type());
+        line += '"';
+        if (e->isInputEvent()) {
+            const auto *input = static_cast<const QInputEvent *>(e);
+            line += ",\"timestamp\":";
+            line += QByteArray::number(input->timestamp());
+        }
+        if (e->isPointerEvent()) {
+            const auto *pointer = static_cast<const QPointerEvent *>(e);
+            line += ",\"points\":[";
+            for (qsizetype i = 0; i < pointer->pointCount(); ++i) {
+                const QEventPoint &point = pointer->point(i);
+                if (i)
+                    line += ',';
+                line += "{\"id\":";
+                line += QByteArray::number(point.id());
+                line += ",\"x\":";
+                line += QByteArray::number(point.position().x());
+                line += ",\"y\":";
+                line += QByteArray::number(point.position().y());
+                line += ",\"pressure\":";
+                line += QByteArray::number(point.pressure());
+                line += '}';
+            }
+            line += ']';
+        } else if (e->type() == QEvent::KeyPress || e->type() == QEvent::KeyRelease) {
+            const auto *key = static_cast<const QKeyEvent *>(e);
+            line += ",\"key\":";
+            line += QByteArray::number(key->key());
+            line += ",\"autoRepeat\":";
+            line += key->isAutoRepeat() ? "true" : "false";
+        }
+        line += "}\n";
+        qout->write(line);
+    }
+
+    // Writes the number of events per type, most frequent first, as the
+    // last line.
+    void writeCounts()
+    {
+        QList<std::pair<quint64, QEvent::Type>> counts;
+        for (auto it = m_counts.cbegin(); it != m_counts.cend(); ++it)
+            counts.append({ it.value(), QEvent::Type(it.key()) });
+        std::sort(counts.begin(), counts.end(), [](const auto &a, const auto &b) {
+            return a.first > b.first;
+        });
+
+        QByteArray line = "{\"t\":" + QByteArray::number(m_timer.nsecsElapsed())
+                + ",\"counts\":{";
+        for (qsizetype i = 0; i < counts.size(); ++i) {
+            if (i)
+                line += ',';
+            line += '"';
+            line += typeName(counts.at(i).second);
+            line += "\":";
+            line += QByteArray::number(counts.at(i).first);
+        }
+        line += "}}\n";
+        qout->write(line);
+    }
+
+private:
+    static QByteArray typeName(QEvent::Type type)
+    {
+        static const QMetaEnum metaEnum = QMetaEnum::fromType<QEvent::Type>();
+        if (const char *key = metaEnum.valueToKey(type))
+            return key;
+        return QByteArray::number(int(type));
+    }
+
+    QElapsedTimer m_timer;
+    QHash<int, quint64> m_counts;
+};
+
+JsonTracer *tracer = nullptr;
+
 class Widget : public QWidget
 {
 public:
@@ -20,7 +119,10 @@ public:
     {
         if (e->type() == QEvent::ContextMenu)
             return false;
-        QDebug(qout) << e << Qt::endl;
+        if (tracer)
+            tracer->trace(e);
+        else
+            QDebug(qout) << e << Qt::endl;
         return QWidget::event(e);
     }
 };
@@ -30,11 +132,45 @@ int main(int argc, char **argv)
 {
     QApplication app(argc, argv);
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Prints the events a widget receives."));
+    parser.addHelpOption();
+    const QCommandLineOption jsonOption(
+            QStringLiteral("json"),
+            QStringLiteral("Write one JSON object per event, with timestamps in nanoseconds, "
+                           "and the number of events per type at exit."));
+    parser.addOption(jsonOption);
+    const QCommandLineOption outputOption(
+            { QStringLiteral("o"), QStringLiteral("output") },
+            QStringLiteral("Write the events to <file> instead of the standard output."),
+            QStringLiteral("file"));
+    parser.addOption(outputOption);
+    parser.process(app);
+
     QFile fout;
-    fout.open(stdout, QIODevice::WriteOnly);
+    if (parser.isSet(outputOption)) {
+        fout.setFileName(parser.value(outputOption));
+        if (!fout.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning("Cannot open %s: %s", qPrintable(fout.fileName()),
+                     qPrintable(fout.errorString()));
+            return 1;
+        }
+    } else {
+        fout.open(stdout, QIODevice::WriteOnly);
+    }
     qout = &fout;
 
-    Widget w;
-    w.show();
-    return app.exec();
+    JsonTracer jsonTracer;
+    if (parser.isSet(jsonOption))
+        tracer = &jsonTracer;
+
+    int result = 0;
+    {
+        Widget w;
+        w.show();
+        result = app.exec();
+    }
+    if (tracer)
+        tracer->writeCounts();
+    return result;
 }
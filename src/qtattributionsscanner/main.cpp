@@ -5,6 +5,7 @@
 #include "logging.h"
 #include "packagefilter.h"
 #include "qdocgenerator.h"
+#include "scancache.h"
 #include "scanner.h"
 
 #include <QtCore/qcommandlineparser.h>
@@ -53,6 +54,11 @@ int main(int argc, char *argv[])
     QCommandLineOption outputOption({ u"o"_s, u"output"_s },
                                     tr("Write generated data to <file>."),
                                     u"file"_s);
+    QCommandLineOption cacheOption(u"cache"_s,
+                                   tr("Keep the results of scanning directories in <file>, "
+                                      "and only read attribution files again that changed "
+                                      "since the last run."),
+                                   u"file"_s);
     QCommandLineOption verboseOption(u"verbose"_s, tr("Verbose output."));
     QCommandLineOption silentOption({ u"s"_s, u"silent"_s }, tr("Minimal output."));
 
@@ -62,6 +68,7 @@ int main(int argc, char *argv[])
     parser.addOption(baseDirOption);
     parser.addOption(noCheckPathsOption);
     parser.addOption(outputOption);
+    parser.addOption(cacheOption);
     parser.addOption(verboseOption);
     parser.addOption(silentOption);
 
@@ -100,6 +107,14 @@ int main(int argc, char *argv[])
         parser.showHelp(8);
     }
 
+    Scanner::ScanCache cache;
+    const QString cacheFile = parser.value(cacheOption);
+    const QString cacheKey = Scanner::scanCacheKey(formats, checks, logLevel);
+    if (!cacheFile.isEmpty() && !cache.load(cacheFile, cacheKey) && logLevel == VerboseLog) {
+        std::cerr << qPrintable(tr("Scan cache %1 cannot be used, scanning all files.").arg(
+                                    QDir::toNativeSeparators(cacheFile))) << std::endl;
+    }
+
     // Parse the attribution files
     QList<Package> packages;
     for (const QString &path: paths) {
@@ -109,7 +124,8 @@ int main(int argc, char *argv[])
                 std::cerr << qPrintable(tr("Recursively scanning %1 for attribution files...").arg(
                                             QDir::toNativeSeparators(path))) << std::endl;
             std::optional<QList<Package>> p
-                    = Scanner::scanDirectory(path, formats, checks, logLevel);
+                    = Scanner::scanDirectory(path, formats, checks, logLevel,
+                                             cacheFile.isEmpty() ? nullptr : &cache);
             if (!p)
                 return 1;
             packages.append(*p);
@@ -126,6 +142,11 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (!cacheFile.isEmpty() && !cache.save(cacheFile, cacheKey) && logLevel != SilentLog) {
+        std::cerr << qPrintable(tr("Cannot write scan cache %1.").arg(
+                                    QDir::toNativeSeparators(cacheFile))) << std::endl;
+    }
+
     // Apply the filter
     if (parser.isSet(filterOption)) {
         PackageFilter filter(parser.value(filterOption));
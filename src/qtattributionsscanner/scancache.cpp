@@ -0,0 +1,120 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "scancache.h"
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+
+static QDataStream &operator<<(QDataStream &stream, const Package &p)
+{
+    return stream << p.id << p.path << p.files << p.name << p.qdocModule << p.qtUsage
+                  << p.securityCritical << p.qtParts << p.description << p.homepage
+                  << p.version << p.downloadLocation << p.license << p.licenseId
+                  << p.licenseFiles << p.licenseFilesContents << p.copyright
+                  << p.copyrightFile << p.copyrightFileContents << p.cpeList << p.purlList
+                  << p.packageComment;
+}
+
+static QDataStream &operator>>(QDataStream &stream, Package &p)
+{
+    return stream >> p.id >> p.path >> p.files >> p.name >> p.qdocModule >> p.qtUsage
+                  >> p.securityCritical >> p.qtParts >> p.description >> p.homepage
+                  >> p.version >> p.downloadLocation >> p.license >> p.licenseId
+                  >> p.licenseFiles >> p.licenseFilesContents >> p.copyright
+                  >> p.copyrightFile >> p.copyrightFileContents >> p.cpeList >> p.purlList
+                  >> p.packageComment;
+}
+
+namespace Scanner {
+
+static const quint32 cacheMagic = 0x51415343; // "QASC"
+static const quint32 cacheVersion = 1;
+
+/*
+  Replaces the contents of the cache with the one stored in fileName.
+  The cache stays empty if the file does not exist, or if it was written
+  by another version, or for another key, that is, with other options.
+*/
+bool ScanCache::load(const QString &fileName, const QString &key)
+{
+    directories.clear();
+    files.clear();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString storedKey;
+    stream >> magic >> version;
+    if (magic != cacheMagic || version != cacheVersion)
+        return false;
+    stream >> storedKey;
+    if (storedKey != key)
+        return false;
+
+    QHash<QString, Directory> storedDirectories;
+    QHash<QString, File> storedFiles;
+    qint64 count = 0;
+    stream >> count;
+    for (qint64 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Directory directory;
+        stream >> path >> directory.lastModified >> directory.entries >> directory.directories;
+        storedDirectories.insert(path, std::move(directory));
+    }
+    stream >> count;
+    for (qint64 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        File entry;
+        QByteArray diagnostics;
+        stream >> path >> entry.dependencies >> entry.packages >> diagnostics;
+        entry.diagnostics = diagnostics.toStdString();
+        storedFiles.insert(path, std::move(entry));
+    }
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    directories = std::move(storedDirectories);
+    files = std::move(storedFiles);
+    return true;
+}
+
+bool ScanCache::save(const QString &fileName, const QString &key) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << cacheMagic << cacheVersion << key;
+    stream << qint64(directories.size());
+    for (auto it = directories.cbegin(); it != directories.cend(); ++it)
+        stream << it.key() << it->lastModified << it->entries << it->directories;
+    stream << qint64(files.size());
+    for (auto it = files.cbegin(); it != files.cend(); ++it) {
+        stream << it.key() << it->dependencies << it->packages
+               << QByteArray::fromStdString(it->diagnostics);
+    }
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+// Returns the modification time of path in milliseconds, or -1 if it
+// does not exist.
+qint64 ScanCache::lastModified(const QString &path)
+{
+    const QFileInfo info(path);
+    if (!info.exists())
+        return -1;
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+} // namespace Scanner
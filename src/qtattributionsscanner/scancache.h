@@ -0,0 +1,60 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef SCANCACHE_H
+#define SCANCACHE_H
+
+#include "package.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+#include <string>
+#include <utility>
+
+namespace Scanner {
+
+/*
+  The results of earlier scans, keyed by absolute path. A directory
+  listing stays valid as long as the modification time of the directory
+  is unchanged, and the packages of an attribution file as long as none
+  of the files they were read from changed.
+*/
+class ScanCache
+{
+public:
+    // The matching files and the subdirectories of a directory, in the
+    // order of QDir::entryInfoList().
+    struct Directory
+    {
+        qint64 lastModified = -1;
+        QStringList entries;
+        QSet<QString> directories;
+    };
+
+    // The packages read from an attribution file, with the diagnostics
+    // printed while reading them.
+    struct File
+    {
+        // The files that were read or checked, with their modification
+        // times, or -1 if they did not exist.
+        QList<std::pair<QString, qint64>> dependencies;
+        QList<Package> packages;
+        std::string diagnostics;
+    };
+
+    bool load(const QString &fileName, const QString &key);
+    bool save(const QString &fileName, const QString &key) const;
+
+    QHash<QString, Directory> directories;
+    QHash<QString, File> files;
+
+    static qint64 lastModified(const QString &path);
+};
+
+} // namespace Scanner
+
+#endif // SCANCACHE_H
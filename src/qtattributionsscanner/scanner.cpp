@@ -3,24 +3,39 @@
 
 #include "scanner.h"
 #include "logging.h"
+#include "scancache.h"
 
 #include <QtCore/qdir.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qvariant.h>
+#include <QtCore/qwaitcondition.h>
 
 #include <iostream>
+#include <sstream>
 
 using namespace Qt::Literals::StringLiterals;
 
 namespace Scanner {
 
+// Diagnostics go to std::cerr, unless the files are read in parallel, in
+// which case they are collected per file and printed in scanning order.
+static thread_local std::ostream *diagnostics = nullptr;
+
+static std::ostream &errorStream()
+{
+    return diagnostics ? *diagnostics : std::cerr;
+}
+
 static void missingPropertyWarning(const QString &filePath, const QString &property)
 {
-    std::cerr << qPrintable(tr("File %1: Missing mandatory property '%2'.").arg(
+    errorStream() << qPrintable(tr("File %1: Missing mandatory property '%2'.").arg(
                                 QDir::toNativeSeparators(filePath), property)) << std::endl;
 }
 
@@ -46,7 +61,7 @@ static bool validatePackage(Package &p, const QString &filePath, Checks checks,
         validPackage = false;
     } else if (!p.id.isLower() || p.id.contains(' '_L1)) {
         if (logLevel != SilentLog)
-            std::cerr << qPrintable(tr("File %1: Value of 'Id' must be in lowercase and without spaces.")
+            errorStream() << qPrintable(tr("File %1: Value of 'Id' must be in lowercase and without spaces.")
                                         .arg(QDir::toNativeSeparators(filePath))) << std::endl;
         validPackage = false;
     }
@@ -59,7 +74,7 @@ static bool validatePackage(Package &p, const QString &filePath, Checks checks,
 
     if (!p.copyright.isEmpty() && !p.copyrightFile.isEmpty()) {
         if (logLevel != SilentLog) {
-            std::cerr << qPrintable(tr("File %1: Properties 'Copyright' and 'CopyrightFile' are "
+            errorStream() << qPrintable(tr("File %1: Properties 'Copyright' and 'CopyrightFile' are "
                                        "mutually exclusive.")
                                             .arg(QDir::toNativeSeparators(filePath)))
                       << std::endl;
@@ -78,7 +93,7 @@ static bool validatePackage(Package &p, const QString &filePath, Checks checks,
             && part != "tools"_L1 && part != "libs"_L1) {
 
             if (logLevel != SilentLog) {
-                std::cerr << qPrintable(tr("File %1: Property 'QtPart' contains unknown element "
+                errorStream() << qPrintable(tr("File %1: Property 'QtPart' contains unknown element "
                                            "'%2'. Valid entries are 'examples', 'tests', 'tools' "
                                            "and 'libs'.").arg(
                                             QDir::toNativeSeparators(filePath), part))
@@ -93,7 +108,7 @@ static bool validatePackage(Package &p, const QString &filePath, Checks checks,
 
     const QDir dir = p.path;
     if (!dir.exists()) {
-        std::cerr << qPrintable(
+        errorStream() << qPrintable(
                 tr("File %1: Directory '%2' does not exist.")
                         .arg(QDir::toNativeSeparators(filePath), QDir::toNativeSeparators(p.path)))
                   << std::endl;
@@ -102,7 +117,7 @@ static bool validatePackage(Package &p, const QString &filePath, Checks checks,
         for (const QString &file : std::as_const(p.files)) {
             if (!dir.exists(file)) {
                 if (logLevel != SilentLog) {
-                    std::cerr << qPrintable(
+                    errorStream() << qPrintable(
                             tr("File %1: Path '%2' does not exist in directory '%3'.")
                                     .arg(QDir::toNativeSeparators(filePath),
                                          QDir::toNativeSeparators(file),
@@ -209,11 +224,11 @@ static bool autoDetectLicenseFiles(Package &p)
         } else if (licensesDir.exists(fileName)) {
             p.licenseFiles.append(licensesDir.filePath(fileName));
         } else {
-            std::cerr << "tr(Missing expected license file:)" << std::endl;
-            std::cerr << qPrintable(QDir::toNativeSeparators(licensesDirLocal.filePath(fileNameLocal)))
+            errorStream() << "tr(Missing expected license file:)" << std::endl;
+            errorStream() << qPrintable(QDir::toNativeSeparators(licensesDirLocal.filePath(fileNameLocal)))
                       << std::endl;
             if (!licensesDirPath.isEmpty()) {
-                std::cerr << qPrintable(tr("or\n %1").arg(
+                errorStream() << qPrintable(tr("or\n %1").arg(
                                             QDir::toNativeSeparators(licensesDir.filePath(fileName))))
                           << std::endl;
             }
@@ -239,7 +254,7 @@ static bool handleStringOrStringArrayJsonKey(QStringList &outList, const QString
         outList.append(jsonValue.toString());
     } else {
         if (logLevel != SilentLog) {
-            std::cerr << qPrintable(tr("File %1: Expected JSON array of strings or "
+            errorStream() << qPrintable(tr("File %1: Expected JSON array of strings or "
                                        "string as value of %2.").arg(
                                         QDir::toNativeSeparators(filePath), key))
                       << std::endl;
@@ -265,7 +280,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
             && key != "Files"_L1 && key != "LicenseFiles"_L1 && key != "Comment"_L1
             && key != "Copyright"_L1 && key != "CPE"_L1 && key != "PURL"_L1) {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("File %1: Expected JSON string as value of %2.").arg(
+                errorStream() << qPrintable(tr("File %1: Expected JSON string as value of %2.").arg(
                                             QDir::toNativeSeparators(filePath), key)) << std::endl;
             validPackage = false;
             continue;
@@ -286,7 +301,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
                 p.files = value.simplified().split(QLatin1Char(' '), Qt::SkipEmptyParts);
             } else {
                 if (logLevel != SilentLog) {
-                    std::cerr << qPrintable(tr("File %1: Expected JSON array of strings as value "
+                    errorStream() << qPrintable(tr("File %1: Expected JSON array of strings as value "
                                                "of Files.").arg(QDir::toNativeSeparators(filePath)))
                               << std::endl;
                     validPackage = false;
@@ -316,7 +331,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
             auto strings = toStringList(iter.value());
             if (!strings) {
                 if (logLevel != SilentLog)
-                    std::cerr << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
+                    errorStream() << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
                                                     .arg(QDir::toNativeSeparators(filePath), key))
                               << std::endl;
                 validPackage = false;
@@ -337,7 +352,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
                 p.copyright = value;
             } else {
                 if (logLevel != SilentLog) {
-                    std::cerr << qPrintable(tr("File %1: Expected JSON array of strings or "
+                    errorStream() << qPrintable(tr("File %1: Expected JSON array of strings or "
                                                "string as value of %2.").arg(
                                                 QDir::toNativeSeparators(filePath), key)) << std::endl;
                     validPackage = false;
@@ -368,7 +383,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
             p.qtUsage = value;
         } else if (key == "SecurityCritical"_L1) {
             if (!iter.value().isBool()) {
-                std::cerr << qPrintable(tr("File %1: Expected JSON boolean in %2.")
+                errorStream() << qPrintable(tr("File %1: Expected JSON boolean in %2.")
                                                 .arg(QDir::toNativeSeparators(filePath), key))
                           << std::endl;
                 validPackage = false;
@@ -379,7 +394,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
             auto parts = toStringList(iter.value());
             if (!parts) {
                 if (logLevel != SilentLog) {
-                    std::cerr << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
+                    errorStream() << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
                                                     .arg(QDir::toNativeSeparators(filePath), key))
                               << std::endl;
                 }
@@ -389,7 +404,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
             p.qtParts = parts.value();
         } else {
             if (logLevel != SilentLog) {
-                std::cerr << qPrintable(tr("File %1: Unknown key %2.").arg(
+                errorStream() << qPrintable(tr("File %1: Unknown key %2.").arg(
                                             QDir::toNativeSeparators(filePath), key)) << std::endl;
             }
             validPackage = false;
@@ -399,7 +414,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
     if (!p.copyrightFile.isEmpty()) {
         QFile file(p.copyrightFile);
         if (!file.open(QIODevice::ReadOnly)) {
-            std::cerr << qPrintable(tr("File %1: Cannot open 'CopyrightFile' %2.\n")
+            errorStream() << qPrintable(tr("File %1: Cannot open 'CopyrightFile' %2.\n")
                                             .arg(QDir::toNativeSeparators(filePath),
                                                  QDir::toNativeSeparators(p.copyrightFile)));
             validPackage = false;
@@ -414,7 +429,7 @@ static std::optional<Package> readPackage(const QJsonObject &object, const QStri
         QFile file(licenseFile);
         if (!file.open(QIODevice::ReadOnly)) {
             if (logLevel != SilentLog) {
-                std::cerr << qPrintable(tr("File %1: Cannot open 'LicenseFile' %2.\n")
+                errorStream() << qPrintable(tr("File %1: Cannot open 'LicenseFile' %2.\n")
                                                 .arg(QDir::toNativeSeparators(filePath),
                                                      QDir::toNativeSeparators(licenseFile)));
             }
@@ -534,13 +549,13 @@ std::optional<QList<Package>> readFile(const QString &filePath, Checks checks, L
     bool errorsFound = false;
 
     if (logLevel == VerboseLog) {
-        std::cerr << qPrintable(tr("Reading file %1...").arg(
+        errorStream() << qPrintable(tr("Reading file %1...").arg(
                                     QDir::toNativeSeparators(filePath))) << std::endl;
     }
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         if (logLevel != SilentLog)
-            std::cerr << qPrintable(tr("Could not open file %1.").arg(
+            errorStream() << qPrintable(tr("Could not open file %1.").arg(
                                         QDir::toNativeSeparators(file.fileName()))) << std::endl;
         return std::nullopt;
     }
@@ -552,7 +567,7 @@ std::optional<QList<Package>> readFile(const QString &filePath, Checks checks, L
         if (document.isNull()) {
             if (logLevel != SilentLog) {
                 const CursorPosition pos = mapFromOffset(content, jsonParseError.offset);
-                std::cerr << qPrintable(tr("Could not parse file %1: %2 at line %3, column %4")
+                errorStream() << qPrintable(tr("Could not parse file %1: %2 at line %3, column %4")
                                                 .arg(QDir::toNativeSeparators(file.fileName()),
                                                      jsonParseError.errorString(),
                                                      QString::number(pos.line),
@@ -584,7 +599,7 @@ std::optional<QList<Package>> readFile(const QString &filePath, Checks checks, L
                     }
                 } else {
                     if (logLevel != SilentLog) {
-                        std::cerr << qPrintable(tr("File %1: Expecting JSON object in array.")
+                        errorStream() << qPrintable(tr("File %1: Expecting JSON object in array.")
                                         .arg(QDir::toNativeSeparators(file.fileName())))
                                   << std::endl;
                     }
@@ -593,7 +608,7 @@ std::optional<QList<Package>> readFile(const QString &filePath, Checks checks, L
             }
         } else {
             if (logLevel != SilentLog) {
-                std::cerr << qPrintable(tr("File %1: Expecting JSON object in array.").arg(
+                errorStream() << qPrintable(tr("File %1: Expecting JSON object in array.").arg(
                                             QDir::toNativeSeparators(file.fileName()))) << std::endl;
             }
             errorsFound = true;
@@ -604,7 +619,7 @@ std::optional<QList<Package>> readFile(const QString &filePath, Checks checks, L
             packages << chromiumPackage;
     } else {
         if (logLevel != SilentLog) {
-            std::cerr << qPrintable(tr("File %1: Unsupported file type.")
+            errorStream() << qPrintable(tr("File %1: Unsupported file type.")
                             .arg(QDir::toNativeSeparators(file.fileName())))
                       << std::endl;
         }
@@ -616,13 +631,165 @@ std::optional<QList<Package>> readFile(const QString &filePath, Checks checks, L
     return packages;
 }
 
-std::optional<QList<Package>> scanDirectory(const QString &directory, InputFormats inputFormats,
-                                            Checks checks, LogLevel logLevel)
+namespace {
+
+using DirectoryListing = ScanCache::Directory;
+
+/*
+  Lists all directories below a root on the global thread pool. Every
+  worker takes the next directory from a shared queue, and adds its
+  subdirectories to it, so that large subtrees are spread over all
+  threads. A directory whose modification time is unchanged is not
+  listed again; its listing is taken from the cache.
+*/
+class DirectoryWalker
 {
-    QDir dir(directory);
-    QList<Package> packages;
-    bool errorsFound = false;
+public:
+    DirectoryWalker(const QStringList &nameFilters, const ScanCache *cache)
+        : m_nameFilters(nameFilters), m_cache(cache)
+    {
+    }
+
+    QHash<QString, DirectoryListing> walk(const QString &root)
+    {
+        QThreadPool *pool = QThreadPool::globalInstance();
+        const int workers = qMax(1, pool->maxThreadCount());
+        QMutexLocker locker(&m_mutex);
+        m_queue.append(root);
+        m_running = workers;
+        locker.unlock();
+        for (int i = 0; i < workers; ++i)
+            pool->start([this] { work(); });
+        locker.relock();
+        while (m_running > 0)
+            m_changed.wait(&m_mutex);
+        return std::move(m_listings);
+    }
+
+private:
+    DirectoryListing list(const QString &directory) const
+    {
+        DirectoryListing listing;
+        if (m_cache) {
+            listing.lastModified = ScanCache::lastModified(directory);
+            const auto it = m_cache->directories.constFind(directory);
+            if (it != m_cache->directories.cend() && listing.lastModified >= 0
+                && it->lastModified == listing.lastModified) {
+                return *it;
+            }
+        }
+
+        QDir dir(directory);
+        dir.setNameFilters(m_nameFilters);
+        dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Files);
+        const QFileInfoList entries = dir.entryInfoList();
+        for (const QFileInfo &info : entries) {
+            listing.entries.append(info.filePath());
+            if (info.isDir())
+                listing.directories.insert(info.filePath());
+        }
+        return listing;
+    }
+
+    void work()
+    {
+        QMutexLocker locker(&m_mutex);
+        for (;;) {
+            while (m_queue.isEmpty() && m_busy > 0)
+                m_changed.wait(&m_mutex);
+            if (m_queue.isEmpty())
+                break;
+            const QString directory = m_queue.takeLast();
+            ++m_busy;
+            locker.unlock();
+
+            DirectoryListing listing = list(directory);
+            QStringList subdirectories;
+            for (const QString &entry : std::as_const(listing.entries)) {
+                if (listing.directories.contains(entry))
+                    subdirectories.append(entry);
+            }
+
+            locker.relock();
+            m_listings.insert(directory, std::move(listing));
+            m_queue += subdirectories;
+            --m_busy;
+            m_changed.wakeAll();
+        }
+        --m_running;
+        m_changed.wakeAll();
+    }
+
+    const QStringList m_nameFilters;
+    const ScanCache *m_cache;
+    QMutex m_mutex;
+    QWaitCondition m_changed;
+    QStringList m_queue;
+    int m_busy = 0;
+    int m_running = 0;
+    QHash<QString, DirectoryListing> m_listings;
+};
+
+// Appends the files below directory in depth-first order, as a recursive
+// walk would find them.
+void collectFiles(const QHash<QString, DirectoryListing> &listings, const QString &directory,
+                  QStringList *files)
+{
+    const DirectoryListing listing = listings.value(directory);
+    for (const QString &entry : listing.entries) {
+        if (listing.directories.contains(entry))
+            collectFiles(listings, entry, files);
+        else
+            files->append(entry);
+    }
+}
 
+struct FileResult
+{
+    std::optional<QList<Package>> packages;
+    std::string diagnostics;
+    QList<std::pair<QString, qint64>> dependencies;
+    bool cached = false;
+};
+
+bool isUpToDate(const ScanCache::File &entry)
+{
+    for (const auto &[path, lastModified] : entry.dependencies) {
+        if (ScanCache::lastModified(path) != lastModified)
+            return false;
+    }
+    return true;
+}
+
+// Returns the files and the directories that reading filePath depends on,
+// that is, the files whose contents ended up in the packages, and those
+// that were only checked for existence.
+QList<std::pair<QString, qint64>> dependencies(const QString &filePath, qint64 lastModified,
+                                               const QList<Package> &packages)
+{
+    QSet<QString> seen = { filePath };
+    QList<std::pair<QString, qint64>> result = { { filePath, lastModified } };
+    const auto add = [&seen, &result](const QString &path) {
+        if (!path.isEmpty() && !seen.contains(path)) {
+            seen.insert(path);
+            result.append({ path, ScanCache::lastModified(path) });
+        }
+    };
+    for (const Package &p : packages) {
+        // The directory changes when a local license file is added.
+        add(p.path);
+        add(p.copyrightFile);
+        for (const QString &licenseFile : p.licenseFiles)
+            add(licenseFile);
+        const QDir dir(p.path);
+        for (const QString &file : p.files)
+            add(dir.filePath(file));
+    }
+    return result;
+}
+
+QStringList nameFilters(InputFormats inputFormats)
+{
     QStringList nameFilters = QStringList();
     if (inputFormats & InputFormat::QtAttributions)
         nameFilters << u"qt_attribution.json"_s;
@@ -630,25 +797,101 @@ std::optional<QList<Package>> scanDirectory(const QString &directory, InputForma
         nameFilters << u"README.chromium"_s;
     if (qEnvironmentVariableIsSet("QT_ATTRIBUTIONSSCANNER_TEST"))
         nameFilters << u"qt_attribution_test.json"_s << u"README_test.chromium"_s;
+    return nameFilters;
+}
 
-    dir.setNameFilters(nameFilters);
-    dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Files);
+} // namespace
 
-    const QFileInfoList entries = dir.entryInfoList();
-    for (const QFileInfo &info : entries) {
-        if (info.isDir()) {
-            std::optional<QList<Package>> ps =
-                    scanDirectory(info.filePath(), inputFormats, checks, logLevel);
-            if (!ps)
-                errorsFound = true;
-            else
-                packages += *ps;
-        } else {
-            std::optional p = readFile(info.filePath(), checks, logLevel);
-            if (!p)
-                errorsFound = true;
-            else
-                packages += *p;
+/*
+  Returns the key of a scan cache, which has to match for the cache to
+  be used: the cached listings depend on the input formats, and the
+  packages and the diagnostics on the checks and the log level.
+*/
+QString scanCacheKey(InputFormats inputFormats, Checks checks, LogLevel logLevel)
+{
+    return nameFilters(inputFormats).join(u' ')
+            + u";checks=%1;log=%2"_s.arg(checks.toInt()).arg(int(logLevel));
+}
+
+/*
+  Finds the attribution files below directory, and reads them all in
+  parallel. The packages and the diagnostics are reported in the same
+  order as a sequential depth-first scan would produce them.
+
+  If cache is set, unchanged directories are not listed, and unchanged
+  attribution files are not read again; afterwards, the cache holds the
+  results of this scan below directory.
+*/
+std::optional<QList<Package>> scanDirectory(const QString &directory, InputFormats inputFormats,
+                                            Checks checks, LogLevel logLevel, ScanCache *cache)
+{
+    DirectoryWalker walker(nameFilters(inputFormats), cache);
+    QHash<QString, DirectoryListing> listings = walker.walk(directory);
+    QStringList files;
+    collectFiles(listings, directory, &files);
+
+    QList<FileResult> results(files.size());
+    QThreadPool *pool = QThreadPool::globalInstance();
+    for (qsizetype i = 0; i < files.size(); ++i) {
+        pool->start([&files, &results, i, checks, logLevel, cache] {
+            const QString &filePath = files.at(i);
+            FileResult &result = results[i];
+            qint64 lastModified = -1;
+            if (cache) {
+                const auto it = cache->files.constFind(filePath);
+                if (it != cache->files.cend() && isUpToDate(*it)) {
+                    result.packages = it->packages;
+                    result.diagnostics = it->diagnostics;
+                    result.dependencies = it->dependencies;
+                    result.cached = true;
+                    return;
+                }
+                lastModified = ScanCache::lastModified(filePath);
+            }
+
+            std::ostringstream stream;
+            diagnostics = &stream;
+            result.packages = readFile(filePath, checks, logLevel);
+            diagnostics = nullptr;
+            result.diagnostics = stream.str();
+            if (cache && result.packages)
+                result.dependencies = dependencies(filePath, lastModified, *result.packages);
+        });
+    }
+    pool->waitForDone();
+
+    QList<Package> packages;
+    bool errorsFound = false;
+    for (qsizetype i = 0; i < results.size(); ++i) {
+        const FileResult &result = results.at(i);
+        if (result.cached && logLevel == VerboseLog) {
+            std::cerr << qPrintable(tr("Using cached packages of %1.").arg(
+                                        QDir::toNativeSeparators(files.at(i)))) << std::endl;
+        }
+        std::cerr << result.diagnostics;
+        if (!result.packages)
+            errorsFound = true;
+        else
+            packages += *result.packages;
+    }
+
+    if (cache) {
+        // Forget everything below directory that was not found again.
+        const QString prefix = directory.endsWith(u'/') ? directory : directory + u'/';
+        const auto isBelow = [&directory, &prefix](const QString &path) {
+            return path == directory || path.startsWith(prefix);
+        };
+        cache->directories.removeIf([&isBelow](const auto &it) { return isBelow(it.key()); });
+        cache->files.removeIf([&isBelow](const auto &it) { return isBelow(it.key()); });
+        for (auto it = listings.begin(); it != listings.end(); ++it)
+            cache->directories.insert(it.key(), std::move(it.value()));
+        for (qsizetype i = 0; i < files.size(); ++i) {
+            FileResult &result = results[i];
+            if (!result.packages)
+                continue;
+            cache->files.insert(files.at(i),
+                                { std::move(result.dependencies), std::move(*result.packages),
+                                  std::move(result.diagnostics) });
         }
     }
 
@@ -14,6 +14,8 @@
 
 namespace Scanner {
 
+class ScanCache;
+
 enum class InputFormat {
     QtAttributions = 0x1, // qt_attributions.json
     ChromiumAttributions = 0x2, // README.chromium
@@ -27,7 +29,9 @@ Q_DECLARE_OPERATORS_FOR_FLAGS(Checks)
 
 std::optional<QList<Package>> readFile(const QString &filePath, Checks checks, LogLevel logLevel);
 std::optional<QList<Package>> scanDirectory(const QString &directory, InputFormats inputFormats,
-                                            Checks checks, LogLevel logLevel);
+                                            Checks checks, LogLevel logLevel,
+                                            ScanCache *cache = nullptr);
+QString scanCacheKey(InputFormats inputFormats, Checks checks, LogLevel logLevel);
 }
 
 #endif // SCANNER_H
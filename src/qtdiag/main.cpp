@@ -5,6 +5,7 @@
 
 #include <QtGui/QGuiApplication>
 #include <QtCore/QCommandLineParser>
+#include <QtCore/QElapsedTimer>
 
 #include <iostream>
 #include <string>
@@ -13,7 +14,11 @@ QT_USE_NAMESPACE
 
 int main(int argc, char **argv)
 {
+    QElapsedTimer applicationTimer;
+    applicationTimer.start();
     QGuiApplication app(argc, argv);
+    QtDiagTimings timings;
+    timings.application = applicationTimer.nsecsElapsed();
 
     QCoreApplication::setApplicationName(QStringLiteral("qtdiag"));
     QCoreApplication::setApplicationVersion(QLatin1String(QT_VERSION_STR));
@@ -26,12 +31,14 @@ int main(int argc, char **argv)
     const QCommandLineOption fontOption(QStringLiteral("fonts"), QStringLiteral("Output list of fonts"));
     const QCommandLineOption noVkOption(QStringLiteral("no-vulkan"), QStringLiteral("Do not output Vulkan information"));
     const QCommandLineOption noRhiOption(QStringLiteral("no-rhi"), QStringLiteral("Do not output RHI information"));
+    const QCommandLineOption jsonOption(QStringLiteral("json"), QStringLiteral("Output JSON, including initialization timings"));
     commandLineParser.setApplicationDescription(QStringLiteral("Prints diagnostic output about the Qt library."));
     commandLineParser.addOption(noGlOption);
     commandLineParser.addOption(glExtensionOption);
     commandLineParser.addOption(fontOption);
     commandLineParser.addOption(noVkOption);
     commandLineParser.addOption(noRhiOption);
+    commandLineParser.addOption(jsonOption);
     commandLineParser.addHelpOption();
     commandLineParser.process(app);
     unsigned flags = commandLineParser.isSet(noGlOption) ? 0u : unsigned(QtDiagGl);
@@ -44,7 +51,13 @@ int main(int argc, char **argv)
     if (!commandLineParser.isSet(noRhiOption))
         flags |= QtDiagRhi;
 
-    std::wcout << qtDiag(flags).toStdWString();
+    if (commandLineParser.isSet(jsonOption)) {
+        std::cout << qtDiagJson(flags, &timings).toStdString();
+        std::cout.flush();
+        return 0;
+    }
+
+    std::wcout << qtDiag(flags, &timings).toStdWString();
     std::wcout.flush();
     return 0;
 }
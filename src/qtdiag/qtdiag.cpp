@@ -40,6 +40,10 @@
 #include <QtCore/QDir>
 #include <QtCore/QFileSelector>
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QVersionNumber>
 
 #include <private/qsimd_p.h>
@@ -558,10 +562,13 @@ static inline QByteArrayList qtFeatures()
     return result;
 }
 
-QString qtDiag(unsigned flags)
+QString qtDiag(unsigned flags, QtDiagTimings *timings)
 {
     QString result;
     QTextStream str(&result);
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+    QElapsedTimer timer;
 
     const QPlatformIntegration *platformIntegration = QGuiApplicationPrivate::platformIntegration();
     str << QLibraryInfo::build() << " on \"" << QGuiApplication::platformName() << "\" "
@@ -861,7 +868,10 @@ QString qtDiag(unsigned flags)
 
 #ifndef QT_NO_OPENGL
     if (flags & QtDiagGl) {
+        timer.start();
         dumpGlInfo(str, flags & QtDiagGlExtensions);
+        if (timings)
+            timings->openGL = timer.nsecsElapsed();
         str << "\n";
     }
 #else
@@ -870,7 +880,10 @@ QString qtDiag(unsigned flags)
 
 #if QT_CONFIG(vulkan)
     if (flags & QtDiagVk) {
+        timer.start();
         dumpVkInfo(str);
+        if (timings)
+            timings->vulkan = timer.nsecsElapsed();
         str << "\n\n";
     }
 #endif // vulkan
@@ -894,11 +907,79 @@ QString qtDiag(unsigned flags)
 #endif // Q_OS_WIN
 
     if (flags & QtDiagRhi) {
+        timer.start();
         dumpRhiInfo(str);
+        if (timings)
+            timings->rhi = timer.nsecsElapsed();
         str << "\n";
     }
 
+    if (timings)
+        timings->total = totalTimer.nsecsElapsed();
     return result;
 }
 
+static QJsonValue milliseconds(qint64 nsecs)
+{
+    return nsecs < 0 ? QJsonValue() : QJsonValue(nsecs / 1000000.0);
+}
+
+static QJsonArray toJson(const QRect &r)
+{
+    return { r.x(), r.y(), r.width(), r.height() };
+}
+
+/*
+    Returns the main facts of qtDiag() as a JSON object for collecting
+    them from many machines: the platform, the screens, and how long the
+    initialization of the platform plugin and the graphics APIs took. The
+    complete text report is included as a list of lines.
+*/
+QByteArray qtDiagJson(unsigned flags, QtDiagTimings *timings)
+{
+    const QString report = qtDiag(flags, timings);
+
+    QJsonObject os;
+    os.insert(QLatin1String("prettyProductName"), QSysInfo::prettyProductName());
+    os.insert(QLatin1String("productType"), QSysInfo::productType());
+    os.insert(QLatin1String("productVersion"), QSysInfo::productVersion());
+    os.insert(QLatin1String("kernelType"), QSysInfo::kernelType());
+    os.insert(QLatin1String("kernelVersion"), QSysInfo::kernelVersion());
+    os.insert(QLatin1String("cpuArchitecture"), QSysInfo::currentCpuArchitecture());
+
+    QJsonArray screens;
+    const QList<QScreen *> screenList = QGuiApplication::screens();
+    for (const QScreen *screen : screenList) {
+        QJsonObject object;
+        object.insert(QLatin1String("name"), screen->name());
+        object.insert(QLatin1String("geometry"), toJson(screen->geometry()));
+        object.insert(QLatin1String("availableGeometry"), toJson(screen->availableGeometry()));
+        object.insert(QLatin1String("devicePixelRatio"), screen->devicePixelRatio());
+        object.insert(QLatin1String("logicalDpi"), screen->logicalDotsPerInch());
+        object.insert(QLatin1String("physicalDpi"), screen->physicalDotsPerInch());
+        object.insert(QLatin1String("refreshRate"), screen->refreshRate());
+        object.insert(QLatin1String("depth"), screen->depth());
+        screens.append(object);
+    }
+
+    QJsonObject timing;
+    const QtDiagTimings noTimings;
+    const QtDiagTimings &t = timings ? *timings : noTimings;
+    timing.insert(QLatin1String("applicationMs"), milliseconds(t.application));
+    timing.insert(QLatin1String("openGLMs"), milliseconds(t.openGL));
+    timing.insert(QLatin1String("vulkanMs"), milliseconds(t.vulkan));
+    timing.insert(QLatin1String("rhiMs"), milliseconds(t.rhi));
+    timing.insert(QLatin1String("totalMs"), milliseconds(t.total));
+
+    QJsonObject root;
+    root.insert(QLatin1String("qtVersion"), QLatin1String(qVersion()));
+    root.insert(QLatin1String("build"), QLatin1String(QLibraryInfo::build()));
+    root.insert(QLatin1String("platformName"), QGuiApplication::platformName());
+    root.insert(QLatin1String("os"), os);
+    root.insert(QLatin1String("screens"), screens);
+    root.insert(QLatin1String("timing"), timing);
+    root.insert(QLatin1String("report"), QJsonArray::fromStringList(report.split(u'\n')));
+    return QJsonDocument(root).toJson();
+}
+
 QT_END_NAMESPACE
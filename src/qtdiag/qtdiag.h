@@ -4,6 +4,7 @@
 #ifndef QTDIAG_H
 #define QTDIAG_H
 
+#include <QtCore/QByteArray>
 #include <QtCore/QString>
 
 QT_BEGIN_NAMESPACE
@@ -16,7 +17,18 @@ enum QtDiagFlags {
     QtDiagRhi = 0x10
 };
 
-QString qtDiag(unsigned flags = 0);
+// Nanoseconds taken by the parts of the initialization, -1 if not done.
+struct QtDiagTimings
+{
+    qint64 application = -1; // QGuiApplication, loading the platform plugin
+    qint64 openGL = -1;
+    qint64 vulkan = -1;
+    qint64 rhi = -1;
+    qint64 total = -1; // collecting all information
+};
+
+QString qtDiag(unsigned flags = 0, QtDiagTimings *timings = nullptr);
+QByteArray qtDiagJson(unsigned flags, QtDiagTimings *timings);
 
 QT_END_NAMESPACE
 
@@ -5,14 +5,18 @@
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDir>
+#include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLibrary>
 #include <QPluginLoader>
 #include <QStringList>
+#include <QThreadPool>
 
 #include <iostream>
+#include <vector>
 
 enum PrintOption {
     PrintIID = 0x01,
@@ -23,6 +27,46 @@ enum PrintOption {
 Q_DECLARE_FLAGS(PrintOptions, PrintOption)
 Q_DECLARE_OPERATORS_FOR_FLAGS(PrintOptions)
 
+struct PluginMetaData
+{
+    QString fileName;
+    QJsonObject metaData;
+    QString errorString;
+    bool foundInDirectory = false;
+};
+
+// Reads the meta data of all plugins on the global thread pool. The plugins
+// are not loaded; QPluginLoader only scans the files for the meta data
+// section, which for large deployments is dominated by I/O and parsing.
+static void readMetaData(std::vector<PluginMetaData> &plugins)
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    for (PluginMetaData &plugin : plugins) {
+        pool->start([&plugin] {
+            QPluginLoader loader(plugin.fileName);
+            plugin.metaData = loader.metaData();
+            if (plugin.metaData.isEmpty())
+                plugin.errorString = loader.errorString();
+        });
+    }
+    pool->waitForDone();
+}
+
+static void appendPlugins(const QString &directory, std::vector<PluginMetaData> *plugins)
+{
+    QDirIterator it(directory, QDir::Files | QDir::NoDotAndDotDot,
+                    QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+    QStringList found;
+    while (it.hasNext()) {
+        const QString fileName = it.next();
+        if (QLibrary::isLibrary(fileName))
+            found.append(fileName);
+    }
+    found.sort();
+    for (const QString &fileName : std::as_const(found))
+        plugins->push_back({fileName, {}, {}, true});
+}
+
 int main(int argc, char** argv)
 {
     QCoreApplication app(argc, argv);
@@ -37,15 +81,21 @@ int main(int argc, char** argv)
                                       QStringLiteral("Print the plugin metadata in JSON format"));
     QCommandLineOption printOption(QStringList() << "p" << QStringLiteral("print"),
                                    QStringLiteral("Print detail (iid, classname, qtinfo, userdata)"), QStringLiteral("detail"));
+    QCommandLineOption recursiveOption(QStringList() << "r" << QStringLiteral("recursive"),
+                                       QStringLiteral("Scan directories given as arguments recursively for plug-ins"));
+    QCommandLineOption jsonReportOption(QStringLiteral("json-report"),
+                                        QStringLiteral("Print the meta data of all plug-ins as one JSON object keyed by file name"));
     jsonFormatOption.setDefaultValue(QStringLiteral("indented"));
     printOption.setDefaultValues(QStringList() << QStringLiteral("iid") << QStringLiteral("qtinfo") << QStringLiteral("userdata"));
 
     parser.addOption(fullJsonOption);
     parser.addOption(jsonFormatOption);
     parser.addOption(printOption);
+    parser.addOption(recursiveOption);
+    parser.addOption(jsonReportOption);
     parser.addHelpOption();
     parser.addVersionOption();
-    parser.addPositionalArgument(QStringLiteral("plugin"), QStringLiteral("Plug-in of which to read the meta data."), QStringLiteral("<plugin>"));
+    parser.addPositionalArgument(QStringLiteral("plugin"), QStringLiteral("Plug-in of which to read the meta data, or a directory with --recursive."), QStringLiteral("<plugin>"));
     parser.process(app);
 
     if (parser.positionalArguments().isEmpty())
@@ -64,7 +114,11 @@ int main(int argc, char** argv)
     if (printOptionList.contains("userdata"))
         print |= PrintUserData;
 
+    const bool recursive = parser.isSet(recursiveOption);
+    const bool jsonReport = parser.isSet(jsonReportOption);
+
     int retval = 0;
+    std::vector<PluginMetaData> plugins;
     const QStringList positionalArguments = parser.positionalArguments();
     for (const QString &plugin : positionalArguments) {
         QByteArray pluginNativeName = QFile::encodeName(QDir::toNativeSeparators(plugin));
@@ -73,17 +127,30 @@ int main(int argc, char** argv)
             retval = 1;
             continue;
         }
+        if (recursive && QFileInfo(plugin).isDir()) {
+            appendPlugins(plugin, &plugins);
+            continue;
+        }
         if (!QLibrary::isLibrary(plugin)) {
             std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": Not a plug-in." << std::endl;
             retval = 1;
             continue;
         }
+        plugins.push_back({plugin, {}, {}, false});
+    }
+    readMetaData(plugins);
 
-        QPluginLoader loader(plugin);
-        QJsonObject metaData = loader.metaData();
+    const bool printFileNames = recursive || positionalArguments.size() != 1;
+    QJsonObject report;
+    for (const PluginMetaData &plugin : plugins) {
+        QByteArray pluginNativeName = QFile::encodeName(QDir::toNativeSeparators(plugin.fileName));
+        const QJsonObject &metaData = plugin.metaData;
         if (metaData.isEmpty()) {
+            // Directories may contain other libraries than plug-ins.
+            if (plugin.foundInDirectory)
+                continue;
             std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": No plug-in meta-data found: "
-                      << qPrintable(loader.errorString()) << std::endl;
+                      << qPrintable(plugin.errorString) << std::endl;
             retval = 1;
             continue;
         }
@@ -114,7 +181,12 @@ int main(int argc, char** argv)
             continue;
         }
 
-        if (parser.positionalArguments().size() != 1)
+        if (jsonReport) {
+            report.insert(QDir::toNativeSeparators(plugin.fileName), metaData);
+            continue;
+        }
+
+        if (printFileNames)
             std::cout << pluginNativeName.constData() << ": ";
         if (fullJson) {
             std::cout << QJsonDocument(metaData).toJson(jsonFormat).constData();
@@ -140,5 +212,11 @@ int main(int argc, char** argv)
         }
     }
 
+    if (jsonReport) {
+        std::cout << QJsonDocument(report).toJson(jsonFormat).constData();
+        if (jsonFormat == QJsonDocument::Compact)
+            std::cout << std::endl;
+    }
+
     return retval;
 }
@@ -7,6 +7,7 @@
 #include <QtWidgets/QApplication>
 #include <QtGui/QBitmap>
 #include <QtGui/QPixmap>
+#include <QtGui/QPixmapCache>
 #include <QtGui/QPainter>
 #include <QtCore/QTextStream>
 #include <QtCore/QFile>
@@ -379,42 +380,46 @@ void DeviceSkin::calcRegions()
     }
 }
 
-void DeviceSkin::loadImages()
+// Transforming the skin images and computing their heuristic masks is slow
+// for large skins and used to be repeated whenever a preview was opened or
+// zoomed. The skin parameters (and thus the images) are shared between
+// previews, so the results are kept in the pixmap cache keyed by the source
+// image and the transformation.
+static QPixmap skinPixmap(const QImage &image, const QTransform &transform,
+                          Qt::ImageConversionFlags flags, bool heuristicMask)
 {
-    QImage iup = m_parameters.skinImageUp;
-    QImage idown = m_parameters.skinImageDown;
+    if (image.isNull())
+        return QPixmap();
+
+    const QString key = "deviceskin_%1_%2_%3_%4_%5_%6_%7"_L1
+            .arg(image.cacheKey())
+            .arg(transform.m11()).arg(transform.m12())
+            .arg(transform.m21()).arg(transform.m22())
+            .arg(int(flags)).arg(heuristicMask ? 1 : 0);
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap))
+        return pixmap;
 
-    QImage iclosed;
-    const bool hasClosedImage = !m_parameters.skinImageClosed.isNull();
+    pixmap = transform.isIdentity()
+            ? QPixmap::fromImage(image, flags)
+            : QPixmap::fromImage(image.transformed(transform, Qt::SmoothTransformation), flags);
+    if (heuristicMask && pixmap.mask().isNull())
+        pixmap.setMask(pixmap.createHeuristicMask());
+    QPixmapCache::insert(key, pixmap);
+    return pixmap;
+}
 
-    if (hasClosedImage)
-        iclosed =  m_parameters.skinImageClosed;
-    QImage icurs;
+void DeviceSkin::loadImages()
+{
     const bool hasCursorImage = !m_parameters.skinCursor.isNull();
-    if (hasCursorImage)
-        icurs =  m_parameters.skinCursor;
-
-    if (!transform.isIdentity()) {
-        iup = iup.transformed(transform, Qt::SmoothTransformation);
-        idown = idown.transformed(transform, Qt::SmoothTransformation);
-        if (hasClosedImage)
-            iclosed = iclosed.transformed(transform, Qt::SmoothTransformation);
-        if (hasCursorImage)
-            icurs = icurs.transformed(transform, Qt::SmoothTransformation);
-    }
+
     const Qt::ImageConversionFlags conv = Qt::ThresholdAlphaDither|Qt::AvoidDither;
-    skinImageUp = QPixmap::fromImage(iup);
-    skinImageDown = QPixmap::fromImage(idown, conv);
-    if (hasClosedImage)
-        skinImageClosed = QPixmap::fromImage(iclosed, conv);
-    if (hasCursorImage)
-        skinCursor = QPixmap::fromImage(icurs, conv);
+    skinImageUp = skinPixmap(m_parameters.skinImageUp, transform, Qt::AutoColor, true);
+    skinImageDown = skinPixmap(m_parameters.skinImageDown, transform, conv, false);
+    skinImageClosed = skinPixmap(m_parameters.skinImageClosed, transform, conv, true);
+    skinCursor = skinPixmap(m_parameters.skinCursor, transform, conv, false);
 
     setFixedSize( skinImageUp.size() );
-    if (!skinImageUp.mask())
-        skinImageUp.setMask(skinImageUp.createHeuristicMask());
-    if (!skinImageClosed.mask())
-        skinImageClosed.setMask(skinImageClosed.createHeuristicMask());
 
     QWidget* parent = parentWidget();
     parent->setMask( skinImageUp.mask() );
@@ -11,10 +11,73 @@
 #include <QtCore/QTimer>
 #include <QtWidgets/QLineEdit>
 
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#if QT_CONFIG(future)
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QPromise>
+#include <QtCore/QThreadPool>
+#endif
+
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+namespace {
+// The writing systems of the font families. Determining them takes long
+// with many installed fonts, so this is done once per process.
+struct FontFamilyIndex
+{
+    QList<QFontDatabase::WritingSystem> writingSystems; // those of all families
+    QHash<QString, QList<QFontDatabase::WritingSystem>> familyWritingSystems;
+};
+} // namespace
+
+static FontFamilyIndex createFontFamilyIndex()
+{
+    FontFamilyIndex index;
+    QSet<QFontDatabase::WritingSystem> writingSystems;
+    const QStringList families = QFontDatabase::families();
+    for (const QString &family : families) {
+        const auto familyWritingSystems = QFontDatabase::writingSystems(family);
+        for (QFontDatabase::WritingSystem ws : familyWritingSystems)
+            writingSystems.insert(ws);
+        index.familyWritingSystems.insert(family, familyWritingSystems);
+    }
+    for (int ws = QFontDatabase::Any + 1; ws < QFontDatabase::WritingSystemsCount; ++ws) {
+        if (writingSystems.contains(QFontDatabase::WritingSystem(ws)))
+            index.writingSystems.append(QFontDatabase::WritingSystem(ws));
+    }
+    return index;
+}
+
+#if QT_CONFIG(future)
+// The index is created on a worker thread when the first panel is shown
+// (the font database is thread-safe) and shared by all panels.
+static QFuture<FontFamilyIndex> fontFamilyIndex()
+{
+    static const QFuture<FontFamilyIndex> future = [] {
+        auto promise = std::make_shared<QPromise<FontFamilyIndex>>();
+        promise->start();
+        QFuture<FontFamilyIndex> result = promise->future();
+        QThreadPool::globalInstance()->start([promise] {
+            promise->addResult(createFontFamilyIndex());
+            promise->finish();
+        });
+        return result;
+    }();
+    return future;
+}
+#else
+static const FontFamilyIndex &fontFamilyIndex()
+{
+    static const FontFamilyIndex index = createFontFamilyIndex();
+    return index;
+}
+#endif
+
 FontPanel::FontPanel(QWidget *parentWidget) :
     QGroupBox(parentWidget),
     m_previewLineEdit(new QLineEdit),
@@ -30,10 +93,23 @@ FontPanel::FontPanel(QWidget *parentWidget) :
     // writing systems
     m_writingSystemComboBox->setEditable(false);
 
-    auto writingSystems = QFontDatabase::writingSystems();
-    writingSystems.push_front(QFontDatabase::Any);
-    for (QFontDatabase::WritingSystem ws : std::as_const(writingSystems))
-        m_writingSystemComboBox->addItem(QFontDatabase::writingSystemName(ws), QVariant(ws));
+    m_writingSystemComboBox->addItem(QFontDatabase::writingSystemName(QFontDatabase::Any),
+                                     QVariant(QFontDatabase::Any));
+#if QT_CONFIG(future)
+    const QFuture<FontFamilyIndex> index = fontFamilyIndex();
+    if (index.isFinished()) {
+        addWritingSystems(index.result().writingSystems);
+    } else {
+        auto *watcher = new QFutureWatcher<void>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher] {
+            addWritingSystems(fontFamilyIndex().result().writingSystems);
+            watcher->deleteLater();
+        });
+        watcher->setFuture(QFuture<void>(index));
+    }
+#else
+    addWritingSystems(fontFamilyIndex().writingSystems);
+#endif
     connect(m_writingSystemComboBox, &QComboBox::currentIndexChanged,
             this, &FontPanel::slotWritingSystemChanged);
     formLayout->addRow(tr("&Writing system"), m_writingSystemComboBox);
@@ -80,7 +156,15 @@ void FontPanel::setSelectedFont(const QFont &f)
     m_familyComboBox->setCurrentFont(f);
     if (m_familyComboBox->currentIndex() < 0) {
         // family not in writing system - find the corresponding one?
-        QList<QFontDatabase::WritingSystem> familyWritingSystems = QFontDatabase::writingSystems(f.family());
+#if QT_CONFIG(future)
+        const QFuture<FontFamilyIndex> index = fontFamilyIndex();
+        const QList<QFontDatabase::WritingSystem> familyWritingSystems = index.isFinished()
+            ? index.result().familyWritingSystems.value(f.family())
+            : QFontDatabase::writingSystems(f.family());
+#else
+        const QList<QFontDatabase::WritingSystem> familyWritingSystems =
+            fontFamilyIndex().familyWritingSystems.value(f.family());
+#endif
         if (familyWritingSystems.isEmpty())
             return;
 
@@ -156,6 +240,20 @@ void FontPanel::slotPointSizeChanged(int)
     delayedPreviewFontUpdate();
 }
 
+// Adds the writing systems after "Any", keeping the current one.
+void FontPanel::addWritingSystems(const QList<QFontDatabase::WritingSystem> &writingSystems)
+{
+    const bool blocked = m_writingSystemComboBox->blockSignals(true);
+    for (QFontDatabase::WritingSystem ws : writingSystems)
+        m_writingSystemComboBox->addItem(QFontDatabase::writingSystemName(ws), QVariant(ws));
+    // A writing system set before they were known
+    if (m_writingSystemComboBox->currentIndex() == -1) {
+        const QVariant current(m_familyComboBox->writingSystem());
+        m_writingSystemComboBox->setCurrentIndex(m_writingSystemComboBox->findData(current));
+    }
+    m_writingSystemComboBox->blockSignals(blocked);
+}
+
 void FontPanel::updateWritingSystem(QFontDatabase::WritingSystem ws)
 {
 
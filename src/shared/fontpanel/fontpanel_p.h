@@ -51,6 +51,7 @@ private:
     int pointSize() const;
     int closestPointSizeIndex(int ps) const;
 
+    void addWritingSystems(const QList<QFontDatabase::WritingSystem> &writingSystems);
     void updateWritingSystem(QFontDatabase::WritingSystem ws);
     void updateFamily(const QString &family);
     void updatePointSizes(const QString &family, const QString &style);
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qtcolorline_p.h"
+#include "qtgradientutils_p.h"
 #include "qdrawutil.h"
 
 #include <QtGui/QPainter>
@@ -630,14 +631,8 @@ void QtColorLinePrivate::paintEvent(QPaintEvent *)
     QPainter p(q_ptr);
     if (q_ptr->isEnabled()) {
         if (m_backgroundCheckered) {
-            int pixSize = 20;
-            QPixmap pm(2 * pixSize, 2 * pixSize);
-            QPainter pmp(&pm);
-            pmp.fillRect(0, 0, pixSize, pixSize, Qt::white);
-            pmp.fillRect(pixSize, pixSize, pixSize, pixSize, Qt::white);
-            pmp.fillRect(0, pixSize, pixSize, pixSize, Qt::black);
-            pmp.fillRect(pixSize, 0, pixSize, pixSize, Qt::black);
-            pmp.end();
+            const int pixSize = 20;
+            const QPixmap pm = QtGradientUtils::checkerboardPixmap(pixSize);
 
             p.setBrushOrigin((rect.width() % pixSize + pixSize) / 2, (rect.height() % pixSize + pixSize) / 2);
 
@@ -3,6 +3,7 @@
 
 #include "qtgradientstopswidget_p.h"
 #include "qtgradientstopsmodel_p.h"
+#include "qtgradientutils_p.h"
 
 #include <QtCore/QMap>
 #include <QtCore/QHash>
@@ -724,13 +725,8 @@ void QtGradientStopsWidget::paintEvent(QPaintEvent *e)
     QPainter p;
 
     if (d_ptr->m_backgroundCheckered) {
-        int pixSize = 20;
-        QPixmap pm(2 * pixSize, 2 * pixSize);
-        QPainter pmp(&pm);
-        pmp.fillRect(0, 0, pixSize, pixSize, Qt::white);
-        pmp.fillRect(pixSize, pixSize, pixSize, pixSize, Qt::white);
-        pmp.fillRect(0, pixSize, pixSize, pixSize, Qt::black);
-        pmp.fillRect(pixSize, 0, pixSize, pixSize, Qt::black);
+        const int pixSize = 20;
+        const QPixmap pm = QtGradientUtils::checkerboardPixmap(pixSize);
 
         p.begin(&pix);
         p.setBrushOrigin((size.width() % pixSize + pixSize) / 2, (size.height() % pixSize + pixSize) / 2);
@@ -6,6 +6,7 @@
 #include <QtGui/QLinearGradient>
 #include <QtGui/QRadialGradient>
 #include <QtGui/QConicalGradient>
+#include <QtGui/QPixmapCache>
 #include <QtXml/QDomDocument>
 #include <QtCore/QDebug>
 
@@ -251,14 +252,8 @@ QPixmap QtGradientUtils::gradientPixmap(const QGradient &gradient, QSize size,
     p.setCompositionMode(QPainter::CompositionMode_Source);
 
     if (checkeredBackground) {
-        int pixSize = 20;
-        QPixmap pm(2 * pixSize, 2 * pixSize);
-
-        QPainter pmp(&pm);
-        pmp.fillRect(0, 0, pixSize, pixSize, Qt::lightGray);
-        pmp.fillRect(pixSize, pixSize, pixSize, pixSize, Qt::lightGray);
-        pmp.fillRect(0, pixSize, pixSize, pixSize, Qt::darkGray);
-        pmp.fillRect(pixSize, 0, pixSize, pixSize, Qt::darkGray);
+        const int pixSize = 20;
+        const QPixmap pm = checkerboardPixmap(pixSize, Qt::lightGray, Qt::darkGray);
 
         p.setBrushOrigin((size.width() % pixSize + pixSize) / 2, (size.height() % pixSize + pixSize) / 2);
         p.fillRect(0, 0, size.width(), size.height(), pm);
@@ -276,6 +271,28 @@ QPixmap QtGradientUtils::gradientPixmap(const QGradient &gradient, QSize size,
     return QPixmap::fromImage(image);
 }
 
+// The checkered backgrounds are painted on every repaint of the gradient
+// widgets, including each mouse move while a handle is dragged, so the
+// tiles are kept in the pixmap cache.
+QPixmap QtGradientUtils::checkerboardPixmap(int squareSize, QColor light, QColor dark)
+{
+    const QString key = "qtgradienteditor_checkerboard_%1_%2_%3"_L1
+            .arg(squareSize).arg(light.rgba(), 0, 16).arg(dark.rgba(), 0, 16);
+    QPixmap pm;
+    if (QPixmapCache::find(key, &pm))
+        return pm;
+
+    pm = QPixmap(2 * squareSize, 2 * squareSize);
+    QPainter pmp(&pm);
+    pmp.fillRect(0, 0, squareSize, squareSize, light);
+    pmp.fillRect(squareSize, squareSize, squareSize, squareSize, light);
+    pmp.fillRect(0, squareSize, squareSize, squareSize, dark);
+    pmp.fillRect(squareSize, 0, squareSize, squareSize, dark);
+    pmp.end();
+    QPixmapCache::insert(key, pm);
+    return pm;
+}
+
 static QString styleSheetFillName(const QGradient &gradient)
 {
     QString result;
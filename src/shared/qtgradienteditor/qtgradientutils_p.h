@@ -32,6 +32,8 @@ public:
 
     static QPixmap gradientPixmap(const QGradient &gradient, QSize size = QSize(64, 64),
                                   bool checkeredBackground = false);
+    static QPixmap checkerboardPixmap(int squareSize, QColor light = Qt::white,
+                                      QColor dark = Qt::black);
 };
 
 QT_END_NAMESPACE
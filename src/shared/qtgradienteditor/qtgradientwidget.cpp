@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qtgradientwidget_p.h"
+#include "qtgradientutils_p.h"
 #include <QtCore/QMap>
 #include <QtGui/QImage>
 #include <QtGui/QPainter>
@@ -33,6 +34,8 @@ public:
     void setAngleConical(double angle);
 
     void paintPoint(QPainter *painter, QPointF point, double size) const;
+    QGradient gradient() const;
+    const QPixmap &backgroundPixmap();
 
     double m_handleSize;
     bool m_backgroundCheckered;
@@ -66,8 +69,71 @@ public:
     double m_dragRadius;
     double m_angleOffset;
     double m_dragAngle;
+
+    // Checkered background and gradient as last painted. Most repaints,
+    // e.g. hovering or dragging a handle onto the same spot, leave both
+    // unchanged, so they are only rendered again when the gradient, the
+    // widget size or the device pixel ratio changes.
+    QPixmap m_backgroundPixmap;
+    QGradient m_backgroundGradient;
+    bool m_backgroundPixmapCheckered = false;
 };
 
+QGradient QtGradientWidgetPrivate::gradient() const
+{
+    QGradient gradient;
+    switch (m_gradientType) {
+        case QGradient::LinearGradient:
+            gradient = QLinearGradient(m_startLinear, m_endLinear);
+            break;
+        case QGradient::RadialGradient:
+            gradient = QRadialGradient(m_centralRadial, m_radiusRadial, m_focalRadial);
+            break;
+        case QGradient::ConicalGradient:
+            gradient = QConicalGradient(m_centralConical, m_angleConical);
+            break;
+        default:
+            return gradient;
+    }
+    gradient.setStops(m_gradientStops);
+    gradient.setSpread(m_gradientSpread);
+    return gradient;
+}
+
+const QPixmap &QtGradientWidgetPrivate::backgroundPixmap()
+{
+    Q_Q(QtGradientWidget);
+    const QSize size = q->size();
+    const qreal dpr = q->devicePixelRatio();
+    const QGradient grad = gradient();
+    if (!m_backgroundPixmap.isNull() && m_backgroundPixmap.deviceIndependentSize() == size
+        && m_backgroundPixmap.devicePixelRatio() == dpr
+        && m_backgroundPixmapCheckered == m_backgroundCheckered
+        && m_backgroundGradient == grad) {
+        return m_backgroundPixmap;
+    }
+
+    m_backgroundGradient = grad;
+    m_backgroundPixmapCheckered = m_backgroundCheckered;
+    m_backgroundPixmap = QPixmap(size * dpr);
+    m_backgroundPixmap.setDevicePixelRatio(dpr);
+    m_backgroundPixmap.fill(Qt::transparent);
+
+    QPainter p(&m_backgroundPixmap);
+    if (m_backgroundCheckered) {
+        const int pixSize = 40;
+        const QPixmap pm = QtGradientUtils::checkerboardPixmap(pixSize);
+        p.setBrushOrigin((size.width() % pixSize + pixSize) / 2, (size.height() % pixSize + pixSize) / 2);
+        p.fillRect(QRect(QPoint(0, 0), size), pm);
+        p.setBrushOrigin(0, 0);
+    }
+    if (grad.type() != QGradient::NoGradient) {
+        p.scale(size.width(), size.height());
+        p.fillRect(QRect(0, 0, 1, 1), grad);
+    }
+    return m_backgroundPixmap;
+}
+
 double QtGradientWidgetPrivate::correctAngle(double angle) const
 {
     double a = angle;
@@ -446,46 +512,10 @@ void QtGradientWidget::paintEvent(QPaintEvent *e)
 
     QPainter p(this);
 
-    if (d_ptr->m_backgroundCheckered) {
-        int pixSize = 40;
-        QPixmap pm(2 * pixSize, 2 * pixSize);
-
-        QPainter pmp(&pm);
-        pmp.fillRect(0, 0, pixSize, pixSize, Qt::white);
-        pmp.fillRect(pixSize, pixSize, pixSize, pixSize, Qt::white);
-        pmp.fillRect(0, pixSize, pixSize, pixSize, Qt::black);
-        pmp.fillRect(pixSize, 0, pixSize, pixSize, Qt::black);
-
-        p.setBrushOrigin((size().width() % pixSize + pixSize) / 2, (size().height() % pixSize + pixSize) / 2);
-        p.fillRect(rect(), pm);
-        p.setBrushOrigin(0, 0);
-    }
-
-    QGradient *gradient = nullptr;
-    switch (d_ptr->m_gradientType) {
-        case QGradient::LinearGradient:
-            gradient = new QLinearGradient(d_ptr->m_startLinear, d_ptr->m_endLinear);
-            break;
-        case QGradient::RadialGradient:
-            gradient = new QRadialGradient(d_ptr->m_centralRadial, d_ptr->m_radiusRadial, d_ptr->m_focalRadial);
-            break;
-        case QGradient::ConicalGradient:
-            gradient = new QConicalGradient(d_ptr->m_centralConical, d_ptr->m_angleConical);
-            break;
-        default:
-            break;
-    }
-    if (!gradient)
+    p.drawPixmap(0, 0, d_ptr->backgroundPixmap());
+    if (d_ptr->m_backgroundGradient.type() == QGradient::NoGradient)
         return;
 
-    gradient->setStops(d_ptr->m_gradientStops);
-    gradient->setSpread(d_ptr->m_gradientSpread);
-
-    p.save();
-    p.scale(size().width(), size().height());
-    p.fillRect(QRect(0, 0, 1, 1), *gradient);
-    p.restore();
-
     p.setRenderHint(QPainter::Antialiasing);
 
     QColor c = QColor::fromRgbF(0.5, 0.5, 0.5, 0.5);
@@ -611,8 +641,6 @@ void QtGradientWidget::paintEvent(QPaintEvent *e)
         p.restore();
 
     }
-
-    delete gradient;
 }
 
 void QtGradientWidget::setGradientStops(const QGradientStops &stops)
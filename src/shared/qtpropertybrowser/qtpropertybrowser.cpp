@@ -5,6 +5,8 @@
 #include <QtCore/QHash>
 #include <QtGui/QIcon>
 
+#include <utility>
+
 #if defined(Q_CC_MSVC)
 #    pragma warning(disable: 4786) /* MS VS 6: truncating debug info after 255 characters */
 #endif
@@ -1205,6 +1207,10 @@ public:
     QList<QtBrowserItem *> m_topLevelIndexes;
     QHash<QtProperty *, QList<QtBrowserItem *> > m_propertyToIndexes;
 
+    // Properties whose data changed between beginUpdate() and endUpdate()
+    QSet<QtProperty *> m_changedProperties;
+    int m_updateDepth = 0;
+
     QtBrowserItem *m_currentItem;
 };
 
@@ -1260,6 +1266,7 @@ void QtAbstractPropertyBrowserPrivate::removeSubTree(QtProperty *property,
         return;
 
     m_propertyToParents.remove(property);
+    m_changedProperties.remove(property);
     QtAbstractPropertyManager *manager = property->propertyManager();
     m_managerToProperties[manager].removeAll(property);
     if (m_managerToProperties[manager].isEmpty()) {
@@ -1408,6 +1415,11 @@ void QtAbstractPropertyBrowserPrivate::slotPropertyDataChanged(QtProperty *prope
     if (!m_propertyToParents.contains(property))
         return;
 
+    if (m_updateDepth > 0) {
+        m_changedProperties.insert(property);
+        return;
+    }
+
     const auto it = m_propertyToIndexes.constFind(property);
     if (it == m_propertyToIndexes.constEnd())
         return;
@@ -1878,6 +1890,43 @@ void QtAbstractPropertyBrowser::unsetFactoryForManager(QtAbstractPropertyManager
     }
 }
 
+/*!
+    Starts a batch of changes to the properties shown by the browser.
+
+    Until the matching endUpdate() call, the browser does not update the
+    items of properties whose data changes. endUpdate() then updates
+    each changed item once, however often its property changed. Calls
+    can be nested.
+
+    \sa endUpdate()
+*/
+void QtAbstractPropertyBrowser::beginUpdate()
+{
+    ++d_ptr->m_updateDepth;
+}
+
+/*!
+    Ends a batch of changes started by beginUpdate(), updating the
+    items of the properties that changed in a single pass.
+
+    \sa beginUpdate()
+*/
+void QtAbstractPropertyBrowser::endUpdate()
+{
+    Q_ASSERT(d_ptr->m_updateDepth > 0);
+    if (--d_ptr->m_updateDepth > 0 || d_ptr->m_changedProperties.isEmpty())
+        return;
+
+    const QSet<QtProperty *> changedProperties = std::exchange(d_ptr->m_changedProperties, {});
+    const bool updatesWereEnabled = updatesEnabled();
+    if (updatesWereEnabled)
+        setUpdatesEnabled(false);
+    for (QtProperty *property : changedProperties)
+        d_ptr->slotPropertyDataChanged(property);
+    if (updatesWereEnabled)
+        setUpdatesEnabled(true);
+}
+
 /*!
     Returns the current item in the property browser.
 
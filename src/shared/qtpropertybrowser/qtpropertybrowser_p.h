@@ -234,6 +234,9 @@ public:
 
     void unsetFactoryForManager(QtAbstractPropertyManager *manager);
 
+    void beginUpdate();
+    void endUpdate();
+
     QtBrowserItem *currentItem() const;
     void setCurrentItem(QtBrowserItem *);
 
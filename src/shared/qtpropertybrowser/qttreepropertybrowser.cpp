@@ -5,6 +5,7 @@
 
 #include <QtCore/QOperatingSystemVersion>
 #include <QtCore/QHash>
+#include <QtCore/QSet>
 #include <QtGui/QFocusEvent>
 #include <QtGui/QIcon>
 #include <QtGui/QPainter>
@@ -71,9 +72,13 @@ public:
 
 private:
     void updateItem(QTreeWidgetItem *item);
+    void updateItemContents(QTreeWidgetItem *item);
+    void updateOutdatedChildren(QTreeWidgetItem *item);
 
     QHash<QtBrowserItem *, QTreeWidgetItem *> m_indexToItem;
     QHash<QTreeWidgetItem *, QtBrowserItem *> m_itemToIndex;
+    // Items within collapsed items whose texts and icons are not up to date
+    QSet<QTreeWidgetItem *> m_outdatedItems;
 
     QHash<QtBrowserItem *, QColor> m_indexToBackgroundColor;
 
@@ -553,6 +558,7 @@ void QtTreePropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
 
     m_indexToItem.remove(index);
     m_itemToIndex.remove(item);
+    m_outdatedItems.remove(item);
     m_indexToBackgroundColor.remove(index);
 }
 
@@ -563,7 +569,48 @@ void QtTreePropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
     updateItem(item);
 }
 
+static bool isInCollapsedItem(const QTreeWidgetItem *item)
+{
+    for (const QTreeWidgetItem *parent = item->parent(); parent; parent = parent->parent()) {
+        if (!parent->isExpanded())
+            return true;
+    }
+    return false;
+}
+
 void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
+{
+    // Value texts and icons can be expensive to create; for items that are
+    // not shown, they are only created when the items are expanded.
+    const bool visible = !isInCollapsedItem(item);
+    if (visible)
+        updateItemContents(item);
+    else
+        m_outdatedItems.insert(item);
+
+    QtProperty *property = m_itemToIndex[item]->property();
+    bool wasEnabled = item->flags() & Qt::ItemIsEnabled;
+    bool isEnabled = wasEnabled;
+    if (property->isEnabled()) {
+        QTreeWidgetItem *parent = item->parent();
+        if (!parent || (parent->flags() & Qt::ItemIsEnabled))
+            isEnabled = true;
+        else
+            isEnabled = false;
+    } else {
+        isEnabled = false;
+    }
+    if (wasEnabled != isEnabled) {
+        if (isEnabled)
+            enableItem(item);
+        else
+            disableItem(item);
+    }
+    if (visible)
+        m_treeWidget->viewport()->update();
+}
+
+void QtTreePropertyBrowserPrivate::updateItemContents(QTreeWidgetItem *item)
 {
     QtProperty *property = m_itemToIndex[item]->property();
     QIcon expandIcon;
@@ -584,24 +631,17 @@ void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
     item->setStatusTip(0, property->statusTip());
     item->setWhatsThis(0, property->whatsThis());
     item->setText(0, propertyName);
-    bool wasEnabled = item->flags() & Qt::ItemIsEnabled;
-    bool isEnabled = wasEnabled;
-    if (property->isEnabled()) {
-        QTreeWidgetItem *parent = item->parent();
-        if (!parent || (parent->flags() & Qt::ItemIsEnabled))
-            isEnabled = true;
-        else
-            isEnabled = false;
-    } else {
-        isEnabled = false;
-    }
-    if (wasEnabled != isEnabled) {
-        if (isEnabled)
-            enableItem(item);
-        else
-            disableItem(item);
+}
+
+void QtTreePropertyBrowserPrivate::updateOutdatedChildren(QTreeWidgetItem *item)
+{
+    for (int i = 0, count = item->childCount(); i < count && !m_outdatedItems.isEmpty(); ++i) {
+        QTreeWidgetItem *child = item->child(i);
+        if (m_outdatedItems.remove(child))
+            updateItemContents(child);
+        if (child->isExpanded())
+            updateOutdatedChildren(child);
     }
-    m_treeWidget->viewport()->update();
 }
 
 QColor QtTreePropertyBrowserPrivate::calculatedBackgroundColor(QtBrowserItem *item) const
@@ -629,8 +669,10 @@ void QtTreePropertyBrowserPrivate::slotExpanded(const QModelIndex &index)
 {
     QTreeWidgetItem *item = indexToItem(index);
     QtBrowserItem *idx = m_itemToIndex.value(item);
-    if (item)
+    if (item) {
+        updateOutdatedChildren(item);
         emit q_ptr->expanded(idx);
+    }
 }
 
 void QtTreePropertyBrowserPrivate::slotCurrentBrowserItemChanged(QtBrowserItem *item)
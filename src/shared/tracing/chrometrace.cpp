@@ -0,0 +1,178 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "chrometrace_p.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+struct TraceEvent
+{
+    QString name;
+    QString file;
+    int lane;
+    qint64 startNsecs;
+    qint64 durationNsecs;
+};
+
+struct Trace
+{
+    QMutex mutex;
+    QElapsedTimer timer;
+    QString toolName;
+    QString fileName;
+    QList<QString> laneNames; // Indexed by lane
+    QList<TraceEvent> events;
+};
+}
+
+static std::atomic<bool> traceEnabled = false;
+
+static Trace &trace()
+{
+    static Trace t;
+    return t;
+}
+
+static void writeAtExit()
+{
+    QString errorString;
+    if (!ChromeTrace::write(&errorString))
+        std::cerr << qPrintable(errorString) << std::endl;
+}
+
+void ChromeTrace::initialize(QLatin1StringView toolName, const QString &fileName)
+{
+    QString traceFile = fileName;
+    if (traceFile.isEmpty())
+        traceFile = qEnvironmentVariable("QT_TOOLS_TRACE");
+    if (traceFile.isEmpty() || isEnabled())
+        return;
+
+    if (QFileInfo(traceFile).isDir()) {
+        traceFile = QDir(traceFile).filePath(
+                QString(toolName) + u'-' + QString::number(QCoreApplication::applicationPid())
+                + ".json"_L1);
+    }
+
+    Trace &t = trace();
+    {
+        QMutexLocker locker(&t.mutex);
+        t.toolName = toolName;
+        t.fileName = traceFile;
+        t.timer.start();
+    }
+    traceEnabled = true;
+    // Registered after trace() was constructed, so it runs before its destruction.
+    std::atexit(writeAtExit);
+}
+
+bool ChromeTrace::isEnabled()
+{
+    return traceEnabled;
+}
+
+qint64 ChromeTrace::elapsedNsecs()
+{
+    return trace().timer.nsecsElapsed();
+}
+
+// Every thread that records a span gets a lane of its own, numbered in the
+// order in which the threads first recorded something.
+static int currentLane(Trace &t)
+{
+    static thread_local int lane = -1;
+    if (lane < 0) {
+        QThread *thread = QThread::currentThread();
+        QString name = thread->objectName();
+        if (QCoreApplication *app = QCoreApplication::instance(); app && app->thread() == thread)
+            name = u"main"_s;
+        QMutexLocker locker(&t.mutex);
+        lane = int(t.laneNames.size());
+        if (name.isEmpty())
+            name = u"thread "_s + QString::number(lane);
+        t.laneNames.append(name);
+    }
+    return lane;
+}
+
+void ChromeTrace::addSpan(const QString &name, const QString &file,
+                          qint64 startNsecs, qint64 durationNsecs)
+{
+    if (!isEnabled())
+        return;
+    Trace &t = trace();
+    const int lane = currentLane(t);
+    QMutexLocker locker(&t.mutex);
+    t.events.append({ name, file, lane, startNsecs, durationNsecs });
+}
+
+// Writes the events in the JSON object format of the Trace Event Format,
+// with timestamps in microseconds.
+bool ChromeTrace::write(QString *errorString)
+{
+    if (!isEnabled())
+        return true;
+
+    Trace &t = trace();
+    QMutexLocker locker(&t.mutex);
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray events;
+    for (qsizetype lane = 0; lane < t.laneNames.size(); ++lane) {
+        events.append(QJsonObject {
+                { u"ph"_s, u"M"_s },
+                { u"name"_s, u"thread_name"_s },
+                { u"pid"_s, pid },
+                { u"tid"_s, qint64(lane) },
+                { u"args"_s, QJsonObject { { u"name"_s, t.laneNames.at(lane) } } },
+        });
+    }
+    for (const TraceEvent &event : std::as_const(t.events)) {
+        QJsonObject object {
+            { u"ph"_s, u"X"_s },
+            { u"cat"_s, t.toolName },
+            { u"name"_s, event.name },
+            { u"pid"_s, pid },
+            { u"tid"_s, event.lane },
+            { u"ts"_s, double(event.startNsecs) / 1000 },
+            { u"dur"_s, double(event.durationNsecs) / 1000 },
+        };
+        if (!event.file.isEmpty())
+            object.insert(u"args"_s, QJsonObject { { u"file"_s, event.file } });
+        events.append(object);
+    }
+
+    QFile file(t.fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (errorString) {
+            *errorString = u"Cannot write trace file %1: %2"_s.arg(
+                    QDir::toNativeSeparators(t.fileName), file.errorString());
+        }
+        return false;
+    }
+    const QJsonObject root { { u"traceEvents"_s, events },
+                             { u"displayTimeUnit"_s, u"ms"_s } };
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,87 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists for the convenience
+// of the Qt tools. This header file may change from version to version
+// without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef CHROMETRACE_P_H
+#define CHROMETRACE_P_H
+
+#include <QtCore/QString>
+
+QT_BEGIN_NAMESPACE
+
+// Records spans of work as Chrome trace events, which chrome://tracing and
+// Perfetto show as flame charts with one lane per thread.
+//
+// Tracing is off unless the QT_TOOLS_TRACE environment variable is set, or
+// a tool passes a file name to initialize(). The value is the trace file to
+// write when the tool exits. If it names an existing directory, the trace is
+// written to <tool>-<pid>.json in it, so that tools run several times by a
+// build do not overwrite each other's traces.
+//
+// Every span uses the tool name as its category. Its name is the operation,
+// such as "extract" or "release", and the file the operation works on, if
+// any, is recorded in the "file" argument of the event. This way the traces
+// of all tools can be filtered and compared the same way.
+//
+// All functions may be called from any thread.
+class ChromeTrace
+{
+public:
+    static void initialize(QLatin1StringView toolName, const QString &fileName = QString());
+    static bool isEnabled();
+
+    static void addSpan(const QString &name, const QString &file,
+                        qint64 startNsecs, qint64 durationNsecs);
+    static qint64 elapsedNsecs();
+
+    static bool write(QString *errorString);
+
+    // Records the time until its destruction as a span.
+    class Span
+    {
+    public:
+        explicit Span(QLatin1StringView name, const QString &file = QString())
+        {
+            if (isEnabled())
+                start(name, file);
+        }
+        explicit Span(const QString &name, const QString &file = QString())
+        {
+            if (isEnabled())
+                start(name, file);
+        }
+        ~Span()
+        {
+            if (m_start >= 0)
+                addSpan(m_name, m_file, m_start, elapsedNsecs() - m_start);
+        }
+
+    private:
+        Q_DISABLE_COPY_MOVE(Span)
+
+        void start(const QString &name, const QString &file)
+        {
+            m_name = name;
+            m_file = file;
+            m_start = elapsedNsecs();
+        }
+
+        QString m_name;
+        QString m_file;
+        qint64 m_start = -1;
+    };
+};
+
+QT_END_NAMESPACE
+
+#endif // CHROMETRACE_P_H
@@ -26,11 +26,22 @@
 #include <QtGui/qaction.h>
 #include <QtGui/qactiongroup.h>
 
+#include <QtCore/qbuffer.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdatastream.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qlibraryinfo.h>
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -527,6 +538,12 @@ bool FormBuilderPrivate::addItem(DomWidget *ui_widget, QWidget *widget, QWidget
 }
 #endif
 
+#ifdef QFORMINTERNAL_NAMESPACE
+using QFormInternal::DomUI;
+using QFormInternal::QFormBuilderExtra;
+using QFormInternal::uiLibWarning;
+#endif
+
 class QUiLoaderPrivate
 {
 public:
@@ -536,9 +553,129 @@ public:
     FormBuilderPrivate builder;
 #endif
 
+    ~QUiLoaderPrivate() { clearPendingForms(); }
+
     void setupWidgetMap() const;
+    QWidget *loadCached(QIODevice *device, QWidget *parentWidget);
+    void preload(const QByteArray &data);
+    void clearPendingForms();
+
+    // A parsed form, or the error message of a form that failed to parse.
+    struct CachedForm
+    {
+        std::unique_ptr<DomUI> ui;
+        QString errorString;
+    };
+
+    static QByteArray formCacheKey(const QByteArray &data, const QString &language);
+    static CachedForm *parseForm(const QByteArray &data, const QString &language);
+
+    // The forms parsed so far, by the hash of their contents and language.
+    static constexpr qsizetype FormCacheSize = 64;
+    QCache<QByteArray, CachedForm> formCache{FormCacheSize};
+#if QT_CONFIG(future)
+    // The forms being parsed on the thread pool after preload().
+    QHash<QByteArray, QFuture<CachedForm *>> pendingForms;
+#endif
+    QString cacheErrorString;
+    bool formCacheEnabled = false;
 };
 
+// The language is part of the key since forms written for another
+// language fail to parse.
+QByteArray QUiLoaderPrivate::formCacheKey(const QByteArray &data, const QString &language)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(language.toUtf8());
+    hash.addData(QByteArrayView("\0", 1));
+    hash.addData(data);
+    return hash.result();
+}
+
+// Does not issue warnings, so that forms can be parsed on the thread pool.
+QUiLoaderPrivate::CachedForm *QUiLoaderPrivate::parseForm(const QByteArray &data,
+                                                          const QString &language)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly | QIODevice::Text);
+    auto *form = new CachedForm;
+    form->ui.reset(QFormBuilderExtra::readUi(&buffer, language, &form->errorString));
+    return form;
+}
+
+// Creating the widgets only reads the DOM of a form, so the same DOM can
+// be used for each load of the form. Forms that fail to parse are cached
+// with their error message.
+QWidget *QUiLoaderPrivate::loadCached(QIODevice *device, QWidget *parentWidget)
+{
+    cacheErrorString.clear();
+    const QByteArray data = device->readAll();
+    const QString &language = builder.d->m_language;
+    const QByteArray key = formCacheKey(data, language);
+
+    CachedForm *form = formCache.object(key);
+#if QT_CONFIG(future)
+    if (!form) {
+        const auto pending = pendingForms.constFind(key);
+        if (pending != pendingForms.cend()) {
+            form = pending->result();
+            pendingForms.erase(pending);
+            formCache.insert(key, form);
+        }
+    }
+#endif
+    if (!form) {
+        form = parseForm(data, language);
+        formCache.insert(key, form);
+    }
+
+    if (!form->ui) {
+        cacheErrorString = form->errorString;
+        uiLibWarning(cacheErrorString);
+        return nullptr;
+    }
+
+    QWidget *widget = builder.create(form->ui.get(), parentWidget);
+    if (!widget)
+        cacheErrorString = QFormBuilderExtra::msgInvalidUiFile();
+    return widget;
+}
+
+// Parses the form on the thread pool. Only the DOM is built there; the
+// widgets and property values are created by load() on the GUI thread.
+// No more forms are parsed ahead than the cache can hold.
+void QUiLoaderPrivate::preload(const QByteArray &data)
+{
+#if QT_CONFIG(future)
+    if (pendingForms.size() >= FormCacheSize)
+        return;
+    const QString language = builder.d->m_language;
+    const QByteArray key = formCacheKey(data, language);
+    if (formCache.contains(key) || pendingForms.contains(key))
+        return;
+
+    auto promise = std::make_shared<QPromise<CachedForm *>>();
+    promise->start();
+    pendingForms.insert(key, promise->future());
+    QThreadPool::globalInstance()->start([promise, data, language] {
+        promise->addResult(parseForm(data, language));
+        promise->finish();
+    });
+#else
+    Q_UNUSED(data);
+#endif
+}
+
+void QUiLoaderPrivate::clearPendingForms()
+{
+#if QT_CONFIG(future)
+    for (QFuture<CachedForm *> &pending : pendingForms)
+        delete pending.result();
+    pendingForms.clear();
+#endif
+}
+
 void QUiLoaderPrivate::setupWidgetMap() const
 {
     if (!g_widgets()->isEmpty())
@@ -656,9 +793,40 @@ QWidget *QUiLoader::load(QIODevice *device, QWidget *parentWidget)
     // QXmlStreamReader will report errors on open failure.
     if (!device->isOpen())
         device->open(QIODevice::ReadOnly|QIODevice::Text);
+    if (d->formCacheEnabled)
+        return d->loadCached(device, parentWidget);
     return d->builder.load(device, parentWidget);
 }
 
+/*!
+    \since 6.10
+
+    Reads the form from the given \a device and parses it on a thread of
+    QThreadPool::globalInstance(), while the calling thread continues.
+    A later call to load() with the same form contents only creates the
+    widgets, which has to happen on the GUI thread. If the parsing has not
+    finished by then, load() waits for it.
+
+    This allows applications to parse the forms they need while they show
+    a splash screen or create their main window.
+
+    The parsed forms are kept in the form cache. At most as many forms as
+    the cache holds are parsed ahead; further calls are ignored until
+    load() has taken some of them. This function does nothing unless the
+    cache is enabled, or if Qt was built without QFuture.
+
+    \sa setFormCacheEnabled(), load()
+*/
+void QUiLoader::preload(QIODevice *device)
+{
+    Q_D(QUiLoader);
+    if (!d->formCacheEnabled)
+        return;
+    if (!device->isOpen())
+        device->open(QIODevice::ReadOnly|QIODevice::Text);
+    d->preload(device->readAll());
+}
+
 /*!
     Returns a list naming the paths in which the loader will search when
     locating custom widget plugins.
@@ -899,6 +1067,79 @@ bool QUiLoader::isTranslationEnabled() const
     return d->builder.trEnabled;
 }
 
+/*!
+    \since 6.10
+
+    If \a enabled is true, the loader keeps the forms it has parsed, and
+    subsequent calls to load() with the same form contents create the
+    widgets without parsing the XML again. This speeds up applications
+    that load the same forms repeatedly. The cache holds up to 64 forms;
+    disabling it releases them.
+
+    The cache is disabled by default.
+
+    \sa isFormCacheEnabled(), load(), preload()
+*/
+void QUiLoader::setFormCacheEnabled(bool enabled)
+{
+    Q_D(QUiLoader);
+    d->formCacheEnabled = enabled;
+    if (!enabled) {
+        d->clearPendingForms();
+        d->formCache.clear();
+    }
+}
+
+/*!
+    \since 6.10
+
+    Returns true if the loader keeps the forms it has parsed; otherwise
+    returns false.
+
+    \sa setFormCacheEnabled()
+*/
+bool QUiLoader::isFormCacheEnabled() const
+{
+    Q_D(const QUiLoader);
+    return d->formCacheEnabled;
+}
+
+/*!
+    \since 6.10
+
+    If \a enabled is true, the icons that the loader loads from files and
+    from the icon theme are kept in a cache that is shared by all loaders.
+    Forms that use the same icons then share them instead of reading their
+    files again.
+
+    Only enable the cache if the icon files and resources do not change
+    while the application runs, since forms loaded afterwards would still
+    show the icons read before.
+
+    The cache is disabled by default.
+
+    \sa isIconCacheEnabled(), load()
+*/
+void QUiLoader::setIconCacheEnabled(bool enabled)
+{
+    Q_D(QUiLoader);
+    d->builder.setIconCacheEnabled(enabled);
+}
+
+/*!
+    \since 6.10
+
+    Returns true if the loader keeps the icons it loads in a cache;
+    otherwise returns false.
+
+    \sa setIconCacheEnabled()
+*/
+bool QUiLoader::isIconCacheEnabled() const
+{
+    Q_D(const QUiLoader);
+    return d->builder.isIconCacheEnabled();
+}
+
 /*!
     Returns a human-readable description of the last error occurred in load().
 
@@ -909,7 +1150,7 @@ bool QUiLoader::isTranslationEnabled() const
 QString QUiLoader::errorString() const
 {
     Q_D(const QUiLoader);
-    return d->builder.errorString();
+    return d->formCacheEnabled ? d->cacheErrorString : d->builder.errorString();
 }
 
 QT_END_NAMESPACE
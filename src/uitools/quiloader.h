@@ -31,6 +31,7 @@ public:
     void addPluginPath(const QString &path);
 
     QWidget *load(QIODevice *device, QWidget *parentWidget = nullptr);
+    void preload(QIODevice *device);
     QStringList availableWidgets() const;
     QStringList availableLayouts() const;
 
@@ -48,6 +49,12 @@ public:
     void setTranslationEnabled(bool enabled);
     bool isTranslationEnabled() const;
 
+    void setFormCacheEnabled(bool enabled);
+    bool isFormCacheEnabled() const;
+
+    void setIconCacheEnabled(bool enabled);
+    bool isIconCacheEnabled() const;
+
     QString errorString() const;
 
 private:
@@ -0,0 +1,109 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <chrometrace_p.h>
+
+#include <QtTest/QtTest>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+
+using namespace Qt::StringLiterals;
+
+class tst_ChromeTrace : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void writeSpans();
+
+private:
+    QString m_traceFile;
+};
+
+// The trace is written once more when the test exits, so the directory must
+// outlive the handler that initialize() registers with atexit().
+static QTemporaryDir &traceDir()
+{
+    static QTemporaryDir dir;
+    return dir;
+}
+
+void tst_ChromeTrace::initTestCase()
+{
+    QVERIFY(traceDir().isValid());
+    m_traceFile = traceDir().filePath(u"trace.json"_s);
+    ChromeTrace::initialize("tst_chrometrace"_L1, m_traceFile);
+    QVERIFY(ChromeTrace::isEnabled());
+}
+
+void tst_ChromeTrace::writeSpans()
+{
+    {
+        const ChromeTrace::Span outer("extract"_L1, u"main.cpp"_s);
+        const ChromeTrace::Span inner(u"parse"_s);
+        QThread::msleep(1);
+    }
+    QThread *worker = QThread::create([] {
+        const ChromeTrace::Span span("release"_L1, u"app_de.qm"_s);
+    });
+    worker->setObjectName(u"worker"_s);
+    worker->start();
+    QVERIFY(worker->wait());
+    delete worker;
+
+    QString errorString;
+    QVERIFY2(ChromeTrace::write(&errorString), qPrintable(errorString));
+
+    QFile file(m_traceFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+    QVERIFY(document.isObject());
+
+    QHash<QString, QJsonObject> spans;
+    QHash<qint64, QString> laneNames;
+    const QJsonArray events = document.object().value("traceEvents"_L1).toArray();
+    for (const QJsonValue &value : events) {
+        const QJsonObject event = value.toObject();
+        const QString phase = event.value("ph"_L1).toString();
+        if (phase == "M"_L1) {
+            QCOMPARE(event.value("name"_L1).toString(), u"thread_name"_s);
+            laneNames.insert(event.value("tid"_L1).toInteger(),
+                             event.value("args"_L1).toObject().value("name"_L1).toString());
+        } else {
+            QCOMPARE(phase, u"X"_s);
+            QCOMPARE(event.value("cat"_L1).toString(), u"tst_chrometrace"_s);
+            spans.insert(event.value("name"_L1).toString(), event);
+        }
+    }
+    QCOMPARE(spans.size(), 3);
+
+    const QJsonObject outer = spans.value(u"extract"_s);
+    const QJsonObject inner = spans.value(u"parse"_s);
+    const QJsonObject release = spans.value(u"release"_s);
+    QCOMPARE(outer.value("args"_L1).toObject().value("file"_L1).toString(), u"main.cpp"_s);
+    QVERIFY(!inner.contains("args"_L1));
+    QCOMPARE(release.value("args"_L1).toObject().value("file"_L1).toString(), u"app_de.qm"_s);
+
+    // Nested spans share a lane and lie within each other.
+    const double outerStart = outer.value("ts"_L1).toDouble();
+    const double innerStart = inner.value("ts"_L1).toDouble();
+    QCOMPARE(inner.value("tid"_L1), outer.value("tid"_L1));
+    QVERIFY(innerStart >= outerStart);
+    QVERIFY(innerStart + inner.value("dur"_L1).toDouble()
+            <= outerStart + outer.value("dur"_L1).toDouble());
+    QVERIFY(outer.value("dur"_L1).toDouble() >= 1000);
+
+    QCOMPARE(laneNames.value(outer.value("tid"_L1).toInteger()), u"main"_s);
+    QCOMPARE(laneNames.value(release.value("tid"_L1).toInteger()), u"worker"_s);
+}
+
+QTEST_GUILESS_MAIN(tst_ChromeTrace)
+#include "tst_chrometrace.moc"
@@ -4,8 +4,28 @@
 #include <QtTest/QtTest>
 
 #include <QtHelp/QHelpEngineCore>
+#include <QtQmlLS/private/qqmllshelpplugininterface_p.h>
 #include <QtQmlLS/private/qqmllshelputils_p.h>
 
+#include <thread>
+
+using namespace Qt::StringLiterals;
+
+static QQmlLSHelpPluginInterface *helpPlugin()
+{
+    const QStringList libraryPaths = QCoreApplication::libraryPaths();
+    for (const QString &libraryPath : libraryPaths) {
+        const QDir dir(libraryPath + "/help"_L1);
+        const QStringList fileNames = dir.entryList({ u"*helpplugin*"_s }, QDir::Files);
+        for (const QString &fileName : fileNames) {
+            QPluginLoader loader(dir.filePath(fileName));
+            if (auto plugin = qobject_cast<QQmlLSHelpPluginInterface *>(loader.instance()))
+                return plugin;
+        }
+    }
+    return nullptr;
+}
+
 // TODO (Qt 7.0)
 // Remove this test as well as the plugin from QtTools when the QtHelp lib
 // is split into QtHelpCore and QtHelp. Then QmlLS can depend only on QtHelpCore.
@@ -16,6 +36,8 @@ private slots:
     void initTestCase();
     void documentationForItem_data();
     void documentationForItem();
+    void providerLookups();
+    void lookupsFromOtherThreads();
 
 private:
     HelpManager helpManager;
@@ -83,5 +105,94 @@ void tst_HelpEnginePlugin::documentationForItem()
     QCOMPARE(actual.value(), expectedDocumentation);
 }
 
+void tst_HelpEnginePlugin::providerLookups()
+{
+    QQmlLSHelpPluginInterface *plugin = helpPlugin();
+    if (!plugin)
+        QSKIP("The help engine plugin is not available.");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto provider = plugin->initialize(dir.filePath(u"collection.qhc"_s), nullptr);
+    QVERIFY(provider);
+
+    // Not registered yet; the empty result is cached too.
+    QVERIFY(provider->documentsForIdentifier(u"QML.Timer"_s).empty());
+
+    // Registering must drop the cached lookups.
+    QVERIFY(provider->registerDocumentation(QStringLiteral(DATADIR) + "/qtqml.qch"_L1));
+    const auto links = provider->documentsForIdentifier(u"QML.Timer"_s);
+    QCOMPARE(links.size(), size_t(1));
+    QVERIFY(links.front().url.path().endsWith("/qml-qtqml-timer.html"_L1));
+
+    const auto cachedLinks = provider->documentsForIdentifier(u"QML.Timer"_s);
+    QCOMPARE(cachedLinks.size(), links.size());
+    QCOMPARE(cachedLinks.front().url, links.front().url);
+    QCOMPARE(cachedLinks.front().title, links.front().title);
+
+    // The filtered overload is cached separately from the unfiltered one.
+    QCOMPARE(provider->documentsForIdentifier(u"QML.Timer"_s, QString()).size(), links.size());
+    QVERIFY(provider->documentsForIdentifier(u"QML.NoSuchType"_s).empty());
+
+    const QByteArray page = provider->fileData(links.front().url);
+    QVERIFY(page.contains("Timer"));
+    QCOMPARE(provider->fileData(links.front().url), page);
+}
+
+void tst_HelpEnginePlugin::lookupsFromOtherThreads()
+{
+    QQmlLSHelpPluginInterface *plugin = helpPlugin();
+    if (!plugin)
+        QSKIP("The help engine plugin is not available.");
+
+    // Engines must be closed on the thread that opened them.
+    QTest::failOnWarning(QRegularExpression(u"QSqlDatabase"_s));
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    auto provider = plugin->initialize(dir.filePath(u"collection.qhc"_s), nullptr);
+    QVERIFY(provider);
+    QVERIFY(provider->registerDocumentation(QStringLiteral(DATADIR) + "/qtqml.qch"_L1));
+    const auto links = provider->documentsForIdentifier(u"QML.Timer"_s);
+    QCOMPARE(links.size(), size_t(1));
+    const QUrl timerPage = links.front().url;
+
+    // Each thread asks for something not cached yet, so it needs an engine.
+    QUrl qthreadPage;
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        const auto links = provider->documentsForIdentifier(u"QML.QtQml.Timer"_s);
+        if (links.size() == 1)
+            qthreadPage = links.front().url;
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QCOMPARE(qthreadPage, timerPage);
+
+    // Threads not started by QThread never emit finished().
+    QUrl adoptedPage;
+    std::thread adopted([&] {
+        const auto links = provider->documentsForIdentifier(u"Timer::interval"_s);
+        if (links.size() == 1)
+            adoptedPage = links.front().url;
+    });
+    adopted.join();
+    QCOMPARE(adoptedPage.path(), timerPage.path());
+    QCOMPARE(adoptedPage.fragment(), u"interval-prop"_s);
+
+    // A thread outliving the provider closes its engine when it exits.
+    QSemaphore looked, destroyed;
+    QByteArray page;
+    std::thread lingering([&] {
+        page = provider->fileData(timerPage);
+        looked.release();
+        destroyed.acquire();
+    });
+    looked.acquire();
+    provider.reset();
+    destroyed.release();
+    lingering.join();
+    QVERIFY(page.contains("Timer"));
+}
+
 QTEST_MAIN(tst_HelpEnginePlugin)
 #include "tst_helpengineplugin.moc"
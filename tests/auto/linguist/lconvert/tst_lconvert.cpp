@@ -5,6 +5,8 @@
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
 
+#include <tuple>
+
 using namespace Qt::Literals::StringLiterals;
 
 class tst_lconvert : public QObject
@@ -27,6 +29,8 @@ private slots:
     void chains_data();
     void chains();
     void merge();
+    void batch();
+    void translationMemory();
 
 private:
     void doWait(QProcess *cvt, int stage);
@@ -369,6 +373,132 @@ void tst_lconvert::merge()
         doCompare(&cvt, dataDir + "idxmerge.ts.out");
 }
 
+void tst_lconvert::batch()
+{
+    QTemporaryDir outDir;
+    QVERIFY(outDir.isValid());
+    const QString batchFileName = outDir.filePath(u"conversions.txt"_s);
+    QFile batchFile(batchFileName);
+    QVERIFY(batchFile.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream out(&batchFile);
+    out << "# Converted in parallel\n"
+        << "\"" << dataDir << "test-escapes.po\" -of po -o \"" << outDir.path()
+        << "/escapes.po\"\n\n"
+        << "-i \"" << dataDir << "test-slurp.po\" -of po -o \"" << outDir.path()
+        << "/slurp.po\"\n";
+    out.flush();
+    batchFile.close();
+
+    QProcess cvt;
+    cvt.start(lconvert, { u"-batch"_s, batchFileName });
+    doWait(&cvt, 1);
+    if (QTest::currentTestFailed())
+        return;
+
+    QFile escapes(outDir.filePath(u"escapes.po"_s));
+    QVERIFY(escapes.open(QIODevice::ReadOnly | QIODevice::Text));
+    doCompare(&escapes, dataDir + "test-escapes.po.out");
+    QFile slurp(outDir.filePath(u"slurp.po"_s));
+    QVERIFY(slurp.open(QIODevice::ReadOnly | QIODevice::Text));
+    doCompare(&slurp, dataDir + "test-slurp.po.out");
+}
+
+static bool writeTsFile(const QString &fileName, const QString &language)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+    QTextStream out(&file);
+    out << R"(<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language=")" << language << R"(">
+<context>
+    <name>Dialog</name>
+    <message>
+        <source>Open the file</source>
+        <translation>Translation of "Open the file"</translation>
+    </message>
+    <message>
+        <source>Close the file</source>
+        <translation>Translation of "Close the file"</translation>
+    </message>
+    <message>
+        <source>Not translated yet</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
+</TS>
+)";
+    return true;
+}
+
+void tst_lconvert::translationMemory()
+{
+    QTemporaryDir outDir;
+    QVERIFY(outDir.isValid());
+    const QString deFile = outDir.filePath(u"de.ts"_s);
+    const QString frFile = outDir.filePath(u"fr.ts"_s);
+    QVERIFY(writeTsFile(deFile, u"de"_s));
+    QVERIFY(writeTsFile(frFile, u"fr"_s));
+    const QString tmFile = outDir.filePath(u"memory.qtm"_s);
+
+    const auto update = [&](const QString &tsFile, int stage) {
+        QProcess cvt;
+        cvt.start(lconvert, { u"-verbose"_s, u"-update-translation-memory"_s, tmFile, tsFile });
+        doWait(&cvt, stage);
+        // No output file is written without -o.
+        return std::pair(cvt.readAllStandardOutput(), QString::fromUtf8(cvt.readAllStandardError()));
+    };
+
+    // Only the finished translations are added, each one once per language.
+    auto [output, errors] = update(deFile, 1);
+    QVERIFY(!QTest::currentTestFailed());
+    QVERIFY(output.isEmpty());
+    QVERIFY2(errors.contains(u"Added 2 translation(s)"_s), qPrintable(errors));
+    std::tie(output, errors) = update(deFile, 2);
+    QVERIFY(!QTest::currentTestFailed());
+    QVERIFY2(errors.contains(u"Added 0 translation(s)"_s), qPrintable(errors));
+    std::tie(output, errors) = update(frFile, 3);
+    QVERIFY(!QTest::currentTestFailed());
+    QVERIFY2(errors.contains(u"Added 2 translation(s)"_s), qPrintable(errors));
+
+    // The header, and the offset of the index at the end, which has to lie
+    // between the header and itself.
+    QFile tm(tmFile);
+    QVERIFY(tm.open(QIODevice::ReadWrite));
+    const QByteArray contents = tm.readAll();
+    QVERIFY(contents.size() > 16);
+    QCOMPARE(contents.first(8), QByteArray("QtTM\0\0\0\1", 8));
+    QDataStream stream(contents.last(8));
+    quint64 indexOffset = 0;
+    stream >> indexOffset;
+    QVERIFY(indexOffset >= 8);
+    QVERIFY(indexOffset < quint64(contents.size() - 8));
+
+    // Translation memories with a broken index are rejected and not
+    // overwritten.
+    QVERIFY(tm.seek(contents.size() - 8));
+    QDataStream out(&tm);
+    out << quint64(contents.size());
+    tm.close();
+    QProcess cvt;
+    cvt.start(lconvert, { u"-update-translation-memory"_s, tmFile, deFile });
+    QVERIFY(cvt.waitForFinished(3000));
+    QCOMPARE(cvt.exitCode(), 3);
+    errors = QString::fromUtf8(cvt.readAllStandardError());
+    QVERIFY2(errors.contains(u"is corrupt"_s), qPrintable(errors));
+    QCOMPARE(QFileInfo(tmFile).size(), qint64(contents.size()));
+
+    // Neither are files of other formats.
+    QVERIFY(QFile::remove(tmFile));
+    QVERIFY(QFile::copy(deFile, tmFile));
+    cvt.start(lconvert, { u"-update-translation-memory"_s, tmFile, deFile });
+    QVERIFY(cvt.waitForFinished(3000));
+    QCOMPARE(cvt.exitCode(), 3);
+    errors = QString::fromUtf8(cvt.readAllStandardError());
+    QVERIFY2(errors.contains(u"is not a translation memory"_s), qPrintable(errors));
+}
+
 QTEST_APPLESS_MAIN(tst_lconvert)
 
 #include "tst_lconvert.moc"
@@ -0,0 +1,118 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "messagemodel.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTranslator>
+
+#include <QtTest/QtTest>
+
+class tst_MessageModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void releaseSnapshot();
+    void writeQm_data();
+    void writeQm();
+    void writeQmError();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_tsFile;
+};
+
+void tst_MessageModel::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_tsFile = m_dir.filePath("test_de.ts");
+    QFile ts(m_tsFile);
+    QVERIFY(ts.open(QIODevice::WriteOnly));
+    ts.write(R"(<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="de_DE">
+<context>
+    <name>Context</name>
+    <message>
+        <source>Hello</source>
+        <translation>Hallo</translation>
+    </message>
+    <message>
+        <source>World</source>
+        <translation type="unfinished">Welt</translation>
+    </message>
+</context>
+</TS>
+)");
+}
+
+void tst_MessageModel::releaseSnapshot()
+{
+    DataModel model;
+    bool langGuessed = false;
+    QVERIFY(model.load(m_tsFile, &langGuessed, nullptr));
+
+    const Translator tor = model.releaseSnapshot();
+    QCOMPARE(tor.languageCode(), QLocale(QLocale::German, QLocale::Germany).name());
+    QCOMPARE(tor.messageCount(), 2);
+    QCOMPARE(tor.message(0).sourceText(), QString("Hello"));
+    QCOMPARE(tor.message(0).translation(), QString("Hallo"));
+    QCOMPARE(tor.message(1).type(), TranslatorMessage::Unfinished);
+
+    // The snapshot is a copy, the model can change in the meantime.
+    MessageItem *item = model.findMessage("Context", "Hello", QString());
+    QVERIFY(item);
+    item->setTranslation("Servus");
+    QCOMPARE(tor.message(0).translation(), QString("Hallo"));
+}
+
+void tst_MessageModel::writeQm_data()
+{
+    QTest::addColumn<bool>("ignoreUnfinished");
+    QTest::addColumn<QString>("world");
+
+    QTest::newRow("all") << false << QString("Welt");
+    QTest::newRow("ignore-unfinished") << true << QString();
+}
+
+void tst_MessageModel::writeQm()
+{
+    QFETCH(bool, ignoreUnfinished);
+    QFETCH(QString, world);
+
+    DataModel model;
+    bool langGuessed = false;
+    QVERIFY(model.load(m_tsFile, &langGuessed, nullptr));
+
+    const QString qmFile = m_dir.filePath(QTest::currentDataTag() + QString(".qm"));
+    QString errors;
+    QVERIFY(DataModel::writeQm(model.releaseSnapshot(), qmFile, false, ignoreUnfinished,
+                               SaveEverything, &errors));
+    QVERIFY2(errors.isEmpty(), qPrintable(errors));
+
+    QTranslator translator;
+    QVERIFY(translator.load(qmFile));
+    QCOMPARE(translator.translate("Context", "Hello"), QString("Hallo"));
+    QCOMPARE(translator.translate("Context", "World"), world);
+}
+
+void tst_MessageModel::writeQmError()
+{
+    DataModel model;
+    bool langGuessed = false;
+    QVERIFY(model.load(m_tsFile, &langGuessed, nullptr));
+
+    const QString qmFile = m_dir.filePath("missing/test_de.qm");
+    QString errors;
+    QVERIFY(!DataModel::writeQm(model.releaseSnapshot(), qmFile, false, false,
+                                SaveEverything, &errors));
+    QVERIFY(errors.contains(qmFile));
+    QVERIFY(!QFile::exists(qmFile));
+}
+
+QTEST_MAIN(tst_MessageModel)
+#include "tst_messagemodel.moc"
@@ -8,7 +8,12 @@
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlQuery>
 
+#include <QtCore/QVersionNumber>
+
 #include <QtHelp/QHelpEngineCore>
+#include <QtHelp/QHelpFilterData>
+#include <QtHelp/QHelpFilterEngine>
+#include <QtHelp/QHelpLink>
 
 class tst_QHelpEngineCore : public QObject
 {
@@ -18,13 +23,19 @@ private slots:
     void init();
 
     void setupData();
+    void journalMode();
+    void requestSetupData();
     void collectionFile();
     void setCollectionFile();
     void copyCollectionFile();
 
     void namespaceName();
     void registeredDocumentations();
+    void filterEngineResults();
+    void filterNullVersions();
+    void batchedDocuments();
     void registerDocumentation();
+    void registerDocumentations();
     void unregisterDocumentation();
     void documentationFileName();
 
@@ -74,6 +85,55 @@ void tst_QHelpEngineCore::setupData()
     QCOMPARE(help.setupData(), true);
 }
 
+void tst_QHelpEngineCore::journalMode()
+{
+    const auto journalMode = [this] {
+        QString mode;
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "journaldb");
+            db.setDatabaseName(m_colFile);
+            if (db.open()) {
+                QSqlQuery query(db);
+                if (query.exec("PRAGMA journal_mode") && query.next())
+                    mode = query.value(0).toString();
+            }
+        }
+        QSqlDatabase::removeDatabase("journaldb");
+        return mode;
+    };
+
+    {
+        QHelpEngineCore help(m_colFile, 0);
+        help.setReadOnly(false);
+        QCOMPARE(help.setupData(), true);
+        QCOMPARE(journalMode(), QString("wal"));
+    }
+
+    // The rollback journal is restored once the collection is closed.
+    QCOMPARE(journalMode(), QString("delete"));
+    QVERIFY(!QFile::exists(m_colFile + "-wal"));
+    QVERIFY(!QFile::exists(m_colFile + "-shm"));
+}
+
+void tst_QHelpEngineCore::requestSetupData()
+{
+#if QT_CONFIG(future)
+    QHelpEngineCore help(m_colFile, 0);
+    help.setReadOnly(false);
+    QSignalSpy startedSpy(&help, &QHelpEngineCore::setupStarted);
+    QSignalSpy finishedSpy(&help, &QHelpEngineCore::setupFinished);
+
+    QFuture<bool> future = help.requestSetupData();
+    QTRY_VERIFY(future.isFinished());
+    QCOMPARE(future.result(), true);
+    QCOMPARE(startedSpy.size(), 1);
+    QCOMPARE(finishedSpy.size(), 1);
+    QCOMPARE(help.registeredDocumentations().size(), 3);
+#else
+    QSKIP("QtHelp was built without QFuture support");
+#endif
+}
+
 void tst_QHelpEngineCore::collectionFile()
 {
     QHelpEngineCore help(m_colFile, 0);
@@ -173,6 +233,161 @@ void tst_QHelpEngineCore::registeredDocumentations()
     QCOMPARE(lst.isEmpty(), true);
 }
 
+void tst_QHelpEngineCore::filterEngineResults()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    help.setReadOnly(false);
+    QCOMPARE(help.setupData(), true);
+    QHelpFilterEngine *filterEngine = help.filterEngine();
+
+    QStringList namespaces = filterEngine->namespacesForFilter(QString());
+    QStringList docs = help.registeredDocumentations();
+    namespaces.sort();
+    docs.sort();
+    QCOMPARE(namespaces, docs);
+    const QStringList allIndices = filterEngine->indices(QString());
+    QVERIFY(!allIndices.isEmpty());
+    QVERIFY(filterEngine->namespacesForFilter("Unknown").isEmpty());
+    QVERIFY(filterEngine->indices("Unknown").isEmpty());
+
+    QHelpFilterData filterData;
+    filterData.setVersions({ QVersionNumber(99, 99) });
+    QVERIFY(filterEngine->setFilterData("Future", filterData));
+    QVERIFY(filterEngine->namespacesForFilter("Future").isEmpty());
+    QVERIFY(filterEngine->indices("Future").isEmpty());
+
+    // Changing the filter has to be reflected in the results kept for it.
+    QVERIFY(filterEngine->setFilterData("Future", QHelpFilterData()));
+    QCOMPARE(filterEngine->namespacesForFilter("Future").size(), docs.size());
+    QCOMPARE(filterEngine->indices("Future"), allIndices);
+
+    QVERIFY(filterEngine->removeFilter("Future"));
+    QVERIFY(filterEngine->indices("Future").isEmpty());
+}
+
+void tst_QHelpEngineCore::filterNullVersions()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    help.setReadOnly(false);
+    QCOMPARE(help.setupData(), true);
+    QHelpFilterEngine *filterEngine = help.filterEngine();
+    const QStringList docs = help.registeredDocumentations();
+    QVERIFY(!docs.isEmpty());
+
+    const auto setDocumentationVersions = [this](const QVariant &version) {
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "versiondb");
+            db.setDatabaseName(m_colFile);
+            QVERIFY(db.open());
+            QSqlQuery query(db);
+            QVERIFY(query.prepare("UPDATE VersionTable SET Version = ?"));
+            query.addBindValue(version);
+            QVERIFY(query.exec());
+        }
+        QSqlDatabase::removeDatabase("versiondb");
+    };
+
+    // A filter for documentation without a version stores a NULL version,
+    // which does not match an empty one.
+    QHelpFilterData filterData;
+    filterData.setVersions({ QVersionNumber() });
+    setDocumentationVersions(QString(""));
+    QVERIFY(filterEngine->setFilterData("NoVersion", filterData));
+    QVERIFY(filterEngine->namespacesForFilter("NoVersion").isEmpty());
+
+    setDocumentationVersions(QVariant(QMetaType::fromType<QString>()));
+    QVERIFY(filterEngine->setFilterData("NoVersion", filterData));
+    QCOMPARE(filterEngine->namespacesForFilter("NoVersion").size(), docs.size());
+}
+
+// Looks up the documents for one value of an index field with a query of
+// its own, as QHelpEngineCore did before it batched the lookups.
+static QList<QHelpLink> unbatchedDocuments(const QString &collectionFile,
+                                          const QString &fieldName, const QString &fieldValue)
+{
+    QList<QHelpLink> links;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "unbatched");
+        db.setDatabaseName(collectionFile);
+        if (!db.open())
+            return links;
+        QSqlQuery query(db);
+        query.prepare(QString("SELECT FileNameTable.Title, NamespaceTable.Name, "
+                              "FolderTable.Name, FileNameTable.Name, IndexTable.Anchor "
+                              "FROM IndexTable, FileNameTable, FolderTable, NamespaceTable "
+                              "WHERE IndexTable.FileId = FileNameTable.FileId "
+                              "AND FileNameTable.FolderId = FolderTable.Id "
+                              "AND IndexTable.NamespaceId = NamespaceTable.Id "
+                              "AND IndexTable.%1 = ? "
+                              "ORDER BY LOWER(FileNameTable.Title), FileNameTable.Title")
+                              .arg(fieldName));
+        query.addBindValue(fieldValue);
+        query.exec();
+        while (query.next()) {
+            QString title = query.value(0).toString();
+            if (title.isEmpty())
+                title = fieldValue + " : " + query.value(3).toString();
+            QUrl url;
+            url.setScheme("qthelp");
+            url.setAuthority(query.value(1).toString());
+            url.setPath('/' + query.value(2).toString() + '/' + query.value(3).toString());
+            url.setFragment(query.value(4).toString());
+            links.append(QHelpLink { url, title });
+        }
+    }
+    QSqlDatabase::removeDatabase("unbatched");
+    return links;
+}
+
+static void compareDocuments(const QList<QHelpLink> &actual, const QList<QHelpLink> &expected)
+{
+    QCOMPARE(actual.size(), expected.size());
+    for (qsizetype i = 0; i < expected.size(); ++i) {
+        QCOMPARE(actual.at(i).url, expected.at(i).url);
+        QCOMPARE(actual.at(i).title, expected.at(i).title);
+    }
+}
+
+void tst_QHelpEngineCore::batchedDocuments()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    help.setReadOnly(false);
+    help.setUsesFilterEngine(true);
+    QCOMPARE(help.setupData(), true);
+
+    // More values than fit into one query, with duplicates and values
+    // without documents in between.
+    QStringList ids = { "Test::foo", "Test::bar", "Unknown::id", "Test::foo" };
+    for (int i = 0; i < 600; ++i)
+        ids.append(QString("Unknown::id%1").arg(i));
+    ids += { "People::einstein", "Cars::newton", "Fancy::foobar" };
+
+    for (int pass = 0; pass < 2; ++pass) { // the second pass uses the cached results
+        const auto documents = help.documentsForIdentifiers(ids, QString());
+        QVERIFY(documents.contains("Test::foo"));
+        QVERIFY(documents.contains("Fancy::foobar"));
+        QVERIFY(!documents.contains("Unknown::id"));
+        for (const QString &id : std::as_const(ids)) {
+            const QList<QHelpLink> expected = unbatchedDocuments(m_colFile, "Identifier", id);
+            QCOMPARE(documents.contains(id), !expected.isEmpty());
+            compareDocuments(documents.value(id), expected);
+            if (QTest::currentTestFailed())
+                return;
+        }
+    }
+
+    const QStringList keywords = { "foo", "einstein", "newton", "nothing" };
+    const auto keywordDocuments = help.documentsForKeywords(keywords, QString());
+    QVERIFY(!keywordDocuments.value("foo").isEmpty());
+    for (const QString &keyword : keywords) {
+        compareDocuments(keywordDocuments.value(keyword),
+                         unbatchedDocuments(m_colFile, "Name", keyword));
+        if (QTest::currentTestFailed())
+            return;
+    }
+    QVERIFY(help.documentsForIdentifiers({}, QString()).isEmpty());
+}
+
 void tst_QHelpEngineCore::registerDocumentation()
 {
     if (QFile::exists(m_colFile))
@@ -208,6 +423,31 @@ void tst_QHelpEngineCore::registerDocumentation()
     QSqlDatabase::removeDatabase("testdb");
 }
 
+void tst_QHelpEngineCore::registerDocumentations()
+{
+    if (QFile::exists(m_colFile))
+        QDir::current().remove(m_colFile);
+
+    QHelpEngineCore c(m_colFile);
+    c.setReadOnly(false);
+    QCOMPARE(c.setupData(), true);
+    const QStringList files = { m_path + "/data/qmake-3.3.8.qch",
+                                m_path + "/data/nonexisting.qch",
+                                m_path + "/data/linguist-3.3.8.qch" };
+    QSignalSpy warningSpy(&c, &QHelpEngineCore::warning);
+    QCOMPARE(c.registerDocumentations(files), QStringList({ files.at(0), files.at(2) }));
+    QCOMPARE(warningSpy.size(), 1);
+    QVERIFY(warningSpy.at(0).at(0).toString().contains(files.at(1)));
+    QCOMPARE(c.registeredDocumentations().size(), 2);
+    QVERIFY(c.registeredDocumentations().contains("trolltech.com.3-3-8.linguist"));
+
+    // Files that are already registered are skipped, the others are added.
+    QCOMPARE(c.registerDocumentations({ files.at(0), m_path + "/data/qmake-4.3.0.qch" }),
+             QStringList(m_path + "/data/qmake-4.3.0.qch"));
+    QCOMPARE(warningSpy.size(), 2);
+    QCOMPARE(c.registeredDocumentations().size(), 3);
+}
+
 void tst_QHelpEngineCore::unregisterDocumentation()
 {
     QHelpEngineCore c(m_colFile);
@@ -18,6 +18,7 @@ private slots:
     void generateHelp();
     // Check that two runs of the generator creates the same file twice
     void generateTwice();
+    void generateIncrementally();
 
 private:
     void checkNamespace();
@@ -196,5 +197,89 @@ void tst_QHelpGenerator::generateTwice()
     QCOMPARE(arr1, arr2);
 }
 
+// Returns the uncompressed data of each file in the help file \a fileName.
+static QMap<QString, QByteArray> fileContents(const QString &fileName)
+{
+    QMap<QString, QByteArray> contents;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "contentsdb");
+        db.setDatabaseName(fileName);
+        if (db.open()) {
+            QSqlQuery query(db);
+            query.exec("SELECT a.Name, b.Data FROM FileNameTable a, FileDataTable b "
+                       "WHERE a.FileId=b.Id");
+            while (query.next())
+                contents.insert(query.value(0).toString(), qUncompress(query.value(1).toByteArray()));
+        }
+    }
+    QSqlDatabase::removeDatabase("contentsdb");
+    return contents;
+}
+
+void tst_QHelpGenerator::generateIncrementally()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QDir source(QLatin1String(SRCDIR) + "/data");
+    QVERIFY(QDir(dir.path()).mkdir("sub"));
+    for (const QString &fileName : { "test.qhp", "classic.css", "cars.html", "fancy.html",
+                                     "people.html", "test.html", "sub/about.html" }) {
+        QVERIFY(QFile::copy(source.filePath(fileName), dir.filePath(fileName)));
+        QFile::setPermissions(dir.filePath(fileName), QFile::WriteUser | QFile::ReadUser);
+    }
+    const QString outputFile = dir.filePath("test.qch");
+    const QString previousFile = outputFile + ".previous";
+
+    QHelpProjectData data;
+    QVERIFY(data.readData(dir.filePath("test.qhp")));
+    {
+        HelpGenerator generator(true);
+        QVERIFY(generator.generate(&data, outputFile));
+    }
+    const QMap<QString, QByteArray> contents = fileContents(outputFile);
+    QVERIFY(contents.contains("people.html"));
+
+    // Nothing changed; all files are taken from the previous file.
+    {
+        HelpGenerator generator(true);
+        generator.setIncremental(true);
+        QVERIFY(generator.generate(&data, outputFile));
+    }
+    QVERIFY(!QFile::exists(previousFile));
+    QCOMPARE(fileContents(outputFile), contents);
+
+    // A changed file must not be taken from the previous file.
+    QFile people(dir.filePath("people.html"));
+    QVERIFY(people.open(QIODevice::Append));
+    people.write("<!-- changed -->\n");
+    people.close();
+    QHelpProjectData changedData;
+    QVERIFY(changedData.readData(dir.filePath("test.qhp")));
+    {
+        HelpGenerator generator(true);
+        generator.setIncremental(true);
+        QVERIFY(generator.generate(&changedData, outputFile));
+    }
+    QVERIFY(!QFile::exists(previousFile));
+    const QMap<QString, QByteArray> changedContents = fileContents(outputFile);
+    QVERIFY(people.open(QIODevice::ReadOnly));
+    QCOMPARE(changedContents.value("people.html"), people.readAll());
+    QCOMPARE(changedContents.value("cars.html"), contents.value("cars.html"));
+
+    // An output file that cannot be read is replaced, and removed as well.
+    QVERIFY(QFile::remove(outputFile));
+    QFile garbage(outputFile);
+    QVERIFY(garbage.open(QIODevice::WriteOnly));
+    garbage.write("This is not a help file.");
+    garbage.close();
+    {
+        HelpGenerator generator(true);
+        generator.setIncremental(true);
+        QVERIFY(generator.generate(&changedData, outputFile));
+    }
+    QVERIFY(!QFile::exists(previousFile));
+    QCOMPARE(fileContents(outputFile), changedContents);
+}
+
 QTEST_MAIN(tst_QHelpGenerator)
 #include "tst_qhelpgenerator.moc"
@@ -18,6 +18,7 @@ private slots:
     void virtualFolder();
     void customFilters();
     void filterSections();
+    void serializedContents();
     void metaData();
     void rootPath();
 
@@ -128,6 +129,41 @@ void tst_QHelpProjectData::filterSections()
     }
 }
 
+static void writeTree(QDataStream &s, QHelpDataContentItem *item, int depth)
+{
+    s << depth << item->reference() << item->title();
+    for (QHelpDataContentItem *child : item->children())
+        writeTree(s, child, depth + 1);
+}
+
+void tst_QHelpProjectData::serializedContents()
+{
+    QHelpProjectData treeData;
+    if (!treeData.readData(m_inputFile))
+        QFAIL("Cannot read qhp file!");
+    QHelpProjectData serializedData;
+    if (!serializedData.readData(m_inputFile, QHelpProjectData::SerializedContents))
+        QFAIL("Cannot read qhp file!");
+
+    const QList<QHelpDataFilterSection> treeSections = treeData.filterSections();
+    const QList<QHelpDataFilterSection> serializedSections = serializedData.filterSections();
+    QCOMPARE(serializedSections.size(), treeSections.size());
+
+    for (qsizetype i = 0; i < treeSections.size(); ++i) {
+        const QHelpDataFilterSection &serialized = serializedSections.at(i);
+        QVERIFY(serialized.contents().isEmpty());
+        QVERIFY(serialized.indices() == treeSections.at(i).indices());
+        QCOMPARE(serialized.files(), treeSections.at(i).files());
+
+        QByteArray expected;
+        QDataStream s(&expected, QIODevice::WriteOnly);
+        for (QHelpDataContentItem *item : treeSections.at(i).contents())
+            writeTree(s, item, 0);
+        QVERIFY(!expected.isEmpty());
+        QCOMPARE(serialized.serializedContents(), expected);
+    }
+}
+
 void tst_QHelpProjectData::metaData()
 {
     QHelpProjectData data;
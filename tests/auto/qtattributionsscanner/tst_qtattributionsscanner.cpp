@@ -5,9 +5,13 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qbytearray.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qprocess.h>
+#include <QtCore/qtemporarydir.h>
 
 #include <QtTest/qtest.h>
 
@@ -20,9 +24,12 @@ public:
 private slots:
     void test_data();
     void test();
+    void cache();
+    void cacheInvalidation();
 
 private:
     void readExpectedFile(const QString &baseDir, const QString &fileName, QByteArray *content);
+    void runScanner(const QStringList &arguments, QByteArray *stdOut, QByteArray *stdErr);
 
     QString m_cmd;
     QString m_basePath;
@@ -133,5 +140,122 @@ void tst_qtattributionsscanner::test()
     }
 }
 
+void tst_qtattributionsscanner::runScanner(const QStringList &arguments, QByteArray *stdOut,
+                                           QByteArray *stdErr)
+{
+    QProcess proc;
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert("QT_ATTRIBUTIONSSCANNER_TEST", "1");
+    proc.setProcessEnvironment(env);
+    proc.start(m_cmd, arguments, QIODevice::ReadWrite | QIODevice::Text);
+    QVERIFY2(proc.waitForStarted(), qPrintable(proc.errorString()));
+    QVERIFY(proc.waitForFinished(30000));
+    QCOMPARE(proc.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(proc.exitCode(), 0);
+
+    *stdOut = proc.readAllStandardOutput();
+    *stdErr = proc.readAllStandardError();
+    stdErr->replace(QDir::separator().toLatin1(), "/");
+}
+
+void tst_qtattributionsscanner::cache()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString cacheFile = tempDir.filePath("scan.cache");
+    const QString dir = QDir(m_basePath).absoluteFilePath("good");
+
+    QByteArray expectedErrorOutput;
+    readExpectedFile(dir, "good/expected.error", &expectedErrorOutput);
+    QByteArray expectedOutput;
+    readExpectedFile(dir, "good/expected.json", &expectedOutput);
+    const QJsonDocument expectedJson = QJsonDocument::fromJson(expectedOutput);
+
+    // The second run takes everything from the cache written by the first one.
+    for (int run = 0; run < 2; ++run) {
+        QByteArray stdOut;
+        QByteArray stdErr;
+        runScanner({dir, "--output-format", "json", "--cache", cacheFile}, &stdOut, &stdErr);
+        if (QTest::currentTestFailed())
+            return;
+        QVERIFY(QFileInfo::exists(cacheFile));
+        QCOMPARE(stdErr, expectedErrorOutput);
+        QCOMPARE(QJsonDocument::fromJson(stdOut), expectedJson);
+    }
+}
+
+void tst_qtattributionsscanner::cacheInvalidation()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString cacheFile = tempDir.filePath("scan.cache");
+    const QDir sourceDir(QDir(m_basePath).absoluteFilePath("good/local_license"));
+    const QDir dir(tempDir.filePath("local_license"));
+    QVERIFY(dir.mkpath("."));
+    for (const char *name : {"qt_attribution_test.json", "LICENSE.Id1.txt", "LICENSE.Id2.txt"}) {
+        QVERIFY(QFile::copy(sourceDir.filePath(name), dir.filePath(name)));
+        QVERIFY(QFile::setPermissions(dir.filePath(name),
+                                      QFile::permissions(dir.filePath(name)) | QFile::WriteOwner));
+    }
+
+    // In verbose mode, the scanner reports the attribution files whose
+    // packages it takes from the cache.
+    const QString attributionFile = dir.filePath("qt_attribution_test.json");
+    const QByteArray cacheHit = "Using cached packages of " + attributionFile.toLocal8Bit();
+    const QStringList arguments{dir.path(), "--output-format", "json", "--verbose",
+                                "--cache", cacheFile};
+    const auto touch = [](const QString &fileName, int run) {
+        QFile file(fileName);
+        return file.open(QIODevice::ReadWrite)
+                && file.setFileTime(QDateTime::currentDateTime().addSecs(10 * run),
+                                    QFileDevice::FileModificationTime);
+    };
+
+    QByteArray firstOut;
+    QByteArray stdOut;
+    QByteArray stdErr;
+    runScanner(arguments, &firstOut, &stdErr);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY2(!stdErr.contains(cacheHit), stdErr.constData());
+
+    runScanner(arguments, &stdOut, &stdErr);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY2(stdErr.contains(cacheHit), stdErr.constData());
+    QCOMPARE(QJsonDocument::fromJson(stdOut), QJsonDocument::fromJson(firstOut));
+
+    // A changed license file invalidates the packages that refer to it.
+    QVERIFY(touch(dir.filePath("LICENSE.Id1.txt"), 1));
+    runScanner(arguments, &stdOut, &stdErr);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY2(!stdErr.contains(cacheHit), stdErr.constData());
+
+    runScanner(arguments, &stdOut, &stdErr);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY2(stdErr.contains(cacheHit), stdErr.constData());
+
+    // A changed attribution file is read again, and its new contents are used.
+    {
+        QFile file(attributionFile);
+        QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        QByteArray contents = file.readAll();
+        file.close();
+        contents.replace("\"Local Test\"", "\"Changed Local Test\"");
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text));
+        QCOMPARE(file.write(contents), qint64(contents.size()));
+    }
+    QVERIFY(touch(attributionFile, 2));
+    runScanner(arguments, &stdOut, &stdErr);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY2(!stdErr.contains(cacheHit), stdErr.constData());
+    const QJsonArray packages = QJsonDocument::fromJson(stdOut).array();
+    QCOMPARE(packages.size(), 1);
+    QCOMPARE(packages.first().toObject().value("Name").toString(), QStringLiteral("Changed Local Test"));
+}
+
 QTEST_MAIN(tst_qtattributionsscanner)
 #include "tst_qtattributionsscanner.moc"
@@ -0,0 +1,276 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QBuffer>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QIcon>
+#include <QtGui/QImage>
+#include <QtTest/QtTest>
+#include <QtUiTools/QUiLoader>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QWidget>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+static const char validForm[] = R"(<?xml version="1.0" encoding="UTF-8"?>
+<ui version="4.0">
+ <class>Form</class>
+ <widget class="QWidget" name="Form">
+  <layout class="QVBoxLayout" name="verticalLayout">
+   <item>
+    <widget class="QLabel" name="label">
+     <property name="text">
+      <string>Label text</string>
+     </property>
+    </widget>
+   </item>
+  </layout>
+ </widget>
+</ui>
+)";
+
+// Breaks off in the middle of an element.
+static const char invalidForm[] = R"(<?xml version="1.0" encoding="UTF-8"?>
+<ui version="4.0">
+ <class>Form</class>
+ <widget class="QWidget" name="Form">
+  <property name=
+)";
+
+static const char otherLanguageForm[] = R"(<?xml version="1.0" encoding="UTF-8"?>
+<ui version="4.0" language="jambi">
+ <class>Form</class>
+ <widget class="QWidget" name="Form"/>
+</ui>
+)";
+
+class tst_QUiLoader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void formCacheEnabled();
+    void formCache_data();
+    void formCache();
+    void formCacheErrors_data();
+    void formCacheErrors();
+    void preload();
+    void preloadErrors();
+    void preloadMany();
+    void iconCache();
+
+private:
+    static QWidget *load(QUiLoader &loader, const QByteArray &form);
+};
+
+QWidget *tst_QUiLoader::load(QUiLoader &loader, const QByteArray &form)
+{
+    QBuffer buffer;
+    buffer.setData(form);
+    return loader.load(&buffer);
+}
+
+void tst_QUiLoader::formCacheEnabled()
+{
+    QUiLoader loader;
+    QVERIFY(!loader.isFormCacheEnabled());
+    loader.setFormCacheEnabled(true);
+    QVERIFY(loader.isFormCacheEnabled());
+    loader.setFormCacheEnabled(false);
+    QVERIFY(!loader.isFormCacheEnabled());
+}
+
+void tst_QUiLoader::formCache_data()
+{
+    QTest::addColumn<bool>("cacheEnabled");
+
+    QTest::newRow("uncached") << false;
+    QTest::newRow("cached") << true;
+}
+
+// Each load of a cached form has to create new widgets with the same
+// properties.
+void tst_QUiLoader::formCache()
+{
+    QFETCH(bool, cacheEnabled);
+
+    QUiLoader loader;
+    loader.setFormCacheEnabled(cacheEnabled);
+
+    std::unique_ptr<QWidget> first(load(loader, validForm));
+    QVERIFY2(first, qPrintable(loader.errorString()));
+    QVERIFY(loader.errorString().isEmpty());
+    std::unique_ptr<QWidget> second(load(loader, validForm));
+    QVERIFY2(second, qPrintable(loader.errorString()));
+    QVERIFY(loader.errorString().isEmpty());
+
+    QCOMPARE_NE(first.get(), second.get());
+    for (const QWidget *form : {first.get(), second.get()}) {
+        QCOMPARE(form->objectName(), "Form"_L1);
+        const auto *label = form->findChild<QLabel *>("label"_L1);
+        QVERIFY(label);
+        QCOMPARE(label->text(), "Label text"_L1);
+    }
+    QCOMPARE_NE(first->findChild<QLabel *>(), second->findChild<QLabel *>());
+}
+
+void tst_QUiLoader::formCacheErrors_data()
+{
+    QTest::addColumn<QByteArray>("form");
+    QTest::addColumn<QString>("expectedError");
+
+    QTest::newRow("invalid") << QByteArray(invalidForm) << u"An error has occurred"_s;
+    QTest::newRow("language") << QByteArray(otherLanguageForm) << u"jambi"_s;
+}
+
+// A form that fails to parse reports the same error with and without the
+// cache, also when it is loaded again from the cache.
+void tst_QUiLoader::formCacheErrors()
+{
+    QFETCH(QByteArray, form);
+    QFETCH(QString, expectedError);
+
+    QString uncachedError;
+    {
+        QUiLoader loader;
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression(u"^Designer: "_s));
+        QVERIFY(!load(loader, form));
+        uncachedError = loader.errorString();
+    }
+    QVERIFY2(uncachedError.contains(expectedError), qPrintable(uncachedError));
+
+    QUiLoader loader;
+    loader.setFormCacheEnabled(true);
+    for (int i = 0; i < 2; ++i) {
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression(u"^Designer: "_s));
+        QVERIFY(!load(loader, form));
+        QCOMPARE(loader.errorString(), uncachedError);
+    }
+
+    // A successful load clears the error.
+    std::unique_ptr<QWidget> widget(load(loader, validForm));
+    QVERIFY(widget);
+    QVERIFY(loader.errorString().isEmpty());
+}
+
+void tst_QUiLoader::preload()
+{
+    QUiLoader loader;
+    QBuffer buffer;
+    buffer.setData(validForm);
+    loader.preload(&buffer); // Ignored without the cache
+    loader.setFormCacheEnabled(true);
+    buffer.close();
+    loader.preload(&buffer);
+    buffer.close();
+    loader.preload(&buffer); // Already pending
+
+    for (int i = 0; i < 2; ++i) {
+        std::unique_ptr<QWidget> widget(load(loader, validForm));
+        QVERIFY2(widget, qPrintable(loader.errorString()));
+        QVERIFY(widget->findChild<QLabel *>("label"_L1));
+    }
+}
+
+// Parsing on the thread pool issues no warnings; load() issues the one
+// warning of the failed load.
+void tst_QUiLoader::preloadErrors()
+{
+    QUiLoader loader;
+    loader.setFormCacheEnabled(true);
+    QTest::failOnWarning(QRegularExpression(u".*"_s));
+
+    QBuffer buffer;
+    buffer.setData(invalidForm);
+    loader.preload(&buffer);
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(u"^Designer: An error has occurred"_s));
+    QVERIFY(!load(loader, invalidForm));
+    QVERIFY(loader.errorString().contains("An error has occurred"_L1));
+}
+
+// More forms than the cache holds; the ones that were not parsed ahead are
+// parsed by load().
+void tst_QUiLoader::preloadMany()
+{
+    QUiLoader loader;
+    loader.setFormCacheEnabled(true);
+
+    QList<QByteArray> forms;
+    for (int i = 0; i < 100; ++i) {
+        forms.append(QByteArray(validForm).replace("Label text",
+                                                   "Label " + QByteArray::number(i)));
+        QBuffer buffer;
+        buffer.setData(forms.constLast());
+        loader.preload(&buffer);
+    }
+
+    for (qsizetype i = 0; i < forms.size(); ++i) {
+        std::unique_ptr<QWidget> widget(load(loader, forms.at(i)));
+        QVERIFY2(widget, qPrintable(loader.errorString()));
+        const auto *label = widget->findChild<QLabel *>("label"_L1);
+        QVERIFY(label);
+        QCOMPARE(label->text(), "Label "_L1 + QString::number(i));
+    }
+
+    // Disabling the cache frees the forms still pending.
+    for (const QByteArray &form : std::as_const(forms)) {
+        QBuffer buffer;
+        buffer.setData(form);
+        loader.preload(&buffer);
+    }
+    loader.setFormCacheEnabled(false);
+}
+
+// Loads of a form share their icons only while the cache is enabled.
+void tst_QUiLoader::iconCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString iconFile = dir.filePath(u"icon.png"_s);
+    QImage image(16, 16, QImage::Format_ARGB32);
+    image.fill(Qt::red);
+    QVERIFY(image.save(iconFile));
+
+    const QByteArray form = R"(<?xml version="1.0" encoding="UTF-8"?>
+<ui version="4.0">
+ <class>Form</class>
+ <widget class="QWidget" name="Form">
+  <property name="windowIcon">
+   <iconset>
+    <normaloff>)" + iconFile.toUtf8() + R"(</normaloff>
+   </iconset>
+  </property>
+ </widget>
+</ui>
+)";
+
+    QUiLoader loader;
+    QVERIFY(!loader.isIconCacheEnabled());
+    std::unique_ptr<QWidget> first(load(loader, form));
+    std::unique_ptr<QWidget> second(load(loader, form));
+    QVERIFY(first && second);
+    QVERIFY(!first->windowIcon().isNull());
+    QCOMPARE_NE(first->windowIcon().cacheKey(), second->windowIcon().cacheKey());
+
+    loader.setIconCacheEnabled(true);
+    QVERIFY(loader.isIconCacheEnabled());
+    std::unique_ptr<QWidget> third(load(loader, form));
+    std::unique_ptr<QWidget> fourth(load(loader, form));
+    QVERIFY(third && fourth);
+    QVERIFY(!third->windowIcon().isNull());
+    QCOMPARE(third->windowIcon().cacheKey(), fourth->windowIcon().cacheKey());
+
+    loader.setIconCacheEnabled(false);
+    QVERIFY(!loader.isIconCacheEnabled());
+    std::unique_ptr<QWidget> fifth(load(loader, form));
+    QVERIFY(fifth);
+    QCOMPARE_NE(fifth->windowIcon().cacheKey(), third->windowIcon().cacheKey());
+}
+
+QTEST_MAIN(tst_QUiLoader)
+
+#include "tst_quiloader.moc"
@@ -0,0 +1,371 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QBuffer>
+#include <QtCore/QXmlStreamReader>
+#include <QtCore/QXmlStreamWriter>
+#include <QtDesigner/QFormBuilder>
+#include <QtDesigner/private/ui4_p.h>
+#include <QtTest/QtTest>
+#include <QtWidgets/QFrame>
+#include <QtWidgets/QWidget>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+// Creates the custom widgets of the forms the way an application that
+// registers its own widget classes with the form builder does.
+class FormBuilder : public QFormBuilder
+{
+public:
+    using QFormBuilder::create;
+
+protected:
+    QWidget *createWidget(const QString &widgetName, QWidget *parentWidget,
+                          const QString &name) override
+    {
+        if (widgetName.startsWith("CustomWidget"_L1)) {
+            auto *widget = new QFrame(parentWidget);
+            widget->setObjectName(name);
+            return widget;
+        }
+        return QFormBuilder::createWidget(widgetName, parentWidget, name);
+    }
+};
+
+// Measures the stages of loading and saving forms with QFormBuilder on
+// synthetic forms of several kinds: deeply nested layouts, item views with
+// many items, widgets with style sheets, palettes, fonts and icons, and
+// custom widgets.
+class tst_bench_formbuilder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data();
+    void parse();
+    void create_data();
+    void create();
+    void load_data();
+    void load();
+    void save_data();
+    void save();
+    void write_data();
+    void write();
+
+private:
+    void formData();
+
+    static std::unique_ptr<DomUI> parseForm(const QByteArray &form);
+    static QByteArray createForm(const QByteArray &body, const QByteArray &customWidgets = {});
+    static QByteArray nestedGroup(int depth, int *counter);
+    static QByteArray layoutForm(int depth);
+    static QByteArray itemViewForm(int itemCount);
+    static QByteArray styledForm(int widgetCount);
+    static QByteArray customWidgetForm(int widgetCount);
+};
+
+static QByteArray stringProperty(const char *name, const QByteArray &value)
+{
+    return "<property name=\""_ba + name + "\"><string>"_ba + value + "</string></property>\n"_ba;
+}
+
+QByteArray tst_bench_formbuilder::createForm(const QByteArray &body,
+                                             const QByteArray &customWidgets)
+{
+    QByteArray ui = R"(<?xml version="1.0" encoding="UTF-8"?>
+<ui version="4.0">
+ <class>Form</class>
+ <widget class="QWidget" name="Form">
+)"_ba;
+    ui += stringProperty("windowTitle", "Form"_ba);
+    ui += body;
+    ui += " </widget>\n"_ba;
+    if (!customWidgets.isEmpty())
+        ui += " <customwidgets>\n"_ba + customWidgets + " </customwidgets>\n"_ba;
+    ui += " <resources/>\n <connections/>\n</ui>\n"_ba;
+    return ui;
+}
+
+/*
+  Returns a group box with a label and a line edit, and two more group
+  boxes nested down to \a depth, in vertical and horizontal layouts.
+*/
+QByteArray tst_bench_formbuilder::nestedGroup(int depth, int *counter)
+{
+    const QByteArray number = QByteArray::number((*counter)++);
+    QByteArray group = "<widget class=\"QGroupBox\" name=\"group"_ba + number + "\">\n"_ba;
+    group += stringProperty("title", "Group "_ba + number);
+    group += "<layout class=\"QVBoxLayout\" name=\"verticalLayout"_ba + number + "\">\n"_ba;
+    group += "<item><layout class=\"QHBoxLayout\" name=\"horizontalLayout"_ba + number
+            + "\">\n<item><widget class=\"QLabel\" name=\"label"_ba + number + "\">\n"_ba
+            + stringProperty("text", "Setting "_ba + number)
+            + "</widget></item>\n<item><widget class=\"QLineEdit\" name=\"lineEdit"_ba + number
+            + "\"/></item>\n</layout></item>\n"_ba;
+    if (depth > 0) {
+        for (int i = 0; i < 2; ++i)
+            group += "<item>\n"_ba + nestedGroup(depth - 1, counter) + "</item>\n"_ba;
+    }
+    group += "</layout>\n</widget>\n"_ba;
+    return group;
+}
+
+QByteArray tst_bench_formbuilder::layoutForm(int depth)
+{
+    int counter = 0;
+    return createForm("<layout class=\"QVBoxLayout\" name=\"formLayout\">\n<item>\n"_ba
+                      + nestedGroup(depth, &counter) + "</item>\n</layout>\n"_ba);
+}
+
+/*
+  Returns a form with a tree widget, a table widget and a list widget of
+  \a itemCount items each.
+*/
+QByteArray tst_bench_formbuilder::itemViewForm(int itemCount)
+{
+    static const int columnCount = 4;
+    QByteArray tree = "<item><widget class=\"QTreeWidget\" name=\"treeWidget\">\n"_ba;
+    QByteArray table = "<item><widget class=\"QTableWidget\" name=\"tableWidget\">\n"_ba;
+    QByteArray list = "<item><widget class=\"QListWidget\" name=\"listWidget\">\n"_ba;
+    table += "<property name=\"rowCount\"><number>"_ba + QByteArray::number(itemCount)
+            + "</number></property>\n<property name=\"columnCount\"><number>"_ba
+            + QByteArray::number(columnCount) + "</number></property>\n"_ba;
+    for (int c = 0; c < columnCount; ++c) {
+        const QByteArray column = "<column>\n"_ba
+                + stringProperty("text", "Column "_ba + QByteArray::number(c)) + "</column>\n"_ba;
+        tree += column;
+        table += column;
+    }
+    for (int i = 0; i < itemCount; ++i) {
+        const QByteArray number = QByteArray::number(i);
+        table += "<row>\n"_ba + stringProperty("text", number) + "</row>\n"_ba;
+    }
+    for (int i = 0; i < itemCount; ++i) {
+        const QByteArray number = QByteArray::number(i);
+        tree += "<item>\n"_ba;
+        for (int c = 0; c < columnCount; ++c)
+            tree += stringProperty("text", "Item "_ba + number + '.' + QByteArray::number(c));
+        tree += "<item>\n"_ba + stringProperty("text", "Child "_ba + number)
+                + stringProperty("toolTip", "Child item"_ba) + "</item>\n</item>\n"_ba;
+        for (int c = 0; c < columnCount; ++c) {
+            table += "<item row=\""_ba + number + "\" column=\""_ba + QByteArray::number(c)
+                    + "\">\n"_ba + stringProperty("text", "Cell "_ba + number) + "</item>\n"_ba;
+        }
+        list += "<item>\n"_ba + stringProperty("text", "Entry "_ba + number)
+                + "<property name=\"checkState\"><enum>Checked</enum></property>\n</item>\n"_ba;
+    }
+    tree += "</widget></item>\n"_ba;
+    table += "</widget></item>\n"_ba;
+    list += "</widget></item>\n"_ba;
+    return createForm("<layout class=\"QVBoxLayout\" name=\"formLayout\">\n"_ba + tree + table
+                      + list + "</layout>\n"_ba);
+}
+
+static QByteArray colorRole(const char *role, int red, int green, int blue)
+{
+    return "<colorrole role=\""_ba + role
+            + "\"><brush brushstyle=\"SolidPattern\"><color alpha=\"255\"><red>"_ba
+            + QByteArray::number(red) + "</red><green>"_ba + QByteArray::number(green)
+            + "</green><blue>"_ba + QByteArray::number(blue)
+            + "</blue></color></brush></colorrole>\n"_ba;
+}
+
+/*
+  Returns a form with \a widgetCount push buttons in a grid, each with its
+  own style sheet, palette, font and icon.
+*/
+QByteArray tst_bench_formbuilder::styledForm(int widgetCount)
+{
+    QByteArray body = "<layout class=\"QGridLayout\" name=\"gridLayout\">\n"_ba;
+    for (int i = 0; i < widgetCount; ++i) {
+        const QByteArray number = QByteArray::number(i);
+        const int shade = i % 256;
+        QByteArray colorGroup = colorRole("WindowText", shade, 0, 0)
+                + colorRole("Button", 0, shade, 0) + colorRole("ButtonText", 0, 0, shade)
+                + colorRole("Highlight", shade, shade, 0);
+        body += "<item row=\""_ba + QByteArray::number(i / 4) + "\" column=\""_ba
+                + QByteArray::number(i % 4) + "\">\n<widget class=\"QPushButton\" name=\"button"_ba
+                + number + "\">\n"_ba;
+        body += stringProperty("text", "Button "_ba + number);
+        body += stringProperty("styleSheet",
+                               "QPushButton { color: #"_ba + QByteArray::number(0x100000 + i, 16)
+                                       + "; border: 1px solid gray; border-radius: 4px; "
+                                         "padding: 2px 8px; background: qlineargradient(x1:0, "
+                                         "y1:0, x2:0, y2:1, stop:0 #f6f7fa, stop:1 #dadbde); }\n"
+                                         "QPushButton:pressed { background: #dadbde; }\n"
+                                         "QPushButton:hover { border-color: #3daee9; }"_ba);
+        body += "<property name=\"palette\"><palette>\n<active>\n"_ba + colorGroup
+                + "</active>\n<inactive>\n"_ba + colorGroup + "</inactive>\n<disabled>\n"_ba
+                + colorGroup + "</disabled>\n</palette></property>\n"_ba;
+        body += "<property name=\"font\"><font><family>Sans Serif</family><pointsize>"_ba
+                + QByteArray::number(8 + i % 6)
+                + "</pointsize><bold>true</bold></font></property>\n"_ba;
+        body += "<property name=\"icon\"><iconset theme=\"document-open\">"
+                "<normaloff>icons/open.png</normaloff><normalon>icons/open-on.png</normalon>"
+                "</iconset></property>\n"_ba;
+        body += "</widget>\n</item>\n"_ba;
+    }
+    body += "</layout>\n"_ba;
+    return createForm(body);
+}
+
+/*
+  Returns a form with \a widgetCount custom widgets of five classes in a
+  grid, each with a dynamic property.
+*/
+QByteArray tst_bench_formbuilder::customWidgetForm(int widgetCount)
+{
+    static const int classCount = 5;
+    QByteArray body = "<layout class=\"QGridLayout\" name=\"gridLayout\">\n"_ba;
+    for (int i = 0; i < widgetCount; ++i) {
+        const QByteArray number = QByteArray::number(i);
+        body += "<item row=\""_ba + QByteArray::number(i / 4) + "\" column=\""_ba
+                + QByteArray::number(i % 4) + "\">\n<widget class=\"CustomWidget"_ba
+                + QByteArray::number(i % classCount) + "\" name=\"custom"_ba + number
+                + "\">\n"_ba + stringProperty("toolTip", "Custom widget "_ba + number)
+                + "<property name=\"frameShape\"><enum>QFrame::StyledPanel</enum></property>\n"
+                  "<property name=\"value\" stdset=\"0\"><number>"_ba
+                + number + "</number></property>\n</widget>\n</item>\n"_ba;
+    }
+    body += "</layout>\n"_ba;
+
+    QByteArray customWidgets;
+    for (int c = 0; c < classCount; ++c) {
+        customWidgets += "<customwidget><class>CustomWidget"_ba + QByteArray::number(c)
+                + "</class><extends>QFrame</extends><header>customwidget.h</header>"
+                  "<container>1</container></customwidget>\n"_ba;
+    }
+    return createForm(body, customWidgets);
+}
+
+void tst_bench_formbuilder::formData()
+{
+    QTest::addColumn<QByteArray>("form");
+
+    QTest::newRow("layouts-4") << layoutForm(4);
+    QTest::newRow("layouts-8") << layoutForm(8);
+    QTest::newRow("itemviews-100") << itemViewForm(100);
+    QTest::newRow("itemviews-1000") << itemViewForm(1000);
+    QTest::newRow("styled-20") << styledForm(20);
+    QTest::newRow("styled-200") << styledForm(200);
+    QTest::newRow("custom-50") << customWidgetForm(50);
+    QTest::newRow("custom-500") << customWidgetForm(500);
+}
+
+std::unique_ptr<DomUI> tst_bench_formbuilder::parseForm(const QByteArray &form)
+{
+    QXmlStreamReader reader(form);
+    if (!reader.readNextStartElement())
+        return {};
+    auto ui = std::make_unique<DomUI>();
+    ui->read(reader);
+    if (reader.hasError())
+        return {};
+    return ui;
+}
+
+void tst_bench_formbuilder::parse_data()
+{
+    formData();
+}
+
+void tst_bench_formbuilder::parse()
+{
+    QFETCH(QByteArray, form);
+
+    QBENCHMARK {
+        QVERIFY(parseForm(form));
+    }
+}
+
+void tst_bench_formbuilder::create_data()
+{
+    formData();
+}
+
+/*
+    Measures creating the widgets and layouts of a parsed form and
+    applying their properties.
+*/
+void tst_bench_formbuilder::create()
+{
+    QFETCH(QByteArray, form);
+    const std::unique_ptr<DomUI> ui = parseForm(form);
+    QVERIFY(ui);
+    FormBuilder builder;
+
+    QBENCHMARK {
+        std::unique_ptr<QWidget> widget(builder.create(ui.get(), nullptr));
+        QVERIFY(widget);
+    }
+}
+
+void tst_bench_formbuilder::load_data()
+{
+    formData();
+}
+
+void tst_bench_formbuilder::load()
+{
+    QFETCH(QByteArray, form);
+    FormBuilder builder;
+
+    QBENCHMARK {
+        QBuffer buffer(&form);
+        buffer.open(QIODevice::ReadOnly);
+        std::unique_ptr<QWidget> widget(builder.load(&buffer));
+        QVERIFY2(widget, qPrintable(builder.errorString()));
+    }
+}
+
+void tst_bench_formbuilder::save_data()
+{
+    formData();
+}
+
+/*
+    Measures saving the widgets of a loaded form, which reads back all of
+    their properties.
+*/
+void tst_bench_formbuilder::save()
+{
+    QFETCH(QByteArray, form);
+    FormBuilder builder;
+    QBuffer input(&form);
+    input.open(QIODevice::ReadOnly);
+    const std::unique_ptr<QWidget> widget(builder.load(&input));
+    QVERIFY2(widget, qPrintable(builder.errorString()));
+
+    QBENCHMARK {
+        QBuffer output;
+        output.open(QIODevice::WriteOnly);
+        builder.save(&output, widget.get());
+        QVERIFY(!output.data().isEmpty());
+    }
+}
+
+void tst_bench_formbuilder::write_data()
+{
+    formData();
+}
+
+void tst_bench_formbuilder::write()
+{
+    QFETCH(QByteArray, form);
+    const std::unique_ptr<DomUI> ui = parseForm(form);
+    QVERIFY(ui);
+
+    QBENCHMARK {
+        QByteArray output;
+        QXmlStreamWriter writer(&output);
+        writer.setAutoFormatting(true);
+        writer.writeStartDocument();
+        ui->write(writer);
+        writer.writeEndDocument();
+        QVERIFY(!output.isEmpty());
+    }
+}
+
+QTEST_MAIN(tst_bench_formbuilder)
+#include "tst_bench_formbuilder.moc"
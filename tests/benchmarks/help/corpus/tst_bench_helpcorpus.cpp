@@ -0,0 +1,455 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <QtHelp/QHelpContentWidget>
+#include <QtHelp/QHelpEngine>
+#include <QtHelp/QHelpEngineCore>
+#include <QtHelp/QHelpIndexWidget>
+#include <QtHelp/QHelpSearchEngineCore>
+
+#include "../../../../src/assistant/qhelpgenerator/helpgenerator.h"
+#include "../../../../src/assistant/qhelpgenerator/qhelpprojectdata_p.h"
+
+#include <benchmarkcorpus.h>
+
+using namespace Qt::StringLiterals;
+using BenchmarkCorpus::writeFile;
+
+// The number of distinct words the documents are made of. The search
+// benchmark cycles through more words than the search engine caches
+// results for, so that every search reads the index.
+static constexpr int VocabularySize = 256;
+static constexpr int SearchWordCount = 64;
+
+// Measures the help engine on a synthetic help project of N documents with
+// M keywords each. The documents are grouped into chapters of 50 in the
+// table of contents. Each one has a title, a few paragraphs of text from
+// a fixed vocabulary, and links to its neighbors.
+//
+// The peak memory use of the process so far is printed after each
+// benchmark, where the platform reports it.
+class tst_bench_helpcorpus : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void generate_data();
+    void generate();
+    void registerDocumentation_data();
+    void registerDocumentation();
+    void setupData_data();
+    void setupData();
+    void contentModel_data();
+    void contentModel();
+    void indexModel_data();
+    void indexModel();
+    void fullTextIndex_data();
+    void fullTextIndex();
+    void search_data();
+    void search();
+    void searchCached_data();
+    void searchCached();
+    void copyCollectionFile_data();
+    void copyCollectionFile();
+
+private:
+    void corpusData();
+    void createCorpus(int documentCount, int keywordCount);
+    bool generateQch();
+    bool registerQch();
+    void reportPeakMemory();
+
+    static bool writeProject(const QString &filePath, const QString &name, const QString &toc,
+                             const QString &keywords);
+
+    std::unique_ptr<QTemporaryDir> m_dir;
+    QString m_projectFile;
+    QString m_qchFile;
+    QString m_collectionFile;
+};
+
+void tst_bench_helpcorpus::corpusData()
+{
+    BenchmarkCorpus::addSizeRows("documentCount", "keywordCount",
+                                 { { 100, 10 }, { 1000, 10 }, { 5000, 20 } });
+}
+
+static QString word(int index)
+{
+    return u"term"_s + QString::number(index % VocabularySize);
+}
+
+/*
+    Creates the help project and its documents in a new temporary directory.
+*/
+void tst_bench_helpcorpus::createCorpus(int documentCount, int keywordCount)
+{
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+    const QDir dir(m_dir->path());
+    QVERIFY(dir.mkpath(u"doc"_s));
+    m_projectFile = dir.filePath(u"doc/synth.qhp"_s);
+    m_qchFile = dir.filePath(u"synth.qch"_s);
+    m_collectionFile = dir.filePath(u"synth.qhc"_s);
+
+    QString toc;
+    QString keywords;
+    for (int d = 0; d < documentCount; ++d) {
+        const QString number = QString::number(d);
+        const QString fileName = u"doc"_s + number + u".html"_s;
+        const QString title = u"Document "_s + number;
+
+        QString html = u"<html><head><title>"_s + title + u"</title></head><body>\n<h1>"_s
+                + title + u"</h1>\n"_s;
+        for (int p = 0; p < 5; ++p) {
+            html += u"<p>"_s;
+            for (int w = 0; w < 40; ++w)
+                html += word(d * 7 + p * 31 + w * 13) + u' ';
+            html += u"</p>\n"_s;
+        }
+        html += u"<p>See <a href=\"doc"_s + QString::number((d + 1) % documentCount)
+                + u".html\">the next document</a>.</p>\n"_s;
+        for (int k = 0; k < keywordCount; ++k)
+            html += u"<h2 id=\"key"_s + QString::number(k) + u"\">Key "_s
+                    + QString::number(k) + u"</h2>\n"_s;
+        html += u"</body></html>\n"_s;
+        QVERIFY(writeFile(dir.filePath(u"doc/"_s + fileName), html));
+
+        if (d % 50 == 0) {
+            if (d)
+                toc += u"            </section>\n"_s;
+            toc += u"            <section title=\"Chapter "_s + QString::number(d / 50)
+                    + u"\" ref=\""_s + fileName + u"\">\n"_s;
+        }
+        toc += u"                <section title=\""_s + title + u"\" ref=\""_s + fileName
+                + u"\"/>\n"_s;
+        for (int k = 0; k < keywordCount; ++k) {
+            const QString key = u"key"_s + QString::number(k);
+            keywords += u"            <keyword name=\""_s + word(d + k) + u"\" id=\"Doc"_s
+                    + number + u"::"_s + key + u"\" ref=\""_s + fileName + u'#' + key
+                    + u"\"/>\n"_s;
+        }
+    }
+    if (documentCount)
+        toc += u"            </section>\n"_s;
+
+    QVERIFY(writeProject(m_projectFile, u"synth"_s, toc, keywords));
+}
+
+/*
+    Writes a help project whose namespace, virtual folder, custom filter
+    and filter attribute are all derived from name.
+*/
+bool tst_bench_helpcorpus::writeProject(const QString &filePath, const QString &name,
+                                        const QString &toc, const QString &keywords)
+{
+    return writeFile(filePath,
+                     u"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                     "<QtHelpProject version=\"1.0\">\n"
+                     "    <namespace>org.qt-project."_s
+                     + name + u".100</namespace>\n"
+                              "    <virtualFolder>"_s
+                     + name + u"</virtualFolder>\n"
+                              "    <customFilter name=\""_s
+                     + name + u" 1.0\">\n"
+                              "        <filterAttribute>"_s
+                     + name + u"</filterAttribute>\n"
+                              "    </customFilter>\n"
+                              "    <filterSection>\n"
+                              "        <filterAttribute>"_s
+                     + name + u"</filterAttribute>\n"
+                              "        <toc>\n"_s
+                     + toc
+                     + u"        </toc>\n"
+                       "        <keywords>\n"_s
+                     + keywords
+                     + u"        </keywords>\n"
+                       "        <files>\n"
+                       "            <file>*.html</file>\n"
+                       "        </files>\n"
+                       "    </filterSection>\n"
+                       "</QtHelpProject>\n"_s);
+}
+
+bool tst_bench_helpcorpus::generateQch()
+{
+    QHelpProjectData data;
+    if (!data.readData(m_projectFile))
+        return false;
+    HelpGenerator generator(true);
+    return generator.generate(&data, m_qchFile);
+}
+
+bool tst_bench_helpcorpus::registerQch()
+{
+    QHelpEngineCore engine(m_collectionFile);
+    engine.setReadOnly(false);
+    return engine.setupData() && engine.registerDocumentation(m_qchFile);
+}
+
+void tst_bench_helpcorpus::reportPeakMemory()
+{
+    if (const qint64 peakKiB = BenchmarkCorpus::peakRssKiB(); peakKiB >= 0)
+        qInfo() << peakKiB << "KiB peak RSS";
+}
+
+void tst_bench_helpcorpus::generate_data()
+{
+    corpusData();
+}
+
+void tst_bench_helpcorpus::generate()
+{
+    QFETCH(int, documentCount);
+    QFETCH(int, keywordCount);
+    createCorpus(documentCount, keywordCount);
+
+    QBENCHMARK {
+        QVERIFY(generateQch());
+    }
+    qInfo() << QFileInfo(m_qchFile).size() << "bytes";
+    reportPeakMemory();
+}
+
+void tst_bench_helpcorpus::registerDocumentation_data()
+{
+    corpusData();
+}
+
+void tst_bench_helpcorpus::registerDocumentation()
+{
+    QFETCH(int, documentCount);
+    QFETCH(int, keywordCount);
+    createCorpus(documentCount, keywordCount);
+    QVERIFY(generateQch());
+
+    QBENCHMARK {
+        QFile::remove(m_collectionFile);
+        QVERIFY(registerQch());
+    }
+    reportPeakMemory();
+}
+
+void tst_bench_helpcorpus::setupData_data()
+{
+    corpusData();
+}
+
+void tst_bench_helpcorpus::setupData()
+{
+    QFETCH(int, documentCount);
+    QFETCH(int, keywordCount);
+    createCorpus(documentCount, keywordCount);
+    QVERIFY(generateQch());
+    QVERIFY(registerQch());
+
+    QBENCHMARK {
+        QHelpEngineCore engine(m_collectionFile);
+        QVERIFY(engine.setupData());
+    }
+    reportPeakMemory();
+}
+
+void tst_bench_helpcorpus::contentModel_data()
+{
+    corpusData();
+}
+
+void tst_bench_helpcorpus::contentModel()
+{
+    QFETCH(int, documentCount);
+    QFETCH(int, keywordCount);
+    createCorpus(documentCount, keywordCount);
+    QVERIFY(generateQch());
+    QVERIFY(registerQch());
+
+    QHelpEngine engine(m_collectionFile);
+    QHelpContentModel *model = engine.contentModel();
+    QSignalSpy initialSpy(model, &QHelpContentModel::contentsCreated);
+    QVERIFY(engine.setupData());
+    QTRY_COMPARE_WITH_TIMEOUT(initialSpy.size(), 1, 60000);
+
+    QBENCHMARK {
+        QSignalSpy spy(model, &QHelpContentModel::contentsCreated);
+        model->createContentsForCurrentFilter();
+        QTRY_COMPARE_WITH_TIMEOUT(spy.size(), 1, 60000);
+    }
+    QVERIFY(model->rowCount() > 0);
+    reportPeakMemory();
+}
+
+void tst_bench_helpcorpus::indexModel_data()
+{
+    corpusData();
+}
+
+void tst_bench_helpcorpus::indexModel()
+{
+    QFETCH(int, documentCount);
+    QFETCH(int, keywordCount);
+    createCorpus(documentCount, keywordCount);
+    QVERIFY(generateQch());
+    QVERIFY(registerQch());
+
+    QHelpEngine engine(m_collectionFile);
+    QHelpIndexModel *model = engine.indexModel();
+    QSignalSpy initialSpy(model, &QHelpIndexModel::indexCreated);
+    QVERIFY(engine.setupData());
+    QTRY_COMPARE_WITH_TIMEOUT(initialSpy.size(), 1, 60000);
+
+    QBENCHMARK {
+        QSignalSpy spy(model, &QHelpIndexModel::indexCreated);
+        model->createIndexForCurrentFilter();
+        QTRY_COMPARE_WITH_TIMEOUT(spy.size(), 1, 60000);
+    }
+    QVERIFY(model->rowCount() > 0);
+    reportPeakMemory();
+}
+
+void tst_bench_helpcorpus::fullTextIndex_data()
+{
+    corpusData();
+}
+
+void tst_bench_helpcorpus::fullTextIndex()
+{
+    QFETCH(int, documentCount);
+    QFETCH(int, keywordCount);
+    createCorpus(documentCount, keywordCount);
+    QVERIFY(generateQch());
+    QVERIFY(registerQch());
+
+    QHelpEngineCore engine(m_collectionFile);
+    QVERIFY(engine.setupData());
+    QHelpSearchEngineCore searchEngine(&engine);
+
+    QBENCHMARK {
+        QSignalSpy spy(&searchEngine, &QHelpSearchEngineCore::indexingFinished);
+        searchEngine.reindexDocumentation();
+        QTRY_COMPARE_WITH_TIMEOUT(spy.size(), 1, 600000);
+    }
+    reportPeakMemory();
+}
+
+void tst_bench_helpcorpus::search_data()
+{
+    corpusData();
+}
+
+/*
+    Measures searching a built index and fetching the first page of
+    results. Each search is for another word, so no search is answered
+    from the results cached by the search engine.
+*/
+void tst_bench_helpcorpus::search()
+{
+    QFETCH(int, documentCount);
+    QFETCH(int, keywordCount);
+    createCorpus(documentCount, keywordCount);
+    QVERIFY(generateQch());
+    QVERIFY(registerQch());
+
+    QHelpEngineCore engine(m_collectionFile);
+    QVERIFY(engine.setupData());
+    QHelpSearchEngineCore searchEngine(&engine);
+    QSignalSpy indexSpy(&searchEngine, &QHelpSearchEngineCore::indexingFinished);
+    searchEngine.reindexDocumentation();
+    QTRY_COMPARE_WITH_TIMEOUT(indexSpy.size(), 1, 600000);
+
+    int searchCount = 0;
+    QBENCHMARK {
+        QSignalSpy spy(&searchEngine, &QHelpSearchEngineCore::searchingFinished);
+        searchEngine.search(word(searchCount++ % SearchWordCount));
+        QTRY_COMPARE_WITH_TIMEOUT(spy.size(), 1, 60000);
+        QVERIFY(searchEngine.searchResultCount() > 0);
+        QVERIFY(!searchEngine.searchResults(0, 10).isEmpty());
+    }
+    reportPeakMemory();
+}
+
+void tst_bench_helpcorpus::searchCached_data()
+{
+    corpusData();
+}
+
+/*
+    Measures repeating the same search, as search-as-you-type does when
+    the user deletes characters again.
+*/
+void tst_bench_helpcorpus::searchCached()
+{
+    QFETCH(int, documentCount);
+    QFETCH(int, keywordCount);
+    createCorpus(documentCount, keywordCount);
+    QVERIFY(generateQch());
+    QVERIFY(registerQch());
+
+    QHelpEngineCore engine(m_collectionFile);
+    QVERIFY(engine.setupData());
+    QHelpSearchEngineCore searchEngine(&engine);
+    QSignalSpy indexSpy(&searchEngine, &QHelpSearchEngineCore::indexingFinished);
+    searchEngine.reindexDocumentation();
+    QTRY_COMPARE_WITH_TIMEOUT(indexSpy.size(), 1, 600000);
+
+    QBENCHMARK {
+        QSignalSpy spy(&searchEngine, &QHelpSearchEngineCore::searchingFinished);
+        searchEngine.search(word(0));
+        QTRY_COMPARE_WITH_TIMEOUT(spy.size(), 1, 60000);
+        QVERIFY(!searchEngine.searchResults(0, 10).isEmpty());
+    }
+    reportPeakMemory();
+}
+
+void tst_bench_helpcorpus::copyCollectionFile_data()
+{
+    QTest::addColumn<int>("documentationCount");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("20") << 20;
+    QTest::newRow("100") << 100;
+}
+
+/*
+    Measures copying a collection with many registered documentation sets,
+    each with its own custom filter. The copy takes over the namespaces,
+    folders, filters and settings of the collection, and their number
+    rather than the size of the documentation determines its cost.
+*/
+void tst_bench_helpcorpus::copyCollectionFile()
+{
+    QFETCH(int, documentationCount);
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+    const QDir dir(m_dir->path());
+    QVERIFY(dir.mkpath(u"doc"_s));
+    QVERIFY(writeFile(dir.filePath(u"doc/index.html"_s),
+                      u"<html><head><title>Index</title></head><body></body></html>\n"_s));
+    m_collectionFile = dir.filePath(u"synth.qhc"_s);
+
+    QHelpEngineCore engine(m_collectionFile);
+    engine.setReadOnly(false);
+    QVERIFY(engine.setupData());
+    for (int i = 0; i < documentationCount; ++i) {
+        const QString name = u"synth"_s + QString::number(i);
+        m_projectFile = dir.filePath(u"doc/"_s + name + u".qhp"_s);
+        m_qchFile = dir.filePath(name + u".qch"_s);
+        QVERIFY(writeProject(m_projectFile, name,
+                             u"            <section title=\"Index\" ref=\"index.html\"/>\n"_s,
+                             QString()));
+        QVERIFY(generateQch());
+        QVERIFY(engine.registerDocumentation(m_qchFile));
+    }
+    const QString copiedFile = dir.filePath(u"copy/synth.qhc"_s);
+
+    QBENCHMARK {
+        QFile::remove(copiedFile);
+        QVERIFY(engine.copyCollectionFile(copiedFile));
+    }
+    reportPeakMemory();
+}
+
+QTEST_MAIN(tst_bench_helpcorpus)
+#include "tst_bench_helpcorpus.moc"
@@ -0,0 +1,250 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "translator.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace Qt::StringLiterals;
+
+// Counts the allocations done through the global operator new, so that the
+// allocation behavior of the loaders and writers can be guarded as well.
+static std::atomic<qint64> allocationCount = 0;
+
+void *operator new(std::size_t size)
+{
+    ++allocationCount;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static const int messageCounts[] = { 1000, 10000, 100000 };
+static const char *const formats[] = { "ts", "qm", "po", "xlf", "qph" };
+
+class tst_bench_formats : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void load_data();
+    void load();
+    void save_data();
+    void save();
+    void convert_data();
+    void convert();
+    void loadAllocations_data();
+    void loadAllocations();
+    void saveAllocations_data();
+    void saveAllocations();
+
+private:
+    void formatData();
+    QString catalogFileName(const QString &format, int messageCount) const;
+    static const Translator::FileFormat *fileFormat(const QString &extension);
+    static Translator createCatalog(int messageCount);
+
+    QTemporaryDir m_dir;
+    QHash<int, Translator> m_catalogs;
+};
+
+/*
+  Creates a catalog resembling a real application: contexts of 50
+  messages, with comments, plurals, extra and translator comments,
+  extras and a few references per message.
+*/
+Translator tst_bench_formats::createCatalog(int messageCount)
+{
+    Translator catalog;
+    catalog.setLanguageCode(u"de"_s);
+    catalog.setSourceLanguageCode(u"en"_s);
+    for (int i = 0; i < messageCount; ++i) {
+        const QString context = u"Context%1"_s.arg(i / 50);
+        const QString fileName = u"src/widget%1.cpp"_s.arg(i / 50);
+        TranslatorMessage msg(context, u"Source text %1 of the application"_s.arg(i),
+                              i % 5 == 0 ? u"disambiguation %1"_s.arg(i) : QString(),
+                              QString(), fileName, 10 + (i % 50) * 7, QStringList(),
+                              i % 9 == 0 ? TranslatorMessage::Unfinished
+                                         : TranslatorMessage::Finished);
+        if (i % 7 == 0) {
+            msg.setPlural(true);
+            msg.setSourceText(u"%n item(s) in list %1"_s.arg(i));
+            msg.setTranslations({ u"%n Eintrag in Liste %1"_s.arg(i),
+                                  u"%n Einträge in Liste %1"_s.arg(i) });
+        } else {
+            msg.setTranslation(u"Übersetzter Text %1 der Anwendung"_s.arg(i));
+        }
+        if (i % 3 == 0)
+            msg.setExtraComment(u"Shown in the status bar of window %1"_s.arg(i / 50));
+        if (i % 11 == 0)
+            msg.setTranslatorComment(u"Check the terminology"_s);
+        if (i % 13 == 0)
+            msg.setExtra(u"po-flags"_s, u"c-format"_s);
+        if (i % 4 == 0)
+            msg.addReference(u"src/dialog%1.cpp"_s.arg(i / 200), 20 + i % 200);
+        catalog.append(msg);
+    }
+    return catalog;
+}
+
+const Translator::FileFormat *tst_bench_formats::fileFormat(const QString &extension)
+{
+    for (const Translator::FileFormat &format : std::as_const(Translator::registeredFileFormats())) {
+        if (format.extension == extension)
+            return &format;
+    }
+    return nullptr;
+}
+
+QString tst_bench_formats::catalogFileName(const QString &format, int messageCount) const
+{
+    return m_dir.filePath(u"catalog_%1.%2"_s.arg(messageCount).arg(format));
+}
+
+void tst_bench_formats::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    for (int messageCount : messageCounts) {
+        m_catalogs.insert(messageCount, createCatalog(messageCount));
+        for (const char *format : formats) {
+            const QString extension = QString::fromLatin1(format);
+            QVERIFY2(fileFormat(extension), format);
+            ConversionData cd;
+            QVERIFY2(m_catalogs[messageCount].save(catalogFileName(extension, messageCount),
+                                                   cd, extension),
+                     qPrintable(cd.error()));
+        }
+    }
+}
+
+void tst_bench_formats::formatData()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<int>("messageCount");
+    for (const char *format : formats) {
+        for (int messageCount : messageCounts) {
+            QTest::addRow("%s-%d", format, messageCount)
+                    << QString::fromLatin1(format) << messageCount;
+        }
+    }
+}
+
+void tst_bench_formats::load_data()
+{
+    formatData();
+}
+
+void tst_bench_formats::load()
+{
+    QFETCH(QString, format);
+    QFETCH(int, messageCount);
+    const QString fileName = catalogFileName(format, messageCount);
+
+    QBENCHMARK {
+        Translator catalog;
+        ConversionData cd;
+        QVERIFY2(catalog.load(fileName, cd, format), qPrintable(cd.error()));
+    }
+}
+
+void tst_bench_formats::save_data()
+{
+    formatData();
+}
+
+void tst_bench_formats::save()
+{
+    QFETCH(QString, format);
+    QFETCH(int, messageCount);
+    const Translator &catalog = m_catalogs[messageCount];
+    const Translator::FileFormat *saver = fileFormat(format);
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        ConversionData cd;
+        QVERIFY2(saver->saver(catalog, buffer, cd), qPrintable(cd.error()));
+    }
+}
+
+void tst_bench_formats::convert_data()
+{
+    formatData();
+}
+
+// Converts from TS, the usual source of all other formats, like lconvert does.
+void tst_bench_formats::convert()
+{
+    QFETCH(QString, format);
+    QFETCH(int, messageCount);
+    const QString fileName = catalogFileName(u"ts"_s, messageCount);
+    const Translator::FileFormat *saver = fileFormat(format);
+
+    QBENCHMARK {
+        Translator catalog;
+        ConversionData cd;
+        QVERIFY2(catalog.load(fileName, cd, u"ts"_s), qPrintable(cd.error()));
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY2(saver->saver(catalog, buffer, cd), qPrintable(cd.error()));
+    }
+}
+
+void tst_bench_formats::loadAllocations_data()
+{
+    formatData();
+}
+
+void tst_bench_formats::loadAllocations()
+{
+    QFETCH(QString, format);
+    QFETCH(int, messageCount);
+    const QString fileName = catalogFileName(format, messageCount);
+
+    Translator catalog;
+    ConversionData cd;
+    const qint64 before = allocationCount;
+    QVERIFY2(catalog.load(fileName, cd, format), qPrintable(cd.error()));
+    QTest::setBenchmarkResult(qreal(allocationCount - before), QTest::Events);
+}
+
+void tst_bench_formats::saveAllocations_data()
+{
+    formatData();
+}
+
+void tst_bench_formats::saveAllocations()
+{
+    QFETCH(QString, format);
+    QFETCH(int, messageCount);
+    const Translator &catalog = m_catalogs[messageCount];
+    const Translator::FileFormat *saver = fileFormat(format);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    ConversionData cd;
+    const qint64 before = allocationCount;
+    QVERIFY2(saver->saver(catalog, buffer, cd), qPrintable(cd.error()));
+    QTest::setBenchmarkResult(qreal(allocationCount - before), QTest::Events);
+}
+
+QTEST_MAIN(tst_bench_formats)
+#include "tst_bench_formats.moc"
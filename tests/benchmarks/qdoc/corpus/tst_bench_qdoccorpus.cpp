@@ -0,0 +1,286 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QProcess>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <benchmarkcorpus.h>
+
+using namespace Qt::StringLiterals;
+using BenchmarkCorpus::writeFile;
+
+// Runs QDoc on synthetic modules of N classes with M documented member
+// functions each, plus as many QML types with M properties each. Every
+// class quotes a snippet and links to its neighbors, and a second module
+// links to all classes of the first one through its index file.
+//
+// The phase timings and the peak memory use of the last run, as written
+// by QDoc's -timing-report, are printed after each benchmark.
+class tst_bench_qdoccorpus : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void prepare_data();
+    void prepare();
+    void generate_data();
+    void generate();
+    void generateDependent_data();
+    void generateDependent();
+    void singleExec_data();
+    void singleExec();
+
+private:
+    void corpusData();
+    void createCorpus(int classCount, int memberCount);
+    bool runQDoc(QStringList arguments);
+    void reportPhases();
+
+    QString m_qdoc;
+    std::unique_ptr<QTemporaryDir> m_dir;
+};
+
+void tst_bench_qdoccorpus::initTestCase()
+{
+    const auto binpath = QLibraryInfo::path(QLibraryInfo::BinariesPath);
+    const auto extension = QSysInfo::productType() == "windows"_L1 ? ".exe"_L1 : ""_L1;
+    m_qdoc = binpath + "/qdoc"_L1 + extension;
+    if (!QFileInfo::exists(m_qdoc))
+        QSKIP("QDoc was not found in the binaries path");
+}
+
+void tst_bench_qdoccorpus::corpusData()
+{
+    BenchmarkCorpus::addSizeRows("classCount", "memberCount",
+                                 { { 20, 10 }, { 200, 20 }, { 1000, 20 } });
+}
+
+/*
+    Creates the modules Synth and SynthLinks in a new temporary directory.
+*/
+void tst_bench_qdoccorpus::createCorpus(int classCount, int memberCount)
+{
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+    const QDir dir(m_dir->path());
+    QVERIFY(dir.mkpath(u"synth/snippets"_s));
+    QVERIFY(dir.mkpath(u"links"_s));
+    QVERIFY(dir.mkpath(u"docs"_s));
+
+    QString header = u"#pragma once\n\nnamespace Synth {\n\n"_s;
+    QString source = u"#include \"synth.h\"\n\nnamespace Synth {\n\n"_s;
+    QString qml;
+    QString snippets;
+    for (int c = 0; c < classCount; ++c) {
+        const QString name = u"Class"_s + QString::number(c);
+        const QString next = u"Class"_s + QString::number((c + 1) % classCount);
+        const QString qmlName = u"Type"_s + QString::number(c);
+
+        header += u"class "_s + name + u"\n{\npublic:\n"_s;
+        header += u"    explicit "_s + name + u"(int value = 0);\n"_s;
+        source += u"/*!\n    \\class Synth::"_s + name
+                + u"\n    \\inmodule Synth\n    \\brief The "_s + name
+                + u" class is class number "_s + QString::number(c)
+                + u" of the corpus.\n\n    It is used together with \\l "_s + next
+                + u" and \\l "_s + qmlName
+                + u".\n\n    \\snippet snippets/snippets.cpp "_s + QString::number(c)
+                + u"\n\n    \\sa "_s + next + u"\n*/\n\n"_s;
+        source += u"/*!\n    Constructs the object with \\a value.\n*/\n"_s + name
+                + u"::"_s + name + u"(int value) : m_value(value) {}\n\n"_s;
+        snippets += u"//! ["_s + QString::number(c) + u"]\nSynth::"_s + name
+                + u" object(42);\nint sum = object.member0(1) + object.member1(2);\n//! ["_s
+                + QString::number(c) + u"]\n\n"_s;
+        qml += u"/*!\n    \\qmltype "_s + qmlName + u"\n    \\inqmlmodule SynthQml\n"_s
+                + u"    \\nativetype Synth::"_s + name + u"\n    \\brief A QML type.\n\n"_s
+                + u"    See also \\l {Synth::"_s + name + u"}.\n*/\n\n"_s;
+
+        for (int m = 0; m < memberCount; ++m) {
+            const QString member = u"member"_s + QString::number(m);
+            header += u"    int "_s + member + u"(int value) const;\n"_s;
+            source += u"/*!\n    \\fn int Synth::"_s + name + u"::"_s + member
+                    + u"(int value) const\n\n    Returns the sum of \\a value and the value of "
+                      "this object. See also \\l {"_s
+                    + next + u"::"_s + member + u"()}.\n*/\nint "_s + name + u"::"_s + member
+                    + u"(int value) const { return m_value + value; }\n\n"_s;
+            qml += u"/*!\n    \\qmlproperty int "_s + qmlName + u"::property"_s
+                    + QString::number(m) + u"\n\n    A property of \\l "_s + qmlName
+                    + u".\n*/\n\n"_s;
+        }
+        header += u"\nprivate:\n    int m_value;\n};\n\n"_s;
+    }
+    header += u"} // namespace Synth\n"_s;
+    source += u"} // namespace Synth\n"_s;
+    const QString modules = u"/*!\n    \\module Synth\n    \\title Synth\n    \\brief A synthetic "
+                            "module.\n*/\n\n/*!\n    \\qmlmodule SynthQml\n    \\title SynthQml\n"
+                            "    \\brief A synthetic QML module.\n*/\n"_s;
+
+    QVERIFY(writeFile(dir.filePath(u"synth/synth.h"_s), header));
+    QVERIFY(writeFile(dir.filePath(u"synth/synth.cpp"_s), source));
+    QVERIFY(writeFile(dir.filePath(u"synth/synthqml.qdoc"_s), qml));
+    QVERIFY(writeFile(dir.filePath(u"synth/modules.qdoc"_s), modules));
+    QVERIFY(writeFile(dir.filePath(u"synth/snippets/snippets.cpp"_s), snippets));
+    QVERIFY(writeFile(dir.filePath(u"synth/synth.qdocconf"_s),
+                      u"project = Synth\n"
+                      "moduleheader = synth.h\n"
+                      "headerdirs = .\n"
+                      "sourcedirs = .\n"
+                      "exampledirs = .\n"
+                      "headers.fileextensions = \"*.h\"\n"
+                      "sources.fileextensions = \"*.cpp *.qdoc\"\n"
+                      "excludedirs = snippets\n"
+                      "outputformats = HTML\n"_s));
+
+    QString links = u"/*!\n    \\page links.html\n    \\title Links\n\n"_s;
+    for (int c = 0; c < classCount; ++c) {
+        links += u"    \\list\n    \\li \\l {Synth::Class"_s + QString::number(c)
+                + u"}\n    \\li \\l {Synth::Class"_s + QString::number(c)
+                + u"::member0()}\n    \\li \\l [QML] {Type"_s + QString::number(c)
+                + u"}\n    \\endlist\n"_s;
+    }
+    links += u"*/\n"_s;
+    QVERIFY(writeFile(dir.filePath(u"links/links.qdoc"_s), links));
+    QVERIFY(writeFile(dir.filePath(u"links/links.qdocconf"_s),
+                      u"project = SynthLinks\n"
+                      "depends = synth\n"
+                      "moduleheader =\n"
+                      "sourcedirs = .\n"
+                      "sources.fileextensions = \"*.qdoc\"\n"
+                      "outputformats = HTML\n"_s));
+}
+
+bool tst_bench_qdoccorpus::runQDoc(QStringList arguments)
+{
+    arguments << u"-timing-report"_s << m_dir->filePath(u"timing.json"_s);
+    QProcess process;
+    process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    process.start(m_qdoc, arguments);
+    if (!process.waitForFinished(-1) || process.exitStatus() != QProcess::NormalExit
+        || process.exitCode() != 0) {
+        qWarning() << "QDoc failed:" << arguments << process.errorString();
+        return false;
+    }
+    return true;
+}
+
+void tst_bench_qdoccorpus::reportPhases()
+{
+    QFile file(m_dir->filePath(u"timing.json"_s));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const QJsonObject report = QJsonDocument::fromJson(file.readAll()).object();
+    const QJsonArray phases = report[u"phases"_s].toArray();
+    for (const QJsonValue &phase : phases) {
+        qInfo().noquote() << QString(phase[u"depth"_s].toInt() * 2, u' ')
+                                  + QFileInfo(phase[u"qdocconf"_s].toString()).fileName() + u' '
+                                  + phase[u"pass"_s].toString() + u' '
+                                  + phase[u"phase"_s].toString()
+                          << phase[u"wallMs"_s].toInteger() << "ms,"
+                          << phase[u"peakRssKiB"_s].toInteger() << "KiB peak RSS";
+    }
+    qInfo() << report[u"pageCount"_s].toInteger() << "pages,"
+            << qint64(report[u"pageBytes"_s].toDouble()) << "bytes";
+}
+
+void tst_bench_qdoccorpus::prepare_data()
+{
+    corpusData();
+}
+
+void tst_bench_qdoccorpus::prepare()
+{
+    QFETCH(int, classCount);
+    QFETCH(int, memberCount);
+    createCorpus(classCount, memberCount);
+    const QString output = m_dir->filePath(u"docs/synth"_s);
+    const QStringList arguments{ u"-prepare"_s, u"-outputdir"_s, output,
+                                 u"-I"_s, m_dir->filePath(u"synth"_s),
+                                 m_dir->filePath(u"synth/synth.qdocconf"_s) };
+
+    QBENCHMARK {
+        QVERIFY(runQDoc(arguments));
+    }
+    QVERIFY(QFileInfo::exists(output + u"/synth.index"_s));
+    reportPhases();
+}
+
+void tst_bench_qdoccorpus::generate_data()
+{
+    corpusData();
+}
+
+void tst_bench_qdoccorpus::generate()
+{
+    QFETCH(int, classCount);
+    QFETCH(int, memberCount);
+    createCorpus(classCount, memberCount);
+    const QString output = m_dir->filePath(u"docs/synth"_s);
+    const QStringList common{ u"-outputdir"_s, output, u"-I"_s, m_dir->filePath(u"synth"_s),
+                              m_dir->filePath(u"synth/synth.qdocconf"_s) };
+    QVERIFY(runQDoc(QStringList{ u"-prepare"_s } + common));
+
+    QBENCHMARK {
+        QVERIFY(runQDoc(QStringList{ u"-generate"_s } + common));
+    }
+    reportPhases();
+}
+
+/*
+    Measures reading the index of Synth and resolving links to all of
+    its classes, members, and QML types.
+*/
+void tst_bench_qdoccorpus::generateDependent_data()
+{
+    corpusData();
+}
+
+void tst_bench_qdoccorpus::generateDependent()
+{
+    QFETCH(int, classCount);
+    QFETCH(int, memberCount);
+    createCorpus(classCount, memberCount);
+    const QString output = m_dir->filePath(u"docs/synth"_s);
+    QVERIFY(runQDoc({ u"-prepare"_s, u"-outputdir"_s, output, u"-I"_s,
+                      m_dir->filePath(u"synth"_s), m_dir->filePath(u"synth/synth.qdocconf"_s) }));
+    const QString linksOutput = m_dir->filePath(u"docs/synthlinks"_s);
+    const QStringList arguments{ u"-generate"_s, u"-outputdir"_s, linksOutput,
+                                 u"-indexdir"_s, m_dir->filePath(u"docs"_s),
+                                 m_dir->filePath(u"links/links.qdocconf"_s) };
+
+    QBENCHMARK {
+        QVERIFY(runQDoc(arguments));
+    }
+    QVERIFY(QFileInfo::exists(linksOutput + u"/links.html"_s));
+    reportPhases();
+}
+
+void tst_bench_qdoccorpus::singleExec_data()
+{
+    corpusData();
+}
+
+void tst_bench_qdoccorpus::singleExec()
+{
+    QFETCH(int, classCount);
+    QFETCH(int, memberCount);
+    createCorpus(classCount, memberCount);
+    const QString master = m_dir->filePath(u"master.qdocconf"_s);
+    QVERIFY(writeFile(master, m_dir->filePath(u"synth/synth.qdocconf"_s) + u'\n'
+                              + m_dir->filePath(u"links/links.qdocconf"_s) + u'\n'));
+    const QStringList arguments{ u"-single-exec"_s, u"-outputdir"_s,
+                                 m_dir->filePath(u"docs"_s), u"-I"_s,
+                                 m_dir->filePath(u"synth"_s), master };
+
+    QBENCHMARK {
+        QVERIFY(runQDoc(arguments));
+    }
+    reportPhases();
+}
+
+QTEST_MAIN(tst_bench_qdoccorpus)
+#include "tst_bench_qdoccorpus.moc"
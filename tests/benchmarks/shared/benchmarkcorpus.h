@@ -0,0 +1,61 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef BENCHMARKCORPUS_H
+#define BENCHMARKCORPUS_H
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtTest/QTest>
+
+#include <initializer_list>
+#include <utility>
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+// Helpers for the benchmarks that run a tool on a synthetic corpus of
+// N items with M members each, written to a temporary directory.
+namespace BenchmarkCorpus {
+
+// Adds one row named NxM per corpus size, with the columns itemColumn
+// and memberColumn.
+inline void addSizeRows(const char *itemColumn, const char *memberColumn,
+                        std::initializer_list<std::pair<int, int>> sizes)
+{
+    QTest::addColumn<int>(itemColumn);
+    QTest::addColumn<int>(memberColumn);
+    for (const auto &[items, members] : sizes)
+        QTest::addRow("%dx%d", items, members) << items << members;
+}
+
+inline bool writeFile(const QString &filePath, const QString &contents)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+    return file.write(contents.toUtf8()) >= 0;
+}
+
+// Returns the peak resident set size of this process so far, or -1 where
+// the platform does not report it.
+inline qint64 peakRssKiB()
+{
+#if defined(Q_OS_UNIX)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#  if defined(Q_OS_DARWIN)
+    return usage.ru_maxrss / 1024;
+#  else
+    return usage.ru_maxrss;
+#  endif
+#else
+    return -1;
+#endif
+}
+
+} // namespace BenchmarkCorpus
+
+#endif // BENCHMARKCORPUS_H
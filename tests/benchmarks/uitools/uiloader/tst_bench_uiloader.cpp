@@ -0,0 +1,144 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QBuffer>
+#include <QtTest/QtTest>
+#include <QtUiTools/QUiLoader>
+#include <QtWidgets/QWidget>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+static const int widgetCounts[] = { 10, 100, 1000 };
+
+class tst_bench_uiloader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void load_data();
+    void load();
+
+private:
+    static QByteArray createForm(int widgetCount);
+};
+
+/*
+  Creates a form resembling a settings dialog: rows of labels, line edits,
+  check boxes and combo boxes in a grid layout, with string, number, enum
+  and set properties on each of them.
+*/
+QByteArray tst_bench_uiloader::createForm(int widgetCount)
+{
+    QByteArray ui = R"(<?xml version="1.0" encoding="UTF-8"?>
+<ui version="4.0">
+ <class>Form</class>
+ <widget class="QWidget" name="Form">
+  <property name="windowTitle">
+   <string>Settings</string>
+  </property>
+  <layout class="QGridLayout" name="gridLayout">
+)";
+    static const char *const classes[] = { "QLabel", "QLineEdit", "QCheckBox", "QComboBox" };
+    for (int i = 0; i < widgetCount; ++i) {
+        const char *className = classes[i % 4];
+        ui += "   <item row=\"" + QByteArray::number(i / 4) + "\" column=\""
+                + QByteArray::number(i % 4) + "\">\n"
+                + "    <widget class=\"" + className + "\" name=\"widget" + QByteArray::number(i)
+                + "\">\n"
+                + R"(     <property name="toolTip">
+      <string>Tool tip of the setting</string>
+     </property>
+     <property name="enabled">
+      <bool>true</bool>
+     </property>
+     <property name="focusPolicy">
+      <enum>Qt::StrongFocus</enum>
+     </property>
+     <property name="minimumSize">
+      <size>
+       <width>40</width>
+       <height>20</height>
+      </size>
+     </property>
+)";
+        switch (i % 4) {
+        case 0:
+            ui += R"(     <property name="text">
+      <string>Setting</string>
+     </property>
+     <property name="alignment">
+      <set>Qt::AlignRight|Qt::AlignTrailing|Qt::AlignVCenter</set>
+     </property>
+)";
+            break;
+        case 1:
+            ui += R"(     <property name="maxLength">
+      <number>64</number>
+     </property>
+     <property name="echoMode">
+      <enum>QLineEdit::Normal</enum>
+     </property>
+)";
+            break;
+        case 2:
+            ui += R"(     <property name="text">
+      <string>Enable</string>
+     </property>
+     <property name="checked">
+      <bool>true</bool>
+     </property>
+)";
+            break;
+        case 3:
+            ui += R"(     <property name="sizeAdjustPolicy">
+      <enum>QComboBox::AdjustToContents</enum>
+     </property>
+     <item>
+      <property name="text">
+       <string>First</string>
+      </property>
+     </item>
+     <item>
+      <property name="text">
+       <string>Second</string>
+      </property>
+     </item>
+)";
+            break;
+        }
+        ui += "    </widget>\n   </item>\n";
+    }
+    ui += "  </layout>\n </widget>\n <resources/>\n <connections/>\n</ui>\n";
+    return ui;
+}
+
+void tst_bench_uiloader::load_data()
+{
+    QTest::addColumn<int>("widgetCount");
+    QTest::addColumn<bool>("formCache");
+    for (int widgetCount : widgetCounts) {
+        QTest::addRow("%d", widgetCount) << widgetCount << false;
+        QTest::addRow("%d-cached", widgetCount) << widgetCount << true;
+    }
+}
+
+void tst_bench_uiloader::load()
+{
+    QFETCH(int, widgetCount);
+    QFETCH(bool, formCache);
+    QByteArray form = createForm(widgetCount);
+    QUiLoader loader;
+    loader.setFormCacheEnabled(formCache);
+
+    QBENCHMARK {
+        QBuffer buffer(&form);
+        buffer.open(QIODevice::ReadOnly);
+        std::unique_ptr<QWidget> widget(loader.load(&buffer));
+        QVERIFY2(widget, qPrintable(loader.errorString()));
+    }
+}
+
+QTEST_MAIN(tst_bench_uiloader)
+#include "tst_bench_uiloader.moc"